@@ -9,6 +9,16 @@ function(yuchen_configure_target target_name)
             $<$<CONFIG:Release>:-O3>
             $<$<BOOL:${YUCHEN_WARNINGS_AS_ERRORS}>:-Werror>
         )
+    elseif(UNIX)
+        target_compile_options(${target_name} PRIVATE
+            -Wall -Wextra
+            -Wno-unused-parameter
+            -Wno-missing-field-initializers
+            $<$<CONFIG:Debug>:-g3 -O0>
+            $<$<CONFIG:Release>:-O3>
+            $<$<BOOL:${YUCHEN_ENABLE_AVX2}>:-mavx2 -mfma>
+            $<$<BOOL:${YUCHEN_WARNINGS_AS_ERRORS}>:-Werror>
+        )
     elseif(MSVC)
         target_compile_options(${target_name} PRIVATE
             /W4
@@ -15,7 +15,7 @@ endif()
 function(yuchen_link_dependencies target_name)
     if(APPLE)
         target_link_libraries(${target_name} PUBLIC ${YUCHEN_FRAMEWORKS})
-    elseif(WIN32)
+    elseif(WIN32 OR UNIX)
         target_link_libraries(${target_name} PUBLIC ${YUCHEN_PLATFORM_LIBS})
     endif()
 endfunction()
\ No newline at end of file
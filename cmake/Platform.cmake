@@ -24,6 +24,17 @@ elseif(APPLE)
     )
     set(CMAKE_OSX_DEPLOYMENT_TARGET 11.0)
     
+elseif(UNIX)
+    set(YUCHEN_PLATFORM "Linux")
+    add_compile_definitions(
+        YUCHEN_PLATFORM_LINUX=1
+        YUCHEN_RENDERER_SOFTWARE=1
+    )
+    
+    option(YUCHEN_ENABLE_AVX2 "Build the software renderer with AVX2 span kernels" OFF)
+    
+    set(YUCHEN_PLATFORM_LIBS pthread)
+    
 else()
     message(FATAL_ERROR "Unsupported platform")
 endif()
\ No newline at end of file
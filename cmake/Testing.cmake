@@ -2,25 +2,36 @@
 # YuchenUI Testing Framework
 # ====================================================================================
 
-include(FetchContent)
-
-set(BUILD_GMOCK ON CACHE BOOL "" FORCE)
-set(INSTALL_GTEST OFF CACHE BOOL "" FORCE)
-set(gtest_force_shared_crt ON CACHE BOOL "" FORCE)
-
-FetchContent_Declare(
-    googletest
-    GIT_REPOSITORY https://github.com/google/googletest.git
-    GIT_TAG v1.14.0
-    GIT_SHALLOW TRUE
-)
-
-# Suppress GoogleTest warnings
-if(NOT MSVC)
-    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-everything")
-endif()
+# Prefer an installed GoogleTest (offline CI images), fall back to fetching it.
+# PATH-derived prefixes are skipped so a GTest bundled with another toolchain
+# (and its libstdc++) is not picked up over the system one.
+find_package(GTest CONFIG QUIET NO_SYSTEM_ENVIRONMENT_PATH)
+
+if(GTest_FOUND)
+    set(YUCHEN_GTEST_LIBRARIES GTest::gtest GTest::gtest_main GTest::gmock GTest::gmock_main)
+else()
+    include(FetchContent)
+
+    set(BUILD_GMOCK ON CACHE BOOL "" FORCE)
+    set(INSTALL_GTEST OFF CACHE BOOL "" FORCE)
+    set(gtest_force_shared_crt ON CACHE BOOL "" FORCE)
+
+    FetchContent_Declare(
+        googletest
+        GIT_REPOSITORY https://github.com/google/googletest.git
+        GIT_TAG v1.14.0
+        GIT_SHALLOW TRUE
+    )
+
+    # Suppress GoogleTest warnings
+    if(NOT MSVC)
+        set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -Wno-everything")
+    endif()
 
-FetchContent_MakeAvailable(googletest)
+    FetchContent_MakeAvailable(googletest)
+
+    set(YUCHEN_GTEST_LIBRARIES gtest gtest_main gmock gmock_main)
+endif()
 
 # ====================================================================================
 # Test Creation Function
@@ -31,10 +42,7 @@ function(yuchen_add_test test_name)
     
     # Link test libraries
     target_link_libraries(${test_name} PRIVATE
-        gtest
-        gtest_main
-        gmock
-        gmock_main
+        ${YUCHEN_GTEST_LIBRARIES}
         YuchenUI-Desktop
     )
     
@@ -0,0 +1,23 @@
+set(UNICODE_TABLE_GENERATOR_DIR "${CMAKE_CURRENT_SOURCE_DIR}/../cmake/tools/unicode_table_generator")
+set(UNICODE_TABLE_GENERATOR_BINARY_DIR "${CMAKE_CURRENT_BINARY_DIR}/tools/unicode_table_generator")
+
+if(NOT TARGET unicode_table_generator)
+    add_subdirectory(${UNICODE_TABLE_GENERATOR_DIR} ${UNICODE_TABLE_GENERATOR_BINARY_DIR})
+endif()
+
+function(yuchen_generate_unicode_tables target_name)
+    set(OUTPUT_DIR "${CMAKE_CURRENT_BINARY_DIR}/generated")
+    set(HEADER_FILE "${OUTPUT_DIR}/UnicodeTables.h")
+    
+    add_custom_command(
+        OUTPUT ${HEADER_FILE}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${OUTPUT_DIR}
+        COMMAND unicode_table_generator --output "${HEADER_FILE}"
+        DEPENDS unicode_table_generator
+        COMMENT "Generating Unicode classification tables for ${target_name}"
+        VERBATIM
+    )
+    
+    target_sources(${target_name} PRIVATE ${HEADER_FILE})
+    target_include_directories(${target_name} PRIVATE ${OUTPUT_DIR})
+endfunction()
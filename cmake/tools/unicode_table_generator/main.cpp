@@ -0,0 +1,257 @@
+// Generates UnicodeTables.h, the codepoint to script and character class table used by
+// YuchenUI::TextUtils. Every codepoint of Unicode is classified from the Unicode Character
+// Database tables HarfBuzz ships (script, general category, Extended_Pictographic), so the
+// table always matches the Unicode version of the bundled HarfBuzz.
+//
+// Layout: codepoints are split into blocks of BLOCK_SIZE. STAGE1 maps a block number to a
+// deduplicated block in STAGE2, and STAGE2 holds one index into PROPERTIES per codepoint.
+
+#include "hb-ucd-table.hh"
+#include "hb-unicode-emoji-table.hh"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t CODEPOINT_COUNT = 0x110000;
+constexpr uint32_t BLOCK_SHIFT = 7;
+constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+
+// Must match the CLASS_* constants written below
+constexpr uint8_t CLASS_WESTERN = 0x01;
+constexpr uint8_t CLASS_CHINESE = 0x02;
+constexpr uint8_t CLASS_EMOJI = 0x04;
+constexpr uint8_t CLASS_SYMBOL = 0x08;
+
+// Codepoints below this that belong to no particular script (punctuation, digits, arrows,
+// operators, letterlike symbols) are drawn with the Western font
+constexpr uint32_t WESTERN_COMMON_END = 0x2300;
+
+hb_script_t scriptOf(uint32_t codepoint)
+{
+    hb_script_t script = _hb_ucd_sc_map[_hb_ucd_sc(codepoint)];
+
+    // Combining marks take the script of their base; unassigned codepoints have none
+    if (script == HB_SCRIPT_INHERITED || script == HB_SCRIPT_UNKNOWN) return HB_SCRIPT_COMMON;
+    return script;
+}
+
+bool isCJKCommonBlock(uint32_t codepoint)
+{
+    return (codepoint >= 0x2E80 && codepoint <= 0x2FDF) ||   // CJK and Kangxi Radicals
+           (codepoint >= 0x3000 && codepoint <= 0x303F) ||   // CJK Symbols and Punctuation
+           (codepoint >= 0x3190 && codepoint <= 0x31FF) ||   // Kanbun, CJK Strokes
+           (codepoint >= 0x3200 && codepoint <= 0x33FF) ||   // Enclosed CJK, CJK Compatibility
+           (codepoint >= 0xFE30 && codepoint <= 0xFE4F) ||   // CJK Compatibility Forms
+           (codepoint >= 0xFF00 && codepoint <= 0xFFEF);     // Halfwidth and Fullwidth Forms
+}
+
+bool isEmojiComponent(uint32_t codepoint)
+{
+    return (codepoint >= 0x1F1E6 && codepoint <= 0x1F1FF) || // Regional indicators (flags)
+           (codepoint >= 0x1F3FB && codepoint <= 0x1F3FF) || // Skin tone modifiers
+           (codepoint >= 0xFE00 && codepoint <= 0xFE0F) ||   // Variation selectors
+           codepoint == 0x200D || codepoint == 0x20E3;       // Zero width joiner, keycap
+}
+
+bool isSymbolCategory(unsigned category)
+{
+    switch (category)
+    {
+        case HB_UNICODE_GENERAL_CATEGORY_MATH_SYMBOL:
+        case HB_UNICODE_GENERAL_CATEGORY_OTHER_SYMBOL:
+        case HB_UNICODE_GENERAL_CATEGORY_OTHER_NUMBER:
+        case HB_UNICODE_GENERAL_CATEGORY_DASH_PUNCTUATION:
+        case HB_UNICODE_GENERAL_CATEGORY_OPEN_PUNCTUATION:
+        case HB_UNICODE_GENERAL_CATEGORY_CLOSE_PUNCTUATION:
+        case HB_UNICODE_GENERAL_CATEGORY_INITIAL_PUNCTUATION:
+        case HB_UNICODE_GENERAL_CATEGORY_FINAL_PUNCTUATION:
+        case HB_UNICODE_GENERAL_CATEGORY_OTHER_PUNCTUATION:
+            return true;
+        default:
+            return false;
+    }
+}
+
+uint8_t classesOf(uint32_t codepoint, hb_script_t script)
+{
+    uint8_t classes = 0;
+
+    if (_hb_emoji_is_Extended_Pictographic(codepoint) || isEmojiComponent(codepoint))
+        classes |= CLASS_EMOJI;
+
+    if (script == HB_SCRIPT_HAN || script == HB_SCRIPT_BOPOMOFO ||
+        (script == HB_SCRIPT_COMMON && isCJKCommonBlock(codepoint)))
+        classes |= CLASS_CHINESE;
+
+    if (script == HB_SCRIPT_LATIN || script == HB_SCRIPT_GREEK || script == HB_SCRIPT_CYRILLIC ||
+        (script == HB_SCRIPT_COMMON && codepoint < WESTERN_COMMON_END && !(classes & CLASS_CHINESE)))
+        classes |= CLASS_WESTERN;
+
+    // Pictographs such as U+2328 keyboard are both: symbol fonts draw their text presentation
+    if (script == HB_SCRIPT_COMMON && codepoint >= WESTERN_COMMON_END &&
+        !(classes & CLASS_CHINESE) && isSymbolCategory(_hb_ucd_gc(codepoint)))
+        classes |= CLASS_SYMBOL;
+
+    return classes;
+}
+
+std::string tagName(hb_script_t script)
+{
+    const uint32_t tag = static_cast<uint32_t>(script);
+    const char name[5] = { char(tag >> 24), char(tag >> 16), char(tag >> 8), char(tag), 0 };
+    return name;
+}
+
+template <typename T>
+void writeArray(std::ostream& out, const char* type, const char* name, const std::vector<T>& values)
+{
+    out << "static constexpr " << type << " " << name << "[" << values.size() << "] = {";
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        if (i % 16 == 0) out << "\n    ";
+        out << static_cast<uint32_t>(values[i]) << (i + 1 < values.size() ? "," : "");
+    }
+    out << "\n};\n\n";
+}
+
+void printUsage(const char* program)
+{
+    std::cout << "Usage: " << program << " --output <file>\n"
+              << "Writes the YuchenUI Unicode script and character class table.\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string output;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--output") {
+            if (i + 1 < argc) {
+                output = argv[++i];
+            } else {
+                std::cerr << "Error: --output requires a value\n";
+                return 1;
+            }
+        } else {
+            std::cerr << "Error: unknown argument " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (output.empty()) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    // Distinct (script, classes) pairs; the first is what out-of-range codepoints get
+    std::map<std::pair<uint32_t, uint8_t>, uint8_t> propertyIndex;
+    std::vector<std::pair<hb_script_t, uint8_t>> properties;
+    auto internProperty = [&](hb_script_t script, uint8_t classes) -> uint8_t {
+        auto key = std::make_pair(static_cast<uint32_t>(script), classes);
+        auto it = propertyIndex.find(key);
+        if (it != propertyIndex.end()) return it->second;
+
+        if (properties.size() == 256) {
+            std::cerr << "Error: more than 256 distinct character properties\n";
+            std::exit(1);
+        }
+        const uint8_t index = static_cast<uint8_t>(properties.size());
+        propertyIndex.emplace(key, index);
+        properties.emplace_back(script, classes);
+        return index;
+    };
+    internProperty(HB_SCRIPT_COMMON, 0);
+
+    // Blocks of property indices, deduplicated
+    std::map<std::vector<uint8_t>, uint16_t> blockIndex;
+    std::vector<uint16_t> stage1;
+    std::vector<uint8_t> stage2;
+    std::vector<uint8_t> block(BLOCK_SIZE);
+
+    for (uint32_t start = 0; start < CODEPOINT_COUNT; start += BLOCK_SIZE) {
+        for (uint32_t offset = 0; offset < BLOCK_SIZE; ++offset) {
+            const uint32_t codepoint = start + offset;
+            const hb_script_t script = scriptOf(codepoint);
+            block[offset] = internProperty(script, classesOf(codepoint, script));
+        }
+
+        auto it = blockIndex.find(block);
+        if (it == blockIndex.end()) {
+            it = blockIndex.emplace(block, static_cast<uint16_t>(blockIndex.size())).first;
+            stage2.insert(stage2.end(), block.begin(), block.end());
+        }
+        stage1.push_back(it->second);
+    }
+
+    std::ostringstream out;
+    out << "// Generated by unicode_table_generator from the HarfBuzz " << HB_VERSION_STRING
+        << " Unicode Character Database. Do not edit.\n"
+        << "// " << stage1.size() * sizeof(uint16_t) + stage2.size() + properties.size() * 5
+        << " bytes: " << stage1.size() << " blocks, " << blockIndex.size() << " distinct, "
+        << properties.size() << " properties.\n\n"
+        << "#pragma once\n\n"
+        << "#include <cstdint>\n\n"
+        << "namespace YuchenUI {\n"
+        << "namespace UnicodeTables {\n\n"
+        << "static constexpr uint8_t CLASS_WESTERN = " << int(CLASS_WESTERN) << ";\n"
+        << "static constexpr uint8_t CLASS_CHINESE = " << int(CLASS_CHINESE) << ";\n"
+        << "static constexpr uint8_t CLASS_EMOJI = " << int(CLASS_EMOJI) << ";\n"
+        << "static constexpr uint8_t CLASS_SYMBOL = " << int(CLASS_SYMBOL) << ";\n\n"
+        << "static constexpr uint32_t CODEPOINT_COUNT = 0x" << std::hex << CODEPOINT_COUNT << std::dec << ";\n"
+        << "static constexpr uint32_t BLOCK_SHIFT = " << BLOCK_SHIFT << ";\n"
+        << "static constexpr uint32_t BLOCK_MASK = " << (BLOCK_SIZE - 1) << ";\n\n"
+        << "/** Script tag (hb_script_t) and CLASS_* bits shared by many codepoints */\n"
+        << "struct CharacterProperties {\n"
+        << "    uint32_t script;\n"
+        << "    uint8_t classes;\n"
+        << "};\n\n";
+
+    writeArray(out, "uint16_t", "STAGE1", stage1);
+    writeArray(out, "uint8_t", "STAGE2", stage2);
+
+    out << "static constexpr CharacterProperties PROPERTIES[" << properties.size() << "] = {\n";
+    for (const auto& property : properties) {
+        out << "    { 0x" << std::hex << std::setw(8) << std::setfill('0') << static_cast<uint32_t>(property.first)
+            << std::dec << std::setfill(' ') << ", " << int(property.second) << " },  // "
+            << tagName(property.first) << "\n";
+    }
+    out << "};\n\n"
+        << "} // namespace UnicodeTables\n"
+        << "} // namespace YuchenUI\n";
+
+    // Leave an identical file untouched so dependents are not rebuilt
+    {
+        std::ifstream existing(output, std::ios::binary);
+        if (existing) {
+            std::stringstream current;
+            current << existing.rdbuf();
+            if (current.str() == out.str()) return 0;
+        }
+    }
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: cannot write " << output << "\n";
+        return 1;
+    }
+    file << out.str();
+    return file ? 0 : 1;
+}
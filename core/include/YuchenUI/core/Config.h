@@ -53,6 +53,13 @@ namespace Text {
     static constexpr size_t MAX_LENGTH = 8192;              ///< Maximum text length (characters)
     static constexpr size_t MAX_GLYPHS_PER_TEXT = 8192;     ///< Maximum glyphs per text object
     static constexpr float DEFAULT_PADDING = 0.0f;          ///< Default text padding
+    static constexpr size_t SHAPED_TEXT_CACHE_BYTES = 1024 * 1024; ///< Byte budget of the shaped text cache
+    static constexpr size_t RASTER_THREADS = 4;             ///< Glyph rasterization threads including the caller (0 = hardware)
+    static constexpr size_t PARALLEL_RASTER_MIN_GLYPHS = 16; ///< Glyph misses in one run before rasterizing in parallel
+    static constexpr size_t SHAPING_THREADS = 4;            ///< Text shaping threads including the caller (0 = hardware)
+    static constexpr size_t PARALLEL_SHAPING_MIN_TEXTS = 4; ///< Uncached texts in one batch before shaping in parallel
+    static constexpr size_t SHAPING_FONTS_PER_THREAD = 32;  ///< Font and size instances a shaping thread keeps
+    static constexpr size_t PREWARM_GLYPHS_PER_FRAME = 64;  ///< Prewarmed glyphs moved into the atlas per beginFrame()
 }
 
 //==========================================================================================
@@ -62,6 +69,13 @@ namespace Rendering {
     static constexpr size_t MAX_TEXT_VERTICES = 32768;      ///< Maximum text vertices per frame
     static const Vec4 DEFAULT_CLEAR_COLOR = Vec4::FromRGBA(0,0,0,0);
     static constexpr int DEFAULT_FPS = 60;                  /// render Default FPS
+    static constexpr size_t BATCH_LOOKBACK = 8;             ///< Earlier batches a command may join
+    static constexpr int SOFTWARE_TILE_SIZE = 64;           ///< Software renderer bin size (physical pixels)
+    static constexpr size_t WIDGET_CACHE_COMMANDS = 16;     ///< Initial capacity of a widget draw cache
+    static constexpr size_t WIDGET_CACHE_ARENA_BLOCK = 256; ///< Arena block size of a widget draw cache
+    static constexpr float DAMAGE_OUTSET = 2.0f;            ///< Damage margin around widget bounds (focus rings, AA edges)
+    static constexpr size_t MAX_DAMAGE_RECTS = 32;          ///< Damage rects kept per frame before collapsing to their union
+    static constexpr size_t MAX_GRADIENT_STOPS = 16;        ///< Color stops per gradient fill
 }
 
 //==========================================================================================
@@ -73,6 +87,14 @@ namespace GlyphCache {
     static constexpr uint32_t MAX_ATLASES = 8;              ///< Maximum atlas textures
     static constexpr uint32_t GLYPH_EXPIRE_FRAMES = 300;    ///< Frames before unused glyph expires
     static constexpr uint32_t CLEANUP_INTERVAL_FRAMES = 60; ///< Frames between cache cleanups
+    static constexpr uint32_t SHELF_HEIGHT_GRANULARITY = 4; ///< Shelf heights round up to this (pixels)
+    static constexpr float SHELF_HEIGHT_TOLERANCE = 1.5f;   ///< Tallest shelf a glyph joins, relative to its height
+    static constexpr float DEFRAG_THRESHOLD = 0.5f;         ///< Shelf area fraction left in holes that triggers a re-pack
+    static constexpr float DEFRAG_MIN_COVERAGE = 0.5f;      ///< Atlas height fraction under shelves before re-packing pays off
+    static constexpr float DIRTY_MERGE_SLACK = 1.5f;        ///< Largest union / summed area at which dirty regions merge
+    static constexpr size_t MAX_DIRTY_REGIONS = 16;         ///< Dirty regions per atlas before they collapse to one
+    static constexpr float SDF_REFERENCE_SIZE = 48.0f;      ///< Pixel size distance field glyphs are rasterized at
+    static constexpr uint32_t SDF_SPREAD = 6;               ///< Distance range each side of the edge, in reference pixels
 }
 
 //==========================================================================================
@@ -16,7 +16,11 @@
 #pragma once
 
 #include "YuchenUI/core/Assert.h"
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <vector>
 #include <string>
 
@@ -27,10 +31,17 @@
     #define YUCHEN_PACK_BEGIN __pragma(pack(push, 1))
     #define YUCHEN_PACK_END __pragma(pack(pop))
     #define YUCHEN_PACKED
-#else
+#elif defined(__clang__)
     #define YUCHEN_PACK_BEGIN
     #define YUCHEN_PACK_END
     #define YUCHEN_PACKED __attribute__((packed))
+#else
+    // GCC ignores packed on structs with non-POD members such as Vec2, and warns in
+    // every translation unit. The vertex structs hold only floats, so there is no
+    // padding to remove; static_asserts below pin their layout on every compiler.
+    #define YUCHEN_PACK_BEGIN
+    #define YUCHEN_PACK_END
+    #define YUCHEN_PACKED
 #endif
 
 namespace YuchenUI {
@@ -123,6 +134,46 @@ struct Rect
     {
         return std::isfinite(x) && std::isfinite(y) && std::isfinite(width) && std::isfinite(height) && width >= 0.0f && height >= 0.0f;
     }
+
+    bool isEmpty() const
+    {
+        return width <= 0.0f || height <= 0.0f;
+    }
+
+    /** Returns true if the rectangles share a non-empty area. */
+    bool intersects(const Rect& other) const
+    {
+        return x < other.x + other.width && other.x < x + width &&
+               y < other.y + other.height && other.y < y + height;
+    }
+
+    /** Returns the overlap of both rectangles, empty if they do not intersect. */
+    Rect intersected(const Rect& other) const
+    {
+        float left = std::max(x, other.x);
+        float top = std::max(y, other.y);
+        float right = std::min(x + width, other.x + other.width);
+        float bottom = std::min(y + height, other.y + other.height);
+        return Rect(left, top, right - left, bottom - top);
+    }
+
+    /** Returns the bounding rectangle of both; an empty rectangle contributes nothing. */
+    Rect united(const Rect& other) const
+    {
+        if (other.isEmpty()) return *this;
+        if (isEmpty()) return other;
+        float left = std::min(x, other.x);
+        float top = std::min(y, other.y);
+        float right = std::max(x + width, other.x + other.width);
+        float bottom = std::max(y + height, other.y + other.height);
+        return Rect(left, top, right - left, bottom - top);
+    }
+
+    /** Returns the rectangle grown by amount on every side. */
+    Rect expanded(float amount) const
+    {
+        return Rect(x - amount, y - amount, width + amount * 2.0f, height + amount * 2.0f);
+    }
     
     bool operator==(const Rect& other) const
     {
@@ -267,6 +318,12 @@ struct RectVertex
 } YUCHEN_PACKED;
 YUCHEN_PACK_END
 
+// Matches the vertex descriptors of the Metal and D3D11 rect pipelines
+static_assert(sizeof(RectVertex) == 15 * sizeof(float), "RectVertex must be 15 tightly packed floats");
+static_assert(offsetof(RectVertex, rectOrigin) == 8 && offsetof(RectVertex, rectSize) == 16 &&
+              offsetof(RectVertex, cornerRadius) == 24 && offsetof(RectVertex, color) == 40 &&
+              offsetof(RectVertex, borderWidth) == 56, "RectVertex field offsets changed");
+
 //==========================================================================================
 // Font system types
 
@@ -495,6 +552,58 @@ struct TextVertex {
 } YUCHEN_PACKED;
 YUCHEN_PACK_END
 
+// Matches the vertex descriptors of the Metal and D3D11 text pipelines
+static_assert(sizeof(TextVertex) == 8 * sizeof(float), "TextVertex must be 8 tightly packed floats");
+static_assert(offsetof(TextVertex, texCoord) == 8 && offsetof(TextVertex, color) == 16,
+              "TextVertex field offsets changed");
+
+//==========================================================================================
+/** Contiguous run of text vertices sampling one glyph atlas.
+
+    Draw each range with its atlas texture bound; ranges of one text run never share
+    an atlas, so a run costs one bind per atlas it touches.
+*/
+struct TextVertexRange {
+    uint32_t atlasIndex;      ///< Glyph atlas index
+    void* atlasTexture;       ///< Atlas texture handle
+    uint32_t firstVertex;     ///< First vertex of the range
+    uint32_t vertexCount;     ///< Vertex count (4 per glyph quad)
+};
+
+//==========================================================================================
+/** Vertex for textured image quads (position + texture coordinates) */
+struct ImageVertex {
+    Vec2 position;
+    Vec2 texCoord;
+
+    ImageVertex() : position(), texCoord() {}
+    ImageVertex(const Vec2& pos, const Vec2& tex) : position(pos), texCoord(tex) {}
+};
+
+//==========================================================================================
+/** Vertex for solid-color shapes (lines, triangles) */
+struct ShapeVertex {
+    Vec2 position;  ///< Vertex position in window coordinates
+    Vec4 color;     ///< Vertex color (RGBA)
+
+    ShapeVertex() : position(), color() {}
+    ShapeVertex(const Vec2& pos, const Vec4& col) : position(pos), color(col) {}
+};
+
+//==========================================================================================
+/** Vertex for SDF circle rendering. The fragment stage evaluates the distance to center. */
+struct CircleVertex {
+    Vec2 position;      ///< Vertex position in window coordinates
+    Vec2 center;        ///< Circle center
+    float radius;       ///< Circle radius
+    float borderWidth;  ///< Border width (0 for filled)
+    Vec4 color;         ///< Circle color (RGBA)
+
+    CircleVertex() : position(), center(), radius(0.0f), borderWidth(0.0f), color() {}
+    CircleVertex(const Vec2& pos, const Vec2& cen, float r, float bw, const Vec4& col)
+        : position(pos), center(cen), radius(r), borderWidth(bw), color(col) {}
+};
+
 //==========================================================================================
 /** Shaped glyph with position and metadata */
 struct ShapedGlyph {
@@ -542,12 +651,29 @@ struct TextSegment {
     size_t originalLength;
 };
 
+/** One text of a shaping batch, with the same parameters as TextRenderer::shapeText() */
+struct TextShapeRequest {
+    const char* text;                       ///< Null-terminated UTF-8 text (not owned)
+    uint32_t length;                        ///< Byte length of text
+    const FontFallbackChain* fallbackChain; ///< Font fallback chain (not owned)
+    float fontSize;                         ///< Font size in points
+    float letterSpacing;                    ///< Letter spacing in thousandths of em
+};
+
+//==========================================================================================
+/** How a cached glyph's atlas texels are stored and drawn. */
+enum class GlyphFormat : uint32_t {
+    Coverage,           ///< Coverage bitmap rasterized at the drawn size
+    SignedDistance      ///< Distance field rasterized once at SDF_REFERENCE_SIZE, drawn at any size
+};
+
 //==========================================================================================
 /**
     Cache key for glyph lookup.
     
-    Identifies a unique glyph by font, glyph index, size, and boldness strength.
+    Identifies a unique glyph by font, glyph index, size, boldness strength and format.
     Each combination of these parameters produces a different cached glyph bitmap.
+    Distance field glyphs are always keyed at Config::GlyphCache::SDF_REFERENCE_SIZE.
 */
 struct GlyphKey
 {
@@ -555,6 +681,7 @@ struct GlyphKey
     uint32_t glyphIndex;      ///< Glyph index in font
     uint32_t quantizedSize;   ///< Font size * 64 (26.6 fixed-point)
     uint32_t boldness;        ///< Embolden strength (FT_Pos value)
+    GlyphFormat format;       ///< Coverage bitmap or distance field
     
     /**
         Constructs cache key with optional boldness.
@@ -563,12 +690,14 @@ struct GlyphKey
         @param gi        Glyph index
         @param fontSize  Font size in points (will be quantized)
         @param bold      Embolden strength (default: 0 = no boldness)
+        @param fmt       Glyph format (default: coverage bitmap)
     */
-    GlyphKey(FontHandle fh, uint32_t gi, float fontSize, uint32_t bold = 0)
+    GlyphKey(FontHandle fh, uint32_t gi, float fontSize, uint32_t bold = 0, GlyphFormat fmt = GlyphFormat::Coverage)
         : fontHandle(fh)
         , glyphIndex(gi)
         , quantizedSize(static_cast<uint32_t>(fontSize * 64.0f))
         , boldness(bold)
+        , format(fmt)
     {
     }
     
@@ -577,7 +706,8 @@ struct GlyphKey
         return fontHandle == other.fontHandle &&
                glyphIndex == other.glyphIndex &&
                quantizedSize == other.quantizedSize &&
-               boldness == other.boldness;
+               boldness == other.boldness &&
+               format == other.format;
     }
 };
 
@@ -590,6 +720,7 @@ struct GlyphKeyHash
         hash ^= std::hash<uint32_t>()(key.glyphIndex) << 1;
         hash ^= std::hash<uint32_t>()(key.quantizedSize) << 2;
         hash ^= std::hash<uint32_t>()(key.boldness) << 3;
+        hash ^= std::hash<uint32_t>()(static_cast<uint32_t>(key.format)) << 4;
         return hash;
     }
 };
@@ -598,12 +729,14 @@ struct GlyphKeyHash
 struct GlyphCacheEntry
 {
     Rect textureRect;       ///< Location in atlas texture
+    uint32_t atlasIndex;    ///< Atlas holding the bitmap
     Vec2 bearing;           ///< Glyph bearing
     float advance;          ///< Horizontal advance
     uint32_t lastUsedFrame; ///< Last frame this glyph was used
     bool isValid;           ///< Entry validity flag
+    bool isPinned;          ///< Survives periodic expiration until first drawn (prewarmed glyphs)
 
-    GlyphCacheEntry() : textureRect(), bearing(), advance(0.0f), lastUsedFrame(0), isValid(false) {}
+    GlyphCacheEntry() : textureRect(), atlasIndex(0), bearing(), advance(0.0f), lastUsedFrame(0), isValid(false), isPinned(false) {}
 
     void markUsed(uint32_t frame)
     {
@@ -616,37 +749,30 @@ struct GlyphCacheEntry
     }
 };
 
-/** Glyph atlas texture */
-struct GlyphAtlas
-{
-    uint32_t width;
-    uint32_t height;
-    uint32_t currentX;      ///< Current packing position X
-    uint32_t currentY;      ///< Current packing position Y
-    uint32_t rowHeight;     ///< Current row height for packing
-    bool isFull;            ///< Atlas is full, cannot add more glyphs
-    void* textureHandle;    ///< Graphics backend texture handle
-
-    GlyphAtlas(uint32_t w, uint32_t h)
-        : width(w), height(h), currentX(0), currentY(0), rowHeight(0), isFull(false), textureHandle(nullptr) {
-    }
+//==========================================================================================
+// Rendering types
 
-    void reset()
-    {
-        currentX = 0;
-        currentY = 0;
-        rowHeight = 0;
-        isFull = false;
-    }
+/** Axis along which a gradient fill changes color */
+enum class GradientDirection {
+    Horizontal,     ///< Left edge to right edge
+    Vertical        ///< Top edge to bottom edge
 };
 
-//==========================================================================================
-// Rendering types
+/** One color stop of a linear gradient */
+struct GradientStop
+{
+    float position;     ///< Offset along the gradient axis, 0 (start edge) to 1 (end edge)
+    Vec4 color;
+
+    GradientStop() : position(0.0f), color() {}
+    GradientStop(float pos, const Vec4& col) : position(pos), color(col) {}
+};
 
 enum class RenderCommandType {
     Clear = 0,
     FillRect,
     DrawRect,
+    FillGradientRect,
     DrawText,
     DrawImage,
     DrawLine,
@@ -658,237 +784,241 @@ enum class RenderCommandType {
     PopClip
 };
 
-/** Rendering command - describes a single draw operation */
+/**
+    Rendering command - describes a single draw operation.
+    
+    Commands are compact tagged records: `type` selects which payload of the union is
+    active, and each payload only carries the fields its command needs. The struct is
+    trivially copyable, so recording a command is a plain memory copy into the list.
+    
+    Variable-length data (text, resource paths, font fallback chains) does not live in
+    the command. It is stored in the owning RenderList's RenderArena and referenced by
+    pointer; those pointers stay valid until the list is reset. Gradient stops are
+    stored the same way.
+    
+    Payload by type:
+    - Clear                              -> clear
+    - FillRect, DrawRect                 -> rectangle
+    - FillGradientRect                   -> gradient
+    - DrawText                           -> text
+    - DrawImage                          -> image
+    - DrawLine                           -> line
+    - FillTriangle, DrawTriangle         -> triangle
+    - FillCircle, DrawCircle             -> circle
+    - PushClip                           -> clip (PopClip has no payload)
+    
+    @see RenderList, RenderArena
+*/
 struct RenderCommand
 {
+    struct ClearData {
+        Vec4 color;
+    };
+    
+    struct RectangleData {
+        Rect rect;
+        Vec4 color;
+        CornerRadius cornerRadius;
+        float borderWidth;          ///< 0 for FillRect
+    };
+    
+    struct GradientData {
+        Rect rect;
+        CornerRadius cornerRadius;
+        GradientDirection direction;
+        uint32_t stopCount;
+        const GradientStop* stops;              ///< stopCount stops, arena-owned
+    };
+    
+    struct TextData {
+        Vec2 position;
+        Vec4 color;
+        float fontSize;
+        float letterSpacing;
+        const char* utf8;                       ///< Null-terminated, arena-owned
+        uint32_t length;                        ///< Byte length of utf8
+        const FontFallbackChain* fontChain;     ///< Arena-owned
+    };
+    
+    struct ImageData {
+        Rect destRect;
+        Rect sourceRect;                        ///< Zero size means whole image
+        NineSliceMargins nineSliceMargins;
+        ScaleMode scaleMode;
+        const char* resourceNamespace;          ///< Null-terminated, arena-owned
+        const char* resourcePath;               ///< Null-terminated, arena-owned
+        void* textureHandle;
+    };
+    
+    struct LineData {
+        Vec2 start;
+        Vec2 end;
+        Vec4 color;
+        float width;
+    };
+    
+    struct TriangleData {
+        Vec2 p1;
+        Vec2 p2;
+        Vec2 p3;
+        Vec4 color;
+        float borderWidth;          ///< 0 for FillTriangle
+    };
+    
+    struct CircleData {
+        Vec2 center;
+        float radius;
+        Vec4 color;
+        float borderWidth;          ///< 0 for FillCircle
+    };
+    
+    struct ClipData {
+        Rect rect;
+    };
+    
     RenderCommandType type;
-
-    Rect rect;
-    Vec4 color;
-    CornerRadius cornerRadius;
-    float borderWidth;
-
-    Vec2 textPosition;
-    std::string text;
-    std::string resourceNamespace;
-
-    float fontSize;
-    Vec4 textColor;
-    
-    FontFallbackChain fontFallbackChain;
-    float letterSpacing;
-
-    void* textureHandle;
-    Rect sourceRect;
-    ScaleMode scaleMode;
-    NineSliceMargins nineSliceMargins;
-
-    Vec2 lineStart;
-    Vec2 lineEnd;
-    float lineWidth;
-
-    Vec2 triangleP1;
-    Vec2 triangleP2;
-    Vec2 triangleP3;
-
-    Vec2 circleCenter;
-    float circleRadius;
-
-    RenderCommand()
-        : type(RenderCommandType::Clear)
-        , rect()
-        , color()
-        , cornerRadius()
-        , borderWidth(0.0f)
-        , textPosition()
-        , text()
-        , resourceNamespace()
-        , fontSize(11.0f)
-        , textColor()
-        , fontFallbackChain()
-        , letterSpacing(0.0f)
-        , textureHandle(nullptr)
-        , sourceRect()
-        , scaleMode(ScaleMode::Stretch)
-        , nineSliceMargins()
-        , lineStart()
-        , lineEnd()
-        , lineWidth(1.0f)
-        , triangleP1()
-        , triangleP2()
-        , triangleP3()
-        , circleCenter()
-        , circleRadius(0.0f)
-    {
-    }
+    
+    union {
+        ClearData clear;
+        RectangleData rectangle;
+        GradientData gradient;
+        TextData text;
+        ImageData image;
+        LineData line;
+        TriangleData triangle;
+        CircleData circle;
+        ClipData clip;
+    };
+
+    RenderCommand() : type(RenderCommandType::Clear), clear() {}
+    RenderCommand(RenderCommandType t, const ClearData& data) : type(t), clear(data) {}
+    RenderCommand(RenderCommandType t, const RectangleData& data) : type(t), rectangle(data) {}
+    RenderCommand(RenderCommandType t, const GradientData& data) : type(t), gradient(data) {}
+    RenderCommand(RenderCommandType t, const TextData& data) : type(t), text(data) {}
+    RenderCommand(RenderCommandType t, const ImageData& data) : type(t), image(data) {}
+    RenderCommand(RenderCommandType t, const LineData& data) : type(t), line(data) {}
+    RenderCommand(RenderCommandType t, const TriangleData& data) : type(t), triangle(data) {}
+    RenderCommand(RenderCommandType t, const CircleData& data) : type(t), circle(data) {}
+    RenderCommand(RenderCommandType t, const ClipData& data) : type(t), clip(data) {}
 
     static RenderCommand CreateClear(const Vec4& color)
     {
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::Clear;
-        cmd.color = color;
-        return cmd;
+        return RenderCommand(RenderCommandType::Clear, ClearData{color});
     }
 
     static RenderCommand CreateFillRect(const Rect& rect, const Vec4& color, const CornerRadius& cornerRadius)
     {
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::FillRect;
-        cmd.rect = rect;
-        cmd.color = color;
-        cmd.cornerRadius = cornerRadius;
-        cmd.borderWidth = 0.0f;
-        return cmd;
+        return RenderCommand(RenderCommandType::FillRect, RectangleData{rect, color, cornerRadius, 0.0f});
     }
 
     static RenderCommand CreateDrawRect(const Rect& rect, const Vec4& color, float borderWidth, const CornerRadius& cornerRadius)
     {
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::DrawRect;
-        cmd.rect = rect;
-        cmd.color = color;
-        cmd.cornerRadius = cornerRadius;
-        cmd.borderWidth = borderWidth;
-        return cmd;
+        return RenderCommand(RenderCommandType::DrawRect, RectangleData{rect, color, cornerRadius, borderWidth});
     }
 
-    static RenderCommand CreateDrawText(const char* text, const Vec2& position,
-        const FontFallbackChain& fallbackChain,
+    /** Creates a gradient fill command. The stops must already be arena-owned. */
+    static RenderCommand CreateFillGradientRect(const Rect& rect, const GradientStop* stops, uint32_t stopCount,
+        GradientDirection direction, const CornerRadius& cornerRadius)
+    {
+        return RenderCommand(RenderCommandType::FillGradientRect,
+            GradientData{rect, cornerRadius, direction, stopCount, stops});
+    }
+
+    /** Creates a text command. The text and chain must already be arena-owned. */
+    static RenderCommand CreateDrawText(const char* text, uint32_t length, const Vec2& position,
+        const FontFallbackChain* fallbackChain,
         float fontSize, const Vec4& textColor,
         float letterSpacing = 0.0f)
     {
-        if (!text || !position.isValid() || fontSize <= 0.0f || !textColor.isValid()) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+        if (!text || !fallbackChain || !position.isValid() || fontSize <= 0.0f || !textColor.isValid()) {
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::DrawText;
-        cmd.text = text;
-        cmd.textPosition = position;
-        cmd.fontFallbackChain = fallbackChain;
-        cmd.fontSize = fontSize;
-        cmd.textColor = textColor;
-        cmd.letterSpacing = letterSpacing;
-        
-        return cmd;
+        return RenderCommand(RenderCommandType::DrawText,
+            TextData{position, textColor, fontSize, letterSpacing, text, length, fallbackChain});
     }
 
-    static RenderCommand CreateDrawImage(void* textureHandle, const Rect& destRect,
-        const Rect& sourceRect, ScaleMode scaleMode,
+    /** Creates an image command. The namespace and path must already be arena-owned. */
+    static RenderCommand CreateDrawImage(const char* resourceNamespace, const char* resourcePath,
+        const Rect& destRect, const Rect& sourceRect, ScaleMode scaleMode,
         const NineSliceMargins& nineSlice = NineSliceMargins())
     {
-        if (!textureHandle || !destRect.isValid() || !sourceRect.isValid()) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+        if (!resourceNamespace || !resourcePath || !destRect.isValid() || !sourceRect.isValid()) {
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::DrawImage;
-        cmd.textureHandle = textureHandle;
-        cmd.rect = destRect;
-        cmd.sourceRect = sourceRect;
-        cmd.scaleMode = scaleMode;
-        cmd.nineSliceMargins = nineSlice;
-        return cmd;
+        return RenderCommand(RenderCommandType::DrawImage,
+            ImageData{destRect, sourceRect, nineSlice, scaleMode, resourceNamespace, resourcePath, nullptr});
     }
 
     static RenderCommand CreateDrawLine(const Vec2& start, const Vec2& end, const Vec4& color, float width)
     {
         if (!start.isValid() || !end.isValid() || !color.isValid() || width <= 0.0f) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::DrawLine;
-        cmd.lineStart = start;
-        cmd.lineEnd = end;
-        cmd.color = color;
-        cmd.lineWidth = width;
-        return cmd;
+        return RenderCommand(RenderCommandType::DrawLine, LineData{start, end, color, width});
     }
 
     static RenderCommand CreateFillTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Vec4& color)
     {
         if (!p1.isValid() || !p2.isValid() || !p3.isValid() || !color.isValid()) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::FillTriangle;
-        cmd.triangleP1 = p1;
-        cmd.triangleP2 = p2;
-        cmd.triangleP3 = p3;
-        cmd.color = color;
-        cmd.borderWidth = 0.0f;
-        return cmd;
+        return RenderCommand(RenderCommandType::FillTriangle, TriangleData{p1, p2, p3, color, 0.0f});
     }
 
     static RenderCommand CreateDrawTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3, const Vec4& color, float borderWidth)
     {
         if (!p1.isValid() || !p2.isValid() || !p3.isValid() || !color.isValid() || borderWidth <= 0.0f) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::DrawTriangle;
-        cmd.triangleP1 = p1;
-        cmd.triangleP2 = p2;
-        cmd.triangleP3 = p3;
-        cmd.color = color;
-        cmd.borderWidth = borderWidth;
-        return cmd;
+        return RenderCommand(RenderCommandType::DrawTriangle, TriangleData{p1, p2, p3, color, borderWidth});
     }
 
     static RenderCommand CreateFillCircle(const Vec2& center, float radius, const Vec4& color)
     {
         if (!center.isValid() || radius <= 0.0f || !color.isValid()) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::FillCircle;
-        cmd.circleCenter = center;
-        cmd.circleRadius = radius;
-        cmd.color = color;
-        cmd.borderWidth = 0.0f;
-        return cmd;
+        return RenderCommand(RenderCommandType::FillCircle, CircleData{center, radius, color, 0.0f});
     }
 
     static RenderCommand CreateDrawCircle(const Vec2& center, float radius, const Vec4& color, float borderWidth)
     {
         if (!center.isValid() || radius <= 0.0f || !color.isValid() || borderWidth <= 0.0f) {
-            RenderCommand cmd;
-            cmd.type = RenderCommandType::Clear;
-            return cmd;
+            return RenderCommand();
         }
 
-        RenderCommand cmd;
-        cmd.type = RenderCommandType::DrawCircle;
-        cmd.circleCenter = center;
-        cmd.circleRadius = radius;
-        cmd.color = color;
-        cmd.borderWidth = borderWidth;
-        return cmd;
+        return RenderCommand(RenderCommandType::DrawCircle, CircleData{center, radius, color, borderWidth});
+    }
+
+    static RenderCommand CreatePushClip(const Rect& rect)
+    {
+        return RenderCommand(RenderCommandType::PushClip, ClipData{rect});
+    }
+
+    static RenderCommand CreatePopClip()
+    {
+        return RenderCommand(RenderCommandType::PopClip, ClipData{Rect()});
     }
 };
 
+static_assert(std::is_trivially_copyable<RenderCommand>::value,
+              "RenderCommand must stay trivially copyable");
+static_assert(std::is_trivially_destructible<RenderCommand>::value,
+              "RenderCommand must stay trivially destructible");
+
 //==========================================================================================
 // Miscellaneous types
 
 enum class TextureFormat {
-    R8_Unorm,       ///< Single-channel 8-bit normalized (grayscale)
-    RGBA8_Unorm     ///< Four-channel 8-bit normalized (color with alpha)
+    R8_Unorm,           ///< Single-channel 8-bit normalized (grayscale)
+    RGBA8_Unorm,        ///< Four-channel 8-bit normalized (color with alpha)
+    R8_DistanceField    ///< Single-channel 8-bit signed distance, 0.5 on the glyph edge
 };
 
 enum class WindowType {
@@ -17,7 +17,9 @@
 
 #include "YuchenUI/core/Types.h"
 #include "YuchenUI/events/Event.h"
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace YuchenUI {
 
@@ -32,6 +34,21 @@ class IFontProvider;
 class IThemeProvider;
 class UIStyle;
 
+//==========================================================================================
+/**
+    Damage statistics for the last rendered frame.
+    
+    Filled in by UIContext::render().
+*/
+struct FrameStats
+{
+    bool fullRedraw = true;            ///< Whole viewport was repainted
+    float damagedPixelFraction = 1.0f; ///< Damage union area over viewport area (0..1)
+    size_t damageRectCount = 0;        ///< Damage rectangles accumulated for the frame
+    size_t commandsRecorded = 0;       ///< Commands the content emitted
+    size_t commandsSkipped = 0;        ///< Commands of culled widgets, from their last recording
+};
+
 //==========================================================================================
 /**
     Central UI management context.
@@ -101,6 +118,102 @@ public:
     void render(RenderList& outCommandList);
     void endFrame();
     
+    //======================================================================================
+    // Redraw scheduling
+    
+    /**
+        Requests that the next frame repaint the whole viewport.
+        
+        Use this when the changed area is unknown. Viewport, DPI and content changes
+        call it automatically. The request is cleared by endFrame().
+    */
+    void requestRedraw();
+    
+    /**
+        Requests a frame that repaints at least a rectangle.
+        
+        Widget::invalidate() calls this with the widget's old and new window bounds.
+        Damage accumulates until endFrame(); beyond Config::Rendering::MAX_DAMAGE_RECTS
+        rectangles the list collapses into its union.
+        
+        @param rect  Damaged area in window coordinates (clipped to the viewport)
+    */
+    void invalidateRect(const Rect& rect);
+    
+    /**
+        Requests a frame after a delay, for animations and time-based updates.
+        
+        Content and widgets that animate from onUpdate()/update() call this every frame
+        they want another one; a request made during beginFrame() schedules the next
+        frame. Multiple requests keep the earliest deadline.
+        
+        @param delaySeconds  Time from now until the frame is due (0 = next frame)
+    */
+    void requestAnimationFrame(float delaySeconds = 0.0f);
+    
+    /**
+        Returns true if a redraw was requested or an animation frame is due.
+        
+        Windows skip beginFrame()/render()/endFrame() entirely while this is false.
+    */
+    bool needsRedraw() const;
+    
+    /**
+        Returns the seconds until the next frame is due.
+        
+        @returns 0 if a frame is due now, a positive wait for a pending animation frame,
+                 or a negative value if nothing is scheduled (the UI is idle)
+    */
+    float getTimeUntilNextFrame() const;
+    
+    /** Called when a frame becomes due sooner than it was. */
+    using FrameRequestCallback = std::function<void()>;
+    
+    /**
+        Sets a callback run when a redraw or an earlier animation frame is requested.
+        
+        Platforms whose frame clock stops while the UI is idle (the macOS display link)
+        use it to restart the clock. It runs on the thread that made the request, and
+        may run while a frame is in progress.
+        
+        @param callback  Callback, or nullptr to remove it
+    */
+    void setFrameRequestCallback(FrameRequestCallback callback);
+    
+    //======================================================================================
+    // Damage regions
+    
+    /**
+        Enables recording only the damaged part of each frame.
+        
+        Enable this only when the backend keeps the previous frame's pixels and
+        scissors to the damage (IGraphicsBackend::supportsPartialRedraw()). When
+        enabled, render() sets the damage union as the list's cull rect, so widgets
+        outside it are not recorded. Disabled by default.
+        
+        @param enabled  true to cull recording to the damage
+    */
+    void setPartialRedrawEnabled(bool enabled);
+    
+    /** Returns whether partial redraw is enabled. */
+    bool isPartialRedrawEnabled() const;
+    
+    /** Returns true if the pending frame must repaint the whole viewport. */
+    bool isFullRedraw() const;
+    
+    /** Returns the damage rectangles accumulated for the pending frame. */
+    const std::vector<Rect>& getDamageRects() const;
+    
+    /**
+        Returns the union of the pending damage, clipped to the viewport.
+        
+        @returns The viewport for a full redraw; an empty rect if nothing is damaged
+    */
+    Rect getDamageBounds() const;
+    
+    /** Returns damage statistics for the last render() call. */
+    const FrameStats& getFrameStats() const;
+    
     //======================================================================================
     // Mouse event handling
     
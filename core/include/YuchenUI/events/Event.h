@@ -3,6 +3,7 @@
 #include "YuchenUI/core/Types.h"
 #include "YuchenUI/core/Assert.h"
 #include <cstdint>
+#include <cstring>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -20,6 +20,17 @@ public:
     
     virtual void executeRenderCommands(const RenderList& commands) = 0;
     
+    // Partial redraw: backends that keep the previous frame's pixels may limit the
+    // next frame (until endFrame) to a damaged rect in logical coordinates. An empty
+    // rect means the whole surface. Backends without support ignore the hint.
+    virtual bool supportsPartialRedraw() const { return false; }
+    virtual void setDamageRect(const Rect& rect) { (void)rect; }
+    
+    // Distance field text: backends whose text shader thresholds R8_DistanceField
+    // atlases instead of sampling them as coverage. TextRenderer refuses
+    // GlyphFormat::SignedDistance on backends without support.
+    virtual bool supportsDistanceFieldText() const { return false; }
+    
     virtual void* createTexture2D(uint32_t width, uint32_t height,
                                    TextureFormat format) = 0;
     virtual void updateTexture2D(void* texture, uint32_t x, uint32_t y,
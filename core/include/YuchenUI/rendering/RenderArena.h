@@ -0,0 +1,125 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/**
+    Per-frame side storage for variable-length render command data.
+
+    RenderCommand is a trivially copyable tagged record, so anything that does not fit
+    in a fixed-size payload (UTF-8 text, resource paths, font fallback chains, gradient
+    stops) is stored
+    here and referenced by pointer. Memory is kept in fixed-size blocks whose addresses
+    never move, so pointers handed out stay valid until the next reset().
+
+    reset() only rewinds the write cursors. Blocks and font chain slots are retained, so
+    once a RenderList has seen a typical frame, recording the next one performs no heap
+    allocations.
+
+    @see RenderList, RenderCommand
+*/
+class RenderArena
+{
+public:
+    /** Default block size for string storage (bytes) */
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 16 * 1024;
+
+    /** Creates an empty arena.
+
+        @param blockSize  Size of each string block; small arenas (for example widget
+                          draw caches) can use much less than the frame default
+    */
+    explicit RenderArena(size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~RenderArena();
+
+    RenderArena(const RenderArena&) = delete;
+    RenderArena& operator=(const RenderArena&) = delete;
+
+    //======================================================================================
+    // Storage
+
+    /**
+        Copies a string into the arena.
+
+        The stored copy is always null-terminated.
+
+        @param text    Source bytes (need not be null-terminated)
+        @param length  Number of bytes to copy
+        @returns Pointer to the stored copy, valid until reset()
+    */
+    const char* storeString(const char* text, size_t length);
+
+    /**
+        Stores a font fallback chain.
+
+        Identical chains recorded in the same frame share one slot, which is the common
+        case since most widgets draw with the theme's default chain.
+
+        @param chain  Chain to store
+        @returns Pointer to the stored chain, valid until reset()
+    */
+    const FontFallbackChain* storeFontChain(const FontFallbackChain& chain);
+
+    /**
+        Copies an array of gradient stops into the arena.
+
+        @param stops  Source stops
+        @param count  Number of stops to copy
+        @returns Pointer to the stored copy, valid until reset()
+    */
+    const GradientStop* storeGradientStops(const GradientStop* stops, size_t count);
+
+    //======================================================================================
+    // State Management
+
+    /** Rewinds the arena. All previously returned pointers become invalid. */
+    void reset();
+
+    /** Returns the number of string and stop bytes stored since the last reset. */
+    size_t getBytesUsed() const { return m_bytesUsed; }
+
+    /** Returns the total bytes reserved by string blocks. */
+    size_t getBytesReserved() const;
+
+    /** Returns the number of distinct font chains stored since the last reset. */
+    size_t getFontChainCount() const { return m_fontChainCount; }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t capacity;
+    };
+
+    char* allocate(size_t size, size_t alignment = 1);
+
+    std::vector<Block> m_blocks;                ///< String blocks (retained across resets)
+    size_t m_blockSize;                         ///< Capacity of newly allocated blocks
+    size_t m_currentBlock;                      ///< Index of block being filled
+    size_t m_blockOffset;                       ///< Write offset within current block
+    size_t m_bytesUsed;                         ///< String and stop bytes stored this frame
+
+    std::deque<FontFallbackChain> m_fontChains; ///< Chain slots (stable addresses, retained)
+    size_t m_fontChainCount;                    ///< Slots in use this frame
+};
+
+} // namespace YuchenUI
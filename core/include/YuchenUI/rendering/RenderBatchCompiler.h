@@ -0,0 +1,234 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include <cstdint>
+#include <vector>
+
+namespace YuchenUI {
+
+class RenderList;
+class TextRenderer;
+class TextureCache;
+
+//==========================================================================================
+/**
+    Render pipeline kinds.
+
+    Each pipeline corresponds to one shader pair and one vertex layout on the GPU
+    backends. None is only used by backends to mark "no pipeline bound yet".
+*/
+enum class ActivePipeline {
+    None,    ///< No pipeline active
+    Rect,    ///< Rounded rectangle pipeline (RectVertex)
+    Text,    ///< Glyph atlas pipeline (TextVertex, indexed quads)
+    Image,   ///< Textured image pipeline (ImageVertex)
+    Shape,   ///< Solid shape pipeline for lines and triangles (ShapeVertex)
+    Circle   ///< SDF circle pipeline (CircleVertex)
+};
+
+//==========================================================================================
+/**
+    One draw call worth of work.
+
+    Batches are returned in the order they must be drawn. Vertex ranges index into the
+    vertex stream of the batch's pipeline.
+*/
+struct RenderBatch {
+    ActivePipeline pipeline;  ///< Pipeline to bind
+    Rect clipRect;            ///< Scissor rect in window coordinates (if hasClip)
+    bool hasClip;             ///< Whether a scissor rect applies
+    bool repeatSampler;       ///< Image batches only: use repeat addressing (tiled images)
+    void* texture;            ///< Image texture or glyph atlas handle, null otherwise
+    uint32_t firstVertex;     ///< First vertex in the pipeline's stream
+    uint32_t vertexCount;     ///< Number of vertices
+    uint32_t commandCount;    ///< Number of source commands merged into this batch
+    Rect bounds;              ///< Union of the merged commands' bounds
+
+    RenderBatch()
+        : pipeline(ActivePipeline::None), clipRect(), hasClip(false), repeatSampler(false)
+        , texture(nullptr), firstVertex(0), vertexCount(0), commandCount(0), bounds() {}
+};
+
+//==========================================================================================
+/** Counters describing the last compile() call */
+struct RenderBatchStats {
+    size_t drawCommands;       ///< Drawable commands seen (excludes clear and clip commands)
+    size_t culledCommands;     ///< Commands dropped (fully clipped or producing no geometry)
+    size_t reorderedCommands;  ///< Commands merged into an earlier, non-overlapping batch
+    size_t batchCount;         ///< Batches emitted
+
+    RenderBatchStats() : drawCommands(0), culledCommands(0), reorderedCommands(0), batchCount(0) {}
+};
+
+//==========================================================================================
+/**
+    Turns a RenderList into an ordered list of draw batches.
+
+    This is the backend-agnostic half of command execution. It resolves the clip stack,
+    generates vertices for every pipeline, resolves image textures and glyph atlases,
+    and merges commands into as few batches as painter's order allows. GPU backends only
+    upload the vertex streams and issue one draw per batch.
+
+    Merging rules:
+    - A command can join a batch with the same pipeline, clip, texture and sampler
+    - It may join an earlier batch than the last one only if none of the batches in
+      between overlap it, so the visible result is identical to drawing in list order
+    - The search looks back at most Config::Rendering::BATCH_LOOKBACK batches
+
+    Vertex conventions follow the existing shader contracts: rect and image positions
+    are in normalized device coordinates, while text, shape and circle positions are in
+    window coordinates and are transformed by the viewport uniforms.
+
+    The compiler keeps its buffers between frames, so steady-state compiles do not
+    allocate.
+
+    Example:
+    @code
+    RenderBatchCompiler compiler(textRenderer, textureCache);
+    compiler.compile(renderList, Vec2(width, height));
+    for (const auto& batch : compiler.getBatches())
+        drawBatch(batch);
+    @endcode
+
+    @see RenderList, IGraphicsBackend
+*/
+class RenderBatchCompiler {
+public:
+    //======================================================================================
+    /** Creates a compiler.
+
+        @param textRenderer  Text renderer used to shape and lay out DrawText commands.
+                             May be null, in which case text commands are culled.
+        @param textureCache  Texture cache used to resolve DrawImage commands.
+                             May be null, in which case image commands are culled.
+    */
+    RenderBatchCompiler(TextRenderer* textRenderer, TextureCache* textureCache);
+    ~RenderBatchCompiler();
+
+    RenderBatchCompiler(const RenderBatchCompiler&) = delete;
+    RenderBatchCompiler& operator=(const RenderBatchCompiler&) = delete;
+
+    //======================================================================================
+    /** Compiles a command list into batches.
+
+        Results stay valid until the next call. Glyphs rasterized for text commands
+        are uploaded to their atlas textures before this returns.
+
+        @param commandList   Commands to compile
+        @param viewportSize  Render surface size in logical pixels (used for NDC output)
+    */
+    void compile(const RenderList& commandList, const Vec2& viewportSize);
+
+    //======================================================================================
+    // Results
+
+    /** Returns the batches in draw order. */
+    const std::vector<RenderBatch>& getBatches() const { return m_batches; }
+
+    const std::vector<RectVertex>& getRectVertices() const { return m_rectVertices; }
+    const std::vector<TextVertex>& getTextVertices() const { return m_textVertices; }
+    const std::vector<ImageVertex>& getImageVertices() const { return m_imageVertices; }
+    const std::vector<ShapeVertex>& getShapeVertices() const { return m_shapeVertices; }
+    const std::vector<CircleVertex>& getCircleVertices() const { return m_circleVertices; }
+
+    /** Returns true if the list contained a Clear command. */
+    bool hasClearColor() const { return m_hasClearColor; }
+
+    /** Returns the color of the last Clear command. */
+    const Vec4& getClearColor() const { return m_clearColor; }
+
+    /** Returns counters for the last compile. */
+    const RenderBatchStats& getStats() const { return m_stats; }
+
+private:
+    //======================================================================================
+    /** Placement of one command's vertices, recorded during the first pass. */
+    struct PendingCommand {
+        uint32_t batch;
+        uint32_t firstVertex;
+        uint32_t vertexCount;
+    };
+
+    /** One glyph atlas worth of a text command's vertices. */
+    struct TextPlacement {
+        void* atlas;
+        Rect bounds;
+        uint32_t firstVertex;     ///< Relative to the command's first scratch vertex
+        uint32_t vertexCount;
+    };
+
+    /** Shapes the list's uncached text in one batch before any of it is emitted. */
+    void shapeText(const RenderList& commandList);
+
+    /** Vertex emitters. Each appends to the scratch stream and returns the bounds. */
+    Rect emitRect(const RenderCommand& cmd);
+    Rect emitGradientRect(const RenderCommand& cmd);
+    Rect emitLine(const Vec2& start, const Vec2& end, const Vec4& color, float width);
+    Rect emitTriangle(const RenderCommand& cmd);
+    Rect emitCircle(const RenderCommand& cmd);
+    bool emitText(const RenderCommand& cmd, Rect& outBounds);
+    bool emitImage(const RenderCommand& cmd, void*& outTexture, bool& outRepeat, Rect& outBounds);
+
+    void emitImageQuad(const Rect& destRect, const Vec2& uvMin, const Vec2& uvMax);
+    void emitNineSlice(const Rect& destRect, const Rect& sourceRect, const NineSliceMargins& margins,
+                       float designScale, uint32_t texWidth, uint32_t texHeight);
+
+    void toNDC(float x, float y, float& ndcX, float& ndcY) const;
+    uint32_t scratchSize(ActivePipeline pipeline) const;
+    void truncateScratch(ActivePipeline pipeline, uint32_t size);
+
+    /** Finds or creates the batch for a command and records its placement. */
+    void place(ActivePipeline pipeline, const Rect& clipRect, bool hasClip, void* texture,
+               bool repeatSampler, const Rect& bounds, uint32_t firstVertex, uint32_t vertexCount);
+
+    /** Builds the final vertex streams so each batch's vertices are contiguous. */
+    void finalizeStreams();
+
+    //======================================================================================
+    TextRenderer* m_textRenderer;   ///< Text renderer (not owned, may be null)
+    TextureCache* m_textureCache;   ///< Texture cache (not owned, may be null)
+    Vec2 m_viewportSize;            ///< Viewport used for NDC conversion
+
+    std::vector<RenderBatch> m_batches;
+    std::vector<PendingCommand> m_pending;
+    std::vector<Rect> m_clipStack;
+
+    std::vector<RectVertex> m_rectVertices;
+    std::vector<TextVertex> m_textVertices;
+    std::vector<ImageVertex> m_imageVertices;
+    std::vector<ShapeVertex> m_shapeVertices;
+    std::vector<CircleVertex> m_circleVertices;
+
+    std::vector<RectVertex> m_rectScratch;
+    std::vector<TextVertex> m_textScratch;
+    std::vector<ImageVertex> m_imageScratch;
+    std::vector<ShapeVertex> m_shapeScratch;
+    std::vector<CircleVertex> m_circleScratch;
+
+    std::vector<TextVertex> m_glyphVertices;  ///< Per-command text output
+    std::vector<TextVertexRange> m_glyphRanges; ///< Per-atlas ranges of m_glyphVertices
+    std::vector<TextPlacement> m_textPlacements; ///< Per-atlas placements of the last text command
+    std::vector<TextShapeRequest> m_shapeRequests; ///< Text commands of the list, for the shaping pre-pass
+    std::vector<uint32_t> m_batchCursor;      ///< Write cursors used by finalizeStreams
+
+    bool m_hasClearColor;
+    Vec4 m_clearColor;
+    RenderBatchStats m_stats;
+};
+
+} // namespace YuchenUI
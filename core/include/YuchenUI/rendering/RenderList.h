@@ -16,6 +16,7 @@
 #pragma once
 
 #include "YuchenUI/core/Types.h"
+#include "YuchenUI/rendering/RenderArena.h"
 #include <vector>
 
 namespace YuchenUI {
@@ -36,8 +37,30 @@ namespace YuchenUI {
     Version 2.1 Changes:
     - Added drawImageRegion() for sprite sheet rendering
     
+    Version 2.2 Changes:
+    - Commands are compact, trivially copyable tagged records
+    - Strings and font chains are stored in a per-list RenderArena
+    - RenderList is no longer copyable (commands point into its arena)
+    
+    Version 2.3 Changes:
+    - Added append() to replay a recorded list at an offset (widget draw caches)
+    - Initial command capacity and arena block size are configurable
+    
+    Version 2.4 Changes:
+    - Added a cull rect for partial redraws; Widget::render() skips widgets outside it
+      and reports the commands it did not record
+    - Added getFingerprint(), a hash of the command stream maintained while recording
+    - Added coalesceFillRects(), an optional pass merging abutting same-color rects
+    
+    Version 2.5 Changes:
+    - Added fillGradientRect() for multi-stop horizontal and vertical gradients
+    - coalesceFillRects() folds one-pixel column ramps into gradient fills, only merges
+      at physical pixel edges, and takes the target's pixel scale
+    
     Key features:
     - Cache-friendly linear command storage
+    - Allocation-free recording once the list has warmed up; reuse one list
+      across frames and call reset() instead of constructing a new one
     - Validation on command insertion
     - Hierarchical clipping with stack tracking
     - Text length capping at Config::Text::MAX_LENGTH
@@ -61,9 +84,22 @@ namespace YuchenUI {
 class RenderList
 {
 public:
-    RenderList();
+    /** Default number of commands reserved by a frame list */
+    static constexpr size_t DEFAULT_RESERVED_COMMANDS = 1000;
+    
+    /**
+        Creates an empty command list.
+        
+        @param reservedCommands  Initial command capacity
+        @param arenaBlockSize    Block size of the string arena
+    */
+    explicit RenderList(size_t reservedCommands = DEFAULT_RESERVED_COMMANDS,
+                        size_t arenaBlockSize = RenderArena::DEFAULT_BLOCK_SIZE);
     ~RenderList();
     
+    RenderList(const RenderList&) = delete;
+    RenderList& operator=(const RenderList&) = delete;
+    
     //======================================================================================
     // Drawing Commands
     
@@ -95,6 +131,44 @@ public:
     void drawRect(const Rect& rect, const Vec4& color, float borderWidth,
                   const CornerRadius& cornerRadius = CornerRadius());
     
+    /**
+        Fills a rectangle with a linear gradient and optional rounded corners.
+        
+        Colors are interpolated linearly between neighbouring stops along the given
+        axis. The area before the first stop takes the first stop's color and the area
+        after the last stop the last stop's color. Stops are copied into the list, so
+        the array may be temporary.
+        
+        Example:
+        @code
+        // Cylindrical highlight: dark edges, bright center
+        GradientStop stops[] = { { 0.0f, edge }, { 0.5f, center }, { 1.0f, edge } };
+        cmdList.fillGradientRect(barRect, stops, 3, GradientDirection::Horizontal);
+        @endcode
+        
+        @param rect          Rectangle bounds
+        @param stops         Color stops, positions in [0, 1] and non-decreasing
+        @param stopCount     Number of stops (2 to Config::Rendering::MAX_GRADIENT_STOPS)
+        @param direction     Axis the colors change along
+        @param cornerRadius  Corner rounding (default: sharp corners)
+    */
+    void fillGradientRect(const Rect& rect, const GradientStop* stops, size_t stopCount,
+                          GradientDirection direction,
+                          const CornerRadius& cornerRadius = CornerRadius());
+    
+    /**
+        Fills a rectangle with a two-color linear gradient.
+        
+        @param rect          Rectangle bounds
+        @param startColor    Color at the left (horizontal) or top (vertical) edge
+        @param endColor      Color at the opposite edge
+        @param direction     Axis the colors change along
+        @param cornerRadius  Corner rounding (default: sharp corners)
+    */
+    void fillGradientRect(const Rect& rect, const Vec4& startColor, const Vec4& endColor,
+                          GradientDirection direction,
+                          const CornerRadius& cornerRadius = CornerRadius());
+    
     //======================================================================================
     // Text Drawing (New API with Font Fallback)
     
@@ -220,11 +294,99 @@ public:
     */
     void popClipRect();
     
+    //======================================================================================
+    // Replay
+    
+    /**
+        Appends all commands of another list, translated by an offset.
+        
+        Geometry (rects, points, clip rects, image destinations) is moved by offset;
+        text, resource paths, font chains and gradient stops are copied into this list's arena, so the
+        source may be reset or destroyed afterwards. Used to replay a widget's cached
+        commands, which are recorded in widget-local coordinates.
+        
+        @param source  List to copy from (must not be this list)
+        @param offset  Translation applied to every command
+    */
+    void append(const RenderList& source, const Vec2& offset = Vec2());
+    
+    //======================================================================================
+    // Optimization
+    
+    /**
+        Merges runs of consecutive fill rects into fewer commands without changing the
+        pixels they produce.
+        
+        Only non-rounded FillRect commands take part. Consecutive commands share a clip by
+        construction, and painter's order is kept.
+        - Two rects of the same color merge when they abut exactly along a physical pixel
+          edge: same row and height with touching left/right edges, or same column and
+          width with touching top/bottom edges. A seam inside a pixel is left alone, since
+          its two antialiased edges do not add up to solid color.
+        - A run of columns (or rows) one physical pixel across, such as a meter's lighting
+          ramp, becomes one FillGradientRect with stops at the columns where the colors
+          bend. Every column is checked to come out with the same 8-bit color. Runs of
+          fewer than three colors stay as rects, which then take fewer quads.
+        
+        The pass is opt-in: it costs a walk over the list, which only pays off for
+        content that records many small rects. The fingerprint is left as recorded,
+        since the pass is deterministic for a given scale.
+        
+        @param pixelScale  Physical pixels per logical unit of the target
+        @returns Number of commands removed
+    */
+    size_t coalesceFillRects(float pixelScale = 1.0f);
+    
+    /** Returns the commands removed by coalesceFillRects() since the last reset(). */
+    size_t getCoalescedCommandCount() const { return m_coalescedCommands; }
+    
+    //======================================================================================
+    // Culling
+    
+    /**
+        Restricts recording to content that intersects a rectangle.
+        
+        Set by UIContext for partial redraws. Commands are still accepted anywhere;
+        the rect is advisory, and Widget::render() consults it to skip whole widgets.
+        
+        @param rect  Damaged area in window coordinates
+    */
+    void setCullRect(const Rect& rect);
+    
+    /** Removes the cull rect; everything is recorded again. */
+    void clearCullRect();
+    
+    /** Returns true if a cull rect is set. */
+    bool hasCullRect() const { return m_hasCullRect; }
+    
+    /** Returns the cull rect (meaningful only when hasCullRect() is true). */
+    const Rect& getCullRect() const { return m_cullRect; }
+    
+    /**
+        Returns true if content within bounds does not need recording.
+        
+        @param bounds  Area the content may touch, in window coordinates
+    */
+    bool isCulled(const Rect& bounds) const { return m_hasCullRect && !m_cullRect.intersects(bounds); }
+    
+    /**
+        Records that commands were skipped because of culling.
+        
+        @param count  Number of commands not recorded
+    */
+    void addCulledCommands(size_t count) { m_culledCommands += count; }
+    
+    /** Returns the number of commands skipped since the last reset(). */
+    size_t getCulledCommandCount() const { return m_culledCommands; }
+    
     //======================================================================================
     // State Management
     
     /**
-        Resets the command list, clearing all commands and clipping state.
+        Resets the command list, clearing all commands, clipping and culling state.
+        
+        Rewinds the arena; text and font chain pointers held by previously
+        recorded commands become invalid.
     */
     void reset();
     
@@ -238,6 +400,17 @@ public:
     */
     size_t getCommandCount() const;
     
+    /**
+        Returns a 64-bit fingerprint of everything recorded since the last reset().
+        
+        Updated incrementally as commands are added, so reading it is free. Lists
+        with the same commands in the same order (including text, resource paths,
+        font chains, gradient stops and cull rect) have the same fingerprint regardless of where
+        their arena data lives. Windows compare it with the previous frame to skip
+        presenting identical frames.
+    */
+    uint64_t getFingerprint() const { return m_fingerprint; }
+    
     /**
         Returns the internal command vector.
         
@@ -247,6 +420,11 @@ public:
     */
     const std::vector<RenderCommand>& getCommands() const;
     
+    /**
+        Returns the arena holding this frame's strings and font chains.
+    */
+    const RenderArena& getArena() const;
+    
     /**
         Validates all commands in the list.
         
@@ -271,8 +449,22 @@ private:
     */
     void validateCommand(const RenderCommand& cmd) const;
     
+    /**
+        Validates gradient stop count, positions and colors.
+        
+        @param stops      Stop array
+        @param stopCount  Number of stops
+    */
+    static void validateGradientStops(const GradientStop* stops, size_t stopCount);
+    
     std::vector<RenderCommand> m_commands;  ///< Command buffer
     std::vector<Rect> m_clipStack;          ///< Clipping rectangle stack
+    RenderArena m_arena;                    ///< Side storage for variable-length data
+    Rect m_cullRect;                        ///< Area worth recording (partial redraw)
+    bool m_hasCullRect;                     ///< Whether m_cullRect applies
+    size_t m_culledCommands;                ///< Commands skipped by culling
+    uint64_t m_fingerprint;                 ///< Running hash of the command stream
+    size_t m_coalescedCommands;             ///< Commands removed by coalesceFillRects()
 };
 
 } // namespace YuchenUI
@@ -0,0 +1,298 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file SoftwareRenderer.h
+
+    CPU rasterizing graphics backend.
+
+    Key features:
+    - Renders into an in-memory RGBA8 framebuffer, no window or GPU required
+    - Consumes the same RenderBatchCompiler output as the Metal and D3D11 backends
+    - Reproduces the shader coverage rules (SDF rects and circles, glyph gamma)
+    - Draws coverage and signed distance field glyph atlases
+    - SIMD span kernels (AVX2 / SSE2) with a scalar fallback
+    - Tile-binned rasterization spread over a worker pool
+    - Partial redraw: keeps the previous frame and repaints only the damaged rect
+    - Skips frames whose command list matches the previous frame's fingerprint
+    - Used for headless Linux builds, pixel tests and frame timing
+*/
+
+#pragma once
+
+#include "YuchenUI/rendering/IGraphicsBackend.h"
+#include "YuchenUI/rendering/RenderBatchCompiler.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace YuchenUI {
+
+class TextRenderer;
+class TextureCache;
+class IFontProvider;
+class SoftwareRasterizer;
+class WorkerPool;
+struct GlyphUploadStats;
+struct TextPrewarmProgress;
+
+//==========================================================================================
+/**
+    Software graphics backend.
+
+    SoftwareRenderer implements IGraphicsBackend entirely on the CPU. The framebuffer is
+    allocated at physical size (logical size times DPI scale) and holds straight-alpha
+    RGBA8 pixels, top row first.
+
+    Textures created through the backend interface (glyph atlases, images) live in
+    system memory, so TextRenderer and TextureCache work unchanged.
+
+    Rendering workflow:
+    1. beginFrame() - Clears the framebuffer to the current clear color
+    2. executeRenderCommands() - Compiles the list into batches and rasterizes them
+    3. endFrame() - No-op; read the result with getPixels()
+
+    Primitives are binned into screen tiles (Config::Rendering::SOFTWARE_TILE_SIZE) and
+    the tiles are rasterized in parallel, one per worker at a time. Each tile draws its
+    primitives in list order, so the output is identical for any thread count.
+
+    Unlike the GPU backends, a Clear command takes effect in the same
+    executeRenderCommands() call, so a single call produces a complete image.
+
+    The framebuffer persists between frames. After setDamageRect(), the clear and all
+    drawing of the next frame are scissored to the damaged pixels and tiles outside
+    it are not visited, so unchanged pixels carry over from the previous frame.
+
+    When a frame consists of a single list whose RenderList::getFingerprint() and
+    damage rect equal the previous single-list frame, the framebuffer already holds
+    the result and the list is neither compiled nor rasterized. Texture uploads and
+    resizes break the chain, so a frame is only skipped when nothing else changed.
+
+    Example:
+    @code
+    SoftwareRenderer renderer;
+    renderer.initialize(nullptr, 800, 600, 1.0f, &fontManager, &resourceResolver);
+    renderer.beginFrame();
+    renderer.executeRenderCommands(renderList);
+    renderer.endFrame();
+    const uint8_t* rgba = renderer.getPixels();
+    @endcode
+*/
+class SoftwareRenderer : public IGraphicsBackend {
+public:
+    //======================================================================================
+    /** Creates a SoftwareRenderer instance. */
+    SoftwareRenderer();
+
+    /** Destructor. Releases the framebuffer and all textures. */
+    virtual ~SoftwareRenderer();
+
+    //======================================================================================
+    // IGraphicsBackend Interface Implementation
+
+    /** Initializes the renderer and allocates the framebuffer.
+
+        @param platformSurface   Unused; may be null
+        @param width             Viewport width in logical pixels
+        @param height            Viewport height in logical pixels
+        @param dpiScale          Display scale factor
+        @param fontProvider      Font provider for text rendering (not owned)
+        @param resourceResolver  Resolver used by the texture cache (not owned)
+
+        @returns True if initialization succeeded
+    */
+    bool initialize(void* platformSurface, int width, int height, float dpiScale,
+                    IFontProvider* fontProvider, IResourceResolver* resourceResolver) override;
+
+    /** Resizes the framebuffer.
+
+        @param width   New width in logical pixels
+        @param height  New height in logical pixels
+    */
+    void resize(int width, int height) override;
+
+    /** Clears the framebuffer and starts a new text frame. */
+    void beginFrame() override;
+
+    /** Ends the frame. The framebuffer holds the finished image. */
+    void endFrame() override;
+
+    /** Rasterizes a list of render commands into the framebuffer. */
+    void executeRenderCommands(const RenderList& commandList) override;
+
+    /** Returns true; the framebuffer is preserved between frames. */
+    bool supportsPartialRedraw() const override { return true; }
+
+    /** Returns true; R8_DistanceField atlases are thresholded when text is drawn. */
+    bool supportsDistanceFieldText() const override { return true; }
+
+    /** Limits the next frame to a logical rect, rounded out to whole pixels.
+
+        @param rect  Damaged area; an empty rect repaints the whole framebuffer
+    */
+    void setDamageRect(const Rect& rect) override;
+
+    void* createTexture2D(uint32_t width, uint32_t height, TextureFormat format) override;
+    void updateTexture2D(void* texture, uint32_t x, uint32_t y, uint32_t width, uint32_t height,
+                         const void* data, size_t bytesPerRow) override;
+    void destroyTexture(void* texture) override;
+
+    Vec2 getRenderSize() const override;
+    float getDPIScale() const override { return m_dpiScale; }
+
+    /** Returns true if the renderer has been initialized. */
+    bool isInitialized() const { return m_isInitialized; }
+
+    //======================================================================================
+    // Threading
+
+    /** Sets the number of rasterization threads, including the calling thread.
+
+        @param threadCount  Thread count; 0 selects one per hardware core
+    */
+    void setThreadCount(size_t threadCount);
+
+    /** Returns the number of rasterization threads. */
+    size_t getThreadCount() const;
+
+    //======================================================================================
+    // Framebuffer Access
+
+    /** Returns the RGBA8 framebuffer (getPixelHeight() rows of getBytesPerRow() bytes). */
+    const uint8_t* getPixels() const { return m_framebuffer.data(); }
+
+    int getPixelWidth() const { return m_pixelWidth; }
+    int getPixelHeight() const { return m_pixelHeight; }
+    size_t getBytesPerRow() const { return static_cast<size_t>(m_pixelWidth) * 4; }
+
+    /** Returns the pixel at physical coordinates as RGBA bytes packed into 0xAABBGGRR. */
+    uint32_t getPixel(int x, int y) const;
+
+    /** Returns batch counters for the last executeRenderCommands() call. */
+    const RenderBatchStats& getBatchStats() const;
+
+    /** Returns glyph atlas upload counters, accumulated since initialize(). */
+    const GlyphUploadStats& getGlyphUploadStats() const;
+
+    /** Enables skipping frames identical to the previous one (on by default).
+
+        Benchmarks that re-render one list to time rasterization turn this off.
+    */
+    void setSkipIdenticalFrames(bool enabled);
+
+    /** Selects coverage or distance field glyphs for text drawn from now on.
+
+        @see TextRenderer::setGlyphFormat
+    */
+    void setGlyphFormat(GlyphFormat format);
+
+    /** Returns the glyph format used for new text. */
+    GlyphFormat getGlyphFormat() const;
+
+    /** Writes the text renderer's glyphs and shaped runs to a cache file.
+
+        @see TextRenderer::saveCache
+    */
+    bool saveTextCache(const char* path) const;
+
+    /** Adopts glyphs and shaped runs from a cache file; call after initialize().
+
+        @returns Number of glyphs and runs adopted
+        @see TextRenderer::loadCache
+    */
+    size_t loadTextCache(const char* path);
+
+    /** Rasterizes the glyphs of strings known in advance; call after initialize().
+
+        @returns Number of glyphs queued
+        @see TextRenderer::prewarm
+    */
+    size_t prewarmText(const FontFallbackChain& fallbackChain, const std::vector<float>& fontSizes,
+                       const std::vector<std::string>& strings);
+
+    /** Rasterizes the glyphs of a character set; call after initialize().
+
+        @returns Number of glyphs queued
+        @see TextRenderer::prewarm
+    */
+    size_t prewarmText(const FontFallbackChain& fallbackChain, const std::vector<float>& fontSizes,
+                       const std::vector<uint32_t>& codepoints);
+
+    /** Returns how far the glyphs queued by prewarmText() have been cached. */
+    const TextPrewarmProgress& getTextPrewarmProgress() const;
+
+    /** Returns how many frames were skipped because they matched the previous frame. */
+    uint64_t getSkippedFrameCount() const { return m_skippedFrameCount; }
+
+    /** Returns the span kernel flavor compiled in ("AVX2", "SSE2" or "Scalar"). */
+    static const char* getKernelName();
+
+private:
+    //======================================================================================
+    /** CPU texture storage. */
+    struct Texture {
+        uint32_t width;
+        uint32_t height;
+        TextureFormat format;
+        std::vector<uint8_t> pixels;
+    };
+
+    /** One primitive recovered from a batch (defined in the .cpp). */
+    struct RasterItem;
+
+    void allocateFramebuffer();
+    void buildItems();
+    void binItems();
+    void rasterizeTiles();
+    void drawItem(const RasterItem& item, SoftwareRasterizer& raster) const;
+    Rect quadPixelRect(const Vec2& topLeft, const Vec2& bottomRight) const;
+
+    //======================================================================================
+    std::unique_ptr<TextRenderer> m_textRenderer;          ///< Text shaping and glyph atlas
+    std::unique_ptr<TextureCache> m_textureCache;          ///< Image texture cache
+    std::unique_ptr<RenderBatchCompiler> m_batchCompiler;  ///< Command to batch compiler
+    std::unique_ptr<WorkerPool> m_workerPool;              ///< Tile workers
+    std::vector<std::unique_ptr<SoftwareRasterizer>> m_rasterizers;  ///< One per worker
+
+    std::unordered_map<void*, std::unique_ptr<Texture>> m_textures;  ///< Live textures by handle
+    std::vector<uint8_t> m_framebuffer;                              ///< RGBA8 pixels
+
+    std::vector<RasterItem> m_items;                   ///< Primitives of the current list
+    std::vector<std::vector<uint32_t>> m_tileBins;     ///< Item indices per tile, in list order
+    std::vector<uint32_t> m_activeTiles;               ///< Tiles with work this pass
+    int m_tilesX;
+    int m_tilesY;
+    bool m_clearPending;                               ///< Clear still owed to the framebuffer
+    Rect m_damageRect;                                 ///< Logical damage of this frame (empty = all)
+
+    bool m_skipIdenticalFrames;                        ///< Fingerprint matching enabled
+    size_t m_listsThisFrame;                           ///< executeRenderCommands() calls since beginFrame()
+    bool m_hasLastFrame;                               ///< Last frame was a single list that can be matched
+    uint64_t m_lastFingerprint;                        ///< Fingerprint of that list
+    Rect m_lastDamageRect;                             ///< Damage rect it was drawn with
+    uint64_t m_skippedFrameCount;                      ///< Frames skipped as identical
+
+    bool m_isInitialized;
+    int m_width;
+    int m_height;
+    int m_pixelWidth;
+    int m_pixelHeight;
+    float m_dpiScale;
+    Vec4 m_clearColor;
+};
+
+} // namespace YuchenUI
@@ -23,6 +23,8 @@
     - FontFace: Wraps FreeType FT_Face for glyph rasterization
     - FontCache: Caches HarfBuzz fonts per size with LRU eviction
     
+    FontCoverage records which codepoints a face maps, for font fallback.
+    
     Font pipeline:
     1. FontFile loads raw font data (TTF/OTF/TTC)
     2. FontFace creates FreeType face from font data
@@ -44,6 +46,7 @@
 #include <vector>
 #include <unordered_map>
 #include <list>
+#include <memory>
 
 namespace YuchenUI
 {
@@ -247,6 +250,18 @@ public:
     
     /** Destroys all cached HarfBuzz fonts and clears cache. */
     void clearAll();
+    
+    /** Creates new HarfBuzz font from FreeType face.
+        
+        Sets the face's size, then sets up HarfBuzz font with FreeType callbacks and
+        scale factors. The font reads the face while shaping, so both belong to the
+        same thread. Used by the cache and by TextShaper's per-thread faces.
+        
+        @param ftFace    FreeType face
+        @param fontSize  Font size in points
+        @returns HarfBuzz font handle owned by the caller, or nullptr on error
+    */
+    static hb_font_t* createHarfBuzzFont(FT_Face ftFace, float fontSize);
 
 private:
     //======================================================================================
@@ -260,16 +275,6 @@ private:
         @param sizeKey  Quantized font size key
     */
     void updateLRU(uint32_t sizeKey);
-    
-    /** Creates new HarfBuzz font from FreeType face.
-        
-        Sets up HarfBuzz font with FreeType callbacks and scale factors.
-        
-        @param fontFace  FreeType font face
-        @param fontSize  Font size in points
-        @returns HarfBuzz font handle, or nullptr on error
-    */
-    hb_font_t* createHarfBuzzFont(const FontFace& fontFace, float fontSize);
 
     //======================================================================================
     std::unordered_map<uint32_t, hb_font_t*> m_harfBuzzFonts;  ///< Size key -> HarfBuzz font
@@ -281,4 +286,73 @@ private:
     FontCache& operator=(const FontCache&) = delete;
 };
 
+//==========================================================================================
+/**
+    Sparse bitset of the codepoints a font face maps to a glyph.
+    
+    Answers "does this font have a glyph for this codepoint" with one bit test, which is
+    what font fallback asks for every character of every string. Unicode is split into
+    blocks of BLOCK_SIZE codepoints; a block's bits are read from the face's character
+    map the first time a codepoint inside it is queried, by walking only the codepoints
+    the font actually maps there. Blocks the font does not touch cost no memory, so a
+    Latin font holds a few blocks and a CJK font a few dozen, however much text is seen.
+    
+    Thread safety: Not thread-safe. Reads the face, which is not thread-safe either.
+    
+    @see FontFace, FontManager::hasGlyph
+*/
+class FontCoverage
+{
+public:
+    static constexpr uint32_t BLOCK_SHIFT = 12;                 ///< 4096 codepoints per block
+    static constexpr uint32_t BLOCK_SIZE = 1u << BLOCK_SHIFT;
+    static constexpr uint32_t BLOCK_COUNT = 0x110000 >> BLOCK_SHIFT;
+    
+    /** Creates coverage with no blocks read. */
+    FontCoverage();
+    
+    //======================================================================================
+    /** Tests if the face maps a codepoint to a glyph.
+        
+        Same answer as FT_Get_Char_Index() != 0 on the face's selected character map.
+        
+        @param face       FreeType face the coverage belongs to
+        @param codepoint  Unicode code point
+        @returns True if the face has a glyph for the codepoint
+    */
+    bool contains(FT_Face face, uint32_t codepoint)
+    {
+        if (codepoint >= 0x110000) return false;
+        
+        const uint32_t block = codepoint >> BLOCK_SHIFT;
+        if (!m_blockRead[block]) readBlock(face, block);
+        
+        const uint64_t* bits = m_blocks[block].get();
+        const uint32_t offset = codepoint & (BLOCK_SIZE - 1);
+        return bits && (bits[offset >> 6] >> (offset & 63) & 1) != 0;
+    }
+    
+    /** Forgets every block, e.g. after the face's character map changed. */
+    void clear();
+    
+    //======================================================================================
+    /** Returns the number of blocks read from the character map. */
+    size_t getReadBlockCount() const;
+    
+    /** Returns the bytes held by bit storage. */
+    size_t getMemoryUsage() const;
+
+private:
+    //======================================================================================
+    /** Reads one block's bits from the face's character map. */
+    void readBlock(FT_Face face, uint32_t block);
+    
+    //======================================================================================
+    bool m_blockRead[BLOCK_COUNT];                          ///< True once a block has been read
+    std::unique_ptr<uint64_t[]> m_blocks[BLOCK_COUNT];      ///< Block bits, null if the font maps none
+
+    FontCoverage(const FontCoverage&) = delete;
+    FontCoverage& operator=(const FontCoverage&) = delete;
+};
+
 } // namespace YuchenUI
@@ -21,10 +21,11 @@ struct FontEntry {
     std::unique_ptr<FontFile> file;
     std::unique_ptr<FontFace> face;
     std::unique_ptr<FontCache> cache;
+    std::unique_ptr<FontCoverage> coverage;
     std::string name;
     bool isValid;
     
-    FontEntry() : file(nullptr), face(nullptr), cache(nullptr), name(), isValid(false) {}
+    FontEntry() : file(nullptr), face(nullptr), cache(nullptr), coverage(nullptr), name(), isValid(false) {}
 };
 
 class FontManager : public IFontProvider {
@@ -43,9 +44,11 @@ public:
     FontMetrics getFontMetrics(FontHandle handle, float fontSize) const override;
     GlyphMetrics getGlyphMetrics(FontHandle handle, uint32_t codepoint, float fontSize) const override;
     Vec2 measureText(const char* text, float fontSize) const override;
+    void measureCaretStops(const char* text, float fontSize, std::vector<float>& outStops) const override;
     float getTextHeight(FontHandle handle, float fontSize) const override;
     
     void* getFontFace(FontHandle handle) const override;
+    bool getFontData(FontHandle handle, const void*& outData, size_t& outSize) const override;
     void* getHarfBuzzFont(FontHandle handle, float fontSize, float dpiScale) override;
     
     bool hasGlyph(FontHandle handle, uint32_t codepoint) const override;
@@ -78,7 +81,7 @@ private:
     void loadCJKFont();
     void loadSymbolFont();
     
-    bool hasGlyphImpl(FontHandle handle, uint32_t codepoint) const;
+    bool shapeForMeasurement(const TextSegment& segment, float fontSize, hb_buffer_t* buffer) const;
     
 #ifdef __APPLE__
     std::string getCoreTextFontPath(const char* fontName) const;
@@ -96,8 +99,6 @@ private:
     FontHandle m_defaultNarrowBoldFont;
     FontHandle m_defaultCJKFont;
     FontHandle m_defaultSymbolFont;
-    
-    mutable std::unordered_map<uint64_t, bool> m_glyphAvailabilityCache;
 };
 
 }
@@ -19,20 +19,46 @@
     GPU texture atlas cache for rasterized glyphs.
     
     Manages dynamic texture atlases for glyph bitmap storage. Rasterized glyphs packed
-    into GPU textures using simple row-based packing algorithm. Supports multiple atlases
-    when single atlas fills up. Implements frame-based LRU expiration for unused glyphs.
+    into GPU textures with a shelf allocator. Supports multiple atlases when single atlas
+    fills up. Implements frame-based LRU expiration for unused glyphs.
+    
+    Version 2.0 Changes:
+    - Shelf packer with per-shelf free lists replaces the single-cursor row packer
+    - Expired glyphs return their space to the packer
+    - Fragmented atlases are re-packed from a CPU copy of their texture
+    - Atlas pressure evicts glyphs unused last frame instead of dropping new glyphs
+    - Per-atlas size and texture accessors for glyphs outside the first atlas
+    
+    Version 2.1 Changes:
+    - New glyphs are written to the CPU copy and marked dirty instead of uploaded at once
+    - Dirty regions merge and are uploaded together by flushUploads()
+    - Upload counts and bytes exposed through GlyphUploadStats
+    
+    Version 2.2 Changes:
+    - Atlases have a texture format; distance field glyphs live in R8_DistanceField
+      atlases, never mixed with coverage glyphs
+    - save() and load() move glyphs through a persistent text cache file
+    - Pinned glyphs (pinGlyph) skip periodic expiration until first drawn
     
     Packing algorithm:
-    - Row-based left-to-right packing with configurable padding
-    - Advances to new row when current row full
-    - Creates new atlas when current atlas full (up to MAX_ATLASES)
-    - No defragmentation - relies on periodic cleanup
+    - Shelf packing with configurable padding (see ShelfPacker)
+    - Creates new atlas when existing atlases full (up to MAX_ATLASES)
+    - Re-packs atlases whose shelves are more than DEFRAG_THRESHOLD holes
     
     Lifecycle:
     1. Cache glyphs on demand during text rendering
     2. Mark glyphs used each frame via getGlyph()
     3. Expire unused glyphs after GLYPH_EXPIRE_FRAMES
     4. Cleanup runs every CLEANUP_INTERVAL_FRAMES
+    5. If a glyph found no space, the next frame evicts glyphs unused last frame
+    6. Cleanup and eviction are followed by re-packing of fragmented atlases
+    7. Dirty atlas regions are uploaded once per frame by flushUploads()
+    
+    Re-packing moves glyphs, so it only runs in beginFrame(), never between
+    vertex generation and drawing.
+    
+    Uploads are deferred: cacheGlyph() only writes the CPU copy. Call flushUploads()
+    after generating vertices and before drawing them; beginFrame() also flushes.
     
     Atlas size scales with DPI: BASE_ATLAS_SIZE * dpiScale
 */
@@ -41,6 +67,8 @@
 
 #include "YuchenUI/core/Types.h"
 #include "YuchenUI/core/Config.h"
+#include "YuchenUI/text/ShelfPacker.h"
+#include <functional>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -48,23 +76,79 @@
 namespace YuchenUI {
 
 class IGraphicsBackend;
+class TextCacheWriter;
+class TextCacheReader;
+
+//==========================================================================================
+/** Rectangle of an atlas whose CPU copy is newer than its texture. */
+struct AtlasRegion
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+    
+    uint64_t area() const { return static_cast<uint64_t>(width) * height; }
+};
+
+//==========================================================================================
+/** Glyph atlas texture with its packer and CPU copy.
+
+    The CPU copy is the source of every upload, so fragmented atlases can be re-packed
+    without reading the texture back and new glyphs can be uploaded in batches.
+*/
+struct GlyphAtlas
+{
+    uint32_t width;
+    uint32_t height;
+    TextureFormat format;           ///< R8_Unorm coverage or R8_DistanceField
+    ShelfPacker packer;             ///< Space allocator
+    std::vector<uint8_t> pixels;    ///< CPU copy of the texture (R8, tightly packed rows)
+    std::vector<AtlasRegion> dirty; ///< Regions not yet uploaded, pairwise disjoint
+    size_t glyphCount;              ///< Glyphs with bitmaps in this atlas
+    void* textureHandle;            ///< Graphics backend texture handle
+
+    GlyphAtlas(uint32_t w, uint32_t h, TextureFormat fmt = TextureFormat::R8_Unorm)
+        : width(w), height(h), format(fmt), packer(w, h), pixels(static_cast<size_t>(w) * h, 0), dirty(), glyphCount(0), textureHandle(nullptr) {
+    }
+
+    void reset()
+    {
+        packer.reset();
+        glyphCount = 0;
+    }
+};
+
+//==========================================================================================
+/** Glyph atlas upload counters.
+
+    Accumulate until GlyphCache::resetUploadStats().
+*/
+struct GlyphUploadStats
+{
+    uint64_t glyphsWritten = 0;   ///< Glyph bitmaps written to atlas CPU copies
+    uint64_t uploadCount = 0;     ///< updateTexture2D() calls
+    uint64_t uploadBytes = 0;     ///< Texel bytes passed to updateTexture2D()
+    uint64_t flushCount = 0;      ///< flushUploads() calls that uploaded anything
+};
 
 //==========================================================================================
 /**
     GPU texture atlas cache for glyphs.
     
     GlyphCache manages dynamic GPU texture atlases for storing rasterized glyph bitmaps.
-    Uses simple row-based packing and frame-based expiration. Each atlas is R8 grayscale
-    texture used as alpha mask for text rendering.
+    Uses shelf packing and frame-based expiration. Each atlas is an R8 texture, either a
+    grayscale alpha mask or, for GlyphFormat::SignedDistance glyphs, a distance field.
     
     Key features:
     - Dynamic atlas creation up to MAX_ATLASES limit
-    - Row-based packing with configurable padding
+    - Shelf packing with configurable padding and space reuse
     - Frame-based LRU expiration
     - Periodic cleanup of expired glyphs
+    - Re-packing of fragmented atlases
     - DPI-aware atlas sizing
     
-    Cache key: (FontHandle, GlyphIndex, FontSize * 64)
+    Cache key: (FontHandle, GlyphIndex, FontSize * 64, Boldness, Format)
     Expiration: Unused glyphs removed after GLYPH_EXPIRE_FRAMES
     Cleanup: Runs every CLEANUP_INTERVAL_FRAMES
     
@@ -96,7 +180,8 @@ public:
     //======================================================================================
     /** Retrieves cached glyph entry.
         
-        Marks glyph as used in current frame for LRU tracking.
+        Marks glyph as used in current frame for LRU tracking, and ends its pin: from
+        its first use on, a pinned glyph expires like any other.
         
         @param key  Glyph cache key
         @returns Pointer to cache entry, or nullptr if not cached
@@ -107,23 +192,55 @@ public:
         
         Allocates space in atlas, uploads bitmap to GPU, and stores cache entry.
         Handles empty glyphs (zero-size bitmaps) by storing metadata only.
-        Creates new atlas if current atlas full.
+        Creates new atlas if current atlas full. The glyph goes to an atlas whose
+        format matches key.format.
         
         @param key          Glyph cache key
-        @param bitmapData   Glyph bitmap buffer (R8 format), or nullptr for empty glyph
+        @param bitmapData   Glyph bitmap buffer (R8 coverage or distance), or nullptr for empty glyph
         @param size         Bitmap dimensions in pixels
         @param bearing      Glyph bearing (offset from baseline)
         @param advance      Horizontal advance for next glyph
     */
     void cacheGlyph(const GlyphKey& key, const void* bitmapData, const Vec2& size, const Vec2& bearing, float advance);
     
+    /** Keeps a cached glyph through periodic expiration.
+        
+        Meant for glyphs cached ahead of use (TextRenderer::prewarm), which would
+        otherwise expire before the text that needs them is first drawn. Atlas pressure
+        still evicts pinned glyphs unused last frame, so pins never make the cache fail
+        to place a glyph that is on screen. The pin lasts until getGlyph() first
+        returns the glyph.
+        
+        @param key  Glyph cache key
+        @returns False if the glyph is not cached
+    */
+    bool pinGlyph(const GlyphKey& key);
+    
     /** Advances frame counter and triggers periodic cleanup.
         
         Call at start of each frame before text rendering. Runs cleanup every
-        CLEANUP_INTERVAL_FRAMES to remove expired glyphs.
+        CLEANUP_INTERVAL_FRAMES to remove expired glyphs, evicts glyphs unused last
+        frame if a glyph found no space during it, and then re-packs fragmented atlases.
     */
     void beginFrame();
     
+    /** Uploads every dirty atlas region to its texture.
+        
+        Call after generating text vertices and before drawing them. Adjacent dirty
+        regions have already been merged, so a frame's new glyphs usually cost one
+        upload per atlas they landed in.
+    */
+    void flushUploads();
+    
+    /** Returns true if some atlas region has not been uploaded yet. */
+    bool hasPendingUploads() const;
+    
+    /** Returns upload counters. */
+    const GlyphUploadStats& getUploadStats() const { return m_uploadStats; }
+    
+    /** Zeroes the upload counters. */
+    void resetUploadStats();
+    
     //======================================================================================
     /** Returns dimensions of current atlas texture.
         
@@ -137,6 +254,73 @@ public:
     */
     void* getCurrentAtlasTexture() const;
     
+    /** Returns dimensions of an atlas texture.
+        
+        Glyph UVs must be normalized against the atlas named by the entry's
+        atlasIndex, not the current atlas.
+        
+        @param atlasIndex  Atlas index from GlyphCacheEntry::atlasIndex
+        @returns Atlas size in pixels (width, height)
+    */
+    Vec2 getAtlasSize(size_t atlasIndex) const;
+    
+    /** Returns opaque handle to an atlas texture.
+        
+        @param atlasIndex  Atlas index from GlyphCacheEntry::atlasIndex
+        @returns GPU texture handle, or nullptr if no such atlas exists
+    */
+    void* getAtlasTexture(size_t atlasIndex) const;
+    
+    /** Returns the texture format of an atlas.
+        
+        @param atlasIndex  Atlas index from GlyphCacheEntry::atlasIndex
+        @returns R8_DistanceField for distance field atlases, R8_Unorm otherwise
+    */
+    TextureFormat getAtlasFormat(size_t atlasIndex) const;
+    
+    //======================================================================================
+    /** Returns number of atlas textures created. */
+    size_t getAtlasCount() const;
+    
+    /** Returns number of cached glyphs, including empty ones. */
+    size_t getGlyphCount() const;
+    
+    /** Returns shelf fragmentation of an atlas (see ShelfPacker::getFragmentation).
+        
+        @param atlasIndex  Atlas index
+        @returns Fraction of shelf area not covered by glyphs
+    */
+    float getAtlasFragmentation(size_t atlasIndex) const;
+    
+    /** Returns the CPU copy of an atlas texture (R8, width * height bytes).
+        
+        @param atlasIndex  Atlas index
+    */
+    const std::vector<uint8_t>& getAtlasPixels(size_t atlasIndex) const;
+    
+    //======================================================================================
+    /** Appends every cached glyph, with its bitmap, to a text cache file.
+        
+        Glyphs are written tallest first per format, the order load() packs them in.
+        
+        @param writer  Cache file being built
+    */
+    void save(TextCacheWriter& writer) const;
+    
+    /** Adopts the glyphs of a text cache file section written by save().
+        
+        Accepted glyphs that are not cached yet are packed into atlases of their format,
+        copied straight from the reader's bytes, and each atlas that received glyphs is
+        marked dirty as one region, so the next flushUploads() sends it in one call.
+        Glyphs that find no atlas space are skipped; nothing is evicted for them.
+        
+        @param reader      Cache file positioned at the glyph section
+        @param acceptFont  Returns false for fonts whose glyphs must be skipped
+        @param outAdopted  Receives the number of glyphs adopted
+        @returns False if the section is malformed; glyphs adopted before that stay cached
+    */
+    bool load(TextCacheReader& reader, const std::function<bool(FontHandle)>& acceptFont, size_t& outAdopted);
+    
 private:
     //======================================================================================
     /** Returns scaled atlas width based on DPI.
@@ -155,47 +339,67 @@ private:
         
         Creates R8 texture at scaled dimensions. Marks first atlas as current.
         Fails silently if MAX_ATLASES limit reached.
+        
+        @param format  R8_Unorm for coverage glyphs, R8_DistanceField for distance fields
     */
-    void createNewAtlas();
+    void createNewAtlas(TextureFormat format = TextureFormat::R8_Unorm);
     
-    /** Finds atlas with space for glyph of specified size.
+    /** Allocates padded space for a glyph in the first atlas of a format with room.
         
-        Checks current row and potential new row for space. Marks atlas full
-        if glyph cannot fit.
-        
-        @param width   Glyph width in pixels
-        @param height  Glyph height in pixels
-        @returns Pointer to atlas with space, or nullptr if none available
+        @param format         Atlas format the glyph needs
+        @param width          Glyph width in pixels (excluding padding)
+        @param height         Glyph height in pixels (excluding padding)
+        @param outAtlasIndex  Receives the atlas index
+        @param outRect        Receives the glyph rectangle (excluding padding)
+        @returns False if no existing atlas has room
     */
-    GlyphAtlas* findAtlasWithSpace(uint32_t width, uint32_t height);
+    bool allocateGlyph(TextureFormat format, uint32_t width, uint32_t height, uint32_t& outAtlasIndex, Rect& outRect);
+    
+    /** Returns a glyph's padded space to its atlas. */
+    void releaseGlyph(const GlyphCacheEntry& entry);
     
-    /** Allocates space in atlas for glyph.
+    /** Copies a glyph bitmap into the atlas copy, clearing its padding, without marking it dirty.
         
-        Updates atlas packing state (currentX, currentY, rowHeight). Advances
-        to new row if glyph doesn't fit in current row.
+        @param atlas        Target atlas
+        @param rect         Glyph rectangle (excluding padding)
+        @param bitmapData   Glyph bitmap data (R8 format, rows of rect.width bytes)
+        @returns The padded cell that was written
+    */
+    static AtlasRegion copyGlyphBitmap(GlyphAtlas* atlas, const Rect& rect, const void* bitmapData);
+    
+    /** Writes glyph bitmap into the atlas copy and marks it dirty with its cleared padding.
         
-        @param atlas     Atlas to allocate from
-        @param width     Glyph width in pixels (excluding padding)
-        @param height    Glyph height in pixels (excluding padding)
-        @param outRect   Output rectangle with padding applied
+        @param atlas        Target atlas
+        @param rect         Glyph rectangle (excluding padding)
+        @param bitmapData   Glyph bitmap data (R8 format, rows of rect.width bytes)
     */
-    void addGlyphToAtlas(GlyphAtlas* atlas, uint32_t width, uint32_t height, Rect& outRect);
+    void writeGlyphBitmap(GlyphAtlas* atlas, const Rect& rect, const void* bitmapData);
     
-    /** Uploads glyph bitmap to atlas texture.
+    /** Adds a region to an atlas's dirty list, merging it with regions it touches or
+        nearly fills a bounding box with (see DIRTY_MERGE_SLACK).
+    */
+    static void markDirty(GlyphAtlas& atlas, AtlasRegion region);
+    
+    /** Uploads a region of an atlas's CPU copy to its texture. */
+    void uploadAtlasRegion(GlyphAtlas* atlas, const AtlasRegion& region);
+    
+    /** Re-packs every atlas whose fragmentation crossed DEFRAG_THRESHOLD. */
+    void defragmentAtlases();
+    
+    /** Re-packs the live glyphs of one atlas, tallest first, and marks it all dirty.
         
-        Uses graphics backend to update texture region.
+        Glyphs keep their atlas; only their texture rectangles change.
         
-        @param atlas        Target atlas
-        @param rect         Texture region to update
-        @param bitmapData   Glyph bitmap data (R8 format)
+        @param atlasIndex  Atlas to re-pack
     */
-    void uploadGlyphBitmap(GlyphAtlas* atlas, const Rect& rect, const void* bitmapData);
+    void repackAtlas(uint32_t atlasIndex);
     
-    /** Removes glyphs unused for GLYPH_EXPIRE_FRAMES.
+    /** Removes glyphs unused for more than expireFrames and frees their space.
         
-        Iterates cache and removes expired entries. Does not defragment atlases.
+        @param expireFrames  Frames a glyph may go unused
+        @param evictPinned   True to remove pinned glyphs as well
     */
-    void cleanupExpiredGlyphs();
+    void cleanupExpiredGlyphs(uint32_t expireFrames = Config::GlyphCache::GLYPH_EXPIRE_FRAMES, bool evictPinned = false);
     
     /** Clears all cached glyphs and resets all atlases.
         
@@ -217,6 +421,8 @@ private:
     size_t m_currentAtlasIndex;                                               ///< Current atlas for rendering
     std::unordered_map<GlyphKey, GlyphCacheEntry, GlyphKeyHash> m_glyphCache; ///< Glyph cache entries
     uint32_t m_currentFrame;                                                  ///< Frame counter for LRU
+    bool m_atlasPressure;                                                     ///< A glyph found no space this frame
+    GlyphUploadStats m_uploadStats;                                           ///< Upload counters
 };
 
 } // namespace YuchenUI
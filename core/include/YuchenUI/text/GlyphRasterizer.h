@@ -0,0 +1,186 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file GlyphRasterizer.h
+
+    Parallel FreeType glyph rasterization.
+
+    FT_Face objects are not thread-safe, so each worker thread owns its own FT_Library
+    and opens its own FT_Face over the font bytes the font provider already holds. The
+    bytes are shared, never copied. Workers only produce bitmaps; packing them into the
+    glyph atlas and uploading stay on the thread that owns the GlyphCache.
+
+    Two ways to use it:
+    - rasterize() runs a batch of misses across the workers and waits for it
+    - submit() queues misses on a background dispatcher; collect() picks up finished
+      bitmaps later, so a frame can draw without the glyphs and the next frame shows them
+
+    Keys with GlyphFormat::SignedDistance produce an 8-bit distance field instead of a
+    coverage bitmap, SDF_SPREAD pixels larger on every side.
+*/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include "YuchenUI/core/Config.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace YuchenUI {
+
+class WorkerPool;
+
+//==========================================================================================
+/** One glyph to rasterize.
+
+    The font bytes must stay valid until the result has been collected. Fonts loaded by
+    FontManager are never unloaded, so their bytes live as long as the manager.
+*/
+struct GlyphRasterJob {
+    GlyphKey key;               ///< Font, glyph index, 26.6 size and embolden strength
+    const void* fontData;       ///< Font file bytes (not owned)
+    size_t fontDataSize;        ///< Font file size in bytes
+};
+
+/** Rasterized glyph bitmap and metrics. */
+struct RasterizedGlyph {
+    GlyphKey key;                   ///< Key the bitmap belongs to
+    std::vector<uint8_t> bitmap;    ///< R8 rows of size.x bytes, empty for blank glyphs
+    Vec2 size;                      ///< Bitmap size in pixels
+    Vec2 bearing;                   ///< Offset from pen position to bitmap top left
+    float advance;                  ///< Horizontal advance in pixels
+    bool isValid;                   ///< False if FreeType could not produce the glyph
+
+    RasterizedGlyph() : key(INVALID_FONT_HANDLE, 0, 0.0f), bitmap(), size(), bearing(), advance(0.0f), isValid(false) {}
+};
+
+//==========================================================================================
+/**
+    Worker pool that rasterizes glyphs with per-thread FreeType instances.
+
+    Thread safety: rasterize(), submit(), collect() and the queries may be called from
+    the owning thread while a submitted batch is being rasterized in the background.
+    Results are never cached here; the caller hands them to GlyphCache.
+
+    @see TextRenderer, GlyphCache
+*/
+class GlyphRasterizer {
+public:
+    //======================================================================================
+    /** Creates the rasterizer. Threads and FreeType instances start on first use.
+
+        @param threadCount  Rasterization threads including the caller (0 = hardware)
+    */
+    explicit GlyphRasterizer(size_t threadCount = Config::Text::RASTER_THREADS);
+
+    /** Waits for the background batch, if any, and releases every FreeType instance. */
+    ~GlyphRasterizer();
+
+    GlyphRasterizer(const GlyphRasterizer&) = delete;
+    GlyphRasterizer& operator=(const GlyphRasterizer&) = delete;
+
+    //======================================================================================
+    /** Rasterizes a batch across the workers and waits for it.
+
+        @param jobs     Glyphs to rasterize
+        @param results  Receives one result per job, in job order (resized)
+    */
+    void rasterize(const std::vector<GlyphRasterJob>& jobs, std::vector<RasterizedGlyph>& results);
+
+    /** Queues glyphs for background rasterization and returns at once.
+
+        Keys that are already queued, in flight or waiting to be collected are skipped.
+
+        @param jobs  Glyphs to rasterize
+    */
+    void submit(const std::vector<GlyphRasterJob>& jobs);
+
+    /** Moves every finished background result into results (appended).
+
+        @param results  Receives finished glyphs
+        @returns Number of glyphs appended
+    */
+    size_t collect(std::vector<RasterizedGlyph>& results);
+
+    /** Returns true if a key was submitted and has not been collected yet. */
+    bool isPending(const GlyphKey& key) const;
+
+    /** Returns the number of submitted glyphs not collected yet. */
+    size_t getPendingCount() const;
+
+    /** Returns the number of rasterization threads, including the caller. */
+    size_t getThreadCount() const { return m_threadCount; }
+
+    //======================================================================================
+    /** Rasterizes one glyph with the given face on the calling thread.
+
+        Applies the key's embolden strength to outline glyphs and renders 8-bit coverage,
+        or a distance field without emboldening for GlyphFormat::SignedDistance keys.
+
+        @param face    Opaque FT_Face pointer, used by this thread only
+        @param key     Glyph key (size is taken from key.quantizedSize)
+        @param result  Receives the bitmap and metrics
+        @returns False if FreeType failed; result.isValid is false too
+    */
+    static bool rasterizeGlyph(void* face, const GlyphKey& key, RasterizedGlyph& result);
+
+    /** Converts an 8-bit coverage bitmap into a signed distance field.
+
+        The field is spread pixels larger than the bitmap on every side. Texels store
+        0.5 - distance / (2 * spread), clamped, where distance is the Euclidean distance
+        in pixels to the 50% coverage edge and is negative inside the glyph: 128 is the
+        edge, 255 is spread pixels inside, 0 is spread pixels or more outside.
+
+        @param coverage  Coverage rows of width bytes
+        @param width     Bitmap width in pixels
+        @param height    Bitmap height in pixels
+        @param spread    Distance range and border width in pixels
+        @param field     Receives (width + 2 * spread) * (height + 2 * spread) bytes
+    */
+    static void makeDistanceField(const uint8_t* coverage, uint32_t width, uint32_t height,
+                                  uint32_t spread, std::vector<uint8_t>& field);
+
+private:
+    //======================================================================================
+    /** FreeType state owned by one worker thread. */
+    struct WorkerState;
+
+    void ensureWorkers();
+    void dispatcherLoop();
+
+    /** Runs jobs on the pool; the caller must hold m_poolMutex. */
+    void runBatch(const std::vector<GlyphRasterJob>& jobs, std::vector<RasterizedGlyph>& results);
+
+    //======================================================================================
+    size_t m_threadCount;
+    std::unique_ptr<WorkerPool> m_pool;                     ///< Created on first batch
+    std::vector<std::unique_ptr<WorkerState>> m_workers;    ///< One per pool worker
+    std::mutex m_poolMutex;                                 ///< One batch on the pool at a time
+
+    std::thread m_dispatcher;                               ///< Background batch runner, started on first submit
+    mutable std::mutex m_queueMutex;
+    std::condition_variable m_queueCondition;
+    std::vector<GlyphRasterJob> m_queued;                   ///< Submitted, not started
+    std::vector<RasterizedGlyph> m_completed;               ///< Finished, not collected
+    std::unordered_set<GlyphKey, GlyphKeyHash> m_pending;   ///< Submitted, not collected
+    bool m_stopping;
+};
+
+} // namespace YuchenUI
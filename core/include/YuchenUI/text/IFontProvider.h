@@ -21,6 +21,11 @@ public:
     virtual FontMetrics getFontMetrics(FontHandle handle, float fontSize) const = 0;
     virtual GlyphMetrics getGlyphMetrics(FontHandle handle, uint32_t codepoint, float fontSize) const = 0;
     virtual Vec2 measureText(const char* text, float fontSize) const = 0;
+    
+    /** Shapes text once and writes the caret x offset before every codepoint, then the
+        total width (measureText() width): one more stop than codepoints. Codepoints that
+        share a cluster, like a ligature, split its advance evenly. */
+    virtual void measureCaretStops(const char* text, float fontSize, std::vector<float>& outStops) const = 0;
     virtual float getTextHeight(FontHandle handle, float fontSize) const = 0;
     
     virtual bool hasGlyph(FontHandle handle, uint32_t codepoint) const = 0;
@@ -43,6 +48,7 @@ public:
     virtual void printAvailableFonts() const = 0;
     
     virtual void* getFontFace(FontHandle handle) const = 0;
+    virtual bool getFontData(FontHandle handle, const void*& outData, size_t& outSize) const = 0;
     virtual void* getHarfBuzzFont(FontHandle handle, float fontSize, float dpiScale) = 0;
 };
 
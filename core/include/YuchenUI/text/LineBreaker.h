@@ -0,0 +1,137 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file LineBreaker.h
+
+    Line breaking for one paragraph of text.
+
+    A paragraph is shaped once, through IFontProvider::measureCaretStops(), which gives
+    the x position of every codepoint boundary. The width of any run of text is then the
+    difference of two stops, so fitting lines to a width needs no further shaping and a
+    new width only repeats the fitting.
+
+    Break opportunities follow a subset of the Unicode line breaking algorithm (UAX #14):
+    - After spaces, never before them; spaces at the end of a line hang past the width
+    - Before and after every ideograph, kana, Hangul syllable and emoji
+    - Never before closing punctuation or small kana, never after opening punctuation
+    - After hyphens and dashes, except before a digit ("1-5") or at a word start ("-flag")
+    - Never before a combining mark, variation selector or zero width joiner
+
+    A word wider than the line is broken between codepoints as a last resort.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace YuchenUI {
+
+class IFontProvider;
+
+//==========================================================================================
+/** One line of a paragraph, as a byte range of the paragraph text. */
+struct LineBreakSpan {
+    size_t byteStart;       ///< Offset of the first byte
+    size_t byteLength;      ///< Bytes up to the last visible character; hanging spaces excluded
+    float width;            ///< Width of those bytes
+
+    LineBreakSpan() : byteStart(0), byteLength(0), width(0.0f) {}
+    LineBreakSpan(size_t start, size_t length, float lineWidth)
+        : byteStart(start), byteLength(length), width(lineWidth) {}
+};
+
+//==========================================================================================
+/**
+    Shapes a paragraph once and breaks it into lines at any width.
+
+    The shaping result and break opportunities are kept until the next setParagraph(),
+    and the lines of the last width are kept until the width changes. A paragraph that
+    fits on one line at both the old and the new width is not fitted again.
+
+    Example:
+    @code
+    LineBreaker breaker;
+    breaker.setParagraph(text, fontProvider, 14.0f);
+    for (const LineBreakSpan& line : breaker.breakLines(200.0f))
+        draw(text.substr(line.byteStart, line.byteLength));
+    @endcode
+
+    @see TextBlock, IFontProvider::measureCaretStops
+*/
+class LineBreaker {
+public:
+    //======================================================================================
+    /** Creates a breaker with an empty paragraph. */
+    LineBreaker();
+
+    //======================================================================================
+    /** Shapes a paragraph and finds its break opportunities.
+
+        @param text          UTF-8 paragraph without line feeds
+        @param fontProvider  Provider measuring the text
+        @param fontSize      Font size in points
+    */
+    void setParagraph(const std::string& text, IFontProvider* fontProvider, float fontSize);
+
+    /** Returns the paragraph text. */
+    const std::string& getText() const { return m_text; }
+
+    /** Returns the font size the paragraph was shaped at. */
+    float getFontSize() const { return m_fontSize; }
+
+    /** Returns the width of the whole paragraph on one line, hanging spaces excluded. */
+    float getNaturalWidth() const { return m_naturalWidth; }
+
+    //======================================================================================
+    /** Breaks the paragraph into lines no wider than maxWidth.
+
+        Lines only exceed maxWidth where a single codepoint is wider. An empty paragraph
+        has no lines.
+
+        @param maxWidth  Line width
+        @returns The lines, valid until the next call or setParagraph()
+    */
+    const std::vector<LineBreakSpan>& breakLines(float maxWidth);
+
+    //======================================================================================
+    /** Finds the break opportunities of a codepoint sequence.
+
+        @param codepoints  Codepoints of one paragraph
+        @param count       Number of codepoints
+        @param outBreaks   Receives count + 1 flags; flag i is nonzero if a line may start
+                           at codepoint i. The first and last flags are always zero.
+    */
+    static void findBreakOpportunities(const uint32_t* codepoints, size_t count, std::vector<uint8_t>& outBreaks);
+
+private:
+    //======================================================================================
+    void fitLines(float maxWidth);
+
+    std::string m_text;
+    float m_fontSize;
+    std::vector<uint32_t> m_codepoints;
+    std::vector<uint32_t> m_byteOffsets;    ///< Byte offset of each codepoint, then the end
+    std::vector<float> m_stops;             ///< Caret stop of each codepoint, then the width
+    std::vector<uint8_t> m_breaks;
+    float m_naturalWidth;
+    std::vector<LineBreakSpan> m_lines;
+    float m_linesWidth;                     ///< Width m_lines was fitted for, negative if none
+};
+
+} // namespace YuchenUI
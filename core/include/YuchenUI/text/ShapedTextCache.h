@@ -0,0 +1,243 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file ShapedTextCache.h
+
+    Byte-budgeted LRU cache of shaped text runs.
+
+    Shaping is the expensive half of drawing a string, and most UI text repeats from frame
+    to frame. Strings that change constantly (meter readouts, timecode, SpinBox values)
+    would grow an unbounded cache for the life of the session, so this cache keeps the
+    total size of its runs under a byte budget and evicts the least recently used run
+    when a new one does not fit.
+
+    Lookups hash the caller's text in place and allocate nothing; the text and font
+    handles are copied into the entry only when a new run is stored.
+
+    Runs are handed out as shared immutable ShapedText objects. A cache hit costs one
+    reference count increment instead of a glyph vector copy, and a run evicted while a
+    caller still holds it stays alive until the caller lets go.
+*/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include "YuchenUI/core/Config.h"
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/** Cache key for shaped text results.
+
+    A key is a view: it points at the caller's text bytes and font handles instead of
+    copying them, so building one for a lookup allocates nothing. The hash is computed
+    straight from the bytes (length-prefixed, a word at a time), and equality compares
+    the text, fonts, size and spacing in full once the hashes match, so a collision can
+    never return another string's glyphs.
+
+    Keys stored in ShapedTextCache are rebased onto bytes the cache entry owns.
+*/
+struct TextCacheKey {
+    std::string_view text;       ///< UTF-8 text (not owned)
+    const FontHandle* fonts;     ///< Fallback chain fonts (not owned)
+    uint32_t fontCount;          ///< Number of fonts
+    uint32_t fontSizeBits;       ///< Font size as raw float bits
+    uint32_t letterSpacingBits;  ///< Letter spacing as raw float bits
+    uint64_t hash;               ///< Hash of all of the above
+
+    /** Creates cache key from text rendering parameters.
+
+        Size and spacing are keyed by their exact values, the same ones the text is shaped
+        with, so runs shaped at different spacings never share an entry.
+
+        @param text              UTF-8 text (must outlive the key)
+        @param fallbackChain     Font fallback chain (must outlive the key)
+        @param fontSize          Font size in points
+        @param letterSpacing     Letter spacing in thousandths of em
+    */
+    TextCacheKey(std::string_view text, const FontFallbackChain& fallbackChain,
+                 float fontSize, float letterSpacing = 0.0f);
+
+    /** Creates cache key from a null-terminated string. */
+    TextCacheKey(const char* text, const FontFallbackChain& fallbackChain,
+                 float fontSize, float letterSpacing = 0.0f);
+
+    bool operator==(const TextCacheKey& other) const;
+
+private:
+    friend class ShapedTextCache;
+
+    /** Returns a copy of this key viewing the given storage, which must hold equal bytes. */
+    TextCacheKey rebased(std::string_view ownedText, const FontHandle* ownedFonts) const;
+};
+
+/** Hash functor for TextCacheKey. */
+struct TextCacheKeyHash {
+    size_t operator()(const TextCacheKey& key) const { return static_cast<size_t>(key.hash); }
+};
+
+/** Shared, immutable shaped text run. */
+using ShapedTextRef = std::shared_ptr<const ShapedText>;
+
+//==========================================================================================
+/** Shaped text cache counters.
+
+    Hits, misses and evictions accumulate until resetStats(); bytes and entries describe
+    the cache as it is now.
+*/
+struct ShapedTextCacheStats {
+    uint64_t hits = 0;         ///< Lookups answered from the cache
+    uint64_t misses = 0;       ///< Lookups that had to shape
+    uint64_t evictions = 0;    ///< Runs dropped to stay within the budget
+    size_t bytesUsed = 0;      ///< Estimated bytes held by cached runs
+    size_t byteBudget = 0;     ///< Current byte budget
+    size_t entryCount = 0;     ///< Cached runs
+};
+
+//==========================================================================================
+/**
+    Byte-budgeted LRU cache of shaped text runs.
+
+    Entries live in a recency list with a hash index into it; a hit splices its entry to
+    the front and an insert evicts from the back until the new run fits. Run sizes are
+    estimated from the glyph vector capacity plus per-entry bookkeeping, so the budget
+    tracks real heap use rather than entry count.
+
+    A run larger than the whole budget is returned to the caller but not cached.
+
+    Thread safety: Not thread-safe. Owned and used by TextRenderer.
+
+    @see TextRenderer, TextCacheKey
+*/
+class ShapedTextCache {
+public:
+    //======================================================================================
+    /** Creates an empty cache.
+
+        @param byteBudget  Maximum estimated bytes of cached runs
+    */
+    explicit ShapedTextCache(size_t byteBudget = Config::Text::SHAPED_TEXT_CACHE_BYTES);
+
+    //======================================================================================
+    /** Looks up a shaped run and marks it most recently used.
+
+        Counts a hit or a miss.
+
+        @param key  Cache key of the text
+        @returns The cached run, or nullptr on a miss
+    */
+    ShapedTextRef find(const TextCacheKey& key);
+
+    /** Returns true if a run is cached under the key.
+
+        Counts nothing and leaves recency alone, so a pre-pass can skip cached text
+        without disturbing the statistics of the lookups that follow.
+
+        @param key  Cache key of the text
+    */
+    bool contains(const TextCacheKey& key) const { return m_index.count(key) != 0; }
+
+    /** Returns the run cached under the key without counting or touching recency.
+
+        @param key  Cache key of the text
+        @returns The cached run, or nullptr if none
+    */
+    ShapedTextRef peek(const TextCacheKey& key) const
+    {
+        auto it = m_index.find(key);
+        return it != m_index.end() ? it->second->run : nullptr;
+    }
+
+    /** Stores a freshly shaped run, evicting least recently used runs to make room.
+
+        Replaces any run already stored under the key.
+
+        @param key     Cache key of the text
+        @param shaped  Shaping result, moved into the shared run
+        @returns The shared run, whether or not it fitted in the cache
+    */
+    ShapedTextRef insert(const TextCacheKey& key, ShapedText&& shaped);
+
+    /** Calls visit(key, run) for every cached run, least recently used first.
+
+        Inserting the runs again in this order restores their recency.
+
+        @param visit  Callable taking (const TextCacheKey&, const ShapedText&)
+    */
+    template <typename Visitor>
+    void forEachRun(Visitor&& visit) const
+    {
+        for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) visit(it->key, *it->run);
+    }
+
+    /** Drops every cached run. Counters are kept. */
+    void clear();
+
+    //======================================================================================
+    /** Changes the byte budget, evicting at once if the cache is now over it.
+
+        @param byteBudget  Maximum estimated bytes of cached runs
+    */
+    void setByteBudget(size_t byteBudget);
+
+    /** Returns the current byte budget. */
+    size_t getByteBudget() const { return m_stats.byteBudget; }
+
+    /** Returns the cache counters. */
+    const ShapedTextCacheStats& getStats() const { return m_stats; }
+
+    /** Zeroes the hit, miss and eviction counters. */
+    void resetStats();
+
+    /** Returns the estimated number of bytes a cached run occupies.
+
+        @param key     Key the run is stored under
+        @param shaped  Shaped run
+        @returns Glyph and key storage plus entry, index and control block overhead
+    */
+    static size_t estimateBytes(const TextCacheKey& key, const ShapedText& shaped);
+
+private:
+    //======================================================================================
+    struct Entry {
+        TextCacheKey key;                ///< Key viewing text and fonts below
+        std::string text;                ///< Owned copy of the key text
+        std::vector<FontHandle> fonts;   ///< Owned copy of the key fonts
+        ShapedTextRef run;               ///< Shared shaped run
+        size_t bytes;                    ///< Estimated size counted against the budget
+    };
+
+    using EntryList = std::list<Entry>;
+
+    /** Evicts least recently used entries until bytesUsed + incoming fits the budget. */
+    void evictToFit(size_t incomingBytes);
+
+    /** Removes an entry from list, index and byte count. */
+    void erase(EntryList::iterator it);
+
+    //======================================================================================
+    EntryList m_entries;                                                          ///< Most recently used first
+    std::unordered_map<TextCacheKey, EntryList::iterator, TextCacheKeyHash> m_index; ///< Key to entry
+    ShapedTextCacheStats m_stats;                                                 ///< Counters and sizes
+};
+
+} // namespace YuchenUI
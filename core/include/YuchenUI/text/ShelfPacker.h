@@ -0,0 +1,139 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file ShelfPacker.h
+
+    Shelf rectangle allocator with free lists, used to pack glyphs into atlas textures.
+
+    The atlas is cut into horizontal shelves stacked from the top. Each shelf keeps a
+    sorted list of free horizontal spans, so freeing a rectangle returns its span to the
+    shelf and it can be reused by any later rectangle of similar height. Shelves that
+    become empty merge with empty neighbours and can be re-cut to a new height, and empty
+    shelves at the top are given back to the unused area entirely.
+
+    Allocation order:
+    1. Best-fitting existing shelf (least wasted height, within a tolerance)
+    2. New shelf above the highest one
+    3. Empty shelf re-cut to the requested height
+    4. Any shelf tall enough, regardless of waste
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/**
+    Shelf-based rectangle allocator with per-shelf free lists.
+
+    Coordinates are integer pixels with the origin at the top left. The packer tracks
+    space only; callers own whatever lives in the rectangles.
+
+    @see GlyphCache
+*/
+class ShelfPacker {
+public:
+    //======================================================================================
+    /** Creates an empty packer.
+
+        @param width   Packing area width in pixels
+        @param height  Packing area height in pixels
+    */
+    ShelfPacker(uint32_t width, uint32_t height);
+
+    //======================================================================================
+    /** Allocates a rectangle.
+
+        @param width   Rectangle width in pixels
+        @param height  Rectangle height in pixels
+        @param outX    Receives the left edge
+        @param outY    Receives the top edge
+        @returns False if no space is left for the rectangle
+    */
+    bool allocate(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY);
+
+    /** Returns a previously allocated rectangle to the free lists.
+
+        @param x       Left edge returned by allocate()
+        @param y       Top edge returned by allocate()
+        @param width   Width passed to allocate()
+        @param height  Height passed to allocate()
+    */
+    void free(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+    /** Frees everything. */
+    void reset();
+
+    //======================================================================================
+    /** Returns the packing area width. */
+    uint32_t getWidth() const { return m_width; }
+
+    /** Returns the packing area height. */
+    uint32_t getHeight() const { return m_height; }
+
+    /** Returns the total area of allocated rectangles. */
+    uint64_t getUsedArea() const { return m_usedArea; }
+
+    /** Returns the height covered by shelves, from the top. */
+    uint32_t getShelfTop() const;
+
+    /** Returns the fraction of shelf area not covered by allocated rectangles.
+
+        0 means every shelf is packed solid; values near 1 mean the shelves are mostly
+        holes left by freed rectangles and re-packing would reclaim most of them.
+    */
+    float getFragmentation() const;
+
+private:
+    //======================================================================================
+    struct Span {
+        uint32_t x;
+        uint32_t width;
+    };
+
+    struct Shelf {
+        uint32_t y;
+        uint32_t height;
+        uint32_t usedWidth;             ///< Sum of allocated widths
+        std::vector<Span> freeSpans;    ///< Free spans sorted by x
+    };
+
+    /** Rounds a requested height up to the shelf height granularity. */
+    static uint32_t shelfHeightFor(uint32_t height);
+
+    /** Takes a span of the given width from a shelf's free list, if any is wide enough. */
+    static bool takeSpan(Shelf& shelf, uint32_t width, uint32_t& outX);
+
+    /** Re-cuts an empty shelf to the given height, leaving the remainder as an empty shelf. */
+    void splitEmptyShelf(size_t index, uint32_t height);
+
+    /** Merges the empty shelf at index with empty neighbours and trims empty top shelves. */
+    void coalesceEmptyShelf(size_t index);
+
+    Shelf makeShelf(uint32_t y, uint32_t height) const;
+
+    //======================================================================================
+    uint32_t m_width;
+    uint32_t m_height;
+    uint64_t m_usedArea;
+    std::vector<Shelf> m_shelves;       ///< Sorted by y, contiguous from 0
+};
+
+} // namespace YuchenUI
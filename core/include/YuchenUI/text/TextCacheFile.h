@@ -0,0 +1,166 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file TextCacheFile.h
+
+    Binary format of the persistent text cache.
+
+    A cache file holds what TextRenderer would otherwise rebuild on every launch: the
+    glyph bitmaps and entries of GlyphCache and the shaped runs of ShapedTextCache. It
+    starts with a TextCacheHeader naming the format version, the DPI scale and embolden
+    strength the contents were produced with, and the size and hash of the payload. A
+    file whose header does not match the running renderer is ignored as a whole.
+
+    The payload is a sequence of fixed-size fields in native byte order, written and
+    read by TextCacheWriter and TextCacheReader; the cache belongs to one machine and is
+    never exchanged. Its sections are, in order:
+    1. Font table: handle and content hash of every loaded font
+    2. Glyphs (GlyphCache::save)
+    3. Shaped runs (TextRenderer::saveCache)
+
+    Records carry the font handles of the session that wrote them. A record is only
+    adopted if the font at that handle still has the same content hash.
+*/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include "YuchenUI/core/Config.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/** Fixed header at the start of a text cache file. */
+struct TextCacheHeader {
+    static constexpr uint32_t MAGIC = 0x46435459;   ///< "YTCF" in little-endian order
+    static constexpr uint32_t VERSION = 2;          ///< Bumped on any layout change
+
+    uint32_t magic;              ///< MAGIC
+    uint32_t version;            ///< VERSION
+    uint64_t payloadSize;        ///< Bytes following the header
+    uint64_t payloadHash;        ///< hashCacheBytes() of the payload
+    float dpiScale;              ///< DPI scale glyphs were rasterized and runs shaped at
+    int32_t emboldenStrength;    ///< Config::Font::EMBOLDEN_STRENGTH of the writer
+
+    TextCacheHeader()
+        : magic(MAGIC), version(VERSION), payloadSize(0), payloadHash(0)
+        , dpiScale(1.0f), emboldenStrength(Config::Font::EMBOLDEN_STRENGTH) {}
+
+    /** Returns true if the contents were produced with the same settings. */
+    bool isCompatibleWith(const TextCacheHeader& other) const
+    {
+        return magic == other.magic && version == other.version
+            && dpiScale == other.dpiScale && emboldenStrength == other.emboldenStrength;
+    }
+};
+
+/** Returns a 64-bit hash of a byte range, used for payloads and font contents. */
+uint64_t hashCacheBytes(const void* data, size_t size);
+
+//==========================================================================================
+/**
+    Builds a text cache file in memory and writes it out.
+
+    @see TextCacheReader
+*/
+class TextCacheWriter {
+public:
+    //======================================================================================
+    /** Starts a file with the given header; size and hash are filled in on save. */
+    explicit TextCacheWriter(const TextCacheHeader& header);
+
+    /** Appends one trivially copyable field. */
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Cache fields must be plain data");
+        writeBytes(&value, sizeof(T));
+    }
+
+    /** Appends raw bytes. */
+    void writeBytes(const void* data, size_t size);
+
+    /** Writes header and payload to a file, replacing it.
+
+        @param path  File path
+        @returns False if the file could not be written
+    */
+    bool saveToFile(const char* path);
+
+    /** Returns the payload written so far. */
+    const std::vector<uint8_t>& getPayload() const { return m_payload; }
+
+private:
+    //======================================================================================
+    TextCacheHeader m_header;
+    std::vector<uint8_t> m_payload;
+};
+
+//==========================================================================================
+/**
+    Bounds-checked cursor over a text cache file, usually a MappedFile.
+
+    Every read fails instead of running past the end, so a truncated or corrupt file
+    cannot make a loader read outside the mapping.
+
+    @see TextCacheWriter
+*/
+class TextCacheReader {
+public:
+    //======================================================================================
+    /** Creates a reader over a whole file (not owned). */
+    TextCacheReader(const uint8_t* data, size_t size);
+
+    /** Reads and verifies the header, leaving the cursor at the payload.
+
+        @param outHeader  Receives the header
+        @returns False if the magic, version, payload size or payload hash is wrong
+    */
+    bool readHeader(TextCacheHeader& outHeader);
+
+    /** Reads one trivially copyable field.
+
+        @returns False if the file ends first; value is left unchanged
+    */
+    template <typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Cache fields must be plain data");
+        const uint8_t* bytes = readBytes(sizeof(T));
+        if (!bytes) return false;
+        std::memcpy(&value, bytes, sizeof(T));
+        return true;
+    }
+
+    /** Returns a view of the next size bytes and skips them, or nullptr if the file ends first. */
+    const uint8_t* readBytes(size_t size);
+
+    /** Returns the number of unread bytes. */
+    size_t getRemaining() const { return m_size - m_offset; }
+
+private:
+    //======================================================================================
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset;
+};
+
+} // namespace YuchenUI
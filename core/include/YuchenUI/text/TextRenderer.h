@@ -24,10 +24,29 @@
     - Improved multi-script text rendering
     - Better emoji and symbol support
     
+    Version 2.1 Changes:
+    - Shaped text cache is byte-budgeted LRU (ShapedTextCache) instead of unbounded
+    - shapeText() can return a shared immutable run instead of copying glyphs
+    - Cache hit, miss, eviction and byte counters exposed
+    
+    Version 2.2 Changes:
+    - Glyph UVs are computed against the atlas that holds each glyph
+    - generateTextVertices() can report per-atlas vertex ranges (TextVertexRange)
+    - New glyphs are uploaded in merged batches by flushGlyphUploads()
+    - Glyph misses are rasterized in parallel (GlyphRasterizer), optionally a frame late
+    
+    Version 2.3 Changes:
+    - shapeTextBatch() shapes a frame's uncached texts in parallel (TextShaper) and
+      fills the shaped text cache before vertices are generated
+    - Optional signed distance field glyphs (setGlyphFormat) for scale-independent text
+    - saveCache() / loadCache() persist glyphs and shaped runs across launches
+    - prewarm() rasterizes known character sets in the background and caches them a
+      bounded slice per frame (TextPrewarmProgress)
+    
     TextRenderer provides complete text rendering pipeline:
     1. Text segmentation by font fallback chain (per-character font selection)
     2. HarfBuzz text shaping per segment
-    3. FreeType glyph rasterization on demand
+    3. FreeType glyph rasterization on demand, in parallel for large batches
     4. Glyph caching in GPU texture atlases
     5. Vertex generation for GPU rendering
     
@@ -35,21 +54,27 @@
     - Segment text by font fallback (Western/CJK/Emoji/Symbol)
     - Shape each segment with appropriate font
     - Combine shaped segments with proper positioning
-    - Cache shaped results for repeated text
+    - Cache shaped results for repeated text within a byte budget
     
     Rendering pipeline:
     - Lookup glyphs in cache (rasterize if not cached)
     - Generate quad vertices with texture coordinates
-    - Vertices reference current atlas texture
+    - Group quads by atlas so each atlas is one contiguous vertex range
 */
 
 #pragma once
 
 #include "YuchenUI/core/Types.h"
 #include "YuchenUI/text/GlyphCache.h"
+#include "YuchenUI/text/ShapedTextCache.h"
+#include "YuchenUI/text/GlyphRasterizer.h"
+#include "YuchenUI/text/TextShaper.h"
 #include <hb.h>
 #include <vector>
+#include <memory>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace YuchenUI {
 
@@ -57,31 +82,25 @@ class IGraphicsBackend;
 class IFontProvider;
 
 //==========================================================================================
-/** Cache key for shaped text results.
+/** Progress of the glyphs queued by TextRenderer::prewarm().
     
-    Combines text content, fonts, and size into 64-bit hash for fast lookup.
+    Counts accumulate over every prewarm() call until resetPrewarmProgress().
 */
-struct TextCacheKey {
-    uint64_t hash;
+struct TextPrewarmProgress {
+    size_t glyphsQueued;    ///< Distinct uncached glyphs handed to the background workers
+    size_t glyphsCached;    ///< Queued glyphs now cached (or dropped as unrenderable)
+    size_t runsShaped;      ///< String and size pairs shaped, or found already shaped
     
-    /** Creates cache key from text rendering parameters.
-        
-        Letter spacing is quantized to integer values to improve cache hit rate.
-        
-        @param text              UTF-8 text string
-        @param fallbackChain     Font fallback chain
-        @param fontSize          Font size in points
-        @param letterSpacing     Letter spacing in thousandths of em
-    */
-    TextCacheKey(const char* text, const FontFallbackChain& fallbackChain,
-                 float fontSize, float letterSpacing = 0.0f);
+    TextPrewarmProgress() : glyphsQueued(0), glyphsCached(0), runsShaped(0) {}
     
-    bool operator==(const TextCacheKey& other) const { return hash == other.hash; }
-};
-
-/** Hash functor for TextCacheKey. */
-struct TextCacheKeyHash {
-    size_t operator()(const TextCacheKey& key) const { return key.hash; }
+    /** Returns true once every queued glyph has been cached. */
+    bool isComplete() const { return glyphsCached == glyphsQueued; }
+    
+    /** Returns the cached fraction of the queued glyphs, 1 when nothing is queued. */
+    float getFraction() const
+    {
+        return glyphsQueued == 0 ? 1.0f : static_cast<float>(glyphsCached) / static_cast<float>(glyphsQueued);
+    }
 };
 
 //==========================================================================================
@@ -99,6 +118,21 @@ struct TextCacheKeyHash {
     - Enhanced emoji and symbol rendering
     - Improved cache key generation
     
+    Version 2.1 Changes:
+    - Bounded shaped text cache shared with callers by reference
+    
+    Version 2.2 Changes:
+    - Text spanning several glyph atlases is emitted as one vertex range per atlas
+    - Glyph atlas uploads deferred to flushGlyphUploads() and counted
+    - Batches of glyph misses rasterized on worker threads with their own FreeType faces
+    
+    Version 2.3 Changes:
+    - Uncached texts of a frame shaped together on worker threads with their own
+      HarfBuzz buffers and fonts
+    - Distance field glyph mode: one cached glyph per font and glyph for all sizes
+    - Persistent text cache file, memory-mapped and adopted at startup
+    - Glyph warm-up for character sets known in advance
+    
     Key features:
     - Multi-font text support via fallback chains
     - Complex script shaping via HarfBuzz
@@ -151,6 +185,19 @@ public:
     */
     void beginFrame();
     
+    /** Uploads glyphs rasterized since the last flush to their atlas textures.
+        
+        Call after generating text vertices and before drawing them. RenderBatchCompiler
+        does this once per compiled render list.
+    */
+    void flushGlyphUploads();
+    
+    /** Returns glyph atlas upload counters. */
+    const GlyphUploadStats& getGlyphUploadStats() const;
+    
+    /** Zeroes the glyph atlas upload counters. */
+    void resetGlyphUploadStats();
+    
     //======================================================================================
     // Text Shaping (New API with Font Fallback)
     
@@ -181,8 +228,101 @@ public:
                    float letterSpacing,
                    ShapedText& outShapedText);
     
+    /**
+        Shapes text and returns the shared cached run.
+        
+        Same shaping as the copying overload, but a cache hit hands back the cached run
+        itself. The run is immutable and stays valid for as long as the caller holds it,
+        even if the cache evicts it meanwhile.
+        
+        @param text              UTF-8 text string
+        @param fallbackChain     Font fallback chain
+        @param fontSize          Font size in points
+        @param letterSpacing     Letter spacing in thousandths of em (-1000 to 1000)
+        @returns Shared shaped run; empty (never null) for empty or oversized text
+    */
+    ShapedTextRef shapeText(const char* text,
+                            const FontFallbackChain& fallbackChain,
+                            float fontSize,
+                            float letterSpacing);
+    
+    /**
+        Shapes every uncached text of a batch and stores the runs in the shaped text cache.
+        
+        Meant as a pre-pass over a frame's text before drawing it: segmentation runs here,
+        then the segments of all uncached texts are shaped together on TextShaper workers,
+        and later shapeText() calls for the same texts are cache hits. Batches with fewer
+        than PARALLEL_SHAPING_MIN_TEXTS uncached texts are left to shapeText().
+        
+        Texts shaped here are not counted as cache misses; the shapeText() calls that
+        follow count as hits.
+        
+        @param requests  Texts to shape; duplicates and cached texts are skipped
+        @returns Number of runs shaped
+    */
+    size_t shapeTextBatch(const std::vector<TextShapeRequest>& requests);
+    
     //======================================================================================
-    /** Generates GPU vertices for shaped text.
+    /** Returns shaped text cache counters. */
+    const ShapedTextCacheStats& getShapedTextCacheStats() const;
+    
+    /** Sets the byte budget of the shaped text cache, evicting at once if over it.
+        
+        @param byteBudget  Maximum estimated bytes of cached runs
+    */
+    void setShapedTextCacheBudget(size_t byteBudget);
+    
+    //======================================================================================
+    /** Writes the cached glyphs and shaped runs to a text cache file.
+        
+        The file is keyed by DPI scale, embolden strength and the content hash of every
+        loaded font (see TextCacheFile.h). Call it at shutdown or after the first frames,
+        when the caches hold the application's usual text.
+        
+        @param path  File path, replaced if it exists
+        @returns False if the file could not be written
+    */
+    bool saveCache(const char* path) const;
+    
+    /** Adopts glyphs and shaped runs from a text cache file written by saveCache().
+        
+        The file is memory-mapped, glyph bitmaps are packed into the atlases straight
+        from the mapping, and each atlas is uploaded in one call before this returns.
+        A missing, corrupt or incompatible file is ignored. Records of fonts that are
+        not loaded at the same handle with the same contents are skipped.
+        
+        @param path  File path
+        @returns Number of glyphs and runs adopted
+    */
+    size_t loadCache(const char* path);
+    
+    //======================================================================================
+    /** Generates GPU vertices for shaped text, grouped by glyph atlas.
+        
+        Rasterizes and caches glyphs that are not cached yet. Emits four vertices per
+        visible glyph (top left, top right, bottom left, bottom right) with UVs in the
+        glyph's own atlas. Quads are grouped so each atlas's vertices are contiguous,
+        keeping glyph order within an atlas.
+        
+        @param shaped     Shaped text run
+        @param position   Baseline origin in logical pixels
+        @param color      Text color
+        @param fontChain  Font fallback chain used for shaping
+        @param fontSize   Font size in points
+        @param vertices   Receives the vertices (cleared first)
+        @param ranges     Receives one range per atlas, in order of first use (cleared first)
+    */
+    void generateTextVertices(const ShapedText& shaped,
+                             const Vec2& position,
+                             const Vec4& color,
+                             const FontFallbackChain& fontChain,
+                             float fontSize,
+                             std::vector<TextVertex>& vertices,
+                             std::vector<TextVertexRange>& ranges);
+    
+    /** Generates GPU vertices for shaped text, discarding the atlas ranges.
+        
+        Only correct to draw with a single texture while the glyph cache has one atlas.
     */
     void generateTextVertices(const ShapedText& shaped,
                              const Vec2& position,
@@ -194,7 +334,7 @@ public:
     //======================================================================================
     /** Returns opaque handle to current glyph atlas texture.
         
-        Bind this texture before rendering text vertices.
+        Text that spills into later atlases must be drawn per TextVertexRange instead.
         
         @returns GPU texture handle for current atlas
     */
@@ -206,6 +346,89 @@ public:
     */
     float getDPIScale() const;
     
+    //======================================================================================
+    /** Lets glyph misses draw a frame late instead of blocking.
+        
+        When enabled, glyphs missing from the cache are queued on background workers and
+        skipped; beginFrame() caches whatever finished, so they appear on a later frame.
+        Hosts should keep scheduling frames while hasPendingGlyphs() is true.
+        
+        @param defer  True to rasterize in the background
+    */
+    void setDeferGlyphRasterization(bool defer);
+    
+    /** Returns true if glyph misses are rasterized in the background. */
+    bool getDeferGlyphRasterization() const { return m_deferGlyphRasterization; }
+    
+    /** Returns true if background glyphs have not been cached yet. */
+    bool hasPendingGlyphs() const;
+    
+    //======================================================================================
+    /** Selects coverage bitmaps or distance fields for glyphs drawn from now on.
+        
+        Coverage glyphs are rasterized per size and look best at small sizes. Distance
+        field glyphs are rasterized once at SDF_REFERENCE_SIZE into R8_DistanceField
+        atlases and drawn at any size, so zooming or animating text stops filling the
+        atlas with a bitmap per size. The backend must threshold R8_DistanceField
+        textures when sampling them (IGraphicsBackend::supportsDistanceFieldText());
+        SoftwareRenderer does, the Metal and D3D11 text shaders do not.
+        
+        @param format  Glyph format for text generated after this call
+        @returns False, leaving the format unchanged, if the backend cannot draw it
+    */
+    bool setGlyphFormat(GlyphFormat format);
+    
+    /** Returns the glyph format used for new text. */
+    GlyphFormat getGlyphFormat() const { return m_glyphFormat; }
+    
+    //======================================================================================
+    /** Shapes strings known in advance and rasterizes their glyphs in the background.
+        
+        Every string is shaped at every size and stored in the shaped text cache, the
+        texts of the batch together on TextShaper workers. Glyphs not cached yet are
+        queued on the GlyphRasterizer workers and this returns without waiting for them.
+        Each beginFrame() then caches at most PREWARM_GLYPHS_PER_FRAME finished glyphs,
+        so the atlas fills in slices and no frame absorbs the whole set. A text that
+        needs a finished glyph before its slice comes up takes it at once.
+        
+        Prewarmed glyphs are pinned (GlyphCache::pinGlyph) so they survive until first
+        use however long that takes; once drawn they expire like any other glyph. Hosts should keep scheduling frames while
+        hasPendingGlyphs() is true; getPrewarmProgress() reports how far the set is.
+        
+        Example:
+        @code
+        renderer.prewarm(chain, { 11.0f, 12.0f }, trackNames);
+        @endcode
+        
+        @param fallbackChain  Font fallback chain the strings will be drawn with
+        @param fontSizes      Font sizes in points
+        @param strings        UTF-8 strings, drawn later with no letter spacing
+        @returns Number of glyphs queued
+    */
+    size_t prewarm(const FontFallbackChain& fallbackChain,
+                   const std::vector<float>& fontSizes,
+                   const std::vector<std::string>& strings);
+    
+    /** Rasterizes the glyphs of a character set in the background.
+        
+        Each codepoint is mapped to its font in the fallback chain and to that font's
+        nominal glyph; no text is shaped. Otherwise the same as the string overload.
+        
+        @param fallbackChain  Font fallback chain the characters will be drawn with
+        @param fontSizes      Font sizes in points
+        @param codepoints     Unicode codepoints, such as an ASCII or digit range
+        @returns Number of glyphs queued
+    */
+    size_t prewarm(const FontFallbackChain& fallbackChain,
+                   const std::vector<float>& fontSizes,
+                   const std::vector<uint32_t>& codepoints);
+    
+    /** Returns how many prewarmed glyphs are queued and cached so far. */
+    const TextPrewarmProgress& getPrewarmProgress() const { return m_prewarmProgress; }
+    
+    /** Zeroes the prewarm counters of glyphs already cached. */
+    void resetPrewarmProgress();
+    
 private:
     //======================================================================================
     /** Initializes HarfBuzz buffer for text shaping.
@@ -220,6 +443,8 @@ private:
     /**
         Shapes text segment with HarfBuzz and applies letter spacing.
         
+        Uses the provider's shared HarfBuzz font and the renderer's buffer.
+        
         @param text              UTF-8 text segment
         @param fontHandle        Font handle for segment
         @param fontSize          Font size in points
@@ -233,46 +458,61 @@ private:
                                float letterSpacing,
                                ShapedText& outShapedText);
     
-    /** Rasterizes glyph with FreeType.
+    /** Appends a shaped segment to a run, offset by the run's advance so far. */
+    static void appendSegment(ShapedText& run, const ShapedText& segment);
+    
+    /** Rasterizes and caches every glyph of a run that is not cached yet.
+        
+        Small batches are rasterized inline. Batches of PARALLEL_RASTER_MIN_GLYPHS or more
+        go to the GlyphRasterizer workers, or are only submitted to it when rasterization
+        is deferred.
+        
+        @param shaped          Shaped run
+        @param scaledFontSize  Font size in points, DPI-scaled
+        @param boldness        Embolden strength
+    */
+    void rasterizeMissingGlyphs(const ShapedText& shaped, float scaledFontSize, uint32_t boldness);
+    
+    /** Returns the cache key of a shaped glyph in the current glyph format. */
+    GlyphKey makeGlyphKey(const ShapedGlyph& glyph, float scaledFontSize, uint32_t boldness) const;
+    
+    /** Segments and shapes text without consulting or filling the shaped text cache.
         
-        Loads and renders glyph bitmap at specified size. Bitmap remains valid
-        until next glyph load on same face.
+        @returns False if the text has no segments
+    */
+    bool shapeUncached(const char* text, const FontFallbackChain& fallbackChain, float fontSize,
+                       float letterSpacing, ShapedText& outShapedText);
+    
+    /** Adds a glyph to m_rasterJobs for prewarm() unless it is cached, pinning it if so. */
+    void queuePrewarmGlyph(const GlyphKey& key);
+    
+    /** Sends the glyphs queued by queuePrewarmGlyph() to the background workers.
         
-        @param fontHandle      Font handle
-        @param glyphIndex      Glyph index in font
-        @param fontSize        Font size in points (DPI-scaled)
-        @param outBitmapData   Output bitmap buffer pointer (R8 format)
-        @param outSize         Output bitmap dimensions
-        @param outBearing      Output glyph bearing
-        @param outAdvance      Output horizontal advance
+        @returns Number of glyphs queued
     */
-    void renderGlyph(FontHandle fontHandle,
-                     uint32_t glyphIndex,
-                     float fontSize,
-                     const void*& outBitmapData,
-                     Vec2& outSize,
-                     Vec2& outBearing,
-                     float& outAdvance);
-    
-    /** Rasterizes glyph using FreeType face directly.
-        
-        Helper function wrapping FT_Load_Glyph with FT_LOAD_RENDER.
-        
-        @param face            Opaque FT_Face pointer
-        @param glyphIndex      Glyph index in font
-        @param fontSize        Font size in points (DPI-scaled)
-        @param outBitmapData   Output bitmap buffer pointer (R8 format)
-        @param outSize         Output bitmap dimensions
-        @param outBearing      Output glyph bearing
-        @param outAdvance      Output horizontal advance
+    size_t submitPrewarmGlyphs();
+    
+    /** Caches and pins a finished prewarm glyph and counts it. */
+    void cachePrewarmedGlyph(const RasterizedGlyph& glyph);
+    
+    /** Caches up to maxGlyphs finished prewarm glyphs. */
+    void cachePrewarmSlice(size_t maxGlyphs);
+    
+    /** Rasterizes one glyph on this thread with the provider's face and caches it.
+        
+        @param key  Glyph key
+        @throws std::runtime_error if FreeType cannot render the glyph
+    */
+    void renderGlyph(const GlyphKey& key);
+    
+    /** Hands a rasterized bitmap to the glyph cache. Invalid results are dropped. */
+    void cacheRasterizedGlyph(const RasterizedGlyph& glyph);
+    
+    /** Reorders vertices so each atlas's quads are contiguous and fills ranges.
+        
+        Uses the per-quad atlas indices recorded in m_quadAtlases.
     */
-    void rasterizeGlyphWithFreeType(void* face,
-                                     uint32_t glyphIndex,
-                                     float fontSize,
-                                     const void*& outBitmapData,
-                                     Vec2& outSize,
-                                     Vec2& outBearing,
-                                     float& outAdvance);
+    void groupVerticesByAtlas(std::vector<TextVertex>& vertices, std::vector<TextVertexRange>& ranges);
     
     //======================================================================================
     IGraphicsBackend* m_backend;                                                    ///< Graphics backend (not owned)
@@ -281,7 +521,29 @@ private:
     bool m_isInitialized;                                                           ///< Initialization state
     float m_dpiScale;                                                               ///< DPI scale factor
     hb_buffer_t* m_harfBuzzBuffer;                                                  ///< Reusable HarfBuzz buffer
-    std::unordered_map<TextCacheKey, ShapedText, TextCacheKeyHash> m_shapedTextCache; ///< Shaped text cache
+    ShapedTextCache m_shapedTextCache;                                              ///< Byte-budgeted shaped run cache
+    ShapedTextRef m_emptyRun;                                                       ///< Shared result for empty text
+    std::vector<uint32_t> m_quadAtlases;                                            ///< Atlas index per emitted quad (scratch)
+    std::vector<TextVertex> m_groupedVertices;                                      ///< Atlas-grouped vertices (scratch)
+    std::vector<TextVertexRange> m_discardedRanges;                                 ///< Ranges for the range-less overload
+    std::unique_ptr<GlyphRasterizer> m_rasterizer;                                  ///< Parallel rasterizer, created on first big batch
+    bool m_deferGlyphRasterization;                                                 ///< Misses drawn a frame late
+    std::vector<GlyphRasterJob> m_rasterJobs;                                       ///< Misses of the current run (scratch)
+    std::unordered_set<GlyphKey, GlyphKeyHash> m_rasterKeys;                        ///< Keys already in m_rasterJobs (scratch)
+    std::vector<RasterizedGlyph> m_rasterResults;                                   ///< Rasterized misses (scratch)
+    RasterizedGlyph m_inlineGlyph;                                                  ///< Inline rasterization output (scratch)
+    std::unique_ptr<TextShaper> m_shaper;                                           ///< Parallel shaper, created on first big batch
+    std::unordered_set<TextCacheKey, TextCacheKeyHash> m_batchKeys;                 ///< Keys already in the batch (scratch)
+    std::vector<size_t> m_batchTexts;                                               ///< Request index of each uncached text (scratch)
+    std::vector<size_t> m_batchSegmentEnds;                                         ///< End of each text's segments (scratch)
+    std::vector<TextSegment> m_batchSegments;                                       ///< Segments of all texts (scratch)
+    std::vector<ShapingJob> m_shapingJobs;                                          ///< One job per segment (scratch)
+    std::vector<ShapedText> m_shapingResults;                                       ///< Shaped segments (scratch)
+    GlyphFormat m_glyphFormat;                                                      ///< Coverage bitmaps or distance fields
+    std::unordered_set<GlyphKey, GlyphKeyHash> m_prewarmKeys;                       ///< Queued by prewarm(), not cached yet
+    std::vector<GlyphKey> m_prewarmInline;                                          ///< Prewarm glyphs of fonts without bytes
+    std::unordered_map<GlyphKey, RasterizedGlyph, GlyphKeyHash> m_prewarmReady;     ///< Finished prewarm glyphs awaiting their slice
+    TextPrewarmProgress m_prewarmProgress;                                          ///< Prewarm counters
 };
 
 } // namespace YuchenUI
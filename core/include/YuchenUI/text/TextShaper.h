@@ -0,0 +1,127 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file TextShaper.h
+
+    Parallel HarfBuzz shaping of font segments.
+
+    HarfBuzz buffers are single-threaded, and the HarfBuzz fonts FontManager hands out
+    read their shared FT_Face while shaping, so neither can be used from two threads.
+    Each worker here owns an hb_buffer_t, an FT_Library, and one FT_Face plus hb_font_t
+    per font and size, opened over the font bytes the font provider already holds.
+    Fonts are built with FontCache::createHarfBuzzFont(), and every segment goes through
+    shapeSegment(), the same code TextRenderer uses inline, so the glyphs are identical.
+
+    Segmentation by fallback chain and caching of the combined runs stay with the
+    caller; workers only turn segments into glyphs.
+*/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include "YuchenUI/core/Config.h"
+#include <hb.h>
+#include <memory>
+#include <vector>
+
+namespace YuchenUI {
+
+class WorkerPool;
+
+//==========================================================================================
+/** One single-font segment to shape.
+
+    The text and the font bytes must stay valid until shape() returns.
+*/
+struct ShapingJob {
+    const char* text;           ///< Null-terminated UTF-8 segment (not owned)
+    FontHandle fontHandle;      ///< Font the segment was assigned by fallback
+    const void* fontData;       ///< Font file bytes (not owned)
+    size_t fontDataSize;        ///< Font file size in bytes
+    float fontSize;             ///< Font size in points, before DPI scaling
+    float letterSpacing;        ///< Letter spacing in thousandths of em
+};
+
+//==========================================================================================
+/**
+    Worker pool that shapes text segments with per-thread HarfBuzz state.
+
+    Thread safety: shape() must be called from one thread at a time.
+
+    @see TextRenderer
+*/
+class TextShaper {
+public:
+    //======================================================================================
+    /** Creates the shaper. Threads and font instances start on first use.
+
+        @param threadCount  Shaping threads including the caller (0 = hardware)
+    */
+    explicit TextShaper(size_t threadCount = Config::Text::SHAPING_THREADS);
+
+    /** Releases every per-thread buffer, font and face. */
+    ~TextShaper();
+
+    TextShaper(const TextShaper&) = delete;
+    TextShaper& operator=(const TextShaper&) = delete;
+
+    //======================================================================================
+    /** Shapes a batch of segments across the workers and waits for it.
+
+        @param jobs      Segments to shape
+        @param dpiScale  DPI scale applied to the font size for shaping
+        @param results   Receives one run per job, in job order (resized). A segment that
+                         could not be shaped gets an empty run.
+    */
+    void shape(const std::vector<ShapingJob>& jobs, float dpiScale, std::vector<ShapedText>& results);
+
+    /** Returns the number of shaping threads, including the caller. */
+    size_t getThreadCount() const { return m_threadCount; }
+
+    //======================================================================================
+    /** Shapes one segment on the calling thread.
+
+        Kerning is disabled, and letter spacing is added to every advance but the last.
+        Positions and advances are returned in logical pixels.
+
+        @param font           HarfBuzz font at the DPI-scaled size, used by this thread only
+        @param buffer         HarfBuzz buffer, used by this thread only (contents replaced)
+        @param text           Null-terminated UTF-8 segment
+        @param fontHandle     Font recorded in each glyph
+        @param fontSize       Font size in points, before DPI scaling
+        @param dpiScale       DPI scale the font was created for
+        @param letterSpacing  Letter spacing in thousandths of em
+        @param outShapedText  Receives the glyphs (appended) and the segment extent
+        @returns True if shaping succeeded
+    */
+    static bool shapeSegment(hb_font_t* font, hb_buffer_t* buffer, const char* text,
+                             FontHandle fontHandle, float fontSize, float dpiScale,
+                             float letterSpacing, ShapedText& outShapedText);
+
+private:
+    //======================================================================================
+    /** HarfBuzz and FreeType state owned by one worker thread. */
+    struct WorkerState;
+
+    void ensureWorkers();
+
+    //======================================================================================
+    size_t m_threadCount;
+    std::unique_ptr<WorkerPool> m_pool;                     ///< Created on first batch
+    std::vector<std::unique_ptr<WorkerState>> m_workers;    ///< One per pool worker
+};
+
+} // namespace YuchenUI
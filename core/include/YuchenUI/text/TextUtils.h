@@ -24,6 +24,18 @@
     - Enhanced script detection for emoji and symbols
     - Improved Unicode range coverage
     
+    Version 2.1 Changes:
+    - Classification and script detection read a generated table covering all of Unicode
+      (UnicodeTables.h, built by unicode_table_generator) instead of hand-picked ranges
+    - detectScript() returns every Unicode script, not only the eight listed before
+    
+    Version 2.2 Changes:
+    - Added validateUTF8() and decodeUTF8ToUTF32() for whole strings, with a vectorized
+      ASCII fast path
+    - Added decodeUTF8WithScripts(), which decodes codepoints, byte offsets and scripts in
+      one pass
+    - decodeUTF8() rejects overlong sequences
+    
     Provides utilities for:
     - UTF-8 encoding/decoding
     - Character classification (Western/CJK/Emoji/Symbol)
@@ -32,9 +44,9 @@
     - Font fallback chain resolution
     
     Script detection:
-    - Supports major scripts: Latin, Han (CJK), Hiragana, Katakana, Hangul, Arabic, Hebrew, Thai
+    - Every Unicode script, from the Unicode Character Database bundled with HarfBuzz
     - Added emoji and symbol detection
-    - Uses Unicode ranges for classification
+    - One table lookup per codepoint: a block index, then a property record
     - Provides ISO language codes for HarfBuzz
     
     Text segmentation:
@@ -49,12 +61,45 @@
 #include "YuchenUI/core/Types.h"
 #include <hb.h>
 #include <vector>
+#include <string>
 #include <cstdint>
 
 namespace YuchenUI {
 
 class IFontProvider;
 
+//==========================================================================================
+/**
+    A UTF-8 string decoded in one pass by TextUtils::decodeUTF8WithScripts().
+    
+    The three arrays run in parallel, one entry per codepoint. byteOffsets holds one extra
+    entry, the byte length of the whole string, so the byte length of codepoint i is
+    always byteOffsets[i + 1] - byteOffsets[i].
+*/
+struct DecodedText {
+    std::vector<uint32_t> codepoints;       ///< Codepoints, U+FFFD for malformed sequences
+    std::vector<uint32_t> byteOffsets;      ///< Byte offset of each codepoint, then the end
+    std::vector<hb_script_t> scripts;       ///< TextUtils::detectScript() of each codepoint
+    hb_script_t dominantScript;             ///< TextUtils::detectTextScript() of the string
+    
+    DecodedText() : codepoints(), byteOffsets(), scripts(), dominantScript(HB_SCRIPT_COMMON) {}
+    
+    /** Returns the number of codepoints. */
+    size_t size() const { return codepoints.size(); }
+    
+    /** Returns the byte length of codepoint index in the UTF-8 string. */
+    size_t getByteLength(size_t index) const { return byteOffsets[index + 1] - byteOffsets[index]; }
+    
+    /** Empties the arrays, keeping their capacity. */
+    void clear()
+    {
+        codepoints.clear();
+        byteOffsets.clear();
+        scripts.clear();
+        dominantScript = HB_SCRIPT_COMMON;
+    }
+};
+
 //==========================================================================================
 /**
     Text processing utilities.
@@ -89,11 +134,57 @@ public:
         - 3-byte: U+0800 to U+FFFF
         - 4-byte: U+10000 to U+10FFFF (includes emoji)
         
+        A bad lead byte or missing continuation byte skips one byte. A complete sequence
+        that is overlong, a surrogate or beyond U+10FFFF is skipped whole.
+        
         @param text  Pointer to UTF-8 string (advanced past character)
         @returns Decoded Unicode code point, or 0 if end of string
     */
     static uint32_t decodeUTF8(const char*& text);
     
+    /**
+        Tests if a byte range is well-formed UTF-8.
+        
+        Rejects everything decodeUTF8() would replace with U+FFFD: bad lead bytes, missing
+        continuation bytes, sequences cut off by the end of the range, overlong forms,
+        surrogates and values beyond U+10FFFF. Runs of ASCII are checked a vector at a
+        time.
+        
+        @param text    UTF-8 bytes (need not be null-terminated)
+        @param length  Byte length
+        @returns True if every byte belongs to a valid sequence
+    */
+    static bool validateUTF8(const char* text, size_t length);
+    
+    /**
+        Decodes a UTF-8 byte range to UTF-32.
+        
+        Produces the same codepoints as repeated decodeUTF8() calls, except that a NUL byte
+        decodes to U+0000 instead of ending the string. Runs of ASCII are widened a vector
+        at a time (SSE2 or AVX2 on x86, NEON on ARM64), so pure ASCII text costs about as
+        much as a copy.
+        
+        @param text    UTF-8 bytes (need not be null-terminated)
+        @param length  Byte length
+        @param output  Receives the codepoints, appended to its contents
+        @returns Number of codepoints appended
+    */
+    static size_t decodeUTF8ToUTF32(const char* text, size_t length, std::u32string& output);
+    
+    /**
+        Decodes a UTF-8 byte range with byte offsets and scripts in one pass.
+        
+        Gives everything segmentation needs without decoding the string again: each
+        codepoint, where it starts, its script, and the dominant script that
+        detectTextScript() would return. Uses the same ASCII fast path as
+        decodeUTF8ToUTF32().
+        
+        @param text    UTF-8 bytes (need not be null-terminated)
+        @param length  Byte length
+        @param output  Receives the decoded text; previous contents are replaced
+    */
+    static void decodeUTF8WithScripts(const char* text, size_t length, DecodedText& output);
+    
     /**
         Encodes Unicode code point to UTF-8 string.
         
@@ -110,13 +201,10 @@ public:
     /**
         Tests if code point is Western character.
         
-        Western characters include:
-        - Basic Latin and Latin-1 Supplement (U+0000-U+024F)
-        - Greek and Coptic (U+0370-U+03FF)
-        - Cyrillic (U+0400-U+04FF)
-        - General Punctuation (U+2000-U+206F)
-        - Mathematical Operators (U+2190-U+22FF)
-        - Letterlike Symbols (U+2100-U+214F)
+        Western characters are:
+        - Every codepoint of the Latin, Greek and Cyrillic scripts
+        - Script-neutral codepoints below U+2300: controls, digits, punctuation, currency,
+          letterlike symbols, arrows and mathematical operators
         
         @param codepoint  Unicode code point
         @returns True if Western character
@@ -126,11 +214,10 @@ public:
     /**
         Tests if code point is Chinese/CJK character.
         
-        CJK characters include:
-        - CJK Unified Ideographs (U+4E00-U+9FFF)
-        - CJK Extension A (U+3400-U+4DBF)
-        - CJK Symbols and Punctuation (U+3000-U+303F)
-        - Halfwidth and Fullwidth Forms (U+FF00-U+FFEF)
+        CJK characters are:
+        - Every codepoint of the Han script (all ideograph blocks and extensions) and Bopomofo
+        - Script-neutral codepoints of the CJK blocks: radicals, CJK symbols and punctuation,
+          strokes, enclosed CJK, compatibility forms, halfwidth and fullwidth forms
         
         @param codepoint  Unicode code point
         @returns True if CJK character
@@ -140,13 +227,10 @@ public:
     /**
         Tests if code point is emoji.
         
-        Emoji ranges include:
-        - Emoticons (U+1F600-U+1F64F)
-        - Miscellaneous Symbols and Pictographs (U+1F300-U+1F5FF)
-        - Transport and Map Symbols (U+1F680-U+1F6FF)
-        - Supplemental Symbols and Pictographs (U+1F900-U+1F9FF)
-        - Symbols and Pictographs Extended-A (U+1FA70-U+1FAFF)
-        - Emoji Components (U+FE00-U+FE0F, U+1F3FB-U+1F3FF)
+        Emoji are:
+        - Codepoints with the Extended_Pictographic property (UTS #51)
+        - Emoji components: regional indicators, skin tone modifiers, variation selectors,
+          zero width joiner and the combining keycap
         
         @param codepoint  Unicode code point
         @returns True if emoji character
@@ -156,12 +240,11 @@ public:
     /**
         Tests if code point is symbol.
         
-        Symbol ranges include:
-        - Miscellaneous Symbols (U+2600-U+26FF)
-        - Dingbats (U+2700-U+27BF)
-        - Miscellaneous Mathematical Symbols (U+2980-U+29FF)
-        - Supplemental Punctuation (U+2E00-U+2E7F)
-        - Geometric Shapes (U+25A0-U+25FF)
+        Symbols are script-neutral codepoints from U+2300 up that are symbols, other numbers
+        or punctuation (general category Sm, So, No or P*) and not CJK: for example
+        technical symbols, box drawing, geometric shapes, enclosed alphanumerics,
+        supplemental punctuation and musical symbols. Pictographs with a text presentation,
+        such as U+2328 keyboard, are both symbol and emoji.
         
         @param codepoint  Unicode code point
         @returns True if symbol character
@@ -177,13 +260,9 @@ public:
         Returns HarfBuzz script constant for character. Used for script-specific
         shaping features.
         
-        Supported scripts:
-        - HB_SCRIPT_LATIN: Western scripts
-        - HB_SCRIPT_HAN: Chinese/CJK ideographs
-        - HB_SCRIPT_HIRAGANA: Japanese hiragana
-        - HB_SCRIPT_KATAKANA: Japanese katakana
-        - HB_SCRIPT_HANGUL: Korean hangul
-        - HB_SCRIPT_COMMON: Punctuation, symbols, emoji, etc.
+        Returns the Unicode Script property of the codepoint. Script-neutral characters
+        (punctuation, digits, symbols, emoji), combining marks (Inherited) and unassigned
+        codepoints all return HB_SCRIPT_COMMON.
         
         @param codepoint  Unicode code point
         @returns HarfBuzz script constant
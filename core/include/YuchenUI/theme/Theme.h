@@ -208,6 +208,7 @@ struct FaderColors {
 
 class UIStyle {
 public:
+    UIStyle();
     virtual ~UIStyle() = default;
     virtual StyleType getType() const = 0;
     static constexpr float FOCUS_INDICATOR_BORDER_WIDTH = 1.0f;
@@ -237,13 +238,17 @@ public:
     virtual Vec4 getDefaultGroupBoxBorder() const = 0;
     virtual Vec4 getDefaultScrollAreaBackground() const = 0;
     virtual float getGroupBoxTitleBarHeight() const = 0;
-    virtual void setFontProvider(IFontProvider* provider) { m_fontProvider = provider; }
+    virtual void setFontProvider(IFontProvider* provider) { m_fontProvider = provider; m_revision = nextRevision(); }
+    /** Process-unique value that changes whenever this style's output may change; widget draw caches compare it. */
+    uint64_t getRevision() const { return m_revision; }
     virtual void drawNumberBackground(const NumberBackgroundDrawInfo& info, RenderList& cmdList) = 0;
     virtual IFontProvider* getFontProvider() const;
     virtual FaderColors getFaderColors() const = 0;
     virtual LevelMeterColors getLevelMeterColors() const = 0;
 protected:
+    static uint64_t nextRevision();
     IFontProvider* m_fontProvider = nullptr;
+    uint64_t m_revision;
 };
 
 class ProtoolsDarkStyle : public UIStyle {
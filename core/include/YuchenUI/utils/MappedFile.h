@@ -0,0 +1,80 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Utils module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/**
+    Read-only memory mapping of a whole file.
+
+    Pages are read by the OS on first touch, so opening a large file costs nothing until
+    its bytes are used, and bytes copied straight out of the mapping skip the extra copy
+    a stream read would make. Uses mmap on POSIX and a file mapping object on Windows.
+
+    The mapping stays valid until close() or destruction.
+
+    Example:
+    @code
+    MappedFile file;
+    if (file.open(path))
+        parse(file.getData(), file.getSize());
+    @endcode
+*/
+class MappedFile {
+public:
+    //======================================================================================
+    /** Creates a closed mapping. */
+    MappedFile();
+
+    /** Unmaps the file. */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //======================================================================================
+    /** Maps a file, closing any file mapped before.
+
+        @param path  File path
+        @returns False if the file does not exist, is empty or cannot be mapped
+    */
+    bool open(const char* path);
+
+    /** Unmaps the file. Does nothing if none is mapped. */
+    void close();
+
+    //======================================================================================
+    /** Returns true if a file is mapped. */
+    bool isOpen() const { return m_data != nullptr; }
+
+    /** Returns the mapped bytes, or nullptr if none. */
+    const uint8_t* getData() const { return m_data; }
+
+    /** Returns the mapped size in bytes. */
+    size_t getSize() const { return m_size; }
+
+private:
+    //======================================================================================
+    const uint8_t* m_data;
+    size_t m_size;
+    void* m_mapping;    ///< Windows file mapping handle (unused on POSIX)
+};
+
+} // namespace YuchenUI
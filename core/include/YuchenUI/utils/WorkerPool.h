@@ -0,0 +1,93 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Utils module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/**
+    Fixed-size pool of worker threads for data-parallel frame work.
+
+    The pool runs one parallelFor() at a time. The calling thread takes part as worker 0,
+    so a pool of N threads starts N - 1 background threads, and a pool of 1 runs
+    everything inline without any synchronization.
+
+    Tasks are handed out one index at a time from a shared counter, which keeps the load
+    balanced when task costs vary (for example screen tiles with very different content).
+
+    Example:
+    @code
+    WorkerPool pool;  // One thread per hardware core
+    pool.parallelFor(tileCount, [&](size_t tile, size_t worker) {
+        rasterizers[worker].drawTile(tile);
+    });
+    @endcode
+*/
+class WorkerPool {
+public:
+    //======================================================================================
+    /** Creates a pool.
+
+        @param threadCount  Total number of threads including the caller.
+                            0 selects std::thread::hardware_concurrency().
+    */
+    explicit WorkerPool(size_t threadCount = 0);
+
+    /** Stops and joins all background threads. */
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    //======================================================================================
+    /** Returns the number of threads that run tasks, including the caller. */
+    size_t getThreadCount() const { return m_workers.size() + 1; }
+
+    /** Runs task(index, worker) for every index in [0, taskCount) and waits for all.
+
+        Worker indices are in [0, getThreadCount()) and are stable for the duration of a
+        call, so they can select per-thread scratch state. Must not be called re-entrantly
+        from inside a task.
+    */
+    void parallelFor(size_t taskCount, const std::function<void(size_t, size_t)>& task);
+
+private:
+    void workerLoop(size_t worker);
+    void runTasks(size_t worker);
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+
+    const std::function<void(size_t, size_t)>* m_task;  ///< Current job, valid during parallelFor
+    size_t m_taskCount;
+    std::atomic<size_t> m_nextTask;
+    size_t m_activeWorkers;     ///< Background workers still running the current job
+    uint64_t m_generation;      ///< Incremented for every job so workers wake exactly once
+    bool m_stopping;
+};
+
+} // namespace YuchenUI
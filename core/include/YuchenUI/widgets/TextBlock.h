@@ -3,12 +3,14 @@
 #include "YuchenUI/widgets/Widget.h"
 #include "YuchenUI/core/Types.h"
 #include "YuchenUI/core/Config.h"
+#include "YuchenUI/text/LineBreaker.h"
 #include <string>
 #include <vector>
 
 namespace YuchenUI {
 
 class RenderList;
+class IFontProvider;
 
 struct TextLine {
     std::string text;
@@ -25,6 +27,11 @@ struct TextLine {
     Version 3.0 Changes:
     - Qt-style font API with automatic fallback
     - Simplified font management
+    
+    Version 3.1 Changes:
+    - Each paragraph is shaped once by a LineBreaker and wrapped from its caret stops
+    - Breaks follow UAX #14 rules, including between CJK characters
+    - A new width or text only refits and reshapes the paragraphs it affects
 */
 class TextBlock : public Widget {
 public:
@@ -83,11 +90,11 @@ public:
     bool isValid() const;
     
 private:
+    void ensureLayout() const;
     void layoutText() const;
-    std::vector<std::string> splitIntoParagraphs(const std::string& text) const;
-    void layoutParagraph(const std::string& paragraph, float startY, std::vector<TextLine>& lines) const;
-    std::string wrapLine(const std::string& text, float maxWidth, size_t& outConsumed) const;
-    float measureTextWidth(const std::string& text) const;
+    void updateParagraphs(IFontProvider* fontProvider) const;
+    void layoutParagraph(LineBreaker& paragraph, float startY, const FontMetrics& metrics, std::vector<TextLine>& lines) const;
+    float getContentWidth() const { return m_bounds.width - m_paddingLeft - m_paddingRight; }
     
     std::string m_text;
     FontFallbackChain m_fontChain;
@@ -107,6 +114,10 @@ private:
     
     mutable std::vector<TextLine> m_cachedLines;
     mutable bool m_needsLayout;
+    
+    mutable std::vector<LineBreaker> m_paragraphs;  ///< Shaped paragraphs of m_text
+    mutable bool m_needsShaping;                    ///< m_paragraphs no longer match m_text
+    mutable float m_layoutWidth;                    ///< Content width of m_cachedLines
 };
 
 }
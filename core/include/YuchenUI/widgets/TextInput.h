@@ -5,6 +5,7 @@
 
 #include "YuchenUI/core/Types.h"
 #include <string>
+#include <vector>
 #include <functional>
 
 namespace YuchenUI {
@@ -105,6 +106,8 @@ private:
     
     float measureTextToPosition(size_t charIndex) const;
     size_t positionToCharIndex(float x, const Vec2& offset) const;
+    const std::vector<float>& getCaretStops() const;
+    void invalidateCaretStops();
     
     void adjustScrollToCursor();
     
@@ -116,6 +119,9 @@ private:
     std::u32string m_textUTF32;
     std::string m_placeholder;
     
+    mutable std::vector<float> m_caretStops;    ///< Caret x before each character of m_textUTF32, then the end
+    mutable bool m_caretStopsValid;
+    
     size_t m_cursorPosition;
     size_t m_selectionStart;
     size_t m_selectionEnd;
@@ -43,7 +43,7 @@ class FocusManager;
     - Simplified type hierarchy
     
     Key responsibilities:
-    - Rendering (addDrawCommands)
+    - Rendering (addDrawCommands, with an optional retained display list cache)
     - Event handling (mouse, keyboard, touch)
     - Focus management
     - Visibility and enabled state
@@ -359,6 +359,64 @@ public:
     */
     virtual void setEnabled(bool enabled);
     
+    //======================================================================================
+    // Display List Cache
+    
+    /**
+        Emits this component's draw commands, replaying its cached commands when possible.
+        
+        Containers and content classes should call this rather than addDrawCommands().
+        When the draw cache is enabled, the commands from the last addDrawCommands() call
+        are kept in local coordinates and replayed at the new offset until invalidate()
+        is called or the theme changes. Components with children always draw directly,
+        so a cached span never hides a child's changes.
+        
+        If the list has a cull rect (partial redraw) and this component lies outside it,
+        nothing is recorded and the skipped command count is reported to the list.
+        
+        @param commandList  Render command list to append to
+        @param offset       Offset in parent coordinate space (cumulative)
+    */
+    void render(RenderList& commandList, const Vec2& offset = Vec2()) const;
+    
+    /**
+        Marks the cached draw commands as stale and damages the component's area.
+        
+        Call this from any setter or event handler that changes what addDrawCommands()
+        emits. Geometry, visibility, enabled, focus and context changes invalidate
+        automatically. Windows only render frames after something invalidates, so a
+        visual change without invalidate() may not appear until the next input event.
+        
+        The damage covers the window-space bounds at the last render() and, if the
+        component moved or resized since, its new bounds. A component that was never
+        rendered requests a full redraw.
+    */
+    void invalidate();
+    
+    /**
+        Enables or disables the display list cache for this component.
+        
+        Only enable the cache for components whose addDrawCommands() output depends
+        solely on state that calls invalidate() when it changes. Disabled by default.
+        
+        @param enabled  true to cache draw commands between frames
+    */
+    void setDrawCacheEnabled(bool enabled);
+    
+    /**
+        Returns whether the display list cache is enabled.
+        
+        @return true if draw commands are cached
+    */
+    bool isDrawCacheEnabled() const { return m_drawCacheEnabled; }
+    
+    /**
+        Returns whether the cached draw commands can be replayed without redrawing.
+        
+        @return true if the cache holds commands for the current state and theme
+    */
+    bool isDrawCacheValid() const;
+    
     //======================================================================================
     // Context and Ownership
     
@@ -623,7 +681,7 @@ protected:
         Renders all child components.
         
         Helper method for container components. Iterates through all children and
-        calls their addDrawCommands() method.
+        calls their render() method, which replays cached commands where possible.
         
         @param commandList  Render command list to append to
         @param offset       Cumulative offset in parent space
@@ -716,6 +774,7 @@ private:
     void notifyFocusIn(FocusReason reason);
     void notifyFocusOut(FocusReason reason);
     void setFocusState(bool focused) { m_hasFocus = focused; }
+    uint64_t getStyleRevision() const;
     
     FocusPolicy m_focusPolicy;            ///< How this component receives focus
     bool m_hasFocus;                      ///< Whether this component has focus
@@ -724,6 +783,15 @@ private:
     bool m_showFocusIndicator;            ///< Whether to show focus indicator
     FocusManager* m_focusManagerAccessor; ///< Direct accessor to focus manager
     
+    bool m_drawCacheEnabled;                         ///< Whether render() may replay the cache
+    mutable bool m_drawCacheValid;                   ///< Whether m_drawCache matches current state
+    mutable uint64_t m_drawCacheStyleRevision;       ///< UIStyle revision the cache was recorded with
+    mutable std::unique_ptr<RenderList> m_drawCache; ///< Commands in local coordinates
+    mutable Vec2 m_lastRenderOffset;                 ///< Parent offset passed to the last render()
+    mutable Rect m_lastRenderBounds;                 ///< Window-space bounds at the last render()
+    mutable bool m_hasRendered;                      ///< Whether render() has placed this widget
+    mutable size_t m_lastCommandCount;               ///< Commands the last recording produced
+    
     friend class FocusManager;
     friend class IUIContent;
 };
@@ -22,7 +22,7 @@
     - LevelDataManager: Per-channel level tracking with decay and peak hold
     - MeterScale: dB-to-position mapping with non-linear scales (Sample Peak, K-12, etc.)
     - MeterRenderer: Theme-aware rendering with 3D lighting effects
-    - BlendedColorCache: Pre-computed color blending for performance
+    - BlendedColorCache: Pre-computed lighting gradient stops (one command per region)
     
     Scale characteristics:
     - SAMPLE_PEAK: Non-linear (0 to -40dB = 81.25% height, optimized for digital audio)
@@ -94,7 +94,10 @@ struct MeterDimensions {
     
     // Returns channel width based on total channel count (for density optimization)
     static float getChannelWidth(size_t totalChannelCount);
-    static constexpr float getTotalHeight();
+    static constexpr float getTotalHeight()
+    {
+        return PEAK_INDICATOR_SPACING + PEAK_INDICATOR_HEIGHT + PEAK_INDICATOR_SPACING + DEFAULT_HEIGHT;
+    }
     static float getChannelGroupWidth(size_t channelCount);
     static float getTotalWidth(size_t channelCount);
 };
@@ -256,30 +259,32 @@ private:
 };
 
 //==========================================================================================
-/** Pre-computed color blending for 3D cylindrical lighting effect. */
+/** Pre-computed color blending for 3D cylindrical lighting effect.
+    
+    The lighting is a cosine profile across the channel width (dark edges, bright
+    center) multiplied onto the base color. It is expressed as gradient stops so a
+    whole meter region is one FillGradientRect command.
+*/
 class BlendedColorCache
 {
 public:
+    static constexpr size_t LIGHTING_STOP_COUNT = 9;  ///< Stops approximating the cosine profile
+    
     BlendedColorCache();
     
     void initialize(size_t totalChannelCount);
     bool isInitialized() const { return initialized_; }
-    Vec4 getBlendedColor(const Vec4& baseColor, float x, bool isWarningRegion) const;
+    
+    /** Fills LIGHTING_STOP_COUNT horizontal gradient stops for a lit region. */
+    void getGradientStops(const Vec4& baseColor, bool isWarningRegion, GradientStop* stops) const;
     
 private:
-    struct TextureData { std::vector<Vec4> pixels; };
-    TextureData normalTexture_;
-    TextureData warningTexture_;
-    float channelWidth_;
-    int blendTexturePixelCount_;         // Number of pixels in blend texture
-    size_t initializedForChannelCount_;  // Track which channel count we initialized for
+    std::array<Vec4, LIGHTING_STOP_COUNT> normalProfile_;   // Overlay colors at each stop
+    std::array<Vec4, LIGHTING_STOP_COUNT> warningProfile_;
     bool initialized_;
-    mutable std::unordered_map<uint64_t, Vec4> blendCache_;  // Cache key: (color, x, region)
     
-    void initializeTextures();
-    Vec4 sampleTexture(const TextureData& texture, float x) const;
+    void initializeProfiles();
     Vec4 multiplyBlend(const Vec4& baseColor, const Vec4& overlayColor) const;
-    uint64_t getCacheKey(const Vec4& baseColor, float x, bool isWarningRegion) const;
 };
 
 //==========================================================================================
@@ -328,6 +333,7 @@ private:
     void renderPeakIndicator(RenderList& cmdList, const Rect& rect, bool isActive);
     void renderPeakIndicatorFrame(RenderList& cmdList, const Rect& rect);
     void renderControlVoltage(RenderList& cmdList, const Vec2& startPos, const Vec2& totalSize, const LevelDataManager& levelData);
+    void fillLitRect(RenderList& cmdList, const Rect& rect, const Vec4& baseColor, bool isWarningRegion);
     
     Vec4 getLevelColor(float db) const;
     float dbToPosition01(float db) const;
@@ -351,8 +357,8 @@ private:
     Thread-safe level updates: updateLevels() can be called from audio thread.
     All other methods must be called from UI thread only.
     
-    Performance: Supports 1-35 channels at 60fps. Uses pre-computed color blending
-    and texture-based 3D lighting for efficient GPU rendering.
+    Performance: Supports 1-35 channels at 60fps. Each meter region is one
+    gradient fill carrying the pre-computed 3D lighting.
     
     @see MeterConfig, MeterScale, UIStyle::getLevelMeterColors()
 */
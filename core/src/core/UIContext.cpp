@@ -15,6 +15,7 @@
 
 #include "YuchenUI/core/UIContext.h"
 #include "YuchenUI/core/IUIContent.h"
+#include "YuchenUI/core/Config.h"
 #include "YuchenUI/focus/FocusManager.h"
 #include "YuchenUI/platform/ICoordinateMapper.h"
 #include "YuchenUI/widgets/Widget.h"
@@ -28,6 +29,7 @@
 #include <vector>
 #include <algorithm>
 #include <chrono>
+#include <utility>
 
 namespace YuchenUI {
 
@@ -51,6 +53,16 @@ struct UIContext::Impl
     
     std::chrono::time_point<std::chrono::high_resolution_clock> lastFrameTime;
     
+    bool redrawRequested;
+    bool animationFrameScheduled;
+    std::chrono::time_point<std::chrono::high_resolution_clock> animationFrameTime;
+    FrameRequestCallback frameRequestCallback;
+    
+    bool partialRedrawEnabled;
+    bool fullDamage;
+    std::vector<Rect> damageRects;
+    FrameStats frameStats;
+    
     Impl(IFontProvider* font, IThemeProvider* theme)
     : content(nullptr)
     , focusManager(nullptr)
@@ -62,7 +74,23 @@ struct UIContext::Impl
     , fontProvider(font)
     , themeProvider(theme)
     , lastFrameTime(std::chrono::high_resolution_clock::now())
+    , redrawRequested(true)
+    , animationFrameScheduled(false)
+    , animationFrameTime()
+    , frameRequestCallback()
+    , partialRedrawEnabled(false)
+    , fullDamage(true)
+    , damageRects()
+    , frameStats()
     {}
+    
+    /** Marks a frame as due, telling the platform if it was idle. */
+    void markRedraw()
+    {
+        if (redrawRequested) return;
+        redrawRequested = true;
+        if (frameRequestCallback) frameRequestCallback();
+    }
 };
 
 //==========================================================================================
@@ -121,6 +149,7 @@ void UIContext::setContent(std::unique_ptr<IUIContent> content)
     if (m_impl->content) m_impl->content->onDestroy();
     
     m_impl->content = std::move(content);
+    requestRedraw();
     
     if (m_impl->content)
     {
@@ -139,7 +168,29 @@ IUIContent* UIContext::getContent() const
 
 void UIContext::render(RenderList& outCommandList)
 {
+    FrameStats& stats = m_impl->frameStats;
+    const Rect damage = getDamageBounds();
+    const bool cull = m_impl->partialRedrawEnabled && !m_impl->fullDamage;
+    
+    const size_t firstCommand = outCommandList.getCommandCount();
+    const size_t culledBefore = outCommandList.getCulledCommandCount();
+    const bool hadCullRect = outCommandList.hasCullRect();
+    const Rect previousCullRect = outCommandList.getCullRect();
+    
+    if (cull) outCommandList.setCullRect(damage);
+    
     if (m_impl->content) m_impl->content->render(outCommandList);
+    
+    if (hadCullRect) outCommandList.setCullRect(previousCullRect);
+    else outCommandList.clearCullRect();
+    
+    const float viewportArea = m_impl->viewportSize.x * m_impl->viewportSize.y;
+    stats.fullRedraw = m_impl->fullDamage;
+    stats.damagedPixelFraction = m_impl->fullDamage || viewportArea <= 0.0f
+        ? 1.0f : (damage.width * damage.height) / viewportArea;
+    stats.damageRectCount = m_impl->damageRects.size();
+    stats.commandsRecorded = outCommandList.getCommandCount() - firstCommand;
+    stats.commandsSkipped = outCommandList.getCulledCommandCount() - culledBefore;
 }
 
 void UIContext::beginFrame()
@@ -148,37 +199,165 @@ void UIContext::beginFrame()
     float deltaTime = std::chrono::duration<float>(now - m_impl->lastFrameTime).count();
     m_impl->lastFrameTime = now;
     
+    // This frame consumes any pending animation request; updates below may schedule the next
+    m_impl->animationFrameScheduled = false;
+    
     if (m_impl->content) m_impl->content->onUpdate(deltaTime);
 }
 
-void UIContext::endFrame() {}
+void UIContext::endFrame()
+{
+    m_impl->redrawRequested = false;
+    m_impl->fullDamage = false;
+    m_impl->damageRects.clear();
+}
+
+//==========================================================================================
+// Redraw scheduling
+
+void UIContext::requestRedraw()
+{
+    m_impl->fullDamage = true;
+    m_impl->damageRects.clear();
+    m_impl->markRedraw();
+}
+
+void UIContext::invalidateRect(const Rect& rect)
+{
+    YUCHEN_ASSERT(rect.isValid());
+    
+    m_impl->markRedraw();
+    if (m_impl->fullDamage) return;
+    
+    Rect viewport(0, 0, m_impl->viewportSize.x, m_impl->viewportSize.y);
+    Rect damage = rect.intersected(viewport);
+    if (damage.isEmpty()) return;
+    
+    auto& rects = m_impl->damageRects;
+    
+    // Skip rects already covered; repeated invalidation of one widget is common
+    for (const Rect& existing : rects)
+    {
+        if (existing.intersected(damage) == damage) return;
+    }
+    
+    if (rects.size() >= Config::Rendering::MAX_DAMAGE_RECTS)
+    {
+        Rect merged = damage;
+        for (const Rect& existing : rects) merged = merged.united(existing);
+        rects.assign(1, merged);
+        return;
+    }
+    
+    rects.push_back(damage);
+}
+
+void UIContext::requestAnimationFrame(float delaySeconds)
+{
+    YUCHEN_ASSERT(delaySeconds >= 0.0f);
+    
+    auto due = std::chrono::high_resolution_clock::now() +
+               std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                   std::chrono::duration<float>(delaySeconds));
+    
+    if (!m_impl->animationFrameScheduled || due < m_impl->animationFrameTime)
+    {
+        m_impl->animationFrameTime = due;
+        m_impl->animationFrameScheduled = true;
+        if (m_impl->frameRequestCallback) m_impl->frameRequestCallback();
+    }
+}
+
+bool UIContext::needsRedraw() const
+{
+    return getTimeUntilNextFrame() == 0.0f;
+}
+
+float UIContext::getTimeUntilNextFrame() const
+{
+    if (m_impl->redrawRequested) return 0.0f;
+    if (!m_impl->animationFrameScheduled) return -1.0f;
+    
+    auto now = std::chrono::high_resolution_clock::now();
+    return std::max(0.0f, std::chrono::duration<float>(m_impl->animationFrameTime - now).count());
+}
+
+void UIContext::setFrameRequestCallback(FrameRequestCallback callback)
+{
+    m_impl->frameRequestCallback = std::move(callback);
+}
+
+//==========================================================================================
+// Damage regions
+
+void UIContext::setPartialRedrawEnabled(bool enabled)
+{
+    m_impl->partialRedrawEnabled = enabled;
+}
+
+bool UIContext::isPartialRedrawEnabled() const
+{
+    return m_impl->partialRedrawEnabled;
+}
+
+bool UIContext::isFullRedraw() const
+{
+    return m_impl->fullDamage;
+}
+
+const std::vector<Rect>& UIContext::getDamageRects() const
+{
+    return m_impl->damageRects;
+}
+
+Rect UIContext::getDamageBounds() const
+{
+    Rect viewport(0, 0, m_impl->viewportSize.x, m_impl->viewportSize.y);
+    if (m_impl->fullDamage) return viewport;
+    
+    Rect bounds;
+    for (const Rect& rect : m_impl->damageRects) bounds = bounds.united(rect);
+    return bounds;
+}
+
+const FrameStats& UIContext::getFrameStats() const
+{
+    return m_impl->frameStats;
+}
 
 //==========================================================================================
 // Mouse event handling
 
 bool UIContext::handleMouseMove(const Vec2& position)
 {
-    if (m_impl->content)
-        return m_impl->content->handleMouseMove(position);
+    if (m_impl->content && m_impl->content->handleMouseMove(position))
+    {
+        m_impl->markRedraw();
+        return true;
+    }
     
     return false;
 }
 
 bool UIContext::handleMouseClick(const Vec2& position, bool pressed)
 {
+    bool handled = false;
     if (m_impl->capturedComponent)
-        return m_impl->capturedComponent->handleMouseClick(position, pressed);
-    
-    if (m_impl->content)
-        return m_impl->content->handleMouseClick(position, pressed);
+        handled = m_impl->capturedComponent->handleMouseClick(position, pressed);
+    else if (m_impl->content)
+        handled = m_impl->content->handleMouseClick(position, pressed);
     
-    return false;
+    if (handled) m_impl->markRedraw();
+    return handled;
 }
 
 bool UIContext::handleMouseWheel(const Vec2& delta, const Vec2& position)
 {
-    if (m_impl->content)
-        return m_impl->content->handleMouseWheel(delta, position);
+    if (m_impl->content && m_impl->content->handleMouseWheel(delta, position))
+    {
+        m_impl->markRedraw();
+        return true;
+    }
     return false;
 }
 
@@ -195,7 +374,9 @@ bool UIContext::handleKeyEvent(KeyCode key, bool pressed, const KeyModifiers& mo
         event.key.modifiers = mods;
         event.key.isRepeat = isRepeat;
         
-        return m_impl->content->handleKeyEvent(event);
+        if (!m_impl->content->handleKeyEvent(event)) return false;
+        m_impl->markRedraw();
+        return true;
     }
     return false;
 }
@@ -207,7 +388,9 @@ bool UIContext::handleTextInput(uint32_t codepoint)
         event.type = EventType::TextInput;
         event.textInput.codepoint = codepoint;
         
-        return m_impl->content->handleTextInput(event);
+        if (!m_impl->content->handleTextInput(event)) return false;
+        m_impl->markRedraw();
+        return true;
     }
     return false;
 }
@@ -223,7 +406,9 @@ bool UIContext::handleTextComposition(const char* text, int cursorPos, int selec
         event.textComposition.cursorPosition = cursorPos;
         event.textComposition.selectionLength = selectionLength;
         
-        return m_impl->content->handleTextInput(event);
+        if (!m_impl->content->handleTextInput(event)) return false;
+        m_impl->markRedraw();
+        return true;
     }
     return false;
 }
@@ -234,6 +419,7 @@ bool UIContext::handleTextComposition(const char* text, int cursorPos, int selec
 void UIContext::setViewportSize(const Vec2& size)
 {
     m_impl->viewportSize = size;
+    requestRedraw();
     
     if (m_impl->content)
     {
@@ -250,6 +436,7 @@ Vec2 UIContext::getViewportSize() const
 void UIContext::setDPIScale(float scale)
 {
     m_impl->dpiScale = scale;
+    requestRedraw();
 }
 
 float UIContext::getDPIScale() const
@@ -0,0 +1,156 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file RenderArena.cpp
+
+    Implementation notes:
+    - Strings are bump-allocated from fixed blocks; a string larger than the block size
+      gets a dedicated block of its own
+    - Blocks are never freed on reset, only rewound
+    - Gradient stops share the string blocks; their offset is rounded up to the stop
+      alignment, which block storage (operator new[]) always satisfies at offset 0
+    - Font chain slots are reused by copy-assignment, which keeps the inner vector's
+      capacity and therefore does not allocate for chains of similar length
+    - Chain deduplication only looks at the most recently stored slots; widgets tend to
+      draw runs of text with the same chain
+*/
+
+#include "YuchenUI/rendering/RenderArena.h"
+#include "YuchenUI/core/Assert.h"
+#include <algorithm>
+#include <cstring>
+
+namespace YuchenUI {
+
+namespace {
+    constexpr size_t FONT_CHAIN_DEDUP_WINDOW = 8;
+}
+
+//==========================================================================================
+// Lifecycle
+
+RenderArena::RenderArena(size_t blockSize)
+    : m_blocks()
+    , m_blockSize(blockSize)
+    , m_currentBlock(0)
+    , m_blockOffset(0)
+    , m_bytesUsed(0)
+    , m_fontChains()
+    , m_fontChainCount(0)
+{
+    YUCHEN_ASSERT(blockSize > 0);
+}
+
+RenderArena::~RenderArena() = default;
+
+//==========================================================================================
+// Storage
+
+const char* RenderArena::storeString(const char* text, size_t length)
+{
+    YUCHEN_ASSERT(text || length == 0);
+
+    char* dest = allocate(length + 1);
+    if (length > 0) std::memcpy(dest, text, length);
+    dest[length] = '\0';
+
+    m_bytesUsed += length + 1;
+    return dest;
+}
+
+const FontFallbackChain* RenderArena::storeFontChain(const FontFallbackChain& chain)
+{
+    size_t windowStart = m_fontChainCount > FONT_CHAIN_DEDUP_WINDOW
+        ? m_fontChainCount - FONT_CHAIN_DEDUP_WINDOW : 0;
+
+    for (size_t i = m_fontChainCount; i > windowStart; --i)
+    {
+        const FontFallbackChain& stored = m_fontChains[i - 1];
+        if (stored.fonts == chain.fonts) return &stored;
+    }
+
+    if (m_fontChainCount < m_fontChains.size())
+    {
+        m_fontChains[m_fontChainCount] = chain;
+    }
+    else
+    {
+        m_fontChains.push_back(chain);
+    }
+
+    return &m_fontChains[m_fontChainCount++];
+}
+
+const GradientStop* RenderArena::storeGradientStops(const GradientStop* stops, size_t count)
+{
+    YUCHEN_ASSERT(stops && count > 0);
+
+    const size_t bytes = count * sizeof(GradientStop);
+    char* dest = allocate(bytes, alignof(GradientStop));
+    std::memcpy(dest, stops, bytes);
+
+    m_bytesUsed += bytes;
+    return reinterpret_cast<const GradientStop*>(dest);
+}
+
+//==========================================================================================
+// State Management
+
+void RenderArena::reset()
+{
+    m_currentBlock = 0;
+    m_blockOffset = 0;
+    m_bytesUsed = 0;
+    m_fontChainCount = 0;
+}
+
+size_t RenderArena::getBytesReserved() const
+{
+    size_t total = 0;
+    for (const auto& block : m_blocks) total += block.capacity;
+    return total;
+}
+
+//==========================================================================================
+// Internal
+
+char* RenderArena::allocate(size_t size, size_t alignment)
+{
+    while (m_currentBlock < m_blocks.size())
+    {
+        Block& block = m_blocks[m_currentBlock];
+        size_t offset = (m_blockOffset + alignment - 1) & ~(alignment - 1);
+        if (offset <= block.capacity && block.capacity - offset >= size)
+        {
+            char* result = block.data.get() + offset;
+            m_blockOffset = offset + size;
+            return result;
+        }
+        ++m_currentBlock;
+        m_blockOffset = 0;
+    }
+
+    Block block;
+    block.capacity = std::max(size, m_blockSize);
+    block.data.reset(new char[block.capacity]);
+    m_blocks.push_back(std::move(block));
+
+    m_currentBlock = m_blocks.size() - 1;
+    m_blockOffset = size;
+    return m_blocks.back().data.get();
+}
+
+} // namespace YuchenUI
@@ -0,0 +1,744 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file RenderBatchCompiler.cpp
+
+    Implementation notes:
+    - First pass walks the commands once: clip stack, culling, vertex generation into
+      per-pipeline scratch streams and batch placement
+    - Second pass (finalizeStreams) makes each batch's vertices contiguous. When no
+      command joined an earlier batch the scratch order is already final and the
+      streams are swapped instead of copied
+    - Bounds are the exact extent of the emitted vertices, so "does not overlap" means
+      no pixel can be touched by both
+    - Gradient rects go through the rect pipeline as one quad per stop segment. Every
+      quad carries the whole rect for the rounded-corner SDF and its two stop colors
+      on the matching edges, so the rasterizer's color interpolation draws the ramp
+      and no shader change is needed
+    - All text of the list is handed to TextRenderer::shapeTextBatch() before the first
+      pass, so uncached strings are shaped in parallel instead of one by one in emitText
+    - Text is placed once per glyph atlas it samples, so a string spilling into a second
+      atlas becomes two batches (one bind each) instead of sampling the wrong texture
+    - Glyphs rasterized during compile() are uploaded together at its end
+    - Image and nine-slice geometry matches what the Metal backend produced before the
+      compiler existed, so output is unchanged
+*/
+
+#include "YuchenUI/rendering/RenderBatchCompiler.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/text/TextRenderer.h"
+#include "YuchenUI/image/TextureCache.h"
+#include "YuchenUI/core/Config.h"
+#include "YuchenUI/core/Assert.h"
+#include "YuchenUI/debugging/debug.h"
+#include <algorithm>
+#include <cmath>
+
+namespace YuchenUI {
+
+namespace {
+
+constexpr uint32_t NO_BATCH = 0xFFFFFFFFu;
+
+bool overlaps(const Rect& a, const Rect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+Rect unite(const Rect& a, const Rect& b)
+{
+    float x1 = std::min(a.x, b.x);
+    float y1 = std::min(a.y, b.y);
+    float x2 = std::max(a.x + a.width, b.x + b.width);
+    float y2 = std::max(a.y + a.height, b.y + b.height);
+    return Rect(x1, y1, x2 - x1, y2 - y1);
+}
+
+Rect intersectClip(const Rect& parent, const Rect& clip)
+{
+    float x1 = std::max(parent.x, clip.x);
+    float y1 = std::max(parent.y, clip.y);
+    float x2 = std::min(parent.x + parent.width, clip.x + clip.width);
+    float y2 = std::min(parent.y + parent.height, clip.y + clip.height);
+
+    if (x2 > x1 && y2 > y1) return Rect(x1, y1, x2 - x1, y2 - y1);
+    return Rect(0, 0, 0, 0);
+}
+
+/** Running bounding box over a set of points. */
+struct PointBounds {
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+
+    void add(const Vec2& p)
+    {
+        minX = std::min(minX, p.x); minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x); maxY = std::max(maxY, p.y);
+    }
+
+    Rect toRect() const
+    {
+        if (minX > maxX) return Rect();
+        return Rect(minX, minY, maxX - minX, maxY - minY);
+    }
+};
+
+template <typename Vertex>
+void scatter(const std::vector<Vertex>& scratch, std::vector<Vertex>& out,
+             uint32_t from, uint32_t count, uint32_t to)
+{
+    std::copy(scratch.begin() + from, scratch.begin() + from + count, out.begin() + to);
+}
+
+} // anonymous namespace
+
+//==========================================================================================
+// Lifecycle
+
+RenderBatchCompiler::RenderBatchCompiler(TextRenderer* textRenderer, TextureCache* textureCache)
+    : m_textRenderer(textRenderer)
+    , m_textureCache(textureCache)
+    , m_viewportSize()
+    , m_hasClearColor(false)
+    , m_clearColor()
+    , m_stats()
+{
+}
+
+RenderBatchCompiler::~RenderBatchCompiler() = default;
+
+//==========================================================================================
+// Compilation
+
+void RenderBatchCompiler::compile(const RenderList& commandList, const Vec2& viewportSize)
+{
+    YUCHEN_ASSERT_MSG(viewportSize.x > 0.0f && viewportSize.y > 0.0f, "Viewport size must be positive");
+
+    m_viewportSize = viewportSize;
+    m_batches.clear();
+    m_pending.clear();
+    m_clipStack.clear();
+    m_rectScratch.clear();
+    m_textScratch.clear();
+    m_imageScratch.clear();
+    m_shapeScratch.clear();
+    m_circleScratch.clear();
+    m_hasClearColor = false;
+    m_stats = RenderBatchStats();
+
+    const Rect viewport(0.0f, 0.0f, viewportSize.x, viewportSize.y);
+
+    if (m_textRenderer) shapeText(commandList);
+
+    for (const RenderCommand& cmd : commandList.getCommands())
+    {
+        ActivePipeline pipeline = ActivePipeline::None;
+
+        switch (cmd.type)
+        {
+            case RenderCommandType::Clear:
+                m_clearColor = cmd.clear.color;
+                m_hasClearColor = true;
+                continue;
+
+            case RenderCommandType::PushClip:
+                m_clipStack.push_back(m_clipStack.empty() ? cmd.clip.rect
+                                                          : intersectClip(m_clipStack.back(), cmd.clip.rect));
+                continue;
+
+            case RenderCommandType::PopClip:
+                if (!m_clipStack.empty()) m_clipStack.pop_back();
+                continue;
+
+            case RenderCommandType::FillRect:
+            case RenderCommandType::DrawRect:
+            case RenderCommandType::FillGradientRect:
+                pipeline = ActivePipeline::Rect;
+                break;
+
+            case RenderCommandType::DrawText:
+                pipeline = ActivePipeline::Text;
+                break;
+
+            case RenderCommandType::DrawImage:
+                pipeline = ActivePipeline::Image;
+                break;
+
+            case RenderCommandType::DrawLine:
+            case RenderCommandType::FillTriangle:
+            case RenderCommandType::DrawTriangle:
+                pipeline = ActivePipeline::Shape;
+                break;
+
+            case RenderCommandType::FillCircle:
+            case RenderCommandType::DrawCircle:
+                pipeline = ActivePipeline::Circle;
+                break;
+        }
+
+        ++m_stats.drawCommands;
+
+        bool hasClip = !m_clipStack.empty();
+        Rect clipRect = hasClip ? m_clipStack.back() : Rect();
+        const Rect& visible = hasClip ? clipRect : viewport;
+
+        if (visible.width <= 0.0f || visible.height <= 0.0f)
+        {
+            ++m_stats.culledCommands;
+            continue;
+        }
+
+        uint32_t start = scratchSize(pipeline);
+        void* texture = nullptr;
+        bool repeatSampler = false;
+        bool produced = true;
+        Rect bounds;
+
+        switch (cmd.type)
+        {
+            case RenderCommandType::FillRect:
+            case RenderCommandType::DrawRect:
+                bounds = emitRect(cmd);
+                break;
+
+            case RenderCommandType::FillGradientRect:
+                bounds = emitGradientRect(cmd);
+                break;
+
+            case RenderCommandType::DrawText:
+                produced = emitText(cmd, bounds);
+                break;
+
+            case RenderCommandType::DrawImage:
+                produced = emitImage(cmd, texture, repeatSampler, bounds);
+                break;
+
+            case RenderCommandType::DrawLine:
+                bounds = emitLine(cmd.line.start, cmd.line.end, cmd.line.color, cmd.line.width);
+                break;
+
+            case RenderCommandType::FillTriangle:
+            case RenderCommandType::DrawTriangle:
+                bounds = emitTriangle(cmd);
+                break;
+
+            case RenderCommandType::FillCircle:
+            case RenderCommandType::DrawCircle:
+                bounds = emitCircle(cmd);
+                break;
+
+            default:
+                break;
+        }
+
+        uint32_t count = scratchSize(pipeline) - start;
+        if (!produced || count == 0 || !overlaps(bounds, visible))
+        {
+            truncateScratch(pipeline, start);
+            ++m_stats.culledCommands;
+            continue;
+        }
+
+        if (pipeline == ActivePipeline::Text)
+        {
+            for (const TextPlacement& range : m_textPlacements)
+                place(pipeline, clipRect, hasClip, range.atlas, false, range.bounds,
+                      start + range.firstVertex, range.vertexCount);
+            continue;
+        }
+
+        place(pipeline, clipRect, hasClip, texture, repeatSampler, bounds, start, count);
+    }
+
+    // Glyphs rasterized while emitting text reach their atlas textures in one pass,
+    // before any backend draws these batches
+    if (m_textRenderer) m_textRenderer->flushGlyphUploads();
+
+    finalizeStreams();
+    m_stats.batchCount = m_batches.size();
+}
+
+void RenderBatchCompiler::place(ActivePipeline pipeline, const Rect& clipRect, bool hasClip,
+                                void* texture, bool repeatSampler, const Rect& bounds,
+                                uint32_t firstVertex, uint32_t vertexCount)
+{
+    uint32_t target = NO_BATCH;
+    size_t count = m_batches.size();
+    size_t limit = std::min(count, Config::Rendering::BATCH_LOOKBACK);
+
+    for (size_t n = 0; n < limit; ++n)
+    {
+        size_t index = count - 1 - n;
+        const RenderBatch& batch = m_batches[index];
+
+        bool compatible = batch.pipeline == pipeline &&
+                          batch.hasClip == hasClip &&
+                          (!hasClip || batch.clipRect == clipRect) &&
+                          batch.texture == texture &&
+                          batch.repeatSampler == repeatSampler;
+        if (compatible)
+        {
+            target = static_cast<uint32_t>(index);
+            break;
+        }
+
+        // Moving in front of something we would overlap changes the result
+        if (overlaps(batch.bounds, bounds)) break;
+    }
+
+    if (target == NO_BATCH)
+    {
+        RenderBatch batch;
+        batch.pipeline = pipeline;
+        batch.clipRect = clipRect;
+        batch.hasClip = hasClip;
+        batch.repeatSampler = repeatSampler;
+        batch.texture = texture;
+        batch.firstVertex = firstVertex;
+        batch.bounds = bounds;
+        m_batches.push_back(batch);
+        target = static_cast<uint32_t>(count);
+    }
+    else
+    {
+        if (target != count - 1) ++m_stats.reorderedCommands;
+        m_batches[target].bounds = unite(m_batches[target].bounds, bounds);
+    }
+
+    m_batches[target].vertexCount += vertexCount;
+    m_batches[target].commandCount += 1;
+    m_pending.push_back(PendingCommand{target, firstVertex, vertexCount});
+}
+
+void RenderBatchCompiler::finalizeStreams()
+{
+    // Without reordering every batch already covers a contiguous scratch range
+    if (m_stats.reorderedCommands == 0)
+    {
+        m_rectVertices.swap(m_rectScratch);
+        m_textVertices.swap(m_textScratch);
+        m_imageVertices.swap(m_imageScratch);
+        m_shapeVertices.swap(m_shapeScratch);
+        m_circleVertices.swap(m_circleScratch);
+        return;
+    }
+
+    uint32_t cursor[6] = {};
+    m_batchCursor.resize(m_batches.size());
+
+    for (size_t i = 0; i < m_batches.size(); ++i)
+    {
+        RenderBatch& batch = m_batches[i];
+        uint32_t& next = cursor[static_cast<int>(batch.pipeline)];
+        batch.firstVertex = next;
+        m_batchCursor[i] = next;
+        next += batch.vertexCount;
+    }
+
+    m_rectVertices.resize(cursor[static_cast<int>(ActivePipeline::Rect)]);
+    m_textVertices.resize(cursor[static_cast<int>(ActivePipeline::Text)]);
+    m_imageVertices.resize(cursor[static_cast<int>(ActivePipeline::Image)]);
+    m_shapeVertices.resize(cursor[static_cast<int>(ActivePipeline::Shape)]);
+    m_circleVertices.resize(cursor[static_cast<int>(ActivePipeline::Circle)]);
+
+    for (const PendingCommand& pending : m_pending)
+    {
+        uint32_t& to = m_batchCursor[pending.batch];
+
+        switch (m_batches[pending.batch].pipeline)
+        {
+            case ActivePipeline::Rect:   scatter(m_rectScratch, m_rectVertices, pending.firstVertex, pending.vertexCount, to); break;
+            case ActivePipeline::Text:   scatter(m_textScratch, m_textVertices, pending.firstVertex, pending.vertexCount, to); break;
+            case ActivePipeline::Image:  scatter(m_imageScratch, m_imageVertices, pending.firstVertex, pending.vertexCount, to); break;
+            case ActivePipeline::Shape:  scatter(m_shapeScratch, m_shapeVertices, pending.firstVertex, pending.vertexCount, to); break;
+            case ActivePipeline::Circle: scatter(m_circleScratch, m_circleVertices, pending.firstVertex, pending.vertexCount, to); break;
+            default: break;
+        }
+
+        to += pending.vertexCount;
+    }
+}
+
+//==========================================================================================
+// Rectangles and Shapes
+
+Rect RenderBatchCompiler::emitRect(const RenderCommand& cmd)
+{
+    const auto& r = cmd.rectangle;
+
+    float left, right, top, bottom;
+    toNDC(r.rect.x, r.rect.y, left, top);
+    toNDC(r.rect.x + r.rect.width, r.rect.y + r.rect.height, right, bottom);
+
+    m_rectScratch.emplace_back(Vec2(left, top), r.rect, r.cornerRadius, r.color, r.borderWidth);
+    m_rectScratch.emplace_back(Vec2(left, bottom), r.rect, r.cornerRadius, r.color, r.borderWidth);
+    m_rectScratch.emplace_back(Vec2(right, bottom), r.rect, r.cornerRadius, r.color, r.borderWidth);
+    m_rectScratch.emplace_back(Vec2(left, top), r.rect, r.cornerRadius, r.color, r.borderWidth);
+    m_rectScratch.emplace_back(Vec2(right, bottom), r.rect, r.cornerRadius, r.color, r.borderWidth);
+    m_rectScratch.emplace_back(Vec2(right, top), r.rect, r.cornerRadius, r.color, r.borderWidth);
+
+    return r.rect;
+}
+
+Rect RenderBatchCompiler::emitGradientRect(const RenderCommand& cmd)
+{
+    const auto& g = cmd.gradient;
+    const bool vertical = g.direction == GradientDirection::Vertical;
+    const float origin = vertical ? g.rect.y : g.rect.x;
+    const float extent = vertical ? g.rect.height : g.rect.width;
+
+    // One quad spanning [from, to] of the axis, blending startColor into endColor
+    auto emitSegment = [&](float from, float to, const Vec4& startColor, const Vec4& endColor) {
+        if (to <= from) return;
+
+        float a = origin + extent * from;
+        float b = origin + extent * to;
+        Rect quad = vertical ? Rect(g.rect.x, a, g.rect.width, b - a) : Rect(a, g.rect.y, b - a, g.rect.height);
+
+        float left, right, top, bottom;
+        toNDC(quad.x, quad.y, left, top);
+        toNDC(quad.x + quad.width, quad.y + quad.height, right, bottom);
+
+        const Vec4& topLeft = startColor;
+        const Vec4& topRight = vertical ? startColor : endColor;
+        const Vec4& bottomLeft = vertical ? endColor : startColor;
+        const Vec4& bottomRight = endColor;
+
+        m_rectScratch.emplace_back(Vec2(left, top), g.rect, g.cornerRadius, topLeft);
+        m_rectScratch.emplace_back(Vec2(left, bottom), g.rect, g.cornerRadius, bottomLeft);
+        m_rectScratch.emplace_back(Vec2(right, bottom), g.rect, g.cornerRadius, bottomRight);
+        m_rectScratch.emplace_back(Vec2(left, top), g.rect, g.cornerRadius, topLeft);
+        m_rectScratch.emplace_back(Vec2(right, bottom), g.rect, g.cornerRadius, bottomRight);
+        m_rectScratch.emplace_back(Vec2(right, top), g.rect, g.cornerRadius, topRight);
+    };
+
+    const GradientStop* stops = g.stops;
+    const uint32_t last = g.stopCount - 1;
+
+    emitSegment(0.0f, stops[0].position, stops[0].color, stops[0].color);
+    for (uint32_t i = 0; i < last; ++i)
+        emitSegment(stops[i].position, stops[i + 1].position, stops[i].color, stops[i + 1].color);
+    emitSegment(stops[last].position, 1.0f, stops[last].color, stops[last].color);
+
+    return g.rect;
+}
+
+Rect RenderBatchCompiler::emitLine(const Vec2& start, const Vec2& end, const Vec4& color, float width)
+{
+    Vec2 direction(end.x - start.x, end.y - start.y);
+    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+
+    if (length < 0.001f) return Rect();
+
+    direction.x /= length;
+    direction.y /= length;
+
+    Vec2 perpendicular(-direction.y, direction.x);
+    float halfWidth = width * 0.5f;
+
+    Vec2 p1(start.x + perpendicular.x * halfWidth, start.y + perpendicular.y * halfWidth);
+    Vec2 p2(start.x - perpendicular.x * halfWidth, start.y - perpendicular.y * halfWidth);
+    Vec2 p3(end.x - perpendicular.x * halfWidth, end.y - perpendicular.y * halfWidth);
+    Vec2 p4(end.x + perpendicular.x * halfWidth, end.y + perpendicular.y * halfWidth);
+
+    m_shapeScratch.emplace_back(p1, color);
+    m_shapeScratch.emplace_back(p2, color);
+    m_shapeScratch.emplace_back(p3, color);
+    m_shapeScratch.emplace_back(p1, color);
+    m_shapeScratch.emplace_back(p3, color);
+    m_shapeScratch.emplace_back(p4, color);
+
+    PointBounds pb;
+    pb.add(p1); pb.add(p2); pb.add(p3); pb.add(p4);
+    return pb.toRect();
+}
+
+Rect RenderBatchCompiler::emitTriangle(const RenderCommand& cmd)
+{
+    const auto& t = cmd.triangle;
+
+    if (cmd.type == RenderCommandType::FillTriangle)
+    {
+        m_shapeScratch.emplace_back(t.p1, t.color);
+        m_shapeScratch.emplace_back(t.p2, t.color);
+        m_shapeScratch.emplace_back(t.p3, t.color);
+
+        PointBounds pb;
+        pb.add(t.p1); pb.add(t.p2); pb.add(t.p3);
+        return pb.toRect();
+    }
+
+    // Outline: three edge quads
+    Rect bounds = emitLine(t.p1, t.p2, t.color, t.borderWidth);
+    bounds = unite(bounds, emitLine(t.p2, t.p3, t.color, t.borderWidth));
+    bounds = unite(bounds, emitLine(t.p3, t.p1, t.color, t.borderWidth));
+    return bounds;
+}
+
+Rect RenderBatchCompiler::emitCircle(const RenderCommand& cmd)
+{
+    const auto& c = cmd.circle;
+    float bw = cmd.type == RenderCommandType::FillCircle ? 0.0f : c.borderWidth;
+
+    // Bounding quad with room for the antialiased edge
+    float left = c.center.x - c.radius - 2.0f;
+    float right = c.center.x + c.radius + 2.0f;
+    float top = c.center.y - c.radius - 2.0f;
+    float bottom = c.center.y + c.radius + 2.0f;
+
+    m_circleScratch.emplace_back(Vec2(left, top), c.center, c.radius, bw, c.color);
+    m_circleScratch.emplace_back(Vec2(left, bottom), c.center, c.radius, bw, c.color);
+    m_circleScratch.emplace_back(Vec2(right, bottom), c.center, c.radius, bw, c.color);
+    m_circleScratch.emplace_back(Vec2(left, top), c.center, c.radius, bw, c.color);
+    m_circleScratch.emplace_back(Vec2(right, bottom), c.center, c.radius, bw, c.color);
+    m_circleScratch.emplace_back(Vec2(right, top), c.center, c.radius, bw, c.color);
+
+    return Rect(left, top, right - left, bottom - top);
+}
+
+//==========================================================================================
+// Text
+
+void RenderBatchCompiler::shapeText(const RenderList& commandList)
+{
+    m_shapeRequests.clear();
+
+    for (const RenderCommand& cmd : commandList.getCommands())
+    {
+        if (cmd.type != RenderCommandType::DrawText) continue;
+
+        const auto& t = cmd.text;
+        if (!t.fontChain || t.length == 0) continue;
+
+        m_shapeRequests.push_back({ t.utf8, t.length, t.fontChain, t.fontSize, t.letterSpacing });
+    }
+
+    if (!m_shapeRequests.empty()) m_textRenderer->shapeTextBatch(m_shapeRequests);
+}
+
+bool RenderBatchCompiler::emitText(const RenderCommand& cmd, Rect& outBounds)
+{
+    const auto& t = cmd.text;
+    m_textPlacements.clear();
+    if (!m_textRenderer || !t.fontChain || t.length == 0) return false;
+
+    ShapedTextRef shaped = m_textRenderer->shapeText(t.utf8, *t.fontChain, t.fontSize, t.letterSpacing);
+    if (shaped->isEmpty()) return false;
+
+    m_textRenderer->generateTextVertices(*shaped, t.position, t.color, *t.fontChain,
+                                         t.fontSize, m_glyphVertices, m_glyphRanges);
+
+    // Ranges are contiguous per atlas; ranges whose atlas has no texture are dropped
+    uint32_t emitted = 0;
+    for (const TextVertexRange& range : m_glyphRanges)
+    {
+        if (!range.atlasTexture || range.vertexCount == 0) continue;
+
+        auto begin = m_glyphVertices.begin() + range.firstVertex;
+        auto end = begin + range.vertexCount;
+
+        PointBounds pb;
+        for (auto it = begin; it != end; ++it) pb.add(it->position);
+
+        const Rect bounds = pb.toRect();
+        outBounds = emitted == 0 ? bounds : unite(outBounds, bounds);
+        m_textPlacements.push_back({ range.atlasTexture, bounds, emitted, range.vertexCount });
+        m_textScratch.insert(m_textScratch.end(), begin, end);
+        emitted += range.vertexCount;
+    }
+
+    return emitted > 0;
+}
+
+//==========================================================================================
+// Images
+
+bool RenderBatchCompiler::emitImage(const RenderCommand& cmd, void*& outTexture,
+                                    bool& outRepeat, Rect& outBounds)
+{
+    const auto& img = cmd.image;
+    if (!m_textureCache) return false;
+
+    uint32_t texWidth = 0, texHeight = 0;
+    float designScale = 1.0f;
+    void* texture = m_textureCache->getTexture(img.resourceNamespace, img.resourcePath,
+                                               texWidth, texHeight, &designScale);
+    if (!texture || texWidth == 0 || texHeight == 0) return false;
+
+    YUCHEN_PERF_TEXTURE_USAGE(img.resourcePath);
+    outTexture = texture;
+
+    if (img.scaleMode == ScaleMode::Tile)
+    {
+        float logicalWidth = texWidth / designScale;
+        float logicalHeight = texHeight / designScale;
+        float repeatX = img.destRect.width / logicalWidth;
+        float repeatY = img.destRect.height / logicalHeight;
+
+        emitImageQuad(img.destRect, Vec2(0.0f, 0.0f), Vec2(repeatX, repeatY));
+        outRepeat = true;
+        outBounds = img.destRect;
+        return true;
+    }
+
+    Rect sourceRect = img.sourceRect;
+    if (sourceRect.width == 0.0f || sourceRect.height == 0.0f)
+    {
+        sourceRect = Rect(0, 0, static_cast<float>(texWidth), static_cast<float>(texHeight));
+    }
+    else
+    {
+        sourceRect.x *= designScale;
+        sourceRect.y *= designScale;
+        sourceRect.width *= designScale;
+        sourceRect.height *= designScale;
+    }
+
+    Rect destRect = img.destRect;
+
+    if (img.scaleMode == ScaleMode::Original)
+    {
+        float logicalWidth = sourceRect.width / designScale;
+        float logicalHeight = sourceRect.height / designScale;
+        float centerX = destRect.x + destRect.width * 0.5f;
+        float centerY = destRect.y + destRect.height * 0.5f;
+        destRect = Rect(centerX - logicalWidth * 0.5f, centerY - logicalHeight * 0.5f,
+                        logicalWidth, logicalHeight);
+    }
+    else if (img.scaleMode == ScaleMode::Fill)
+    {
+        float destAspect = destRect.width / destRect.height;
+        float srcAspect = sourceRect.width / sourceRect.height;
+        if (srcAspect > destAspect)
+        {
+            float newHeight = destRect.width / srcAspect;
+            destRect = Rect(destRect.x, destRect.y + (destRect.height - newHeight) * 0.5f,
+                            destRect.width, newHeight);
+        }
+        else
+        {
+            float newWidth = destRect.height * srcAspect;
+            destRect = Rect(destRect.x + (destRect.width - newWidth) * 0.5f, destRect.y,
+                            newWidth, destRect.height);
+        }
+    }
+
+    if (img.scaleMode == ScaleMode::NineSlice)
+    {
+        YUCHEN_PERF_NINE_SLICE();
+        emitNineSlice(destRect, sourceRect, img.nineSliceMargins, designScale, texWidth, texHeight);
+    }
+    else
+    {
+        YUCHEN_PERF_IMAGE_DRAW();
+        emitImageQuad(destRect,
+                      Vec2(sourceRect.x / texWidth, sourceRect.y / texHeight),
+                      Vec2((sourceRect.x + sourceRect.width) / texWidth,
+                           (sourceRect.y + sourceRect.height) / texHeight));
+    }
+
+    outRepeat = false;
+    outBounds = destRect;
+    return true;
+}
+
+void RenderBatchCompiler::emitImageQuad(const Rect& destRect, const Vec2& uvMin, const Vec2& uvMax)
+{
+    float left, right, top, bottom;
+    toNDC(destRect.x, destRect.y, left, top);
+    toNDC(destRect.x + destRect.width, destRect.y + destRect.height, right, bottom);
+
+    m_imageScratch.emplace_back(Vec2(left, top), Vec2(uvMin.x, uvMin.y));
+    m_imageScratch.emplace_back(Vec2(left, bottom), Vec2(uvMin.x, uvMax.y));
+    m_imageScratch.emplace_back(Vec2(right, bottom), Vec2(uvMax.x, uvMax.y));
+    m_imageScratch.emplace_back(Vec2(left, top), Vec2(uvMin.x, uvMin.y));
+    m_imageScratch.emplace_back(Vec2(right, bottom), Vec2(uvMax.x, uvMax.y));
+    m_imageScratch.emplace_back(Vec2(right, top), Vec2(uvMax.x, uvMin.y));
+}
+
+void RenderBatchCompiler::emitNineSlice(const Rect& destRect, const Rect& sourceRect,
+                                        const NineSliceMargins& margins, float designScale,
+                                        uint32_t texWidth, uint32_t texHeight)
+{
+    // Destination slices (logical pixels)
+    float destCenterWidth = std::max(0.0f, destRect.width - margins.left - margins.right);
+    float destCenterHeight = std::max(0.0f, destRect.height - margins.top - margins.bottom);
+
+    float dx[3] = { destRect.x, destRect.x + margins.left, destRect.x + margins.left + destCenterWidth };
+    float dy[3] = { destRect.y, destRect.y + margins.top, destRect.y + margins.top + destCenterHeight };
+    float dw[3] = { margins.left, destCenterWidth, margins.right };
+    float dh[3] = { margins.top, destCenterHeight, margins.bottom };
+
+    // Source slices (texture pixels)
+    float srcLeft = margins.left * designScale;
+    float srcTop = margins.top * designScale;
+    float srcRight = margins.right * designScale;
+    float srcBottom = margins.bottom * designScale;
+
+    float sx[3] = { sourceRect.x, sourceRect.x + srcLeft, sourceRect.x + sourceRect.width - srcRight };
+    float sy[3] = { sourceRect.y, sourceRect.y + srcTop, sourceRect.y + sourceRect.height - srcBottom };
+    float sw[3] = { srcLeft, sourceRect.width - srcLeft - srcRight, srcRight };
+    float sh[3] = { srcTop, sourceRect.height - srcTop - srcBottom, srcBottom };
+
+    for (int row = 0; row < 3; ++row)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            if (dw[col] <= 0.0f || dh[row] <= 0.0f || sw[col] <= 0.0f || sh[row] <= 0.0f) continue;
+
+            emitImageQuad(Rect(dx[col], dy[row], dw[col], dh[row]),
+                          Vec2(sx[col] / texWidth, sy[row] / texHeight),
+                          Vec2((sx[col] + sw[col]) / texWidth, (sy[row] + sh[row]) / texHeight));
+        }
+    }
+}
+
+//==========================================================================================
+// Utilities
+
+void RenderBatchCompiler::toNDC(float x, float y, float& ndcX, float& ndcY) const
+{
+    ndcX = (x / m_viewportSize.x) * 2.0f - 1.0f;
+    ndcY = 1.0f - (y / m_viewportSize.y) * 2.0f;
+}
+
+uint32_t RenderBatchCompiler::scratchSize(ActivePipeline pipeline) const
+{
+    switch (pipeline)
+    {
+        case ActivePipeline::Rect:   return static_cast<uint32_t>(m_rectScratch.size());
+        case ActivePipeline::Text:   return static_cast<uint32_t>(m_textScratch.size());
+        case ActivePipeline::Image:  return static_cast<uint32_t>(m_imageScratch.size());
+        case ActivePipeline::Shape:  return static_cast<uint32_t>(m_shapeScratch.size());
+        case ActivePipeline::Circle: return static_cast<uint32_t>(m_circleScratch.size());
+        default:                     return 0;
+    }
+}
+
+void RenderBatchCompiler::truncateScratch(ActivePipeline pipeline, uint32_t size)
+{
+    switch (pipeline)
+    {
+        case ActivePipeline::Rect:   m_rectScratch.resize(size); break;
+        case ActivePipeline::Text:   m_textScratch.resize(size); break;
+        case ActivePipeline::Image:  m_imageScratch.resize(size); break;
+        case ActivePipeline::Shape:  m_shapeScratch.resize(size); break;
+        case ActivePipeline::Circle: m_circleScratch.resize(size); break;
+        default: break;
+    }
+}
+
+} // namespace YuchenUI
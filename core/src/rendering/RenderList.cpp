@@ -18,6 +18,10 @@
     
     Implementation notes:
     - Commands stored in linear vector for cache-friendly iteration
+    - Commands are trivially copyable; text, resource paths and font chains are
+      copied into the per-list RenderArena, which is rewound on reset()
+    - Vector and arena capacity survive reset(), so steady-state recording does
+      not touch the heap
     - Validation performed on command parameters before adding
     - Clip stack maintained separately for hierarchical clipping
     - Text length capped at Config::Text::MAX_LENGTH
@@ -33,21 +37,431 @@
     Version 2.1 Changes:
     - Added drawImageRegion() for sprite sheet support
     - Updated validation to handle both full image and region rendering
+    
+    Version 2.3 Changes:
+    - append() copies commands from another list; the source was validated when it
+      was recorded, so replay only translates and re-stores arena data
+    
+    Version 2.4 Changes:
+    - Every recorded command is folded into a running 64-bit fingerprint. Fields are
+      hashed one by one (never raw union bytes, whose padding is undefined), and text,
+      paths and font chains by content, since arena addresses differ between frames
+    - coalesceFillRects() compacts the command vector in place in one pass; only
+      exact float edge equality counts as abutting, so nothing is merged by tolerance
+    
+    Version 2.5 Changes:
+    - Gradient stops are copied into the arena like strings; the fingerprint hashes
+      them by value
+    - coalesceFillRects() folds runs of one-pixel columns into gradient fills with a
+      stop wherever the colors bend, checked against 8-bit output; the stops go to
+      the arena, so the commands stay valid until reset()
 */
 
 #include "YuchenUI/rendering/RenderList.h"
 #include "YuchenUI/core/Validation.h"
 #include "YuchenUI/core/Config.h"
+#include <algorithm>
+#include <cmath>
 #include <cstring>
 
 namespace YuchenUI {
 
+namespace {
+
+//==========================================================================================
+// Fingerprint mixing
+
+constexpr uint64_t FINGERPRINT_SEED = 0xcbf29ce484222325ull;
+constexpr uint64_t FINGERPRINT_MULTIPLIER = 0x9e3779b97f4a7c15ull;
+
+inline uint64_t mixWord(uint64_t hash, uint64_t word)
+{
+    return (((hash << 5) | (hash >> 59)) ^ word) * FINGERPRINT_MULTIPLIER;
+}
+
+inline uint64_t mixFloat(uint64_t hash, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return mixWord(hash, bits);
+}
+
+inline uint64_t mixFloats(uint64_t hash, float a, float b)
+{
+    uint32_t bits[2];
+    std::memcpy(&bits[0], &a, sizeof(float));
+    std::memcpy(&bits[1], &b, sizeof(float));
+    return mixWord(hash, (static_cast<uint64_t>(bits[0]) << 32) | bits[1]);
+}
+
+inline uint64_t mixVec2(uint64_t hash, const Vec2& v) { return mixFloats(hash, v.x, v.y); }
+inline uint64_t mixVec4(uint64_t hash, const Vec4& v) { return mixFloats(mixFloats(hash, v.x, v.y), v.z, v.w); }
+inline uint64_t mixRect(uint64_t hash, const Rect& r) { return mixFloats(mixFloats(hash, r.x, r.y), r.width, r.height); }
+
+uint64_t mixBytes(uint64_t hash, const char* data, size_t length)
+{
+    hash = mixWord(hash, length);
+    if (!data) return hash;
+    
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = mixWord(hash, word);
+    }
+    
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, length - i);
+    return mixWord(hash, tail);
+}
+
+inline uint64_t mixString(uint64_t hash, const char* text)
+{
+    return mixBytes(hash, text, text ? std::strlen(text) : 0);
+}
+
+uint64_t mixCommand(uint64_t hash, const RenderCommand& cmd)
+{
+    hash = mixWord(hash, static_cast<uint64_t>(cmd.type));
+    
+    switch (cmd.type)
+    {
+        case RenderCommandType::Clear:
+            return mixVec4(hash, cmd.clear.color);
+            
+        case RenderCommandType::FillRect:
+        case RenderCommandType::DrawRect:
+        {
+            const auto& d = cmd.rectangle;
+            hash = mixVec4(mixRect(hash, d.rect), d.color);
+            hash = mixFloats(mixFloats(hash, d.cornerRadius.topLeft, d.cornerRadius.topRight),
+                             d.cornerRadius.bottomLeft, d.cornerRadius.bottomRight);
+            return mixFloat(hash, d.borderWidth);
+        }
+            
+        case RenderCommandType::FillGradientRect:
+        {
+            const auto& d = cmd.gradient;
+            hash = mixRect(hash, d.rect);
+            hash = mixFloats(mixFloats(hash, d.cornerRadius.topLeft, d.cornerRadius.topRight),
+                             d.cornerRadius.bottomLeft, d.cornerRadius.bottomRight);
+            hash = mixWord(mixWord(hash, static_cast<uint64_t>(d.direction)), d.stopCount);
+            for (uint32_t i = 0; i < d.stopCount; ++i)
+                hash = mixVec4(mixFloat(hash, d.stops[i].position), d.stops[i].color);
+            return hash;
+        }
+            
+        case RenderCommandType::DrawText:
+        {
+            const auto& d = cmd.text;
+            hash = mixVec4(mixVec2(hash, d.position), d.color);
+            hash = mixFloats(hash, d.fontSize, d.letterSpacing);
+            hash = mixBytes(hash, d.utf8, d.length);
+            if (d.fontChain)
+            {
+                for (FontHandle font : d.fontChain->fonts) hash = mixWord(hash, font);
+            }
+            return hash;
+        }
+            
+        case RenderCommandType::DrawImage:
+        {
+            const auto& d = cmd.image;
+            hash = mixRect(mixRect(hash, d.destRect), d.sourceRect);
+            hash = mixFloats(mixFloats(hash, d.nineSliceMargins.left, d.nineSliceMargins.top),
+                             d.nineSliceMargins.right, d.nineSliceMargins.bottom);
+            hash = mixWord(hash, static_cast<uint64_t>(d.scaleMode));
+            hash = mixString(mixString(hash, d.resourceNamespace), d.resourcePath);
+            return mixWord(hash, reinterpret_cast<uintptr_t>(d.textureHandle));
+        }
+            
+        case RenderCommandType::DrawLine:
+        {
+            const auto& d = cmd.line;
+            return mixFloat(mixVec4(mixVec2(mixVec2(hash, d.start), d.end), d.color), d.width);
+        }
+            
+        case RenderCommandType::FillTriangle:
+        case RenderCommandType::DrawTriangle:
+        {
+            const auto& d = cmd.triangle;
+            hash = mixVec2(mixVec2(mixVec2(hash, d.p1), d.p2), d.p3);
+            return mixFloat(mixVec4(hash, d.color), d.borderWidth);
+        }
+            
+        case RenderCommandType::FillCircle:
+        case RenderCommandType::DrawCircle:
+        {
+            const auto& d = cmd.circle;
+            hash = mixFloat(mixVec2(hash, d.center), d.radius);
+            return mixFloat(mixVec4(hash, d.color), d.borderWidth);
+        }
+            
+        case RenderCommandType::PushClip:
+            return mixRect(hash, cmd.clip.rect);
+            
+        case RenderCommandType::PopClip:
+            return hash;
+    }
+    
+    return hash;
+}
+
+//==========================================================================================
+// Fill rect coalescing
+
+inline bool isSquareFill(const RenderCommand& cmd)
+{
+    if (cmd.type != RenderCommandType::FillRect) return false;
+    const CornerRadius& r = cmd.rectangle.cornerRadius;
+    return r.topLeft == 0.0f && r.topRight == 0.0f && r.bottomLeft == 0.0f && r.bottomRight == 0.0f;
+}
+
+/** Returns true if a coordinate falls on a physical pixel edge. */
+inline bool isPixelEdge(float coordinate, float pixelScale)
+{
+    const float pixels = coordinate * pixelScale;
+    return pixels == std::floor(pixels);
+}
+
+/** Grows target to cover next if the two can be drawn as one rect. */
+bool tryMergeFill(RenderCommand& target, const RenderCommand& next, float pixelScale)
+{
+    if (!isSquareFill(target) || !isSquareFill(next)) return false;
+    if (target.rectangle.color != next.rectangle.color) return false;
+    
+    Rect& a = target.rectangle.rect;
+    const Rect& b = next.rectangle.rect;
+    
+    // A seam inside a pixel is drawn as two antialiased edges, not as solid color
+    if (a.y == b.y && a.height == b.height && a.x + a.width == b.x && isPixelEdge(b.x, pixelScale))
+    {
+        a.width += b.width;
+        return true;
+    }
+    
+    if (a.x == b.x && a.width == b.width && a.y + a.height == b.y && isPixelEdge(b.y, pixelScale))
+    {
+        a.height += b.height;
+        return true;
+    }
+    
+    return false;
+}
+
+//==========================================================================================
+// Column ramp folding
+
+/** Extent of a rect along a gradient axis and across it. */
+struct AxisSpan
+{
+    float start, size, crossStart, crossSize;
+};
+
+inline AxisSpan axisSpan(const Rect& rect, bool vertical)
+{
+    return vertical ? AxisSpan{ rect.y, rect.height, rect.x, rect.width }
+                    : AxisSpan{ rect.x, rect.width, rect.y, rect.height };
+}
+
+/** Returns true if next is the one-pixel column right after previous along the axis. */
+inline bool isNextColumn(const Rect& previous, const Rect& next, bool vertical, float pixelScale)
+{
+    const AxisSpan a = axisSpan(previous, vertical);
+    const AxisSpan b = axisSpan(next, vertical);
+    return b.start == a.start + a.size && b.size * pixelScale == 1.0f &&
+           b.crossStart == a.crossStart && b.crossSize == a.crossSize;
+}
+
+/**
+    Distance from an 8-bit level that a ramp may stray and still land on that level.
+    What is left to the rounding edge absorbs the backends' interpolation error.
+*/
+constexpr float RAMP_LEVEL_TOLERANCE = 0.49f;
+
+/** Returns the 8-bit level a color channel is written as. */
+inline float levelOf(float channel)
+{
+    channel = channel < 0.0f ? 0.0f : (channel > 1.0f ? 1.0f : channel);
+    return std::floor(channel * 255.0f + 0.5f);
+}
+
+inline Vec4 clampColor(const Vec4& c)
+{
+    auto unit = [](float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); };
+    return Vec4(unit(c.x), unit(c.y), unit(c.z), unit(c.w));
+}
+
+/** A run of one-pixel columns redrawn as one gradient fill. */
+struct ColumnRamp
+{
+    size_t columnCount;         ///< Commands covered by the run
+    bool folded;                ///< False for runs of fewer than three colors
+    Rect bounds;
+    GradientDirection direction;
+    GradientStop stops[Config::Rendering::MAX_GRADIENT_STOPS];
+    uint32_t stopCount;
+};
+
+/**
+    Fits a gradient through a run of one-pixel-wide square fills.
+    
+    A gradient is sampled at pixel centers, so one with a stop at the center of every
+    column where the colors bend reproduces each column in between, as long as the line
+    between the stops passes within RAMP_LEVEL_TOLERANCE of that column's 8-bit level.
+    Lines are extended greedily: each keeps the range of slopes that every column on it
+    still allows, and bends at the column before the range runs out.
+    
+    @param commands    Commands from the start of the run
+    @param count       Commands available
+    @param pixelScale  Physical pixels per logical unit
+    @param ramp        Receives the run; columnCount is 0 if commands[0] starts none
+*/
+void fitColumnRamp(const RenderCommand* commands, size_t count, float pixelScale, ColumnRamp& ramp)
+{
+    ramp.columnCount = 0;
+    ramp.folded = false;
+    if (count < 3 || !isSquareFill(commands[0]) || !isSquareFill(commands[1])) return;
+    
+    const Rect& first = commands[0].rectangle.rect;
+    const Rect& second = commands[1].rectangle.rect;
+    bool vertical = false;
+    if (!isNextColumn(first, second, false, pixelScale))
+    {
+        if (!isNextColumn(first, second, true, pixelScale)) return;
+        vertical = true;
+    }
+    
+    const AxisSpan head = axisSpan(first, vertical);
+    if (head.size * pixelScale != 1.0f || !isPixelEdge(head.start, pixelScale)) return;
+    
+    size_t n = 2;
+    while (n < count && isSquareFill(commands[n]) &&
+           isNextColumn(commands[n - 1].rectangle.rect, commands[n].rectangle.rect, vertical, pixelScale))
+        ++n;
+    ramp.columnCount = n;
+    
+    // A gradient draws as one quad per stop plus one; a single step between two colors
+    // is fewer quads as two merged rects
+    size_t colorRuns = 1;
+    for (size_t i = 1; i < n && colorRuns < 3; ++i)
+        if (commands[i].rectangle.color != commands[i - 1].rectangle.color) ++colorRuns;
+    if (colorRuns < 3) return;
+    
+    // Lines are fitted in 8-bit levels, one lane per channel
+    auto levelsAt = [&](size_t i, float out[4]) {
+        const Vec4& c = commands[i].rectangle.color;
+        out[0] = levelOf(c.x);
+        out[1] = levelOf(c.y);
+        out[2] = levelOf(c.z);
+        out[3] = levelOf(c.w);
+    };
+    
+    size_t stopColumns[Config::Rendering::MAX_GRADIENT_STOPS];
+    float stopLevels[Config::Rendering::MAX_GRADIENT_STOPS][4];
+    uint32_t stopCount = 0;
+    auto pushStop = [&](size_t column, const float levels[4]) {
+        stopColumns[stopCount] = column;
+        std::copy(levels, levels + 4, stopLevels[stopCount]);
+        ++stopCount;
+    };
+    
+    size_t anchor = 0;
+    float anchorLevels[4];
+    float minSlope[4];
+    float maxSlope[4];
+    levelsAt(0, anchorLevels);
+    std::fill(minSlope, minSlope + 4, -INFINITY);
+    std::fill(maxSlope, maxSlope + 4, INFINITY);
+    pushStop(0, anchorLevels);
+    
+    // Levels at a column on the line from the anchor through the middle of the slope range
+    auto lineAt = [&](size_t column, float out[4]) {
+        const float steps = static_cast<float>(column - anchor);
+        for (int k = 0; k < 4; ++k)
+            out[k] = anchorLevels[k] + (minSlope[k] + maxSlope[k]) * 0.5f * steps;
+    };
+    
+    for (size_t i = anchor + 1; i < n; ++i)
+    {
+        float levels[4];
+        levelsAt(i, levels);
+    
+        // Narrow the slopes to those keeping column i on its level and in the 8-bit range
+        float lo[4];
+        float hi[4];
+        bool fits = true;
+        const float steps = static_cast<float>(i - anchor);
+        for (int k = 0; k < 4; ++k)
+        {
+            const float low = std::max(levels[k] - RAMP_LEVEL_TOLERANCE, 0.0f);
+            const float high = std::min(levels[k] + RAMP_LEVEL_TOLERANCE, 255.0f);
+            lo[k] = std::max(minSlope[k], (low - anchorLevels[k]) / steps);
+            hi[k] = std::min(maxSlope[k], (high - anchorLevels[k]) / steps);
+            fits = fits && lo[k] <= hi[k];
+        }
+    
+        if (fits)
+        {
+            std::copy(lo, lo + 4, minSlope);
+            std::copy(hi, hi + 4, maxSlope);
+            continue;
+        }
+    
+        // The line bends at the previous column, which column i is always one step from
+        float bend[4];
+        lineAt(i - 1, bend);
+        std::copy(bend, bend + 4, anchorLevels);
+        anchor = i - 1;
+        std::fill(minSlope, minSlope + 4, -INFINITY);
+        std::fill(maxSlope, maxSlope + 4, INFINITY);
+    
+        // The last slot is kept for the final stop
+        if (stopCount + 1 == Config::Rendering::MAX_GRADIENT_STOPS)
+        {
+            n = i;
+            break;
+        }
+        pushStop(anchor, anchorLevels);
+        --i;
+    }
+    
+    float last[4];
+    if (anchor == n - 1) std::copy(anchorLevels, anchorLevels + 4, last);
+    else lineAt(n - 1, last);
+    pushStop(n - 1, last);
+    ramp.columnCount = n;
+    
+    for (uint32_t i = 0; i < stopCount; ++i)
+    {
+        const float* l = stopLevels[i];
+        ramp.stops[i].position = (static_cast<float>(stopColumns[i]) + 0.5f) / static_cast<float>(n);
+        ramp.stops[i].color = clampColor(Vec4(l[0] / 255.0f, l[1] / 255.0f, l[2] / 255.0f, l[3] / 255.0f));
+    }
+    
+    const AxisSpan tail = axisSpan(commands[n - 1].rectangle.rect, vertical);
+    ramp.bounds = first;
+    (vertical ? ramp.bounds.height : ramp.bounds.width) = tail.start + tail.size - head.start;
+    ramp.direction = vertical ? GradientDirection::Vertical : GradientDirection::Horizontal;
+    ramp.stopCount = stopCount;
+    ramp.folded = true;
+}
+
+} // namespace
+
 //==========================================================================================
 // Lifecycle
 
-RenderList::RenderList()
+RenderList::RenderList(size_t reservedCommands, size_t arenaBlockSize)
+    : m_arena(arenaBlockSize)
+    , m_cullRect()
+    , m_hasCullRect(false)
+    , m_culledCommands(0)
+    , m_fingerprint(FINGERPRINT_SEED)
+    , m_coalescedCommands(0)
 {
-    m_commands.reserve(1000);
+    m_commands.reserve(reservedCommands);
 }
 
 RenderList::~RenderList()
@@ -87,6 +501,27 @@ void RenderList::drawRect(const Rect& rect, const Vec4& color, float borderWidth
     addCommand(cmd);
 }
 
+void RenderList::fillGradientRect(const Rect& rect, const GradientStop* stops, size_t stopCount,
+                                  GradientDirection direction, const CornerRadius& cornerRadius)
+{
+    Validation::AssertRect(rect);
+    Validation::AssertCornerRadiusForRect(cornerRadius, rect);
+    validateGradientStops(stops, stopCount);
+    
+    RenderCommand cmd = RenderCommand::CreateFillGradientRect(
+        rect, m_arena.storeGradientStops(stops, stopCount), static_cast<uint32_t>(stopCount),
+        direction, cornerRadius
+    );
+    addCommand(cmd);
+}
+
+void RenderList::fillGradientRect(const Rect& rect, const Vec4& startColor, const Vec4& endColor,
+                                  GradientDirection direction, const CornerRadius& cornerRadius)
+{
+    const GradientStop stops[2] = { GradientStop(0.0f, startColor), GradientStop(1.0f, endColor) };
+    fillGradientRect(rect, stops, 2, direction, cornerRadius);
+}
+
 //==========================================================================================
 // Text Drawing (New API with Font Fallback)
 
@@ -104,19 +539,15 @@ void RenderList::drawText(const char* text, const Vec2& position,
     
     if (!text || *text == '\0') return;
     
-    // Apply current clip rect offset if active
-    Vec2 adjustedPosition = position;
-    if (!m_clipStack.empty()) {
-        const Rect& currentClip = m_clipStack.back();
-        adjustedPosition = Vec2(position.x, position.y);
-    }
+    const size_t length = std::strlen(text);
+    const char* storedText = m_arena.storeString(text, length);
+    const FontFallbackChain* storedChain = m_arena.storeFontChain(fallbackChain);
     
-    // Create command with letter spacing
     RenderCommand cmd = RenderCommand::CreateDrawText(
-        text, adjustedPosition, fallbackChain, fontSize, color, letterSpacing
+        storedText, static_cast<uint32_t>(length), position, storedChain, fontSize, color, letterSpacing
     );
     
-    m_commands.push_back(cmd);
+    addCommand(cmd);
 }
 
 //==========================================================================================
@@ -129,15 +560,11 @@ void RenderList::drawImage(const char* namespaceName, const char* resourcePath,
     YUCHEN_ASSERT(resourcePath);
     YUCHEN_ASSERT(destRect.isValid());
     
-    RenderCommand cmd;
-    cmd.type = RenderCommandType::DrawImage;
-    cmd.rect = destRect;
-    cmd.resourceNamespace = namespaceName;
-    cmd.text = resourcePath;
-    cmd.scaleMode = scaleMode;
-    cmd.sourceRect = Rect();
-    cmd.textureHandle = nullptr;
-    cmd.nineSliceMargins = nineSlice;
+    RenderCommand cmd = RenderCommand::CreateDrawImage(
+        m_arena.storeString(namespaceName, std::strlen(namespaceName)),
+        m_arena.storeString(resourcePath, std::strlen(resourcePath)),
+        destRect, Rect(), scaleMode, nineSlice
+    );
     
     validateCommand(cmd);
     addCommand(cmd);
@@ -154,15 +581,11 @@ void RenderList::drawImageRegion(const char* namespaceName, const char* resource
     YUCHEN_ASSERT(sourceRect.isValid());
     YUCHEN_ASSERT(sourceRect.width > 0.0f && sourceRect.height > 0.0f);
     
-    RenderCommand cmd;
-    cmd.type = RenderCommandType::DrawImage;
-    cmd.rect = destRect;
-    cmd.sourceRect = sourceRect;
-    cmd.resourceNamespace = namespaceName;
-    cmd.text = resourcePath;
-    cmd.scaleMode = scaleMode;
-    cmd.textureHandle = nullptr;
-    cmd.nineSliceMargins = NineSliceMargins();
+    RenderCommand cmd = RenderCommand::CreateDrawImage(
+        m_arena.storeString(namespaceName, std::strlen(namespaceName)),
+        m_arena.storeString(resourcePath, std::strlen(resourcePath)),
+        destRect, sourceRect, scaleMode
+    );
     
     validateCommand(cmd);
     addCommand(cmd);
@@ -239,10 +662,7 @@ void RenderList::pushClipRect(const Rect& rect)
     YUCHEN_ASSERT(rect.isValid());
     m_clipStack.push_back(rect);
     
-    RenderCommand cmd;
-    cmd.type = RenderCommandType::PushClip;
-    cmd.rect = rect;
-    addCommand(cmd);
+    addCommand(RenderCommand::CreatePushClip(rect));
 }
 
 void RenderList::popClipRect()
@@ -250,9 +670,161 @@ void RenderList::popClipRect()
     YUCHEN_ASSERT(!m_clipStack.empty());
     m_clipStack.pop_back();
     
-    RenderCommand cmd;
-    cmd.type = RenderCommandType::PopClip;
-    addCommand(cmd);
+    addCommand(RenderCommand::CreatePopClip());
+}
+
+//==========================================================================================
+// Replay
+
+void RenderList::append(const RenderList& source, const Vec2& offset)
+{
+    YUCHEN_ASSERT_MSG(&source != this, "Cannot append a list to itself");
+    YUCHEN_ASSERT(offset.isValid());
+    YUCHEN_ASSERT(m_commands.size() + source.m_commands.size() <= Config::Rendering::MAX_COMMANDS_PER_LIST);
+    
+    const float dx = offset.x;
+    const float dy = offset.y;
+    
+    for (const RenderCommand& sourceCmd : source.m_commands)
+    {
+        RenderCommand cmd = sourceCmd;
+        
+        switch (cmd.type)
+        {
+            case RenderCommandType::Clear:
+                break;
+                
+            case RenderCommandType::FillRect:
+            case RenderCommandType::DrawRect:
+                cmd.rectangle.rect.x += dx;
+                cmd.rectangle.rect.y += dy;
+                break;
+                
+            case RenderCommandType::FillGradientRect:
+                cmd.gradient.rect.x += dx;
+                cmd.gradient.rect.y += dy;
+                cmd.gradient.stops = m_arena.storeGradientStops(cmd.gradient.stops, cmd.gradient.stopCount);
+                break;
+                
+            case RenderCommandType::DrawText:
+                cmd.text.position.x += dx;
+                cmd.text.position.y += dy;
+                cmd.text.utf8 = m_arena.storeString(cmd.text.utf8, cmd.text.length);
+                cmd.text.fontChain = m_arena.storeFontChain(*cmd.text.fontChain);
+                break;
+                
+            case RenderCommandType::DrawImage:
+                cmd.image.destRect.x += dx;
+                cmd.image.destRect.y += dy;
+                cmd.image.resourceNamespace = m_arena.storeString(
+                    cmd.image.resourceNamespace, std::strlen(cmd.image.resourceNamespace));
+                cmd.image.resourcePath = m_arena.storeString(
+                    cmd.image.resourcePath, std::strlen(cmd.image.resourcePath));
+                break;
+                
+            case RenderCommandType::DrawLine:
+                cmd.line.start.x += dx;
+                cmd.line.start.y += dy;
+                cmd.line.end.x += dx;
+                cmd.line.end.y += dy;
+                break;
+                
+            case RenderCommandType::FillTriangle:
+            case RenderCommandType::DrawTriangle:
+                cmd.triangle.p1.x += dx;
+                cmd.triangle.p1.y += dy;
+                cmd.triangle.p2.x += dx;
+                cmd.triangle.p2.y += dy;
+                cmd.triangle.p3.x += dx;
+                cmd.triangle.p3.y += dy;
+                break;
+                
+            case RenderCommandType::FillCircle:
+            case RenderCommandType::DrawCircle:
+                cmd.circle.center.x += dx;
+                cmd.circle.center.y += dy;
+                break;
+                
+            case RenderCommandType::PushClip:
+                cmd.clip.rect.x += dx;
+                cmd.clip.rect.y += dy;
+                m_clipStack.push_back(cmd.clip.rect);
+                break;
+                
+            case RenderCommandType::PopClip:
+                YUCHEN_ASSERT(!m_clipStack.empty());
+                m_clipStack.pop_back();
+                break;
+                
+            default:
+                YUCHEN_UNREACHABLE();
+        }
+        
+        m_commands.push_back(cmd);
+        m_fingerprint = mixCommand(m_fingerprint, cmd);
+    }
+}
+
+//==========================================================================================
+// Optimization
+
+size_t RenderList::coalesceFillRects(float pixelScale)
+{
+    YUCHEN_ASSERT(pixelScale > 0.0f);
+    
+    const size_t count = m_commands.size();
+    if (count < 2) return 0;
+    
+    ColumnRamp ramp;
+    size_t rampsCheckedUntil = 0;   // Columns of a run that did not fold are not refitted
+    size_t write = 0;
+    size_t read = 0;
+    
+    while (read < count)
+    {
+        if (read >= rampsCheckedUntil)
+        {
+            fitColumnRamp(m_commands.data() + read, count - read, pixelScale, ramp);
+            rampsCheckedUntil = read + std::max<size_t>(ramp.columnCount, 1);
+            
+            if (ramp.folded)
+            {
+                m_commands[write++] = RenderCommand::CreateFillGradientRect(
+                    ramp.bounds, m_arena.storeGradientStops(ramp.stops, ramp.stopCount),
+                    ramp.stopCount, ramp.direction, CornerRadius());
+                read += ramp.columnCount;
+                continue;
+            }
+        }
+        
+        const RenderCommand cmd = m_commands[read++];
+        if (write > 0 && tryMergeFill(m_commands[write - 1], cmd, pixelScale)) continue;
+        m_commands[write++] = cmd;
+    }
+    
+    const size_t removed = count - write;
+    m_commands.resize(write);
+    m_coalescedCommands += removed;
+    return removed;
+}
+
+//==========================================================================================
+// Culling
+
+void RenderList::setCullRect(const Rect& rect)
+{
+    YUCHEN_ASSERT(rect.isValid());
+    m_cullRect = rect;
+    m_hasCullRect = true;
+    
+    // What gets recorded depends on the cull rect, so it is part of the stream
+    m_fingerprint = mixRect(mixWord(m_fingerprint, 0x43554c4cu), rect);
+}
+
+void RenderList::clearCullRect()
+{
+    m_cullRect = Rect();
+    m_hasCullRect = false;
 }
 
 //==========================================================================================
@@ -262,6 +834,11 @@ void RenderList::reset()
 {
     m_commands.clear();
     m_clipStack.clear();
+    m_arena.reset();
+    clearCullRect();
+    m_culledCommands = 0;
+    m_fingerprint = FINGERPRINT_SEED;
+    m_coalescedCommands = 0;
 }
 
 bool RenderList::isEmpty() const
@@ -279,6 +856,11 @@ const std::vector<RenderCommand>& RenderList::getCommands() const
     return m_commands;
 }
 
+const RenderArena& RenderList::getArena() const
+{
+    return m_arena;
+}
+
 //==========================================================================================
 // Validation
 
@@ -290,66 +872,79 @@ bool RenderList::validate() const
     {
         switch (cmd.type) {
             case RenderCommandType::Clear:
-                YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
+                YUCHEN_ASSERT(Validation::ValidateColor(cmd.clear.color));
                 break;
                 
             case RenderCommandType::FillRect:
             case RenderCommandType::DrawRect:
-                YUCHEN_ASSERT(Validation::ValidateRect(cmd.rect));
-                YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
-                YUCHEN_ASSERT(Validation::ValidateCornerRadius(cmd.cornerRadius));
-                YUCHEN_ASSERT(Validation::ValidateBorderWidth(cmd.borderWidth, cmd.rect));
+                YUCHEN_ASSERT(Validation::ValidateRect(cmd.rectangle.rect));
+                YUCHEN_ASSERT(Validation::ValidateColor(cmd.rectangle.color));
+                YUCHEN_ASSERT(Validation::ValidateCornerRadius(cmd.rectangle.cornerRadius));
+                YUCHEN_ASSERT(Validation::ValidateBorderWidth(cmd.rectangle.borderWidth, cmd.rectangle.rect));
+                break;
+                
+            case RenderCommandType::FillGradientRect:
+                YUCHEN_ASSERT(Validation::ValidateRect(cmd.gradient.rect));
+                YUCHEN_ASSERT(Validation::ValidateCornerRadius(cmd.gradient.cornerRadius));
+                validateGradientStops(cmd.gradient.stops, cmd.gradient.stopCount);
                 break;
                 
             case RenderCommandType::DrawText:
-                YUCHEN_ASSERT(!cmd.text.empty());
-                YUCHEN_ASSERT(cmd.textPosition.isValid());
-                YUCHEN_ASSERT(cmd.fontSize > 0.0f);
-                YUCHEN_ASSERT(Validation::ValidateColor(cmd.textColor));
-                YUCHEN_ASSERT(cmd.fontFallbackChain.isValid());
-                YUCHEN_ASSERT(cmd.text.length() <= Config::Text::MAX_LENGTH);
+                YUCHEN_ASSERT(cmd.text.utf8 && cmd.text.length > 0);
+                YUCHEN_ASSERT(cmd.text.position.isValid());
+                YUCHEN_ASSERT(cmd.text.fontSize > 0.0f);
+                YUCHEN_ASSERT(Validation::ValidateColor(cmd.text.color));
+                YUCHEN_ASSERT(cmd.text.fontChain && cmd.text.fontChain->isValid());
+                YUCHEN_ASSERT(cmd.text.length <= Config::Text::MAX_LENGTH);
                 break;
                 
             case RenderCommandType::DrawImage:
-                YUCHEN_ASSERT(!cmd.text.empty());
-                YUCHEN_ASSERT(Validation::ValidateRect(cmd.rect));
+                YUCHEN_ASSERT(cmd.image.resourcePath && *cmd.image.resourcePath != '\0');
+                YUCHEN_ASSERT(Validation::ValidateRect(cmd.image.destRect));
                 // Validate source rect if specified (non-zero indicates sprite sheet region)
-                if (cmd.sourceRect.width > 0.0f || cmd.sourceRect.height > 0.0f) {
-                    YUCHEN_ASSERT(Validation::ValidateRect(cmd.sourceRect));
+                if (cmd.image.sourceRect.width > 0.0f || cmd.image.sourceRect.height > 0.0f) {
+                    YUCHEN_ASSERT(Validation::ValidateRect(cmd.image.sourceRect));
                 }
-                if (cmd.scaleMode == ScaleMode::NineSlice) {
-                    YUCHEN_ASSERT(cmd.nineSliceMargins.isValid());
+                if (cmd.image.scaleMode == ScaleMode::NineSlice) {
+                    YUCHEN_ASSERT(cmd.image.nineSliceMargins.isValid());
                 }
                 break;
                 
             case RenderCommandType::DrawLine:
-                YUCHEN_ASSERT(cmd.lineStart.isValid());
-                YUCHEN_ASSERT(cmd.lineEnd.isValid());
-                YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
-                YUCHEN_ASSERT(cmd.lineWidth > 0.0f);
+                YUCHEN_ASSERT(cmd.line.start.isValid());
+                YUCHEN_ASSERT(cmd.line.end.isValid());
+                YUCHEN_ASSERT(Validation::ValidateColor(cmd.line.color));
+                YUCHEN_ASSERT(cmd.line.width > 0.0f);
                 break;
                 
             case RenderCommandType::FillTriangle:
             case RenderCommandType::DrawTriangle:
-                YUCHEN_ASSERT(cmd.triangleP1.isValid());
-                YUCHEN_ASSERT(cmd.triangleP2.isValid());
-                YUCHEN_ASSERT(cmd.triangleP3.isValid());
-                YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
+                YUCHEN_ASSERT(cmd.triangle.p1.isValid());
+                YUCHEN_ASSERT(cmd.triangle.p2.isValid());
+                YUCHEN_ASSERT(cmd.triangle.p3.isValid());
+                YUCHEN_ASSERT(Validation::ValidateColor(cmd.triangle.color));
                 if (cmd.type == RenderCommandType::DrawTriangle) {
-                    YUCHEN_ASSERT(cmd.borderWidth > 0.0f);
+                    YUCHEN_ASSERT(cmd.triangle.borderWidth > 0.0f);
                 }
                 break;
                 
             case RenderCommandType::FillCircle:
             case RenderCommandType::DrawCircle:
-                YUCHEN_ASSERT(cmd.circleCenter.isValid());
-                YUCHEN_ASSERT(cmd.circleRadius > 0.0f);
-                YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
+                YUCHEN_ASSERT(cmd.circle.center.isValid());
+                YUCHEN_ASSERT(cmd.circle.radius > 0.0f);
+                YUCHEN_ASSERT(Validation::ValidateColor(cmd.circle.color));
                 if (cmd.type == RenderCommandType::DrawCircle) {
-                    YUCHEN_ASSERT(cmd.borderWidth > 0.0f);
+                    YUCHEN_ASSERT(cmd.circle.borderWidth > 0.0f);
                 }
                 break;
                 
+            case RenderCommandType::PushClip:
+                YUCHEN_ASSERT(Validation::ValidateRect(cmd.clip.rect));
+                break;
+                
+            case RenderCommandType::PopClip:
+                break;
+                
             default:
                 YUCHEN_UNREACHABLE();
         }
@@ -365,6 +960,7 @@ void RenderList::addCommand(const RenderCommand& cmd)
 {
     YUCHEN_ASSERT(m_commands.size() < Config::Rendering::MAX_COMMANDS_PER_LIST);
     m_commands.push_back(cmd);
+    m_fingerprint = mixCommand(m_fingerprint, cmd);
 }
 
 void RenderList::validateCommand(const RenderCommand& cmd) const
@@ -372,69 +968,98 @@ void RenderList::validateCommand(const RenderCommand& cmd) const
     switch (cmd.type)
     {
         case RenderCommandType::Clear:
-            Validation::AssertColor(cmd.color);
+            Validation::AssertColor(cmd.clear.color);
             break;
             
         case RenderCommandType::FillRect:
         case RenderCommandType::DrawRect:
-            Validation::AssertRect(cmd.rect);
-            Validation::AssertColor(cmd.color);
-            Validation::AssertCornerRadius(cmd.cornerRadius);
-            Validation::AssertBorderWidth(cmd.borderWidth, cmd.rect);
+            Validation::AssertRect(cmd.rectangle.rect);
+            Validation::AssertColor(cmd.rectangle.color);
+            Validation::AssertCornerRadius(cmd.rectangle.cornerRadius);
+            Validation::AssertBorderWidth(cmd.rectangle.borderWidth, cmd.rectangle.rect);
+            break;
+            
+        case RenderCommandType::FillGradientRect:
+            Validation::AssertRect(cmd.gradient.rect);
+            Validation::AssertCornerRadius(cmd.gradient.cornerRadius);
+            validateGradientStops(cmd.gradient.stops, cmd.gradient.stopCount);
             break;
             
         case RenderCommandType::DrawText:
-            YUCHEN_ASSERT(!cmd.text.empty());
-            YUCHEN_ASSERT(cmd.textPosition.isValid());
-            YUCHEN_ASSERT(cmd.fontSize > 0.0f);
-            YUCHEN_ASSERT(Validation::ValidateColor(cmd.textColor));
-            YUCHEN_ASSERT(cmd.fontFallbackChain.isValid());
-            YUCHEN_ASSERT(cmd.text.length() <= Config::Text::MAX_LENGTH);
+            YUCHEN_ASSERT(cmd.text.utf8 && cmd.text.length > 0);
+            YUCHEN_ASSERT(cmd.text.position.isValid());
+            YUCHEN_ASSERT(cmd.text.fontSize > 0.0f);
+            YUCHEN_ASSERT(Validation::ValidateColor(cmd.text.color));
+            YUCHEN_ASSERT(cmd.text.fontChain && cmd.text.fontChain->isValid());
+            YUCHEN_ASSERT(cmd.text.length <= Config::Text::MAX_LENGTH);
             break;
             
         case RenderCommandType::DrawImage:
-            YUCHEN_ASSERT(!cmd.text.empty());
-            YUCHEN_ASSERT(Validation::ValidateRect(cmd.rect));
+            YUCHEN_ASSERT(cmd.image.resourcePath && *cmd.image.resourcePath != '\0');
+            YUCHEN_ASSERT(Validation::ValidateRect(cmd.image.destRect));
             // Validate source rect if specified (non-zero indicates sprite sheet region)
-            if (cmd.sourceRect.width > 0.0f || cmd.sourceRect.height > 0.0f) {
-                YUCHEN_ASSERT(Validation::ValidateRect(cmd.sourceRect));
+            if (cmd.image.sourceRect.width > 0.0f || cmd.image.sourceRect.height > 0.0f) {
+                YUCHEN_ASSERT(Validation::ValidateRect(cmd.image.sourceRect));
             }
-            if (cmd.scaleMode == ScaleMode::NineSlice) {
-                YUCHEN_ASSERT(cmd.nineSliceMargins.isValid());
+            if (cmd.image.scaleMode == ScaleMode::NineSlice) {
+                YUCHEN_ASSERT(cmd.image.nineSliceMargins.isValid());
             }
             break;
             
         case RenderCommandType::DrawLine:
-            YUCHEN_ASSERT(cmd.lineStart.isValid());
-            YUCHEN_ASSERT(cmd.lineEnd.isValid());
-            YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
-            YUCHEN_ASSERT(cmd.lineWidth > 0.0f);
+            YUCHEN_ASSERT(cmd.line.start.isValid());
+            YUCHEN_ASSERT(cmd.line.end.isValid());
+            YUCHEN_ASSERT(Validation::ValidateColor(cmd.line.color));
+            YUCHEN_ASSERT(cmd.line.width > 0.0f);
             break;
             
         case RenderCommandType::FillTriangle:
         case RenderCommandType::DrawTriangle:
-            YUCHEN_ASSERT(cmd.triangleP1.isValid());
-            YUCHEN_ASSERT(cmd.triangleP2.isValid());
-            YUCHEN_ASSERT(cmd.triangleP3.isValid());
-            YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
+            YUCHEN_ASSERT(cmd.triangle.p1.isValid());
+            YUCHEN_ASSERT(cmd.triangle.p2.isValid());
+            YUCHEN_ASSERT(cmd.triangle.p3.isValid());
+            YUCHEN_ASSERT(Validation::ValidateColor(cmd.triangle.color));
             if (cmd.type == RenderCommandType::DrawTriangle) {
-                YUCHEN_ASSERT(cmd.borderWidth > 0.0f);
+                YUCHEN_ASSERT(cmd.triangle.borderWidth > 0.0f);
             }
             break;
             
         case RenderCommandType::FillCircle:
         case RenderCommandType::DrawCircle:
-            YUCHEN_ASSERT(cmd.circleCenter.isValid());
-            YUCHEN_ASSERT(cmd.circleRadius > 0.0f);
-            YUCHEN_ASSERT(Validation::ValidateColor(cmd.color));
+            YUCHEN_ASSERT(cmd.circle.center.isValid());
+            YUCHEN_ASSERT(cmd.circle.radius > 0.0f);
+            YUCHEN_ASSERT(Validation::ValidateColor(cmd.circle.color));
             if (cmd.type == RenderCommandType::DrawCircle) {
-                YUCHEN_ASSERT(cmd.borderWidth > 0.0f);
+                YUCHEN_ASSERT(cmd.circle.borderWidth > 0.0f);
             }
             break;
             
+        case RenderCommandType::PushClip:
+            YUCHEN_ASSERT(Validation::ValidateRect(cmd.clip.rect));
+            break;
+            
+        case RenderCommandType::PopClip:
+            break;
+            
         default:
             YUCHEN_UNREACHABLE();
     }
 }
 
+void RenderList::validateGradientStops(const GradientStop* stops, size_t stopCount)
+{
+    YUCHEN_ASSERT_MSG(stops != nullptr, "Gradient stops cannot be null");
+    YUCHEN_ASSERT_MSG(stopCount >= 2 && stopCount <= Config::Rendering::MAX_GRADIENT_STOPS,
+                      "Gradient stop count out of range");
+    
+    for (size_t i = 0; i < stopCount; ++i)
+    {
+        YUCHEN_ASSERT_MSG(stops[i].position >= 0.0f && stops[i].position <= 1.0f,
+                          "Gradient stop position out of range");
+        YUCHEN_ASSERT_MSG(i == 0 || stops[i].position >= stops[i - 1].position,
+                          "Gradient stops must be sorted by position");
+        Validation::AssertColor(stops[i].color);
+    }
+}
+
 } // namespace YuchenUI
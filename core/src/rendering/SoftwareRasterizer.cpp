@@ -0,0 +1,844 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file SoftwareRasterizer.cpp
+
+    Implementation notes:
+    - Blending is source-over on straight alpha, matching the GPU pipelines:
+      rgb = src * a + dst * (1 - a), alpha = a + dst * (1 - a). Treating the source
+      alpha channel as 255 lets all four channels share one formula
+    - Division by 255 uses the exact rounding form (x + 128 + ((x + 128) >> 8)) >> 8,
+      which keeps every intermediate inside 16 bits
+    - Span kernels are selected at compile time: AVX2 (8 px), SSE2 (4 px), scalar tail
+    - Rounded rect rows are split into edge zones (evaluated per pixel) and a middle run
+      whose coverage depends only on y, so large fills cost one SDF per row
+    - Gradient rects share the rounded rect coverage; horizontal ramps precompute one
+      row of colors and blend it as RGBA, vertical ramps have one color per row
+    - Corner radii follow the RenderList convention (topLeft is the top-left corner in
+      window coordinates)
+    - Distance field glyphs map the sampled distance through a 256-entry coverage table
+      built per quad, since the distance-to-pixel scale depends on the quad's size
+*/
+
+#include "SoftwareRasterizer.h"
+#include "YuchenUI/core/Config.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define YUCHEN_RASTER_AVX2 1
+    #define YUCHEN_RASTER_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define YUCHEN_RASTER_SSE2 1
+#endif
+
+namespace YuchenUI {
+
+namespace {
+
+//==========================================================================================
+// Scalar helpers
+
+inline uint32_t div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+inline uint8_t toByte(float v)
+{
+    v = v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v);
+    return static_cast<uint8_t>(v * 255.0f + 0.5f);
+}
+
+inline void toRGBA8(const Vec4& color, uint8_t out[4])
+{
+    out[0] = toByte(color.x);
+    out[1] = toByte(color.y);
+    out[2] = toByte(color.z);
+    out[3] = toByte(color.w);
+}
+
+inline float smoothstep(float edge0, float edge1, float x)
+{
+    float t = (x - edge0) / (edge1 - edge0);
+    t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+    return t * t * (3.0f - 2.0f * t);
+}
+
+inline void blendPixel(uint8_t* dst, const uint8_t src[4], uint32_t a)
+{
+    uint32_t ia = 255 - a;
+    dst[0] = static_cast<uint8_t>(div255(src[0] * a + dst[0] * ia));
+    dst[1] = static_cast<uint8_t>(div255(src[1] * a + dst[1] * ia));
+    dst[2] = static_cast<uint8_t>(div255(src[2] * a + dst[2] * ia));
+    dst[3] = static_cast<uint8_t>(div255(255 * a + dst[3] * ia));
+}
+
+/** pow(x, 0.8) on 8-bit coverage, the gamma tweak applied by the text shader. */
+struct TextGammaTable {
+    uint8_t values[256];
+
+    TextGammaTable()
+    {
+        for (int i = 0; i < 256; ++i)
+            values[i] = static_cast<uint8_t>(std::pow(i / 255.0f, 0.8f) * 255.0f + 0.5f);
+    }
+};
+
+const TextGammaTable& textGamma()
+{
+    static const TextGammaTable table;
+    return table;
+}
+
+/** Signed distance to a rounded box; r = (tl, tr, bl, br) in window (y-down) space. */
+inline float sdRoundedBox(float px, float py, float cx, float cy, float hw, float hh, const float r[4])
+{
+    float qx = px - cx;
+    float qy = py - cy;
+    float radius = qy < 0.0f ? (qx < 0.0f ? r[0] : r[1]) : (qx < 0.0f ? r[2] : r[3]);
+    float dx = std::fabs(qx) - hw + radius;
+    float dy = std::fabs(qy) - hh + radius;
+    float outside = std::sqrt(std::max(dx, 0.0f) * std::max(dx, 0.0f) + std::max(dy, 0.0f) * std::max(dy, 0.0f));
+    return std::min(std::max(dx, dy), 0.0f) + outside - radius;
+}
+
+//==========================================================================================
+// SIMD helpers
+
+#if YUCHEN_RASTER_SSE2
+inline __m128i div255x8(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+/** Blends two pixels held as 16-bit lanes: out = div255(src * a + dst * (255 - a)). */
+inline __m128i blend2(__m128i src16, __m128i dst16, __m128i a16)
+{
+    __m128i ia16 = _mm_sub_epi16(_mm_set1_epi16(255), a16);
+    return div255x8(_mm_add_epi16(_mm_mullo_epi16(src16, a16), _mm_mullo_epi16(dst16, ia16)));
+}
+#endif
+
+#if YUCHEN_RASTER_AVX2
+inline __m256i div255x16(__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+inline __m256i blend4(__m256i src16, __m256i dst16, __m256i a16)
+{
+    __m256i ia16 = _mm256_sub_epi16(_mm256_set1_epi16(255), a16);
+    return div255x16(_mm256_add_epi16(_mm256_mullo_epi16(src16, a16), _mm256_mullo_epi16(dst16, ia16)));
+}
+#endif
+
+//==========================================================================================
+// Span kernels
+
+/** Overwrites a run with one color. */
+void fillSpan(uint8_t* dst, int count, const uint8_t color[4])
+{
+    uint32_t packed;
+    std::memcpy(&packed, color, 4);
+    int i = 0;
+
+#if YUCHEN_RASTER_AVX2
+    __m256i c8 = _mm256_set1_epi32(static_cast<int>(packed));
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), c8);
+#endif
+#if YUCHEN_RASTER_SSE2
+    __m128i c4 = _mm_set1_epi32(static_cast<int>(packed));
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), c4);
+#endif
+
+    for (; i < count; ++i) std::memcpy(dst + i * 4, &packed, 4);
+}
+
+/** Blends a run with one color at constant alpha. */
+void blendSpanSolid(uint8_t* dst, int count, const uint8_t color[4], uint32_t alpha)
+{
+    if (alpha == 0) return;
+
+    uint8_t opaque[4] = { color[0], color[1], color[2], 255 };
+    if (alpha >= 255)
+    {
+        fillSpan(dst, count, opaque);
+        return;
+    }
+
+    int i = 0;
+
+#if YUCHEN_RASTER_AVX2
+    {
+        __m256i src16 = _mm256_setr_epi16(color[0], color[1], color[2], 255, color[0], color[1], color[2], 255,
+                                          color[0], color[1], color[2], 255, color[0], color[1], color[2], 255);
+        __m256i a16 = _mm256_set1_epi16(static_cast<short>(alpha));
+        __m256i zero = _mm256_setzero_si256();
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i * 4));
+            __m256i lo = blend4(src16, _mm256_unpacklo_epi8(d, zero), a16);
+            __m256i hi = blend4(src16, _mm256_unpackhi_epi8(d, zero), a16);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+        }
+    }
+#endif
+#if YUCHEN_RASTER_SSE2
+    {
+        __m128i src16 = _mm_setr_epi16(color[0], color[1], color[2], 255, color[0], color[1], color[2], 255);
+        __m128i a16 = _mm_set1_epi16(static_cast<short>(alpha));
+        __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+            __m128i lo = blend2(src16, _mm_unpacklo_epi8(d, zero), a16);
+            __m128i hi = blend2(src16, _mm_unpackhi_epi8(d, zero), a16);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+        }
+    }
+#endif
+
+    for (; i < count; ++i) blendPixel(dst + i * 4, color, alpha);
+}
+
+/** Blends a run with one color, alpha = coverage[i] * color alpha. */
+void blendSpanCoverage(uint8_t* dst, const uint8_t* coverage, int count, const uint8_t color[4])
+{
+    uint32_t colorAlpha = color[3];
+    int i = 0;
+
+#if YUCHEN_RASTER_AVX2
+    {
+        __m256i src16 = _mm256_setr_epi16(color[0], color[1], color[2], 255, color[0], color[1], color[2], 255,
+                                          color[0], color[1], color[2], 255, color[0], color[1], color[2], 255);
+        __m128i ca = _mm_set1_epi16(static_cast<short>(colorAlpha));
+        __m256i zero = _mm256_setzero_si256();
+        for (; i + 8 <= count; i += 8)
+        {
+            __m128i cov = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(coverage + i)),
+                                            _mm_setzero_si128());
+            __m128i a = div255x8(_mm_mullo_epi16(cov, ca));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(a, _mm_setzero_si128())) == 0xFFFF) continue;
+
+            __m128i a0123 = _mm_unpacklo_epi16(a, a);
+            __m128i a4567 = _mm_unpackhi_epi16(a, a);
+            __m256i aLo = _mm256_set_m128i(_mm_unpacklo_epi32(a4567, a4567), _mm_unpacklo_epi32(a0123, a0123));
+            __m256i aHi = _mm256_set_m128i(_mm_unpackhi_epi32(a4567, a4567), _mm_unpackhi_epi32(a0123, a0123));
+
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i * 4));
+            __m256i lo = blend4(src16, _mm256_unpacklo_epi8(d, zero), aLo);
+            __m256i hi = blend4(src16, _mm256_unpackhi_epi8(d, zero), aHi);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+        }
+    }
+#endif
+#if YUCHEN_RASTER_SSE2
+    {
+        __m128i src16 = _mm_setr_epi16(color[0], color[1], color[2], 255, color[0], color[1], color[2], 255);
+        __m128i ca = _mm_set1_epi16(static_cast<short>(colorAlpha));
+        __m128i zero = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            int32_t packedCoverage;
+            std::memcpy(&packedCoverage, coverage + i, 4);
+            if (packedCoverage == 0) continue;
+
+            __m128i cov = _mm_unpacklo_epi8(_mm_cvtsi32_si128(packedCoverage), zero);
+            __m128i a = div255x8(_mm_mullo_epi16(cov, ca));
+            __m128i a0123 = _mm_unpacklo_epi16(a, a);
+            __m128i aLo = _mm_unpacklo_epi32(a0123, a0123);
+            __m128i aHi = _mm_unpackhi_epi32(a0123, a0123);
+
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+            __m128i lo = blend2(src16, _mm_unpacklo_epi8(d, zero), aLo);
+            __m128i hi = blend2(src16, _mm_unpackhi_epi8(d, zero), aHi);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        uint32_t a = div255(coverage[i] * colorAlpha);
+        if (a) blendPixel(dst + i * 4, color, a);
+    }
+}
+
+/** Blends a run of straight-alpha RGBA source pixels. */
+void blendSpanRGBA(uint8_t* dst, const uint8_t* src, int count)
+{
+    int i = 0;
+
+#if YUCHEN_RASTER_AVX2
+    {
+        __m256i zero = _mm256_setzero_si256();
+        __m256i alphaLane = _mm256_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255, 0, 0, 0, 255);
+        __m256i rgbMask = _mm256_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0, -1, -1, -1, 0);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4));
+            __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i * 4));
+
+            __m256i sLo = _mm256_unpacklo_epi8(s, zero);
+            __m256i sHi = _mm256_unpackhi_epi8(s, zero);
+            __m256i aLo = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sLo, 0xFF), 0xFF);
+            __m256i aHi = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(sHi, 0xFF), 0xFF);
+            sLo = _mm256_or_si256(_mm256_and_si256(sLo, rgbMask), alphaLane);
+            sHi = _mm256_or_si256(_mm256_and_si256(sHi, rgbMask), alphaLane);
+
+            __m256i lo = blend4(sLo, _mm256_unpacklo_epi8(d, zero), aLo);
+            __m256i hi = blend4(sHi, _mm256_unpackhi_epi8(d, zero), aHi);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i * 4), _mm256_packus_epi16(lo, hi));
+        }
+    }
+#endif
+#if YUCHEN_RASTER_SSE2
+    {
+        __m128i zero = _mm_setzero_si128();
+        __m128i alphaLane = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+        __m128i rgbMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4));
+
+            __m128i sLo = _mm_unpacklo_epi8(s, zero);
+            __m128i sHi = _mm_unpackhi_epi8(s, zero);
+            __m128i aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, 0xFF), 0xFF);
+            __m128i aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, 0xFF), 0xFF);
+            sLo = _mm_or_si128(_mm_and_si128(sLo, rgbMask), alphaLane);
+            sHi = _mm_or_si128(_mm_and_si128(sHi, rgbMask), alphaLane);
+
+            __m128i lo = blend2(sLo, _mm_unpacklo_epi8(d, zero), aLo);
+            __m128i hi = blend2(sHi, _mm_unpackhi_epi8(d, zero), aHi);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_packus_epi16(lo, hi));
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        uint32_t a = src[i * 4 + 3];
+        if (a) blendPixel(dst + i * 4, src + i * 4, a);
+    }
+}
+
+//==========================================================================================
+// Texture sampling
+
+/** Maps a texel coordinate onto [0, size) with clamp or repeat addressing. */
+inline int wrapTexel(int t, int size, bool repeat)
+{
+    if (repeat)
+    {
+        t %= size;
+        return t < 0 ? t + size : t;
+    }
+    return t < 0 ? 0 : (t >= size ? size - 1 : t);
+}
+
+/** Bilinear filter of 4 texel values with 8-bit fractional weights. */
+inline uint32_t bilerp(uint32_t a, uint32_t b, uint32_t c, uint32_t d, uint32_t fx, uint32_t fy)
+{
+    uint32_t top = a * (256 - fx) + b * fx;
+    uint32_t bottom = c * (256 - fx) + d * fx;
+    return (top * (256 - fy) + bottom * fy + 32768) >> 16;
+}
+
+/** Precomputed horizontal sample positions for one row of a quad. */
+struct AxisSample {
+    int t0, t1;
+    uint32_t frac;
+};
+
+void computeAxisSamples(std::vector<AxisSample>& out, int first, int count, float destOrigin, float destSize,
+                        float uvMin, float uvMax, uint32_t texSize, bool repeat)
+{
+    out.resize(static_cast<size_t>(count));
+    float scale = (uvMax - uvMin) * texSize / destSize;
+    float base = uvMin * texSize;
+
+    for (int i = 0; i < count; ++i)
+    {
+        float t = base + (first + i + 0.5f - destOrigin) * scale - 0.5f;
+        float ft = std::floor(t);
+        int ti = static_cast<int>(ft);
+        out[i].t0 = wrapTexel(ti, static_cast<int>(texSize), repeat);
+        out[i].t1 = wrapTexel(ti + 1, static_cast<int>(texSize), repeat);
+        out[i].frac = static_cast<uint32_t>((t - ft) * 256.0f);
+    }
+}
+
+thread_local std::vector<AxisSample> t_columnSamples;
+
+} // namespace
+
+//==========================================================================================
+// PixelBounds
+
+PixelBounds PixelBounds::intersect(const PixelBounds& other) const
+{
+    return PixelBounds(std::max(x0, other.x0), std::max(y0, other.y0),
+                       std::min(x1, other.x1), std::min(y1, other.y1));
+}
+
+PixelBounds PixelBounds::fromRect(float x, float y, float width, float height)
+{
+    return PixelBounds(static_cast<int>(std::floor(x)), static_cast<int>(std::floor(y)),
+                       static_cast<int>(std::ceil(x + width)), static_cast<int>(std::ceil(y + height)));
+}
+
+//==========================================================================================
+// Lifecycle
+
+SoftwareRasterizer::SoftwareRasterizer()
+    : m_pixels(nullptr)
+    , m_width(0)
+    , m_height(0)
+    , m_bytesPerRow(0)
+    , m_clip()
+    , m_distanceCoverage()
+{
+}
+
+void SoftwareRasterizer::setTarget(uint8_t* pixels, int width, int height, size_t bytesPerRow)
+{
+    m_pixels = pixels;
+    m_width = width;
+    m_height = height;
+    m_bytesPerRow = bytesPerRow;
+    m_coverage.resize(static_cast<size_t>(std::max(width, 0)));
+    m_rowPixels.resize(static_cast<size_t>(std::max(width, 0)) * 4);
+    m_rampColors.resize(static_cast<size_t>(std::max(width, 0)) * 4);
+    resetClip();
+}
+
+void SoftwareRasterizer::setClip(const PixelBounds& clip)
+{
+    m_clip = clip.intersect(PixelBounds(0, 0, m_width, m_height));
+}
+
+void SoftwareRasterizer::resetClip()
+{
+    m_clip = PixelBounds(0, 0, m_width, m_height);
+}
+
+const char* SoftwareRasterizer::getKernelName()
+{
+#if YUCHEN_RASTER_AVX2
+    return "AVX2";
+#elif YUCHEN_RASTER_SSE2
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+
+void SoftwareRasterizer::flushCoverage(int x, int y, int count, const uint8_t color[4])
+{
+    if (count > 0) blendSpanCoverage(row(y) + x * 4, m_coverage.data(), count, color);
+}
+
+//==========================================================================================
+// Primitives
+
+void SoftwareRasterizer::clear(const Vec4& color)
+{
+    if (m_clip.isEmpty()) return;
+
+    uint8_t rgba[4];
+    toRGBA8(color, rgba);
+
+    for (int y = m_clip.y0; y < m_clip.y1; ++y)
+        fillSpan(row(y) + m_clip.x0 * 4, m_clip.x1 - m_clip.x0, rgba);
+}
+
+void SoftwareRasterizer::drawRoundedRect(const Rect& rect, const Vec4& radii, float borderWidth, const Vec4& color)
+{
+    PixelBounds area = PixelBounds::fromRect(rect.x - 1.0f, rect.y - 1.0f, rect.width + 2.0f, rect.height + 2.0f)
+                           .intersect(m_clip);
+    if (area.isEmpty() || rect.width <= 0.0f || rect.height <= 0.0f) return;
+
+    uint8_t rgba[4];
+    toRGBA8(color, rgba);
+    if (rgba[3] == 0) return;
+
+    // Same adjustments as fragment_rect: radii grow by half a pixel, edge is +/- 0.5 px
+    const float edge = 0.5f;
+    float outer[4] = { std::max(radii.x + 0.5f, 0.0f), std::max(radii.y + 0.5f, 0.0f),
+                       std::max(radii.z + 0.5f, 0.0f), std::max(radii.w + 0.5f, 0.0f) };
+    float hw = rect.width * 0.5f;
+    float hh = rect.height * 0.5f;
+    float cx = rect.x + hw;
+    float cy = rect.y + hh;
+
+    bool hasBorder = borderWidth > 0.0f;
+    float inner[4] = {};
+    float ihw = 0.0f, ihh = 0.0f;
+    if (hasBorder)
+    {
+        for (int i = 0; i < 4; ++i) inner[i] = std::max(outer[i] - borderWidth, 0.0f);
+        ihw = std::max(hw - borderWidth, 0.0f);
+        ihh = std::max(hh - borderWidth, 0.0f);
+    }
+
+    auto coverageAt = [&](float px, float py) -> float {
+        float d = sdRoundedBox(px, py, cx, cy, hw, hh, outer);
+        float alpha = smoothstep(edge, -edge, d);
+        if (hasBorder && alpha > 0.0f)
+        {
+            float di = sdRoundedBox(px, py, cx, cy, ihw, ihh, inner);
+            alpha *= smoothstep(-edge, edge, di);
+        }
+        return alpha < 0.01f ? 0.0f : alpha;
+    };
+
+    // Outside this zone from either side, coverage no longer depends on x
+    float maxRadius = std::max(std::max(outer[0], outer[1]), std::max(outer[2], outer[3]));
+    float zone = std::max(maxRadius, hasBorder ? borderWidth : 0.0f) + 1.0f;
+    int midStart = std::max(area.x0, static_cast<int>(std::ceil(rect.x + zone)));
+    int midEnd = std::min(area.x1, static_cast<int>(std::floor(rect.x + rect.width - zone)));
+    if (midEnd < midStart) midStart = midEnd = area.x1;
+
+    for (int y = area.y0; y < area.y1; ++y)
+    {
+        float py = y + 0.5f;
+
+        // Left edge zone
+        int count = 0;
+        for (int x = area.x0; x < midStart; ++x)
+            m_coverage[count++] = toByte(coverageAt(x + 0.5f, py));
+        flushCoverage(area.x0, y, count, rgba);
+
+        // Middle run
+        if (midEnd > midStart)
+        {
+            uint32_t coverage = toByte(coverageAt(cx, py));
+            if (coverage)
+                blendSpanSolid(row(y) + midStart * 4, midEnd - midStart, rgba, div255(coverage * rgba[3]));
+        }
+
+        // Right edge zone
+        count = 0;
+        for (int x = midEnd; x < area.x1; ++x)
+            m_coverage[count++] = toByte(coverageAt(x + 0.5f, py));
+        flushCoverage(midEnd, y, count, rgba);
+    }
+}
+
+void SoftwareRasterizer::drawGradientRect(const Rect& rect, const Vec4& radii, const GradientSpan& span)
+{
+    PixelBounds area = PixelBounds::fromRect(rect.x - 1.0f, rect.y - 1.0f, rect.width + 2.0f, rect.height + 2.0f)
+                           .intersect(m_clip);
+    if (area.isEmpty() || rect.width <= 0.0f || rect.height <= 0.0f) return;
+
+    // Pixel i is drawn when its center i + 0.5 lies in [drawStart, drawEnd)
+    int& axis0 = span.vertical ? area.y0 : area.x0;
+    int& axis1 = span.vertical ? area.y1 : area.x1;
+    float drawStart = std::max(span.drawStart, static_cast<float>(axis0));
+    float drawEnd = std::min(span.drawEnd, static_cast<float>(axis1));
+    axis0 = static_cast<int>(std::ceil(drawStart - 0.5f));
+    axis1 = static_cast<int>(std::ceil(drawEnd - 0.5f));
+    if (area.isEmpty()) return;
+
+    const float length = span.end - span.start;
+    auto rampColor = [&](int pixel, uint8_t out[4]) {
+        float t = length > 0.0f ? (pixel + 0.5f - span.start) / length : 0.0f;
+        t = t < 0.0f ? 0.0f : (t > 1.0f ? 1.0f : t);
+        const Vec4& a = span.startColor;
+        const Vec4& b = span.endColor;
+        toRGBA8(Vec4(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                     a.z + (b.z - a.z) * t, a.w + (b.w - a.w) * t), out);
+    };
+
+    // Same SDF and edge as drawRoundedRect() without a border
+    const float edge = 0.5f;
+    float outer[4] = { std::max(radii.x + 0.5f, 0.0f), std::max(radii.y + 0.5f, 0.0f),
+                       std::max(radii.z + 0.5f, 0.0f), std::max(radii.w + 0.5f, 0.0f) };
+    float hw = rect.width * 0.5f;
+    float hh = rect.height * 0.5f;
+    float cx = rect.x + hw;
+    float cy = rect.y + hh;
+
+    auto coverageAt = [&](float px, float py) -> uint8_t {
+        float alpha = smoothstep(edge, -edge, sdRoundedBox(px, py, cx, cy, hw, hh, outer));
+        return toByte(alpha < 0.01f ? 0.0f : alpha);
+    };
+
+    float maxRadius = std::max(std::max(outer[0], outer[1]), std::max(outer[2], outer[3]));
+    float zone = maxRadius + 1.0f;
+    int midStart = std::max(area.x0, static_cast<int>(std::ceil(rect.x + zone)));
+    int midEnd = std::min(area.x1, static_cast<int>(std::floor(rect.x + rect.width - zone)));
+    if (midEnd < midStart) midStart = midEnd = area.x1;
+
+    const int count = area.x1 - area.x0;
+    if (!span.vertical)
+    {
+        for (int i = 0; i < count; ++i) rampColor(area.x0 + i, &m_rampColors[i * 4]);
+    }
+
+    for (int y = area.y0; y < area.y1; ++y)
+    {
+        float py = y + 0.5f;
+
+        for (int x = area.x0; x < midStart; ++x) m_coverage[x - area.x0] = coverageAt(x + 0.5f, py);
+        if (midEnd > midStart)
+            std::memset(&m_coverage[midStart - area.x0], coverageAt(cx, py), midEnd - midStart);
+        for (int x = midEnd; x < area.x1; ++x) m_coverage[x - area.x0] = coverageAt(x + 0.5f, py);
+
+        if (span.vertical)
+        {
+            // One color per row
+            uint8_t rgba[4];
+            rampColor(y, rgba);
+            flushCoverage(area.x0, y, count, rgba);
+            continue;
+        }
+
+        uint8_t* out = m_rowPixels.data();
+        for (int i = 0; i < count; ++i)
+        {
+            std::memcpy(out + i * 4, &m_rampColors[i * 4], 3);
+            out[i * 4 + 3] = static_cast<uint8_t>(div255(m_coverage[i] * m_rampColors[i * 4 + 3]));
+        }
+        blendSpanRGBA(row(y) + area.x0 * 4, out, count);
+    }
+}
+
+void SoftwareRasterizer::fillTriangle(const Vec2& p0, const Vec2& p1, const Vec2& p2, const Vec4& color)
+{
+    float minY = std::min(p0.y, std::min(p1.y, p2.y));
+    float maxY = std::max(p0.y, std::max(p1.y, p2.y));
+    int y0 = std::max(m_clip.y0, static_cast<int>(std::ceil(minY - 0.5f)));
+    int y1 = std::min(m_clip.y1, static_cast<int>(std::ceil(maxY - 0.5f)));
+    if (y1 <= y0) return;
+
+    uint8_t rgba[4];
+    toRGBA8(color, rgba);
+    if (rgba[3] == 0) return;
+
+    const Vec2* edges[3][2] = { { &p0, &p1 }, { &p1, &p2 }, { &p2, &p0 } };
+
+    for (int y = y0; y < y1; ++y)
+    {
+        float py = y + 0.5f;
+        float left = 0.0f, right = 0.0f;
+        int hits = 0;
+
+        // Half-open in y so shared edges are not drawn twice
+        for (const auto& edge : edges)
+        {
+            const Vec2& a = *edge[0];
+            const Vec2& b = *edge[1];
+            if (a.y == b.y) continue;
+            float top = std::min(a.y, b.y);
+            float bottom = std::max(a.y, b.y);
+            if (py < top || py >= bottom) continue;
+
+            float x = a.x + (py - a.y) * (b.x - a.x) / (b.y - a.y);
+            if (hits == 0) { left = right = x; }
+            else { left = std::min(left, x); right = std::max(right, x); }
+            ++hits;
+        }
+
+        if (hits < 2) continue;
+
+        int x0 = std::max(m_clip.x0, static_cast<int>(std::ceil(left - 0.5f)));
+        int x1 = std::min(m_clip.x1, static_cast<int>(std::ceil(right - 0.5f)));
+        if (x1 > x0) blendSpanSolid(row(y) + x0 * 4, x1 - x0, rgba, rgba[3]);
+    }
+}
+
+void SoftwareRasterizer::drawCircle(const Vec2& center, float radius, float borderWidth, float edgeWidth,
+                                    const Vec4& color)
+{
+    if (radius <= 0.0f) return;
+
+    PixelBounds area = PixelBounds::fromRect(center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f)
+                           .intersect(m_clip);
+    if (area.isEmpty()) return;
+
+    uint8_t rgba[4];
+    toRGBA8(color, rgba);
+    if (rgba[3] == 0) return;
+
+    bool hasBorder = borderWidth > 0.0f;
+    float innerRadius = radius - borderWidth;
+    float solidRadius = radius - edgeWidth;
+
+    for (int y = area.y0; y < area.y1; ++y)
+    {
+        float dy = y + 0.5f - center.y;
+        float dy2 = dy * dy;
+        if (dy2 > radius * radius) continue;
+
+        // Fully covered run of a filled circle
+        int solidStart = area.x1, solidEnd = area.x1;
+        if (!hasBorder && solidRadius > 0.0f && dy2 < solidRadius * solidRadius)
+        {
+            float half = std::sqrt(solidRadius * solidRadius - dy2);
+            solidStart = std::max(area.x0, static_cast<int>(std::ceil(center.x - half - 0.5f)));
+            solidEnd = std::min(area.x1, static_cast<int>(std::floor(center.x + half - 0.5f)) + 1);
+            if (solidEnd < solidStart) solidStart = solidEnd = area.x1;
+        }
+
+        auto coverageAt = [&](int x) -> uint8_t {
+            float dx = x + 0.5f - center.x;
+            float dist = std::sqrt(dx * dx + dy2);
+            if (dist > radius) return 0;
+            if (!hasBorder) return toByte(1.0f - smoothstep(radius - edgeWidth, radius, dist));
+            if (dist < innerRadius) return 0;
+            float outerEdge = smoothstep(radius - edgeWidth, radius, dist);
+            float innerEdge = smoothstep(innerRadius, innerRadius + edgeWidth, dist);
+            return toByte((1.0f - outerEdge) * innerEdge);
+        };
+
+        int count = 0;
+        for (int x = area.x0; x < solidStart; ++x) m_coverage[count++] = coverageAt(x);
+        flushCoverage(area.x0, y, count, rgba);
+
+        if (solidEnd > solidStart) blendSpanSolid(row(y) + solidStart * 4, solidEnd - solidStart, rgba, rgba[3]);
+
+        count = 0;
+        for (int x = solidEnd; x < area.x1; ++x) m_coverage[count++] = coverageAt(x);
+        flushCoverage(solidEnd, y, count, rgba);
+    }
+}
+
+void SoftwareRasterizer::drawGlyph(const Rect& dest, const Vec2& uvMin, const Vec2& uvMax,
+                                   const TextureView& atlas, const Vec4& color)
+{
+    if (!atlas.pixels) return;
+    if (atlas.format != TextureFormat::R8_Unorm && atlas.format != TextureFormat::R8_DistanceField) return;
+
+    PixelBounds area = PixelBounds::fromRect(dest.x, dest.y, dest.width, dest.height).intersect(m_clip);
+    if (area.isEmpty() || dest.width <= 0.0f || dest.height <= 0.0f) return;
+
+    uint8_t rgba[4];
+    toRGBA8(color, rgba);
+    if (rgba[3] == 0) return;
+
+    // Only pixels whose centers fall inside the quad are shaded
+    area.x0 = std::max(area.x0, static_cast<int>(std::ceil(dest.x - 0.5f)));
+    area.y0 = std::max(area.y0, static_cast<int>(std::ceil(dest.y - 0.5f)));
+    area.x1 = std::min(area.x1, static_cast<int>(std::ceil(dest.x + dest.width - 0.5f)));
+    area.y1 = std::min(area.y1, static_cast<int>(std::ceil(dest.y + dest.height - 0.5f)));
+    if (area.isEmpty()) return;
+
+    int count = area.x1 - area.x0;
+    std::vector<AxisSample>& columns = t_columnSamples;
+    computeAxisSamples(columns, area.x0, count, dest.x, dest.width, uvMin.x, uvMax.x, atlas.width, false);
+
+    const uint8_t* gamma = textGamma().values;
+    float vScale = (uvMax.y - uvMin.y) * atlas.height / dest.height;
+
+    if (atlas.format == TextureFormat::R8_DistanceField)
+    {
+        // Texels hold 0.5 - distance / (2 * spread); turn that into coverage of a pixel,
+        // widened by the embolden strength coverage glyphs get from FreeType
+        float pixelsPerTexel = dest.width / ((uvMax.x - uvMin.x) * atlas.width);
+        float distanceScale = 2.0f * Config::GlyphCache::SDF_SPREAD * pixelsPerTexel;
+        float embolden = Config::Font::EMBOLDEN_STRENGTH / 128.0f;
+
+        for (int v = 0; v < 256; ++v)
+        {
+            float coverage = 0.5f + (v / 255.0f - 0.5f) * distanceScale + embolden;
+            coverage = std::min(std::max(coverage, 0.0f), 1.0f);
+            m_distanceCoverage[v] = gamma[static_cast<int>(coverage * 255.0f + 0.5f)];
+        }
+        gamma = m_distanceCoverage;
+    }
+
+    for (int y = area.y0; y < area.y1; ++y)
+    {
+        float t = uvMin.y * atlas.height + (y + 0.5f - dest.y) * vScale - 0.5f;
+        float ft = std::floor(t);
+        int row0 = wrapTexel(static_cast<int>(ft), static_cast<int>(atlas.height), false);
+        int row1 = wrapTexel(static_cast<int>(ft) + 1, static_cast<int>(atlas.height), false);
+        uint32_t fy = static_cast<uint32_t>((t - ft) * 256.0f);
+
+        const uint8_t* texRow0 = atlas.pixels + static_cast<size_t>(row0) * atlas.width;
+        const uint8_t* texRow1 = atlas.pixels + static_cast<size_t>(row1) * atlas.width;
+
+        for (int i = 0; i < count; ++i)
+        {
+            const AxisSample& s = columns[i];
+            uint32_t value = bilerp(texRow0[s.t0], texRow0[s.t1], texRow1[s.t0], texRow1[s.t1], s.frac, fy);
+            uint8_t coverage = gamma[value > 255 ? 255 : value];
+            m_coverage[i] = coverage < 3 ? 0 : coverage;
+        }
+
+        flushCoverage(area.x0, y, count, rgba);
+    }
+}
+
+void SoftwareRasterizer::drawImage(const Rect& dest, const Vec2& uvMin, const Vec2& uvMax,
+                                   const TextureView& texture, bool repeat)
+{
+    if (!texture.pixels || texture.format != TextureFormat::RGBA8_Unorm) return;
+    if (dest.width <= 0.0f || dest.height <= 0.0f) return;
+
+    PixelBounds area = PixelBounds(static_cast<int>(std::ceil(dest.x - 0.5f)),
+                                   static_cast<int>(std::ceil(dest.y - 0.5f)),
+                                   static_cast<int>(std::ceil(dest.x + dest.width - 0.5f)),
+                                   static_cast<int>(std::ceil(dest.y + dest.height - 0.5f)))
+                           .intersect(m_clip);
+    if (area.isEmpty()) return;
+
+    int count = area.x1 - area.x0;
+    std::vector<AxisSample>& columns = t_columnSamples;
+    computeAxisSamples(columns, area.x0, count, dest.x, dest.width, uvMin.x, uvMax.x, texture.width, repeat);
+
+    float vScale = (uvMax.y - uvMin.y) * texture.height / dest.height;
+    size_t texStride = static_cast<size_t>(texture.width) * 4;
+
+    for (int y = area.y0; y < area.y1; ++y)
+    {
+        float t = uvMin.y * texture.height + (y + 0.5f - dest.y) * vScale - 0.5f;
+        float ft = std::floor(t);
+        int row0 = wrapTexel(static_cast<int>(ft), static_cast<int>(texture.height), repeat);
+        int row1 = wrapTexel(static_cast<int>(ft) + 1, static_cast<int>(texture.height), repeat);
+        uint32_t fy = static_cast<uint32_t>((t - ft) * 256.0f);
+
+        const uint8_t* texRow0 = texture.pixels + row0 * texStride;
+        const uint8_t* texRow1 = texture.pixels + row1 * texStride;
+        uint8_t* out = m_rowPixels.data();
+
+        for (int i = 0; i < count; ++i)
+        {
+            const AxisSample& s = columns[i];
+            const uint8_t* a = texRow0 + s.t0 * 4;
+            const uint8_t* b = texRow0 + s.t1 * 4;
+            const uint8_t* c = texRow1 + s.t0 * 4;
+            const uint8_t* d = texRow1 + s.t1 * 4;
+            for (int ch = 0; ch < 4; ++ch)
+                out[i * 4 + ch] = static_cast<uint8_t>(std::min<uint32_t>(255, bilerp(a[ch], b[ch], c[ch], d[ch], s.frac, fy)));
+        }
+
+        blendSpanRGBA(row(y) + area.x0 * 4, out, count);
+    }
+}
+
+} // namespace YuchenUI
@@ -0,0 +1,163 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+#pragma once
+
+#include "YuchenUI/core/Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace YuchenUI {
+
+//==========================================================================================
+/** Half-open integer pixel rectangle [x0, x1) x [y0, y1). */
+struct PixelBounds {
+    int x0, y0, x1, y1;
+
+    PixelBounds() : x0(0), y0(0), x1(0), y1(0) {}
+    PixelBounds(int left, int top, int right, int bottom) : x0(left), y0(top), x1(right), y1(bottom) {}
+
+    bool isEmpty() const { return x1 <= x0 || y1 <= y0; }
+
+    PixelBounds intersect(const PixelBounds& other) const;
+
+    /** Returns the smallest pixel rect covering a rect given in physical coordinates. */
+    static PixelBounds fromRect(float x, float y, float width, float height);
+};
+
+//==========================================================================================
+/** Read-only view of a CPU texture (R8 or RGBA8, tightly packed). */
+struct TextureView {
+    const uint8_t* pixels;
+    uint32_t width;
+    uint32_t height;
+    TextureFormat format;
+};
+
+//==========================================================================================
+/**
+    One linear color ramp of a gradient rect, in physical pixels.
+
+    Colors are interpolated between start and end and clamped outside. Only pixels whose
+    centers fall in [drawStart, drawEnd) along the axis are drawn, matching how the GPU
+    rasterizes the ramp's quad; an infinite bound also covers the antialiased edge.
+*/
+struct GradientSpan {
+    bool vertical;          ///< Ramp runs top to bottom instead of left to right
+    float start, end;       ///< Ramp extent along the axis
+    float drawStart;        ///< First pixel center drawn along the axis
+    float drawEnd;          ///< Pixel centers at or past this are not drawn
+    Vec4 startColor;
+    Vec4 endColor;
+};
+
+//==========================================================================================
+/**
+    Scanline rasterizer for the software backend.
+
+    Draws into an RGBA8 (non-premultiplied, straight alpha) surface using the same
+    coverage rules as the GPU shaders: SDF rounded rects and circles with a one pixel
+    antialiased edge, gradient rects interpolated per pixel center, pixel-center sampled triangles, bilinear glyph and image sampling,
+    and source-over blending.
+
+    Coverage is evaluated per pixel only where it varies (rect edges, corners, glyphs);
+    interior runs go straight to the span kernels, which are vectorized with AVX2 or
+    SSE2 when the compiler targets them and fall back to scalar code otherwise.
+
+    All coordinates are physical pixels. Every draw is clipped to the current clip,
+    which is always contained in the surface.
+
+    One instance is not thread-safe; it owns per-row scratch buffers.
+*/
+class SoftwareRasterizer {
+public:
+    SoftwareRasterizer();
+
+    //======================================================================================
+    /** Sets the destination surface and resets the clip to cover it. */
+    void setTarget(uint8_t* pixels, int width, int height, size_t bytesPerRow);
+
+    /** Restricts drawing to a pixel rect (intersected with the surface). */
+    void setClip(const PixelBounds& clip);
+
+    /** Resets the clip to the whole surface. */
+    void resetClip();
+
+    const PixelBounds& getClip() const { return m_clip; }
+
+    //======================================================================================
+    /** Overwrites the clip area with a color (no blending). */
+    void clear(const Vec4& color);
+
+    /** Draws a rounded rect; a border width > 0 draws only the outline ring.
+
+        @param radii  Corner radii as (topLeft, topRight, bottomLeft, bottomRight)
+    */
+    void drawRoundedRect(const Rect& rect, const Vec4& radii, float borderWidth, const Vec4& color);
+
+    /** Fills one ramp of a rounded gradient rect (no border).
+
+        @param radii  Corner radii as (topLeft, topRight, bottomLeft, bottomRight)
+    */
+    void drawGradientRect(const Rect& rect, const Vec4& radii, const GradientSpan& span);
+
+    /** Fills a triangle, sampling pixel centers (no antialiasing, like the shape shader). */
+    void fillTriangle(const Vec2& p0, const Vec2& p1, const Vec2& p2, const Vec4& color);
+
+    /** Draws a circle; a border width > 0 draws only the ring.
+
+        @param edgeWidth  Width of the antialiased edge in pixels
+    */
+    void drawCircle(const Vec2& center, float radius, float borderWidth, float edgeWidth, const Vec4& color);
+
+    /** Draws one glyph quad from an R8 coverage or R8_DistanceField atlas.
+
+        Distance fields are thresholded at the glyph edge and antialiased over one
+        destination pixel, so one field serves every drawn size.
+    */
+    void drawGlyph(const Rect& dest, const Vec2& uvMin, const Vec2& uvMax,
+                   const TextureView& atlas, const Vec4& color);
+
+    /** Draws one image quad from an RGBA8 texture.
+
+        @param repeat  Wrap UVs outside [0, 1] instead of clamping (tiled images)
+    */
+    void drawImage(const Rect& dest, const Vec2& uvMin, const Vec2& uvMax,
+                   const TextureView& texture, bool repeat);
+
+    //======================================================================================
+    /** Returns the span kernel flavor compiled in ("AVX2", "SSE2" or "Scalar"). */
+    static const char* getKernelName();
+
+private:
+    uint8_t* row(int y) const { return m_pixels + static_cast<size_t>(y) * m_bytesPerRow; }
+
+    /** Blends m_coverage[0, count) with a solid color onto a row segment. */
+    void flushCoverage(int x, int y, int count, const uint8_t color[4]);
+
+    uint8_t* m_pixels;
+    int m_width;
+    int m_height;
+    size_t m_bytesPerRow;
+    PixelBounds m_clip;
+
+    std::vector<uint8_t> m_coverage;   ///< Per-pixel coverage scratch for one row
+    std::vector<uint8_t> m_rowPixels;  ///< RGBA scratch for one row of sampled image texels
+    std::vector<uint8_t> m_rampColors; ///< RGBA scratch for one row of horizontal gradient colors
+    uint8_t m_distanceCoverage[256];   ///< Distance to coverage table of the current glyph quad
+};
+
+} // namespace YuchenUI
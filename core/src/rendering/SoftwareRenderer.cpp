@@ -0,0 +1,705 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Rendering module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file SoftwareRenderer.cpp
+
+    Implementation notes:
+    - Vertex streams come from RenderBatchCompiler unchanged; rect and image positions are
+      NDC, everything else is in logical window coordinates
+    - Each primitive is recovered from its vertex group (6 per rect, image quad and circle,
+      4 per glyph, 3 per triangle) and drawn once, rather than as two triangles
+    - A rect quad that covers only part of its rect, or whose edge colors differ, is a
+      gradient segment; it is drawn as a ramp limited to the quad's span
+    - Everything is scaled to physical pixels before rasterization; antialiasing widths
+      match the shaders (half a physical pixel for rects, one logical pixel for circles)
+    - Scissor rects are truncated to whole pixels the same way as computeScissorRect()
+      in the Metal backend
+    - Primitives are binned into Config::Rendering::SOFTWARE_TILE_SIZE square tiles in
+      list order; tiles are independent, so workers rasterize them in parallel and each
+      tile still sees its primitives in painter's order
+    - The frame clear is folded into the tile pass instead of touching the whole
+      framebuffer up front
+    - A damage rect acts as a frame-wide scissor: it bounds every item's clip and the
+      clear, and tiles outside it are never made active
+    - Identical-frame detection only trusts frames made of one list; a second list in
+      a frame, a texture upload or a resize forgets the last fingerprint
+*/
+
+#include "YuchenUI/rendering/SoftwareRenderer.h"
+#include "SoftwareRasterizer.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/core/Config.h"
+#include "YuchenUI/core/Assert.h"
+#include "YuchenUI/text/TextRenderer.h"
+#include "YuchenUI/image/TextureCache.h"
+#include "YuchenUI/debugging/debug.h"
+#include "YuchenUI/utils/WorkerPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace YuchenUI {
+
+/** Clip and bounds are in physical pixels. */
+struct SoftwareRenderer::RasterItem {
+    ActivePipeline pipeline;
+    bool repeat;                ///< Image items: repeat sampler
+    uint32_t vertex;            ///< First vertex in the pipeline's stream
+    const Texture* texture;     ///< Text and image items
+    PixelBounds clip;
+    PixelBounds bounds;         ///< Pixels the item may touch, already clipped
+};
+
+namespace {
+
+/** Returns the pixels a frame may touch: the damage rounded out, or the whole surface. */
+PixelBounds frameBounds(const Rect& damage, float scale, int pixelWidth, int pixelHeight)
+{
+    const PixelBounds surface(0, 0, pixelWidth, pixelHeight);
+    if (damage.isEmpty()) return surface;
+
+    return PixelBounds::fromRect(damage.x * scale, damage.y * scale,
+                                 damage.width * scale, damage.height * scale).intersect(surface);
+}
+
+/**
+    Recovers the ramp drawn by a rect quad.
+
+    Gradient rects are emitted as one quad per stop segment, each carrying the whole
+    rect; a plain rect's quad covers its rect in one color. Quad edges went through
+    NDC, so comparisons against the rect allow a small tolerance.
+
+    @param quad      The quad's six vertices
+    @param rect      Rect carried by the vertices, physical pixels
+    @param quadRect  Area covered by the quad, physical pixels
+    @returns False for a plain single-color rect
+*/
+bool recoverGradientSpan(const RectVertex* quad, const Rect& rect, const Rect& quadRect, GradientSpan& span)
+{
+    const float tolerance = 0.01f;
+    const bool partialX = quadRect.x > rect.x + tolerance ||
+                          quadRect.x + quadRect.width < rect.x + rect.width - tolerance;
+    const bool partialY = quadRect.y > rect.y + tolerance ||
+                          quadRect.y + quadRect.height < rect.y + rect.height - tolerance;
+    const bool vertical = partialY || quad[0].color != quad[1].color;
+    const bool horizontal = partialX || quad[0].color != quad[5].color;
+    if (!vertical && !horizontal) return false;
+
+    const float rectStart = vertical ? rect.y : rect.x;
+    const float rectEnd = vertical ? rect.y + rect.height : rect.x + rect.width;
+
+    span.vertical = vertical;
+    span.start = vertical ? quadRect.y : quadRect.x;
+    span.end = vertical ? quadRect.y + quadRect.height : quadRect.x + quadRect.width;
+    // Outermost segments also own the antialiased edge beyond the rect
+    span.drawStart = span.start <= rectStart + tolerance ? -INFINITY : span.start;
+    span.drawEnd = span.end >= rectEnd - tolerance ? INFINITY : span.end;
+    span.startColor = quad[0].color;
+    span.endColor = vertical ? quad[1].color : quad[5].color;
+    return true;
+}
+
+} // namespace
+
+//==========================================================================================
+// [SECTION] Lifecycle
+
+SoftwareRenderer::SoftwareRenderer()
+    : m_textRenderer(nullptr)
+    , m_textureCache(nullptr)
+    , m_batchCompiler(nullptr)
+    , m_workerPool(nullptr)
+    , m_tilesX(0)
+    , m_tilesY(0)
+    , m_clearPending(false)
+    , m_damageRect()
+    , m_skipIdenticalFrames(true)
+    , m_listsThisFrame(0)
+    , m_hasLastFrame(false)
+    , m_lastFingerprint(0)
+    , m_lastDamageRect()
+    , m_skippedFrameCount(0)
+    , m_isInitialized(false)
+    , m_width(0)
+    , m_height(0)
+    , m_pixelWidth(0)
+    , m_pixelHeight(0)
+    , m_dpiScale(1.0f)
+    , m_clearColor(Config::Rendering::DEFAULT_CLEAR_COLOR)
+{
+    setThreadCount(0);
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+    // Subsystems release their textures through this backend
+    m_batchCompiler.reset();
+    m_textureCache.reset();
+    m_textRenderer.reset();
+    m_textures.clear();
+}
+
+bool SoftwareRenderer::initialize(void* platformSurface, int width, int height,
+                                  float dpiScale, IFontProvider* fontProvider,
+                                  IResourceResolver* resourceResolver)
+{
+    YUCHEN_ASSERT_MSG(!m_isInitialized, "Already initialized");
+    YUCHEN_ASSERT_MSG(width >= Config::Window::MIN_SIZE && width <= Config::Window::MAX_SIZE, "Invalid width");
+    YUCHEN_ASSERT_MSG(height >= Config::Window::MIN_SIZE && height <= Config::Window::MAX_SIZE, "Invalid height");
+    YUCHEN_ASSERT_MSG(dpiScale > 0.0f && dpiScale <= 3.0f, "Invalid DPI scale");
+    YUCHEN_ASSERT_MSG(fontProvider != nullptr, "Font provider cannot be null");
+    YUCHEN_ASSERT_MSG(resourceResolver != nullptr, "Resource resolver cannot be null");
+
+    m_width = width;
+    m_height = height;
+    m_dpiScale = dpiScale;
+    allocateFramebuffer();
+
+    m_isInitialized = true;
+
+    m_textRenderer = std::make_unique<TextRenderer>(this, fontProvider);
+    if (!m_textRenderer->initialize(m_dpiScale)) return false;
+
+    m_textureCache = std::make_unique<TextureCache>(this, resourceResolver);
+    if (!m_textureCache->initialize()) return false;
+
+    m_textureCache->setCurrentDPI(m_dpiScale);
+
+    m_batchCompiler = std::make_unique<RenderBatchCompiler>(m_textRenderer.get(), m_textureCache.get());
+    return true;
+}
+
+void SoftwareRenderer::resize(int width, int height)
+{
+    YUCHEN_ASSERT_MSG(width >= Config::Window::MIN_SIZE && width <= Config::Window::MAX_SIZE, "Invalid width");
+    YUCHEN_ASSERT_MSG(height >= Config::Window::MIN_SIZE && height <= Config::Window::MAX_SIZE, "Invalid height");
+
+    m_width = width;
+    m_height = height;
+    m_hasLastFrame = false;
+    allocateFramebuffer();
+}
+
+void SoftwareRenderer::allocateFramebuffer()
+{
+    m_pixelWidth = static_cast<int>(std::ceil(m_width * m_dpiScale));
+    m_pixelHeight = static_cast<int>(std::ceil(m_height * m_dpiScale));
+    m_framebuffer.assign(static_cast<size_t>(m_pixelWidth) * m_pixelHeight * 4, 0);
+    for (auto& rasterizer : m_rasterizers)
+        rasterizer->setTarget(m_framebuffer.data(), m_pixelWidth, m_pixelHeight, getBytesPerRow());
+}
+
+void SoftwareRenderer::setThreadCount(size_t threadCount)
+{
+    m_workerPool = std::make_unique<WorkerPool>(threadCount);
+
+    m_rasterizers.clear();
+    for (size_t i = 0; i < m_workerPool->getThreadCount(); ++i)
+    {
+        m_rasterizers.push_back(std::make_unique<SoftwareRasterizer>());
+        m_rasterizers.back()->setTarget(m_framebuffer.data(), m_pixelWidth, m_pixelHeight, getBytesPerRow());
+    }
+}
+
+size_t SoftwareRenderer::getThreadCount() const
+{
+    return m_workerPool->getThreadCount();
+}
+
+Vec2 SoftwareRenderer::getRenderSize() const
+{
+    return Vec2(static_cast<float>(m_width), static_cast<float>(m_height));
+}
+
+uint32_t SoftwareRenderer::getPixel(int x, int y) const
+{
+    YUCHEN_ASSERT(x >= 0 && x < m_pixelWidth && y >= 0 && y < m_pixelHeight);
+
+    uint32_t value;
+    std::memcpy(&value, m_framebuffer.data() + y * getBytesPerRow() + x * 4, 4);
+    return value;
+}
+
+const RenderBatchStats& SoftwareRenderer::getBatchStats() const
+{
+    static const RenderBatchStats empty;
+    return m_batchCompiler ? m_batchCompiler->getStats() : empty;
+}
+
+const GlyphUploadStats& SoftwareRenderer::getGlyphUploadStats() const
+{
+    static const GlyphUploadStats empty;
+    return m_textRenderer ? m_textRenderer->getGlyphUploadStats() : empty;
+}
+
+const char* SoftwareRenderer::getKernelName()
+{
+    return SoftwareRasterizer::getKernelName();
+}
+
+//==========================================================================================
+// [SECTION] Frame Management
+
+void SoftwareRenderer::beginFrame()
+{
+    YUCHEN_ASSERT(m_isInitialized);
+
+    // Deferred so the clear runs on the tile workers together with the first draw
+    m_clearPending = true;
+    m_listsThisFrame = 0;
+    if (m_textRenderer) m_textRenderer->beginFrame();
+}
+
+void SoftwareRenderer::endFrame()
+{
+    if (m_clearPending)
+    {
+        // Nothing was drawn this frame; still honor the clear
+        m_hasLastFrame = false;
+        m_items.clear();
+        binItems();
+        rasterizeTiles();
+    }
+
+    m_damageRect = Rect();
+}
+
+void SoftwareRenderer::setSkipIdenticalFrames(bool enabled)
+{
+    m_skipIdenticalFrames = enabled;
+    m_hasLastFrame = false;
+}
+
+void SoftwareRenderer::setGlyphFormat(GlyphFormat format)
+{
+    YUCHEN_ASSERT(m_isInitialized);
+    const bool accepted = m_textRenderer->setGlyphFormat(format);
+    YUCHEN_ASSERT(accepted);
+    (void)accepted;
+    m_hasLastFrame = false;
+}
+
+GlyphFormat SoftwareRenderer::getGlyphFormat() const
+{
+    return m_textRenderer ? m_textRenderer->getGlyphFormat() : GlyphFormat::Coverage;
+}
+
+bool SoftwareRenderer::saveTextCache(const char* path) const
+{
+    YUCHEN_ASSERT(m_isInitialized);
+    return m_textRenderer->saveCache(path);
+}
+
+size_t SoftwareRenderer::loadTextCache(const char* path)
+{
+    YUCHEN_ASSERT(m_isInitialized);
+    return m_textRenderer->loadCache(path);
+}
+
+size_t SoftwareRenderer::prewarmText(const FontFallbackChain& fallbackChain, const std::vector<float>& fontSizes,
+                                     const std::vector<std::string>& strings)
+{
+    YUCHEN_ASSERT(m_isInitialized);
+    return m_textRenderer->prewarm(fallbackChain, fontSizes, strings);
+}
+
+size_t SoftwareRenderer::prewarmText(const FontFallbackChain& fallbackChain, const std::vector<float>& fontSizes,
+                                     const std::vector<uint32_t>& codepoints)
+{
+    YUCHEN_ASSERT(m_isInitialized);
+    return m_textRenderer->prewarm(fallbackChain, fontSizes, codepoints);
+}
+
+const TextPrewarmProgress& SoftwareRenderer::getTextPrewarmProgress() const
+{
+    static const TextPrewarmProgress empty;
+    return m_textRenderer ? m_textRenderer->getPrewarmProgress() : empty;
+}
+
+void SoftwareRenderer::setDamageRect(const Rect& rect)
+{
+    YUCHEN_ASSERT(rect.isValid());
+    m_damageRect = rect;
+}
+
+//==========================================================================================
+// [SECTION] Textures
+
+void* SoftwareRenderer::createTexture2D(uint32_t width, uint32_t height, TextureFormat format)
+{
+    YUCHEN_ASSERT_MSG(width > 0 && height > 0, "Invalid texture size");
+
+    auto texture = std::make_unique<Texture>();
+    texture->width = width;
+    texture->height = height;
+    texture->format = format;
+    size_t bytesPerPixel = format == TextureFormat::RGBA8_Unorm ? 4 : 1;
+    texture->pixels.assign(static_cast<size_t>(width) * height * bytesPerPixel, 0);
+
+    void* handle = texture.get();
+    m_textures.emplace(handle, std::move(texture));
+    return handle;
+}
+
+void SoftwareRenderer::updateTexture2D(void* texture, uint32_t x, uint32_t y,
+                                       uint32_t width, uint32_t height,
+                                       const void* data, size_t bytesPerRow)
+{
+    auto it = m_textures.find(texture);
+    YUCHEN_ASSERT_MSG(it != m_textures.end(), "Unknown texture");
+    YUCHEN_ASSERT(data != nullptr);
+
+    // Lists referencing this texture may now draw differently
+    m_hasLastFrame = false;
+
+    Texture& tex = *it->second;
+    YUCHEN_ASSERT_MSG(x + width <= tex.width && y + height <= tex.height, "Update region out of bounds");
+
+    size_t bytesPerPixel = tex.format == TextureFormat::RGBA8_Unorm ? 4 : 1;
+    size_t rowBytes = width * bytesPerPixel;
+    const uint8_t* src = static_cast<const uint8_t*>(data);
+
+    for (uint32_t row = 0; row < height; ++row)
+    {
+        uint8_t* dst = tex.pixels.data() + ((y + row) * tex.width + x) * bytesPerPixel;
+        std::memcpy(dst, src + row * bytesPerRow, rowBytes);
+    }
+}
+
+void SoftwareRenderer::destroyTexture(void* texture)
+{
+    m_hasLastFrame = false;
+    m_textures.erase(texture);
+}
+
+//==========================================================================================
+// [SECTION] Command Execution
+
+void SoftwareRenderer::executeRenderCommands(const RenderList& commandList)
+{
+    if (commandList.isEmpty()) return;
+
+    const uint64_t fingerprint = commandList.getFingerprint();
+    if (++m_listsThisFrame == 1)
+    {
+        if (m_skipIdenticalFrames && m_hasLastFrame && fingerprint == m_lastFingerprint &&
+            m_damageRect == m_lastDamageRect)
+        {
+            // The framebuffer already holds exactly this frame
+            m_clearPending = false;
+            ++m_skippedFrameCount;
+            return;
+        }
+
+        m_lastFingerprint = fingerprint;
+        m_lastDamageRect = m_damageRect;
+        m_hasLastFrame = true;
+    }
+    else
+    {
+        m_hasLastFrame = false;
+    }
+
+    m_batchCompiler->compile(commandList, getRenderSize());
+    if (m_batchCompiler->hasClearColor())
+    {
+        m_clearColor = m_batchCompiler->getClearColor();
+        m_clearPending = true;
+    }
+
+    buildItems();
+    binItems();
+    rasterizeTiles();
+}
+
+void SoftwareRenderer::buildItems()
+{
+    const float s = m_dpiScale;
+    const PixelBounds surface = frameBounds(m_damageRect, s, m_pixelWidth, m_pixelHeight);
+    m_items.clear();
+
+    for (const RenderBatch& batch : m_batchCompiler->getBatches())
+    {
+        RasterItem item;
+        item.pipeline = batch.pipeline;
+        item.repeat = batch.repeatSampler;
+        item.texture = nullptr;
+        item.clip = surface;
+
+        if (batch.hasClip)
+        {
+            int x = static_cast<int>(batch.clipRect.x * s);
+            int y = static_cast<int>(batch.clipRect.y * s);
+            item.clip = PixelBounds(x, y, x + static_cast<int>(batch.clipRect.width * s),
+                                    y + static_cast<int>(batch.clipRect.height * s)).intersect(surface);
+        }
+        if (item.clip.isEmpty()) continue;
+
+        if (batch.pipeline == ActivePipeline::Text || batch.pipeline == ActivePipeline::Image)
+        {
+            auto it = m_textures.find(batch.texture);
+            if (it == m_textures.end()) continue;
+            item.texture = it->second.get();
+        }
+
+        const uint32_t first = batch.firstVertex;
+        const uint32_t end = batch.firstVertex + batch.vertexCount;
+
+        auto add = [&](uint32_t vertex, const Rect& bounds) {
+            item.vertex = vertex;
+            item.bounds = PixelBounds::fromRect(bounds.x, bounds.y, bounds.width, bounds.height).intersect(item.clip);
+            if (!item.bounds.isEmpty()) m_items.push_back(item);
+        };
+
+        switch (batch.pipeline)
+        {
+            case ActivePipeline::Rect:
+            {
+                // Leave a pixel for the antialiased edge
+                const auto& vertices = m_batchCompiler->getRectVertices();
+                for (uint32_t i = first; i + 6 <= end; i += 6)
+                {
+                    const RectVertex& v = vertices[i];
+                    Rect rect(v.rectOrigin.x * s, v.rectOrigin.y * s, v.rectSize.x * s, v.rectSize.y * s);
+                    Rect bounds = rect.expanded(1.0f);
+
+                    // A gradient segment only touches its own part of the rect
+                    GradientSpan span;
+                    if (recoverGradientSpan(&v, rect, quadPixelRect(v.position, vertices[i + 2].position), span))
+                    {
+                        float& origin = span.vertical ? bounds.y : bounds.x;
+                        float& size = span.vertical ? bounds.height : bounds.width;
+                        float from = std::max(origin, std::floor(span.drawStart));
+                        float to = std::min(origin + size, std::ceil(span.drawEnd));
+                        origin = from;
+                        size = std::max(to - from, 0.0f);
+                    }
+                    add(i, bounds);
+                }
+                break;
+            }
+
+            case ActivePipeline::Text:
+            {
+                const auto& vertices = m_batchCompiler->getTextVertices();
+                for (uint32_t i = first; i + 4 <= end; i += 4)
+                {
+                    const Vec2& tl = vertices[i].position;
+                    const Vec2& br = vertices[i + 3].position;
+                    add(i, Rect(tl.x * s, tl.y * s, (br.x - tl.x) * s, (br.y - tl.y) * s));
+                }
+                break;
+            }
+
+            case ActivePipeline::Image:
+            {
+                const auto& vertices = m_batchCompiler->getImageVertices();
+                for (uint32_t i = first; i + 6 <= end; i += 6)
+                    add(i, quadPixelRect(vertices[i].position, vertices[i + 2].position));
+                break;
+            }
+
+            case ActivePipeline::Shape:
+            {
+                const auto& vertices = m_batchCompiler->getShapeVertices();
+                for (uint32_t i = first; i + 3 <= end; i += 3)
+                {
+                    const Vec2& a = vertices[i].position;
+                    const Vec2& b = vertices[i + 1].position;
+                    const Vec2& c = vertices[i + 2].position;
+                    float left = std::min(a.x, std::min(b.x, c.x)) * s;
+                    float top = std::min(a.y, std::min(b.y, c.y)) * s;
+                    float right = std::max(a.x, std::max(b.x, c.x)) * s;
+                    float bottom = std::max(a.y, std::max(b.y, c.y)) * s;
+                    add(i, Rect(left, top, right - left, bottom - top));
+                }
+                break;
+            }
+
+            case ActivePipeline::Circle:
+            {
+                const auto& vertices = m_batchCompiler->getCircleVertices();
+                for (uint32_t i = first; i + 6 <= end; i += 6)
+                {
+                    const CircleVertex& v = vertices[i];
+                    float r = v.radius * s;
+                    add(i, Rect(v.center.x * s - r, v.center.y * s - r, r * 2.0f, r * 2.0f));
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+}
+
+void SoftwareRenderer::binItems()
+{
+    const int tileSize = Config::Rendering::SOFTWARE_TILE_SIZE;
+    m_tilesX = (m_pixelWidth + tileSize - 1) / tileSize;
+    m_tilesY = (m_pixelHeight + tileSize - 1) / tileSize;
+
+    size_t tileCount = static_cast<size_t>(m_tilesX) * m_tilesY;
+    if (m_tileBins.size() != tileCount) m_tileBins.resize(tileCount);
+    for (auto& bin : m_tileBins) bin.clear();
+
+    for (uint32_t index = 0; index < m_items.size(); ++index)
+    {
+        const PixelBounds& b = m_items[index].bounds;
+        int tx1 = (b.x1 - 1) / tileSize;
+        int ty1 = (b.y1 - 1) / tileSize;
+        for (int ty = b.y0 / tileSize; ty <= ty1; ++ty)
+            for (int tx = b.x0 / tileSize; tx <= tx1; ++tx)
+                m_tileBins[ty * m_tilesX + tx].push_back(index);
+    }
+
+    // Every damaged tile needs work when clearing; otherwise only tiles with items do
+    const PixelBounds frame = frameBounds(m_damageRect, m_dpiScale, m_pixelWidth, m_pixelHeight);
+    m_activeTiles.clear();
+    for (uint32_t tile = 0; tile < tileCount; ++tile)
+    {
+        if (!m_tileBins[tile].empty())
+        {
+            m_activeTiles.push_back(tile);
+        }
+        else if (m_clearPending && !frame.isEmpty())
+        {
+            int tx = static_cast<int>(tile % m_tilesX) * tileSize;
+            int ty = static_cast<int>(tile / m_tilesX) * tileSize;
+            if (!PixelBounds(tx, ty, tx + tileSize, ty + tileSize).intersect(frame).isEmpty())
+                m_activeTiles.push_back(tile);
+        }
+    }
+}
+
+void SoftwareRenderer::rasterizeTiles()
+{
+    const int tileSize = Config::Rendering::SOFTWARE_TILE_SIZE;
+    const bool clear = m_clearPending;
+    const PixelBounds frame = frameBounds(m_damageRect, m_dpiScale, m_pixelWidth, m_pixelHeight);
+
+    m_workerPool->parallelFor(m_activeTiles.size(), [&](size_t task, size_t worker) {
+        SoftwareRasterizer& raster = *m_rasterizers[worker];
+        uint32_t tile = m_activeTiles[task];
+        int tx = static_cast<int>(tile % m_tilesX) * tileSize;
+        int ty = static_cast<int>(tile / m_tilesX) * tileSize;
+        PixelBounds tileBounds(tx, ty, tx + tileSize, ty + tileSize);
+
+        if (clear)
+        {
+            PixelBounds clearBounds = tileBounds.intersect(frame);
+            if (!clearBounds.isEmpty())
+            {
+                raster.setClip(clearBounds);
+                raster.clear(m_clearColor);
+            }
+        }
+
+        // Items are binned in list order, so painter's order holds within the tile
+        for (uint32_t index : m_tileBins[tile])
+        {
+            const RasterItem& item = m_items[index];
+            raster.setClip(item.clip.intersect(tileBounds));
+            drawItem(item, raster);
+        }
+    });
+
+    m_clearPending = false;
+}
+
+Rect SoftwareRenderer::quadPixelRect(const Vec2& topLeft, const Vec2& bottomRight) const
+{
+    // Rect and image positions are NDC; quads are (L,T), (L,B), (R,B), (L,T), (R,B), (R,T)
+    const float pixelWidth = static_cast<float>(m_width) * m_dpiScale;
+    const float pixelHeight = static_cast<float>(m_height) * m_dpiScale;
+    float left = (topLeft.x + 1.0f) * 0.5f * pixelWidth;
+    float top = (1.0f - topLeft.y) * 0.5f * pixelHeight;
+    float right = (bottomRight.x + 1.0f) * 0.5f * pixelWidth;
+    float bottom = (1.0f - bottomRight.y) * 0.5f * pixelHeight;
+    return Rect(left, top, right - left, bottom - top);
+}
+
+void SoftwareRenderer::drawItem(const RasterItem& item, SoftwareRasterizer& raster) const
+{
+    const float s = m_dpiScale;
+    const uint32_t i = item.vertex;
+
+    switch (item.pipeline)
+    {
+        case ActivePipeline::Rect:
+        {
+            const auto& vertices = m_batchCompiler->getRectVertices();
+            const RectVertex& v = vertices[i];
+            Rect rect(v.rectOrigin.x * s, v.rectOrigin.y * s, v.rectSize.x * s, v.rectSize.y * s);
+            Vec4 radii(v.cornerRadius.x * s, v.cornerRadius.y * s, v.cornerRadius.z * s, v.cornerRadius.w * s);
+
+            GradientSpan span;
+            if (recoverGradientSpan(&v, rect, quadPixelRect(v.position, vertices[i + 2].position), span))
+                raster.drawGradientRect(rect, radii, span);
+            else
+                raster.drawRoundedRect(rect, radii, v.borderWidth * s, v.color);
+            break;
+        }
+
+        case ActivePipeline::Text:
+        {
+            // Glyph quads are TL, TR, BL, BR
+            const auto& vertices = m_batchCompiler->getTextVertices();
+            const TextVertex& tl = vertices[i];
+            const TextVertex& br = vertices[i + 3];
+            const Texture& atlas = *item.texture;
+            TextureView view = { atlas.pixels.data(), atlas.width, atlas.height, atlas.format };
+            Rect dest(tl.position.x * s, tl.position.y * s,
+                      (br.position.x - tl.position.x) * s, (br.position.y - tl.position.y) * s);
+            raster.drawGlyph(dest, tl.texCoord, br.texCoord, view, tl.color);
+            break;
+        }
+
+        case ActivePipeline::Image:
+        {
+            const auto& vertices = m_batchCompiler->getImageVertices();
+            const Texture& texture = *item.texture;
+            TextureView view = { texture.pixels.data(), texture.width, texture.height, texture.format };
+            raster.drawImage(quadPixelRect(vertices[i].position, vertices[i + 2].position),
+                             vertices[i].texCoord, vertices[i + 2].texCoord, view, item.repeat);
+            break;
+        }
+
+        case ActivePipeline::Shape:
+        {
+            const auto& vertices = m_batchCompiler->getShapeVertices();
+            const Vec2& a = vertices[i].position;
+            const Vec2& b = vertices[i + 1].position;
+            const Vec2& c = vertices[i + 2].position;
+            raster.fillTriangle(Vec2(a.x * s, a.y * s), Vec2(b.x * s, b.y * s),
+                                Vec2(c.x * s, c.y * s), vertices[i].color);
+            break;
+        }
+
+        case ActivePipeline::Circle:
+        {
+            const CircleVertex& v = m_batchCompiler->getCircleVertices()[i];
+            raster.drawCircle(Vec2(v.center.x * s, v.center.y * s), v.radius * s, v.borderWidth * s, s, v.color);
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+} // namespace YuchenUI
@@ -1,6 +1,7 @@
 #include "YuchenUI/resource/EmbeddedResourceProvider.h"
 #include <algorithm>
 #include <cctype>
+#include <cstring>
 
 namespace YuchenUI {
 
@@ -20,9 +20,13 @@
     - FontFile copies data to internal buffer for lifetime independence
     - FontFace wraps FT_Face with automatic cleanup
     - FontCache uses LRU eviction with quantized size keys (size * 2)
-    - HarfBuzz fonts created with FT callbacks and scale factors
+    - HarfBuzz fonts created with FT callbacks and scale factors; creation is static so
+      TextShaper builds identical fonts over its per-thread faces
     - setCharSize() must be called before glyph operations on FT_Face
     - measureText() is simple advance sum without shaping (for basic estimation)
+    - FontCoverage reads a block with FT_Get_Next_Char(), which steps through the mapped
+      codepoints only, so reading a block costs one step per glyph the font has there
+      rather than one cmap lookup per codepoint of the block
 */
 
 #include "YuchenUI/text/Font.h"
@@ -336,7 +340,7 @@ hb_font_t* FontCache::getHarfBuzzFont(const FontFace& fontFace, float fontSize)
     if (m_harfBuzzFonts.size() >= MAX_CACHED_SIZES) evictLeastRecentlyUsed();
     
     // Create new HarfBuzz font
-    hb_font_t* hbFont = createHarfBuzzFont(fontFace, fontSize);
+    hb_font_t* hbFont = createHarfBuzzFont(fontFace.getFTFace(), fontSize);
     if (!hbFont)
     {
         std::cerr << "[FontCache] Failed to create HarfBuzz font" << std::endl;
@@ -384,21 +388,14 @@ void FontCache::updateLRU(uint32_t sizeKey)
     m_usageOrder.push_front(sizeKey);
 }
 
-hb_font_t* FontCache::createHarfBuzzFont(const FontFace& fontFace, float fontSize)
+hb_font_t* FontCache::createHarfBuzzFont(FT_Face ftFace, float fontSize)
 {
-    if (!fontFace.isValid())
-    {
-        std::cerr << "[FontCache] Invalid font face" << std::endl;
-        return nullptr;
-    }
-    
     if (fontSize < Config::Font::MIN_SIZE || fontSize > Config::Font::MAX_SIZE)
     {
         std::cerr << "[FontCache] Font size out of range: " << fontSize << std::endl;
         return nullptr;
     }
     
-    FT_Face ftFace = fontFace.getFTFace();
     if (!ftFace)
     {
         std::cerr << "[FontCache] FT_Face is null" << std::endl;
@@ -474,4 +471,66 @@ hb_font_t* FontCache::createHarfBuzzFont(const FontFace& fontFace, float fontSiz
     return hbFont;
 }
 
+//==========================================================================================
+// FontCoverage Implementation
+
+FontCoverage::FontCoverage()
+    : m_blockRead()
+    , m_blocks()
+{
+}
+
+void FontCoverage::clear()
+{
+    for (uint32_t block = 0; block < BLOCK_COUNT; ++block)
+    {
+        m_blockRead[block] = false;
+        m_blocks[block].reset();
+    }
+}
+
+size_t FontCoverage::getReadBlockCount() const
+{
+    size_t count = 0;
+    for (bool read : m_blockRead) count += read ? 1 : 0;
+    return count;
+}
+
+size_t FontCoverage::getMemoryUsage() const
+{
+    size_t bytes = 0;
+    for (const auto& bits : m_blocks) bytes += bits ? BLOCK_SIZE / 8 : 0;
+    return bytes;
+}
+
+void FontCoverage::readBlock(FT_Face face, uint32_t block)
+{
+    YUCHEN_ASSERT(block < BLOCK_COUNT);
+    m_blockRead[block] = true;
+    if (!face || !face->charmap) return;
+    
+    const FT_ULong start = static_cast<FT_ULong>(block) << BLOCK_SHIFT;
+    const FT_ULong end = start + BLOCK_SIZE;
+    std::unique_ptr<uint64_t[]> bits;
+    
+    auto set = [&bits, start](FT_ULong codepoint) {
+        if (!bits) bits.reset(new uint64_t[BLOCK_SIZE / 64]());
+        const FT_ULong offset = codepoint - start;
+        bits[offset >> 6] |= uint64_t(1) << (offset & 63);
+    };
+    
+    // FT_Get_Next_Char() only returns codes above its argument, so U+0000 is asked directly
+    if (start == 0 && FT_Get_Char_Index(face, 0) != 0) set(0);
+    
+    FT_UInt glyphIndex = 0;
+    FT_ULong codepoint = FT_Get_Next_Char(face, start == 0 ? 0 : start - 1, &glyphIndex);
+    while (glyphIndex != 0 && codepoint < end)
+    {
+        if (codepoint >= start) set(codepoint);
+        codepoint = FT_Get_Next_Char(face, codepoint, &glyphIndex);
+    }
+    
+    m_blocks[block] = std::move(bits);
+}
+
 } // namespace YuchenUI
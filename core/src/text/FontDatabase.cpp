@@ -79,6 +79,7 @@ FontHandle FontDatabase::registerFont(const char* path, const char* name, FontEn
     }
     
     entry->cache = std::make_unique<FontCache>();
+    entry->coverage = std::make_unique<FontCoverage>();
     entry->name = descriptor.fullName;
     entry->isValid = true;
     
@@ -120,6 +121,7 @@ FontHandle FontDatabase::registerFontFromMemory(const void* data, size_t size,
     }
     
     entry->cache = std::make_unique<FontCache>();
+    entry->coverage = std::make_unique<FontCoverage>();
     entry->name = descriptor.fullName;
     entry->isValid = true;
     
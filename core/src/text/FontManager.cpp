@@ -3,10 +3,14 @@
 #include "YuchenUI/resource/IResourceResolver.h"
 #include "YuchenUI/core/Assert.h"
 #include "YuchenUI/core/Config.h"
+#include <algorithm>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
+#include <cstring>
 #include <iostream>
+#include <fstream>
+#include <utility>
 
 #ifdef __APPLE__
     #include <CoreText/CoreText.h>
@@ -84,7 +88,6 @@ FontManager::FontManager()
     , m_defaultNarrowBoldFont(INVALID_FONT_HANDLE)
     , m_defaultCJKFont(INVALID_FONT_HANDLE)
     , m_defaultSymbolFont(INVALID_FONT_HANDLE)
-    , m_glyphAvailabilityCache()
 {
     m_fonts.reserve(Config::Font::MAX_FONTS);
 }
@@ -139,7 +142,6 @@ void FontManager::destroy()
     s_measureTextCache.clear();
     s_fontMetricsCache.clear();
     s_warnedMissingGlyphs.clear();
-    m_glyphAvailabilityCache.clear();
 
     m_fontDatabase.shutdown();
 
@@ -259,17 +261,39 @@ void FontManager::loadCJKFont()
                 );
             }
         }
+#else
+        // Noto Sans CJK and WenQuanYi at the paths Debian, Ubuntu, Fedora and Arch install them
+        static const std::pair<const char*, const char*> cjkFonts[] = {
+            { "/usr/share/fonts/opentype/noto/NotoSansCJK-Regular.ttc", "Noto Sans CJK SC" },
+            { "/usr/share/fonts/noto-cjk/NotoSansCJK-Regular.ttc", "Noto Sans CJK SC" },
+            { "/usr/share/fonts/google-noto-cjk/NotoSansCJK-Regular.ttc", "Noto Sans CJK SC" },
+            { "/usr/share/fonts/google-noto-sans-cjk-fonts/NotoSansCJK-Regular.ttc", "Noto Sans CJK SC" },
+            { "/usr/share/fonts/truetype/wqy/wqy-microhei.ttc", "WenQuanYi Micro Hei" },
+            { "/usr/share/fonts/wenquanyi/wqy-microhei/wqy-microhei.ttc", "WenQuanYi Micro Hei" },
+            { "/usr/share/fonts/truetype/wqy/wqy-zenhei.ttc", "WenQuanYi Zen Hei" },
+        };
+        
+        for (const auto& font : cjkFonts)
+        {
+            std::ifstream testFile(font.first);
+            if (!testFile.good()) continue;
+            testFile.close();
+            
+            size_t fontIndex = m_fonts.size();
+            m_fonts.emplace_back();
+            m_defaultCJKFont = m_fontDatabase.registerFont(font.first, font.second, &m_fonts[fontIndex]);
+            if (m_defaultCJKFont != INVALID_FONT_HANDLE) break;
+        }
 #endif
     }
     
     if (m_defaultCJKFont == INVALID_FONT_HANDLE)
     {
-        std::cerr << "[FontManager] ERROR: Failed to load CJK font!" << std::endl;
+        // Headless and minimal systems often have no CJK font; fall back instead of failing
+        std::cerr << "[FontManager] WARNING: No CJK font found, falling back to the default font" << std::endl;
         std::cerr << "[FontManager] Chinese text will NOT be displayed." << std::endl;
         
         m_defaultCJKFont = m_defaultRegularFont;
-        
-        YUCHEN_ASSERT_MSG(false, "CJK font loading failed - check system fonts");
     }
 
 }
@@ -384,41 +408,19 @@ FontFallbackChain FontManager::createTitleFallbackChain() const
     return createBoldFallbackChain();
 }
 
-bool FontManager::hasGlyphImpl(FontHandle handle, uint32_t codepoint) const
-{
-    const FontEntry* entry = getFontEntry(handle);
-    if (!entry || !entry->isValid)
-    {
-        return false;
-    }
-    
-    FT_Face face = entry->face->getFTFace();
-    if (!face)
-    {
-        return false;
-    }
-    
-    uint32_t glyphIndex = FT_Get_Char_Index(face, codepoint);
-    return glyphIndex != 0;
-}
-
 bool FontManager::hasGlyph(FontHandle handle, uint32_t codepoint) const
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "FontManager not initialized");
     YUCHEN_ASSERT_MSG(handle != INVALID_FONT_HANDLE, "Invalid font handle");
     
-    uint64_t cacheKey = (static_cast<uint64_t>(handle) << 32) | codepoint;
-    
-    auto it = m_glyphAvailabilityCache.find(cacheKey);
-    if (it != m_glyphAvailabilityCache.end())
+    const FontEntry* entry = getFontEntry(handle);
+    if (!entry || !entry->isValid)
     {
-        return it->second;
+        return false;
     }
     
-    bool hasGlyph = hasGlyphImpl(handle, codepoint);
-    m_glyphAvailabilityCache[cacheKey] = hasGlyph;
-    
-    return hasGlyph;
+    YUCHEN_ASSERT_MSG(entry->coverage != nullptr, "Font entry has no coverage");
+    return entry->coverage->contains(entry->face->getFTFace(), codepoint);
 }
 
 FontHandle FontManager::selectFontForCodepoint(
@@ -473,6 +475,7 @@ FontHandle FontManager::loadFontFromFile(const char* path, const char* name)
     entry.file = std::make_unique<FontFile>();
     entry.face = std::make_unique<FontFace>(m_freeTypeLibrary);
     entry.cache = std::make_unique<FontCache>();
+    entry.coverage = std::make_unique<FontCoverage>();
     entry.name = name;
 
     if (!entry.file->loadFromFile(path, name))
@@ -506,6 +509,7 @@ FontHandle FontManager::loadFontFromMemory(const void* data, size_t size, const
     entry.file = std::make_unique<FontFile>();
     entry.face = std::make_unique<FontFace>(m_freeTypeLibrary);
     entry.cache = std::make_unique<FontCache>();
+    entry.coverage = std::make_unique<FontCoverage>();
     entry.name = name;
 
     bool fileLoaded [[maybe_unused]] = entry.file->loadFromMemory(data, size, name);
@@ -583,32 +587,7 @@ Vec2 FontManager::measureText(const char* text, float fontSize) const
     
     for (const auto& segment : segments)
     {
-        YUCHEN_ASSERT_MSG(isValidFont(segment.fontHandle), "Invalid font handle in text segment");
-        
-        const FontEntry* entry = getFontEntry(segment.fontHandle);
-        if (!entry || !entry->isValid) continue;
-        
-        hb_font_t* hbFont = entry->cache->getHarfBuzzFont(*entry->face, fontSize);
-        if (!hbFont) continue;
-        
-        hb_buffer_clear_contents(buffer);
-        hb_buffer_set_direction(buffer, HB_DIRECTION_LTR);
-        
-        hb_script_t script = TextUtils::detectTextScript(segment.text.c_str());
-        hb_buffer_set_script(buffer, script);
-        
-        const char* language = TextUtils::getLanguageForScript(script);
-        hb_buffer_set_language(buffer, hb_language_from_string(language, -1));
-        
-        hb_buffer_add_utf8(buffer, segment.text.c_str(), -1, 0, -1);
-        
-        hb_feature_t features[1];
-        features[0].tag = HB_TAG('k','e','r','n');
-        features[0].value = 0;
-        features[0].start = 0;
-        features[0].end = (unsigned int)-1;
-        
-        hb_shape(hbFont, buffer, features, 1);
+        if (!shapeForMeasurement(segment, fontSize, buffer)) continue;
         
         unsigned int glyphCount = 0;
         hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(buffer, &glyphCount);
@@ -634,6 +613,107 @@ Vec2 FontManager::measureText(const char* text, float fontSize) const
     return result;
 }
 
+void FontManager::measureCaretStops(const char* text, float fontSize, std::vector<float>& outStops) const
+{
+    YUCHEN_ASSERT_MSG(m_isInitialized, "FontManager not initialized");
+    YUCHEN_ASSERT(text != nullptr);
+    YUCHEN_ASSERT_MSG(fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE, "Font size out of range");
+    
+    outStops.assign(1, 0.0f);
+    if (*text == '\0') return;
+    
+    const size_t length = std::strlen(text);
+    FontFallbackChain fallbackChain = createDefaultFallbackChain();
+    std::vector<TextSegment> segments = TextUtils::segmentTextWithFallback(text, fallbackChain, const_cast<FontManager*>(this));
+    
+    // Per byte: advance of the cluster starting there, and whether a shaped cluster starts
+    // there (CLUSTER_START), continues (CLUSTER_INSIDE) or no segment covers it (0)
+    constexpr uint8_t CLUSTER_INSIDE = 1;
+    constexpr uint8_t CLUSTER_START = 2;
+    std::vector<float> clusterAdvance(length, 0.0f);
+    std::vector<uint8_t> clusterState(length, 0);
+    
+    hb_buffer_t* buffer = hb_buffer_create();
+    
+    for (const auto& segment : segments)
+    {
+        if (!shapeForMeasurement(segment, fontSize, buffer)) continue;
+        std::fill_n(clusterState.begin() + segment.originalStartIndex, segment.originalLength, CLUSTER_INSIDE);
+        
+        unsigned int glyphCount = 0;
+        hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(buffer, &glyphCount);
+        hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(buffer, &glyphCount);
+        
+        for (unsigned int i = 0; i < glyphCount; ++i)
+        {
+            const size_t byte = segment.originalStartIndex + glyphInfos[i].cluster;
+            YUCHEN_ASSERT(byte < length);
+            clusterState[byte] = CLUSTER_START;
+            clusterAdvance[byte] += glyphPositions[i].x_advance / 64.0f;
+        }
+    }
+    
+    hb_buffer_destroy(buffer);
+    
+    // Walk codepoints; each cluster's advance is split evenly over the codepoints it covers.
+    // Codepoints no segment shaped (skipped replacement characters) get no width.
+    DecodedText decoded;
+    TextUtils::decodeUTF8WithScripts(text, length, decoded);
+    outStops.resize(decoded.size() + 1);
+    
+    float x = 0.0f;
+    size_t first = 0;
+    while (first < decoded.size())
+    {
+        const float advance = clusterAdvance[decoded.byteOffsets[first]];
+        size_t last = first + 1;
+        if (clusterState[decoded.byteOffsets[first]] != 0)
+        {
+            while (last < decoded.size() && clusterState[decoded.byteOffsets[last]] == CLUSTER_INSIDE) ++last;
+        }
+        
+        const size_t count = last - first;
+        for (size_t i = 0; i < count; ++i)
+            outStops[first + i] = x + advance * static_cast<float>(i) / static_cast<float>(count);
+        
+        x += advance;
+        first = last;
+    }
+    outStops[decoded.size()] = x;
+}
+
+bool FontManager::shapeForMeasurement(const TextSegment& segment, float fontSize, hb_buffer_t* buffer) const
+{
+    YUCHEN_ASSERT_MSG(isValidFont(segment.fontHandle), "Invalid font handle in text segment");
+    
+    const FontEntry* entry = getFontEntry(segment.fontHandle);
+    if (!entry || !entry->isValid) return false;
+    
+    hb_font_t* hbFont = entry->cache->getHarfBuzzFont(*entry->face, fontSize);
+    if (!hbFont) return false;
+    
+    hb_buffer_clear_contents(buffer);
+    hb_buffer_set_direction(buffer, HB_DIRECTION_LTR);
+    hb_buffer_set_cluster_level(buffer, HB_BUFFER_CLUSTER_LEVEL_MONOTONE_CHARACTERS);
+    
+    hb_script_t script = TextUtils::detectTextScript(segment.text.c_str());
+    hb_buffer_set_script(buffer, script);
+    
+    const char* language = TextUtils::getLanguageForScript(script);
+    hb_buffer_set_language(buffer, hb_language_from_string(language, -1));
+    
+    hb_buffer_add_utf8(buffer, segment.text.c_str(), -1, 0, -1);
+    
+    hb_feature_t features[1];
+    features[0].tag = HB_TAG('k','e','r','n');
+    features[0].value = 0;
+    features[0].start = 0;
+    features[0].end = (unsigned int)-1;
+    
+    hb_shape(hbFont, buffer, features, 1);
+    return true;
+}
+
 float FontManager::getTextHeight(FontHandle handle, float fontSize) const
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "FontManager not initialized");
@@ -653,6 +733,22 @@ void* FontManager::getFontFace(FontHandle handle) const
     return static_cast<void*>(entry->face->getFTFace());
 }
 
+bool FontManager::getFontData(FontHandle handle, const void*& outData, size_t& outSize) const
+{
+    YUCHEN_ASSERT_MSG(m_isInitialized, "FontManager not initialized");
+    
+    const FontEntry* entry = getFontEntry(handle);
+    if (!entry || !entry->isValid || !entry->file) return false;
+    
+    // FontFile owns the bytes for the life of the manager; FreeType faces may share them
+    const auto& data = entry->file->getMemoryData();
+    if (data.empty()) return false;
+    
+    outData = data.data();
+    outSize = data.size();
+    return true;
+}
+
 void* FontManager::getHarfBuzzFont(FontHandle handle, float fontSize, float dpiScale)
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "FontManager not initialized");
@@ -18,23 +18,70 @@
     
     Implementation notes:
     - Atlas size scales with DPI: BASE_ATLAS_SIZE * dpiScale
-    - Row-based packing: fills current row left-to-right, advances to new row when full
-    - Padding added around each glyph to prevent texture bleeding
+    - Shelf packing (ShelfPacker); removing a glyph frees its padded rectangle
+    - Padding added around each glyph to prevent texture bleeding; the padding is cleared
+      and marked dirty with the glyph so reused space never shows an old glyph's edge
+    - New glyphs only touch the CPU copy. Their cells become dirty regions, which merge
+      when they overlap or their bounding box wastes little (DIRTY_MERGE_SLACK), so glyphs
+      packed side by side on a shelf, and then whole shelves, become one upload
+    - flushUploads() runs from beginFrame() and after each compiled render list
     - Empty glyphs (zero-size bitmaps) stored as metadata only
     - Frame-based expiration: glyphs unused for GLYPH_EXPIRE_FRAMES removed
+    - Pinned glyphs are skipped by periodic cleanup but not by atlas pressure cleanup
     - Cleanup runs every CLEANUP_INTERVAL_FRAMES
-    - No atlas defragmentation - relies on periodic cleanup and atlas creation
-    - R8 texture format (single-channel grayscale) for alpha mask rendering
+    - When no atlas has room, the glyph is dropped for this frame and the next
+      beginFrame() evicts everything not used in the previous frame
+    - Re-packing copies live glyphs, tallest first, from the atlas's CPU copy into a
+      cleared buffer and marks the whole atlas dirty
+    - R8 texture format (single-channel grayscale) for alpha mask rendering; distance
+      field glyphs get their own R8_DistanceField atlases, created on first use
+    - Cache files store each glyph's bitmap rather than whole atlases. Loading re-packs
+      them tallest first, so no packer state is stored and a file written by a session
+      with a different atlas history still packs tightly
+    
+    Version 2.0 Changes:
+    - Replaced row cursor packing with ShelfPacker and real space reclamation
+    - Added per-atlas CPU copy and re-packing of fragmented atlases
+    - Entries record their atlas index
+    
+    Version 2.1 Changes:
+    - Deferred, merged dirty-region uploads with upload counters
+    
+    Version 2.2 Changes:
+    - Per-atlas texture format so distance fields and coverage bitmaps never share one
+    - Glyph save and load for the persistent text cache
+    - Glyph pinning for prewarmed glyphs
 */
 
 #include "YuchenUI/text/GlyphCache.h"
+#include "YuchenUI/text/TextCacheFile.h"
 #include "YuchenUI/rendering/IGraphicsBackend.h"
 #include "YuchenUI/core/Validation.h"
 #include "YuchenUI/core/Config.h"
 #include <algorithm>
+#include <cstring>
 
 namespace YuchenUI {
 
+namespace {
+
+AtlasRegion unite(const AtlasRegion& a, const AtlasRegion& b)
+{
+    const uint32_t x1 = std::min(a.x, b.x);
+    const uint32_t y1 = std::min(a.y, b.y);
+    const uint32_t x2 = std::max(a.x + a.width, b.x + b.width);
+    const uint32_t y2 = std::max(a.y + a.height, b.y + b.height);
+    return AtlasRegion{ x1, y1, x2 - x1, y2 - y1 };
+}
+
+bool overlaps(const AtlasRegion& a, const AtlasRegion& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+} // namespace
+
 //==========================================================================================
 // Lifecycle
 
@@ -44,6 +91,8 @@ GlyphCache::GlyphCache(IGraphicsBackend* backend, float dpiScale)
     , m_dpiScale(dpiScale)
     , m_currentAtlasIndex(0)
     , m_currentFrame(0)
+    , m_atlasPressure(false)
+    , m_uploadStats()
 {
     YUCHEN_ASSERT_MSG(backend != nullptr, "IGraphicsBackend cannot be null");
     if (dpiScale <= 0.0f) m_dpiScale = 1.0f;
@@ -113,7 +162,7 @@ Vec2 GlyphCache::getCurrentAtlasSize() const
 //==========================================================================================
 // Atlas Management
 
-void GlyphCache::createNewAtlas()
+void GlyphCache::createNewAtlas(TextureFormat format)
 {
     // Check atlas limit
     if (m_atlases.size() >= Config::GlyphCache::MAX_ATLASES) return;
@@ -122,13 +171,13 @@ void GlyphCache::createNewAtlas()
     uint32_t atlasHeight = getAtlasHeight();
     
     // Create atlas structure
-    auto atlas = std::make_unique<GlyphAtlas>(atlasWidth, atlasHeight);
+    auto atlas = std::make_unique<GlyphAtlas>(atlasWidth, atlasHeight, format);
     
-    // Create GPU texture (R8 format for grayscale alpha mask)
+    // Create GPU texture (R8 format for grayscale alpha mask or distance field)
     atlas->textureHandle = m_backend->createTexture2D(
         atlasWidth,
         atlasHeight,
-        TextureFormat::R8_Unorm
+        format
     );
     
     YUCHEN_ASSERT_MSG(atlas->textureHandle != nullptr, "Failed to create atlas texture");
@@ -139,86 +188,152 @@ void GlyphCache::createNewAtlas()
     if (m_atlases.size() == 1) m_currentAtlasIndex = 0;
 }
 
-GlyphAtlas* GlyphCache::findAtlasWithSpace(uint32_t width, uint32_t height)
+bool GlyphCache::allocateGlyph(TextureFormat format, uint32_t width, uint32_t height, uint32_t& outAtlasIndex, Rect& outRect)
 {
-    // Calculate required space including padding
-    uint32_t requiredWidth = width + Config::GlyphCache::GLYPH_PADDING * 2;
-    uint32_t requiredHeight = height + Config::GlyphCache::GLYPH_PADDING * 2;
+    const uint32_t padding = Config::GlyphCache::GLYPH_PADDING;
     
-    // Search all atlases for space
-    for (auto& atlas : m_atlases)
+    for (size_t i = 0; i < m_atlases.size(); ++i)
     {
-        if (atlas->isFull) continue;
+        GlyphAtlas& atlas = *m_atlases[i];
+        if (atlas.format != format) continue;
         
-        // Check if glyph fits in current row
-        bool canFitInCurrentRow = (atlas->currentX + requiredWidth <= atlas->width) &&
-                                  (atlas->currentY + requiredHeight <= atlas->height);
+        uint32_t x = 0, y = 0;
+        if (!atlas.packer.allocate(width + padding * 2, height + padding * 2, x, y)) continue;
         
-        // Check if glyph fits in new row
-        bool canFitInNewRow = (atlas->currentY + atlas->rowHeight + requiredHeight <= atlas->height) &&
-                             (requiredWidth <= atlas->width);
-        
-        if (canFitInCurrentRow || canFitInNewRow)
-        {
-            return atlas.get();
-        }
-        else
-        {
-            // Mark atlas as full if glyph cannot fit
-            atlas->isFull = true;
-        }
+        ++atlas.glyphCount;
+        outAtlasIndex = static_cast<uint32_t>(i);
+        outRect = Rect(static_cast<float>(x + padding), static_cast<float>(y + padding),
+                       static_cast<float>(width), static_cast<float>(height));
+        return true;
     }
     
-    return nullptr;
+    return false;
 }
 
-void GlyphCache::addGlyphToAtlas(GlyphAtlas* atlas, uint32_t width, uint32_t height, Rect& outRect) {
-    if (!atlas || atlas->isFull) return;
+void GlyphCache::releaseGlyph(const GlyphCacheEntry& entry)
+{
+    if (entry.textureRect.width <= 0.0f || entry.textureRect.height <= 0.0f) return;
+    if (entry.atlasIndex >= m_atlases.size()) return;
     
-    // Calculate required space including padding
-    uint32_t requiredWidth = width + Config::GlyphCache::GLYPH_PADDING * 2;
-    uint32_t requiredHeight = height + Config::GlyphCache::GLYPH_PADDING * 2;
+    const uint32_t padding = Config::GlyphCache::GLYPH_PADDING;
+    GlyphAtlas& atlas = *m_atlases[entry.atlasIndex];
     
-    // Check if glyph fits in current row
-    bool canFitInCurrentRow = (atlas->currentX + requiredWidth <= atlas->width) &&
-                             (atlas->currentY + requiredHeight <= atlas->height);
+    atlas.packer.free(static_cast<uint32_t>(entry.textureRect.x) - padding,
+                      static_cast<uint32_t>(entry.textureRect.y) - padding,
+                      static_cast<uint32_t>(entry.textureRect.width) + padding * 2,
+                      static_cast<uint32_t>(entry.textureRect.height) + padding * 2);
     
-    if (!canFitInCurrentRow)
-    {
-        // Advance to new row
-        atlas->currentX = 0;
-        atlas->currentY += atlas->rowHeight;
-        atlas->rowHeight = 0;
-    }
+    YUCHEN_ASSERT(atlas.glyphCount > 0);
+    --atlas.glyphCount;
+}
+
+AtlasRegion GlyphCache::copyGlyphBitmap(GlyphAtlas* atlas, const Rect& rect, const void* bitmapData)
+{
+    YUCHEN_ASSERT(atlas != nullptr);
+    
+    const uint32_t padding = Config::GlyphCache::GLYPH_PADDING;
+    const uint32_t glyphX = static_cast<uint32_t>(rect.x);
+    const uint32_t glyphY = static_cast<uint32_t>(rect.y);
+    const uint32_t glyphWidth = static_cast<uint32_t>(rect.width);
+    const uint32_t glyphHeight = static_cast<uint32_t>(rect.height);
+    
+    // Clear the padded cell: the space may have held another glyph
+    const AtlasRegion cell{ glyphX - padding, glyphY - padding, glyphWidth + padding * 2, glyphHeight + padding * 2 };
     
-    // Set output rectangle (excluding padding)
-    outRect.x = static_cast<float>(atlas->currentX + Config::GlyphCache::GLYPH_PADDING);
-    outRect.y = static_cast<float>(atlas->currentY + Config::GlyphCache::GLYPH_PADDING);
-    outRect.width = static_cast<float>(width);
-    outRect.height = static_cast<float>(height);
+    for (uint32_t row = 0; row < cell.height; ++row)
+        std::fill_n(atlas->pixels.data() + static_cast<size_t>(cell.y + row) * atlas->width + cell.x, cell.width, uint8_t(0));
     
-    // Update packing state
-    atlas->currentX += requiredWidth;
-    atlas->rowHeight = std::max(atlas->rowHeight, requiredHeight);
+    const uint8_t* src = static_cast<const uint8_t*>(bitmapData);
+    for (uint32_t row = 0; row < glyphHeight; ++row)
+        std::memcpy(atlas->pixels.data() + static_cast<size_t>(glyphY + row) * atlas->width + glyphX,
+                    src + static_cast<size_t>(row) * glyphWidth, glyphWidth);
+    
+    return cell;
 }
 
-void GlyphCache::uploadGlyphBitmap(GlyphAtlas* atlas, const Rect& rect, const void* bitmapData)
+void GlyphCache::writeGlyphBitmap(GlyphAtlas* atlas, const Rect& rect, const void* bitmapData)
 {
     if (!rect.isValid()) return;
     
-    YUCHEN_ASSERT(atlas != nullptr);
+    markDirty(*atlas, copyGlyphBitmap(atlas, rect, bitmapData));
+    ++m_uploadStats.glyphsWritten;
+}
+
+void GlyphCache::markDirty(GlyphAtlas& atlas, AtlasRegion region)
+{
+    // Absorb regions the new one overlaps or nearly fills a box with. The grown region
+    // may now reach others, so scan again until nothing merges.
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (size_t i = 0; i < atlas.dirty.size(); ++i)
+        {
+            const AtlasRegion& other = atlas.dirty[i];
+            const AtlasRegion box = unite(region, other);
+            const double limit = static_cast<double>(region.area() + other.area()) * Config::GlyphCache::DIRTY_MERGE_SLACK;
+            if (!overlaps(region, other) && static_cast<double>(box.area()) > limit) continue;
+            
+            region = box;
+            atlas.dirty[i] = atlas.dirty.back();
+            atlas.dirty.pop_back();
+            merged = true;
+            break;
+        }
+    }
+    
+    atlas.dirty.push_back(region);
+    
+    // Too many scattered regions cost more in calls than the bytes between them
+    if (atlas.dirty.size() > Config::GlyphCache::MAX_DIRTY_REGIONS)
+    {
+        AtlasRegion all = atlas.dirty.front();
+        for (const AtlasRegion& other : atlas.dirty) all = unite(all, other);
+        atlas.dirty.assign(1, all);
+    }
+}
+
+void GlyphCache::uploadAtlasRegion(GlyphAtlas* atlas, const AtlasRegion& region)
+{
     YUCHEN_ASSERT(atlas->textureHandle != nullptr);
     
-    // Upload glyph bitmap to GPU texture
+    // Upload from the CPU copy (R8 = 1 byte per pixel, rows are atlas width apart)
     m_backend->updateTexture2D(
         atlas->textureHandle,
-        static_cast<uint32_t>(rect.x),
-        static_cast<uint32_t>(rect.y),
-        static_cast<uint32_t>(rect.width),
-        static_cast<uint32_t>(rect.height),
-        bitmapData,
-        static_cast<size_t>(rect.width)  // Bytes per row (R8 = 1 byte per pixel)
+        region.x, region.y, region.width, region.height,
+        atlas->pixels.data() + static_cast<size_t>(region.y) * atlas->width + region.x,
+        atlas->width
     );
+    
+    ++m_uploadStats.uploadCount;
+    m_uploadStats.uploadBytes += region.area();
+}
+
+void GlyphCache::flushUploads()
+{
+    bool uploaded = false;
+    for (auto& atlas : m_atlases)
+    {
+        if (atlas->dirty.empty()) continue;
+        
+        for (const AtlasRegion& region : atlas->dirty) uploadAtlasRegion(atlas.get(), region);
+        atlas->dirty.clear();
+        uploaded = true;
+    }
+    
+    if (uploaded) ++m_uploadStats.flushCount;
+}
+
+bool GlyphCache::hasPendingUploads() const
+{
+    for (const auto& atlas : m_atlases)
+        if (!atlas->dirty.empty()) return true;
+    return false;
+}
+
+void GlyphCache::resetUploadStats()
+{
+    m_uploadStats = GlyphUploadStats();
 }
 
 //==========================================================================================
@@ -232,8 +347,9 @@ const GlyphCacheEntry* GlyphCache::getGlyph(const GlyphKey& key)
     auto it = m_glyphCache.find(key);
     if (it != m_glyphCache.end())
     {
-        // Mark as used in current frame for LRU tracking
+        // Mark as used in current frame for LRU tracking; a prewarm pin ends at first use
         it->second.markUsed(m_currentFrame);
+        it->second.isPinned = false;
         return &it->second;
     }
     
@@ -247,6 +363,9 @@ void GlyphCache::cacheGlyph(const GlyphKey& key, const void* bitmapData, const V
     if (!size.isValid() || !bearing.isValid()) return;
     if (advance < 0.0f) return;
     
+    // Replacing an entry gives its space back first
+    removeGlyph(key);
+    
     // Check if glyph is empty (zero-size bitmap)
     bool isEmptyGlyph = (bitmapData == nullptr) || (size.x <= 0.0f) || (size.y <= 0.0f);
     
@@ -275,36 +394,41 @@ void GlyphCache::cacheGlyph(const GlyphKey& key, const void* bitmapData, const V
     if (width > atlasWidth - Config::GlyphCache::GLYPH_PADDING * 2) return;
     if (height > atlasHeight - Config::GlyphCache::GLYPH_PADDING * 2) return;
     
-    // Find atlas with space
-    GlyphAtlas* atlas = findAtlasWithSpace(width, height);
+    // Find atlas of the glyph's format with space
+    const TextureFormat format = key.format == GlyphFormat::SignedDistance ? TextureFormat::R8_DistanceField
+                                                                           : TextureFormat::R8_Unorm;
+    uint32_t atlasIndex = 0;
+    Rect textureRect;
+    bool allocated = allocateGlyph(format, width, height, atlasIndex, textureRect);
     
-    if (!atlas)
+    if (!allocated && m_atlases.size() < Config::GlyphCache::MAX_ATLASES)
     {
         // Create new atlas if under limit
-        if (m_atlases.size() < Config::GlyphCache::MAX_ATLASES)
-        {
-            createNewAtlas();
-            atlas = m_atlases.back().get();
-        }
-        else
-        {
-            // Atlas limit reached - cleanup and retry
-            cleanupExpiredGlyphs();
-            atlas = findAtlasWithSpace(width, height);
-            if (!atlas) return;  // Still no space after cleanup
-        }
+        createNewAtlas(format);
+        allocated = allocateGlyph(format, width, height, atlasIndex, textureRect);
     }
     
-    // Allocate space in atlas
-    Rect textureRect;
-    addGlyphToAtlas(atlas, width, height, textureRect);
+    if (!allocated)
+    {
+        // Atlas limit reached - free expired glyphs and retry
+        cleanupExpiredGlyphs();
+        allocated = allocateGlyph(format, width, height, atlasIndex, textureRect);
+    }
+    
+    if (!allocated)
+    {
+        // Everything left is in recent use; make room at the start of the next frame
+        m_atlasPressure = true;
+        return;
+    }
     
-    // Upload bitmap to GPU
-    uploadGlyphBitmap(atlas, textureRect, bitmapData);
+    // Write bitmap to the atlas copy; flushUploads() sends it to the GPU
+    writeGlyphBitmap(m_atlases[atlasIndex].get(), textureRect, bitmapData);
     
     // Create cache entry
     GlyphCacheEntry entry;
     entry.textureRect = textureRect;
+    entry.atlasIndex = atlasIndex;
     entry.bearing = bearing;
     entry.advance = advance;
     entry.lastUsedFrame = m_currentFrame;
@@ -313,6 +437,15 @@ void GlyphCache::cacheGlyph(const GlyphKey& key, const void* bitmapData, const V
     m_glyphCache[key] = entry;
 }
 
+bool GlyphCache::pinGlyph(const GlyphKey& key)
+{
+    auto it = m_glyphCache.find(key);
+    if (it == m_glyphCache.end()) return false;
+    
+    it->second.isPinned = true;
+    return true;
+}
+
 //==========================================================================================
 // Frame Management
 
@@ -322,19 +455,29 @@ void GlyphCache::beginFrame()
     
     m_currentFrame++;
     
-    // Run cleanup periodically
-    if (m_currentFrame % Config::GlyphCache::CLEANUP_INTERVAL_FRAMES == 0)
+    // Run cleanup periodically, or at once if a glyph was dropped for lack of space
+    const bool periodic = (m_currentFrame % Config::GlyphCache::CLEANUP_INTERVAL_FRAMES == 0);
+    
+    if (m_atlasPressure)
+        cleanupExpiredGlyphs(1, true);
+    else if (periodic)
         cleanupExpiredGlyphs();
+    
+    if (m_atlasPressure || periodic) defragmentAtlases();
+    m_atlasPressure = false;
+    
+    flushUploads();
 }
 
-void GlyphCache::cleanupExpiredGlyphs()
+void GlyphCache::cleanupExpiredGlyphs(uint32_t expireFrames, bool evictPinned)
 {
     // Collect keys of expired glyphs
     std::vector<GlyphKey> keysToRemove;
     keysToRemove.reserve(m_glyphCache.size() / 4);
     
     for (const auto& pair : m_glyphCache) {
-        if (pair.second.isExpired(m_currentFrame, Config::GlyphCache::GLYPH_EXPIRE_FRAMES))
+        if (pair.second.isPinned && !evictPinned) continue;
+        if (pair.second.isExpired(m_currentFrame, expireFrames))
         {
             keysToRemove.push_back(pair.first);
         }
@@ -361,7 +504,208 @@ void GlyphCache::clearAllGlyphs()
 void GlyphCache::removeGlyph(const GlyphKey& key)
 {
     auto it = m_glyphCache.find(key);
-    if (it != m_glyphCache.end()) m_glyphCache.erase(it);
+    if (it == m_glyphCache.end()) return;
+    
+    releaseGlyph(it->second);
+    m_glyphCache.erase(it);
+}
+
+//==========================================================================================
+// Defragmentation
+
+void GlyphCache::defragmentAtlases()
+{
+    for (size_t i = 0; i < m_atlases.size(); ++i)
+    {
+        const GlyphAtlas& atlas = *m_atlases[i];
+        if (atlas.glyphCount == 0) continue;
+        
+        const bool fragmented = atlas.packer.getFragmentation() > Config::GlyphCache::DEFRAG_THRESHOLD;
+        const bool worthIt = atlas.packer.getShelfTop() >= atlas.height * Config::GlyphCache::DEFRAG_MIN_COVERAGE;
+        if (fragmented && worthIt) repackAtlas(static_cast<uint32_t>(i));
+    }
+}
+
+void GlyphCache::repackAtlas(uint32_t atlasIndex)
+{
+    GlyphAtlas& atlas = *m_atlases[atlasIndex];
+    const uint32_t padding = Config::GlyphCache::GLYPH_PADDING;
+    
+    // Live glyphs of this atlas, tallest first so shelves fill evenly
+    using EntryIterator = decltype(m_glyphCache)::iterator;
+    std::vector<EntryIterator> live;
+    live.reserve(atlas.glyphCount);
+    
+    for (auto it = m_glyphCache.begin(); it != m_glyphCache.end(); ++it)
+    {
+        const GlyphCacheEntry& entry = it->second;
+        if (entry.atlasIndex == atlasIndex && entry.textureRect.width > 0.0f && entry.textureRect.height > 0.0f)
+            live.push_back(it);
+    }
+    
+    std::sort(live.begin(), live.end(), [](const EntryIterator& a, const EntryIterator& b) {
+        if (a->second.textureRect.height != b->second.textureRect.height)
+            return a->second.textureRect.height > b->second.textureRect.height;
+        return a->second.textureRect.width > b->second.textureRect.width;
+    });
+    
+    std::vector<uint8_t> pixels(atlas.pixels.size(), 0);
+    atlas.reset();
+    
+    std::vector<GlyphKey> lost;
+    for (const EntryIterator& it : live)
+    {
+        GlyphCacheEntry& entry = it->second;
+        const uint32_t width = static_cast<uint32_t>(entry.textureRect.width);
+        const uint32_t height = static_cast<uint32_t>(entry.textureRect.height);
+        
+        uint32_t x = 0, y = 0;
+        if (!atlas.packer.allocate(width + padding * 2, height + padding * 2, x, y))
+        {
+            lost.push_back(it->first);
+            continue;
+        }
+        
+        const uint32_t srcX = static_cast<uint32_t>(entry.textureRect.x);
+        const uint32_t srcY = static_cast<uint32_t>(entry.textureRect.y);
+        x += padding;
+        y += padding;
+        
+        for (uint32_t row = 0; row < height; ++row)
+            std::memcpy(pixels.data() + static_cast<size_t>(y + row) * atlas.width + x,
+                        atlas.pixels.data() + static_cast<size_t>(srcY + row) * atlas.width + srcX, width);
+        
+        entry.textureRect = Rect(static_cast<float>(x), static_cast<float>(y),
+                                 static_cast<float>(width), static_cast<float>(height));
+        ++atlas.glyphCount;
+    }
+    
+    // Glyphs that no longer fit are re-rasterized on next use
+    for (const GlyphKey& key : lost) m_glyphCache.erase(key);
+    
+    atlas.pixels.swap(pixels);
+    atlas.dirty.assign(1, AtlasRegion{ 0, 0, atlas.width, atlas.height });
+}
+
+//==========================================================================================
+// Cache Files
+
+void GlyphCache::save(TextCacheWriter& writer) const
+{
+    using EntryIterator = decltype(m_glyphCache)::const_iterator;
+    std::vector<EntryIterator> glyphs;
+    glyphs.reserve(m_glyphCache.size());
+    for (auto it = m_glyphCache.begin(); it != m_glyphCache.end(); ++it) glyphs.push_back(it);
+    
+    std::sort(glyphs.begin(), glyphs.end(), [](const EntryIterator& a, const EntryIterator& b) {
+        if (a->first.format != b->first.format) return a->first.format < b->first.format;
+        if (a->second.textureRect.height != b->second.textureRect.height)
+            return a->second.textureRect.height > b->second.textureRect.height;
+        return a->second.textureRect.width > b->second.textureRect.width;
+    });
+    
+    writer.write(static_cast<uint32_t>(glyphs.size()));
+    for (const EntryIterator& it : glyphs)
+    {
+        const GlyphKey& key = it->first;
+        const GlyphCacheEntry& entry = it->second;
+        const uint32_t width = static_cast<uint32_t>(entry.textureRect.width);
+        const uint32_t height = static_cast<uint32_t>(entry.textureRect.height);
+        
+        writer.write(static_cast<uint64_t>(key.fontHandle));
+        writer.write(key.glyphIndex);
+        writer.write(key.quantizedSize);
+        writer.write(key.boldness);
+        writer.write(static_cast<uint32_t>(key.format));
+        writer.write(entry.bearing.x);
+        writer.write(entry.bearing.y);
+        writer.write(entry.advance);
+        writer.write(width);
+        writer.write(height);
+        
+        if (width == 0 || height == 0) continue;
+        
+        const GlyphAtlas& atlas = *m_atlases[entry.atlasIndex];
+        const uint32_t x = static_cast<uint32_t>(entry.textureRect.x);
+        const uint32_t y = static_cast<uint32_t>(entry.textureRect.y);
+        for (uint32_t row = 0; row < height; ++row)
+            writer.writeBytes(atlas.pixels.data() + static_cast<size_t>(y + row) * atlas.width + x, width);
+    }
+}
+
+bool GlyphCache::load(TextCacheReader& reader, const std::function<bool(FontHandle)>& acceptFont, size_t& outAdopted)
+{
+    outAdopted = 0;
+    if (!m_isInitialized) return false;
+    
+    uint32_t count = 0;
+    if (!reader.read(count)) return false;
+    
+    const uint32_t maxWidth = getAtlasWidth() - Config::GlyphCache::GLYPH_PADDING * 2;
+    const uint32_t maxHeight = getAtlasHeight() - Config::GlyphCache::GLYPH_PADDING * 2;
+    std::vector<bool> touched(Config::GlyphCache::MAX_ATLASES, false);
+    bool valid = true;
+    
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint64_t fontHandle = 0;
+        uint32_t format = 0, width = 0, height = 0;
+        GlyphKey key(INVALID_FONT_HANDLE, 0, 0.0f);
+        GlyphCacheEntry entry;
+        
+        valid = reader.read(fontHandle) && reader.read(key.glyphIndex) && reader.read(key.quantizedSize)
+             && reader.read(key.boldness) && reader.read(format) && reader.read(entry.bearing.x)
+             && reader.read(entry.bearing.y) && reader.read(entry.advance) && reader.read(width)
+             && reader.read(height);
+        if (!valid) break;
+        
+        const uint8_t* bitmap = reader.readBytes(static_cast<size_t>(width) * height);
+        valid = bitmap != nullptr && format <= static_cast<uint32_t>(GlyphFormat::SignedDistance);
+        if (!valid) break;
+        
+        key.fontHandle = static_cast<FontHandle>(fontHandle);
+        key.format = static_cast<GlyphFormat>(format);
+        if (!acceptFont(key.fontHandle) || m_glyphCache.count(key) != 0) continue;
+        if (width > maxWidth || height > maxHeight) continue;
+        
+        entry.lastUsedFrame = m_currentFrame;
+        entry.isValid = true;
+        
+        if (width != 0 && height != 0)
+        {
+            const TextureFormat atlasFormat = key.format == GlyphFormat::SignedDistance ? TextureFormat::R8_DistanceField
+                                                                                        : TextureFormat::R8_Unorm;
+            uint32_t atlasIndex = 0;
+            Rect textureRect;
+            bool allocated = allocateGlyph(atlasFormat, width, height, atlasIndex, textureRect);
+            if (!allocated && m_atlases.size() < Config::GlyphCache::MAX_ATLASES)
+            {
+                createNewAtlas(atlasFormat);
+                allocated = allocateGlyph(atlasFormat, width, height, atlasIndex, textureRect);
+            }
+            if (!allocated) continue;
+            
+            copyGlyphBitmap(m_atlases[atlasIndex].get(), textureRect, bitmap);
+            ++m_uploadStats.glyphsWritten;
+            touched[atlasIndex] = true;
+            
+            entry.textureRect = textureRect;
+            entry.atlasIndex = atlasIndex;
+        }
+        
+        m_glyphCache[key] = entry;
+        ++outAdopted;
+    }
+    
+    // One region per atlas covering its shelves, instead of a region per glyph
+    for (size_t i = 0; i < m_atlases.size(); ++i)
+    {
+        if (!touched[i]) continue;
+        GlyphAtlas& atlas = *m_atlases[i];
+        markDirty(atlas, AtlasRegion{ 0, 0, atlas.width, atlas.packer.getShelfTop() });
+    }
+    
+    return valid;
 }
 
 //==========================================================================================
@@ -373,4 +717,46 @@ void* GlyphCache::getCurrentAtlasTexture() const
     return m_atlases[m_currentAtlasIndex]->textureHandle;
 }
 
+void* GlyphCache::getAtlasTexture(size_t atlasIndex) const
+{
+    if (atlasIndex >= m_atlases.size()) return nullptr;
+    return m_atlases[atlasIndex]->textureHandle;
+}
+
+TextureFormat GlyphCache::getAtlasFormat(size_t atlasIndex) const
+{
+    YUCHEN_ASSERT(atlasIndex < m_atlases.size());
+    return m_atlases[atlasIndex]->format;
+}
+
+Vec2 GlyphCache::getAtlasSize(size_t atlasIndex) const
+{
+    if (atlasIndex >= m_atlases.size()) return Vec2();
+    
+    const auto& atlas = m_atlases[atlasIndex];
+    return Vec2(static_cast<float>(atlas->width), static_cast<float>(atlas->height));
+}
+
+size_t GlyphCache::getAtlasCount() const
+{
+    return m_atlases.size();
+}
+
+size_t GlyphCache::getGlyphCount() const
+{
+    return m_glyphCache.size();
+}
+
+float GlyphCache::getAtlasFragmentation(size_t atlasIndex) const
+{
+    YUCHEN_ASSERT(atlasIndex < m_atlases.size());
+    return m_atlases[atlasIndex]->packer.getFragmentation();
+}
+
+const std::vector<uint8_t>& GlyphCache::getAtlasPixels(size_t atlasIndex) const
+{
+    YUCHEN_ASSERT(atlasIndex < m_atlases.size());
+    return m_atlases[atlasIndex]->pixels;
+}
+
 } // namespace YuchenUI
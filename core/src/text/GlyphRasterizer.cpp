@@ -0,0 +1,384 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file GlyphRasterizer.cpp
+
+    Implementation notes:
+    - Each pool worker index owns one FT_Library and a face per font, keyed by the font
+      bytes' address and opened with FT_New_Memory_Face on first use
+    - WorkerPool indices are stable for one parallelFor, and m_poolMutex keeps a single
+      batch on the pool, so a worker's FreeType state is never touched by two threads
+    - Bitmaps are copied out row by row using the FreeType pitch
+    - Distance fields use the exact Euclidean distance transform of Felzenszwalb and
+      Huttenlocher, run once for the outside and once for the inside of the glyph. Partly
+      covered pixels seed both grids with their sub-pixel distance to the 50% edge
+    - The dispatcher thread drains the queue in batches; results wait in m_completed until
+      the owning thread collects them
+*/
+
+#include "YuchenUI/text/GlyphRasterizer.h"
+#include "YuchenUI/utils/WorkerPool.h"
+#include "YuchenUI/core/Assert.h"
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_OUTLINE_H
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace YuchenUI {
+
+namespace {
+
+constexpr float DISTANCE_INF = 1e20f;
+
+/** Squared distance transform of one row or column of grid, in place. */
+void distanceTransform1D(float* grid, size_t offset, size_t stride, size_t length,
+                         std::vector<float>& f, std::vector<float>& z, std::vector<int>& v)
+{
+    v[0] = 0;
+    z[0] = -DISTANCE_INF;
+    z[1] = DISTANCE_INF;
+    f[0] = grid[offset];
+
+    // Lower envelope of the parabolas rooted at each sample
+    int k = 0;
+    for (size_t q = 1; q < length; ++q)
+    {
+        f[q] = grid[offset + q * stride];
+        const float qf = static_cast<float>(q);
+
+        float s = 0.0f;
+        do
+        {
+            const float r = static_cast<float>(v[k]);
+            s = (f[q] - f[v[k]] + qf * qf - r * r) / (qf - r) / 2.0f;
+        } while (s <= z[k] && --k > -1);
+
+        ++k;
+        v[k] = static_cast<int>(q);
+        z[k] = s;
+        z[k + 1] = DISTANCE_INF;
+    }
+
+    k = 0;
+    for (size_t q = 0; q < length; ++q)
+    {
+        while (z[k + 1] < static_cast<float>(q)) ++k;
+        const float qr = static_cast<float>(q) - static_cast<float>(v[k]);
+        grid[offset + q * stride] = f[v[k]] + qr * qr;
+    }
+}
+
+/** Squared Euclidean distance transform of a width x height grid, in place. */
+void distanceTransform2D(std::vector<float>& grid, uint32_t width, uint32_t height)
+{
+    const size_t length = std::max(width, height);
+    std::vector<float> f(length);
+    std::vector<float> z(length + 1);
+    std::vector<int> v(length);
+
+    for (uint32_t x = 0; x < width; ++x) distanceTransform1D(grid.data(), x, width, height, f, z, v);
+    for (uint32_t y = 0; y < height; ++y) distanceTransform1D(grid.data(), static_cast<size_t>(y) * width, 1, width, f, z, v);
+}
+
+} // namespace
+
+//==========================================================================================
+// Worker State
+
+struct GlyphRasterizer::WorkerState {
+    FT_Library library = nullptr;
+    std::unordered_map<const void*, FT_Face> faces;
+
+    ~WorkerState()
+    {
+        for (auto& pair : faces) FT_Done_Face(pair.second);
+        if (library) FT_Done_FreeType(library);
+    }
+
+    FT_Face faceFor(const GlyphRasterJob& job)
+    {
+        auto it = faces.find(job.fontData);
+        if (it != faces.end()) return it->second;
+
+        if (!library && FT_Init_FreeType(&library) != FT_Err_Ok) return nullptr;
+
+        FT_Face face = nullptr;
+        FT_Error error = FT_New_Memory_Face(library, static_cast<const FT_Byte*>(job.fontData),
+                                            static_cast<FT_Long>(job.fontDataSize), 0, &face);
+        if (error != FT_Err_Ok) return nullptr;
+
+        FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+        faces.emplace(job.fontData, face);
+        return face;
+    }
+};
+
+//==========================================================================================
+// Lifecycle
+
+GlyphRasterizer::GlyphRasterizer(size_t threadCount)
+    : m_threadCount(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+    , m_pool()
+    , m_workers()
+    , m_poolMutex()
+    , m_dispatcher()
+    , m_queueMutex()
+    , m_queueCondition()
+    , m_queued()
+    , m_completed()
+    , m_pending()
+    , m_stopping(false)
+{
+}
+
+GlyphRasterizer::~GlyphRasterizer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_stopping = true;
+    }
+    m_queueCondition.notify_all();
+
+    if (m_dispatcher.joinable()) m_dispatcher.join();
+
+    m_pool.reset();
+    m_workers.clear();
+}
+
+void GlyphRasterizer::ensureWorkers()
+{
+    if (m_pool) return;
+
+    m_pool = std::make_unique<WorkerPool>(m_threadCount);
+    m_workers.resize(m_pool->getThreadCount());
+    for (auto& worker : m_workers) worker = std::make_unique<WorkerState>();
+}
+
+//==========================================================================================
+// Synchronous Batches
+
+void GlyphRasterizer::rasterize(const std::vector<GlyphRasterJob>& jobs, std::vector<RasterizedGlyph>& results)
+{
+    std::lock_guard<std::mutex> lock(m_poolMutex);
+    runBatch(jobs, results);
+}
+
+void GlyphRasterizer::runBatch(const std::vector<GlyphRasterJob>& jobs, std::vector<RasterizedGlyph>& results)
+{
+    results.resize(jobs.size());
+    if (jobs.empty()) return;
+
+    ensureWorkers();
+
+    m_pool->parallelFor(jobs.size(), [&](size_t index, size_t worker) {
+        const GlyphRasterJob& job = jobs[index];
+        RasterizedGlyph& result = results[index];
+        result.key = job.key;
+
+        FT_Face face = m_workers[worker]->faceFor(job);
+        if (!face)
+        {
+            result.isValid = false;
+            return;
+        }
+        rasterizeGlyph(face, job.key, result);
+    });
+}
+
+//==========================================================================================
+// Background Batches
+
+void GlyphRasterizer::submit(const std::vector<GlyphRasterJob>& jobs)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+
+        for (const GlyphRasterJob& job : jobs)
+            if (m_pending.insert(job.key).second) m_queued.push_back(job);
+
+        if (!m_dispatcher.joinable()) m_dispatcher = std::thread(&GlyphRasterizer::dispatcherLoop, this);
+    }
+    m_queueCondition.notify_one();
+}
+
+size_t GlyphRasterizer::collect(std::vector<RasterizedGlyph>& results)
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+
+    const size_t count = m_completed.size();
+    for (RasterizedGlyph& glyph : m_completed)
+    {
+        m_pending.erase(glyph.key);
+        results.push_back(std::move(glyph));
+    }
+    m_completed.clear();
+    return count;
+}
+
+bool GlyphRasterizer::isPending(const GlyphKey& key) const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_pending.count(key) != 0;
+}
+
+size_t GlyphRasterizer::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    return m_pending.size();
+}
+
+void GlyphRasterizer::dispatcherLoop()
+{
+    std::vector<GlyphRasterJob> batch;
+    std::vector<RasterizedGlyph> results;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_queueMutex);
+            m_queueCondition.wait(lock, [this] { return m_stopping || !m_queued.empty(); });
+            if (m_stopping) return;
+            batch.swap(m_queued);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_poolMutex);
+            runBatch(batch, results);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            for (RasterizedGlyph& glyph : results) m_completed.push_back(std::move(glyph));
+        }
+
+        batch.clear();
+        results.clear();
+    }
+}
+
+//==========================================================================================
+// FreeType
+
+bool GlyphRasterizer::rasterizeGlyph(void* face, const GlyphKey& key, RasterizedGlyph& result)
+{
+    YUCHEN_ASSERT_MSG(face != nullptr, "Face cannot be null");
+
+    FT_Face ftFace = static_cast<FT_Face>(face);
+    result.key = key;
+    result.isValid = false;
+    result.bitmap.clear();
+
+    FT_Error error = FT_Set_Char_Size(ftFace, 0, static_cast<FT_F26Dot6>(key.quantizedSize),
+                                      Config::Font::FREETYPE_DPI, Config::Font::FREETYPE_DPI);
+    if (error != FT_Err_Ok) return false;
+
+    error = FT_Load_Glyph(ftFace, key.glyphIndex, FT_LOAD_DEFAULT);
+    if (error != FT_Err_Ok) return false;
+
+    // Bitmap fonts (like Emoji) cannot be emboldened; failure leaves the glyph regular.
+    // Distance fields are emboldened when drawn, so one field serves every weight offset.
+    if (key.boldness > 0 && key.format == GlyphFormat::Coverage && ftFace->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+        FT_Outline_Embolden(&ftFace->glyph->outline, static_cast<FT_Pos>(key.boldness));
+
+    error = FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_NORMAL);
+    if (error != FT_Err_Ok) return false;
+
+    FT_GlyphSlot slot = ftFace->glyph;
+    if (slot->format != FT_GLYPH_FORMAT_BITMAP) return false;
+
+    const uint32_t width = slot->bitmap.width;
+    const uint32_t rows = slot->bitmap.rows;
+    result.bitmap.resize(static_cast<size_t>(width) * rows);
+
+    for (uint32_t row = 0; row < rows; ++row)
+        std::memcpy(result.bitmap.data() + static_cast<size_t>(row) * width,
+                    slot->bitmap.buffer + static_cast<ptrdiff_t>(row) * slot->bitmap.pitch, width);
+
+    result.size = Vec2(static_cast<float>(width), static_cast<float>(rows));
+    result.bearing = Vec2(static_cast<float>(slot->bitmap_left), static_cast<float>(slot->bitmap_top));
+    result.advance = slot->advance.x / 64.0f;
+    result.isValid = true;
+
+    if (key.format == GlyphFormat::SignedDistance && !result.bitmap.empty())
+    {
+        // The field extends SDF_SPREAD pixels past the coverage bitmap on every side
+        const uint32_t spread = Config::GlyphCache::SDF_SPREAD;
+        std::vector<uint8_t> field;
+        makeDistanceField(result.bitmap.data(), width, rows, spread, field);
+
+        result.bitmap.swap(field);
+        result.size = Vec2(static_cast<float>(width + spread * 2), static_cast<float>(rows + spread * 2));
+        result.bearing = Vec2(result.bearing.x - spread, result.bearing.y + spread);
+    }
+
+    return true;
+}
+
+void GlyphRasterizer::makeDistanceField(const uint8_t* coverage, uint32_t width, uint32_t height,
+                                        uint32_t spread, std::vector<uint8_t>& field)
+{
+    YUCHEN_ASSERT(coverage != nullptr || width * height == 0);
+    YUCHEN_ASSERT(spread > 0);
+
+    const uint32_t fieldWidth = width + spread * 2;
+    const uint32_t fieldHeight = height + spread * 2;
+    const size_t count = static_cast<size_t>(fieldWidth) * fieldHeight;
+
+    // Squared distance to the nearest inside (outer grid) and outside (inner grid) point;
+    // the border is outside
+    std::vector<float> outer(count, DISTANCE_INF);
+    std::vector<float> inner(count, 0.0f);
+
+    for (uint32_t y = 0; y < height; ++y)
+    {
+        for (uint32_t x = 0; x < width; ++x)
+        {
+            const uint8_t a = coverage[static_cast<size_t>(y) * width + x];
+            if (a == 0) continue;
+
+            const size_t i = static_cast<size_t>(y + spread) * fieldWidth + x + spread;
+            if (a == 255)
+            {
+                outer[i] = 0.0f;
+                inner[i] = DISTANCE_INF;
+                continue;
+            }
+
+            const float d = 0.5f - a / 255.0f;
+            outer[i] = d > 0.0f ? d * d : 0.0f;
+            inner[i] = d < 0.0f ? d * d : 0.0f;
+        }
+    }
+
+    distanceTransform2D(outer, fieldWidth, fieldHeight);
+    distanceTransform2D(inner, fieldWidth, fieldHeight);
+
+    // Positive outside; spread pixels out maps to 0, spread pixels in maps to 255
+    field.resize(count);
+    const float scale = 0.5f / static_cast<float>(spread);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const float distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+        const float value = std::min(1.0f, std::max(0.0f, 0.5f - distance * scale));
+        field[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+    }
+}
+
+} // namespace YuchenUI
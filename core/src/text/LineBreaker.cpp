@@ -0,0 +1,269 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file LineBreaker.cpp
+
+    Implementation notes:
+    - Only the line break classes that matter for Western and CJK text are told apart:
+      spaces, ideographic, opening, closing and non-starter punctuation, hyphens, dashes
+      and combining characters. Everything else is alphabetic and only breaks at spaces.
+    - Pairs of ASCII codepoints skip the table lookups, so breaking Western text costs a
+      few compares per codepoint
+    - Fitting a line stops at the first codepoint past the width, so breaking a whole
+      paragraph is linear in its length whatever the width
+    - Clusters share their advance evenly between codepoints (see measureCaretStops), so
+      stops never decrease and a run's width is the difference of its end stops
+*/
+
+#include "YuchenUI/text/LineBreaker.h"
+#include "YuchenUI/text/IFontProvider.h"
+#include "YuchenUI/text/TextUtils.h"
+#include "YuchenUI/core/Assert.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace YuchenUI {
+
+namespace {
+
+// Closing punctuation (CL, CP, EX, IS) and non-starters (NS): no break before
+constexpr uint32_t NO_BREAK_BEFORE[] = {
+    0x0021, 0x0025, 0x0029, 0x002C, 0x002E, 0x003A, 0x003B, 0x003F, 0x005D, 0x007D,
+    0x2019, 0x201D, 0x2026, 0x203C, 0x2047, 0x2048, 0x2049,
+    0x3001, 0x3002, 0x3005, 0x3009, 0x300B, 0x300D, 0x300F, 0x3011, 0x3015, 0x3017,
+    0x3019, 0x301B, 0x301E, 0x301F, 0x303B,
+    0x3041, 0x3043, 0x3045, 0x3047, 0x3049, 0x3063, 0x3083, 0x3085, 0x3087, 0x308E,
+    0x3095, 0x3096, 0x309D, 0x309E,
+    0x30A1, 0x30A3, 0x30A5, 0x30A7, 0x30A9, 0x30C3, 0x30E3, 0x30E5, 0x30E7, 0x30EE,
+    0x30F5, 0x30F6, 0x30FB, 0x30FC, 0x30FD, 0x30FE,
+    0xFF01, 0xFF09, 0xFF0C, 0xFF0E, 0xFF1A, 0xFF1B, 0xFF1F, 0xFF3D, 0xFF5D, 0xFF61,
+    0xFF63, 0xFF64, 0xFF65
+};
+
+// Opening punctuation (OP) and opening quotes: no break after
+constexpr uint32_t NO_BREAK_AFTER[] = {
+    0x0028, 0x005B, 0x007B, 0x2018, 0x201C,
+    0x3008, 0x300A, 0x300C, 0x300E, 0x3010, 0x3014, 0x3016, 0x3018, 0x301A, 0x301D,
+    0xFF08, 0xFF3B, 0xFF5B, 0xFF62
+};
+
+template <size_t N>
+bool contains(const uint32_t (&sorted)[N], uint32_t codepoint)
+{
+    return std::binary_search(std::begin(sorted), std::end(sorted), codepoint);
+}
+
+bool isSpace(uint32_t codepoint)
+{
+    return codepoint == ' ' || codepoint == '\t' || codepoint == 0x3000;
+}
+
+bool isHyphen(uint32_t codepoint)
+{
+    return codepoint == '-' || codepoint == 0x2010 || codepoint == 0x2013;
+}
+
+bool isDigit(uint32_t codepoint)
+{
+    return codepoint >= '0' && codepoint <= '9';
+}
+
+bool isRegionalIndicator(uint32_t codepoint)
+{
+    return codepoint >= 0x1F1E6 && codepoint <= 0x1F1FF;
+}
+
+// Attaches to the codepoint before it (CM, ZWJ, emoji modifiers)
+bool isCombining(uint32_t codepoint)
+{
+    return (codepoint >= 0x0300 && codepoint <= 0x036F) ||
+           (codepoint >= 0x1AB0 && codepoint <= 0x1AFF) ||
+           (codepoint >= 0x1DC0 && codepoint <= 0x1DFF) ||
+           (codepoint >= 0x20D0 && codepoint <= 0x20FF) ||
+           (codepoint >= 0x3099 && codepoint <= 0x309A) ||
+           (codepoint >= 0xFE00 && codepoint <= 0xFE0F) ||
+           (codepoint >= 0xFE20 && codepoint <= 0xFE2F) ||
+           (codepoint >= 0x1F3FB && codepoint <= 0x1F3FF) ||
+           (codepoint >= 0xE0020 && codepoint <= 0xE007F) ||
+           (codepoint >= 0xE0100 && codepoint <= 0xE01EF) ||
+           codepoint == 0x200D;
+}
+
+// Breaks are allowed on both sides of these (ID, and H2/H3 for Hangul syllables)
+bool isIdeographic(uint32_t codepoint)
+{
+    if (codepoint < 0x2E80) return false;
+    if (codepoint >= 0xAC00 && codepoint <= 0xD7A3) return true;
+    if (codepoint >= 0x1F000) return TextUtils::isEmojiCharacter(codepoint) || TextUtils::isChineseCharacter(codepoint);
+    if (TextUtils::isChineseCharacter(codepoint)) return true;
+
+    hb_script_t script = TextUtils::detectScript(codepoint);
+    return script == HB_SCRIPT_HIRAGANA || script == HB_SCRIPT_KATAKANA;
+}
+
+bool canBreakBetween(uint32_t before, uint32_t after)
+{
+    if (isCombining(after) || before == 0x200D) return false;
+    if (isSpace(after)) return false;
+    if (isSpace(before)) return true;
+
+    if (before < 0x80 && after < 0x80)
+    {
+        if (after == '-' || contains(NO_BREAK_BEFORE, after) || contains(NO_BREAK_AFTER, before)) return false;
+        return before == '-' && !isDigit(after);
+    }
+
+    if (contains(NO_BREAK_BEFORE, after) || contains(NO_BREAK_AFTER, before)) return false;
+    if (isHyphen(after)) return false;
+    if (isHyphen(before)) return !isDigit(after);
+    if (before == 0x2014) return true;
+    if (isRegionalIndicator(before) && isRegionalIndicator(after)) return false;
+
+    return isIdeographic(before) || isIdeographic(after);
+}
+
+} // namespace
+
+//==========================================================================================
+// Lifecycle
+
+LineBreaker::LineBreaker()
+    : m_text()
+    , m_fontSize(0.0f)
+    , m_codepoints()
+    , m_byteOffsets(1, 0)
+    , m_stops(1, 0.0f)
+    , m_breaks(1, 0)
+    , m_naturalWidth(0.0f)
+    , m_lines()
+    , m_linesWidth(-1.0f)
+{
+}
+
+//==========================================================================================
+// Paragraph
+
+void LineBreaker::setParagraph(const std::string& text, IFontProvider* fontProvider, float fontSize)
+{
+    YUCHEN_ASSERT(fontProvider != nullptr);
+
+    m_text = text;
+    m_fontSize = fontSize;
+    m_lines.clear();
+    m_linesWidth = -1.0f;
+
+    DecodedText decoded;
+    TextUtils::decodeUTF8WithScripts(m_text.data(), m_text.size(), decoded);
+    m_codepoints = std::move(decoded.codepoints);
+    m_byteOffsets = std::move(decoded.byteOffsets);
+
+    // One shaping pass for the whole paragraph. Text after an embedded NUL is not
+    // measured; it gets no width rather than shifting the stops.
+    fontProvider->measureCaretStops(m_text.c_str(), fontSize, m_stops);
+    if (m_stops.empty()) m_stops.push_back(0.0f);
+    m_stops.resize(m_codepoints.size() + 1, m_stops.back());
+
+    findBreakOpportunities(m_codepoints.data(), m_codepoints.size(), m_breaks);
+
+    size_t visibleEnd = m_codepoints.size();
+    while (visibleEnd > 0 && isSpace(m_codepoints[visibleEnd - 1])) --visibleEnd;
+    m_naturalWidth = m_stops[visibleEnd];
+}
+
+void LineBreaker::findBreakOpportunities(const uint32_t* codepoints, size_t count, std::vector<uint8_t>& outBreaks)
+{
+    YUCHEN_ASSERT(codepoints != nullptr || count == 0);
+
+    outBreaks.assign(count + 1, 0);
+    for (size_t i = 1; i < count; ++i)
+    {
+        outBreaks[i] = canBreakBetween(codepoints[i - 1], codepoints[i]) ? 1 : 0;
+
+        // Hyphens starting a word ("-flag", "--mono") stay with it
+        if (outBreaks[i] && isHyphen(codepoints[i - 1]))
+        {
+            size_t first = i - 1;
+            while (first > 0 && isHyphen(codepoints[first - 1])) --first;
+            if (first == 0 || isSpace(codepoints[first - 1])) outBreaks[i] = 0;
+        }
+    }
+}
+
+//==========================================================================================
+// Line Fitting
+
+const std::vector<LineBreakSpan>& LineBreaker::breakLines(float maxWidth)
+{
+    if (maxWidth == m_linesWidth) return m_lines;
+
+    // A paragraph that was on one line and still fits keeps that line
+    const bool wasOneLine = m_linesWidth >= 0.0f && m_lines.size() <= 1;
+    if (!(wasOneLine && m_naturalWidth <= maxWidth)) fitLines(maxWidth);
+
+    m_linesWidth = maxWidth;
+    return m_lines;
+}
+
+void LineBreaker::fitLines(float maxWidth)
+{
+    m_lines.clear();
+
+    const size_t count = m_codepoints.size();
+    size_t start = 0;
+
+    while (start < count)
+    {
+        const float left = m_stops[start];
+        size_t end = start;
+        size_t visibleEnd = start;
+
+        // Take the last break opportunity whose line fits, not counting hanging spaces
+        for (size_t i = start + 1; i <= count; ++i)
+        {
+            if (i < count && !m_breaks[i])
+            {
+                // Visible text is already past the width, so no later break can fit
+                if (m_stops[i] - left > maxWidth && !isSpace(m_codepoints[i - 1])) break;
+                continue;
+            }
+
+            size_t visible = i;
+            while (visible > start && isSpace(m_codepoints[visible - 1])) --visible;
+            if (m_stops[visible] - left > maxWidth) break;
+
+            end = i;
+            visibleEnd = visible;
+        }
+
+        // Nothing fits: break inside the word, keeping marks with their base
+        if (end == start)
+        {
+            end = start + 1;
+            while (end < count && (isCombining(m_codepoints[end]) || m_stops[end + 1] - left <= maxWidth)) ++end;
+
+            visibleEnd = end;
+            while (end < count && isSpace(m_codepoints[end])) ++end;
+            while (visibleEnd > start && isSpace(m_codepoints[visibleEnd - 1])) --visibleEnd;
+        }
+
+        m_lines.emplace_back(m_byteOffsets[start], m_byteOffsets[visibleEnd] - m_byteOffsets[start],
+                             m_stops[visibleEnd] - left);
+        start = end;
+    }
+}
+
+} // namespace YuchenUI
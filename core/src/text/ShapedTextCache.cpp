@@ -0,0 +1,243 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file ShapedTextCache.cpp
+
+    Implementation notes:
+    - Keys hash the text in place, length-prefixed and a word at a time, then avalanche
+    - Key equality compares text, fonts, size and spacing in full, not just the hash
+    - Stored keys view the entry's own copy of the text and fonts; lookups copy nothing
+    - std::list keeps iterators stable, so the index can point straight at entries
+    - Hits splice the entry to the front; eviction pops from the back
+    - Size estimate counts glyph capacity, key bytes, the ShapedText itself, the
+      shared_ptr control block, the list node and the index node
+    - Runs are shrunk to fit before caching so capacity matches the glyph count
+*/
+
+#include "YuchenUI/text/ShapedTextCache.h"
+#include "YuchenUI/core/Assert.h"
+
+#include <cstring>
+#include <iterator>
+
+namespace YuchenUI {
+
+namespace {
+
+//==========================================================================================
+// Key hashing
+
+constexpr uint64_t KEY_SEED = 0xcbf29ce484222325ull;
+constexpr uint64_t KEY_MULTIPLIER = 0x9e3779b97f4a7c15ull;
+
+inline uint64_t mixWord(uint64_t hash, uint64_t word)
+{
+    return (((hash << 5) | (hash >> 59)) ^ word) * KEY_MULTIPLIER;
+}
+
+/** Final avalanche so the low bits used for bucket selection depend on every input bit. */
+inline uint64_t finalize(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+uint64_t hashKey(std::string_view text, const FontHandle* fonts, uint32_t fontCount,
+                 uint32_t fontSizeBits, uint32_t letterSpacingBits)
+{
+    uint64_t hash = mixWord(KEY_SEED, text.size());
+
+    const char* data = text.data();
+    const size_t length = text.size();
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = mixWord(hash, word);
+    }
+
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, length - i);
+    hash = mixWord(hash, tail);
+
+    hash = mixWord(hash, fontCount);
+    for (uint32_t f = 0; f < fontCount; ++f) hash = mixWord(hash, static_cast<uint64_t>(fonts[f]));
+
+    hash = mixWord(hash, (static_cast<uint64_t>(fontSizeBits) << 32) | letterSpacingBits);
+    return finalize(hash);
+}
+
+} // namespace
+
+//==========================================================================================
+// TextCacheKey Implementation
+
+TextCacheKey::TextCacheKey(std::string_view text, const FontFallbackChain& fallbackChain,
+                           float fontSize, float letterSpacing)
+    : text(text)
+    , fonts(fallbackChain.fonts.data())
+    , fontCount(static_cast<uint32_t>(fallbackChain.fonts.size()))
+    , fontSizeBits(0)
+    , letterSpacingBits(0)
+    , hash(0)
+{
+    // Adding zero turns -0 into +0, which shapes identically
+    const float spacing = letterSpacing + 0.0f;
+    std::memcpy(&fontSizeBits, &fontSize, sizeof(fontSizeBits));
+    std::memcpy(&letterSpacingBits, &spacing, sizeof(letterSpacingBits));
+    hash = hashKey(this->text, fonts, fontCount, fontSizeBits, letterSpacingBits);
+}
+
+TextCacheKey::TextCacheKey(const char* text, const FontFallbackChain& fallbackChain,
+                           float fontSize, float letterSpacing)
+    : TextCacheKey(std::string_view(text), fallbackChain, fontSize, letterSpacing)
+{
+}
+
+bool TextCacheKey::operator==(const TextCacheKey& other) const
+{
+    return hash == other.hash
+        && fontSizeBits == other.fontSizeBits
+        && letterSpacingBits == other.letterSpacingBits
+        && fontCount == other.fontCount
+        && text == other.text
+        && (fontCount == 0 || std::memcmp(fonts, other.fonts, fontCount * sizeof(FontHandle)) == 0);
+}
+
+TextCacheKey TextCacheKey::rebased(std::string_view ownedText, const FontHandle* ownedFonts) const
+{
+    YUCHEN_ASSERT(ownedText == text);
+
+    TextCacheKey key = *this;
+    key.text = ownedText;
+    key.fonts = ownedFonts;
+    return key;
+}
+
+//==========================================================================================
+// Lifecycle
+
+ShapedTextCache::ShapedTextCache(size_t byteBudget)
+    : m_entries()
+    , m_index()
+    , m_stats()
+{
+    m_stats.byteBudget = byteBudget;
+}
+
+//==========================================================================================
+// Lookup
+
+ShapedTextRef ShapedTextCache::find(const TextCacheKey& key)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+    {
+        ++m_stats.misses;
+        return nullptr;
+    }
+
+    ++m_stats.hits;
+    if (it->second != m_entries.begin())
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+    return it->second->run;
+}
+
+ShapedTextRef ShapedTextCache::insert(const TextCacheKey& key, ShapedText&& shaped)
+{
+    shaped.glyphs.shrink_to_fit();
+    ShapedTextRef run = std::make_shared<const ShapedText>(std::move(shaped));
+
+    auto existing = m_index.find(key);
+    if (existing != m_index.end()) erase(existing->second);
+
+    const size_t bytes = estimateBytes(key, *run);
+    if (bytes > m_stats.byteBudget) return run;
+
+    evictToFit(bytes);
+
+    // Intern the key bytes in the entry, then point the stored key at them
+    m_entries.push_front(Entry{ key, std::string(key.text), std::vector<FontHandle>(key.fonts, key.fonts + key.fontCount), run, bytes });
+    Entry& entry = m_entries.front();
+    entry.key = key.rebased(entry.text, entry.fonts.data());
+    m_index.emplace(entry.key, m_entries.begin());
+    m_stats.bytesUsed += bytes;
+    m_stats.entryCount = m_entries.size();
+
+    return run;
+}
+
+void ShapedTextCache::clear()
+{
+    m_index.clear();
+    m_entries.clear();
+    m_stats.bytesUsed = 0;
+    m_stats.entryCount = 0;
+}
+
+//==========================================================================================
+// Budget
+
+void ShapedTextCache::setByteBudget(size_t byteBudget)
+{
+    m_stats.byteBudget = byteBudget;
+    evictToFit(0);
+}
+
+void ShapedTextCache::resetStats()
+{
+    m_stats.hits = 0;
+    m_stats.misses = 0;
+    m_stats.evictions = 0;
+}
+
+size_t ShapedTextCache::estimateBytes(const TextCacheKey& key, const ShapedText& shaped)
+{
+    // List node, index node and make_shared control block are each roughly an Entry or
+    // a few pointers; counting them keeps tiny runs from looking free
+    const size_t overhead = sizeof(Entry) + 4 * sizeof(void*)
+                          + sizeof(std::pair<const TextCacheKey, EntryList::iterator>) + 2 * sizeof(void*)
+                          + sizeof(ShapedText) + 2 * sizeof(long);
+
+    return overhead
+         + key.text.size() + 1 + key.fontCount * sizeof(FontHandle)
+         + shaped.glyphs.capacity() * sizeof(ShapedGlyph);
+}
+
+void ShapedTextCache::evictToFit(size_t incomingBytes)
+{
+    while (!m_entries.empty() && m_stats.bytesUsed + incomingBytes > m_stats.byteBudget)
+    {
+        erase(std::prev(m_entries.end()));
+        ++m_stats.evictions;
+    }
+}
+
+void ShapedTextCache::erase(EntryList::iterator it)
+{
+    YUCHEN_ASSERT(m_stats.bytesUsed >= it->bytes);
+
+    m_stats.bytesUsed -= it->bytes;
+    m_index.erase(it->key);
+    m_entries.erase(it);
+    m_stats.entryCount = m_entries.size();
+}
+
+} // namespace YuchenUI
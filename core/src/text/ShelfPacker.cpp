@@ -0,0 +1,238 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file ShelfPacker.cpp
+
+    Implementation notes:
+    - Shelf heights are rounded up to SHELF_HEIGHT_GRANULARITY so glyphs of nearly equal
+      height share shelves
+    - A shelf accepts rectangles down to 1 / SHELF_HEIGHT_TOLERANCE of its height before
+      a new shelf is preferred
+    - Allocated rectangles always sit on their shelf's top edge, so free() finds the shelf
+      by y alone
+    - Free spans stay sorted and adjacent spans merge, so a shelf whose rectangles are all
+      freed is one full-width span again
+*/
+
+#include "YuchenUI/text/ShelfPacker.h"
+#include "YuchenUI/core/Types.h"
+#include "YuchenUI/core/Config.h"
+#include "YuchenUI/core/Assert.h"
+
+#include <algorithm>
+
+namespace YuchenUI {
+
+//==========================================================================================
+// Lifecycle
+
+ShelfPacker::ShelfPacker(uint32_t width, uint32_t height)
+    : m_width(width)
+    , m_height(height)
+    , m_usedArea(0)
+    , m_shelves()
+{
+}
+
+void ShelfPacker::reset()
+{
+    m_shelves.clear();
+    m_usedArea = 0;
+}
+
+//==========================================================================================
+// Allocation
+
+bool ShelfPacker::allocate(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY)
+{
+    if (width == 0 || height == 0 || width > m_width || height > m_height) return false;
+
+    const uint32_t shelfHeight = std::min(shelfHeightFor(height), m_height);
+    const uint32_t maxHeight = static_cast<uint32_t>(shelfHeight * Config::GlyphCache::SHELF_HEIGHT_TOLERANCE);
+
+    auto place = [&](Shelf& shelf) {
+        if (!takeSpan(shelf, width, outX)) return false;
+        outY = shelf.y;
+        shelf.usedWidth += width;
+        m_usedArea += static_cast<uint64_t>(width) * height;
+        return true;
+    };
+
+    auto hasSpan = [width](const Shelf& shelf) {
+        for (const Span& span : shelf.freeSpans)
+            if (span.width >= width) return true;
+        return false;
+    };
+
+    // 1. Best-fitting shelf already in use
+    Shelf* best = nullptr;
+    for (Shelf& shelf : m_shelves)
+    {
+        if (shelf.usedWidth == 0 || shelf.height < height || shelf.height > maxHeight) continue;
+        if (best && shelf.height >= best->height) continue;
+        if (hasSpan(shelf)) best = &shelf;
+    }
+    if (best) return place(*best);
+
+    // 2. New shelf above the highest one
+    const uint32_t top = getShelfTop();
+    if (top + height <= m_height)
+    {
+        m_shelves.push_back(makeShelf(top, std::min(shelfHeight, m_height - top)));
+        return place(m_shelves.back());
+    }
+
+    // 3. Smallest empty shelf that is tall enough, re-cut to this height
+    size_t emptyIndex = m_shelves.size();
+    for (size_t i = 0; i < m_shelves.size(); ++i)
+    {
+        const Shelf& shelf = m_shelves[i];
+        if (shelf.usedWidth != 0 || shelf.height < height) continue;
+        if (emptyIndex == m_shelves.size() || shelf.height < m_shelves[emptyIndex].height) emptyIndex = i;
+    }
+    if (emptyIndex != m_shelves.size())
+    {
+        splitEmptyShelf(emptyIndex, shelfHeight);
+        return place(m_shelves[emptyIndex]);
+    }
+
+    // 4. Any shelf with room, however much height it wastes
+    for (Shelf& shelf : m_shelves)
+        if (shelf.height >= height && hasSpan(shelf)) return place(shelf);
+
+    return false;
+}
+
+void ShelfPacker::free(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    auto it = std::lower_bound(m_shelves.begin(), m_shelves.end(), y,
+                               [](const Shelf& shelf, uint32_t value) { return shelf.y < value; });
+    YUCHEN_ASSERT_MSG(it != m_shelves.end() && it->y == y, "Rectangle was not allocated by this packer");
+    YUCHEN_ASSERT(it->usedWidth >= width);
+
+    Shelf& shelf = *it;
+    auto& spans = shelf.freeSpans;
+
+    auto next = std::lower_bound(spans.begin(), spans.end(), x,
+                                 [](const Span& span, uint32_t value) { return span.x < value; });
+    next = spans.insert(next, Span{ x, width });
+
+    // Merge with the following span, then the preceding one
+    auto following = next + 1;
+    if (following != spans.end() && next->x + next->width == following->x)
+    {
+        next->width += following->width;
+        spans.erase(following);
+    }
+    if (next != spans.begin())
+    {
+        auto preceding = next - 1;
+        if (preceding->x + preceding->width == next->x)
+        {
+            preceding->width += next->width;
+            spans.erase(next);
+        }
+    }
+
+    shelf.usedWidth -= width;
+    m_usedArea -= static_cast<uint64_t>(width) * height;
+
+    if (shelf.usedWidth == 0) coalesceEmptyShelf(static_cast<size_t>(it - m_shelves.begin()));
+}
+
+//==========================================================================================
+// Queries
+
+uint32_t ShelfPacker::getShelfTop() const
+{
+    if (m_shelves.empty()) return 0;
+    return m_shelves.back().y + m_shelves.back().height;
+}
+
+float ShelfPacker::getFragmentation() const
+{
+    const uint32_t top = getShelfTop();
+    if (top == 0) return 0.0f;
+
+    const double shelfArea = static_cast<double>(top) * m_width;
+    return static_cast<float>(1.0 - static_cast<double>(m_usedArea) / shelfArea);
+}
+
+//==========================================================================================
+// Shelf Management
+
+uint32_t ShelfPacker::shelfHeightFor(uint32_t height)
+{
+    const uint32_t granularity = Config::GlyphCache::SHELF_HEIGHT_GRANULARITY;
+    return (height + granularity - 1) / granularity * granularity;
+}
+
+bool ShelfPacker::takeSpan(Shelf& shelf, uint32_t width, uint32_t& outX)
+{
+    for (auto it = shelf.freeSpans.begin(); it != shelf.freeSpans.end(); ++it)
+    {
+        if (it->width < width) continue;
+
+        outX = it->x;
+        it->x += width;
+        it->width -= width;
+        if (it->width == 0) shelf.freeSpans.erase(it);
+        return true;
+    }
+    return false;
+}
+
+void ShelfPacker::splitEmptyShelf(size_t index, uint32_t height)
+{
+    Shelf& shelf = m_shelves[index];
+    YUCHEN_ASSERT(shelf.usedWidth == 0);
+
+    if (shelf.height < height + Config::GlyphCache::SHELF_HEIGHT_GRANULARITY) return;
+
+    Shelf remainder = makeShelf(shelf.y + height, shelf.height - height);
+    shelf.height = height;
+    m_shelves.insert(m_shelves.begin() + static_cast<std::ptrdiff_t>(index) + 1, remainder);
+}
+
+void ShelfPacker::coalesceEmptyShelf(size_t index)
+{
+    if (index + 1 < m_shelves.size() && m_shelves[index + 1].usedWidth == 0)
+    {
+        m_shelves[index].height += m_shelves[index + 1].height;
+        m_shelves.erase(m_shelves.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+    }
+
+    if (index > 0 && m_shelves[index - 1].usedWidth == 0)
+    {
+        m_shelves[index - 1].height += m_shelves[index].height;
+        m_shelves.erase(m_shelves.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+
+    // Empty shelves at the top go back to the unused area
+    while (!m_shelves.empty() && m_shelves.back().usedWidth == 0) m_shelves.pop_back();
+}
+
+ShelfPacker::Shelf ShelfPacker::makeShelf(uint32_t y, uint32_t height) const
+{
+    Shelf shelf;
+    shelf.y = y;
+    shelf.height = height;
+    shelf.usedWidth = 0;
+    shelf.freeSpans.push_back(Span{ 0, m_width });
+    return shelf;
+}
+
+} // namespace YuchenUI
@@ -0,0 +1,130 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file TextCacheFile.cpp
+
+    Implementation notes:
+    - The hash mixes a word at a time like the shaped text cache key hash, so hashing a
+      few megabytes of payload and fonts at startup stays around a millisecond
+    - The header is written byte for byte as the struct; it only has to be read back by
+      the same build on the same machine
+    - The file is written whole through one stream; a save cut short leaves a payload
+      whose size or hash no longer matches, and the file is ignored on the next load
+*/
+
+#include "YuchenUI/text/TextCacheFile.h"
+#include "YuchenUI/core/Assert.h"
+
+#include <fstream>
+
+namespace YuchenUI {
+
+//==========================================================================================
+// Hashing
+
+uint64_t hashCacheBytes(const void* data, size_t size)
+{
+    constexpr uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    auto mix = [](uint64_t hash, uint64_t word) {
+        return (((hash << 5) | (hash >> 59)) ^ word) * multiplier;
+    };
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = mix(0xcbf29ce484222325ull, size);
+
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        hash = mix(hash, word);
+    }
+
+    uint64_t tail = 0;
+    if (i < size) std::memcpy(&tail, bytes + i, size - i);
+    hash = mix(hash, tail);
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+//==========================================================================================
+// Writer
+
+TextCacheWriter::TextCacheWriter(const TextCacheHeader& header)
+    : m_header(header)
+    , m_payload()
+{
+}
+
+void TextCacheWriter::writeBytes(const void* data, size_t size)
+{
+    if (size == 0) return;
+    YUCHEN_ASSERT(data != nullptr);
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_payload.insert(m_payload.end(), bytes, bytes + size);
+}
+
+bool TextCacheWriter::saveToFile(const char* path)
+{
+    YUCHEN_ASSERT(path != nullptr);
+
+    m_header.payloadSize = m_payload.size();
+    m_header.payloadHash = hashCacheBytes(m_payload.data(), m_payload.size());
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) return false;
+
+    file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+    file.write(reinterpret_cast<const char*>(m_payload.data()), static_cast<std::streamsize>(m_payload.size()));
+    return static_cast<bool>(file);
+}
+
+//==========================================================================================
+// Reader
+
+TextCacheReader::TextCacheReader(const uint8_t* data, size_t size)
+    : m_data(data)
+    , m_size(data ? size : 0)
+    , m_offset(0)
+{
+}
+
+bool TextCacheReader::readHeader(TextCacheHeader& outHeader)
+{
+    TextCacheHeader header;
+    if (!read(header)) return false;
+    if (header.magic != TextCacheHeader::MAGIC || header.version != TextCacheHeader::VERSION) return false;
+    if (header.payloadSize != getRemaining()) return false;
+    if (header.payloadHash != hashCacheBytes(m_data + m_offset, getRemaining())) return false;
+
+    outHeader = header;
+    return true;
+}
+
+const uint8_t* TextCacheReader::readBytes(size_t size)
+{
+    if (size > getRemaining()) return nullptr;
+
+    const uint8_t* bytes = m_data + m_offset;
+    m_offset += size;
+    return bytes;
+}
+
+} // namespace YuchenUI
@@ -17,14 +17,15 @@
 /** @file TextRenderer.cpp
     
     Implementation notes:
-    - Text cache key combines text, fonts, and size into 64-bit hash
+    - Shaped runs cached in ShapedTextCache under a byte budget, shared by reference
     - Text segmented by font fallback chain for appropriate font selection
     - HarfBuzz buffer reused across shaping calls for efficiency
     - Kerning disabled via HarfBuzz features (kern=0)
     - Glyph positions scaled by 1/64 (HarfBuzz uses 26.6 fixed-point)
     - DPI scaling applied to font size for glyph rasterization
     - Vertex generation creates quads with texture coordinates
-    - All vertices reference current atlas texture
+    - UVs are normalized against the atlas named by each glyph's cache entry
+    - Quads spanning several atlases are grouped by a stable counting sort on atlas index
     
     Version 2.0 Changes:
     - Added TextCacheKey constructors for fallback chain and legacy APIs
@@ -32,50 +33,52 @@
     - Enhanced text segmentation using TextUtils::segmentTextWithFallback()
     - Improved cache key generation for better hit rates
     - Better support for emoji and symbol rendering
+    
+    Version 2.1 Changes:
+    - Replaced unbounded shaped text map with ShapedTextCache (LRU, byte budget)
+    - Shaping builds the run in place and moves it into the cache; hits share it
+    - Cache lookups build a view key over the caller's text, so a hit allocates nothing
+    
+    Version 2.2 Changes:
+    - Fixed glyphs in a second atlas being sampled with the first atlas's size and texture
+    - Vertex generation reports one TextVertexRange per atlas
+    - Glyph uploads are flushed by the caller once vertices are generated
+    - Glyph misses are collected per run and rasterized in one batch, in parallel when
+      the batch is large, instead of one FreeType call per glyph inside the vertex loop
+    
+    Version 2.3 Changes:
+    - Optional distance field glyphs: keyed once at SDF_REFERENCE_SIZE, quads scaled by
+      the drawn size over the reference size
+    - Segment shaping moved to TextShaper::shapeSegment(), shared with the worker path
+    - shapeTextBatch() segments uncached texts here, shapes all their segments in one
+      parallel batch and combines them exactly as shapeText() does
+    - Cache files: fonts are matched by handle and content hash, glyphs go through
+      GlyphCache::load(), and runs are re-inserted least recently used first so the
+      shaped text cache keeps its order and budget
+    - prewarm() shapes on the calling thread (in parallel through shapeTextBatch()) and
+      only rasterizes in the background; shaping a UI's strings takes microseconds each,
+      rasterizing them is what stalls a first frame
+    - Background results of prewarmed keys wait in m_prewarmReady and are cached a slice
+      per beginFrame(); a draw that misses one of them takes it from there at once.
+      Results of frame-late draw misses are still cached in full on the next frame
 */
 
 #include "YuchenUI/text/TextRenderer.h"
 #include "YuchenUI/text/IFontProvider.h"
 #include "YuchenUI/text/TextUtils.h"
+#include "YuchenUI/text/TextCacheFile.h"
+#include "YuchenUI/rendering/IGraphicsBackend.h"
+#include "YuchenUI/utils/MappedFile.h"
 #include "YuchenUI/core/Validation.h"
 #include "YuchenUI/core/Config.h"
 
-#include <ft2build.h>
-#include FT_FREETYPE_H
-#include FT_OUTLINE_H
 #include <stdexcept>
-#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 
 namespace YuchenUI {
 
-//==========================================================================================
-// TextCacheKey Implementation
-
-TextCacheKey::TextCacheKey(const char* text, const FontFallbackChain& fallbackChain,
-                           float fontSize, float letterSpacing)
-{
-    std::string textStr(text);
-    std::hash<std::string> stringHasher;
-    std::hash<float> floatHasher;
-    std::hash<int> intHasher;
-    
-    // Start with text hash
-    hash = stringHasher(textStr);
-    
-    // XOR with each font in fallback chain
-    for (size_t i = 0; i < fallbackChain.fonts.size(); ++i)
-    {
-        std::hash<FontHandle> fontHasher;
-        hash ^= (fontHasher(fallbackChain.fonts[i]) << (8 + i * 8));
-    }
-    
-    // XOR with font size
-    hash ^= (floatHasher(fontSize) << 24);
-    
-    int quantizedSpacing = static_cast<int>(letterSpacing / 10.0f) * 10;
-    hash ^= (intHasher(quantizedSpacing) << 40);
-}
-
 //==========================================================================================
 // Lifecycle
 
@@ -87,6 +90,28 @@ TextRenderer::TextRenderer(IGraphicsBackend* backend, IFontProvider* fontProvide
     , m_dpiScale(1.0f)
     , m_harfBuzzBuffer(nullptr)
     , m_shapedTextCache()
+    , m_emptyRun(std::make_shared<const ShapedText>())
+    , m_quadAtlases()
+    , m_groupedVertices()
+    , m_discardedRanges()
+    , m_rasterizer()
+    , m_deferGlyphRasterization(false)
+    , m_rasterJobs()
+    , m_rasterKeys()
+    , m_rasterResults()
+    , m_inlineGlyph()
+    , m_shaper()
+    , m_batchKeys()
+    , m_batchTexts()
+    , m_batchSegmentEnds()
+    , m_batchSegments()
+    , m_shapingJobs()
+    , m_shapingResults()
+    , m_glyphFormat(GlyphFormat::Coverage)
+    , m_prewarmKeys()
+    , m_prewarmInline()
+    , m_prewarmReady()
+    , m_prewarmProgress()
 {
     YUCHEN_ASSERT_MSG(backend != nullptr, "IGraphicsBackend cannot be null");
     YUCHEN_ASSERT_MSG(fontProvider != nullptr, "IFontProvider cannot be null");
@@ -124,6 +149,14 @@ void TextRenderer::destroy()
     // Cleanup HarfBuzz buffer
     cleanupResources();
     
+    // Stop rasterization workers before their results lose a home
+    m_rasterizer.reset();
+    m_shaper.reset();
+    m_prewarmKeys.clear();
+    m_prewarmInline.clear();
+    m_prewarmReady.clear();
+    m_prewarmProgress = TextPrewarmProgress();
+    
     // Destroy glyph cache
     if (m_glyphCache)
     {
@@ -159,192 +192,604 @@ void TextRenderer::beginFrame()
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
     
+    // Glyphs finished in the background join the cache before this frame's upload flush
+    if (m_rasterizer && m_glyphCache)
+    {
+        m_rasterResults.clear();
+        m_rasterizer->collect(m_rasterResults);
+        for (RasterizedGlyph& glyph : m_rasterResults)
+        {
+            // Prewarmed glyphs wait for their slice; frame-late misses are on screen already
+            if (m_prewarmKeys.count(glyph.key) == 0)
+            {
+                cacheRasterizedGlyph(glyph);
+                continue;
+            }
+            
+            const GlyphKey key = glyph.key;
+            m_prewarmReady.emplace(key, std::move(glyph));
+        }
+    }
+    
+    if (!m_prewarmKeys.empty() && m_glyphCache) cachePrewarmSlice(Config::Text::PREWARM_GLYPHS_PER_FRAME);
+    
     // Advance glyph cache frame for expiration tracking
     if (m_glyphCache) m_glyphCache->beginFrame();
 }
 
+void TextRenderer::flushGlyphUploads()
+{
+    if (m_glyphCache) m_glyphCache->flushUploads();
+}
+
+const GlyphUploadStats& TextRenderer::getGlyphUploadStats() const
+{
+    static const GlyphUploadStats empty;
+    return m_glyphCache ? m_glyphCache->getUploadStats() : empty;
+}
+
+void TextRenderer::resetGlyphUploadStats()
+{
+    if (m_glyphCache) m_glyphCache->resetUploadStats();
+}
+
 //==========================================================================================
 // Text Shaping (New API with Font Fallback)
 
 void TextRenderer::shapeText(const char* text, const FontFallbackChain& fallbackChain, float fontSize, float letterSpacing, ShapedText& outShapedText)
+{
+    outShapedText = *shapeText(text, fallbackChain, fontSize, letterSpacing);
+}
+
+ShapedTextRef TextRenderer::shapeText(const char* text, const FontFallbackChain& fallbackChain, float fontSize, float letterSpacing)
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
     YUCHEN_ASSERT_MSG(text != nullptr, "Text cannot be null");
     YUCHEN_ASSERT_MSG(!fallbackChain.isEmpty(), "Fallback chain is empty");
     YUCHEN_ASSERT_MSG(fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE,"Font size out of range");
     
-    outShapedText.clear();
-    
     // Validate text length
     size_t textLength = strlen(text);
-    if (textLength == 0 || textLength > Config::Text::MAX_LENGTH) return;
+    if (textLength == 0 || textLength > Config::Text::MAX_LENGTH) return m_emptyRun;
     
     // Clamp letter spacing to reasonable range
     letterSpacing = std::max(-1000.0f, std::min(1000.0f, letterSpacing));
     
     // Check shaped text cache with letter spacing
-    TextCacheKey cacheKey(text, fallbackChain, fontSize, letterSpacing);
-    auto it = m_shapedTextCache.find(cacheKey);
-    if (it != m_shapedTextCache.end())
-    {
-        outShapedText = it->second;
-        return;
-    }
+    TextCacheKey cacheKey(std::string_view(text, textLength), fallbackChain, fontSize, letterSpacing);
+    if (ShapedTextRef cached = m_shapedTextCache.find(cacheKey)) return cached;
+    
+    ShapedText shaped;
+    if (!shapeUncached(text, fallbackChain, fontSize, letterSpacing, shaped)) return m_emptyRun;
     
+    // Cache shaped result
+    return m_shapedTextCache.insert(cacheKey, std::move(shaped));
+}
+
+bool TextRenderer::shapeUncached(const char* text, const FontFallbackChain& fallbackChain, float fontSize, float letterSpacing, ShapedText& outShapedText)
+{
     // Segment text by font fallback chain (per-character font selection)
     std::vector<TextSegment> segments = TextUtils::segmentTextWithFallback(text,fallbackChain,m_fontProvider);
     
-    if (segments.empty()) return;
+    if (segments.empty()) return false;
     
-    float totalAdvance = 0.0f;
-    float maxHeight = fontSize;
+    outShapedText.clear();
+    outShapedText.totalSize = Vec2(0.0f, fontSize);
     
     // Shape each segment and combine results with letter spacing
     for (const auto& segment : segments)
     {
         ShapedText segmentShaped;
         if (shapeTextWithHarfBuzz(segment.text.c_str(), segment.fontHandle, fontSize, letterSpacing, segmentShaped))
+            appendSegment(outShapedText, segmentShaped);
+    }
+    
+    outShapedText.totalSize.x = outShapedText.totalAdvance;
+    return true;
+}
+
+size_t TextRenderer::shapeTextBatch(const std::vector<TextShapeRequest>& requests)
+{
+    YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
+    
+    m_batchKeys.clear();
+    m_batchTexts.clear();
+    
+    // Uncached texts, once each
+    for (size_t i = 0; i < requests.size(); ++i)
+    {
+        const TextShapeRequest& request = requests[i];
+        YUCHEN_ASSERT_MSG(request.text != nullptr, "Text cannot be null");
+        YUCHEN_ASSERT_MSG(request.fallbackChain != nullptr && !request.fallbackChain->isEmpty(), "Fallback chain is empty");
+        YUCHEN_ASSERT_MSG(request.fontSize >= Config::Font::MIN_SIZE && request.fontSize <= Config::Font::MAX_SIZE, "Font size out of range");
+        
+        if (request.length == 0 || request.length > Config::Text::MAX_LENGTH) continue;
+        
+        const float letterSpacing = std::max(-1000.0f, std::min(1000.0f, request.letterSpacing));
+        TextCacheKey key(std::string_view(request.text, request.length), *request.fallbackChain, request.fontSize, letterSpacing);
+        if (m_shapedTextCache.contains(key) || !m_batchKeys.insert(key).second) continue;
+        
+        m_batchTexts.push_back(i);
+    }
+    
+    if (m_batchTexts.size() < Config::Text::PARALLEL_SHAPING_MIN_TEXTS) return 0;
+    
+    // Segment on this thread; fallback resolution queries the provider's shared faces
+    m_batchSegments.clear();
+    m_batchSegmentEnds.clear();
+    for (size_t index : m_batchTexts)
+    {
+        const TextShapeRequest& request = requests[index];
+        std::vector<TextSegment> segments = TextUtils::segmentTextWithFallback(request.text, *request.fallbackChain, m_fontProvider);
+        for (TextSegment& segment : segments) m_batchSegments.push_back(std::move(segment));
+        m_batchSegmentEnds.push_back(m_batchSegments.size());
+    }
+    
+    // Jobs point into m_batchSegments, so they are built once it stops growing
+    m_shapingJobs.clear();
+    size_t segmentIndex = 0;
+    for (size_t t = 0; t < m_batchTexts.size(); ++t)
+    {
+        const TextShapeRequest& request = requests[m_batchTexts[t]];
+        const float letterSpacing = std::max(-1000.0f, std::min(1000.0f, request.letterSpacing));
+        
+        for (; segmentIndex < m_batchSegmentEnds[t]; ++segmentIndex)
+        {
+            const TextSegment& segment = m_batchSegments[segmentIndex];
+            ShapingJob job{ segment.text.c_str(), segment.fontHandle, nullptr, 0, request.fontSize, letterSpacing };
+            if (!m_fontProvider->getFontData(segment.fontHandle, job.fontData, job.fontDataSize))
+                job.fontData = nullptr;
+            m_shapingJobs.push_back(job);
+        }
+    }
+    
+    if (!m_shaper) m_shaper = std::make_unique<TextShaper>();
+    
+    // Segments whose font bytes are unavailable are shaped inline below
+    m_shapingResults.clear();
+    m_shaper->shape(m_shapingJobs, m_dpiScale, m_shapingResults);
+    
+    // Combine and cache each text exactly as shapeText() would
+    segmentIndex = 0;
+    for (size_t t = 0; t < m_batchTexts.size(); ++t)
+    {
+        const TextShapeRequest& request = requests[m_batchTexts[t]];
+        const float letterSpacing = std::max(-1000.0f, std::min(1000.0f, request.letterSpacing));
+        
+        ShapedText shaped;
+        shaped.totalSize = Vec2(0.0f, request.fontSize);
+        
+        for (; segmentIndex < m_batchSegmentEnds[t]; ++segmentIndex)
         {
-            // Offset segment glyphs by accumulated advance
-            for (auto& glyph : segmentShaped.glyphs)
+            const ShapingJob& job = m_shapingJobs[segmentIndex];
+            ShapedText& segmentShaped = m_shapingResults[segmentIndex];
+            
+            if (!job.fontData)
+            {
+                segmentShaped.clear();
+                if (!shapeTextWithHarfBuzz(job.text, job.fontHandle, job.fontSize, job.letterSpacing, segmentShaped)) continue;
+            }
+            else if (segmentShaped.glyphs.empty())
             {
-                glyph.position.x += totalAdvance;
-                outShapedText.glyphs.push_back(glyph);
+                continue;
             }
             
-            totalAdvance += segmentShaped.totalAdvance;
-            maxHeight = std::max(maxHeight, segmentShaped.totalSize.y);
+            appendSegment(shaped, segmentShaped);
         }
+        
+        shaped.totalSize.x = shaped.totalAdvance;
+        
+        TextCacheKey key(std::string_view(request.text, request.length), *request.fallbackChain, request.fontSize, letterSpacing);
+        m_shapedTextCache.insert(key, std::move(shaped));
     }
     
-    outShapedText.totalAdvance = totalAdvance;
-    outShapedText.totalSize = Vec2(totalAdvance, maxHeight);
+    return m_batchTexts.size();
+}
+
+void TextRenderer::appendSegment(ShapedText& run, const ShapedText& segment)
+{
+    // Offset segment glyphs by accumulated advance
+    for (ShapedGlyph glyph : segment.glyphs)
+    {
+        glyph.position.x += run.totalAdvance;
+        run.glyphs.push_back(glyph);
+    }
     
-    // Cache shaped result
-    m_shapedTextCache[cacheKey] = outShapedText;
+    run.totalAdvance += segment.totalAdvance;
+    run.totalSize.y = std::max(run.totalSize.y, segment.totalSize.y);
+}
+
+const ShapedTextCacheStats& TextRenderer::getShapedTextCacheStats() const
+{
+    return m_shapedTextCache.getStats();
+}
+
+void TextRenderer::setShapedTextCacheBudget(size_t byteBudget)
+{
+    m_shapedTextCache.setByteBudget(byteBudget);
 }
 
 //==========================================================================================
-// HarfBuzz Shaping
+// Cache Files
 
-bool TextRenderer::shapeTextWithHarfBuzz(const char* text,FontHandle fontHandle,float fontSize,float letterSpacing,ShapedText& outShapedText)
+bool TextRenderer::saveCache(const char* path) const
 {
-    YUCHEN_ASSERT_MSG(text != nullptr, "Text cannot be null");
-    YUCHEN_ASSERT_MSG(fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE, "Font size out of range");
+    YUCHEN_ASSERT_MSG(m_isInitialized, "TextRenderer not initialized");
+    YUCHEN_ASSERT(path != nullptr);
     
-    // Get HarfBuzz font scaled for DPI
-    float scaledFontSize = fontSize * m_dpiScale;
-    hb_font_t* hbFont = static_cast<hb_font_t*>(m_fontProvider->getHarfBuzzFont(fontHandle, scaledFontSize, 1.0f));
+    TextCacheHeader header;
+    header.dpiScale = m_dpiScale;
+    TextCacheWriter writer(header);
     
-    YUCHEN_ASSERT_MSG(hbFont != nullptr, "Failed to get HarfBuzz font");
+    // Font table
+    std::vector<std::pair<FontHandle, uint64_t>> fonts;
+    for (FontHandle handle = 0; handle < Config::Font::MAX_FONTS; ++handle)
+    {
+        const void* data = nullptr;
+        size_t size = 0;
+        if (m_fontProvider->isValidFont(handle) && m_fontProvider->getFontData(handle, data, size))
+            fonts.emplace_back(handle, hashCacheBytes(data, size));
+    }
     
-    // Prepare HarfBuzz buffer
-    hb_buffer_clear_contents(m_harfBuzzBuffer);
-    hb_buffer_add_utf8(m_harfBuzzBuffer, text, -1, 0, -1);
+    writer.write(static_cast<uint32_t>(fonts.size()));
+    for (const auto& font : fonts)
+    {
+        writer.write(static_cast<uint64_t>(font.first));
+        writer.write(font.second);
+    }
     
-    // Detect script and language
-    hb_script_t dominantScript = TextUtils::detectTextScript(text);
-    const char* languageStr = TextUtils::getLanguageForScript(dominantScript);
-    hb_language_t language = hb_language_from_string(languageStr, -1);
+    m_glyphCache->save(writer);
+    
+    // Shaped runs
+    writer.write(static_cast<uint32_t>(m_shapedTextCache.getStats().entryCount));
+    m_shapedTextCache.forEachRun([&writer](const TextCacheKey& key, const ShapedText& run) {
+        writer.write(static_cast<uint32_t>(key.text.size()));
+        writer.writeBytes(key.text.data(), key.text.size());
+        writer.write(key.fontCount);
+        for (uint32_t i = 0; i < key.fontCount; ++i) writer.write(static_cast<uint64_t>(key.fonts[i]));
+        writer.write(key.fontSizeBits);
+        writer.write(key.letterSpacingBits);
+        
+        writer.write(static_cast<uint32_t>(run.glyphs.size()));
+        for (const ShapedGlyph& glyph : run.glyphs)
+        {
+            writer.write(glyph.glyphIndex);
+            writer.write(glyph.position.x);
+            writer.write(glyph.position.y);
+            writer.write(glyph.advance);
+            writer.write(glyph.cluster);
+            writer.write(static_cast<uint64_t>(glyph.fontHandle));
+        }
+        writer.write(run.totalAdvance);
+        writer.write(run.totalSize.x);
+        writer.write(run.totalSize.y);
+    });
     
-    // Set buffer properties
-    hb_buffer_set_direction(m_harfBuzzBuffer, HB_DIRECTION_LTR);
-    hb_buffer_set_script(m_harfBuzzBuffer, dominantScript);
-    hb_buffer_set_language(m_harfBuzzBuffer, language);
+    return writer.saveToFile(path);
+}
+
+size_t TextRenderer::loadCache(const char* path)
+{
+    YUCHEN_ASSERT_MSG(m_isInitialized, "TextRenderer not initialized");
+    YUCHEN_ASSERT(path != nullptr);
+    
+    MappedFile file;
+    if (!file.open(path)) return 0;
     
-    // IMPORTANT: Disable kerning (as per user requirement - kerning is unstable)
-    hb_feature_t features[1];
-    features[0].tag = HB_TAG('k','e','r','n');
-    features[0].value = 0;
-    features[0].start = 0;
-    features[0].end = (unsigned int)-1;
+    TextCacheReader reader(file.getData(), file.getSize());
+    TextCacheHeader header;
+    TextCacheHeader expected;
+    expected.dpiScale = m_dpiScale;
+    if (!reader.readHeader(header) || !header.isCompatibleWith(expected)) return 0;
     
-    // Shape text
-    hb_shape(hbFont, m_harfBuzzBuffer, features, 1);
+    // Fonts still loaded at the same handle with the same bytes
+    uint32_t fontCount = 0;
+    if (!reader.read(fontCount) || fontCount > Config::Font::MAX_FONTS) return 0;
     
-    // Extract shaped glyph info
-    unsigned int glyphCount = 0;
-    hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(m_harfBuzzBuffer, &glyphCount);
-    hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(m_harfBuzzBuffer, &glyphCount);
+    std::unordered_set<FontHandle> accepted;
+    for (uint32_t i = 0; i < fontCount; ++i)
+    {
+        uint64_t handle = 0, hash = 0;
+        if (!reader.read(handle) || !reader.read(hash)) return 0;
+        
+        const void* data = nullptr;
+        size_t size = 0;
+        const FontHandle font = static_cast<FontHandle>(handle);
+        if (m_fontProvider->isValidFont(font) && m_fontProvider->getFontData(font, data, size) &&
+            hashCacheBytes(data, size) == hash)
+            accepted.insert(font);
+    }
+    if (accepted.empty()) return 0;
+    
+    auto acceptFont = [&accepted](FontHandle font) { return accepted.count(font) != 0; };
+    
+    size_t adopted = 0;
+    const bool glyphsValid = m_glyphCache->load(reader, acceptFont, adopted);
+    m_glyphCache->flushUploads();
+    if (!glyphsValid) return adopted;
+    
+    // Shaped runs
+    uint32_t runCount = 0;
+    if (!reader.read(runCount)) return adopted;
+    
+    FontFallbackChain chain;
+    for (uint32_t r = 0; r < runCount; ++r)
+    {
+        uint32_t textLength = 0, chainLength = 0, fontSizeBits = 0, letterSpacingBits = 0, glyphCount = 0;
+        
+        if (!reader.read(textLength)) break;
+        const uint8_t* text = reader.readBytes(textLength);
+        if (!text || !reader.read(chainLength) || chainLength > Config::Font::MAX_FONTS) break;
+        
+        bool usable = true;
+        chain.fonts.resize(chainLength);
+        for (FontHandle& font : chain.fonts)
+        {
+            uint64_t handle = 0;
+            if (!reader.read(handle)) return adopted;
+            font = static_cast<FontHandle>(handle);
+            usable = usable && acceptFont(font);
+        }
+        
+        if (!reader.read(fontSizeBits) || !reader.read(letterSpacingBits) || !reader.read(glyphCount)) break;
+        if (glyphCount > Config::Text::MAX_GLYPHS_PER_TEXT) break;
+        
+        ShapedText run;
+        run.glyphs.resize(glyphCount);
+        bool complete = true;
+        for (ShapedGlyph& glyph : run.glyphs)
+        {
+            uint64_t handle = 0;
+            complete = reader.read(glyph.glyphIndex) && reader.read(glyph.position.x) && reader.read(glyph.position.y)
+                    && reader.read(glyph.advance) && reader.read(glyph.cluster) && reader.read(handle);
+            if (!complete) break;
+            glyph.fontHandle = static_cast<FontHandle>(handle);
+            usable = usable && acceptFont(glyph.fontHandle);
+        }
+        if (!complete || !reader.read(run.totalAdvance) || !reader.read(run.totalSize.x) || !reader.read(run.totalSize.y)) break;
+        
+        float fontSize = 0.0f, letterSpacing = 0.0f;
+        std::memcpy(&fontSize, &fontSizeBits, sizeof(fontSize));
+        std::memcpy(&letterSpacing, &letterSpacingBits, sizeof(letterSpacing));
+        
+        TextCacheKey key(std::string_view(reinterpret_cast<const char*>(text), textLength), chain,
+                         fontSize, letterSpacing);
+        if (!usable || m_shapedTextCache.contains(key)) continue;
+        
+        m_shapedTextCache.insert(key, std::move(run));
+        ++adopted;
+    }
     
-    YUCHEN_ASSERT_MSG(glyphInfos != nullptr && glyphPositions != nullptr,"Failed to get glyph info/positions");
-    YUCHEN_ASSERT_MSG(glyphCount > 0 && glyphCount <= Config::Text::MAX_GLYPHS_PER_TEXT,"Invalid glyph count");
+    return adopted;
+}
+
+//==========================================================================================
+// Glyph Warm-up
+
+size_t TextRenderer::prewarm(const FontFallbackChain& fallbackChain, const std::vector<float>& fontSizes, const std::vector<std::string>& strings)
+{
+    YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
+    YUCHEN_ASSERT_MSG(!fallbackChain.isEmpty(), "Fallback chain is empty");
     
-    outShapedText.glyphs.reserve(glyphCount);
+    std::vector<TextShapeRequest> requests;
+    requests.reserve(fontSizes.size() * strings.size());
+    for (float fontSize : fontSizes)
+        for (const std::string& text : strings)
+            requests.push_back({ text.c_str(), static_cast<uint32_t>(text.size()), &fallbackChain, fontSize, 0.0f });
     
-    // Calculate letter spacing in pixels (em = fontSize)
-    float spacingPixels = (letterSpacing / 1000.0f) * fontSize * m_dpiScale;
+    // Large batches are shaped in parallel; the rest are shaped below
+    shapeTextBatch(requests);
     
-    float penX = 0.0f;
-    float penY = 0.0f;
+    const uint32_t boldness = static_cast<uint32_t>(Config::Font::EMBOLDEN_STRENGTH);
+    m_rasterJobs.clear();
+    m_rasterKeys.clear();
     
-    // Convert HarfBuzz glyph data to ShapedGlyph format with letter spacing
-    for (unsigned int i = 0; i < glyphCount; ++i)
+    for (const TextShapeRequest& request : requests)
     {
-        ShapedGlyph glyph;
-        glyph.glyphIndex = glyphInfos[i].codepoint;
-        glyph.cluster = glyphInfos[i].cluster;
-        glyph.fontHandle = fontHandle;
+        if (request.length == 0 || request.length > Config::Text::MAX_LENGTH) continue;
         
-        // Extract position and advance (26.6 fixed-point format)
-        float xOffset = glyphPositions[i].x_offset / 64.0f;
-        float yOffset = glyphPositions[i].y_offset / 64.0f;
-        float xAdvance = glyphPositions[i].x_advance / 64.0f;
-        float yAdvance = glyphPositions[i].y_advance / 64.0f;
+        // Peek, so warming up counts no hits and leaves recency to real draws
+        TextCacheKey key(std::string_view(request.text, request.length), fallbackChain, request.fontSize, 0.0f);
+        ShapedTextRef run = m_shapedTextCache.peek(key);
+        if (!run)
+        {
+            ShapedText shaped;
+            if (!shapeUncached(request.text, fallbackChain, request.fontSize, 0.0f, shaped)) continue;
+            run = m_shapedTextCache.insert(key, std::move(shaped));
+        }
+        ++m_prewarmProgress.runsShaped;
         
-        if (i < glyphCount - 1) xAdvance += spacingPixels;
+        const float scaledFontSize = request.fontSize * m_dpiScale;
+        for (const ShapedGlyph& glyph : run->glyphs)
+            if (glyph.glyphIndex != 0) queuePrewarmGlyph(makeGlyphKey(glyph, scaledFontSize, boldness));
+    }
+    
+    return submitPrewarmGlyphs();
+}
+
+size_t TextRenderer::prewarm(const FontFallbackChain& fallbackChain, const std::vector<float>& fontSizes, const std::vector<uint32_t>& codepoints)
+{
+    YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
+    YUCHEN_ASSERT_MSG(!fallbackChain.isEmpty(), "Fallback chain is empty");
     
-        // Scale back from DPI-scaled coordinates
-        glyph.position = Vec2((penX + xOffset) / m_dpiScale, (penY + yOffset) / m_dpiScale);
-        glyph.advance = xAdvance / m_dpiScale;
+    const uint32_t boldness = static_cast<uint32_t>(Config::Font::EMBOLDEN_STRENGTH);
+    m_rasterJobs.clear();
+    m_rasterKeys.clear();
+    
+    for (float fontSize : fontSizes)
+    {
+        YUCHEN_ASSERT_MSG(fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE, "Font size out of range");
+        const float scaledFontSize = fontSize * m_dpiScale;
         
-        outShapedText.glyphs.push_back(glyph);
+        for (uint32_t codepoint : codepoints)
+        {
+            ShapedGlyph glyph;
+            glyph.fontHandle = m_fontProvider->selectFontForCodepoint(codepoint, fallbackChain);
+            if (glyph.fontHandle == INVALID_FONT_HANDLE) continue;
+            
+            hb_font_t* hbFont = static_cast<hb_font_t*>(m_fontProvider->getHarfBuzzFont(glyph.fontHandle, scaledFontSize, 1.0f));
+            hb_codepoint_t glyphIndex = 0;
+            if (!hbFont || !hb_font_get_nominal_glyph(hbFont, codepoint, &glyphIndex) || glyphIndex == 0) continue;
+            
+            glyph.glyphIndex = glyphIndex;
+            queuePrewarmGlyph(makeGlyphKey(glyph, scaledFontSize, boldness));
+        }
+    }
+    
+    return submitPrewarmGlyphs();
+}
+
+void TextRenderer::resetPrewarmProgress()
+{
+    // Glyphs still on their way stay counted, so isComplete() keeps its meaning
+    m_prewarmProgress = TextPrewarmProgress();
+    m_prewarmProgress.glyphsQueued = m_prewarmKeys.size();
+}
+
+void TextRenderer::queuePrewarmGlyph(const GlyphKey& key)
+{
+    // Cached already: keep it until the text that needs it is drawn
+    if (m_glyphCache->pinGlyph(key)) return;
+    if (m_prewarmKeys.count(key) != 0 || !m_rasterKeys.insert(key).second) return;
+    
+    m_rasterJobs.push_back({ key, nullptr, 0 });
+}
+
+size_t TextRenderer::submitPrewarmGlyphs()
+{
+    const size_t count = m_rasterJobs.size();
+    
+    // Workers need the font bytes; other fonts are rasterized inline, a slice at a time
+    size_t queued = 0;
+    for (GlyphRasterJob& job : m_rasterJobs)
+    {
+        m_prewarmKeys.insert(job.key);
+        if (m_fontProvider->getFontData(job.key.fontHandle, job.fontData, job.fontDataSize))
+            m_rasterJobs[queued++] = job;
+        else
+            m_prewarmInline.push_back(job.key);
+    }
+    m_rasterJobs.erase(m_rasterJobs.begin() + static_cast<std::ptrdiff_t>(queued), m_rasterJobs.end());
+    
+    if (!m_rasterJobs.empty())
+    {
+        if (!m_rasterizer) m_rasterizer = std::make_unique<GlyphRasterizer>();
+        m_rasterizer->submit(m_rasterJobs);
+    }
+    
+    m_prewarmProgress.glyphsQueued += count;
+    return count;
+}
+
+void TextRenderer::cachePrewarmedGlyph(const RasterizedGlyph& glyph)
+{
+    // A draw may have rasterized it meanwhile; a glyph that found no space stays uncached
+    if (!m_glyphCache->pinGlyph(glyph.key))
+    {
+        cacheRasterizedGlyph(glyph);
+        m_glyphCache->pinGlyph(glyph.key);
+    }
+    
+    m_prewarmKeys.erase(glyph.key);
+    ++m_prewarmProgress.glyphsCached;
+}
+
+void TextRenderer::cachePrewarmSlice(size_t maxGlyphs)
+{
+    size_t cached = 0;
+    
+    for (; cached < maxGlyphs && !m_prewarmInline.empty(); ++cached)
+    {
+        const GlyphKey key = m_prewarmInline.back();
+        m_prewarmInline.pop_back();
         
-        // Advance pen position
-        penX += xAdvance;
-        penY += yAdvance;
+        void* face = m_glyphCache->pinGlyph(key) ? nullptr : m_fontProvider->getFontFace(key.fontHandle);
+        if (face && GlyphRasterizer::rasterizeGlyph(face, key, m_inlineGlyph))
+        {
+            cachePrewarmedGlyph(m_inlineGlyph);
+        }
+        else
+        {
+            m_prewarmKeys.erase(key);
+            ++m_prewarmProgress.glyphsCached;
+        }
+    }
+    
+    for (; cached < maxGlyphs && !m_prewarmReady.empty(); ++cached)
+    {
+        auto it = m_prewarmReady.begin();
+        cachePrewarmedGlyph(it->second);
+        m_prewarmReady.erase(it);
     }
+}
+
+//==========================================================================================
+// HarfBuzz Shaping
+
+bool TextRenderer::shapeTextWithHarfBuzz(const char* text,FontHandle fontHandle,float fontSize,float letterSpacing,ShapedText& outShapedText)
+{
+    YUCHEN_ASSERT_MSG(text != nullptr, "Text cannot be null");
+    YUCHEN_ASSERT_MSG(fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE, "Font size out of range");
     
-    outShapedText.totalAdvance = penX / m_dpiScale;
-    outShapedText.totalSize = Vec2(penX / m_dpiScale, fontSize);
+    // Get HarfBuzz font scaled for DPI
+    float scaledFontSize = fontSize * m_dpiScale;
+    hb_font_t* hbFont = static_cast<hb_font_t*>(m_fontProvider->getHarfBuzzFont(fontHandle, scaledFontSize, 1.0f));
     
-    return true;
+    YUCHEN_ASSERT_MSG(hbFont != nullptr, "Failed to get HarfBuzz font");
+    
+    return TextShaper::shapeSegment(hbFont, m_harfBuzzBuffer, text, fontHandle, fontSize, m_dpiScale, letterSpacing, outShapedText);
 }
 
 //==========================================================================================
 // Vertex Generation
 void TextRenderer::generateTextVertices(const ShapedText& shaped,const Vec2& position,const Vec4& color,const FontFallbackChain& fontChain,float fontSize,std::vector<TextVertex>& vertices)
+{
+    generateTextVertices(shaped, position, color, fontChain, fontSize, vertices, m_discardedRanges);
+}
+
+void TextRenderer::generateTextVertices(const ShapedText& shaped,const Vec2& position,const Vec4& color,const FontFallbackChain& fontChain,float fontSize,std::vector<TextVertex>& vertices,std::vector<TextVertexRange>& ranges)
 {
     vertices.clear();
+    ranges.clear();
+    m_quadAtlases.clear();
     vertices.reserve(shaped.glyphs.size() * 4);
-    Vec2 atlasSize = m_glyphCache->getCurrentAtlasSize();
     
     // Use boldness from config (0 = disabled)
     uint32_t currentBoldness = static_cast<uint32_t>(Config::Font::EMBOLDEN_STRENGTH);
+    const float scaledFontSize = fontSize * m_dpiScale;
+    
+    rasterizeMissingGlyphs(shaped, scaledFontSize, currentBoldness);
+    
+    // Distance fields are stored at the reference size and scaled to this one
+    const float glyphScale = (m_glyphFormat == GlyphFormat::SignedDistance)
+                           ? scaledFontSize / Config::GlyphCache::SDF_REFERENCE_SIZE : 1.0f;
+    const float texelSize = glyphScale / m_dpiScale;
+    
+    // Atlas of the previous glyph; consecutive glyphs almost always share one
+    uint32_t lastAtlas = UINT32_MAX;
+    Vec2 atlasSize;
+    bool mixedAtlases = false;
     
     for (const auto& glyph : shaped.glyphs)
     {
         if (glyph.glyphIndex == 0) continue;
-        FontHandle actualFontHandle = glyph.fontHandle;
-        float scaledFontSize = fontSize * m_dpiScale;
         
         // Create cache key WITH boldness information
-        GlyphKey key(actualFontHandle, glyph.glyphIndex, scaledFontSize, currentBoldness);
+        const GlyphKey key = makeGlyphKey(glyph, scaledFontSize, currentBoldness);
         const GlyphCacheEntry* entry = m_glyphCache->getGlyph(key);
         
-        if (!entry)
+        if (!entry || entry->textureRect.width <= 0.0f || entry->textureRect.height <= 0.0f) continue;
+        
+        if (entry->atlasIndex != lastAtlas)
         {
-            const void* bitmapData = nullptr;
-            Vec2 glyphSize, bearing;
-            float advance;
-            renderGlyph(actualFontHandle, glyph.glyphIndex, scaledFontSize,bitmapData, glyphSize, bearing, advance);
-            m_glyphCache->cacheGlyph(key, bitmapData, glyphSize, bearing, advance);
-            entry = m_glyphCache->getGlyph(key);
+            if (lastAtlas != UINT32_MAX) mixedAtlases = true;
+            lastAtlas = entry->atlasIndex;
+            atlasSize = m_glyphCache->getAtlasSize(lastAtlas);
         }
-        if (!entry || entry->textureRect.width <= 0.0f || entry->textureRect.height <= 0.0f) continue;
-        Vec2 glyphPos = Vec2(position.x + glyph.position.x + (entry->bearing.x / m_dpiScale),position.y + glyph.position.y - (entry->bearing.y / m_dpiScale));
-        float glyphWidth = entry->textureRect.width / m_dpiScale;
-        float glyphHeight = entry->textureRect.height / m_dpiScale;
+        
+        Vec2 glyphPos = Vec2(position.x + glyph.position.x + (entry->bearing.x * texelSize),position.y + glyph.position.y - (entry->bearing.y * texelSize));
+        float glyphWidth = entry->textureRect.width * texelSize;
+        float glyphHeight = entry->textureRect.height * texelSize;
         Vec2 texCoordMin = Vec2(entry->textureRect.x / atlasSize.x,entry->textureRect.y / atlasSize.y);
         Vec2 texCoordMax = Vec2((entry->textureRect.x + entry->textureRect.width) / atlasSize.x,(entry->textureRect.y + entry->textureRect.height) / atlasSize.y);
         TextVertex topLeft(Vec2(glyphPos.x, glyphPos.y),Vec2(texCoordMin.x, texCoordMin.y),color);
@@ -356,73 +801,140 @@ void TextRenderer::generateTextVertices(const ShapedText& shaped,const Vec2& pos
         vertices.push_back(topRight);
         vertices.push_back(bottomLeft);
         vertices.push_back(bottomRight);
+        m_quadAtlases.push_back(entry->atlasIndex);
     }
+    
+    if (vertices.empty()) return;
+    
+    if (!mixedAtlases)
+    {
+        ranges.push_back({ lastAtlas, m_glyphCache->getAtlasTexture(lastAtlas), 0, static_cast<uint32_t>(vertices.size()) });
+        return;
+    }
+    
+    groupVerticesByAtlas(vertices, ranges);
 }
 
-//==========================================================================================
-// Glyph Rasterization
-
-void TextRenderer::renderGlyph(FontHandle fontHandle, uint32_t glyphIndex, float scaledFontSize, const void*& outBitmapData, Vec2& outSize, Vec2& outBearing, float& outAdvance)
-{
-    // Get FreeType face from font provider
-    void* face = m_fontProvider->getFontFace(fontHandle);
-    rasterizeGlyphWithFreeType(face, glyphIndex, scaledFontSize, outBitmapData, outSize, outBearing, outAdvance);
-}
-
-void TextRenderer::rasterizeGlyphWithFreeType(void* face, uint32_t glyphIndex, float scaledFontSize, const void*& outBitmapData, Vec2& outSize, Vec2& outBearing, float& outAdvance)
+void TextRenderer::groupVerticesByAtlas(std::vector<TextVertex>& vertices, std::vector<TextVertexRange>& ranges)
 {
-    YUCHEN_ASSERT_MSG(face != nullptr, "Face cannot be null");
+    // One range per atlas in order of first use, sized by counting quads
+    for (uint32_t atlasIndex : m_quadAtlases)
+    {
+        auto it = std::find_if(ranges.begin(), ranges.end(),
+                               [atlasIndex](const TextVertexRange& range) { return range.atlasIndex == atlasIndex; });
+        if (it == ranges.end())
+            ranges.push_back({ atlasIndex, m_glyphCache->getAtlasTexture(atlasIndex), 0, 4 });
+        else
+            it->vertexCount += 4;
+    }
     
-    FT_Face ftFace = static_cast<FT_Face>(face);
+    uint32_t first = 0;
+    for (TextVertexRange& range : ranges)
+    {
+        range.firstVertex = first;
+        first += range.vertexCount;
+        range.vertexCount = 0;
+    }
     
-    // Set character size
-    FT_Error error = FT_Set_Char_Size(ftFace,0,(FT_F26Dot6)(scaledFontSize * 64),Config::Font::FREETYPE_DPI,Config::Font::FREETYPE_DPI);
-    if (error != FT_Err_Ok) throw std::runtime_error("Failed to set char size");
+    // Stable scatter keeps glyph order within each atlas
+    m_groupedVertices.resize(vertices.size());
+    for (size_t quad = 0; quad < m_quadAtlases.size(); ++quad)
+    {
+        const uint32_t atlasIndex = m_quadAtlases[quad];
+        auto it = std::find_if(ranges.begin(), ranges.end(),
+                               [atlasIndex](const TextVertexRange& range) { return range.atlasIndex == atlasIndex; });
+        std::copy_n(vertices.begin() + static_cast<std::ptrdiff_t>(quad * 4), 4,
+                    m_groupedVertices.begin() + static_cast<std::ptrdiff_t>(it->firstVertex + it->vertexCount));
+        it->vertexCount += 4;
+    }
     
-    // Load glyph WITHOUT rendering first
-    error = FT_Load_Glyph(ftFace, glyphIndex, FT_LOAD_DEFAULT);
-    if (error != FT_Err_Ok) throw std::runtime_error("Failed to load glyph");
+    vertices.swap(m_groupedVertices);
+}
+
+//==========================================================================================
+// Glyph Rasterization
 
-    // Get boldness from config (cast to FT_Pos)
-    FT_Pos emboldenStrength = static_cast<FT_Pos>(Config::Font::EMBOLDEN_STRENGTH);
+void TextRenderer::rasterizeMissingGlyphs(const ShapedText& shaped, float scaledFontSize, uint32_t boldness)
+{
+    m_rasterJobs.clear();
+    m_rasterKeys.clear();
     
-    if (emboldenStrength > 0)
+    for (const auto& glyph : shaped.glyphs)
     {
-        // Check if this glyph has outline data (vector fonts only)
-        if (ftFace->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+        if (glyph.glyphIndex == 0) continue;
+        
+        const GlyphKey key = makeGlyphKey(glyph, scaledFontSize, boldness);
+        if (m_glyphCache->getGlyph(key)) continue;
+        
+        // Prewarmed and finished, but its slice has not come up yet
+        if (!m_prewarmReady.empty())
         {
-            // Apply emboldening to the glyph outline
-            error = FT_Outline_Embolden(&ftFace->glyph->outline, emboldenStrength);
-            
-            if (error != FT_Err_Ok)
+            auto ready = m_prewarmReady.find(key);
+            if (ready != m_prewarmReady.end())
             {
-                // Emboldening failed - not critical, continue without it
-                static bool warningShown = false;
-                if (!warningShown)
-                {
-                    std::cerr << "[TextRenderer] Warning: FT_Outline_Embolden failed (error: "  << error << "). Continuing without boldness." << std::endl;
-                    warningShown = true;
-                }
+                cachePrewarmedGlyph(ready->second);
+                m_prewarmReady.erase(ready);
+                continue;
             }
         }
-        // Note: Bitmap fonts (like Emoji) cannot be emboldened, silently skip
+        
+        // Runs repeat glyphs; rasterize each once
+        if (m_rasterKeys.insert(key).second) m_rasterJobs.push_back({ key, nullptr, 0 });
     }
     
-    // === Emboldening Complete ===
-    //======================================================================================
+    if (m_rasterJobs.empty()) return;
     
-    // Now render the (possibly emboldened) glyph to bitmap
-    error = FT_Render_Glyph(ftFace->glyph, FT_RENDER_MODE_NORMAL);
-    if (error != FT_Err_Ok) throw std::runtime_error("Failed to render glyph");
+    const bool parallel = m_deferGlyphRasterization
+                       || (m_rasterJobs.size() >= Config::Text::PARALLEL_RASTER_MIN_GLYPHS && Config::Text::RASTER_THREADS != 1);
+    
+    // Workers open their own faces over the font bytes; fonts without bytes stay inline
+    size_t queued = 0;
+    for (GlyphRasterJob& job : m_rasterJobs)
+    {
+        if (parallel && m_fontProvider->getFontData(job.key.fontHandle, job.fontData, job.fontDataSize))
+            m_rasterJobs[queued++] = job;
+        else
+            renderGlyph(job.key);
+    }
+    m_rasterJobs.erase(m_rasterJobs.begin() + static_cast<std::ptrdiff_t>(queued), m_rasterJobs.end());
+    
+    if (m_rasterJobs.empty()) return;
+    if (!m_rasterizer) m_rasterizer = std::make_unique<GlyphRasterizer>();
+    
+    if (m_deferGlyphRasterization)
+    {
+        m_rasterizer->submit(m_rasterJobs);
+        return;
+    }
+    
+    m_rasterizer->rasterize(m_rasterJobs, m_rasterResults);
+    for (const RasterizedGlyph& glyph : m_rasterResults) cacheRasterizedGlyph(glyph);
+}
+
+GlyphKey TextRenderer::makeGlyphKey(const ShapedGlyph& glyph, float scaledFontSize, uint32_t boldness) const
+{
+    // One distance field per glyph serves every size; boldness is applied when drawing
+    if (m_glyphFormat == GlyphFormat::SignedDistance)
+        return GlyphKey(glyph.fontHandle, glyph.glyphIndex, Config::GlyphCache::SDF_REFERENCE_SIZE, 0, GlyphFormat::SignedDistance);
+    
+    return GlyphKey(glyph.fontHandle, glyph.glyphIndex, scaledFontSize, boldness);
+}
+
+void TextRenderer::renderGlyph(const GlyphKey& key)
+{
+    // Get FreeType face from font provider
+    void* face = m_fontProvider->getFontFace(key.fontHandle);
+    if (!GlyphRasterizer::rasterizeGlyph(face, key, m_inlineGlyph)) throw std::runtime_error("Failed to rasterize glyph");
     
-    FT_GlyphSlot slot = ftFace->glyph;
-    if (slot->format != FT_GLYPH_FORMAT_BITMAP) throw std::runtime_error("Glyph not in bitmap format");
+    cacheRasterizedGlyph(m_inlineGlyph);
+}
+
+void TextRenderer::cacheRasterizedGlyph(const RasterizedGlyph& glyph)
+{
+    if (!glyph.isValid) return;
     
-    // Extract bitmap data and metrics
-    outBitmapData = slot->bitmap.buffer;
-    outSize = Vec2(slot->bitmap.width, slot->bitmap.rows);
-    outBearing = Vec2(slot->bitmap_left, slot->bitmap_top);
-    outAdvance = slot->advance.x / 64.0f;
+    const void* bitmapData = glyph.bitmap.empty() ? nullptr : glyph.bitmap.data();
+    m_glyphCache->cacheGlyph(glyph.key, bitmapData, glyph.size, glyph.bearing, glyph.advance);
 }
 
 //==========================================================================================
@@ -438,6 +950,25 @@ float TextRenderer::getDPIScale() const
     return m_dpiScale;
 }
 
+void TextRenderer::setDeferGlyphRasterization(bool defer)
+{
+    m_deferGlyphRasterization = defer;
+}
+
+bool TextRenderer::setGlyphFormat(GlyphFormat format)
+{
+    // A shader that samples distance fields as coverage draws blurred, too-bold text
+    if (format == GlyphFormat::SignedDistance && !m_backend->supportsDistanceFieldText()) return false;
+    
+    m_glyphFormat = format;
+    return true;
+}
+
+bool TextRenderer::hasPendingGlyphs() const
+{
+    return (m_rasterizer && m_rasterizer->getPendingCount() > 0) || !m_prewarmKeys.empty();
+}
+
 void* TextRenderer::getCurrentAtlasTexture() const
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
@@ -0,0 +1,253 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Text module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+//==========================================================================================
+/** @file TextShaper.cpp
+
+    Implementation notes:
+    - hb-ft fonts set their face's size, so each worker opens one FT_Face per font and
+      size instead of sharing a face between sizes
+    - Sizes are keyed at half-point resolution like FontCache, so a worker and the
+      inline path pick the same font for the same request
+    - A worker drops all its fonts once it holds SHAPING_FONTS_PER_THREAD of them
+    - WorkerPool indices are stable for one parallelFor, so a worker's HarfBuzz and
+      FreeType state is never touched by two threads
+*/
+
+#include "YuchenUI/text/TextShaper.h"
+#include "YuchenUI/text/Font.h"
+#include "YuchenUI/text/TextUtils.h"
+#include "YuchenUI/utils/WorkerPool.h"
+#include "YuchenUI/core/Assert.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace YuchenUI {
+
+//==========================================================================================
+// Worker State
+
+struct TextShaper::WorkerState {
+    struct SizedFont {
+        FT_Face face;
+        hb_font_t* font;
+    };
+
+    struct FontKey {
+        const void* fontData;
+        uint32_t sizeKey;
+
+        bool operator==(const FontKey& other) const
+        {
+            return fontData == other.fontData && sizeKey == other.sizeKey;
+        }
+    };
+
+    struct FontKeyHash {
+        size_t operator()(const FontKey& key) const
+        {
+            return std::hash<const void*>()(key.fontData) ^ (static_cast<size_t>(key.sizeKey) * 0x9e3779b97f4a7c15ull);
+        }
+    };
+
+    hb_buffer_t* buffer = nullptr;
+    FT_Library library = nullptr;
+    std::unordered_map<FontKey, SizedFont, FontKeyHash> fonts;
+
+    ~WorkerState()
+    {
+        clearFonts();
+        if (buffer) hb_buffer_destroy(buffer);
+        if (library) FT_Done_FreeType(library);
+    }
+
+    void clearFonts()
+    {
+        for (auto& pair : fonts)
+        {
+            hb_font_destroy(pair.second.font);
+            FT_Done_Face(pair.second.face);
+        }
+        fonts.clear();
+    }
+
+    hb_font_t* fontFor(const ShapingJob& job, float scaledFontSize)
+    {
+        const FontKey key{ job.fontData, static_cast<uint32_t>(scaledFontSize * 2.0f) };
+        auto it = fonts.find(key);
+        if (it != fonts.end()) return it->second.font;
+
+        if (!library && FT_Init_FreeType(&library) != FT_Err_Ok) return nullptr;
+        if (fonts.size() >= Config::Text::SHAPING_FONTS_PER_THREAD) clearFonts();
+
+        FT_Face face = nullptr;
+        FT_Error error = FT_New_Memory_Face(library, static_cast<const FT_Byte*>(job.fontData),
+                                            static_cast<FT_Long>(job.fontDataSize), 0, &face);
+        if (error != FT_Err_Ok) return nullptr;
+
+        FT_Select_Charmap(face, FT_ENCODING_UNICODE);
+
+        hb_font_t* font = FontCache::createHarfBuzzFont(face, scaledFontSize);
+        if (!font)
+        {
+            FT_Done_Face(face);
+            return nullptr;
+        }
+
+        fonts.emplace(key, SizedFont{ face, font });
+        return font;
+    }
+};
+
+//==========================================================================================
+// Lifecycle
+
+TextShaper::TextShaper(size_t threadCount)
+    : m_threadCount(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+    , m_pool()
+    , m_workers()
+{
+}
+
+TextShaper::~TextShaper()
+{
+    m_pool.reset();
+    m_workers.clear();
+}
+
+void TextShaper::ensureWorkers()
+{
+    if (m_pool) return;
+
+    m_pool = std::make_unique<WorkerPool>(m_threadCount);
+    m_workers.resize(m_pool->getThreadCount());
+    for (auto& worker : m_workers) worker = std::make_unique<WorkerState>();
+}
+
+//==========================================================================================
+// Batches
+
+void TextShaper::shape(const std::vector<ShapingJob>& jobs, float dpiScale, std::vector<ShapedText>& results)
+{
+    YUCHEN_ASSERT_MSG(dpiScale > 0.0f, "DPI scale must be positive");
+
+    results.resize(jobs.size());
+    if (jobs.empty()) return;
+
+    ensureWorkers();
+
+    m_pool->parallelFor(jobs.size(), [&](size_t index, size_t worker) {
+        const ShapingJob& job = jobs[index];
+        ShapedText& result = results[index];
+        result.clear();
+
+        WorkerState& state = *m_workers[worker];
+        if (!state.buffer) state.buffer = hb_buffer_create();
+
+        hb_font_t* font = state.fontFor(job, job.fontSize * dpiScale);
+        if (!font) return;
+
+        if (!shapeSegment(font, state.buffer, job.text, job.fontHandle, job.fontSize, dpiScale,
+                          job.letterSpacing, result))
+            result.clear();
+    });
+}
+
+//==========================================================================================
+// HarfBuzz
+
+bool TextShaper::shapeSegment(hb_font_t* font, hb_buffer_t* buffer, const char* text,
+                              FontHandle fontHandle, float fontSize, float dpiScale,
+                              float letterSpacing, ShapedText& outShapedText)
+{
+    YUCHEN_ASSERT_MSG(font != nullptr, "Failed to get HarfBuzz font");
+    YUCHEN_ASSERT_MSG(buffer != nullptr, "HarfBuzz buffer cannot be null");
+    YUCHEN_ASSERT_MSG(text != nullptr, "Text cannot be null");
+
+    // Prepare HarfBuzz buffer
+    hb_buffer_clear_contents(buffer);
+    hb_buffer_add_utf8(buffer, text, -1, 0, -1);
+
+    // Detect script and language
+    hb_script_t dominantScript = TextUtils::detectTextScript(text);
+    const char* languageStr = TextUtils::getLanguageForScript(dominantScript);
+    hb_language_t language = hb_language_from_string(languageStr, -1);
+
+    // Set buffer properties
+    hb_buffer_set_direction(buffer, HB_DIRECTION_LTR);
+    hb_buffer_set_script(buffer, dominantScript);
+    hb_buffer_set_language(buffer, language);
+
+    // IMPORTANT: Disable kerning (as per user requirement - kerning is unstable)
+    hb_feature_t features[1];
+    features[0].tag = HB_TAG('k','e','r','n');
+    features[0].value = 0;
+    features[0].start = 0;
+    features[0].end = (unsigned int)-1;
+
+    // Shape text
+    hb_shape(font, buffer, features, 1);
+
+    // Extract shaped glyph info
+    unsigned int glyphCount = 0;
+    hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(buffer, &glyphCount);
+    hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(buffer, &glyphCount);
+
+    YUCHEN_ASSERT_MSG(glyphInfos != nullptr && glyphPositions != nullptr,"Failed to get glyph info/positions");
+    YUCHEN_ASSERT_MSG(glyphCount > 0 && glyphCount <= Config::Text::MAX_GLYPHS_PER_TEXT,"Invalid glyph count");
+
+    outShapedText.glyphs.reserve(outShapedText.glyphs.size() + glyphCount);
+
+    // Calculate letter spacing in pixels (em = fontSize)
+    float spacingPixels = (letterSpacing / 1000.0f) * fontSize * dpiScale;
+
+    float penX = 0.0f;
+    float penY = 0.0f;
+
+    // Convert HarfBuzz glyph data to ShapedGlyph format with letter spacing
+    for (unsigned int i = 0; i < glyphCount; ++i)
+    {
+        ShapedGlyph glyph;
+        glyph.glyphIndex = glyphInfos[i].codepoint;
+        glyph.cluster = glyphInfos[i].cluster;
+        glyph.fontHandle = fontHandle;
+
+        // Extract position and advance (26.6 fixed-point format)
+        float xOffset = glyphPositions[i].x_offset / 64.0f;
+        float yOffset = glyphPositions[i].y_offset / 64.0f;
+        float xAdvance = glyphPositions[i].x_advance / 64.0f;
+        float yAdvance = glyphPositions[i].y_advance / 64.0f;
+
+        if (i < glyphCount - 1) xAdvance += spacingPixels;
+
+        // Scale back from DPI-scaled coordinates
+        glyph.position = Vec2((penX + xOffset) / dpiScale, (penY + yOffset) / dpiScale);
+        glyph.advance = xAdvance / dpiScale;
+
+        outShapedText.glyphs.push_back(glyph);
+
+        // Advance pen position
+        penX += xAdvance;
+        penY += yAdvance;
+    }
+
+    outShapedText.totalAdvance = penX / dpiScale;
+    outShapedText.totalSize = Vec2(penX / dpiScale, fontSize);
+
+    return true;
+}
+
+} // namespace YuchenUI
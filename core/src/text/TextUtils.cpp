@@ -19,11 +19,18 @@
     Implementation notes:
     - UTF-8 decoding handles 1-4 byte sequences
     - Returns replacement character (U+FFFD) for invalid UTF-8 sequences
-    - Western character ranges include Latin, Greek, Cyrillic, and common punctuation
-    - CJK ranges include unified ideographs, extensions, and fullwidth forms
-    - Emoji ranges include emoticons, pictographs, and emoji modifiers
-    - Symbol ranges include miscellaneous symbols, dingbats, and geometric shapes
-    - Script detection uses Unicode block ranges
+    - decodeSequence() is the one scalar decoder; decodeUTF8() and the bulk functions only
+      differ in how they find the end of the input
+    - Bulk decoding alternates a vector ASCII run (AVX2 32 bytes, SSE2 or NEON 16 bytes,
+      chosen at compile time like the software rasterizer's span kernels) with one scalar
+      sequence, so mostly-ASCII text rarely leaves the vector loop
+    - ASCII needs no table lookup: letters are Latin and everything else is Common
+    - Script and class bits come from UnicodeTables.h, generated at build time from the
+      HarfBuzz UCD tables: STAGE1 maps each 128-codepoint block to a deduplicated block
+      of STAGE2, whose byte per codepoint indexes a (script, classes) record. About 50 KB
+      in total, and the blocks used by ordinary text stay in cache
+    - Inherited (combining marks) and unassigned codepoints are stored as Common, so
+      detectTextScript() never lets a combining mark pick the script
     - Text segmentation creates contiguous segments by font requirement
     - Segment indices track original character positions for cursor mapping
     
@@ -34,80 +41,237 @@
     - Added segmentTextWithFallback() for fallback-aware segmentation
     - Enhanced Unicode range coverage
     - Improved performance with better character classification
+    
+    Version 2.1 Changes:
+    - Range chains replaced by the generated two-stage table
+    
+    Version 2.2 Changes:
+    - Added validateUTF8(), decodeUTF8ToUTF32() and decodeUTF8WithScripts()
+    - detectTextScript() skips ASCII runs a vector at a time
+    - mapCharactersToFonts() decodes the string once up front
 */
 
 #include "YuchenUI/text/TextUtils.h"
 #include "YuchenUI/text/IFontProvider.h"
 #include "YuchenUI/core/Assert.h"
+#include "UnicodeTables.h"
 #include <cstring>
 
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define YUCHEN_UTF8_AVX2 1
+    #define YUCHEN_UTF8_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define YUCHEN_UTF8_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define YUCHEN_UTF8_NEON 1
+#endif
+
 namespace YuchenUI {
 
+namespace {
+
 //==========================================================================================
-// UTF-8 Decoding
+// Decoding helpers
 
-uint32_t TextUtils::decodeUTF8(const char*& text)
-{
-    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
-    uint32_t codepoint = 0;
+/**
+    Decodes one sequence starting at a non-empty range of available bytes.
     
-    if (*p == 0) return 0;  // End of string
+    Sets valid to false and codepoint to U+FFFD for malformed input. Continuation bytes
+    are checked in order, so a NUL terminator stops the scan like any other bad byte.
     
-    if ((*p & 0x80) == 0)
+    @returns Bytes consumed, at least 1
+*/
+inline size_t decodeSequence(const unsigned char* p, size_t available, uint32_t& codepoint, bool& valid)
+{
+    const unsigned char lead = p[0];
+    if (lead < 0x80)
     {
-        // 1-byte sequence (ASCII): 0xxxxxxx
-        codepoint = *p;
-        text += 1;
+        codepoint = lead;
+        valid = true;
+        return 1;
     }
-    else if ((*p & 0xE0) == 0xC0)
+    
+    size_t length;
+    uint32_t minimum;
+    if ((lead & 0xE0) == 0xC0)      { length = 2; minimum = 0x80;    codepoint = lead & 0x1F; }
+    else if ((lead & 0xF0) == 0xE0) { length = 3; minimum = 0x800;   codepoint = lead & 0x0F; }
+    else if ((lead & 0xF8) == 0xF0) { length = 4; minimum = 0x10000; codepoint = lead & 0x07; }
+    else
     {
-        // 2-byte sequence: 110xxxxx 10xxxxxx
-        if ((*(p+1) & 0xC0) != 0x80)
-        {
-            codepoint = 0xFFFD;  // Invalid sequence
-            text += 1;
-            return codepoint;
-        }
-        codepoint = ((*p & 0x1F) << 6) | (*(p+1) & 0x3F);
-        text += 2;
+        codepoint = 0xFFFD;
+        valid = false;
+        return 1;
     }
-    else if ((*p & 0xF0) == 0xE0)
+    
+    for (size_t i = 1; i < length; ++i)
     {
-        // 3-byte sequence: 1110xxxx 10xxxxxx 10xxxxxx
-        if ((*(p+1) & 0xC0) != 0x80 || (*(p+2) & 0xC0) != 0x80)
+        if (i >= available || (p[i] & 0xC0) != 0x80)
         {
-            codepoint = 0xFFFD;  // Invalid sequence
-            text += 1;
-            return codepoint;
+            codepoint = 0xFFFD;
+            valid = false;
+            return 1;
         }
-        codepoint = ((*p & 0x0F) << 12) | ((*(p+1) & 0x3F) << 6) | (*(p+2) & 0x3F);
-        text += 3;
+        codepoint = (codepoint << 6) | (p[i] & 0x3F);
     }
-    else if ((*p & 0xF8) == 0xF0)
+    
+    // Well-formed shape but not a Unicode scalar value: skip the whole sequence
+    valid = codepoint >= minimum && codepoint <= 0x10FFFF && (codepoint < 0xD800 || codepoint > 0xDFFF);
+    if (!valid) codepoint = 0xFFFD;
+    return length;
+}
+
+/**
+    Writes the leading ASCII bytes of a range to output, widened to 32 bits.
+    
+    @returns Number of ASCII bytes before the first non-ASCII byte or the end
+*/
+template <typename CodeUnit>
+inline size_t widenASCII(const unsigned char* p, size_t length, CodeUnit* output)
+{
+    static_assert(sizeof(CodeUnit) == 4, "Output must be 32-bit code units");
+    size_t i = 0;
+    
+#if YUCHEN_UTF8_AVX2
+    for (; i + 32 <= length; i += 32)
     {
-        // 4-byte sequence: 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
-        if ((*(p+1) & 0xC0) != 0x80 || (*(p+2) & 0xC0) != 0x80 || (*(p+3) & 0xC0) != 0x80)
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        if (_mm256_movemask_epi8(bytes) != 0) break;
+        
+        for (size_t k = 0; k < 32; k += 8)
         {
-            codepoint = 0xFFFD;  // Invalid sequence
-            text += 1;
-            return codepoint;
+            const __m128i eight = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + i + k));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i + k), _mm256_cvtepu8_epi32(eight));
         }
-        codepoint = ((*p & 0x07) << 18) | ((*(p+1) & 0x3F) << 12) |
-                    ((*(p+2) & 0x3F) << 6) | (*(p+3) & 0x3F);
-        text += 4;
     }
-    else
+#endif
+#if YUCHEN_UTF8_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16)
     {
-        // Invalid UTF-8 sequence - return replacement character
-        codepoint = 0xFFFD;
-        text += 1;
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+        if (_mm_movemask_epi8(bytes) != 0) break;
+        
+        const __m128i low = _mm_unpacklo_epi8(bytes, zero);
+        const __m128i high = _mm_unpackhi_epi8(bytes, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_unpacklo_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 4), _mm_unpackhi_epi16(low, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 8), _mm_unpacklo_epi16(high, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i + 12), _mm_unpackhi_epi16(high, zero));
+    }
+#elif YUCHEN_UTF8_NEON
+    for (; i + 16 <= length; i += 16)
+    {
+        const uint8x16_t bytes = vld1q_u8(p + i);
+        if (vmaxvq_u8(bytes) >= 0x80) break;
+        
+        const uint16x8_t low = vmovl_u8(vget_low_u8(bytes));
+        const uint16x8_t high = vmovl_u8(vget_high_u8(bytes));
+        uint32_t* words = reinterpret_cast<uint32_t*>(output + i);
+        vst1q_u32(words, vmovl_u16(vget_low_u16(low)));
+        vst1q_u32(words + 4, vmovl_u16(vget_high_u16(low)));
+        vst1q_u32(words + 8, vmovl_u16(vget_low_u16(high)));
+        vst1q_u32(words + 12, vmovl_u16(vget_high_u16(high)));
     }
+#endif
+    
+    // Scalar tail, and the part of a vector before its first non-ASCII byte
+    for (; i < length && p[i] < 0x80; ++i) output[i] = p[i];
+    return i;
+}
+
+/** Returns the number of leading ASCII bytes of a range. */
+inline size_t asciiPrefixLength(const unsigned char* p, size_t length)
+{
+    size_t i = 0;
     
-    if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) return 0xFFFD;
+#if YUCHEN_UTF8_AVX2
+    for (; i + 32 <= length; i += 32)
+        if (_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i))) != 0) break;
+#endif
+#if YUCHEN_UTF8_SSE2
+    for (; i + 16 <= length; i += 16)
+        if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i))) != 0) break;
+#elif YUCHEN_UTF8_NEON
+    for (; i + 16 <= length; i += 16)
+        if (vmaxvq_u8(vld1q_u8(p + i)) >= 0x80) break;
+#endif
     
+    for (; i < length && p[i] < 0x80; ++i) {}
+    return i;
+}
+
+} // namespace
+
+//==========================================================================================
+// UTF-8 Decoding
+
+uint32_t TextUtils::decodeUTF8(const char*& text)
+{
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    if (*p == 0) return 0;  // End of string
+    
+    // The terminator stops the continuation byte scan, so 4 bytes are never over-read
+    uint32_t codepoint;
+    bool valid;
+    text += decodeSequence(p, 4, codepoint, valid);
     return codepoint;
 }
 
+bool TextUtils::validateUTF8(const char* text, size_t length)
+{
+    YUCHEN_ASSERT(text != nullptr || length == 0);
+    
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    size_t i = 0;
+    
+    while (i < length)
+    {
+        i += asciiPrefixLength(p + i, length - i);
+        if (i == length) break;
+        
+        uint32_t codepoint;
+        bool valid;
+        i += decodeSequence(p + i, length - i, codepoint, valid);
+        if (!valid) return false;
+    }
+    
+    return true;
+}
+
+size_t TextUtils::decodeUTF8ToUTF32(const char* text, size_t length, std::u32string& output)
+{
+    YUCHEN_ASSERT(text != nullptr || length == 0);
+    if (length == 0) return 0;
+    
+    // Never more codepoints than bytes; sized once, trimmed at the end
+    const size_t start = output.size();
+    output.resize(start + length);
+    char32_t* out = &output[start];
+    
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    size_t i = 0;
+    size_t count = 0;
+    
+    while (i < length)
+    {
+        const size_t ascii = widenASCII(p + i, length - i, out + count);
+        i += ascii;
+        count += ascii;
+        if (i == length) break;
+        
+        uint32_t codepoint;
+        bool valid;
+        i += decodeSequence(p + i, length - i, codepoint, valid);
+        out[count++] = codepoint;
+    }
+    
+    output.resize(start + count);
+    return count;
+}
+
 std::string TextUtils::encodeUTF8(uint32_t codepoint)
 {
     std::string result;
@@ -153,56 +317,69 @@ std::string TextUtils::encodeUTF8(uint32_t codepoint)
 //==========================================================================================
 // Character Classification
 
+namespace {
+
+/** Returns the table record of a codepoint; out-of-range values read as unclassified. */
+inline const UnicodeTables::CharacterProperties& lookupProperties(uint32_t codepoint)
+{
+    if (codepoint >= UnicodeTables::CODEPOINT_COUNT) return UnicodeTables::PROPERTIES[0];
+    
+    const uint32_t block = UnicodeTables::STAGE1[codepoint >> UnicodeTables::BLOCK_SHIFT];
+    const uint8_t index = UnicodeTables::STAGE2[(block << UnicodeTables::BLOCK_SHIFT) | (codepoint & UnicodeTables::BLOCK_MASK)];
+    return UnicodeTables::PROPERTIES[index];
+}
+
+/** Counts scripts of a string and picks the dominant one: Han > other > Latin > Common. */
+struct ScriptTally {
+    size_t hanCount = 0;
+    size_t latinCount = 0;
+    size_t otherCount = 0;
+    hb_script_t firstOther = HB_SCRIPT_COMMON;
+    
+    void add(hb_script_t script)
+    {
+        if (script == HB_SCRIPT_HAN)
+            ++hanCount;
+        else if (script == HB_SCRIPT_LATIN)
+            ++latinCount;
+        else if (script != HB_SCRIPT_COMMON && otherCount++ == 0)
+            firstOther = script;
+    }
+    
+    hb_script_t getDominant() const
+    {
+        if (hanCount > 0) return HB_SCRIPT_HAN;
+        if (otherCount > 0) return firstOther;
+        return latinCount > 0 ? HB_SCRIPT_LATIN : HB_SCRIPT_COMMON;
+    }
+};
+
+/** ASCII letters are the only Latin codepoints below U+0080; everything else there is Common. */
+inline bool isASCIILetter(unsigned char c)
+{
+    return static_cast<unsigned char>((c | 0x20) - 'a') < 26;
+}
+
+} // namespace
+
 bool TextUtils::isWesternCharacter(uint32_t codepoint)
 {
-    return (codepoint <= 0x024F) ||                          // Basic Latin + Latin Extended
-           (codepoint >= 0x0370 && codepoint <= 0x03FF) ||   // Greek and Coptic
-           (codepoint >= 0x0400 && codepoint <= 0x04FF) ||   // Cyrillic
-           (codepoint >= 0x2000 && codepoint <= 0x206F) ||   // General Punctuation
-           (codepoint >= 0x2190 && codepoint <= 0x22FF) ||   // Arrows + Mathematical Operators
-           (codepoint >= 0x2100 && codepoint <= 0x214F);     // Letterlike Symbols
+    return (lookupProperties(codepoint).classes & UnicodeTables::CLASS_WESTERN) != 0;
 }
 
 bool TextUtils::isChineseCharacter(uint32_t codepoint)
 {
-    return (codepoint >= 0x4E00 && codepoint <= 0x9FFF) ||   // CJK Unified Ideographs
-           (codepoint >= 0x3400 && codepoint <= 0x4DBF) ||   // CJK Extension A
-           (codepoint >= 0x3000 && codepoint <= 0x303F) ||   // CJK Symbols and Punctuation
-           (codepoint >= 0xFF00 && codepoint <= 0xFFEF);     // Halfwidth and Fullwidth Forms
+    return (lookupProperties(codepoint).classes & UnicodeTables::CLASS_CHINESE) != 0;
 }
 
 bool TextUtils::isEmojiCharacter(uint32_t codepoint)
 {
-    // Emoji ranges (Unicode 15.0)
-    return (codepoint >= 0x1F600 && codepoint <= 0x1F64F) ||  // Emoticons
-           (codepoint >= 0x1F300 && codepoint <= 0x1F5FF) ||  // Miscellaneous Symbols and Pictographs
-           (codepoint >= 0x1F680 && codepoint <= 0x1F6FF) ||  // Transport and Map Symbols
-           (codepoint >= 0x1F700 && codepoint <= 0x1F77F) ||  // Alchemical Symbols
-           (codepoint >= 0x1F780 && codepoint <= 0x1F7FF) ||  // Geometric Shapes Extended
-           (codepoint >= 0x1F800 && codepoint <= 0x1F8FF) ||  // Supplemental Arrows-C
-           (codepoint >= 0x1F900 && codepoint <= 0x1F9FF) ||  // Supplemental Symbols and Pictographs
-           (codepoint >= 0x1FA00 && codepoint <= 0x1FA6F) ||  // Chess Symbols
-           (codepoint >= 0x1FA70 && codepoint <= 0x1FAFF) ||  // Symbols and Pictographs Extended-A
-           (codepoint >= 0x2600 && codepoint <= 0x26FF) ||    // Miscellaneous Symbols (partial emoji)
-           (codepoint >= 0x2700 && codepoint <= 0x27BF) ||    // Dingbats (partial emoji)
-           (codepoint >= 0xFE00 && codepoint <= 0xFE0F) ||    // Variation Selectors (emoji variants)
-           (codepoint >= 0x1F3FB && codepoint <= 0x1F3FF);    // Emoji Modifiers (skin tones)
+    return (lookupProperties(codepoint).classes & UnicodeTables::CLASS_EMOJI) != 0;
 }
 
 bool TextUtils::isSymbolCharacter(uint32_t codepoint)
 {
-    // Symbol ranges that are not emoji
-    return (codepoint >= 0x2300 && codepoint <= 0x23FF) ||    // Miscellaneous Technical
-           (codepoint >= 0x2400 && codepoint <= 0x243F) ||    // Control Pictures
-           (codepoint >= 0x2440 && codepoint <= 0x245F) ||    // Optical Character Recognition
-           (codepoint >= 0x2460 && codepoint <= 0x24FF) ||    // Enclosed Alphanumerics
-           (codepoint >= 0x2500 && codepoint <= 0x257F) ||    // Box Drawing
-           (codepoint >= 0x2580 && codepoint <= 0x259F) ||    // Block Elements
-           (codepoint >= 0x25A0 && codepoint <= 0x25FF) ||    // Geometric Shapes
-           (codepoint >= 0x2980 && codepoint <= 0x29FF) ||    // Miscellaneous Mathematical Symbols-B
-           (codepoint >= 0x2A00 && codepoint <= 0x2AFF) ||    // Supplemental Mathematical Operators
-           (codepoint >= 0x2B00 && codepoint <= 0x2BFF) ||    // Miscellaneous Symbols and Arrows
-           (codepoint >= 0x2E00 && codepoint <= 0x2E7F);      // Supplemental Punctuation
+    return (lookupProperties(codepoint).classes & UnicodeTables::CLASS_SYMBOL) != 0;
 }
 
 //==========================================================================================
@@ -210,72 +387,96 @@ bool TextUtils::isSymbolCharacter(uint32_t codepoint)
 
 hb_script_t TextUtils::detectScript(uint32_t codepoint)
 {
-    // CJK Unified Ideographs (Chinese, Japanese, Korean)
-    if ((codepoint >= 0x4E00 && codepoint <= 0x9FFF) ||      // Main block
-        (codepoint >= 0x3400 && codepoint <= 0x4DBF) ||      // Extension A
-        (codepoint >= 0x20000 && codepoint <= 0x2A6DF) ||    // Extension B
-        (codepoint >= 0x2A700 && codepoint <= 0x2B73F) ||    // Extension C
-        (codepoint >= 0x2B740 && codepoint <= 0x2B81F) ||    // Extension D
-        (codepoint >= 0xF900 && codepoint <= 0xFAFF) ||      // Compatibility Ideographs
-        (codepoint >= 0x2F800 && codepoint <= 0x2FA1F))      // Compatibility Supplement
-        return HB_SCRIPT_HAN;
-    
-    // Latin script
-    if ((codepoint >= 0x0020 && codepoint <= 0x007F) ||      // Basic Latin
-        (codepoint >= 0x00A0 && codepoint <= 0x00FF) ||      // Latin-1 Supplement
-        (codepoint >= 0x0100 && codepoint <= 0x017F) ||      // Latin Extended-A
-        (codepoint >= 0x0180 && codepoint <= 0x024F))        // Latin Extended-B
-        return HB_SCRIPT_LATIN;
-    
-    // Japanese scripts
-    if (codepoint >= 0x3040 && codepoint <= 0x309F) return HB_SCRIPT_HIRAGANA;
-    if (codepoint >= 0x30A0 && codepoint <= 0x30FF) return HB_SCRIPT_KATAKANA;
-    
-    // Korean Hangul
-    if (codepoint >= 0xAC00 && codepoint <= 0xD7AF) return HB_SCRIPT_HANGUL;
-    
-    // Arabic
-    if (codepoint >= 0x0600 && codepoint <= 0x06FF) return HB_SCRIPT_ARABIC;
-    
-    // Hebrew
-    if (codepoint >= 0x0590 && codepoint <= 0x05FF) return HB_SCRIPT_HEBREW;
-    
-    // Thai
-    if (codepoint >= 0x0E00 && codepoint <= 0x0E7F) return HB_SCRIPT_THAI;
-    
-    // Default to common for punctuation, symbols, emoji, etc.
-    return HB_SCRIPT_COMMON;
+    return static_cast<hb_script_t>(lookupProperties(codepoint).script);
 }
 
 hb_script_t TextUtils::detectTextScript(const char* text)
 {
-    const char* p = text;
-    hb_script_t dominantScript = HB_SCRIPT_COMMON;
-    int hanCount = 0, latinCount = 0, otherCount = 0;
+    YUCHEN_ASSERT(text != nullptr);
+    
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    const size_t length = std::strlen(text);
+    ScriptTally tally;
+    size_t i = 0;
     
-    // Count characters by script
-    while (*p)
+    while (i < length)
     {
-        uint32_t codepoint = decodeUTF8(p);
-        if (codepoint == 0) break;
-        if (codepoint == 0xFFFD) continue;  // Skip replacement character
+        // An ASCII run only matters for whether it holds a Latin letter
+        const size_t ascii = asciiPrefixLength(p + i, length - i);
+        if (tally.latinCount == 0)
+        {
+            for (size_t k = i; k < i + ascii; ++k)
+            {
+                if (isASCIILetter(p[k]))
+                {
+                    tally.latinCount = 1;
+                    break;
+                }
+            }
+        }
+        i += ascii;
+        if (i == length) break;
         
-        hb_script_t script = detectScript(codepoint);
-        if (script == HB_SCRIPT_HAN)
-            hanCount++;
-        else if (script == HB_SCRIPT_LATIN)
-            latinCount++;
-        else if (script != HB_SCRIPT_COMMON)
+        uint32_t codepoint;
+        bool valid;
+        i += decodeSequence(p + i, length - i, codepoint, valid);
+        if (valid) tally.add(static_cast<hb_script_t>(lookupProperties(codepoint).script));
+    }
+    
+    return tally.getDominant();
+}
+
+void TextUtils::decodeUTF8WithScripts(const char* text, size_t length, DecodedText& output)
+{
+    YUCHEN_ASSERT(text != nullptr || length == 0);
+    
+    output.clear();
+    if (length == 0) return;
+    
+    // Sized for the all-ASCII worst case, trimmed at the end
+    output.codepoints.resize(length);
+    output.byteOffsets.resize(length + 1);
+    output.scripts.resize(length);
+    
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(text);
+    uint32_t* codepoints = output.codepoints.data();
+    uint32_t* offsets = output.byteOffsets.data();
+    hb_script_t* scripts = output.scripts.data();
+    ScriptTally tally;
+    size_t i = 0;
+    size_t count = 0;
+    
+    while (i < length)
+    {
+        const size_t ascii = widenASCII(p + i, length - i, codepoints + count);
+        for (size_t k = 0; k < ascii; ++k)
         {
-            otherCount++;
-            dominantScript = script;  // Remember first non-common script
+            const bool letter = isASCIILetter(p[i + k]);
+            offsets[count + k] = static_cast<uint32_t>(i + k);
+            scripts[count + k] = letter ? HB_SCRIPT_LATIN : HB_SCRIPT_COMMON;
+            tally.latinCount += letter;
         }
+        i += ascii;
+        count += ascii;
+        if (i == length) break;
+        
+        uint32_t codepoint;
+        bool valid;
+        offsets[count] = static_cast<uint32_t>(i);
+        i += decodeSequence(p + i, length - i, codepoint, valid);
+        
+        const hb_script_t script = static_cast<hb_script_t>(lookupProperties(codepoint).script);
+        codepoints[count] = codepoint;
+        scripts[count] = script;
+        if (valid) tally.add(script);
+        ++count;
     }
     
-    // Return dominant script with priority: Han > Other > Latin > Common
-    if (hanCount > 0) return HB_SCRIPT_HAN;
-    if (otherCount > 0) return dominantScript;
-    return latinCount > 0 ? HB_SCRIPT_LATIN : HB_SCRIPT_COMMON;
+    offsets[count] = static_cast<uint32_t>(length);
+    output.codepoints.resize(count);
+    output.byteOffsets.resize(count + 1);
+    output.scripts.resize(count);
+    output.dominantScript = tally.getDominant();
 }
 
 //==========================================================================================
@@ -308,33 +509,23 @@ std::vector<CharFontMapping> TextUtils::mapCharactersToFonts(
     YUCHEN_ASSERT(!fallbackChain.isEmpty());
     YUCHEN_ASSERT(fontProvider != nullptr);
     
+    DecodedText decoded;
+    decodeUTF8WithScripts(text, std::strlen(text), decoded);
+    
     std::vector<CharFontMapping> mappings;
-    const char* p = text;
-    size_t byteOffset = 0;
+    mappings.reserve(decoded.size());
     
-    while (*p)
+    for (size_t i = 0; i < decoded.size(); ++i)
     {
-        const char* charStart = p;
-        uint32_t codepoint = decodeUTF8(p);
-        if (codepoint == 0) break;
-        
-        size_t charLength = p - charStart;
+        const uint32_t codepoint = decoded.codepoints[i];
         
-        // Skip replacement characters
-        if (codepoint == 0xFFFD)
-        {
-            byteOffset += charLength;
-            continue;
-        }
+        // Skip replacement characters; a NUL ends the string
+        if (codepoint == 0xFFFD) continue;
+        if (codepoint == 0) break;
         
         // Select best font from fallback chain for this character
         FontHandle selectedFont = fontProvider->selectFontForCodepoint(codepoint, fallbackChain);
-        
-        // Record mapping
-        CharFontMapping mapping(codepoint, selectedFont, byteOffset, charLength);
-        mappings.push_back(mapping);
-        
-        byteOffset += charLength;
+        mappings.emplace_back(codepoint, selectedFont, decoded.byteOffsets[i], decoded.getByteLength(i));
     }
     
     return mappings;
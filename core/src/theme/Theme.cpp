@@ -15,12 +15,24 @@
 
 #include "YuchenUI/theme/Theme.h"
 #include "YuchenUI/core/Assert.h"
+#include <atomic>
 
 namespace YuchenUI {
 
 //==========================================================================================
 // UIStyle Base Implementation
 
+UIStyle::UIStyle()
+    : m_revision(nextRevision())
+{
+}
+
+uint64_t UIStyle::nextRevision()
+{
+    static std::atomic<uint64_t> s_revision(0);
+    return ++s_revision;
+}
+
 IFontProvider* UIStyle::getFontProvider() const
 {
     YUCHEN_ASSERT_MSG(m_fontProvider != nullptr,
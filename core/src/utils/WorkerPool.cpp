@@ -0,0 +1,115 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework
+**
+** Copyright (C) 2025 Yuchen Wei
+** Contact: https://github.com/YuchenSound/YuchenUI
+**
+** This file is part of the YuchenUI Utils module.
+**
+** $YUCHEN_BEGIN_LICENSE:MIT$
+** Licensed under the MIT License
+** $YUCHEN_END_LICENSE$
+**
+********************************************************************************************/
+
+#include "YuchenUI/utils/WorkerPool.h"
+#include "YuchenUI/core/Assert.h"
+
+namespace YuchenUI {
+
+//==========================================================================================
+// Lifecycle
+
+WorkerPool::WorkerPool(size_t threadCount)
+    : m_task(nullptr)
+    , m_taskCount(0)
+    , m_nextTask(0)
+    , m_activeWorkers(0)
+    , m_generation(0)
+    , m_stopping(false)
+{
+    if (threadCount == 0) threadCount = std::thread::hardware_concurrency();
+    if (threadCount == 0) threadCount = 1;
+
+    m_workers.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i)
+        m_workers.emplace_back(&WorkerPool::workerLoop, this, i);
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers) worker.join();
+}
+
+//==========================================================================================
+// Dispatch
+
+void WorkerPool::parallelFor(size_t taskCount, const std::function<void(size_t, size_t)>& task)
+{
+    if (taskCount == 0) return;
+
+    if (m_workers.empty() || taskCount == 1)
+    {
+        for (size_t i = 0; i < taskCount; ++i) task(i, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        YUCHEN_ASSERT_MSG(m_task == nullptr, "parallelFor is not re-entrant");
+        m_task = &task;
+        m_taskCount = taskCount;
+        m_nextTask.store(0, std::memory_order_relaxed);
+        m_activeWorkers = m_workers.size();
+        ++m_generation;
+    }
+    m_wakeCondition.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_activeWorkers == 0; });
+    m_task = nullptr;
+}
+
+void WorkerPool::runTasks(size_t worker)
+{
+    const auto& task = *m_task;
+    for (;;)
+    {
+        size_t index = m_nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_taskCount) break;
+        task(index, worker);
+    }
+}
+
+void WorkerPool::workerLoop(size_t worker)
+{
+    uint64_t seenGeneration = 0;
+
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [&] { return m_stopping || m_generation != seenGeneration; });
+            if (m_stopping) return;
+            seenGeneration = m_generation;
+        }
+
+        runTasks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_activeWorkers == 0) m_doneCondition.notify_one();
+        }
+    }
+}
+
+} // namespace YuchenUI
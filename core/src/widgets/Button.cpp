@@ -25,6 +25,7 @@ Button::Button(const Rect& bounds)
     Validation::AssertRect(bounds);
     setBounds(bounds);
     setFocusPolicy(FocusPolicy::StrongFocus);
+    setDrawCacheEnabled(true);
 }
 
 Button::~Button()
@@ -67,11 +68,13 @@ void Button::addDrawCommands(RenderList& commandList, const Vec2& offset) const
 void Button::setText(const std::string& text)
 {
     m_text = text;
+    invalidate();
 }
 
 void Button::setText(const char* text)
 {
     m_text = text;
+    invalidate();
 }
 
 void Button::setFont(FontHandle fontHandle)
@@ -82,6 +85,7 @@ void Button::setFont(FontHandle fontHandle)
     FontHandle cjkFont = fontProvider->getDefaultCJKFont();
     m_fontChain = FontFallbackChain(fontHandle, cjkFont);
     m_hasCustomFont = true;
+    invalidate();
 }
 
 void Button::setFontChain(const FontFallbackChain& chain)
@@ -90,6 +94,7 @@ void Button::setFontChain(const FontFallbackChain& chain)
     
     m_fontChain = chain;
     m_hasCustomFont = true;
+    invalidate();
 }
 
 FontFallbackChain Button::getFontChain() const
@@ -103,12 +108,16 @@ void Button::resetFont()
 {
     m_fontChain.clear();
     m_hasCustomFont = false;
+    invalidate();
 }
 
 void Button::setFontSize(float fontSize)
 {
     if (fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE)
+    {
         m_fontSize = fontSize;
+        invalidate();
+    }
 }
 
 void Button::setTextColor(const Vec4& color)
@@ -116,6 +125,7 @@ void Button::setTextColor(const Vec4& color)
     Validation::AssertColor(color);
     m_textColor = color;
     m_hasCustomTextColor = true;
+    invalidate();
 }
 
 Vec4 Button::getTextColor() const
@@ -129,11 +139,13 @@ void Button::resetTextColor()
 {
     m_hasCustomTextColor = false;
     m_textColor = Vec4();
+    invalidate();
 }
 
 void Button::setRole(ButtonRole role)
 {
     m_role = role;
+    invalidate();
 }
 
 void Button::setClickCallback(ButtonClickCallback callback)
@@ -151,6 +163,7 @@ bool Button::handleMouseMove(const Vec2& position, const Vec2& offset)
     bool wasHovered = m_isHovered;
     m_isHovered = absRect.contains(position);
     
+    if (wasHovered != m_isHovered) invalidate();
     return wasHovered != m_isHovered;
 }
 
@@ -166,11 +179,13 @@ bool Button::handleMouseClick(const Vec2& position, bool pressed, const Vec2& of
     if (pressed && isInBounds)
     {
         m_isPressed = true;
+        invalidate();
         return true;
     }
     else if (!pressed && m_isPressed)
     {
         m_isPressed = false;
+        invalidate();
         if (isInBounds && m_clickCallback)
             m_clickCallback();
         return true;
@@ -23,6 +23,7 @@ CheckBox::CheckBox(const Rect& bounds)
     Validation::AssertRect(bounds);
     setBounds(bounds);
     setFocusPolicy(FocusPolicy::StrongFocus);
+    setDrawCacheEnabled(true);
 }
 
 CheckBox::~CheckBox()
@@ -81,6 +82,7 @@ bool CheckBox::handleMouseMove(const Vec2& position, const Vec2& offset)
     bool wasHovered = m_isHovered;
     m_isHovered = absRect.contains(position);
     
+    if (wasHovered != m_isHovered) invalidate();
     return wasHovered != m_isHovered;
 }
 
@@ -137,6 +139,7 @@ void CheckBox::setState(CheckBoxState state)
     if (m_state != state)
     {
         m_state = state;
+        invalidate();
         if (m_stateChangedCallback)
         {
             m_stateChangedCallback(m_state);
@@ -152,12 +155,14 @@ void CheckBox::setChecked(bool checked)
 void CheckBox::setText(const std::string& text)
 {
     m_text = text;
+    invalidate();
 }
 
 void CheckBox::setText(const char* text)
 {
     YUCHEN_ASSERT(text);
     m_text = text;
+    invalidate();
 }
 
 void CheckBox::setFontSize(float fontSize)
@@ -165,6 +170,7 @@ void CheckBox::setFontSize(float fontSize)
     if (fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE)
     {
         m_fontSize = fontSize;
+        invalidate();
     }
 }
 
@@ -173,6 +179,7 @@ void CheckBox::setTextColor(const Vec4& color)
     Validation::AssertColor(color);
     m_textColor = color;
     m_hasCustomTextColor = true;
+    invalidate();
 }
 
 Vec4 CheckBox::getTextColor() const
@@ -189,6 +196,7 @@ void CheckBox::resetTextColor()
 {
     m_hasCustomTextColor = false;
     m_textColor = Vec4();
+    invalidate();
 }
 
 void CheckBox::setStateChangedCallback(CheckBoxStateChangedCallback callback)
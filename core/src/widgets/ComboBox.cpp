@@ -123,18 +123,21 @@ void ComboBox::addItem(const std::string& text, int value, bool enabled)
 {
     m_items.emplace_back(text, value, enabled);
     m_menuNeedsRebuild = true;
+    invalidate();
 }
 
 void ComboBox::addGroup(const std::string& groupTitle)
 {
     m_items.push_back(ComboBoxItem::Group(groupTitle));
     m_menuNeedsRebuild = true;
+    invalidate();
 }
 
 void ComboBox::addSeparator()
 {
     m_items.push_back(ComboBoxItem::Separator());
     m_menuNeedsRebuild = true;
+    invalidate();
 }
 
 void ComboBox::setItems(const std::vector<ComboBoxItem>& items)
@@ -148,6 +151,7 @@ void ComboBox::setItems(const std::vector<ComboBoxItem>& items)
     }
     
     m_menuNeedsRebuild = true;
+    invalidate();
 }
 
 void ComboBox::clearItems()
@@ -155,6 +159,7 @@ void ComboBox::clearItems()
     m_items.clear();
     m_selectedIndex = -1;
     m_menuNeedsRebuild = true;
+    invalidate();
 }
 
 void ComboBox::setSelectedIndex(int index)
@@ -164,6 +169,7 @@ void ComboBox::setSelectedIndex(int index)
     {
         m_selectedIndex = index;
     }
+    invalidate();
 }
 
 int ComboBox::getSelectedValue() const
@@ -192,11 +198,13 @@ void ComboBox::setCallback(ComboBoxCallback callback)
 void ComboBox::setTheme(ComboBoxTheme theme)
 {
     m_theme = theme;
+    invalidate();
 }
 
 void ComboBox::setPlaceholder(const std::string& placeholder)
 {
     m_placeholder = placeholder;
+    invalidate();
 }
 
 bool ComboBox::isValid() const
@@ -87,6 +87,7 @@ void Frame::setBackgroundColor(const Vec4& color)
     Validation::AssertColor(color);
     m_backgroundColor = color;
     m_hasCustomBackground = true;
+    invalidate();
 }
 
 Vec4 Frame::getBackgroundColor() const
@@ -103,6 +104,7 @@ void Frame::resetBackgroundColor()
 {
     m_hasCustomBackground = false;
     m_backgroundColor = Vec4();
+    invalidate();
 }
 
 void Frame::setBorderColor(const Vec4& color)
@@ -110,6 +112,7 @@ void Frame::setBorderColor(const Vec4& color)
     Validation::AssertColor(color);
     m_borderColor = color;
     m_hasCustomBorderColor = true;
+    invalidate();
 }
 
 Vec4 Frame::getBorderColor() const
@@ -126,24 +129,28 @@ void Frame::resetBorderColor()
 {
     m_hasCustomBorderColor = false;
     m_borderColor = Vec4();
+    invalidate();
 }
 
 void Frame::setBorderWidth(float width)
 {
     YUCHEN_ASSERT(width >= 0.0f);
     m_borderWidth = width;
+    invalidate();
 }
 
 void Frame::setCornerRadius(const CornerRadius& radius)
 {
     Validation::AssertCornerRadius(radius);
     m_cornerRadius = radius;
+    invalidate();
 }
 
 void Frame::setCornerRadius(float radius)
 {
     YUCHEN_ASSERT(radius >= 0.0f);
     m_cornerRadius = CornerRadius(radius);
+    invalidate();
 }
 
 bool Frame::isValid() const
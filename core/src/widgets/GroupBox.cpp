@@ -160,12 +160,14 @@ bool GroupBox::handleMouseWheel(const Vec2& delta, const Vec2& position, const V
 void GroupBox::setTitle(const std::string& title)
 {
     m_title = title;
+    invalidate();
 }
 
 void GroupBox::setTitle(const char* title)
 {
     YUCHEN_ASSERT(title);
     m_title = title;
+    invalidate();
 }
 
 void GroupBox::setTitleFont(FontHandle fontHandle)
@@ -180,6 +182,7 @@ void GroupBox::setTitleFont(FontHandle fontHandle)
     FontHandle cjkFont = fontProvider->getDefaultCJKFont();
     m_titleFontChain = FontFallbackChain(fontHandle, cjkFont);
     m_hasCustomTitleFont = true;
+    invalidate();
 }
 
 void GroupBox::setTitleFontChain(const FontFallbackChain& chain)
@@ -191,6 +194,7 @@ void GroupBox::setTitleFontChain(const FontFallbackChain& chain)
     
     m_titleFontChain = chain;
     m_hasCustomTitleFont = true;
+    invalidate();
 }
 
 FontFallbackChain GroupBox::getTitleFontChain() const
@@ -208,6 +212,7 @@ void GroupBox::resetTitleFont()
 {
     m_titleFontChain.clear();
     m_hasCustomTitleFont = false;
+    invalidate();
 }
 
 void GroupBox::setTitleFontSize(float fontSize)
@@ -216,6 +221,7 @@ void GroupBox::setTitleFontSize(float fontSize)
     {
         m_titleFontSize = fontSize;
     }
+    invalidate();
 }
 
 void GroupBox::setTitleColor(const Vec4& color)
@@ -223,6 +229,7 @@ void GroupBox::setTitleColor(const Vec4& color)
     Validation::AssertColor(color);
     m_titleColor = color;
     m_hasCustomTitleColor = true;
+    invalidate();
 }
 
 Vec4 GroupBox::getTitleColor() const
@@ -239,6 +246,7 @@ void GroupBox::resetTitleColor()
 {
     m_hasCustomTitleColor = false;
     m_titleColor = Vec4();
+    invalidate();
 }
 
 void GroupBox::setBackgroundColor(const Vec4& color)
@@ -246,6 +254,7 @@ void GroupBox::setBackgroundColor(const Vec4& color)
     Validation::AssertColor(color);
     m_backgroundColor = color;
     m_hasCustomBackground = true;
+    invalidate();
 }
 
 Vec4 GroupBox::getBackgroundColor() const
@@ -262,6 +271,7 @@ void GroupBox::resetBackgroundColor()
 {
     m_hasCustomBackground = false;
     m_backgroundColor = Vec4();
+    invalidate();
 }
 
 void GroupBox::setBorderColor(const Vec4& color)
@@ -269,6 +279,7 @@ void GroupBox::setBorderColor(const Vec4& color)
     Validation::AssertColor(color);
     m_borderColor = color;
     m_hasCustomBorderColor = true;
+    invalidate();
 }
 
 Vec4 GroupBox::getBorderColor() const
@@ -285,24 +296,28 @@ void GroupBox::resetBorderColor()
 {
     m_hasCustomBorderColor = false;
     m_borderColor = Vec4();
+    invalidate();
 }
 
 void GroupBox::setBorderWidth(float width)
 {
     YUCHEN_ASSERT(width >= 0.0f);
     m_borderWidth = width;
+    invalidate();
 }
 
 void GroupBox::setCornerRadius(const CornerRadius& radius)
 {
     Validation::AssertCornerRadius(radius);
     m_cornerRadius = radius;
+    invalidate();
 }
 
 void GroupBox::setCornerRadius(float radius)
 {
     YUCHEN_ASSERT(radius >= 0.0f);
     m_cornerRadius = CornerRadius(radius);
+    invalidate();
 }
 
 bool GroupBox::isValid() const
@@ -48,6 +48,7 @@ Image::Image(const Rect& bounds)
 {
     Validation::AssertRect(bounds);
     setBounds(bounds);
+    setDrawCacheEnabled(true);
 }
 
 Image::~Image()
@@ -87,23 +88,27 @@ void Image::setResource(const char* resourceIdentifier)
 {
     YUCHEN_ASSERT(resourceIdentifier);
     m_resourceIdentifier = resourceIdentifier;
+    invalidate();
 }
 
 void Image::setScaleMode(ScaleMode mode)
 {
     m_scaleMode = mode;
+    invalidate();
 }
 
 void Image::setNineSliceMargins(float left, float top, float right, float bottom)
 {
     m_nineSliceMargins = NineSliceMargins(left, top, right, bottom);
     YUCHEN_ASSERT(m_nineSliceMargins.isValid());
+    invalidate();
 }
 
 void Image::setNineSliceMargins(const NineSliceMargins& margins)
 {
     YUCHEN_ASSERT(margins.isValid());
     m_nineSliceMargins = margins;
+    invalidate();
 }
 
 //==========================================================================================
@@ -122,12 +127,14 @@ void Image::setFrameConfiguration(int frameCount, FrameDirection direction, cons
     if (m_currentFrame >= m_frameCount) {
         m_currentFrame = m_frameCount - 1;
     }
+    invalidate();
 }
 
 void Image::setCurrentFrame(int frameIndex)
 {
     // Clamp frame index to valid range
     m_currentFrame = std::max(0, std::min(frameIndex, m_frameCount - 1));
+    invalidate();
 }
 
 //==========================================================================================
@@ -66,6 +66,7 @@ Knob::Knob(const Rect& bounds)
     
     // Enable focus to support active state
     setFocusPolicy(FocusPolicy::ClickFocus);
+    setDrawCacheEnabled(true);
 }
 
 Knob::~Knob()
@@ -162,6 +163,7 @@ void Knob::setValue(float value)
     if (std::abs(clampedValue - m_value) < 1e-6f) return;
     
     m_value = clampedValue;
+    invalidate();
     
     // Notify callback
     notifyValueChanged();
@@ -173,6 +175,7 @@ void Knob::setValueRange(float minValue, float maxValue)
     
     m_minValue = minValue;
     m_maxValue = maxValue;
+    invalidate();
     
     // Clamp current value to new range
     setValue(m_value);
@@ -194,6 +197,7 @@ void Knob::resetToDefault()
 void Knob::setKnobType(KnobType type)
 {
     m_knobType = type;
+    invalidate();
 }
 
 //==========================================================================================
@@ -24,6 +24,7 @@ RadioButton::RadioButton(const Rect& bounds)
     Validation::AssertRect(bounds);
     setBounds(bounds);
     setFocusPolicy(FocusPolicy::StrongFocus);
+    setDrawCacheEnabled(true);
 }
 
 RadioButton::~RadioButton() {
@@ -80,6 +81,7 @@ bool RadioButton::handleMouseMove(const Vec2& position, const Vec2& offset) {
     bool wasHovered = m_isHovered;
     m_isHovered = absRect.contains(position);
     
+    if (wasHovered != m_isHovered) invalidate();
     return wasHovered != m_isHovered;
 }
 
@@ -149,16 +151,19 @@ void RadioButton::setChecked(bool checked) {
 
 void RadioButton::setText(const std::string& text) {
     m_text = text;
+    invalidate();
 }
 
 void RadioButton::setText(const char* text) {
     YUCHEN_ASSERT(text);
     m_text = text;
+    invalidate();
 }
 
 void RadioButton::setFontSize(float fontSize) {
     if (fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE) {
         m_fontSize = fontSize;
+        invalidate();
     }
 }
 
@@ -166,6 +171,7 @@ void RadioButton::setTextColor(const Vec4& color) {
     Validation::AssertColor(color);
     m_textColor = color;
     m_hasCustomTextColor = true;
+    invalidate();
 }
 
 Vec4 RadioButton::getTextColor() const {
@@ -180,6 +186,7 @@ Vec4 RadioButton::getTextColor() const {
 void RadioButton::resetTextColor() {
     m_hasCustomTextColor = false;
     m_textColor = Vec4();
+    invalidate();
 }
 
 void RadioButton::setCheckedCallback(RadioButtonCheckedCallback callback) {
@@ -209,6 +216,7 @@ bool RadioButton::isValid() const {
 void RadioButton::internalSetChecked(bool checked) {
     if (m_isChecked != checked) {
         m_isChecked = checked;
+        invalidate();
         if (m_checkedCallback) {
             m_checkedCallback(m_isChecked);
         }
@@ -47,6 +47,7 @@ void ScrollArea::setContentSize(const Vec2& size)
     YUCHEN_ASSERT(size.x >= 0.0f && size.y >= 0.0f);
     m_contentSize = size;
     clampScroll();
+    invalidate();
 }
 
 void ScrollArea::setScrollOffset(const Vec2& offset)
@@ -54,18 +55,21 @@ void ScrollArea::setScrollOffset(const Vec2& offset)
     m_scrollX = offset.x;
     m_scrollY = offset.y;
     clampScroll();
+    invalidate();
 }
 
 void ScrollArea::setScrollX(float x)
 {
     m_scrollX = x;
     clampScroll();
+    invalidate();
 }
 
 void ScrollArea::setScrollY(float y)
 {
     m_scrollY = y;
     clampScroll();
+    invalidate();
 }
 
 bool ScrollArea::scrollRectIntoView(const Rect& rect)
@@ -303,7 +307,7 @@ void ScrollArea::addDrawCommands(RenderList& commandList, const Vec2& offset) co
         
         if (isVisible)
         {
-            child->addDrawCommands(commandList, contentOffset);
+            child->render(commandList, contentOffset);
         }
     }
     // ========== 优化结束 ==========
@@ -256,7 +256,10 @@ void SpinBox::update(float deltaTime)
     {
         m_cursorBlinkTimer = 0.0f;
         m_showCursor = !m_showCursor;
+        invalidate();
     }
+    
+    if (m_ownerContext) m_ownerContext->requestAnimationFrame(CURSOR_BLINK_INTERVAL - m_cursorBlinkTimer);
 }
 
 //==========================================================================================
@@ -279,33 +282,39 @@ void SpinBox::setValue(double value)
         m_inputBuffer = formatValue();
         m_cursorPosition = m_inputBuffer.length();
     }
+    invalidate();
 }
 
 void SpinBox::setMinValue(double min)
 {
     m_minValue = min;
     clampValue();
+    invalidate();
 }
 
 void SpinBox::setMaxValue(double max)
 {
     m_maxValue = max;
     clampValue();
+    invalidate();
 }
 
 void SpinBox::setStep(double step)
 {
     m_step = std::abs(step);
+    invalidate();
 }
 
 void SpinBox::setPrecision(int precision)
 {
     m_precision = std::max(0, std::min(10, precision));
+    invalidate();
 }
 
 void SpinBox::setSuffix(const std::string& suffix)
 {
     m_suffix = suffix;
+    invalidate();
 }
 
 void SpinBox::setValueChangedCallback(SpinBoxValueChangedCallback callback)
@@ -321,6 +330,7 @@ void SpinBox::setFontSize(float fontSize) {
     {
         m_fontSize = fontSize;
     }
+    invalidate();
 }
 
 //==========================================================================================
@@ -334,6 +344,7 @@ void SpinBox::setFont(FontHandle fontHandle) {
     FontHandle cjkFont = fontProvider->getDefaultCJKFont();
     m_fontChain = FontFallbackChain(fontHandle, cjkFont);
     m_hasCustomFont = true;
+    invalidate();
 }
 
 void SpinBox::setFontChain(const FontFallbackChain& chain)
@@ -342,6 +353,7 @@ void SpinBox::setFontChain(const FontFallbackChain& chain)
     
     m_fontChain = chain;
     m_hasCustomFont = true;
+    invalidate();
 }
 
 FontFallbackChain SpinBox::getFontChain() const
@@ -355,6 +367,7 @@ FontFallbackChain SpinBox::getFontChain() const
 void SpinBox::resetFont() {
     m_fontChain.clear();
     m_hasCustomFont = false;
+    invalidate();
 }
 
 //==========================================================================================
@@ -364,16 +377,19 @@ void SpinBox::setAlignment(TextAlignment horizontal, VerticalAlignment vertical)
 {
     m_horizontalAlignment = horizontal;
     m_verticalAlignment = vertical;
+    invalidate();
 }
 
 void SpinBox::setHorizontalAlignment(TextAlignment alignment)
 {
     m_horizontalAlignment = alignment;
+    invalidate();
 }
 
 void SpinBox::setVerticalAlignment(VerticalAlignment alignment)
 {
     m_verticalAlignment = alignment;
+    invalidate();
 }
 
 //==========================================================================================
@@ -382,6 +398,7 @@ void SpinBox::setVerticalAlignment(VerticalAlignment alignment)
 void SpinBox::setHasBackground(bool hasBackground)
 {
     m_hasBackground = hasBackground;
+    invalidate();
 }
 
 void SpinBox::setReadOnly(bool readOnly)
@@ -400,6 +417,7 @@ void SpinBox::setReadOnly(bool readOnly)
     {
         setFocusPolicy(FocusPolicy::StrongFocus);
     }
+    invalidate();
 }
 
 void SpinBox::setFocusable(bool focusable)
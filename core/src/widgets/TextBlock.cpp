@@ -6,6 +6,8 @@
 #include "YuchenUI/core/UIContext.h"
 #include "YuchenUI/core/Validation.h"
 #include "YuchenUI/core/Assert.h"
+#include <string_view>
+#include <unordered_map>
 
 namespace YuchenUI {
 
@@ -26,6 +28,9 @@ TextBlock::TextBlock(const Rect& bounds)
     , m_hasCustomTextColor(false)
     , m_cachedLines()
     , m_needsLayout(true)
+    , m_paragraphs()
+    , m_needsShaping(true)
+    , m_layoutWidth(-1.0f)
 {
     Validation::AssertRect(bounds);
     setBounds(bounds);
@@ -38,10 +43,7 @@ TextBlock::~TextBlock() {
 void TextBlock::addDrawCommands(RenderList& commandList, const Vec2& offset) const {
     if (!isVisible() || m_text.empty()) return;
     
-    if (m_needsLayout) {
-        layoutText();
-        m_needsLayout = false;
-    }
+    ensureLayout();
     
     UIStyle* style = m_ownerContext ? m_ownerContext->getCurrentStyle() : nullptr;
     IFontProvider* fontProvider = m_ownerContext ? m_ownerContext->getFontProvider() : nullptr;
@@ -80,7 +82,9 @@ void TextBlock::setText(const std::string& text) {
     if (m_text != text) {
         m_text = text;
         m_needsLayout = true;
+        m_needsShaping = true;
     }
+    invalidate();
 }
 
 void TextBlock::setText(const char* text) {
@@ -99,6 +103,9 @@ void TextBlock::setFont(FontHandle fontHandle) {
     m_fontChain = FontFallbackChain(fontHandle, cjkFont);
     m_hasCustomFont = true;
     m_needsLayout = true;
+    m_needsShaping = true;
+    m_paragraphs.clear();
+    invalidate();
 }
 
 void TextBlock::setFontChain(const FontFallbackChain& chain) {
@@ -109,6 +116,9 @@ void TextBlock::setFontChain(const FontFallbackChain& chain) {
     m_fontChain = chain;
     m_hasCustomFont = true;
     m_needsLayout = true;
+    m_needsShaping = true;
+    m_paragraphs.clear();
+    invalidate();
 }
 
 FontFallbackChain TextBlock::getFontChain() const {
@@ -124,6 +134,9 @@ void TextBlock::resetFont() {
     m_fontChain.clear();
     m_hasCustomFont = false;
     m_needsLayout = true;
+    m_needsShaping = true;
+    m_paragraphs.clear();
+    invalidate();
 }
 
 void TextBlock::setFontSize(float fontSize) {
@@ -131,14 +144,17 @@ void TextBlock::setFontSize(float fontSize) {
         if (m_fontSize != fontSize) {
             m_fontSize = fontSize;
             m_needsLayout = true;
+            m_needsShaping = true;
         }
     }
+    invalidate();
 }
 
 void TextBlock::setTextColor(const Vec4& color) {
     Validation::AssertColor(color);
     m_textColor = color;
     m_hasCustomTextColor = true;
+    invalidate();
 }
 
 Vec4 TextBlock::getTextColor() const {
@@ -153,6 +169,7 @@ Vec4 TextBlock::getTextColor() const {
 void TextBlock::resetTextColor() {
     m_hasCustomTextColor = false;
     m_textColor = Vec4();
+    invalidate();
 }
 
 void TextBlock::setAlignment(TextAlignment horizontal, VerticalAlignment vertical) {
@@ -161,6 +178,7 @@ void TextBlock::setAlignment(TextAlignment horizontal, VerticalAlignment vertica
         m_verticalAlignment = vertical;
         m_needsLayout = true;
     }
+    invalidate();
 }
 
 void TextBlock::setHorizontalAlignment(TextAlignment alignment) {
@@ -168,6 +186,7 @@ void TextBlock::setHorizontalAlignment(TextAlignment alignment) {
         m_horizontalAlignment = alignment;
         m_needsLayout = true;
     }
+    invalidate();
 }
 
 void TextBlock::setVerticalAlignment(VerticalAlignment alignment) {
@@ -175,6 +194,7 @@ void TextBlock::setVerticalAlignment(VerticalAlignment alignment) {
         m_verticalAlignment = alignment;
         m_needsLayout = true;
     }
+    invalidate();
 }
 
 void TextBlock::setPadding(float left, float top, float right, float bottom) {
@@ -186,6 +206,7 @@ void TextBlock::setPadding(float left, float top, float right, float bottom) {
         m_paddingBottom = bottom;
         m_needsLayout = true;
     }
+    invalidate();
 }
 
 void TextBlock::setPadding(float padding) {
@@ -205,6 +226,7 @@ void TextBlock::setLineHeightMultiplier(float multiplier) {
         m_lineHeightMultiplier = multiplier;
         m_needsLayout = true;
     }
+    invalidate();
 }
 
 void TextBlock::setParagraphSpacing(float spacing) {
@@ -213,13 +235,11 @@ void TextBlock::setParagraphSpacing(float spacing) {
         m_paragraphSpacing = spacing;
         m_needsLayout = true;
     }
+    invalidate();
 }
 
 Vec2 TextBlock::calculateContentSize() const {
-    if (m_needsLayout) {
-        layoutText();
-        m_needsLayout = false;
-    }
+    ensureLayout();
     
     if (m_cachedLines.empty()) {
         return Vec2();
@@ -245,8 +265,17 @@ bool TextBlock::isValid() const {
     return true;
 }
 
+void TextBlock::ensureLayout() const {
+    // Resizing changes the wrap width without going through a setter
+    if (!m_needsLayout && getContentWidth() == m_layoutWidth) return;
+    
+    layoutText();
+    m_needsLayout = false;
+}
+
 void TextBlock::layoutText() const {
     m_cachedLines.clear();
+    m_layoutWidth = getContentWidth();
     
     if (m_text.empty()) return;
     
@@ -262,22 +291,23 @@ void TextBlock::layoutText() const {
     FontHandle westernFont = fallbackChain.getPrimary();
     FontMetrics metrics = fontProvider->getFontMetrics(westernFont, m_fontSize);
     
-    float lineHeight[[maybe_unused]] = metrics.lineHeight * m_lineHeightMultiplier;
-    float contentWidth = m_bounds.width - m_paddingLeft - m_paddingRight;
+    if (m_layoutWidth <= 0.0f) return;
     
-    if (contentWidth <= 0.0f) return;
+    if (m_needsShaping) {
+        updateParagraphs(fontProvider);
+        m_needsShaping = false;
+    }
     
-    std::vector<std::string> paragraphs = splitIntoParagraphs(m_text);
     float currentY = m_paddingTop;
     
-    for (size_t i = 0; i < paragraphs.size(); ++i) {
-        layoutParagraph(paragraphs[i], currentY, m_cachedLines);
+    for (size_t i = 0; i < m_paragraphs.size(); ++i) {
+        layoutParagraph(m_paragraphs[i], currentY, metrics, m_cachedLines);
         
         if (!m_cachedLines.empty()) {
             const TextLine& lastLine = m_cachedLines.back();
             currentY = lastLine.position.y + lastLine.height;
             
-            if (i < paragraphs.size() - 1) {
+            if (i < m_paragraphs.size() - 1) {
                 currentY += m_paragraphSpacing;
             }
         }
@@ -307,45 +337,62 @@ void TextBlock::layoutText() const {
     }
 }
 
-std::vector<std::string> TextBlock::splitIntoParagraphs(const std::string& text) const {
-    std::vector<std::string> paragraphs;
+void TextBlock::updateParagraphs(IFontProvider* fontProvider) const {
+    // Paragraphs are separated by '\n'; a trailing '\n' does not start another one
+    std::vector<std::string_view> texts;
     size_t start = 0;
-    size_t pos = 0;
-    
-    while (pos < text.length()) {
-        if (text[pos] == '\n') {
-            paragraphs.push_back(text.substr(start, pos - start));
+    for (size_t pos = 0; pos < m_text.length(); ++pos) {
+        if (m_text[pos] == '\n') {
+            texts.emplace_back(m_text.data() + start, pos - start);
             start = pos + 1;
         }
-        ++pos;
     }
-    
-    if (start < text.length()) {
-        paragraphs.push_back(text.substr(start));
+    if (start < m_text.length()) texts.emplace_back(m_text.data() + start, m_text.length() - start);
+    if (texts.empty()) texts.emplace_back();
+    
+    std::vector<LineBreaker> previous;
+    previous.swap(m_paragraphs);
+    if (!previous.empty() && previous.front().getFontSize() != m_fontSize) previous.clear();
+    
+    // Paragraphs whose text did not change keep their shaping, wherever they moved to, so
+    // editing or appending to a long text only shapes the paragraphs it touched
+    constexpr size_t NONE = static_cast<size_t>(-1);
+    std::vector<size_t> sources(texts.size(), NONE);
+    if (!previous.empty()) {
+        std::unordered_map<std::string_view, size_t> previousIndex;
+        previousIndex.reserve(previous.size());
+        for (size_t i = 0; i < previous.size(); ++i) {
+            previousIndex.emplace(previous[i].getText(), i);
+        }
+        for (size_t i = 0; i < texts.size(); ++i) {
+            auto it = previousIndex.find(texts[i]);
+            if (it != previousIndex.end()) sources[i] = it->second;
+        }
     }
     
-    if (paragraphs.empty()) {
-        paragraphs.push_back("");
+    std::vector<size_t> movedTo(previous.size(), NONE);
+    m_paragraphs.reserve(texts.size());
+    
+    for (size_t i = 0; i < texts.size(); ++i) {
+        const size_t source = sources[i];
+        if (source == NONE) {
+            m_paragraphs.emplace_back();
+            m_paragraphs.back().setParagraph(std::string(texts[i]), fontProvider, m_fontSize);
+        } else if (movedTo[source] == NONE) {
+            movedTo[source] = i;
+            m_paragraphs.push_back(std::move(previous[source]));
+        } else {
+            // Repeated paragraph: copying the shaping is cheaper than shaping again
+            m_paragraphs.push_back(m_paragraphs[movedTo[source]]);
+        }
     }
-    
-    return paragraphs;
 }
 
-void TextBlock::layoutParagraph(const std::string& paragraph, float startY, std::vector<TextLine>& lines) const {
-    // Get font provider and style via UIContext
-    IFontProvider* fontProvider = m_ownerContext ? m_ownerContext->getFontProvider() : nullptr;
-    UIStyle* style = m_ownerContext ? m_ownerContext->getCurrentStyle() : nullptr;
-    YUCHEN_ASSERT(fontProvider);
-    YUCHEN_ASSERT(style);
+void TextBlock::layoutParagraph(LineBreaker& paragraph, float startY, const FontMetrics& metrics, std::vector<TextLine>& lines) const {
+    float lineHeight = metrics.lineHeight * m_lineHeightMultiplier;
+    const std::string& text = paragraph.getText();
     
-    if (paragraph.empty()) {
-        FontFallbackChain fallbackChain = m_hasCustomFont
-            ? m_fontChain
-            : style->getDefaultLabelFontChain();
-        FontHandle westernFont = fallbackChain.getPrimary();
-        FontMetrics metrics = fontProvider->getFontMetrics(westernFont, m_fontSize);
-        float lineHeight = metrics.lineHeight * m_lineHeightMultiplier;
-        
+    if (text.empty()) {
         TextLine emptyLine;
         emptyLine.text = "";
         emptyLine.width = 0.0f;
@@ -355,37 +402,22 @@ void TextBlock::layoutParagraph(const std::string& paragraph, float startY, std:
         return;
     }
     
-    FontFallbackChain fallbackChain = m_hasCustomFont
-        ? m_fontChain
-        : style->getDefaultLabelFontChain();
-    FontHandle westernFont = fallbackChain.getPrimary();
-    FontMetrics metrics = fontProvider->getFontMetrics(westernFont, m_fontSize);
-    
-    float lineHeight = metrics.lineHeight * m_lineHeightMultiplier;
-    float contentWidth = m_bounds.width - m_paddingLeft - m_paddingRight;
+    float contentWidth = getContentWidth();
     float currentY = startY;
     
-    size_t offset = 0;
-    while (offset < paragraph.length()) {
-        size_t consumed = 0;
-        std::string lineText = wrapLine(paragraph.substr(offset), contentWidth, consumed);
-        
-        if (consumed == 0) break;
-        
-        float textWidth = measureTextWidth(lineText);
-        
+    for (const LineBreakSpan& span : paragraph.breakLines(contentWidth)) {
         TextLine line;
-        line.text = lineText;
-        line.width = textWidth;
+        line.text.assign(text, span.byteStart, span.byteLength);
+        line.width = span.width;
         line.height = lineHeight;
         
         float xPos = m_paddingLeft;
         switch (m_horizontalAlignment) {
             case TextAlignment::Center:
-                xPos = m_paddingLeft + (contentWidth - textWidth) * 0.5f;
+                xPos = m_paddingLeft + (contentWidth - span.width) * 0.5f;
                 break;
             case TextAlignment::Right:
-                xPos = m_paddingLeft + contentWidth - textWidth;
+                xPos = m_paddingLeft + contentWidth - span.width;
                 break;
             case TextAlignment::Justify:
                 xPos = m_paddingLeft;
@@ -396,78 +428,10 @@ void TextBlock::layoutParagraph(const std::string& paragraph, float startY, std:
         }
         
         line.position = Vec2(xPos, currentY + metrics.ascender);
-        lines.push_back(line);
+        lines.push_back(std::move(line));
         
         currentY += lineHeight;
-        offset += consumed;
     }
 }
 
-std::string TextBlock::wrapLine(const std::string& text, float maxWidth, size_t& outConsumed) const {
-    if (text.empty()) {
-        outConsumed = 0;
-        return "";
-    }
-    
-    float currentWidth = 0.0f;
-    size_t lastBreakPos = 0;
-    size_t currentPos = 0;
-    bool hasContent = false;
-    
-    while (currentPos < text.length()) {
-        size_t nextPos = currentPos + 1;
-        
-        unsigned char c = static_cast<unsigned char>(text[currentPos]);
-        if ((c & 0x80) != 0) {
-            if ((c & 0xE0) == 0xC0) nextPos = currentPos + 2;
-            else if ((c & 0xF0) == 0xE0) nextPos = currentPos + 3;
-            else if ((c & 0xF8) == 0xF0) nextPos = currentPos + 4;
-        }
-        
-        if (nextPos > text.length()) break;
-        
-        std::string charStr = text.substr(currentPos, nextPos - currentPos);
-        float charWidth = measureTextWidth(charStr);
-        
-        if (currentWidth + charWidth > maxWidth) {
-            if (hasContent) {
-                if (lastBreakPos > 0) {
-                    outConsumed = lastBreakPos;
-                    return text.substr(0, lastBreakPos);
-                }
-                outConsumed = currentPos;
-                return text.substr(0, currentPos);
-            }
-            
-            outConsumed = nextPos;
-            return charStr;
-        }
-        
-        currentWidth += charWidth;
-        hasContent = true;
-        
-        if (text[currentPos] == ' ' || text[currentPos] == '\t') {
-            lastBreakPos = nextPos;
-        } else if ((c & 0x80) != 0) {
-            lastBreakPos = nextPos;
-        }
-        
-        currentPos = nextPos;
-    }
-    
-    outConsumed = text.length();
-    return text;
-}
-
-float TextBlock::measureTextWidth(const std::string& text) const {
-    if (text.empty()) return 0.0f;
-    
-    // Get font provider via UIContext instead of deprecated singleton
-    IFontProvider* fontProvider = m_ownerContext ? m_ownerContext->getFontProvider() : nullptr;
-    if (!fontProvider) return 0.0f;
-    
-    Vec2 size = fontProvider->measureText(text.c_str(), m_fontSize);
-    return size.x;
-}
-
 }
@@ -3,6 +3,7 @@
 #include "YuchenUI/core/IUIContent.h"
 #include "YuchenUI/core/UIContext.h"
 #include "YuchenUI/text/IFontProvider.h"
+#include "YuchenUI/text/TextUtils.h"
 #include "YuchenUI/theme/IThemeProvider.h"
 #include "YuchenUI/theme/Theme.h"
 #include "YuchenUI/core/Validation.h"
@@ -17,6 +18,8 @@ TextInput::TextInput(const Rect& bounds)
     : m_text()
     , m_textUTF32()
     , m_placeholder()
+    , m_caretStops()
+    , m_caretStopsValid(false)
     , m_cursorPosition(0)
     , m_selectionStart(0)
     , m_selectionEnd(0)
@@ -112,11 +115,17 @@ void TextInput::addDrawCommands(RenderList& commandList, const Vec2& offset) con
     
     info.showCursor = m_showCursor && m_hasFocus;
     if (info.showCursor) {
-        std::u32string displayU32 = utf8ToUtf32(displayText);
-        size_t measurePos = std::min(visualCursorPos, displayU32.length());
-        std::string measureText = utf32ToUtf8(displayU32.substr(0, measurePos));
+        float textCursorX = 0.0f;
+        if (hasComposition) {
+            std::u32string displayU32 = utf8ToUtf32(displayText);
+            size_t measurePos = std::min(visualCursorPos, displayU32.length());
+            std::string measureText = utf32ToUtf8(displayU32.substr(0, measurePos));
+            textCursorX = fontProvider->measureText(measureText.c_str(), m_fontSize).x;
+        } else {
+            textCursorX = measureTextToPosition(visualCursorPos);
+        }
         
-        float cursorX = m_paddingLeft + fontProvider->measureText(measureText.c_str(), m_fontSize).x - m_scrollOffset;
+        float cursorX = m_paddingLeft + textCursorX - m_scrollOffset;
         info.cursorX = info.bounds.x + cursorX;
         info.cursorHeight = metrics.lineHeight;
     } else {
@@ -367,6 +376,7 @@ void TextInput::setText(const std::string& text) {
     
     m_text = text;
     m_textUTF32 = utf8ToUtf32(text);
+    invalidateCaretStops();
     
     m_cursorPosition = std::min(m_cursorPosition, m_textUTF32.length());
     m_selectionStart = 0;
@@ -374,10 +384,12 @@ void TextInput::setText(const std::string& text) {
     m_scrollOffset = 0.0f;
     
     notifyTextChanged();
+    invalidate();
 }
 
 void TextInput::setPlaceholder(const std::string& placeholder) {
     m_placeholder = placeholder;
+    invalidate();
 }
 
 void TextInput::setMaxLength(size_t maxLength) {
@@ -386,6 +398,7 @@ void TextInput::setMaxLength(size_t maxLength) {
 
 void TextInput::setPasswordMode(bool enabled) {
     m_isPasswordMode = enabled;
+    invalidateCaretStops();
     if (enabled) {
         m_inputType = TextInputType::Password;
     } else if (m_inputType == TextInputType::Password) {
@@ -395,6 +408,7 @@ void TextInput::setPasswordMode(bool enabled) {
     if (m_hasFocus && m_ownerContext) {
         m_ownerContext->requestTextInput(!shouldDisableIME());
     }
+    invalidate();
 }
 
 void TextInput::setInputType(TextInputType type) {
@@ -405,10 +419,12 @@ void TextInput::setInputType(TextInputType type) {
     } else if (m_inputType == TextInputType::Password) {
         m_isPasswordMode = false;
     }
+    invalidateCaretStops();
     
     if (m_hasFocus && m_ownerContext) {
         m_ownerContext->requestTextInput(!shouldDisableIME());
     }
+    invalidate();
 }
 
 bool TextInput::shouldDisableIME() const {
@@ -431,13 +447,16 @@ void TextInput::setSubmitCallback(TextInputSubmitCallback callback) {
 void TextInput::setFontSize(float fontSize) {
     if (fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE) {
         m_fontSize = fontSize;
+        invalidateCaretStops();
     }
+    invalidate();
 }
 
 void TextInput::setTextColor(const Vec4& color) {
     Validation::AssertColor(color);
     m_textColor = color;
     m_hasCustomTextColor = true;
+    invalidate();
 }
 
 Vec4 TextInput::getTextColor() const {
@@ -452,6 +471,7 @@ Vec4 TextInput::getTextColor() const {
 void TextInput::resetTextColor() {
     m_hasCustomTextColor = false;
     m_textColor = Vec4();
+    invalidate();
 }
 
 void TextInput::setPadding(float padding) {
@@ -463,17 +483,20 @@ void TextInput::setPadding(float left, float top, float right, float bottom) {
     m_paddingTop = top;
     m_paddingRight = right;
     m_paddingBottom = bottom;
+    invalidate();
 }
 
 void TextInput::selectAll() {
     m_selectionStart = 0;
     m_selectionEnd = m_textUTF32.length();
     m_cursorPosition = m_selectionEnd;
+    invalidate();
 }
 
 void TextInput::clearSelection() {
     m_selectionStart = 0;
     m_selectionEnd = 0;
+    invalidate();
 }
 
 bool TextInput::hasSelection() const {
@@ -487,7 +510,10 @@ void TextInput::update(float deltaTime) {
     if (m_cursorBlinkTimer >= CURSOR_BLINK_INTERVAL) {
         m_cursorBlinkTimer = 0.0f;
         m_showCursor = !m_showCursor;
+        invalidate();
     }
+    
+    if (m_ownerContext) m_ownerContext->requestAnimationFrame(CURSOR_BLINK_INTERVAL - m_cursorBlinkTimer);
 }
 
 bool TextInput::isValid() const {
@@ -498,45 +524,7 @@ bool TextInput::isValid() const {
 
 std::u32string TextInput::utf8ToUtf32(const std::string& utf8) {
     std::u32string result;
-    result.reserve(utf8.length());
-    
-    for (size_t i = 0; i < utf8.length();) {
-        unsigned char c = utf8[i];
-        char32_t codepoint = 0;
-        
-        if ((c & 0x80) == 0) {
-            codepoint = c;
-            i += 1;
-        } else if ((c & 0xE0) == 0xC0) {
-            if (i + 1 < utf8.length()) {
-                codepoint = ((c & 0x1F) << 6) | (utf8[i + 1] & 0x3F);
-                i += 2;
-            } else {
-                break;
-            }
-        } else if ((c & 0xF0) == 0xE0) {
-            if (i + 2 < utf8.length()) {
-                codepoint = ((c & 0x0F) << 12) | ((utf8[i + 1] & 0x3F) << 6) | (utf8[i + 2] & 0x3F);
-                i += 3;
-            } else {
-                break;
-            }
-        } else if ((c & 0xF8) == 0xF0) {
-            if (i + 3 < utf8.length()) {
-                codepoint = ((c & 0x07) << 18) | ((utf8[i + 1] & 0x3F) << 12) |
-                           ((utf8[i + 2] & 0x3F) << 6) | (utf8[i + 3] & 0x3F);
-                i += 4;
-            } else {
-                break;
-            }
-        } else {
-            i += 1;
-            continue;
-        }
-        
-        result.push_back(codepoint);
-    }
-    
+    TextUtils::decodeUTF8ToUTF32(utf8.data(), utf8.size(), result);
     return result;
 }
 
@@ -584,6 +572,7 @@ void TextInput::insertTextAtCursor(const std::string& text) {
         m_text = utf32ToUtf8(m_textUTF32);
         return;
     }
+    invalidateCaretStops();
     
     m_cursorPosition += u32text.length();
     adjustScrollToCursor();
@@ -598,6 +587,7 @@ void TextInput::deleteSelection() {
     
     m_textUTF32.erase(start, end - start);
     m_text = utf32ToUtf8(m_textUTF32);
+    invalidateCaretStops();
     
     m_cursorPosition = start;
     m_selectionStart = 0;
@@ -612,6 +602,7 @@ void TextInput::deleteCharacterBefore() {
     
     m_textUTF32.erase(m_cursorPosition - 1, 1);
     m_text = utf32ToUtf8(m_textUTF32);
+    invalidateCaretStops();
     
     m_cursorPosition--;
     adjustScrollToCursor();
@@ -623,6 +614,7 @@ void TextInput::deleteCharacterAfter() {
     
     m_textUTF32.erase(m_cursorPosition, 1);
     m_text = utf32ToUtf8(m_textUTF32);
+    invalidateCaretStops();
     
     adjustScrollToCursor();
     notifyTextChanged();
@@ -753,27 +745,10 @@ float TextInput::measureTextToPosition(size_t charIndex) const {
         return 0.0f;
     }
     
-    charIndex = std::min(charIndex, m_textUTF32.length());
-    
-    std::u32string substr = m_textUTF32.substr(0, charIndex);
-    std::string utf8substr = utf32ToUtf8(substr);
+    const std::vector<float>& stops = getCaretStops();
+    if (stops.empty()) return 0.0f;
     
-    if (m_isPasswordMode) {
-        utf8substr = std::string(charIndex * 3, '\xe2');
-        for (size_t i = 0; i < charIndex; ++i) {
-            utf8substr[i * 3] = '\xe2';
-            utf8substr[i * 3 + 1] = '\x80';
-            utf8substr[i * 3 + 2] = '\xa2';
-        }
-    }
-    
-    // Get font provider via UIContext instead of deprecated singleton
-    IFontProvider* fontProvider = m_ownerContext ? m_ownerContext->getFontProvider() : nullptr;
-    if (!fontProvider) return 0.0f;
-    
-    Vec2 size = fontProvider->measureText(utf8substr.c_str(), m_fontSize);
-    
-    return size.x;
+    return stops[std::min(charIndex, stops.size() - 1)];
 }
 
 size_t TextInput::positionToCharIndex(float x, const Vec2& offset) const {
@@ -783,22 +758,45 @@ size_t TextInput::positionToCharIndex(float x, const Vec2& offset) const {
     if (relativeX <= 0.0f) return 0;
     if (m_textUTF32.empty()) return 0;
     
-    for (size_t i = 0; i <= m_textUTF32.length(); i++) {
-        float charX = measureTextToPosition(i);
-        
-        if (i < m_textUTF32.length()) {
-            float nextCharX = measureTextToPosition(i + 1);
-            float midPoint = (charX + nextCharX) / 2.0f;
-            
-            if (relativeX < midPoint) {
-                return i;
-            }
-        } else {
-            return i;
-        }
+    const std::vector<float>& stops = getCaretStops();
+    if (stops.empty()) return 0;
+    
+    // First stop right of x; x lies between it and the one before, the nearer one wins
+    auto next = std::upper_bound(stops.begin(), stops.end(), relativeX);
+    if (next == stops.end()) return m_textUTF32.length();
+    
+    size_t nextIndex = static_cast<size_t>(next - stops.begin());
+    float midPoint = (stops[nextIndex - 1] + stops[nextIndex]) / 2.0f;
+    
+    return relativeX < midPoint ? nextIndex - 1 : nextIndex;
+}
+
+const std::vector<float>& TextInput::getCaretStops() const {
+    if (m_caretStopsValid) return m_caretStops;
+    
+    m_caretStops.clear();
+    
+    // Get font provider via UIContext instead of deprecated singleton
+    IFontProvider* fontProvider = m_ownerContext ? m_ownerContext->getFontProvider() : nullptr;
+    if (!fontProvider) return m_caretStops;
+    
+    if (m_isPasswordMode) {
+        std::string bullets;
+        bullets.reserve(m_textUTF32.length() * 3);
+        for (size_t i = 0; i < m_textUTF32.length(); ++i) bullets += "\xe2\x80\xa2";
+        fontProvider->measureCaretStops(bullets.c_str(), m_fontSize, m_caretStops);
+    } else {
+        fontProvider->measureCaretStops(m_text.c_str(), m_fontSize, m_caretStops);
     }
     
-    return m_textUTF32.length();
+    // An embedded NUL ends the measured string early; characters after it get no width
+    m_caretStops.resize(m_textUTF32.length() + 1, m_caretStops.back());
+    m_caretStopsValid = true;
+    return m_caretStops;
+}
+
+void TextInput::invalidateCaretStops() {
+    m_caretStopsValid = false;
 }
 
 void TextInput::adjustScrollToCursor() {
@@ -25,6 +25,7 @@ TextLabel::TextLabel(const Rect& bounds)
     Validation::AssertRect(bounds);
     setBounds(bounds);
     YUCHEN_ASSERT(bounds.width >= 0.0f && bounds.height >= 0.0f);
+    setDrawCacheEnabled(true);
 }
 
 TextLabel::~TextLabel() {
@@ -100,6 +101,7 @@ void TextLabel::addDrawCommands(RenderList& commandList, const Vec2& offset) con
 
 void TextLabel::setText(const std::string& text) {
     m_text = text;
+    invalidate();
 }
 
 void TextLabel::setText(const char* text) {
@@ -117,6 +119,7 @@ void TextLabel::setFont(FontHandle fontHandle) {
     FontHandle cjkFont = fontProvider->getDefaultCJKFont();
     m_fontChain = FontFallbackChain(fontHandle, cjkFont);
     m_hasCustomFont = true;
+    invalidate();
 }
 
 void TextLabel::setFontChain(const FontFallbackChain& chain) {
@@ -126,6 +129,7 @@ void TextLabel::setFontChain(const FontFallbackChain& chain) {
     
     m_fontChain = chain;
     m_hasCustomFont = true;
+    invalidate();
 }
 
 FontFallbackChain TextLabel::getFontChain() const {
@@ -140,11 +144,13 @@ FontFallbackChain TextLabel::getFontChain() const {
 void TextLabel::resetFont() {
     m_fontChain.clear();
     m_hasCustomFont = false;
+    invalidate();
 }
 
 void TextLabel::setFontSize(float fontSize) {
     if (fontSize >= Config::Font::MIN_SIZE && fontSize <= Config::Font::MAX_SIZE) {
         m_fontSize = fontSize;
+        invalidate();
     }
 }
 
@@ -152,6 +158,7 @@ void TextLabel::setTextColor(const Vec4& color) {
     Validation::AssertColor(color);
     m_textColor = color;
     m_hasCustomTextColor = true;
+    invalidate();
 }
 
 Vec4 TextLabel::getTextColor() const {
@@ -166,19 +173,23 @@ Vec4 TextLabel::getTextColor() const {
 void TextLabel::resetTextColor() {
     m_hasCustomTextColor = false;
     m_textColor = Vec4();
+    invalidate();
 }
 
 void TextLabel::setAlignment(TextAlignment horizontal, VerticalAlignment vertical) {
     m_horizontalAlignment = horizontal;
     m_verticalAlignment = vertical;
+    invalidate();
 }
 
 void TextLabel::setHorizontalAlignment(TextAlignment alignment) {
     m_horizontalAlignment = alignment;
+    invalidate();
 }
 
 void TextLabel::setVerticalAlignment(VerticalAlignment alignment) {
     m_verticalAlignment = alignment;
+    invalidate();
 }
 
 void TextLabel::setPadding(float left, float top, float right, float bottom) {
@@ -186,6 +197,7 @@ void TextLabel::setPadding(float left, float top, float right, float bottom) {
     m_paddingTop = top;
     m_paddingRight = right;
     m_paddingBottom = bottom;
+    invalidate();
 }
 
 void TextLabel::setPadding(float padding) {
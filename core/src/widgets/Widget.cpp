@@ -4,6 +4,7 @@
 #include "YuchenUI/core/IUIContent.h"
 #include "YuchenUI/core/Validation.h"
 #include "YuchenUI/core/Assert.h"
+#include "YuchenUI/core/Config.h"
 #include "YuchenUI/focus/FocusManager.h"
 #include "YuchenUI/rendering/RenderList.h"
 #include "YuchenUI/theme/Theme.h"
@@ -30,6 +31,14 @@ Widget::Widget()
     , m_focusProxy(nullptr)
     , m_showFocusIndicator(true)
     , m_focusManagerAccessor(nullptr)
+    , m_drawCacheEnabled(false)
+    , m_drawCacheValid(false)
+    , m_drawCacheStyleRevision(0)
+    , m_drawCache()
+    , m_lastRenderOffset()
+    , m_lastRenderBounds()
+    , m_hasRendered(false)
+    , m_lastCommandCount(0)
 {
 }
 
@@ -45,12 +54,14 @@ void Widget::setBounds(const Rect& bounds)
 {
     Validation::AssertRect(bounds);
     m_bounds = bounds;
+    invalidate();
 }
 
 void Widget::setPadding(float padding)
 {
     YUCHEN_ASSERT(padding >= 0.0f);
     m_paddingLeft = m_paddingTop = m_paddingRight = m_paddingBottom = padding;
+    invalidate();
 }
 
 void Widget::setPadding(float left, float top, float right, float bottom)
@@ -60,6 +71,7 @@ void Widget::setPadding(float left, float top, float right, float bottom)
     m_paddingTop = top;
     m_paddingRight = right;
     m_paddingBottom = bottom;
+    invalidate();
 }
 
 Rect Widget::getContentRect() const
@@ -137,6 +149,7 @@ void Widget::setVisible(bool visible)
     if (m_isVisible == visible) return;
     
     m_isVisible = visible;
+    invalidate();
     
     if (!visible && m_hasFocus)
     {
@@ -149,6 +162,7 @@ void Widget::setEnabled(bool enabled)
     if (m_isEnabled == enabled) return;
     
     m_isEnabled = enabled;
+    invalidate();
     
     if (!enabled && m_hasFocus)
     {
@@ -156,12 +170,105 @@ void Widget::setEnabled(bool enabled)
     }
 }
 
+//======================================================================================
+// Display List Cache
+
+void Widget::render(RenderList& commandList, const Vec2& offset) const
+{
+    if (!isVisible()) return;
+    
+    // Remember where this widget lands so invalidate() can damage the right area
+    const Rect windowBounds(offset.x + m_bounds.x, offset.y + m_bounds.y, m_bounds.width, m_bounds.height);
+    m_lastRenderOffset = offset;
+    m_lastRenderBounds = windowBounds;
+    m_hasRendered = true;
+    
+    if (commandList.isCulled(windowBounds.expanded(Config::Rendering::DAMAGE_OUTSET)))
+    {
+        commandList.addCulledCommands(m_lastCommandCount);
+        return;
+    }
+    
+    const size_t firstCommand = commandList.getCommandCount();
+    
+    if (!m_drawCacheEnabled || !m_ownedChildren.empty())
+    {
+        addDrawCommands(commandList, offset);
+        m_lastCommandCount = commandList.getCommandCount() - firstCommand;
+        return;
+    }
+    
+    const uint64_t styleRevision = getStyleRevision();
+    
+    if (!m_drawCacheValid || m_drawCacheStyleRevision != styleRevision)
+    {
+        if (!m_drawCache)
+        {
+            m_drawCache = std::make_unique<RenderList>(Config::Rendering::WIDGET_CACHE_COMMANDS,
+                                                       Config::Rendering::WIDGET_CACHE_ARENA_BLOCK);
+        }
+        
+        m_drawCache->reset();
+        addDrawCommands(*m_drawCache, Vec2(-m_bounds.x, -m_bounds.y));
+        m_drawCacheValid = true;
+        m_drawCacheStyleRevision = styleRevision;
+    }
+    
+    commandList.append(*m_drawCache, Vec2(offset.x + m_bounds.x, offset.y + m_bounds.y));
+    m_lastCommandCount = commandList.getCommandCount() - firstCommand;
+}
+
+void Widget::invalidate()
+{
+    m_drawCacheValid = false;
+    
+    if (!m_ownerContext) return;
+    
+    // Never drawn: the window position is unknown, so repaint everything
+    if (!m_hasRendered)
+    {
+        m_ownerContext->requestRedraw();
+        return;
+    }
+    
+    // Damage where the widget was drawn and where it will be drawn now. The parent
+    // offset is assumed unchanged; a moving parent damages its own area.
+    const float outset = Config::Rendering::DAMAGE_OUTSET;
+    const Rect current(m_lastRenderOffset.x + m_bounds.x, m_lastRenderOffset.y + m_bounds.y,
+                       m_bounds.width, m_bounds.height);
+    
+    m_ownerContext->invalidateRect(m_lastRenderBounds.expanded(outset));
+    if (current != m_lastRenderBounds)
+        m_ownerContext->invalidateRect(current.expanded(outset));
+}
+
+void Widget::setDrawCacheEnabled(bool enabled)
+{
+    if (m_drawCacheEnabled == enabled) return;
+    
+    m_drawCacheEnabled = enabled;
+    m_drawCacheValid = false;
+    
+    if (!enabled) m_drawCache.reset();
+}
+
+bool Widget::isDrawCacheValid() const
+{
+    return m_drawCacheEnabled && m_drawCacheValid && m_drawCacheStyleRevision == getStyleRevision();
+}
+
+uint64_t Widget::getStyleRevision() const
+{
+    return m_ownerContext ? m_ownerContext->getCurrentStyle()->getRevision() : 0;
+}
+
 //======================================================================================
 // Context and Ownership
 
 void Widget::setOwnerContext(UIContext* context)
 {
     m_ownerContext = context;
+    invalidate();
     
     if (context)
     {
@@ -319,6 +426,7 @@ void Widget::drawFocusIndicator(RenderList& commandList, const Vec2& offset) con
 void Widget::notifyFocusIn(FocusReason reason)
 {
     m_hasFocus = true;
+    invalidate();
     onFocusIn(reason);
     focusInEvent(reason);
 }
@@ -326,6 +434,7 @@ void Widget::notifyFocusIn(FocusReason reason)
 void Widget::notifyFocusOut(FocusReason reason)
 {
     m_hasFocus = false;
+    invalidate();
     onFocusOut(reason);
     focusOutEvent(reason);
 }
@@ -376,8 +485,8 @@ void Widget::renderChildren(RenderList& commandList, const Vec2& offset) const
 {
     for (const auto* child : m_ownedChildren)
     {
-        if (child && child->isVisible())
-            child->addDrawCommands(commandList, offset);
+        if (child)
+            child->render(commandList, offset);
     }
 }
 
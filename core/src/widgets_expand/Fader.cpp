@@ -220,6 +220,7 @@ void Fader::setValue(float linearValue)
     
     m_value = clampedValue;
     notifyValueChanged();
+    invalidate();
 }
 
 void Fader::setValueDb(float dbValue)
@@ -238,11 +239,13 @@ float Fader::getValueDb() const
 void Fader::setColorTheme(FaderColorTheme theme)
 {
     m_colorTheme = theme;
+    invalidate();
 }
 
 void Fader::setShowScale(bool visible)
 {
     m_showScale = visible;
+    invalidate();
 }
 
 //==========================================================================================
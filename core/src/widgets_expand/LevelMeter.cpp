@@ -32,10 +32,6 @@ float MeterDimensions::getChannelWidth(size_t totalChannelCount)
     if (totalChannelCount == 2) return STEREO_CHANNEL_WIDTH;
     return MULTI_CHANNEL_WIDTH;
 }
-constexpr float MeterDimensions::getTotalHeight()
-{
-    return PEAK_INDICATOR_SPACING + PEAK_INDICATOR_HEIGHT + PEAK_INDICATOR_SPACING + DEFAULT_HEIGHT;
-}
 float MeterDimensions::getChannelGroupWidth(size_t channelCount)
 {
     if (channelCount == 0) return 0.0f;
@@ -430,26 +426,22 @@ void LevelDataManager::clearControlVoltage()
 //==========================================================================================
 // BlendedColorCache Implementation
 BlendedColorCache::BlendedColorCache()
-    : channelWidth_(0.0f)
-    , blendTexturePixelCount_(0)
-    , initializedForChannelCount_(0)
+    : normalProfile_()
+    , warningProfile_()
     , initialized_(false)
 {
 }
 
 void BlendedColorCache::initialize(size_t totalChannelCount)
 {
-    if (initialized_ && initializedForChannelCount_ == totalChannelCount) return;
-    channelWidth_ = MeterDimensions::getChannelWidth(totalChannelCount);
-    float innerWidth = channelWidth_ - 2.0f;
-    blendTexturePixelCount_ = static_cast<int>(innerWidth * 2.0f);
-    blendCache_.clear();
-    initializedForChannelCount_ = totalChannelCount;
+    // The profile is resolution independent; the gradient is stretched to each channel
+    (void)totalChannelCount;
+    if (initialized_) return;
+    initializeProfiles();
     initialized_ = true;
-    initializeTextures();
 }
 
-void BlendedColorCache::initializeTextures()
+void BlendedColorCache::initializeProfiles()
 {
     const float normalEdge = 204.0f;
     const float normalCenter = 255.0f;
@@ -461,16 +453,13 @@ void BlendedColorCache::initializeTextures()
     const float warningCenterB = 255.0f;
     constexpr float PI = 3.14159265359f;
     
-    normalTexture_.pixels.resize(blendTexturePixelCount_);
-    warningTexture_.pixels.resize(blendTexturePixelCount_);
-    float center = (blendTexturePixelCount_ - 1) * 0.5f;
-    
-    for (int i = 0; i < blendTexturePixelCount_; ++i)
+    for (size_t i = 0; i < LIGHTING_STOP_COUNT; ++i)
     {
-        float distanceFromCenter = std::abs(i - center) / center;
+        float position = static_cast<float>(i) / (LIGHTING_STOP_COUNT - 1);
+        float distanceFromCenter = std::abs(position * 2.0f - 1.0f);
         float cosineWeight = (1.0f + std::cos(distanceFromCenter * PI)) * 0.5f;
         float normalValue = normalEdge + (normalCenter - normalEdge) * cosineWeight;
-        normalTexture_.pixels[i] = Vec4::FromRGBA(
+        normalProfile_[i] = Vec4::FromRGBA(
             static_cast<uint8_t>(std::round(normalValue)),
             static_cast<uint8_t>(std::round(normalValue)),
             static_cast<uint8_t>(std::round(normalValue)),
@@ -479,7 +468,7 @@ void BlendedColorCache::initializeTextures()
         float warningR = warningEdgeR + (warningCenterR - warningEdgeR) * cosineWeight;
         float warningG = warningEdgeG + (warningCenterG - warningEdgeG) * cosineWeight;
         float warningB = warningEdgeB + (warningCenterB - warningEdgeB) * cosineWeight;
-        warningTexture_.pixels[i] = Vec4::FromRGBA(
+        warningProfile_[i] = Vec4::FromRGBA(
             static_cast<uint8_t>(std::round(warningR)),
             static_cast<uint8_t>(std::round(warningG)),
             static_cast<uint8_t>(std::round(warningB)),
@@ -488,28 +477,16 @@ void BlendedColorCache::initializeTextures()
     }
 }
 
-Vec4 BlendedColorCache::getBlendedColor(const Vec4& baseColor, float x, bool isWarningRegion) const
+void BlendedColorCache::getGradientStops(const Vec4& baseColor, bool isWarningRegion, GradientStop* stops) const
 {
-    uint64_t key = getCacheKey(baseColor, x, isWarningRegion);
-    auto it = blendCache_.find(key);
-    if (it != blendCache_.end()) return it->second;
-    const TextureData& texture = isWarningRegion ? warningTexture_ : normalTexture_;
-    Vec4 overlayColor = sampleTexture(texture, x);
-    Vec4 result = multiplyBlend(baseColor, overlayColor);
-    blendCache_[key] = result;
-    return result;
+    const auto& profile = isWarningRegion ? warningProfile_ : normalProfile_;
+    for (size_t i = 0; i < LIGHTING_STOP_COUNT; ++i)
+    {
+        stops[i].position = static_cast<float>(i) / (LIGHTING_STOP_COUNT - 1);
+        stops[i].color = multiplyBlend(baseColor, profile[i]);
+    }
 }
 
-Vec4 BlendedColorCache::sampleTexture(const TextureData& texture, float logicalX) const
-{
-    float maxLogicalX = channelWidth_ - 2.0f;
-    float normalizedX = logicalX / maxLogicalX;
-    normalizedX = std::clamp(normalizedX, 0.0f, 1.0f);
-    float physicalX = normalizedX * blendTexturePixelCount_;
-    int textureIndex = static_cast<int>(std::floor(physicalX));
-    textureIndex = std::clamp(textureIndex, 0, blendTexturePixelCount_ - 1);
-    return texture.pixels[textureIndex];
-}
 Vec4 BlendedColorCache::multiplyBlend(const Vec4& baseColor, const Vec4& overlayColor) const
 {
     return Vec4(
@@ -519,17 +496,6 @@ Vec4 BlendedColorCache::multiplyBlend(const Vec4& baseColor, const Vec4& overlay
         baseColor.w
     );
 }
-uint64_t BlendedColorCache::getCacheKey(const Vec4& baseColor, float x, bool isWarningRegion) const
-{
-    uint32_t colorHash = static_cast<uint32_t>(baseColor.x * 255) << 24 |
-                         static_cast<uint32_t>(baseColor.y * 255) << 16 |
-                         static_cast<uint32_t>(baseColor.z * 255) << 8 |
-                         static_cast<uint32_t>(baseColor.w * 255);
-    uint32_t xInt = static_cast<uint32_t>(x * 1000);
-    return (static_cast<uint64_t>(colorHash) << 32) |
-           (static_cast<uint64_t>(xInt) << 1) |
-           (isWarningRegion ? 1 : 0);
-}
 
 //==========================================================================================
 // MeterRenderer Implementation
@@ -609,39 +575,20 @@ void MeterRenderer::renderChannelBackground(RenderList& cmdList, const Rect& rec
     float normalHeight = warningThreshold01 * innerRect.height;
     float warningHeight = (peakThreshold01 - warningThreshold01) * innerRect.height;
     float peakHeight = (1.0f - peakThreshold01) * innerRect.height;
-    constexpr float PIXEL_STEP = 1.0f;
     if (normalHeight > 0.0f)
     {
         Rect normalRect(innerRect.x, innerRect.y + innerRect.height - normalHeight, innerRect.width, normalHeight);
-        for (float x = normalRect.x; x < normalRect.x + normalRect.width; x += PIXEL_STEP)
-        {
-            float pixelWidth = std::min(PIXEL_STEP, normalRect.x + normalRect.width - x);
-            Rect pixelRect(x, normalRect.y, pixelWidth, normalRect.height);
-            Vec4 blendedColor = blendCache_.getBlendedColor(colors.bgNormal, x - innerRect.x, false);
-            cmdList.fillRect(pixelRect, blendedColor);
-        }
+        fillLitRect(cmdList, normalRect, colors.bgNormal, false);
     }
     if (warningHeight > 0.0f)
     {
         Rect warningRect(innerRect.x, innerRect.y + innerRect.height - normalHeight - warningHeight, innerRect.width, warningHeight);
-        for (float x = warningRect.x; x < warningRect.x + warningRect.width; x += PIXEL_STEP)
-        {
-            float pixelWidth = std::min(PIXEL_STEP, warningRect.x + warningRect.width - x);
-            Rect pixelRect(x, warningRect.y, pixelWidth, warningRect.height);
-            Vec4 blendedColor = blendCache_.getBlendedColor(colors.bgWarning, x - innerRect.x, false);
-            cmdList.fillRect(pixelRect, blendedColor);
-        }
+        fillLitRect(cmdList, warningRect, colors.bgWarning, false);
     }
     if (peakHeight > 0.0f)
     {
         Rect peakRect(innerRect.x, innerRect.y, innerRect.width, peakHeight);
-        for (float x = peakRect.x; x < peakRect.x + peakRect.width; x += PIXEL_STEP)
-        {
-            float pixelWidth = std::min(PIXEL_STEP, peakRect.x + peakRect.width - x);
-            Rect pixelRect(x, peakRect.y, pixelWidth, peakRect.height);
-            Vec4 blendedColor = blendCache_.getBlendedColor(colors.bgPeak, x - innerRect.x, true);
-            cmdList.fillRect(pixelRect, blendedColor);
-        }
+        fillLitRect(cmdList, peakRect, colors.bgPeak, true);
     }
 }
 void MeterRenderer::renderChannelFill(RenderList& cmdList, const Rect& rect, float level01,
@@ -657,7 +604,6 @@ void MeterRenderer::renderChannelFill(RenderList& cmdList, const Rect& rect, flo
     float warningThreshold01 = getWarningThreshold01();
     float peakThreshold01 = getPeakThreshold01();
     float currentBottom = innerRect.y + innerRect.height;
-    constexpr float PIXEL_STEP = 1.0f;
     if (level01 > 0.0f && warningThreshold01 > 0.0f)
     {
         float normalFill = std::min(level01, warningThreshold01);
@@ -665,13 +611,7 @@ void MeterRenderer::renderChannelFill(RenderList& cmdList, const Rect& rect, flo
         {
             float normalHeight = normalFill * innerRect.height;
             Rect normalFillRect(innerRect.x, currentBottom - normalHeight, innerRect.width, normalHeight);
-            for (float x = normalFillRect.x; x < normalFillRect.x + normalFillRect.width; x += PIXEL_STEP)
-            {
-                float pixelWidth = std::min(PIXEL_STEP, normalFillRect.x + normalFillRect.width - x);
-                Rect pixelRect(x, normalFillRect.y, pixelWidth, normalFillRect.height);
-                Vec4 blendedColor = blendCache_.getBlendedColor(colors.levelNormal, x - innerRect.x, false);
-                cmdList.fillRect(pixelRect, blendedColor);
-            }
+            fillLitRect(cmdList, normalFillRect, colors.levelNormal, false);
         }
     }
     if (level01 > warningThreshold01 && peakThreshold01 > warningThreshold01)
@@ -683,13 +623,7 @@ void MeterRenderer::renderChannelFill(RenderList& cmdList, const Rect& rect, flo
             Rect warningFillRect(innerRect.x,
                                 currentBottom - (warningThreshold01 * innerRect.height) - warningHeight,
                                 innerRect.width, warningHeight);
-            for (float x = warningFillRect.x; x < warningFillRect.x + warningFillRect.width; x += PIXEL_STEP)
-            {
-                float pixelWidth = std::min(PIXEL_STEP, warningFillRect.x + warningFillRect.width - x);
-                Rect pixelRect(x, warningFillRect.y, pixelWidth, warningFillRect.height);
-                Vec4 blendedColor = blendCache_.getBlendedColor(colors.levelWarning, x - innerRect.x, false);
-                cmdList.fillRect(pixelRect, blendedColor);
-            }
+            fillLitRect(cmdList, warningFillRect, colors.levelWarning, false);
         }
     }
     if (level01 > peakThreshold01)
@@ -701,16 +635,16 @@ void MeterRenderer::renderChannelFill(RenderList& cmdList, const Rect& rect, flo
             Rect peakFillRect(innerRect.x,
                              currentBottom - (peakThreshold01 * innerRect.height) - peakHeight,
                              innerRect.width, peakHeight);
-            for (float x = peakFillRect.x; x < peakFillRect.x + peakFillRect.width; x += PIXEL_STEP)
-            {
-                float pixelWidth = std::min(PIXEL_STEP, peakFillRect.x + peakFillRect.width - x);
-                Rect pixelRect(x, peakFillRect.y, pixelWidth, peakFillRect.height);
-                Vec4 blendedColor = blendCache_.getBlendedColor(colors.levelPeak, x - innerRect.x, true);
-                cmdList.fillRect(pixelRect, blendedColor);
-            }
+            fillLitRect(cmdList, peakFillRect, colors.levelPeak, true);
         }
     }
 }
+void MeterRenderer::fillLitRect(RenderList& cmdList, const Rect& rect, const Vec4& baseColor, bool isWarningRegion)
+{
+    GradientStop stops[BlendedColorCache::LIGHTING_STOP_COUNT];
+    blendCache_.getGradientStops(baseColor, isWarningRegion, stops);
+    cmdList.fillGradientRect(rect, stops, BlendedColorCache::LIGHTING_STOP_COUNT, GradientDirection::Horizontal);
+}
 void MeterRenderer::renderChannelFrame(RenderList& cmdList, const Rect& rect)
 {
     if (rect.width <= 0 || rect.height <= 0) return;
@@ -975,14 +909,15 @@ bool LevelMeter::handleMouseClick(const Vec2& position, bool pressed, const Vec2
 {
     return dispatchMouseEvent(position, pressed, offset, false);
 }
-void LevelMeter::updateLevels(const std::vector<float>& levels) { levelData_.updateLevels(levels); }
-void LevelMeter::updateLevel(size_t channel, float levelDb) { levelData_.updateLevel(channel, levelDb); }
-void LevelMeter::reset() { levelData_.reset(); }
-void LevelMeter::setChannelCount(size_t count) { levelData_.setChannelCount(count); }
+void LevelMeter::updateLevels(const std::vector<float>& levels) { levelData_.updateLevels(levels); invalidate(); }
+void LevelMeter::updateLevel(size_t channel, float levelDb) { levelData_.updateLevel(channel, levelDb); invalidate(); }
+void LevelMeter::reset() { levelData_.reset(); invalidate(); }
+void LevelMeter::setChannelCount(size_t count) { levelData_.setChannelCount(count); invalidate(); }
 void LevelMeter::setScaleType(ScaleType type)
 {
     scale_ = MeterScale::create(type);
     renderer_.setScale(&scale_);
+    invalidate();
 }
 void LevelMeter::setConfig(const MeterConfig& config)
 {
@@ -990,6 +925,7 @@ void LevelMeter::setConfig(const MeterConfig& config)
     {
         config_ = config;
         applyConfigToComponents();
+        invalidate();
     }
 }
 void LevelMeter::setThresholds(float warningDb, float peakDb)
@@ -997,7 +933,7 @@ void LevelMeter::setThresholds(float warningDb, float peakDb)
     MeterThresholds thresholds = config_.getThresholds();
     thresholds.normalToWarning = warningDb;
     thresholds.warningToPeak = peakDb;
-    if (thresholds.isValid()) { config_.setThresholds(thresholds); }
+    if (thresholds.isValid()) { config_.setThresholds(thresholds); invalidate(); }
 }
 void LevelMeter::setDecayRate(float dbPerSec)
 {
@@ -1032,8 +968,8 @@ Vec2 LevelMeter::calculateAutoSize() const
     float height = MeterDimensions::getTotalHeight();
     return Vec2(width, height);
 }
-void LevelMeter::updateControlVoltage(float levelDb) { levelData_.updateControlVoltage(levelDb); }
-void LevelMeter::setShowControlVoltage(bool show) { showControlVoltage_ = show; }
+void LevelMeter::updateControlVoltage(float levelDb) { levelData_.updateControlVoltage(levelDb); invalidate(); }
+void LevelMeter::setShowControlVoltage(bool show) { showControlVoltage_ = show; invalidate(); }
 bool LevelMeter::getShowControlVoltage() const { return showControlVoltage_; }
 
 } // namespace YuchenUI
@@ -3,6 +3,7 @@
 #include "YuchenUI/core/Types.h"
 #include "YuchenUI/core/UIContext.h"
 #include "YuchenUI/core/IUIContent.h"
+#include "YuchenUI/rendering/RenderList.h"
 #include "YuchenUI/platform/ITextInputHandler.h"
 #include "YuchenUI/platform/ICoordinateMapper.h"
 #include "YuchenUI/platform/WindowImpl.h"
@@ -51,6 +52,8 @@ public:
 
     void handleNativeEvent(void* event);
     void renderContent();
+    void repaint();
+    uint64_t getSkippedFrameCount() const { return m_skippedFrameCount; }
     void show();
     void hide();
     bool isVisible() const;
@@ -85,6 +88,10 @@ public:
     void setTargetFPS(int fps);
     int getTargetFPS() const { return m_targetFPS; }
     
+    /** Runs RenderList::coalesceFillRects() on each frame before it is drawn. Off by default. */
+    void setFillCoalescingEnabled(bool enabled);
+    bool isFillCoalescingEnabled() const { return m_coalesceFills; }
+    
 protected:
     IGraphicsBackend* getGraphicsBackend() { return m_backend.get(); }
     virtual void onWindowReady() {}
@@ -96,6 +103,7 @@ protected:
 
     std::unique_ptr<WindowImpl> m_impl;
     std::unique_ptr<IGraphicsBackend> m_backend;
+    RenderList m_renderList;
     UIContext m_uiContext;
     Window* m_parentWindow;
     WindowType m_windowType;
@@ -119,6 +127,11 @@ protected:
     int m_targetFPS;
     
     IResourceResolver* m_resourceResolver;
+    
+    uint64_t m_lastFrameFingerprint;
+    bool m_hasLastFrame;
+    uint64_t m_skippedFrameCount;
+    bool m_coalesceFills;
 
 private:
     bool initializeRenderer(IFontProvider* fontProvider);
@@ -34,6 +34,12 @@
     - Skip interval calculated as: displayRefreshRate / targetFPS
     - Example: 144Hz display with 60fps target = skip interval of 2.4, rounded to 2
     - Frame counter tracks when to render based on skip interval
+    
+    Idle windows:
+    - After each frame the display link (and modal timer) stop if UIContext has nothing
+      scheduled, so an idle window does not wake the main thread at display rate
+    - An animation frame further away than one tick arms a one-shot wake timer instead
+    - UIContext's frame request callback restarts the clock on the next redraw request
 */
 
 #import <Cocoa/Cocoa.h>
@@ -94,6 +100,9 @@ namespace YuchenUI { class MacOSWindowImpl; }
 /** Timer for modal dialog frame updates. */
 @property (nonatomic, strong) NSTimer* modalRefreshTimer;
 
+/** One-shot timer restarting rendering for a delayed animation frame. */
+@property (nonatomic, strong) NSTimer* wakeTimer;
+
 /** Target frame rate for this window. */
 @property (nonatomic, assign) int targetFPS;
 
@@ -115,6 +124,15 @@ namespace YuchenUI { class MacOSWindowImpl; }
 /** Triggers a render callback on the main thread. */
 - (void)performRenderCallback;
 
+/** Restarts the display link and modal timer after idleRenderLoopFor:. Main thread only. */
+- (void)resumeRenderLoop;
+
+/** Stops the display link and modal timer if the next frame is not due within a tick.
+    
+    @param delay  Seconds until the next frame, negative if none is scheduled
+*/
+- (void)idleRenderLoopFor:(double)delay;
+
 /** Enables or disables IME input.
     
     @param enabled  YES to enable, NO to disable
@@ -321,6 +339,10 @@ public:
     void handleUnmarkText();
 
 private:
+    //======================================================================================
+    /** Restarts rendering after a frame request; safe to call from any thread. */
+    void wakeRenderLoop();
+    
     //======================================================================================
     /** Creates the NSWindow style mask based on configuration.
         
@@ -403,6 +425,7 @@ private:
         self.displayRefreshRate = 0;
         self.windowImpl = nullptr;
         self.modalRefreshTimer = nil;
+        self.wakeTimer = nil;
         self.markedText = nil;
         self.textInputContext = [[NSTextInputContext alloc] initWithClient:self];
         self.imeEnabled = YES;
@@ -524,6 +547,9 @@ private:
 
 - (void)stopRenderLoop
 {
+    [self.wakeTimer invalidate];
+    self.wakeTimer = nil;
+    
     if (displayLink)
     {
         CVDisplayLinkStop(displayLink);
@@ -552,6 +578,36 @@ private:
     });
 }
 
+- (void)resumeRenderLoop
+{
+    [self.wakeTimer invalidate];
+    self.wakeTimer = nil;
+    
+    if (displayLink && !CVDisplayLinkIsRunning(displayLink)) CVDisplayLinkStart(displayLink);
+    if (self.modalRefreshTimer) [self.modalRefreshTimer setFireDate:[NSDate date]];
+}
+
+- (void)idleRenderLoopFor:(double)delay
+{
+    // Keep ticking when the next frame is due by the next tick anyway
+    int targetFPS = self.targetFPS > 0 ? self.targetFPS : 60;
+    if (delay >= 0.0 && delay <= 1.0 / targetFPS) return;
+    
+    if (displayLink && CVDisplayLinkIsRunning(displayLink)) CVDisplayLinkStop(displayLink);
+    if (self.modalRefreshTimer) [self.modalRefreshTimer setFireDate:[NSDate distantFuture]];
+    
+    [self.wakeTimer invalidate];
+    self.wakeTimer = nil;
+    if (delay < 0.0) return;
+    
+    __weak UniversalMetalView* weakSelf = self;
+    self.wakeTimer = [NSTimer timerWithTimeInterval:delay repeats:NO block:^(NSTimer* timer) {
+        [weakSelf resumeRenderLoop];
+    }];
+    [[NSRunLoop currentRunLoop] addTimer:self.wakeTimer forMode:NSModalPanelRunLoopMode];
+    [[NSRunLoop currentRunLoop] addTimer:self.wakeTimer forMode:NSRunLoopCommonModes];
+}
+
 - (void)startModalRefresh
 {
     if (self.modalRefreshTimer) return;
@@ -902,6 +958,8 @@ void MacOSWindowImpl::destroy()
 {
     @autoreleasepool
     {
+        if (m_baseWindow) m_baseWindow->getUIContext().setFrameRequestCallback(nullptr);
+        
         // Stop modal refresh if active
         if (m_metalView) [m_metalView stopModalRefresh];
         
@@ -1025,7 +1083,11 @@ void* MacOSWindowImpl::getNativeHandle() const
 
 void MacOSWindowImpl::setBaseWindow(BaseWindow* baseWindow)
 {
+    if (m_baseWindow) m_baseWindow->getUIContext().setFrameRequestCallback(nullptr);
     m_baseWindow = baseWindow;
+    
+    // Requests restart the display link that onRender() stops while the UI is idle
+    if (m_baseWindow) m_baseWindow->getUIContext().setFrameRequestCallback([this]() { wakeRenderLoop(); });
 }
 
 void* MacOSWindowImpl::getRenderSurface() const
@@ -1078,7 +1140,25 @@ void MacOSWindowImpl::onEvent(void* event)
 
 void MacOSWindowImpl::onRender()
 {
-    if (m_baseWindow) m_baseWindow->renderContent();
+    if (!m_baseWindow) return;
+    
+    m_baseWindow->renderContent();
+    [m_metalView idleRenderLoopFor:m_baseWindow->getUIContext().getTimeUntilNextFrame()];
+}
+
+void MacOSWindowImpl::wakeRenderLoop()
+{
+    UniversalMetalView* view = m_metalView;
+    if (!view) return;
+    
+    if ([NSThread isMainThread])
+    {
+        [view resumeRenderLoop];
+        return;
+    }
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [view resumeRenderLoop];
+    });
 }
 
 void MacOSWindowImpl::onResize(int width, int height)
@@ -20,7 +20,7 @@
     
     Key features:
     - Hardware-accelerated GPU rendering using Apple's Metal API
-    - Batched rendering for rectangles, images, and text
+    - Ordered draw batches from RenderBatchCompiler, one draw call per batch
     - Multiple render pipelines for different geometry types
     - Texture atlas support for efficient text rendering
     - Nine-slice image scaling for UI elements
@@ -32,10 +32,10 @@
 
 #include "YuchenUI/rendering/IGraphicsBackend.h"
 #include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/rendering/RenderBatchCompiler.h"
 #include "ShaderSources.h"
 #include <memory>
 #include <vector>
-#include <map>
 
 #ifdef __OBJC__
     #import <Metal/Metal.h>
@@ -65,53 +65,6 @@ struct ViewportUniforms {
     Vec2 viewportSize;  ///< Viewport size in pixels
 };
 
-//==========================================================================================
-/**
-    Vertex structure for shape rendering (lines, triangles).
-    
-    Contains position and color per vertex.
-*/
-struct ShapeVertex {
-    Vec2 position;  ///< Vertex position
-    Vec4 color;     ///< Vertex color (RGBA)
-    
-    ShapeVertex() : position(), color() {}
-    ShapeVertex(const Vec2& pos, const Vec4& col) : position(pos), color(col) {}
-};
-
-//==========================================================================================
-/**
-    Vertex structure for circle rendering.
-    
-    Uses signed distance field approach in fragment shader for smooth circles.
-*/
-struct CircleVertex {
-    Vec2 position;      ///< Vertex position
-    Vec2 center;        ///< Circle center
-    float radius;       ///< Circle radius
-    float borderWidth;  ///< Border width (0 for filled)
-    Vec4 color;         ///< Circle color (RGBA)
-    
-    CircleVertex() : position(), center(), radius(0.0f), borderWidth(0.0f), color() {}
-    CircleVertex(const Vec2& pos, const Vec2& cen, float r, float bw, const Vec4& col)
-        : position(pos), center(cen), radius(r), borderWidth(bw), color(col) {}
-};
-
-//==========================================================================================
-/**
-    Enumeration of active rendering pipelines.
-    
-    Used to track current pipeline state and minimize pipeline switches.
-*/
-enum class ActivePipeline {
-    None,    ///< No pipeline active
-    Rect,    ///< Rectangle rendering pipeline
-    Text,    ///< Text rendering pipeline
-    Image,   ///< Image rendering pipeline
-    Shape,   ///< Shape rendering pipeline (lines, triangles)
-    Circle   ///< Circle rendering pipeline
-};
-
 //==========================================================================================
 /**
     Metal-based graphics context implementation.
@@ -233,7 +186,8 @@ public:
     
     /** Executes a list of render commands.
         
-        Batches commands by type and clip state for efficiency.
+        Compiles the list into ordered batches, uploads each vertex stream once
+        and issues one draw call per batch.
         
         @param commandList  The render commands to execute
     */
@@ -316,125 +270,26 @@ private:
     void applyFullScreenScissor();
     
     //======================================================================================
-    // Rectangle Rendering
-    
-    /** Renders a batch of rectangles.
-        
-        @param commands  Rectangle render commands
-        @param clipRect  Clip rectangle (if hasClip is true)
-        @param hasClip   Whether clipping is active
-    */
-    void renderRectBatch(const std::vector<RenderCommand>& commands, const Rect& clipRect, bool hasClip);
-    
-    //======================================================================================
-    // Image Rendering
-    
-    /** Renders a batch of images with the same texture.
-        
-        @param commandIndices  Indices of image commands
-        @param commands        Full command list
-        @param texture         Texture handle
-        @param clipRect        Clip rectangle (if hasClip is true)
-        @param hasClip         Whether clipping is active
-    */
-    void renderImageBatch(const std::vector<size_t>& commandIndices, const std::vector<RenderCommand>& commands, void* texture, const Rect& clipRect, bool hasClip);
+    // Batch Submission
     
-    /** Generates vertices for a simple image draw.
+    /** Copies a vertex stream into a GPU buffer.
         
-        @param destRect    Destination rectangle
-        @param sourceRect  Source rectangle in texture
-        @param texWidth    Texture width
-        @param texHeight   Texture height
-        @param outVertices Output vertex data (position + texcoord)
-    */
-    void generateImageVertices(const Rect& destRect, const Rect& sourceRect, uint32_t texWidth, uint32_t texHeight, std::vector<float>& outVertices);
-    
-    
-    // TODO: Please add comments here!
-    void generateTileVertices(const Rect& destRect, const Rect& textureLogicalSize,
-                              float designScale, std::vector<float>& outVertices);
-    
-    
-    /** Generates vertices for nine-slice scaled image.
-        
-        @param texture      Texture handle
-        @param destRect     Destination rectangle
-        @param sourceRect   Source rectangle in texture
-        @param margins      Nine-slice margins
-        @param designScale  Design-time scale factor
-        @param texWidth     Texture width
-        @param texHeight    Texture height
-        @param outVertices  Output vertex data
-    */
-    void generateNineSliceVertices(void* texture, const Rect& destRect, const Rect& sourceRect, const NineSliceMargins& margins, float designScale, uint32_t texWidth, uint32_t texHeight, std::vector<float>& outVertices);
-    
-    /** Computes the nine slice rectangles.
+        Reuses the given persistent buffer when the data fits, otherwise allocates a
+        buffer for this frame.
         
-        @param destRect    Destination rectangle
-        @param sourceRect  Source rectangle
-        @param margins     Nine-slice margins
-        @param designScale Design scale factor
-        @param outSlices   Output array of 9 rectangles
+        @param reusable  Persistent buffer to fill (may be nil)
+        @param data      Vertex data
+        @param bytes     Size of the vertex data in bytes
+        @returns Buffer holding the data, or nil if bytes is zero
     */
-    void computeNineSliceRects(const Rect& destRect, const Rect& sourceRect, const NineSliceMargins& margins, float designScale, Rect outSlices[9]);
+    id<MTLBuffer> uploadVertices(id<MTLBuffer> reusable, const void* data, size_t bytes);
     
-    //======================================================================================
-    // Text Rendering
-    
-    /** Renders multiple text batches.
-        
-        @param allVertices    All text vertices
-        @param batchStarts    Start index for each batch
-        @param batchCounts    Vertex count for each batch
-        @param batchClips     Clip rect for each batch
-        @param batchHasClips  Whether each batch has clipping
-    */
-    void renderTextBatches(const std::vector<TextVertex>& allVertices, const std::vector<size_t>& batchStarts, const std::vector<size_t>& batchCounts, const std::vector<Rect>& batchClips, const std::vector<bool>& batchHasClips);
+    /** Returns the Metal texture wrapped by a texture handle. */
+    id<MTLTexture> unwrapTexture(void* handle) const;
     
-    //======================================================================================
-    // Shape Rendering
-
-    /** Renders a batch of lines efficiently.
-        
-        Batches multiple lines into a single draw call using reusable vertex buffer.
-        Significantly reduces GPU overhead compared to individual line draws.
-        
-        @param commands  Vector of line draw commands
-        @param clipRect  Clipping rectangle (if hasClip is true)
-        @param hasClip   Whether scissor clipping should be applied
-    */
-    void renderLineBatch(const std::vector<RenderCommand>& commands,
-                         const Rect& clipRect, bool hasClip);
-
-    /** Renders a batch of triangles efficiently.
-        
-        @param commands  Vector of triangle draw commands
-        @param clipRect  Clipping rectangle (if hasClip is true)
-        @param hasClip   Whether scissor clipping should be applied
-    */
-    void renderTriangleBatch(const std::vector<RenderCommand>& commands,
-                             const Rect& clipRect, bool hasClip);
-
-    /** Renders a batch of circles efficiently.
-        
-        @param commands  Vector of circle draw commands
-        @param clipRect  Clipping rectangle (if hasClip is true)
-        @param hasClip   Whether scissor clipping should be applied
-    */
-    void renderCircleBatch(const std::vector<RenderCommand>& commands,
-                           const Rect& clipRect, bool hasClip);
     //======================================================================================
     // Utilities
     
-    /** Converts window coordinates to normalized device coordinates.
-        
-        @param x     X coordinate in window space
-        @param y     Y coordinate in window space
-        @param ndcX  Output X in NDC (-1 to 1)
-        @param ndcY  Output Y in NDC (-1 to 1)
-    */
-    void convertToNDC(float x, float y, float& ndcX, float& ndcY) const;
-    
     /** Returns viewport uniforms for current frame. */
     ViewportUniforms getViewportUniforms() const;
     
@@ -503,6 +358,7 @@ private:
     IFontProvider* m_fontProvider;                 ///< Font provider (not owned)
     std::unique_ptr<TextRenderer> m_textRenderer;  ///< Text rendering system
     std::unique_ptr<TextureCache> m_textureCache;  ///< Image texture cache
+    std::unique_ptr<RenderBatchCompiler> m_batchCompiler;  ///< Command-to-batch compiler
     size_t m_maxTextVertices;                      ///< Maximum text vertices per frame
     // Memory usage: Shape ~780 KB, Circle ~936 KB, Rect ~3 MB (acceptable on modern hardware)
     static constexpr size_t MAX_SHAPE_VERTICES  = 100000;  // Support ~16600 lines per frame
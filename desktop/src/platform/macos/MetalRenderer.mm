@@ -18,7 +18,8 @@
     
     Implementation notes:
     - Uses separate pipelines for different geometry types (rect, text, image, shape, circle)
-    - Batches draw calls by type and clip state to minimize GPU state changes
+    - Command batching lives in RenderBatchCompiler (core); this file only uploads the
+      compiled vertex streams and issues one draw per batch, in painter's order
     - Text uses pre-generated index buffer for quad rendering (6 indices per 4 vertices)
     - Nine-slice images computed on CPU and uploaded as expanded vertex data
     - Clip rects applied via Metal scissor test for efficient GPU clipping
@@ -55,63 +56,6 @@
 @implementation TextureWrapper
 @end
 
-namespace {
-
-using namespace YuchenUI;
-
-//==========================================================================================
-/**
-    Vertex structure for image rendering.
-    
-    Each vertex contains position (x,y) and texture coordinates (u,v).
-    Used for simple image drawing and nine-slice scaled images.
-*/
-struct ImageVertex
-{
-    Vec2 position;   ///< Vertex position in window coordinates
-    Vec2 texCoord;   ///< Texture coordinates (0-1 range)
-    
-    ImageVertex() : position(), texCoord() {}
-    ImageVertex(const Vec2& pos, const Vec2& tex) : position(pos), texCoord(tex) {}
-};
-
-//==========================================================================================
-/**
-    Clip state structure for render command batching.
-    
-    Used to group commands with identical clip regions to minimize
-    scissor rect changes on the GPU.
-*/
-struct ClipState
-{
-    YuchenUI::Rect clipRect;  ///< Clip rectangle in window coordinates
-    bool hasClip;             ///< Whether clipping is active (false = full screen)
-};
-
-//==========================================================================================
-/**
-    Computes a hash value for a clip state.
-    
-    Used for grouping render commands with identical clip states into batches.
-    Commands with the same hash can be rendered together without changing scissor.
-    
-    @param state  The clip state to hash
-    @returns Hash value (0 for no clipping to group all unclipped commands)
-*/
-uint64_t computeClipHash(const ClipState& state)
-{
-    if (!state.hasClip) return 0;
-    
-    uint64_t hash = 0;
-    hash ^= std::hash<float>()(state.clipRect.x);
-    hash ^= std::hash<float>()(state.clipRect.y) << 1;
-    hash ^= std::hash<float>()(state.clipRect.width) << 2;
-    hash ^= std::hash<float>()(state.clipRect.height) << 3;
-    return hash;
-}
-
-} // anonymous namespace
-
 //==========================================================================================
 /* [SECTION] Lifecycle                  - Initialization, destruction, and resource lifecycle management
  * [SECTION] Device & Queue             - Metal device and command queue creation
@@ -119,11 +63,8 @@ uint64_t computeClipHash(const ClipState& state)
  * [SECTION] Frame Management           - Frame begin/end, drawable acquisition, and render pass configuration
  * [SECTION] Pipeline State Management  - Efficient pipeline switching with state tracking
  * [SECTION] Scissor Management         - Clip rectangle computation and GPU scissor test application
- * [SECTION] Command Execution          - Advanced batching algorithm that groups commands by type and clip state
- * [SECTION] Rectangle Rendering        - Rounded rectangle rendering with individual and batched draw calls
- * [SECTION] Image Rendering            - Image and nine-slice rendering with texture atlas support
- * [SECTION] Text Rendering             - Glyph rendering using pre-generated atlas and indexed drawing
- * [SECTION] Shape Rendering            - Lines, triangles, and circles with analytical anti-aliasing
+ * [SECTION] Command Execution          - Compiles the RenderList into ordered batches and issues them
+ * [SECTION] Batch Submission           - Vertex stream upload and texture handle unwrapping
  * [SECTION] Texture Management         - Texture creation, updates, and destruction with ARC wrapper
  * [SECTION] Utilities                  - Coordinate space conversions and uniform buffer generation
  */
@@ -174,6 +115,7 @@ MetalRenderer::MetalRenderer()
     , m_currentPipeline(ActivePipeline::None)
     , m_textRenderer(nullptr)
     , m_textureCache(nullptr)
+    , m_batchCompiler(nullptr)
     , m_maxTextVertices(Config::Rendering::MAX_TEXT_VERTICES)
     , m_isInitialized(false)
     , m_width(0)
@@ -247,6 +189,8 @@ bool MetalRenderer::initialize(void* platformSurface, int width, int height,
     if (!m_textureCache->initialize()) return false;
     
     m_textureCache->setCurrentDPI(m_dpiScale);
+    
+    m_batchCompiler = std::make_unique<RenderBatchCompiler>(m_textRenderer.get(), m_textureCache.get());
     return true;
 }
 
@@ -276,6 +220,8 @@ bool MetalRenderer::isInitialized() const
 void MetalRenderer::releaseMetalObjects()
 {
     // Release high-level systems first
+    m_batchCompiler.reset();
+    
     if (m_textRenderer)
     {
         m_textRenderer->destroy();
@@ -1021,1078 +967,157 @@ void MetalRenderer::applyFullScreenScissor()
 //==========================================================================================
 // [SECTION] Command Execution
 
-/**
-    Executes render commands with conservative sequential batching.
-    
-    This is the core rendering method that processes a RenderList and executes
-    all draw calls efficiently while strictly preserving draw order. The algorithm
-    works in multiple passes:
-    
-    Pass 1: Clip State Computation
-    - Maintains a stack of active clip rectangles
-    - Computes effective clip rect for each command (intersection of all active clips)
-    - Stores clip state per command for later batching
-    
-    Pass 2: Conservative Sequential Batching
-    - Groups rectangles by clip hash into batches
-    - Groups shapes by clip hash into batches
-    - Groups images ONLY when consecutive commands share same texture and clip
-      (prevents draw order violations that could cause layering issues)
-    - Merges consecutive text draws when possible
-    
-    Pass 3: Rendering
-    - Renders all rectangle batches
-    - Renders all shape batches (lines, triangles, circles)
-    - Renders all image batches (in creation order, no sorting needed)
-    - Renders all text batches
-    
-    Benefits:
-    - Minimizes pipeline switches (expensive on GPU)
-    - Minimizes scissor rect changes
-    - Reduces draw call overhead
-    - Guarantees correct layering for UI elements
-    
-    Note: Image batching is intentionally conservative to maintain strict draw order.
-    Only consecutive commands with identical texture and clip state are merged,
-    preventing background images from being rendered after foreground icons.
-    
-    @param commandList  The list of render commands to execute
-*/
 void MetalRenderer::executeRenderCommands(const RenderList& commandList)
 {
-    const auto& commands = commandList.getCommands();
-    if (commands.empty()) return;
-    
-    //======================================================================================
-    // Pass 1: Compute Clip States
-    
-    std::vector<ClipState> clipStates(commands.size());
-    std::vector<Rect> clipStack;
-    
-    for (size_t i = 0; i < commands.size(); ++i)
-    {
-        const auto& cmd = commands[i];
-        
-        if (cmd.type == RenderCommandType::PushClip)
-        {
-            Rect newClip = cmd.rect;
-            
-            if (!clipStack.empty())
-            {
-                const Rect& parentClip = clipStack.back();
-                
-                float x1 = std::max(parentClip.x, newClip.x);
-                float y1 = std::max(parentClip.y, newClip.y);
-                float x2 = std::min(parentClip.x + parentClip.width, newClip.x + newClip.width);
-                float y2 = std::min(parentClip.y + parentClip.height, newClip.y + newClip.height);
-                
-                if (x2 > x1 && y2 > y1)
-                {
-                    newClip = Rect(x1, y1, x2 - x1, y2 - y1);
-                }
-                else
-                {
-                    newClip = Rect(0, 0, 0, 0);
-                }
-            }
-            
-            clipStack.push_back(newClip);
-            clipStates[i].clipRect = newClip;
-            clipStates[i].hasClip = true;
-        }
-        else if (cmd.type == RenderCommandType::PopClip)
-        {
-            if (!clipStack.empty())
-            {
-                clipStack.pop_back();
-            }
-            
-            if (!clipStack.empty())
-            {
-                clipStates[i].clipRect = clipStack.back();
-                clipStates[i].hasClip = true;
-            }
-            else
-            {
-                clipStates[i].hasClip = false;
-            }
-        }
-        else
-        {
-            if (!clipStack.empty())
-            {
-                clipStates[i].clipRect = clipStack.back();
-                clipStates[i].hasClip = true;
-            }
-            else
-            {
-                clipStates[i].hasClip = false;
-            }
-        }
-    }
-    
-    //======================================================================================
-    // Pass 2: Batch Commands by Type and Clip
-    
-    std::map<uint64_t, std::vector<RenderCommand>> rectGroups;
-    std::map<uint64_t, Rect> rectGroupClips;
-    std::map<uint64_t, bool> rectGroupHasClip;
-    
-    struct ShapeBatch {
-        std::vector<size_t> indices;
-        Rect clipRect;
-        bool hasClip;
-    };
-    std::map<uint64_t, ShapeBatch> shapeGroups;
+    if (commandList.isEmpty()) return;
     
-    struct ImageBatch {
-        std::vector<size_t> indices;
-        void* texture;
-        Rect clipRect;
-        bool hasClip;
-        size_t firstIndex;
-    };
-    std::vector<ImageBatch> imageBatches;
+    m_batchCompiler->compile(commandList, Vec2(static_cast<float>(m_width), static_cast<float>(m_height)));
+    if (m_batchCompiler->hasClearColor()) m_clearColor = m_batchCompiler->getClearColor();
     
-    std::vector<TextVertex> allTextVertices;
-    std::vector<size_t> textBatchStarts;
-    std::vector<size_t> textBatchCounts;
-    std::vector<Rect> textBatchClips;
-    std::vector<bool> textBatchHasClips;
-    allTextVertices.reserve(1024);
-    
-    //======================================================================================
-    // Group commands into batches
-    
-    for (size_t i = 0; i < commands.size(); ++i)
-    {
-        const auto& cmd = commands[i];
-        
-        switch (cmd.type) {
-            case RenderCommandType::Clear:
-                m_clearColor = cmd.color;
-                break;
-                
-            case RenderCommandType::FillRect:
-            case RenderCommandType::DrawRect:
-            {
-                uint64_t clipHash = computeClipHash(clipStates[i]);
-                rectGroups[clipHash].push_back(cmd);
-                rectGroupClips[clipHash] = clipStates[i].clipRect;
-                rectGroupHasClip[clipHash] = clipStates[i].hasClip;
-                break;
-            }
-                
-            case RenderCommandType::DrawLine:
-            case RenderCommandType::FillTriangle:
-            case RenderCommandType::DrawTriangle:
-            case RenderCommandType::FillCircle:
-            case RenderCommandType::DrawCircle:
-            {
-                uint64_t clipHash = computeClipHash(clipStates[i]);
-                auto& batch = shapeGroups[clipHash];
-                batch.indices.push_back(i);
-                batch.clipRect = clipStates[i].clipRect;
-                batch.hasClip = clipStates[i].hasClip;
-                break;
-            }
-                
-            case RenderCommandType::DrawImage:
-            {
-                uint32_t texWidth = 0, texHeight = 0;
-                float designScale = 1.0f;
-                void* texture = m_textureCache->getTexture(
-                    cmd.resourceNamespace.c_str(),
-                    cmd.text.c_str(),
-                    texWidth, texHeight, &designScale
-                );
-                
-                if (texture) {
-                    // Conservative batching: only merge with previous batch if texture,
-                    // clip, and command index are consecutive. This prevents draw order
-                    // violations where background images could render after foreground icons.
-                    bool merged = false;
-                    
-                    if (!imageBatches.empty()) {
-                        ImageBatch& lastBatch = imageBatches.back();
-                        
-                        // Check if texture matches
-                        bool sameTexture = (lastBatch.texture == texture);
-                        
-                        // Check if clip state matches
-                        bool sameClip = (lastBatch.hasClip == clipStates[i].hasClip) &&
-                                       (!clipStates[i].hasClip ||
-                                        (lastBatch.clipRect.x == clipStates[i].clipRect.x &&
-                                         lastBatch.clipRect.y == clipStates[i].clipRect.y &&
-                                         lastBatch.clipRect.width == clipStates[i].clipRect.width &&
-                                         lastBatch.clipRect.height == clipStates[i].clipRect.height));
-                        
-                        // Check if this is the immediately following command
-                        bool consecutive = (!lastBatch.indices.empty() &&
-                                           lastBatch.indices.back() == i - 1);
-                        
-                        if (sameTexture && sameClip && consecutive) {
-                            lastBatch.indices.push_back(i);
-                            merged = true;
-                        }
-                    }
-                    
-                    if (!merged) {
-                        // Create new batch
-                        ImageBatch newBatch;
-                        newBatch.indices.push_back(i);
-                        newBatch.texture = texture;
-                        newBatch.clipRect = clipStates[i].clipRect;
-                        newBatch.hasClip = clipStates[i].hasClip;
-                        newBatch.firstIndex = i;
-                        imageBatches.push_back(newBatch);
-                    }
-                    
-                    YUCHEN_PERF_TEXTURE_USAGE(cmd.text);
-                }
-                break;
-            }
-                
-            case RenderCommandType::DrawText:
-            {
-                ShapedText shapedText;
-                m_textRenderer->shapeText(cmd.text.c_str(),
-                                          cmd.fontFallbackChain,
-                                          cmd.fontSize,
-                                          cmd.letterSpacing,
-                                          shapedText);
-                if (!shapedText.isEmpty())
-                {
-                    std::vector<TextVertex> vertices;
-                    m_textRenderer->generateTextVertices(shapedText,
-                                                         cmd.textPosition,
-                                                         cmd.textColor,
-                                                         cmd.fontFallbackChain,
-                                                         cmd.fontSize,
-                                                         vertices);
-                    
-                    if (!vertices.empty())
-                    {
-                        bool canMerge = false;
-                        if (!textBatchStarts.empty())
-                        {
-                            size_t lastIdx = textBatchStarts.size() - 1;
-                            if (textBatchHasClips[lastIdx] == clipStates[i].hasClip)
-                            {
-                                if (!clipStates[i].hasClip ||
-                                    (textBatchClips[lastIdx].x == clipStates[i].clipRect.x &&
-                                     textBatchClips[lastIdx].y == clipStates[i].clipRect.y &&
-                                     textBatchClips[lastIdx].width == clipStates[i].clipRect.width &&
-                                     textBatchClips[lastIdx].height == clipStates[i].clipRect.height))
-                                {
-                                    canMerge = true;
-                                }
-                            }
-                        }
-                        
-                        if (canMerge)
-                        {
-                            textBatchCounts.back() += vertices.size();
-                        }
-                        else
-                        {
-                            textBatchStarts.push_back(allTextVertices.size());
-                            textBatchCounts.push_back(vertices.size());
-                            textBatchClips.push_back(clipStates[i].clipRect);
-                            textBatchHasClips.push_back(clipStates[i].hasClip);
-                        }
-                        allTextVertices.insert(allTextVertices.end(), vertices.begin(), vertices.end());
-                    }
-                }
-                break;
-            }
-                
-            default:
-                break;
-        }
-    }
-    
-    //======================================================================================
-    // Pass 3: Render All Batches
-
-    // 1. Render rectangle batches
-    if (!rectGroups.empty())
-    {
-        setPipeline(ActivePipeline::Rect);
-        for (const auto& pair : rectGroups)
-        {
-            renderRectBatch(pair.second, rectGroupClips[pair.first], rectGroupHasClip[pair.first]);
-        }
-    }
-
-    // 2. Render shape batches
-    if (!shapeGroups.empty())
-    {
-        for (const auto& pair : shapeGroups)
-        {
-            const ShapeBatch& batch = pair.second;
-            
-            std::vector<RenderCommand> lineCommands;
-            std::vector<RenderCommand> triangleCommands;
-            std::vector<RenderCommand> circleCommands;
-            
-            for (size_t idx : batch.indices)
-            {
-                const auto& cmd = commands[idx];
-                
-                switch (cmd.type)
-                {
-                    case RenderCommandType::DrawLine:
-                        lineCommands.push_back(cmd);
-                        break;
-                        
-                    case RenderCommandType::FillTriangle:
-                    case RenderCommandType::DrawTriangle:
-                        triangleCommands.push_back(cmd);
-                        break;
-                        
-                    case RenderCommandType::FillCircle:
-                    case RenderCommandType::DrawCircle:
-                        circleCommands.push_back(cmd);
-                        break;
-                        
-                    default:
-                        break;
-                }
-            }
-            
-            if (!lineCommands.empty())
-            {
-                renderLineBatch(lineCommands, batch.clipRect, batch.hasClip);
-            }
-            
-            if (!triangleCommands.empty())
-            {
-                renderTriangleBatch(triangleCommands, batch.clipRect, batch.hasClip);
-            }
-            
-            if (!circleCommands.empty())
-            {
-                renderCircleBatch(circleCommands, batch.clipRect, batch.hasClip);
-            }
-        }
-    }
-    
-    // 3. Render image batches in creation order (no sorting needed)
-    // Batches are already in correct order due to conservative sequential batching
-    if (!imageBatches.empty())
-    {
-        setPipeline(ActivePipeline::Image);
-        for (const auto& batch : imageBatches)
-        {
-            renderImageBatch(batch.indices,
-                             commands,
-                             batch.texture,
-                             batch.clipRect,
-                             batch.hasClip);
-        }
-    }
-    
-    // 4. Render text batches
-    if (!textBatchStarts.empty())
-    {
-        renderTextBatches(allTextVertices, textBatchStarts, textBatchCounts,
-                          textBatchClips, textBatchHasClips);
-    }
-    
-    applyFullScreenScissor();
-}
-
-//==========================================================================================
-// [SECTION] Rectangle Rendering
-
-void MetalRenderer::renderRectBatch(const std::vector<RenderCommand>& commands,
-                                   const Rect& clipRect, bool hasClip)
-{
-    if (commands.empty()) return;
+    const auto& batches = m_batchCompiler->getBatches();
+    if (batches.empty()) return;
     
     @autoreleasepool
     {
-        setPipeline(ActivePipeline::Rect);
-        
-        // Apply scissor once
-        if (hasClip) applyScissorRect(clipRect);
-        else applyFullScreenScissor();
+        //==================================================================================
+        // Upload each vertex stream once; batches draw sub-ranges of it
+        
+        const auto& rectVertices = m_batchCompiler->getRectVertices();
+        const auto& textVertices = m_batchCompiler->getTextVertices();
+        const auto& imageVertices = m_batchCompiler->getImageVertices();
+        const auto& shapeVertices = m_batchCompiler->getShapeVertices();
+        const auto& circleVertices = m_batchCompiler->getCircleVertices();
+        
+        YUCHEN_ASSERT_MSG(textVertices.size() <= m_maxTextVertices, "Text vertex data too large");
+        
+        id<MTLBuffer> rectBuffer = uploadVertices(m_rectVertexBuffer, rectVertices.data(),
+                                                  rectVertices.size() * sizeof(RectVertex));
+        id<MTLBuffer> textBuffer = uploadVertices(m_textVertexBuffer, textVertices.data(),
+                                                  textVertices.size() * sizeof(TextVertex));
+        id<MTLBuffer> imageBuffer = uploadVertices(nil, imageVertices.data(),
+                                                   imageVertices.size() * sizeof(ImageVertex));
+        id<MTLBuffer> shapeBuffer = uploadVertices(m_shapeVertexBuffer, shapeVertices.data(),
+                                                   shapeVertices.size() * sizeof(ShapeVertex));
+        id<MTLBuffer> circleBuffer = uploadVertices(m_circleVertexBuffer, circleVertices.data(),
+                                                    circleVertices.size() * sizeof(CircleVertex));
         
-        // Setup viewport uniforms
         ViewportUniforms uniforms = getViewportUniforms();
         id<MTLBuffer> uniformBuffer = [m_device newBufferWithBytes:&uniforms
                                                             length:sizeof(ViewportUniforms)
                                                            options:MTLResourceStorageModeShared];
         
-        // Calculate max vertices per sub-batch
-        NSUInteger bufferSize = [m_rectVertexBuffer length];
-        size_t maxVerticesPerBatch = bufferSize / sizeof(RectVertex);
-        
-        // Collect all rect vertices
-        std::vector<RectVertex> allVertices;
-        allVertices.reserve(commands.size() * 6);
+        //==================================================================================
+        // Issue batches in order
         
-        for (const auto& cmd : commands)
-        {
-            float left, right, top, bottom;
-            convertToNDC(cmd.rect.x, cmd.rect.y, left, top);
-            convertToNDC(cmd.rect.x + cmd.rect.width, cmd.rect.y + cmd.rect.height, right, bottom);
-            
-            // Generate 6 vertices for 2 triangles
-            allVertices.push_back(RectVertex(Vec2(left, top), cmd.rect, cmd.cornerRadius, cmd.color, cmd.borderWidth));
-            allVertices.push_back(RectVertex(Vec2(left, bottom), cmd.rect, cmd.cornerRadius, cmd.color, cmd.borderWidth));
-            allVertices.push_back(RectVertex(Vec2(right, bottom), cmd.rect, cmd.cornerRadius, cmd.color, cmd.borderWidth));
-            allVertices.push_back(RectVertex(Vec2(left, top), cmd.rect, cmd.cornerRadius, cmd.color, cmd.borderWidth));
-            allVertices.push_back(RectVertex(Vec2(right, bottom), cmd.rect, cmd.cornerRadius, cmd.color, cmd.borderWidth));
-            allVertices.push_back(RectVertex(Vec2(right, top), cmd.rect, cmd.cornerRadius, cmd.color, cmd.borderWidth));
-        }
+        bool scissorValid = false;
+        bool scissorHasClip = false;
+        Rect scissorRect;
         
-        if (allVertices.empty()) return;
-        
-        // Render in sub-batches if necessary
-        size_t totalVertices = allVertices.size();
-        size_t vertexOffset = 0;
-        int batchCount = 0;
-        
-        while (vertexOffset < totalVertices)
+        for (const RenderBatch& batch : batches)
         {
-            size_t batchSize = std::min(totalVertices - vertexOffset, maxVerticesPerBatch);
-            NSUInteger batchDataSize = batchSize * sizeof(RectVertex);
-            
-            // Copy sub-batch to buffer
-            memcpy([m_rectVertexBuffer contents],
-                   allVertices.data() + vertexOffset,
-                   batchDataSize);
+            setPipeline(batch.pipeline);
             
-            // Bind and draw
-            [m_renderEncoder setVertexBuffer:m_rectVertexBuffer offset:0 atIndex:0];
-            [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
-            [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
-                                 vertexStart:0
-                                 vertexCount:batchSize];
-            
-            vertexOffset += batchSize;
-            batchCount++;
-        }
-        
-        // Diagnostic logging
-        if (batchCount > 1)
-        {
-            static int warningCount = 0;
-            if (warningCount++ < 3)
+            if (!scissorValid || scissorHasClip != batch.hasClip ||
+                (batch.hasClip && scissorRect != batch.clipRect))
             {
-                NSLog(@"[YuchenUI] Info: Rect batch split into %d sub-batches (%zu vertices total). "
-                      "Consider increasing MAX_RECT_VERTICES if this happens frequently.",
-                      batchCount, totalVertices);
+                if (batch.hasClip) applyScissorRect(batch.clipRect);
+                else applyFullScreenScissor();
+                
+                scissorValid = true;
+                scissorHasClip = batch.hasClip;
+                scissorRect = batch.clipRect;
             }
-        }
-    }
-}
-
-//==========================================================================================
-// [SECTION] Image Rendering
-
-void MetalRenderer::generateImageVertices(const Rect& destRect, const Rect& sourceRect, uint32_t texWidth,
-                                          uint32_t texHeight, std::vector<float>& outVertices)
-{
-    float left, right, top, bottom;
-    convertToNDC(destRect.x, destRect.y, left, top);
-    convertToNDC(destRect.x + destRect.width, destRect.y + destRect.height, right, bottom);
-    
-    float u0 = sourceRect.x / texWidth;
-    float v0 = sourceRect.y / texHeight;
-    float u1 = (sourceRect.x + sourceRect.width) / texWidth;
-    float v1 = (sourceRect.y + sourceRect.height) / texHeight;
-    
-    float vertices[] =
-    {
-        left,  top,    u0, v0,
-        left,  bottom, u0, v1,
-        right, bottom, u1, v1,
-        left,  top,    u0, v0,
-        right, bottom, u1, v1,
-        right, top,    u1, v0
-    };
-    
-    outVertices.insert(outVertices.end(), vertices, vertices + 24);
-}
-
-void MetalRenderer::generateTileVertices(const Rect& destRect, const Rect& textureLogicalSize,
-                                         float designScale, std::vector<float>& outVertices)
-{
-    float left, right, top, bottom;
-    convertToNDC(destRect.x, destRect.y, left, top);
-    convertToNDC(destRect.x + destRect.width, destRect.y + destRect.height, right, bottom);
-    
-    float repeatX = destRect.width / textureLogicalSize.width;
-    float repeatY = destRect.height / textureLogicalSize.height;
-    
-    float vertices[] =
-    {
-        left,  top,    0.0f,    0.0f,
-        left,  bottom, 0.0f,    repeatY,
-        right, bottom, repeatX, repeatY,
-        left,  top,    0.0f,    0.0f,
-        right, bottom, repeatX, repeatY,
-        right, top,    repeatX, 0.0f
-    };
-    
-    outVertices.insert(outVertices.end(), vertices, vertices + 24);
-}
-
-void MetalRenderer::computeNineSliceRects(const Rect& destRect, const Rect& sourceRect,
-                                          const NineSliceMargins& margins, float designScale,
-                                          Rect outSlices[9])
-{
-
-    // Destination space (目标坐标，逻辑像素)
-    float destLeft = margins.left;
-    float destTop = margins.top;
-    float destRight = margins.right;
-    float destBottom = margins.bottom;
-    
-    float destCenterWidth = destRect.width - destLeft - destRight;
-    float destCenterHeight = destRect.height - destTop - destBottom;
-    
-    if (destCenterWidth < 0.0f) destCenterWidth = 0.0f;
-    if (destCenterHeight < 0.0f) destCenterHeight = 0.0f;
-    
-    // Row 0: Top-left, Top-center, Top-right
-    outSlices[0] = Rect(destRect.x, destRect.y, destLeft, destTop);
-    outSlices[1] = Rect(destRect.x + destLeft, destRect.y, destCenterWidth, destTop);
-    outSlices[2] = Rect(destRect.x + destLeft + destCenterWidth, destRect.y, destRight, destTop);
-    
-    // Row 1: Middle-left, Middle-center, Middle-right
-    outSlices[3] = Rect(destRect.x, destRect.y + destTop, destLeft, destCenterHeight);
-    outSlices[4] = Rect(destRect.x + destLeft, destRect.y + destTop, destCenterWidth, destCenterHeight);
-    outSlices[5] = Rect(destRect.x + destLeft + destCenterWidth, destRect.y + destTop, destRight, destCenterHeight);
-    
-    // Row 2: Bottom-left, Bottom-center, Bottom-right
-    outSlices[6] = Rect(destRect.x, destRect.y + destTop + destCenterHeight, destLeft, destBottom);
-    outSlices[7] = Rect(destRect.x + destLeft, destRect.y + destTop + destCenterHeight, destCenterWidth, destBottom);
-    outSlices[8] = Rect(destRect.x + destLeft + destCenterWidth, destRect.y + destTop + destCenterHeight, destRight, destBottom);
-}
-
-void MetalRenderer::generateNineSliceVertices(void* texture, const Rect& destRect,
-                                              const Rect& sourceRect, const NineSliceMargins& margins,
-                                              float designScale, uint32_t texWidth, uint32_t texHeight,
-                                              std::vector<float>& outVertices)
-{
-    Rect destSlices[9];
-    computeNineSliceRects(destRect, sourceRect, margins, designScale, destSlices);
-    
-    // Calculate source slice rectangle (texture space, physical pixels)
-    float srcLeft = margins.left * designScale;
-    float srcTop = margins.top * designScale;
-    float srcRight = margins.right * designScale;
-    float srcBottom = margins.bottom * designScale;
-    
-    float srcCenterWidth = sourceRect.width - srcLeft - srcRight;
-    float srcCenterHeight = sourceRect.height - srcTop - srcBottom;
-    
-    Rect srcSlices[9];
-    
-    // Row 0
-    srcSlices[0] = Rect(sourceRect.x, sourceRect.y, srcLeft, srcTop);
-    srcSlices[1] = Rect(sourceRect.x + srcLeft, sourceRect.y, srcCenterWidth, srcTop);
-    srcSlices[2] = Rect(sourceRect.x + sourceRect.width - srcRight, sourceRect.y, srcRight, srcTop);
-    
-    // Row 1
-    srcSlices[3] = Rect(sourceRect.x, sourceRect.y + srcTop, srcLeft, srcCenterHeight);
-    srcSlices[4] = Rect(sourceRect.x + srcLeft, sourceRect.y + srcTop, srcCenterWidth, srcCenterHeight);
-    srcSlices[5] = Rect(sourceRect.x + sourceRect.width - srcRight, sourceRect.y + srcTop, srcRight, srcCenterHeight);
-    
-    // Row 2
-    srcSlices[6] = Rect(sourceRect.x, sourceRect.y + sourceRect.height - srcBottom, srcLeft, srcBottom);
-    srcSlices[7] = Rect(sourceRect.x + srcLeft, sourceRect.y + sourceRect.height - srcBottom, srcCenterWidth, srcBottom);
-    srcSlices[8] = Rect(sourceRect.x + sourceRect.width - srcRight, sourceRect.y + sourceRect.height - srcBottom, srcRight, srcBottom);
-    
-    for (int i = 0; i < 9; ++i)
-    {
-        if (destSlices[i].width > 0.0f && destSlices[i].height > 0.0f &&
-            srcSlices[i].width > 0.0f && srcSlices[i].height > 0.0f)
-        {
-            generateImageVertices(destSlices[i], srcSlices[i], texWidth, texHeight, outVertices);
-        }
-    }
-}
-
-void MetalRenderer::renderImageBatch(const std::vector<size_t>& commandIndices,
-                                     const std::vector<RenderCommand>& commands,
-                                     void* texture, const Rect& clipRect, bool hasClip)
-{
-    if (commandIndices.empty()) return;
-    
-    @autoreleasepool
-    {
-        if (hasClip) applyScissorRect(clipRect);
-        else applyFullScreenScissor();
-        
-        std::vector<float> vertexData;
-        vertexData.reserve(commandIndices.size() * 24);
-        
-        bool useRepeatSampler = false;
-        
-        for (size_t idx : commandIndices)
-        {
-            const auto& cmd = commands[idx];
             
-            uint32_t texWidth = 0, texHeight = 0;
-            float designScale = 1.0f;
-            m_textureCache->getTexture(
-                cmd.resourceNamespace.c_str(),
-                cmd.text.c_str(),
-                texWidth, texHeight, &designScale
-            );
+            [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
             
-            if (cmd.scaleMode == ScaleMode::Tile)
-            {
-                useRepeatSampler = true;
-                
-                Rect textureLogicalSize(0, 0, texWidth / designScale, texHeight / designScale);
-                generateTileVertices(cmd.rect, textureLogicalSize, designScale, vertexData);
-            }
-            else
+            switch (batch.pipeline)
             {
-                Rect sourceRect = cmd.sourceRect;
-                if (sourceRect.width == 0.0f || sourceRect.height == 0.0f)
-                {
-                    sourceRect = Rect(0, 0, texWidth, texHeight);
-                }
-                else
-                {
-                    sourceRect.x *= designScale;
-                    sourceRect.y *= designScale;
-                    sourceRect.width *= designScale;
-                    sourceRect.height *= designScale;
-                }
-                
-                Rect destRect = cmd.rect;
-                
-                if (cmd.scaleMode == ScaleMode::Original)
-                {
-                    float logicalWidth = sourceRect.width / designScale;
-                    float logicalHeight = sourceRect.height / designScale;
-                    float centerX = destRect.x + destRect.width * 0.5f;
-                    float centerY = destRect.y + destRect.height * 0.5f;
-                    destRect = Rect(centerX - logicalWidth * 0.5f,
-                                   centerY - logicalHeight * 0.5f,
-                                   logicalWidth, logicalHeight);
-                }
-                else if (cmd.scaleMode == ScaleMode::Fill)
-                {
-                    float destAspect = destRect.width / destRect.height;
-                    float srcAspect = sourceRect.width / sourceRect.height;
-                    if (srcAspect > destAspect)
-                    {
-                        float newHeight = destRect.width / srcAspect;
-                        destRect = Rect(destRect.x,
-                                       destRect.y + (destRect.height - newHeight) * 0.5f,
-                                       destRect.width, newHeight);
-                    }
-                    else
-                    {
-                        float newWidth = destRect.height * srcAspect;
-                        destRect = Rect(destRect.x + (destRect.width - newWidth) * 0.5f,
-                                       destRect.y, newWidth, destRect.height);
-                    }
-                }
-                
-                if (cmd.scaleMode == ScaleMode::NineSlice)
-                {
-                    YUCHEN_PERF_NINE_SLICE();
-                    generateNineSliceVertices(texture, destRect, sourceRect,
-                                             cmd.nineSliceMargins, designScale,
-                                             texWidth, texHeight, vertexData);
-                }
-                else
+                case ActivePipeline::Rect:
+                    [m_renderEncoder setVertexBuffer:rectBuffer offset:0 atIndex:0];
+                    [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
+                                         vertexStart:batch.firstVertex
+                                         vertexCount:batch.vertexCount];
+                    break;
+                    
+                case ActivePipeline::Text:
                 {
-                    YUCHEN_PERF_IMAGE_DRAW();
-                    generateImageVertices(destRect, sourceRect, texWidth, texHeight, vertexData);
+                    YUCHEN_PERF_TEXTURE_SWITCH();
+                    [m_renderEncoder setFragmentTexture:unwrapTexture(batch.texture) atIndex:0];
+                    [m_renderEncoder setFragmentSamplerState:m_textSampler atIndex:0];
+                    [m_renderEncoder setVertexBuffer:textBuffer offset:0 atIndex:0];
+                    
+                    // 6 indices per 4-vertex quad
+                    NSUInteger indexCount = (batch.vertexCount / 4) * 6;
+                    NSUInteger indexOffset = (batch.firstVertex / 4) * 6 * sizeof(uint16_t);
+                    [m_renderEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
+                                                indexCount:indexCount
+                                                 indexType:MTLIndexTypeUInt16
+                                               indexBuffer:m_textIndexBuffer
+                                         indexBufferOffset:indexOffset];
+                    break;
                 }
-            }
-        }
-        
-        if (vertexData.empty()) return;
-        
-        size_t vertexCount = vertexData.size() / 4;
-        
-        YUCHEN_PERF_BUFFER_CREATE();
-        YUCHEN_PERF_VERTICES(vertexCount);
-        
-        id<MTLBuffer> vertexBuffer = [m_device newBufferWithBytes:vertexData.data()
-                                                           length:vertexData.size() * sizeof(float)
-                                                          options:MTLResourceStorageModeShared];
-        
-        TextureWrapper* wrapper = (__bridge TextureWrapper*)texture;
-        id<MTLTexture> mtlTexture = wrapper.texture;
-        
-        YUCHEN_PERF_TEXTURE_SWITCH();
-        [m_renderEncoder setFragmentTexture:mtlTexture atIndex:0];
-        
-        if (useRepeatSampler)
-        {
-            [m_renderEncoder setFragmentSamplerState:m_imageSamplerRepeat atIndex:0];
-        }
-        else
-        {
-            [m_renderEncoder setFragmentSamplerState:m_imageSampler atIndex:0];
-        }
-        
-        ViewportUniforms uniforms = getViewportUniforms();
-        id<MTLBuffer> uniformBuffer = [m_device newBufferWithBytes:&uniforms
-                                                            length:sizeof(ViewportUniforms)
-                                                           options:MTLResourceStorageModeShared];
-        
-        [m_renderEncoder setVertexBuffer:vertexBuffer offset:0 atIndex:0];
-        [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
-        
-        YUCHEN_PERF_DRAW_CALL();
-        [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
-                             vertexStart:0
-                             vertexCount:vertexCount];
-    }
-}
-
-//==========================================================================================
-// [SECTION] Text Rendering
-
-void MetalRenderer::renderTextBatches(const std::vector<TextVertex>& allVertices,
-                                      const std::vector<size_t>& batchStarts,
-                                      const std::vector<size_t>& batchCounts,
-                                      const std::vector<Rect>& batchClips,
-                                      const std::vector<bool>& batchHasClips)
-{
-    if (allVertices.empty() || batchStarts.empty()) return;
-    
-    @autoreleasepool
-    {
-        setPipeline(ActivePipeline::Text);
-        
-        // Get atlas texture from text renderer
-        void* atlasTexture = getCurrentAtlasTexture();
-        if (!atlasTexture) return;
-        
-        id<MTLTexture> texture = (__bridge id<MTLTexture>)atlasTexture;
-        [m_renderEncoder setFragmentTexture:texture atIndex:0];
-        [m_renderEncoder setFragmentSamplerState:m_textSampler atIndex:0];
-        
-        // Copy all vertices to pre-allocated buffer
-        NSUInteger vertexDataSize = allVertices.size() * sizeof(TextVertex);
-        YUCHEN_ASSERT_MSG(vertexDataSize <= [m_textVertexBuffer length], "Text vertex data too large");
-        
-        memcpy([m_textVertexBuffer contents], allVertices.data(), vertexDataSize);
-        
-        // Setup viewport uniforms
-        ViewportUniforms uniforms = getViewportUniforms();
-        id<MTLBuffer> uniformBuffer = [m_device newBufferWithBytes:&uniforms
-                                                            length:sizeof(ViewportUniforms)
-                                                           options:MTLResourceStorageModeShared];
-        [m_renderEncoder setVertexBuffer:m_textVertexBuffer offset:0 atIndex:0];
-        [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
-        
-        // Render each batch
-        for (size_t i = 0; i < batchStarts.size(); ++i)
-        {
-            // Apply clip for this batch
-            if (batchHasClips[i])
-            {
-                applyScissorRect(batchClips[i]);
-            }
-            else
-            {
-                applyFullScreenScissor();
+                    
+                case ActivePipeline::Image:
+                    YUCHEN_PERF_TEXTURE_SWITCH();
+                    [m_renderEncoder setFragmentTexture:unwrapTexture(batch.texture) atIndex:0];
+                    [m_renderEncoder setFragmentSamplerState:(batch.repeatSampler ? m_imageSamplerRepeat : m_imageSampler)
+                                                     atIndex:0];
+                    [m_renderEncoder setVertexBuffer:imageBuffer offset:0 atIndex:0];
+                    [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
+                                         vertexStart:batch.firstVertex
+                                         vertexCount:batch.vertexCount];
+                    break;
+                    
+                case ActivePipeline::Shape:
+                    [m_renderEncoder setVertexBuffer:shapeBuffer offset:0 atIndex:0];
+                    [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
+                                         vertexStart:batch.firstVertex
+                                         vertexCount:batch.vertexCount];
+                    break;
+                    
+                case ActivePipeline::Circle:
+                    [m_renderEncoder setVertexBuffer:circleBuffer offset:0 atIndex:0];
+                    [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
+                                         vertexStart:batch.firstVertex
+                                         vertexCount:batch.vertexCount];
+                    break;
+                    
+                default:
+                    continue;
             }
             
-            // Draw using indexed rendering
-            NSUInteger indexCount = (batchCounts[i] / 4) * 6;  // 6 indices per quad
-            NSUInteger indexOffset = (batchStarts[i] / 4) * 6 * sizeof(uint16_t);
-            
-            [m_renderEncoder drawIndexedPrimitives:MTLPrimitiveTypeTriangle
-                                        indexCount:indexCount
-                                         indexType:MTLIndexTypeUInt16
-                                       indexBuffer:m_textIndexBuffer
-                                 indexBufferOffset:indexOffset];
+            YUCHEN_PERF_DRAW_CALL();
+            YUCHEN_PERF_VERTICES(batch.vertexCount);
         }
     }
+    
+    applyFullScreenScissor();
 }
 
 //==========================================================================================
-// [SECTION] Shape Rendering - Batched Implementations
+// [SECTION] Batch Submission
 
-void MetalRenderer::renderLineBatch(const std::vector<RenderCommand>& commands,
-                                    const Rect& clipRect, bool hasClip)
+id<MTLBuffer> MetalRenderer::uploadVertices(id<MTLBuffer> reusable, const void* data, size_t bytes)
 {
-    if (commands.empty()) return;
+    if (bytes == 0) return nil;
     
-    @autoreleasepool
+    if (reusable && bytes <= [reusable length])
     {
-        setPipeline(ActivePipeline::Shape);
-        
-        // Apply clipping once for entire batch
-        if (hasClip) applyScissorRect(clipRect);
-        else applyFullScreenScissor();
-        
-        // Setup viewport uniforms (shared across all sub-batches)
-        ViewportUniforms uniforms = getViewportUniforms();
-        id<MTLBuffer> uniformBuffer = [m_device newBufferWithBytes:&uniforms
-                                                            length:sizeof(ViewportUniforms)
-                                                           options:MTLResourceStorageModeShared];
-        
-        // Calculate maximum vertices per sub-batch
-        NSUInteger bufferSize = [m_shapeVertexBuffer length];
-        size_t maxVerticesPerBatch = bufferSize / sizeof(ShapeVertex);
-        
-        // Collect all line vertices
-        std::vector<ShapeVertex> allVertices;
-        allVertices.reserve(commands.size() * 6);  // 6 vertices per line
-        
-        for (const auto& cmd : commands)
-        {
-            // Compute line direction vector
-            Vec2 direction(cmd.lineEnd.x - cmd.lineStart.x,
-                          cmd.lineEnd.y - cmd.lineStart.y);
-            float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-            
-            if (length < 0.001f) continue;  // Skip degenerate lines
-            
-            // Normalize direction
-            direction.x /= length;
-            direction.y /= length;
-            
-            // Compute perpendicular vector (90-degree rotation)
-            Vec2 perpendicular(-direction.y, direction.x);
-            float halfWidth = cmd.lineWidth * 0.5f;
-            
-            // Generate quad vertices
-            Vec2 p1(cmd.lineStart.x + perpendicular.x * halfWidth,
-                   cmd.lineStart.y + perpendicular.y * halfWidth);
-            Vec2 p2(cmd.lineStart.x - perpendicular.x * halfWidth,
-                   cmd.lineStart.y - perpendicular.y * halfWidth);
-            Vec2 p3(cmd.lineEnd.x - perpendicular.x * halfWidth,
-                   cmd.lineEnd.y - perpendicular.y * halfWidth);
-            Vec2 p4(cmd.lineEnd.x + perpendicular.x * halfWidth,
-                   cmd.lineEnd.y + perpendicular.y * halfWidth);
-            
-            // First triangle (p1, p2, p3)
-            allVertices.push_back(ShapeVertex(p1, cmd.color));
-            allVertices.push_back(ShapeVertex(p2, cmd.color));
-            allVertices.push_back(ShapeVertex(p3, cmd.color));
-            
-            // Second triangle (p1, p3, p4)
-            allVertices.push_back(ShapeVertex(p1, cmd.color));
-            allVertices.push_back(ShapeVertex(p3, cmd.color));
-            allVertices.push_back(ShapeVertex(p4, cmd.color));
-        }
-        
-        if (allVertices.empty()) return;
-        
-        // Render in sub-batches if necessary
-        size_t totalVertices = allVertices.size();
-        size_t vertexOffset = 0;
-        int batchCount = 0;
-        
-        while (vertexOffset < totalVertices)
-        {
-            size_t batchSize = std::min(totalVertices - vertexOffset, maxVerticesPerBatch);
-            NSUInteger batchDataSize = batchSize * sizeof(ShapeVertex);
-            
-            // Copy this sub-batch to buffer
-            memcpy([m_shapeVertexBuffer contents],
-                   allVertices.data() + vertexOffset,
-                   batchDataSize);
-            
-            // Bind buffers
-            [m_renderEncoder setVertexBuffer:m_shapeVertexBuffer offset:0 atIndex:0];
-            [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
-            
-            // Draw this sub-batch
-            [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
-                                 vertexStart:0
-                                 vertexCount:batchSize];
-            
-            vertexOffset += batchSize;
-            batchCount++;
-            
-            YUCHEN_PERF_DRAW_CALL();
-            YUCHEN_PERF_VERTICES(batchSize);
-        }
-        
-        // Log warning only if multiple batches were needed (diagnostic info)
-        if (batchCount > 1)
-        {
-            static int warningCount = 0;
-            if (warningCount++ < 3)  // Only show first 3 warnings
-            {
-                NSLog(@"[YuchenUI] Info: Line batch split into %d sub-batches (%zu vertices total). "
-                      "Consider increasing MAX_SHAPE_VERTICES if this happens frequently.",
-                      batchCount, totalVertices);
-            }
-        }
+        memcpy([reusable contents], data, bytes);
+        return reusable;
     }
-}
-
-void MetalRenderer::renderTriangleBatch(const std::vector<RenderCommand>& commands,
-                                       const Rect& clipRect, bool hasClip)
-{
-    if (commands.empty()) return;
     
-    @autoreleasepool
-    {
-        setPipeline(ActivePipeline::Shape);
-        
-        // Apply clipping
-        if (hasClip) applyScissorRect(clipRect);
-        else applyFullScreenScissor();
-        
-        // Collect vertices
-        std::vector<ShapeVertex> allVertices;
-        allVertices.reserve(commands.size() * 6);  // Max 6 vertices per triangle (outline mode)
-        
-        for (const auto& cmd : commands)
-        {
-            bool isFilled = (cmd.type == RenderCommandType::FillTriangle);
-            
-            if (isFilled)
-            {
-                // Filled triangle: 3 vertices
-                allVertices.push_back(ShapeVertex(cmd.triangleP1, cmd.color));
-                allVertices.push_back(ShapeVertex(cmd.triangleP2, cmd.color));
-                allVertices.push_back(ShapeVertex(cmd.triangleP3, cmd.color));
-            }
-            else
-            {
-                // Outline triangle: draw as 3 lines (18 vertices total)
-                // For simplicity, we'll convert to line commands
-                // (In production, you might want a specialized outline shader)
-                
-                // Line 1: p1 -> p2
-                Vec2 dir1(cmd.triangleP2.x - cmd.triangleP1.x, cmd.triangleP2.y - cmd.triangleP1.y);
-                float len1 = std::sqrt(dir1.x * dir1.x + dir1.y * dir1.y);
-                if (len1 > 0.001f)
-                {
-                    dir1.x /= len1; dir1.y /= len1;
-                    Vec2 perp1(-dir1.y, dir1.x);
-                    float hw = cmd.borderWidth * 0.5f;
-                    
-                    Vec2 a1(cmd.triangleP1.x + perp1.x * hw, cmd.triangleP1.y + perp1.y * hw);
-                    Vec2 a2(cmd.triangleP1.x - perp1.x * hw, cmd.triangleP1.y - perp1.y * hw);
-                    Vec2 a3(cmd.triangleP2.x - perp1.x * hw, cmd.triangleP2.y - perp1.y * hw);
-                    Vec2 a4(cmd.triangleP2.x + perp1.x * hw, cmd.triangleP2.y + perp1.y * hw);
-                    
-                    allVertices.push_back(ShapeVertex(a1, cmd.color));
-                    allVertices.push_back(ShapeVertex(a2, cmd.color));
-                    allVertices.push_back(ShapeVertex(a3, cmd.color));
-                    allVertices.push_back(ShapeVertex(a1, cmd.color));
-                    allVertices.push_back(ShapeVertex(a3, cmd.color));
-                    allVertices.push_back(ShapeVertex(a4, cmd.color));
-                }
-                
-                // Line 2 and 3 omitted for brevity - follow same pattern
-            }
-        }
-        
-        if (allVertices.empty()) return;
-        
-        // Check buffer capacity
-        NSUInteger dataSize = allVertices.size() * sizeof(ShapeVertex);
-        if (dataSize > [m_shapeVertexBuffer length])
-        {
-            NSLog(@"[YuchenUI] Warning: Triangle batch too large");
-            return;  // Skip or implement batching
-        }
-        
-        // Copy and draw
-        memcpy([m_shapeVertexBuffer contents], allVertices.data(), dataSize);
-        
-        ViewportUniforms uniforms = getViewportUniforms();
-        id<MTLBuffer> uniformBuffer = [m_device newBufferWithBytes:&uniforms
-                                                            length:sizeof(ViewportUniforms)
-                                                           options:MTLResourceStorageModeShared];
-        
-        [m_renderEncoder setVertexBuffer:m_shapeVertexBuffer offset:0 atIndex:0];
-        [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
-        [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
-                             vertexStart:0
-                             vertexCount:allVertices.size()];
-    }
+    YUCHEN_PERF_BUFFER_CREATE();
+    return [m_device newBufferWithBytes:data length:bytes options:MTLResourceStorageModeShared];
 }
 
-void MetalRenderer::renderCircleBatch(const std::vector<RenderCommand>& commands,
-                                     const Rect& clipRect, bool hasClip)
+id<MTLTexture> MetalRenderer::unwrapTexture(void* handle) const
 {
-    if (commands.empty()) return;
-    
-    @autoreleasepool
-    {
-        setPipeline(ActivePipeline::Circle);
-        
-        // Apply clipping
-        if (hasClip) applyScissorRect(clipRect);
-        else applyFullScreenScissor();
-        
-        // Collect all circle vertices
-        std::vector<CircleVertex> allVertices;
-        allVertices.reserve(commands.size() * 6);  // 6 vertices per circle
-        
-        for (const auto& cmd : commands)
-        {
-            bool isFilled = (cmd.type == RenderCommandType::FillCircle);
-            float bw = isFilled ? 0.0f : cmd.borderWidth;
-            
-            // Create bounding quad for circle
-            float left = cmd.circleCenter.x - cmd.circleRadius - 2.0f;
-            float right = cmd.circleCenter.x + cmd.circleRadius + 2.0f;
-            float top = cmd.circleCenter.y - cmd.circleRadius - 2.0f;
-            float bottom = cmd.circleCenter.y + cmd.circleRadius + 2.0f;
-            
-            // Two triangles (6 vertices)
-            allVertices.push_back(CircleVertex(Vec2(left, top), cmd.circleCenter,
-                                              cmd.circleRadius, bw, cmd.color));
-            allVertices.push_back(CircleVertex(Vec2(left, bottom), cmd.circleCenter,
-                                              cmd.circleRadius, bw, cmd.color));
-            allVertices.push_back(CircleVertex(Vec2(right, bottom), cmd.circleCenter,
-                                              cmd.circleRadius, bw, cmd.color));
-            
-            allVertices.push_back(CircleVertex(Vec2(left, top), cmd.circleCenter,
-                                              cmd.circleRadius, bw, cmd.color));
-            allVertices.push_back(CircleVertex(Vec2(right, bottom), cmd.circleCenter,
-                                              cmd.circleRadius, bw, cmd.color));
-            allVertices.push_back(CircleVertex(Vec2(right, top), cmd.circleCenter,
-                                              cmd.circleRadius, bw, cmd.color));
-        }
-        
-        if (allVertices.empty()) return;
-        
-        // Validate buffer size
-        NSUInteger dataSize = allVertices.size() * sizeof(CircleVertex);
-        if (dataSize > [m_circleVertexBuffer length])
-        {
-            NSLog(@"[YuchenUI] Warning: Circle batch too large");
-            return;
-        }
-        
-        // Copy vertices to buffer
-        memcpy([m_circleVertexBuffer contents], allVertices.data(), dataSize);
-        
-        // Setup uniforms
-        ViewportUniforms uniforms = getViewportUniforms();
-        id<MTLBuffer> uniformBuffer = [m_device newBufferWithBytes:&uniforms
-                                                            length:sizeof(ViewportUniforms)
-                                                           options:MTLResourceStorageModeShared];
-        
-        // Bind and draw
-        [m_renderEncoder setVertexBuffer:m_circleVertexBuffer offset:0 atIndex:0];
-        [m_renderEncoder setVertexBuffer:uniformBuffer offset:0 atIndex:1];
-        [m_renderEncoder drawPrimitives:MTLPrimitiveTypeTriangle
-                             vertexStart:0
-                             vertexCount:allVertices.size()];
-    }
+    if (!handle) return nil;
+    TextureWrapper* wrapper = (__bridge TextureWrapper*)handle;
+    return wrapper.texture;
 }
 
-
-// Keep renderTriangle and renderCircle implementations as-is for now
 //==========================================================================================
 // [SECTION] Texture Management
 
@@ -2112,9 +1137,11 @@ void* MetalRenderer::getCurrentAtlasTexture() const
 void* MetalRenderer::createTexture2D(uint32_t width, uint32_t height, TextureFormat format)
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "Renderer not initialized");
+    YUCHEN_ASSERT_MSG(format != TextureFormat::R8_DistanceField,
+                      "Text shader samples distance fields as coverage (supportsDistanceFieldText)");
     
     // Convert format to Metal pixel format
-    MTLPixelFormat pixelFormat = (format == TextureFormat::R8_Unorm)
+    MTLPixelFormat pixelFormat = (format != TextureFormat::RGBA8_Unorm)
         ? MTLPixelFormatR8Unorm
         : MTLPixelFormatRGBA8Unorm;
     
@@ -2169,13 +1196,6 @@ void MetalRenderer::destroyTexture(void* texture)
 //==========================================================================================
 // [SECTION] Utilities
 
-void MetalRenderer::convertToNDC(float x, float y, float& ndcX, float& ndcY) const
-{
-    // Convert from window coordinates to normalized device coordinates (-1 to 1)
-    ndcX = (x / static_cast<float>(m_width)) * 2.0f - 1.0f;
-    ndcY = 1.0f - (y / static_cast<float>(m_height)) * 2.0f;
-}
-
 ViewportUniforms MetalRenderer::getViewportUniforms() const
 {
     ViewportUniforms uniforms;
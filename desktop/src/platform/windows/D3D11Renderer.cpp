@@ -37,33 +37,6 @@
 #undef DrawTextW
 #endif
 
-namespace {
-
-using namespace YuchenUI;
-
-struct ImageVertex {
-    Vec2 position;
-    Vec2 texCoord;
-};
-
-struct ClipState {
-    YuchenUI::Rect clipRect;
-    bool hasClip;
-};
-
-uint64_t computeClipHash(const ClipState& state) {
-    if (!state.hasClip) return 0;
-    
-    uint64_t hash = 0;
-    hash ^= std::hash<float>()(state.clipRect.x);
-    hash ^= std::hash<float>()(state.clipRect.y) << 1;
-    hash ^= std::hash<float>()(state.clipRect.width) << 2;
-    hash ^= std::hash<float>()(state.clipRect.height) << 3;
-    return hash;
-}
-
-}
-
 namespace YuchenUI {
 
 //==========================================================================================
@@ -92,13 +65,23 @@ D3D11Renderer::D3D11Renderer()
     , m_circleInputLayout(nullptr)
     , m_blendState(nullptr)
     , m_samplerState(nullptr)
+    , m_samplerStateRepeat(nullptr)
     , m_rasterizerState(nullptr)
     , m_constantBuffer(nullptr)
     , m_textVertexBuffer(nullptr)
     , m_textIndexBuffer(nullptr)
+    , m_rectVertexBuffer(nullptr)
+    , m_imageVertexBuffer(nullptr)
+    , m_shapeVertexBuffer(nullptr)
+    , m_circleVertexBuffer(nullptr)
+    , m_rectBufferBytes(0)
+    , m_imageBufferBytes(0)
+    , m_shapeBufferBytes(0)
+    , m_circleBufferBytes(0)
     , m_currentPipeline(ActivePipeline::None)
     , m_textRenderer(nullptr)
     , m_textureCache(nullptr)
+    , m_batchCompiler(nullptr)
     , m_isInitialized(false)
     , m_width(0)
     , m_height(0)
@@ -216,6 +199,8 @@ bool D3D11Renderer::initialize(void* platformSurface, int width, int height, flo
     }
     m_textureCache->setCurrentDPI(m_dpiScale);
     
+    m_batchCompiler = std::make_unique<RenderBatchCompiler>(m_textRenderer.get(), m_textureCache.get());
+    
     return true;
 }
 
@@ -290,8 +275,10 @@ void D3D11Renderer::endFrame()
 void* D3D11Renderer::createTexture2D(uint32_t width, uint32_t height, TextureFormat format)
 {
     YUCHEN_ASSERT_MSG(m_isInitialized, "Renderer not initialized");
+    YUCHEN_ASSERT_MSG(format != TextureFormat::R8_DistanceField,
+                      "Text shader samples distance fields as coverage (supportsDistanceFieldText)");
     
-    DXGI_FORMAT dxgiFormat = (format == TextureFormat::R8_Unorm) ?
+    DXGI_FORMAT dxgiFormat = (format != TextureFormat::RGBA8_Unorm) ?
         DXGI_FORMAT_R8_UNORM : DXGI_FORMAT_R8G8B8A8_UNORM;
     
     D3D11_TEXTURE2D_DESC texDesc = {};
@@ -645,7 +632,13 @@ bool D3D11Renderer::createSamplerStates()
     samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_CLAMP;
     samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_CLAMP;
     
-    return SUCCEEDED(m_device->CreateSamplerState(&samplerDesc, &m_samplerState));
+    if (FAILED(m_device->CreateSamplerState(&samplerDesc, &m_samplerState))) return false;
+    
+    samplerDesc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.AddressV = D3D11_TEXTURE_ADDRESS_WRAP;
+    samplerDesc.AddressW = D3D11_TEXTURE_ADDRESS_WRAP;
+    
+    return SUCCEEDED(m_device->CreateSamplerState(&samplerDesc, &m_samplerStateRepeat));
 }
 
 bool D3D11Renderer::createRasterizerStates()
@@ -671,6 +664,8 @@ bool D3D11Renderer::createConstantBuffers()
 
 void D3D11Renderer::releaseResources()
 {
+    m_batchCompiler.reset();
+    
     if (m_textRenderer) {
         m_textRenderer->destroy();
         m_textRenderer.reset();
@@ -681,11 +676,17 @@ void D3D11Renderer::releaseResources()
         m_textureCache.reset();
     }
     
+    if (m_circleVertexBuffer) { m_circleVertexBuffer->Release(); m_circleVertexBuffer = nullptr; }
+    if (m_shapeVertexBuffer) { m_shapeVertexBuffer->Release(); m_shapeVertexBuffer = nullptr; }
+    if (m_imageVertexBuffer) { m_imageVertexBuffer->Release(); m_imageVertexBuffer = nullptr; }
+    if (m_rectVertexBuffer) { m_rectVertexBuffer->Release(); m_rectVertexBuffer = nullptr; }
+    m_rectBufferBytes = m_imageBufferBytes = m_shapeBufferBytes = m_circleBufferBytes = 0;
     if (m_textIndexBuffer) { m_textIndexBuffer->Release(); m_textIndexBuffer = nullptr; }
     if (m_textVertexBuffer) { m_textVertexBuffer->Release(); m_textVertexBuffer = nullptr; }
     if (m_constantBuffer) { m_constantBuffer->Release(); m_constantBuffer = nullptr; }
     
     if (m_rasterizerState) { m_rasterizerState->Release(); m_rasterizerState = nullptr; }
+    if (m_samplerStateRepeat) { m_samplerStateRepeat->Release(); m_samplerStateRepeat = nullptr; }
     if (m_samplerState) { m_samplerState->Release(); m_samplerState = nullptr; }
     if (m_blendState) { m_blendState->Release(); m_blendState = nullptr; }
     
@@ -798,259 +799,110 @@ void D3D11Renderer::applyFullScreenScissor()
 
 void D3D11Renderer::executeRenderCommands(const RenderList& commandList)
 {
-    const auto& commands = commandList.getCommands();
-    if (commands.empty()) return;
+    if (commandList.isEmpty()) return;
     
-    std::vector<ClipState> clipStates(commands.size());
-    std::vector<Rect> clipStack;
+    m_batchCompiler->compile(commandList, Vec2(static_cast<float>(m_width), static_cast<float>(m_height)));
+    if (m_batchCompiler->hasClearColor()) m_clearColor = m_batchCompiler->getClearColor();
     
-    for (size_t i = 0; i < commands.size(); ++i) {
-        const auto& cmd = commands[i];
-        
-        if (cmd.type == RenderCommandType::PushClip) {
-            Rect newClip = cmd.rect;
-            
-            if (!clipStack.empty()) {
-                const Rect& parentClip = clipStack.back();
-                
-                float x1 = std::max(parentClip.x, newClip.x);
-                float y1 = std::max(parentClip.y, newClip.y);
-                float x2 = std::min(parentClip.x + parentClip.width, newClip.x + newClip.width);
-                float y2 = std::min(parentClip.y + parentClip.height, newClip.y + newClip.height);
-                
-                if (x2 > x1 && y2 > y1) {
-                    newClip = Rect(x1, y1, x2 - x1, y2 - y1);
-                } else {
-                    newClip = Rect(0, 0, 0, 0);
-                }
-            }
-            
-            clipStack.push_back(newClip);
-            clipStates[i].clipRect = newClip;
-            clipStates[i].hasClip = true;
-        }
-        else if (cmd.type == RenderCommandType::PopClip) {
-            if (!clipStack.empty()) {
-                clipStack.pop_back();
-            }
-            
-            if (!clipStack.empty()) {
-                clipStates[i].clipRect = clipStack.back();
-                clipStates[i].hasClip = true;
-            } else {
-                clipStates[i].hasClip = false;
-            }
-        }
-        else {
-            if (!clipStack.empty()) {
-                clipStates[i].clipRect = clipStack.back();
-                clipStates[i].hasClip = true;
-            } else {
-                clipStates[i].hasClip = false;
-            }
-        }
-    }
+    const auto& batches = m_batchCompiler->getBatches();
+    if (batches.empty()) return;
     
-    std::map<uint64_t, std::vector<RenderCommand>> rectGroups;
-    std::map<uint64_t, Rect> rectGroupClips;
-    std::map<uint64_t, bool> rectGroupHasClip;
+    // Upload each vertex stream once; batches draw sub-ranges of it
+    const auto& rectVertices = m_batchCompiler->getRectVertices();
+    const auto& textVertices = m_batchCompiler->getTextVertices();
+    const auto& imageVertices = m_batchCompiler->getImageVertices();
+    const auto& shapeVertices = m_batchCompiler->getShapeVertices();
+    const auto& circleVertices = m_batchCompiler->getCircleVertices();
     
-    struct ImageBatch {
-        std::vector<size_t> indices;
-        void* texture;
-        Rect clipRect;
-        bool hasClip;
-        size_t firstIndex;
-    };
-    std::vector<ImageBatch> imageBatches;
+    YUCHEN_ASSERT_MSG(textVertices.size() <= m_maxTextVertices, "Text vertex data too large");
     
-    std::vector<TextVertex> allTextVertices;
-    std::vector<size_t> textBatchStarts;
-    std::vector<size_t> textBatchCounts;
-    std::vector<Rect> textBatchClips;
-    std::vector<bool> textBatchHasClips;
-    allTextVertices.reserve(1024);
+    uploadVertices(m_rectVertexBuffer, m_rectBufferBytes, rectVertices.data(),
+                   rectVertices.size() * sizeof(RectVertex));
+    uploadVertices(m_imageVertexBuffer, m_imageBufferBytes, imageVertices.data(),
+                   imageVertices.size() * sizeof(ImageVertex));
+    uploadVertices(m_shapeVertexBuffer, m_shapeBufferBytes, shapeVertices.data(),
+                   shapeVertices.size() * sizeof(ShapeVertex));
+    uploadVertices(m_circleVertexBuffer, m_circleBufferBytes, circleVertices.data(),
+                   circleVertices.size() * sizeof(CircleVertex));
     
-    for (size_t i = 0; i < commands.size(); ++i) {
-        const auto& cmd = commands[i];
-        
-        switch (cmd.type) {
-            case RenderCommandType::Clear:
-                m_clearColor = cmd.color;
-                break;
-                
-            case RenderCommandType::FillRect:
-            case RenderCommandType::DrawRect: {
-                uint64_t clipHash = computeClipHash(clipStates[i]);
-                rectGroups[clipHash].push_back(cmd);
-                rectGroupClips[clipHash] = clipStates[i].clipRect;
-                rectGroupHasClip[clipHash] = clipStates[i].hasClip;
-                break;
-            }
-                
-            case RenderCommandType::DrawImage: {
-                uint32_t texWidth = 0, texHeight = 0;
-                float designScale = 1.0f;
-                void* texture = m_textureCache->getTexture(cmd.text.c_str(),
-                    texWidth, texHeight, &designScale);
-                if (texture) {
-                    uint64_t clipHash = computeClipHash(clipStates[i]);
-                    uint64_t textureHash = reinterpret_cast<uint64_t>(texture);
-                    uint64_t key = (textureHash << 32) | clipHash;
-                    
-                    bool foundBatch = false;
-                    for (auto& batch : imageBatches) {
-                        uint64_t batchKey = (reinterpret_cast<uint64_t>(batch.texture) << 32) |
-                            computeClipHash(ClipState{batch.clipRect, batch.hasClip});
-                        if (batchKey == key) {
-                            batch.indices.push_back(i);
-                            foundBatch = true;
-                            break;
-                        }
-                    }
-                    
-                    if (!foundBatch) {
-                        ImageBatch newBatch;
-                        newBatch.indices.push_back(i);
-                        newBatch.texture = texture;
-                        newBatch.clipRect = clipStates[i].clipRect;
-                        newBatch.hasClip = clipStates[i].hasClip;
-                        newBatch.firstIndex = i;
-                        imageBatches.push_back(newBatch);
-                    }
-                }
-                break;
-            }
-                
-            case RenderCommandType::DrawText: {
-                ShapedText shapedText;
-                m_textRenderer->shapeText(cmd.text.c_str(), cmd.westernFont,
-                    cmd.chineseFont, cmd.fontSize, shapedText);
-                if (!shapedText.isEmpty()) {
-                    std::vector<TextVertex> vertices;
-                    m_textRenderer->generateTextVertices(shapedText, cmd.textPosition,
-                        cmd.textColor, cmd.westernFont, cmd.fontSize, vertices);
-                    
-                    if (!vertices.empty()) {
-                        bool canMerge = false;
-                        if (!textBatchStarts.empty()) {
-                            size_t lastIdx = textBatchStarts.size() - 1;
-                            if (textBatchHasClips[lastIdx] == clipStates[i].hasClip) {
-                                if (!clipStates[i].hasClip ||
-                                    (textBatchClips[lastIdx].x == clipStates[i].clipRect.x &&
-                                     textBatchClips[lastIdx].y == clipStates[i].clipRect.y &&
-                                     textBatchClips[lastIdx].width == clipStates[i].clipRect.width &&
-                                     textBatchClips[lastIdx].height == clipStates[i].clipRect.height)) {
-                                    canMerge = true;
-                                }
-                            }
-                        }
-                        
-                        if (canMerge) {
-                            textBatchCounts.back() += vertices.size();
-                        } else {
-                            textBatchStarts.push_back(allTextVertices.size());
-                            textBatchCounts.push_back(vertices.size());
-                            textBatchClips.push_back(clipStates[i].clipRect);
-                            textBatchHasClips.push_back(clipStates[i].hasClip);
-                        }
-                        allTextVertices.insert(allTextVertices.end(), vertices.begin(), vertices.end());
-                    }
-                }
-                break;
-            }
-                
-            default:
-                break;
-        }
-    }
-    
-    if (!rectGroups.empty()) {
-        setPipeline(ActivePipeline::Rect);
-        for (const auto& pair : rectGroups) {
-            renderRectBatch(pair.second, rectGroupClips[pair.first], rectGroupHasClip[pair.first]);
-        }
+    if (!textVertices.empty()) {
+        D3D11_MAPPED_SUBRESOURCE mapped;
+        m_context->Map(m_textVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+        memcpy(mapped.pData, textVertices.data(), textVertices.size() * sizeof(TextVertex));
+        m_context->Unmap(m_textVertexBuffer, 0);
     }
     
-    if (!imageBatches.empty()) {
-        std::sort(imageBatches.begin(), imageBatches.end(),
-            [](const ImageBatch& a, const ImageBatch& b) {
-                return a.firstIndex < b.firstIndex;
-            });
-        
-        setPipeline(ActivePipeline::Image);
-        for (const auto& batch : imageBatches) {
-            renderImageBatch(batch.indices, commands, batch.texture, batch.clipRect, batch.hasClip);
-        }
-    }
-    
-    if (!textBatchStarts.empty()) {
-        renderTextBatches(allTextVertices, textBatchStarts, textBatchCounts,
-            textBatchClips, textBatchHasClips);
-    }
+    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_context->IASetIndexBuffer(m_textIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
     
-    Rect currentClip;
-    bool hasClip = false;
+    bool scissorValid = false;
+    bool scissorHasClip = false;
+    Rect scissorRect;
     
-    for (size_t i = 0; i < commands.size(); ++i) {
-        const auto& cmd = commands[i];
+    for (const RenderBatch& batch : batches) {
+        setPipeline(batch.pipeline);
         
-        if (cmd.type == RenderCommandType::PushClip) {
-            currentClip = clipStates[i].clipRect;
-            hasClip = clipStates[i].hasClip;
-            if (hasClip) {
-                applyScissorRect(currentClip);
-            }
-            continue;
-        }
-        else if (cmd.type == RenderCommandType::PopClip) {
-            hasClip = clipStates[i].hasClip;
-            if (hasClip) {
-                currentClip = clipStates[i].clipRect;
-                applyScissorRect(currentClip);
+        if (!scissorValid || scissorHasClip != batch.hasClip ||
+            (batch.hasClip && scissorRect != batch.clipRect)) {
+            if (batch.hasClip) {
+                applyScissorRect(batch.clipRect);
             } else {
                 applyFullScreenScissor();
             }
-            continue;
+            scissorValid = true;
+            scissorHasClip = batch.hasClip;
+            scissorRect = batch.clipRect;
         }
         
-        if (clipStates[i].hasClip && (!hasClip ||
-            currentClip.x != clipStates[i].clipRect.x ||
-            currentClip.y != clipStates[i].clipRect.y ||
-            currentClip.width != clipStates[i].clipRect.width ||
-            currentClip.height != clipStates[i].clipRect.height)) {
-            currentClip = clipStates[i].clipRect;
-            hasClip = true;
-            applyScissorRect(currentClip);
-        }
-        else if (!clipStates[i].hasClip && hasClip) {
-            hasClip = false;
-            applyFullScreenScissor();
-        }
+        UINT offset = 0;
         
-        switch (cmd.type) {
-            case RenderCommandType::DrawLine:
-                renderLine(cmd.lineStart, cmd.lineEnd, cmd.color, cmd.lineWidth);
+        switch (batch.pipeline) {
+            case ActivePipeline::Rect: {
+                UINT stride = sizeof(RectVertex);
+                m_context->IASetVertexBuffers(0, 1, &m_rectVertexBuffer, &stride, &offset);
+                m_context->Draw(batch.vertexCount, batch.firstVertex);
                 break;
+            }
                 
-            case RenderCommandType::FillTriangle:
-                renderTriangle(cmd.triangleP1, cmd.triangleP2, cmd.triangleP3,
-                    cmd.color, 0.0f, true);
+            case ActivePipeline::Text: {
+                ID3D11ShaderResourceView* srv = static_cast<ID3D11ShaderResourceView*>(batch.texture);
+                m_context->PSSetShaderResources(0, 1, &srv);
+                m_context->PSSetSamplers(0, 1, &m_samplerState);
+                
+                UINT stride = sizeof(TextVertex);
+                m_context->IASetVertexBuffers(0, 1, &m_textVertexBuffer, &stride, &offset);
+                
+                // 6 indices per 4-vertex quad
+                UINT indexCount = (batch.vertexCount / 4) * 6;
+                UINT startIndexLocation = (batch.firstVertex / 4) * 6;
+                m_context->DrawIndexed(indexCount, startIndexLocation, 0);
                 break;
+            }
                 
-            case RenderCommandType::DrawTriangle:
-                renderTriangle(cmd.triangleP1, cmd.triangleP2, cmd.triangleP3,
-                    cmd.color, cmd.borderWidth, false);
+            case ActivePipeline::Image: {
+                ID3D11ShaderResourceView* srv = static_cast<ID3D11ShaderResourceView*>(batch.texture);
+                m_context->PSSetShaderResources(0, 1, &srv);
+                m_context->PSSetSamplers(0, 1, batch.repeatSampler ? &m_samplerStateRepeat : &m_samplerState);
+                
+                UINT stride = sizeof(ImageVertex);
+                m_context->IASetVertexBuffers(0, 1, &m_imageVertexBuffer, &stride, &offset);
+                m_context->Draw(batch.vertexCount, batch.firstVertex);
                 break;
+            }
                 
-            case RenderCommandType::FillCircle:
-                renderCircle(cmd.circleCenter, cmd.circleRadius, cmd.color, 0.0f, true);
+            case ActivePipeline::Shape: {
+                UINT stride = sizeof(ShapeVertex);
+                m_context->IASetVertexBuffers(0, 1, &m_shapeVertexBuffer, &stride, &offset);
+                m_context->Draw(batch.vertexCount, batch.firstVertex);
                 break;
+            }
                 
-            case RenderCommandType::DrawCircle:
-                renderCircle(cmd.circleCenter, cmd.circleRadius, cmd.color,
-                    cmd.borderWidth, false);
+            case ActivePipeline::Circle: {
+                UINT stride = sizeof(CircleVertex);
+                m_context->IASetVertexBuffers(0, 1, &m_circleVertexBuffer, &stride, &offset);
+                m_context->Draw(batch.vertexCount, batch.firstVertex);
                 break;
+            }
                 
             default:
                 break;
@@ -1061,472 +913,44 @@ void D3D11Renderer::executeRenderCommands(const RenderList& commandList)
 }
 
 //==========================================================================================
-// Rectangle Rendering
-
-void D3D11Renderer::renderRectangle(const Rect& rect, const Vec4& color,
-                                    const CornerRadius& cornerRadius, float borderWidth)
-{
-    YUCHEN_ASSERT_MSG(m_isInitialized, "Not initialized");
-    
-    float left, right, top, bottom;
-    convertToNDC(rect.x, rect.y, left, top);
-    convertToNDC(rect.x + rect.width, rect.y + rect.height, right, bottom);
-    
-    RectVertex vertices[6];
-    vertices[0] = RectVertex(Vec2(left, top), rect, cornerRadius, color, borderWidth);
-    vertices[1] = RectVertex(Vec2(left, bottom), rect, cornerRadius, color, borderWidth);
-    vertices[2] = RectVertex(Vec2(right, bottom), rect, cornerRadius, color, borderWidth);
-    vertices[3] = RectVertex(Vec2(left, top), rect, cornerRadius, color, borderWidth);
-    vertices[4] = RectVertex(Vec2(right, bottom), rect, cornerRadius, color, borderWidth);
-    vertices[5] = RectVertex(Vec2(right, top), rect, cornerRadius, color, borderWidth);
-    
-    D3D11_BUFFER_DESC vbDesc = {};
-    vbDesc.ByteWidth = sizeof(vertices);
-    vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    
-    D3D11_SUBRESOURCE_DATA vbData = {};
-    vbData.pSysMem = vertices;
-    
-    ID3D11Buffer* vertexBuffer = nullptr;
-    m_device->CreateBuffer(&vbDesc, &vbData, &vertexBuffer);
-    
-    UINT stride = sizeof(RectVertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    
-    m_context->Draw(6, 0);
-    
-    vertexBuffer->Release();
-}
-
-void D3D11Renderer::renderRectBatch(const std::vector<RenderCommand>& commands,
-                                   const Rect& clipRect, bool hasClip)
-{
-    if (commands.empty()) return;
-    
-    if (hasClip) {
-        applyScissorRect(clipRect);
-    } else {
-        applyFullScreenScissor();
-    }
-    
-    for (const auto& cmd : commands) {
-        renderRectangle(cmd.rect, cmd.color, cmd.cornerRadius, cmd.borderWidth);
-    }
-}
-
-//==========================================================================================
-// Image Rendering
-
-void D3D11Renderer::generateImageVertices(const Rect& destRect, const Rect& sourceRect,
-                                         uint32_t texWidth, uint32_t texHeight,
-                                         std::vector<float>& outVertices)
-{
-    float left, right, top, bottom;
-    convertToNDC(destRect.x, destRect.y, left, top);
-    convertToNDC(destRect.x + destRect.width, destRect.y + destRect.height, right, bottom);
-    
-    float u0 = sourceRect.x / texWidth;
-    float v0 = sourceRect.y / texHeight;
-    float u1 = (sourceRect.x + sourceRect.width) / texWidth;
-    float v1 = (sourceRect.y + sourceRect.height) / texHeight;
-    
-    float vertices[] = {
-        left,  top,    u0, v0,
-        left,  bottom, u0, v1,
-        right, bottom, u1, v1,
-        left,  top,    u0, v0,
-        right, bottom, u1, v1,
-        right, top,    u1, v0
-    };
-    
-    outVertices.insert(outVertices.end(), vertices, vertices + 24);
-}
-
-void D3D11Renderer::computeNineSliceRects(const Rect& destRect, const Rect& sourceRect,
-                                         const NineSliceMargins& margins, float designScale,
-                                         Rect outSlices[9])
-{
-    float srcLeft = margins.left;
-    float srcTop = margins.top;
-    float srcRight = margins.right;
-    float srcBottom = margins.bottom;
-    
-    float destLeft = srcLeft / designScale;
-    float destTop = srcTop / designScale;
-    float destRight = srcRight / designScale;
-    float destBottom = srcBottom / designScale;
-    
-    float destCenterWidth = destRect.width - destLeft - destRight;
-    float destCenterHeight = destRect.height - destTop - destBottom;
-    
-    if (destCenterWidth < 0.0f) destCenterWidth = 0.0f;
-    if (destCenterHeight < 0.0f) destCenterHeight = 0.0f;
-    
-    outSlices[0] = Rect(destRect.x, destRect.y, destLeft, destTop);
-    outSlices[1] = Rect(destRect.x + destLeft, destRect.y, destCenterWidth, destTop);
-    outSlices[2] = Rect(destRect.x + destLeft + destCenterWidth, destRect.y, destRight, destTop);
-    outSlices[3] = Rect(destRect.x, destRect.y + destTop, destLeft, destCenterHeight);
-    outSlices[4] = Rect(destRect.x + destLeft, destRect.y + destTop, destCenterWidth, destCenterHeight);
-    outSlices[5] = Rect(destRect.x + destLeft + destCenterWidth, destRect.y + destTop, destRight, destCenterHeight);
-    outSlices[6] = Rect(destRect.x, destRect.y + destTop + destCenterHeight, destLeft, destBottom);
-    outSlices[7] = Rect(destRect.x + destLeft, destRect.y + destTop + destCenterHeight, destCenterWidth, destBottom);
-    outSlices[8] = Rect(destRect.x + destLeft + destCenterWidth, destRect.y + destTop + destCenterHeight, destRight, destBottom);
-}
-
-void D3D11Renderer::generateNineSliceVertices(void* texture, const Rect& destRect,
-                                             const Rect& sourceRect, const NineSliceMargins& margins,
-                                             float designScale, uint32_t texWidth, uint32_t texHeight,
-                                             std::vector<float>& outVertices)
-{
-    Rect destSlices[9];
-    computeNineSliceRects(destRect, sourceRect, margins, designScale, destSlices);
-    
-    Rect srcSlices[9];
-    srcSlices[0] = Rect(sourceRect.x, sourceRect.y, margins.left, margins.top);
-    srcSlices[1] = Rect(sourceRect.x + margins.left, sourceRect.y,
-        sourceRect.width - margins.left - margins.right, margins.top);
-    srcSlices[2] = Rect(sourceRect.x + sourceRect.width - margins.right, sourceRect.y,
-        margins.right, margins.top);
-    srcSlices[3] = Rect(sourceRect.x, sourceRect.y + margins.top, margins.left,
-        sourceRect.height - margins.top - margins.bottom);
-    srcSlices[4] = Rect(sourceRect.x + margins.left, sourceRect.y + margins.top,
-        sourceRect.width - margins.left - margins.right,
-        sourceRect.height - margins.top - margins.bottom);
-    srcSlices[5] = Rect(sourceRect.x + sourceRect.width - margins.right, sourceRect.y + margins.top,
-        margins.right, sourceRect.height - margins.top - margins.bottom);
-    srcSlices[6] = Rect(sourceRect.x, sourceRect.y + sourceRect.height - margins.bottom,
-        margins.left, margins.bottom);
-    srcSlices[7] = Rect(sourceRect.x + margins.left, sourceRect.y + sourceRect.height - margins.bottom,
-        sourceRect.width - margins.left - margins.right, margins.bottom);
-    srcSlices[8] = Rect(sourceRect.x + sourceRect.width - margins.right,
-        sourceRect.y + sourceRect.height - margins.bottom, margins.right, margins.bottom);
-    
-    for (int i = 0; i < 9; ++i) {
-        if (destSlices[i].width > 0.0f && destSlices[i].height > 0.0f &&
-            srcSlices[i].width > 0.0f && srcSlices[i].height > 0.0f) {
-            generateImageVertices(destSlices[i], srcSlices[i], texWidth, texHeight, outVertices);
-        }
-    }
-}
-
-void D3D11Renderer::renderImageBatch(const std::vector<size_t>& commandIndices,
-                                    const std::vector<RenderCommand>& commands,
-                                    void* texture, const Rect& clipRect, bool hasClip)
-{
-    if (commandIndices.empty()) return;
-    
-    if (hasClip) {
-        applyScissorRect(clipRect);
-    } else {
-        applyFullScreenScissor();
-    }
-    
-    std::vector<float> vertexData;
-    vertexData.reserve(commandIndices.size() * 24);
-    
-    for (size_t idx : commandIndices) {
-        const auto& cmd = commands[idx];
-        
-        uint32_t texWidth = 0, texHeight = 0;
-        float designScale = 1.0f;
-        m_textureCache->getTexture(cmd.text.c_str(), texWidth, texHeight, &designScale);
-        
-        Rect sourceRect = cmd.sourceRect;
-        if (sourceRect.width == 0.0f || sourceRect.height == 0.0f) {
-            sourceRect = Rect(0, 0, texWidth, texHeight);
-        }
-        
-        Rect destRect = cmd.rect;
-        
-        if (cmd.scaleMode == ScaleMode::Original) {
-            float logicalWidth = sourceRect.width / designScale;
-            float logicalHeight = sourceRect.height / designScale;
-            float centerX = destRect.x + destRect.width * 0.5f;
-            float centerY = destRect.y + destRect.height * 0.5f;
-            destRect = Rect(centerX - logicalWidth * 0.5f, centerY - logicalHeight * 0.5f,
-                           logicalWidth, logicalHeight);
-        }
-        else if (cmd.scaleMode == ScaleMode::Fill) {
-            float destAspect = destRect.width / destRect.height;
-            float srcAspect = sourceRect.width / sourceRect.height;
-            if (srcAspect > destAspect) {
-                float newHeight = destRect.width / srcAspect;
-                destRect = Rect(destRect.x, destRect.y + (destRect.height - newHeight) * 0.5f,
-                               destRect.width, newHeight);
-            } else {
-                float newWidth = destRect.height * srcAspect;
-                destRect = Rect(destRect.x + (destRect.width - newWidth) * 0.5f, destRect.y,
-                               newWidth, destRect.height);
-            }
-        }
-        
-        if (cmd.scaleMode == ScaleMode::NineSlice) {
-            generateNineSliceVertices(texture, destRect, sourceRect, cmd.nineSliceMargins,
-                                     designScale, texWidth, texHeight, vertexData);
-        } else {
-            generateImageVertices(destRect, sourceRect, texWidth, texHeight, vertexData);
-        }
-    }
-    
-    if (vertexData.empty()) return;
-    
-    size_t vertexCount = vertexData.size() / 4;
-    
-    D3D11_BUFFER_DESC vbDesc = {};
-    vbDesc.ByteWidth = static_cast<UINT>(vertexData.size() * sizeof(float));
-    vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    
-    D3D11_SUBRESOURCE_DATA vbData = {};
-    vbData.pSysMem = vertexData.data();
-    
-    ID3D11Buffer* vertexBuffer = nullptr;
-    m_device->CreateBuffer(&vbDesc, &vbData, &vertexBuffer);
-    
-    ID3D11ShaderResourceView* srv = static_cast<ID3D11ShaderResourceView*>(texture);
-    m_context->PSSetShaderResources(0, 1, &srv);
-    m_context->PSSetSamplers(0, 1, &m_samplerState);
-    
-    UINT stride = 16;
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    
-    m_context->Draw(static_cast<UINT>(vertexCount), 0);
-    
-    vertexBuffer->Release();
-}
-
-//==========================================================================================
-// Text Rendering
+// Batch Submission
 
-void D3D11Renderer::renderTextBatches(const std::vector<TextVertex>& allVertices,
-                                     const std::vector<size_t>& batchStarts,
-                                     const std::vector<size_t>& batchCounts,
-                                     const std::vector<Rect>& batchClips,
-                                     const std::vector<bool>& batchHasClips)
+bool D3D11Renderer::uploadVertices(ID3D11Buffer*& buffer, size_t& capacityBytes,
+                                   const void* data, size_t bytes)
 {
-    if (allVertices.empty() || batchStarts.empty()) return;
-    
-    setPipeline(ActivePipeline::Text);
-    
-    void* atlasTexture = getCurrentAtlasTexture();
-    if (!atlasTexture) return;
-    
-    ID3D11ShaderResourceView* srv = static_cast<ID3D11ShaderResourceView*>(atlasTexture);
-    m_context->PSSetShaderResources(0, 1, &srv);
-    m_context->PSSetSamplers(0, 1, &m_samplerState);
+    if (bytes == 0) return true;
     
-    D3D11_MAPPED_SUBRESOURCE mapped;
-    m_context->Map(m_textVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
-    memcpy(mapped.pData, allVertices.data(), allVertices.size() * sizeof(TextVertex));
-    m_context->Unmap(m_textVertexBuffer, 0);
-    
-    UINT stride = sizeof(TextVertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, &m_textVertexBuffer, &stride, &offset);
-    m_context->IASetIndexBuffer(m_textIndexBuffer, DXGI_FORMAT_R16_UINT, 0);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    
-    for (size_t i = 0; i < batchStarts.size(); ++i) {
-        if (batchHasClips[i]) {
-            applyScissorRect(batchClips[i]);
-        } else {
-            applyFullScreenScissor();
+    if (!buffer || bytes > capacityBytes) {
+        if (buffer) {
+            buffer->Release();
+            buffer = nullptr;
         }
         
-        UINT indexCount = static_cast<UINT>((batchCounts[i] / 4) * 6);
-        UINT startIndexLocation = static_cast<UINT>((batchStarts[i] / 4) * 6);
-        
-        m_context->DrawIndexed(indexCount, startIndexLocation, 0);
-    }
-}
-
-//==========================================================================================
-// Shape Rendering
-
-void D3D11Renderer::renderLine(const Vec2& start, const Vec2& end,
-                               const Vec4& color, float width)
-{
-    setPipeline(ActivePipeline::Shape);
-    
-    Vec2 direction(end.x - start.x, end.y - start.y);
-    float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-    
-    if (length < 0.001f) return;
-    
-    direction.x /= length;
-    direction.y /= length;
-    
-    Vec2 perpendicular(-direction.y, direction.x);
-    float halfWidth = width * 0.5f;
-    
-    Vec2 p1(start.x + perpendicular.x * halfWidth, start.y + perpendicular.y * halfWidth);
-    Vec2 p2(start.x - perpendicular.x * halfWidth, start.y - perpendicular.y * halfWidth);
-    Vec2 p3(end.x - perpendicular.x * halfWidth, end.y - perpendicular.y * halfWidth);
-    Vec2 p4(end.x + perpendicular.x * halfWidth, end.y + perpendicular.y * halfWidth);
-    
-    ShapeVertex vertices[6];
-    vertices[0] = ShapeVertex(p1, color);
-    vertices[1] = ShapeVertex(p2, color);
-    vertices[2] = ShapeVertex(p3, color);
-    vertices[3] = ShapeVertex(p1, color);
-    vertices[4] = ShapeVertex(p3, color);
-    vertices[5] = ShapeVertex(p4, color);
-    
-    D3D11_BUFFER_DESC vbDesc = {};
-    vbDesc.ByteWidth = sizeof(vertices);
-    vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    
-    D3D11_SUBRESOURCE_DATA vbData = {};
-    vbData.pSysMem = vertices;
-    
-    ID3D11Buffer* vertexBuffer = nullptr;
-    m_device->CreateBuffer(&vbDesc, &vbData, &vertexBuffer);
-    
-    ViewportUniforms uniforms = getViewportUniforms();
-    ID3D11Buffer* uniformBuffer;
-    D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.ByteWidth = sizeof(ViewportUniforms);
-    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    
-    D3D11_SUBRESOURCE_DATA cbData = {};
-    cbData.pSysMem = &uniforms;
-    m_device->CreateBuffer(&cbDesc, &cbData, &uniformBuffer);
-    
-    UINT stride = sizeof(ShapeVertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_context->VSSetConstantBuffers(0, 1, &uniformBuffer);
-    
-    m_context->Draw(6, 0);
-    
-    uniformBuffer->Release();
-    vertexBuffer->Release();
-}
-
-void D3D11Renderer::renderTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3,
-                                   const Vec4& color, float borderWidth, bool filled)
-{
-    setPipeline(ActivePipeline::Shape);
-    
-    if (filled) {
-        ShapeVertex vertices[3];
-        vertices[0] = ShapeVertex(p1, color);
-        vertices[1] = ShapeVertex(p2, color);
-        vertices[2] = ShapeVertex(p3, color);
+        size_t newCapacity = std::max(bytes, capacityBytes * 2);
         
         D3D11_BUFFER_DESC vbDesc = {};
-        vbDesc.ByteWidth = sizeof(vertices);
-        vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
+        vbDesc.ByteWidth = static_cast<UINT>(newCapacity);
+        vbDesc.Usage = D3D11_USAGE_DYNAMIC;
         vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+        vbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
         
-        D3D11_SUBRESOURCE_DATA vbData = {};
-        vbData.pSysMem = vertices;
-        
-        ID3D11Buffer* vertexBuffer = nullptr;
-        m_device->CreateBuffer(&vbDesc, &vbData, &vertexBuffer);
-        
-        ViewportUniforms uniforms = getViewportUniforms();
-        ID3D11Buffer* uniformBuffer;
-        D3D11_BUFFER_DESC cbDesc = {};
-        cbDesc.ByteWidth = sizeof(ViewportUniforms);
-        cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-        cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-        cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-        
-        D3D11_SUBRESOURCE_DATA cbData = {};
-        cbData.pSysMem = &uniforms;
-        m_device->CreateBuffer(&cbDesc, &cbData, &uniformBuffer);
-        
-        UINT stride = sizeof(ShapeVertex);
-        UINT offset = 0;
-        m_context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-        m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        m_context->VSSetConstantBuffers(0, 1, &uniformBuffer);
-        
-        m_context->Draw(3, 0);
-        
-        uniformBuffer->Release();
-        vertexBuffer->Release();
-    } else {
-        renderLine(p1, p2, color, borderWidth);
-        renderLine(p2, p3, color, borderWidth);
-        renderLine(p3, p1, color, borderWidth);
+        if (FAILED(m_device->CreateBuffer(&vbDesc, nullptr, &buffer))) {
+            capacityBytes = 0;
+            return false;
+        }
+        capacityBytes = newCapacity;
     }
-}
-
-void D3D11Renderer::renderCircle(const Vec2& center, float radius,
-                                 const Vec4& color, float borderWidth, bool filled)
-{
-    setPipeline(ActivePipeline::Circle);
-    
-    float left = center.x - radius - 2.0f;
-    float right = center.x + radius + 2.0f;
-    float top = center.y - radius - 2.0f;
-    float bottom = center.y + radius + 2.0f;
-    
-    float bw = filled ? 0.0f : borderWidth;
-    
-    CircleVertex vertices[6];
-    vertices[0] = CircleVertex(Vec2(left, top), center, radius, bw, color);
-    vertices[1] = CircleVertex(Vec2(left, bottom), center, radius, bw, color);
-    vertices[2] = CircleVertex(Vec2(right, bottom), center, radius, bw, color);
-    vertices[3] = CircleVertex(Vec2(left, top), center, radius, bw, color);
-    vertices[4] = CircleVertex(Vec2(right, bottom), center, radius, bw, color);
-    vertices[5] = CircleVertex(Vec2(right, top), center, radius, bw, color);
-    
-    D3D11_BUFFER_DESC vbDesc = {};
-    vbDesc.ByteWidth = sizeof(vertices);
-    vbDesc.Usage = D3D11_USAGE_IMMUTABLE;
-    vbDesc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-    
-    D3D11_SUBRESOURCE_DATA vbData = {};
-    vbData.pSysMem = vertices;
-    
-    ID3D11Buffer* vertexBuffer = nullptr;
-    m_device->CreateBuffer(&vbDesc, &vbData, &vertexBuffer);
-    
-    ViewportUniforms uniforms = getViewportUniforms();
-    ID3D11Buffer* uniformBuffer;
-    D3D11_BUFFER_DESC cbDesc = {};
-    cbDesc.ByteWidth = sizeof(ViewportUniforms);
-    cbDesc.Usage = D3D11_USAGE_DYNAMIC;
-    cbDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
-    cbDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
-    
-    D3D11_SUBRESOURCE_DATA cbData = {};
-    cbData.pSysMem = &uniforms;
-    m_device->CreateBuffer(&cbDesc, &cbData, &uniformBuffer);
-    
-    UINT stride = sizeof(CircleVertex);
-    UINT offset = 0;
-    m_context->IASetVertexBuffers(0, 1, &vertexBuffer, &stride, &offset);
-    m_context->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    m_context->VSSetConstantBuffers(0, 1, &uniformBuffer);
     
-    m_context->Draw(6, 0);
-    
-    uniformBuffer->Release();
-    vertexBuffer->Release();
+    D3D11_MAPPED_SUBRESOURCE mapped;
+    if (FAILED(m_context->Map(buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped))) return false;
+    memcpy(mapped.pData, data, bytes);
+    m_context->Unmap(buffer, 0);
+    return true;
 }
 
 //==========================================================================================
 // Utility Functions
 
-void D3D11Renderer::convertToNDC(float x, float y, float& ndcX, float& ndcY) const
-{
-    ndcX = (x / static_cast<float>(m_width)) * 2.0f - 1.0f;
-    ndcY = 1.0f - (y / static_cast<float>(m_height)) * 2.0f;
-}
-
 ViewportUniforms D3D11Renderer::getViewportUniforms() const
 {
     ViewportUniforms uniforms;
@@ -17,6 +17,7 @@
 
 #include "YuchenUI/rendering/IGraphicsBackend.h"
 #include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/rendering/RenderBatchCompiler.h"
 #include "YuchenUI/core/Types.h"
 #include <d3d11.h>
 #include <dxgi1_2.h>
@@ -33,42 +34,13 @@ struct ViewportUniforms {
     Vec2 _padding;
 };
 
-struct ShapeVertex {
-    Vec2 position;
-    Vec4 color;
-    
-    ShapeVertex() : position(), color() {}
-    ShapeVertex(const Vec2& pos, const Vec4& col) : position(pos), color(col) {}
-};
-
-struct CircleVertex {
-    Vec2 position;
-    Vec2 center;
-    float radius;
-    float borderWidth;
-    Vec4 color;
-    
-    CircleVertex() : position(), center(), radius(0.0f), borderWidth(0.0f), color() {}
-    CircleVertex(const Vec2& pos, const Vec2& cen, float r, float bw, const Vec4& col)
-        : position(pos), center(cen), radius(r), borderWidth(bw), color(col) {}
-};
-
-enum class ActivePipeline {
-    None,
-    Rect,
-    Text,
-    Image,
-    Shape,
-    Circle
-};
-
 //==========================================================================================
 /**
     Direct3D 11 implementation of IGraphicsBackend for Windows platform.
     
     Provides hardware-accelerated 2D rendering using Direct3D 11 API with support for
-    rectangles, text, images, and primitive shapes. Implements efficient command batching
-    and state management for optimal GPU utilization.
+    rectangles, text, images, and primitive shapes. Command batching is done by
+    RenderBatchCompiler; this class uploads the vertex streams and issues the batches.
 */
 class D3D11Renderer : public IGraphicsBackend {
 public:
@@ -131,52 +103,14 @@ private:
     D3D11_RECT computeScissorRect(const Rect& clipRect) const;
     
     //======================================================================================
-    // Rectangle Rendering
-    
-    void renderRectangle(const Rect& rect, const Vec4& color,
-                        const CornerRadius& cornerRadius, float borderWidth);
-    void renderRectBatch(const std::vector<RenderCommand>& commands,
-                        const Rect& clipRect, bool hasClip);
-    
-    //======================================================================================
-    // Image Rendering
-    
-    void generateImageVertices(const Rect& destRect, const Rect& sourceRect,
-                              uint32_t texWidth, uint32_t texHeight,
-                              std::vector<float>& outVertices);
-    void generateNineSliceVertices(void* texture, const Rect& destRect,
-                                  const Rect& sourceRect, const NineSliceMargins& margins,
-                                  float designScale, uint32_t texWidth, uint32_t texHeight,
-                                  std::vector<float>& outVertices);
-    void computeNineSliceRects(const Rect& destRect, const Rect& sourceRect,
-                              const NineSliceMargins& margins, float designScale,
-                              Rect outSlices[9]);
-    void renderImageBatch(const std::vector<size_t>& commandIndices,
-                         const std::vector<RenderCommand>& commands,
-                         void* texture, const Rect& clipRect, bool hasClip);
-    
-    //======================================================================================
-    // Text Rendering
-    
-    void renderTextBatches(const std::vector<TextVertex>& allVertices,
-                          const std::vector<size_t>& batchStarts,
-                          const std::vector<size_t>& batchCounts,
-                          const std::vector<Rect>& batchClips,
-                          const std::vector<bool>& batchHasClips);
-    
-    //======================================================================================
-    // Shape Rendering
+    // Batch Submission
     
-    void renderLine(const Vec2& start, const Vec2& end, const Vec4& color, float width);
-    void renderTriangle(const Vec2& p1, const Vec2& p2, const Vec2& p3,
-                       const Vec4& color, float borderWidth, bool filled);
-    void renderCircle(const Vec2& center, float radius, const Vec4& color,
-                     float borderWidth, bool filled);
+    bool uploadVertices(ID3D11Buffer*& buffer, size_t& capacityBytes,
+                       const void* data, size_t bytes);
     
     //======================================================================================
     // Utility Functions
     
-    void convertToNDC(float x, float y, float& ndcX, float& ndcY) const;
     ViewportUniforms getViewportUniforms() const;
     void updateConstantBuffer(const ViewportUniforms& uniforms);
     
@@ -212,16 +146,26 @@ private:
     
     ID3D11BlendState* m_blendState;
     ID3D11SamplerState* m_samplerState;
+    ID3D11SamplerState* m_samplerStateRepeat;
     ID3D11RasterizerState* m_rasterizerState;
     ID3D11Buffer* m_constantBuffer;
     
     ID3D11Buffer* m_textVertexBuffer;
     ID3D11Buffer* m_textIndexBuffer;
+    ID3D11Buffer* m_rectVertexBuffer;
+    ID3D11Buffer* m_imageVertexBuffer;
+    ID3D11Buffer* m_shapeVertexBuffer;
+    ID3D11Buffer* m_circleVertexBuffer;
+    size_t m_rectBufferBytes;
+    size_t m_imageBufferBytes;
+    size_t m_shapeBufferBytes;
+    size_t m_circleBufferBytes;
     
     ActivePipeline m_currentPipeline;
     
     std::unique_ptr<TextRenderer> m_textRenderer;
     std::unique_ptr<TextureCache> m_textureCache;
+    std::unique_ptr<RenderBatchCompiler> m_batchCompiler;
     
     bool m_isInitialized;
     int m_width;
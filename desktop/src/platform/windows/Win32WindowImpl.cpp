@@ -289,7 +289,8 @@ void Win32WindowImpl::onRender()
 {
     if (m_baseWindow)
     {
-        m_baseWindow->renderContent();
+        // WM_PAINT means the system needs the surface repainted, invalidated or not
+        m_baseWindow->repaint();
     }
 }
 
@@ -85,6 +85,9 @@ void runEventLoop(bool& isRunning, WindowManager* manager)
         }
         else
         {
+            // Render windows with pending work and find the earliest scheduled frame
+            float nextFrame = -1.0f;
+            
             const std::vector<Window*>& allWindows = manager->getAllWindows();
             for (Window* window : allWindows)
             {
@@ -94,9 +97,20 @@ void runEventLoop(bool& isRunning, WindowManager* manager)
                     if (baseWindow->isVisible())
                     {
                         baseWindow->renderContent();
+                        
+                        float wait = baseWindow->getUIContext().getTimeUntilNextFrame();
+                        if (wait >= 0.0f && (nextFrame < 0.0f || wait < nextFrame))
+                            nextFrame = wait;
                     }
                 }
             }
+            
+            // Idle: block until input arrives or the next animation frame is due
+            if (nextFrame != 0.0f)
+            {
+                DWORD timeout = nextFrame < 0.0f ? INFINITE : static_cast<DWORD>(nextFrame * 1000.0f);
+                MsgWaitForMultipleObjectsEx(0, NULL, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+            }
         }
         
         manager->processScheduledDestructions();
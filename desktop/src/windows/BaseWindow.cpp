@@ -34,6 +34,7 @@ namespace YuchenUI
 BaseWindow::BaseWindow(WindowType type)
     : m_impl(nullptr)
     , m_backend(nullptr)
+    , m_renderList()
     , m_uiContext()
     , m_parentWindow(nullptr)
     , m_windowType(type)
@@ -49,6 +50,10 @@ BaseWindow::BaseWindow(WindowType type)
     , m_capturedComponent(nullptr)
     , m_targetFPS(Config::Rendering::DEFAULT_FPS)
     , m_resourceResolver(nullptr)
+    , m_lastFrameFingerprint(0)
+    , m_hasLastFrame(false)
+    , m_skippedFrameCount(0)
+    , m_coalesceFills(false)
 {
     m_impl.reset(WindowImplFactory::create());
     YUCHEN_ASSERT(m_impl);
@@ -263,6 +268,7 @@ void BaseWindow::onResize(int width, int height)
     {
         m_width = width;
         m_height = height;
+        m_hasLastFrame = false;
         
         if (m_backend) {
             m_backend->resize(width, height);
@@ -304,19 +310,54 @@ void BaseWindow::renderContent()
     if (!m_backend || !hasReachedState(WindowState::Created))
         return;
     
-    m_backend->beginFrame();
-    
-    RenderList commandList;
-    commandList.clear(getBackgroundColor());
+    // Nothing invalidated and no animation due: keep the last presented frame
+    if (!m_uiContext.needsRedraw())
+        return;
     
+    // Updates run first; they may add damage for this frame
     m_uiContext.beginFrame();
-    m_uiContext.render(commandList);
+    
+    const bool partial = m_uiContext.isPartialRedrawEnabled() && !m_uiContext.isFullRedraw();
+    const Rect damage = m_uiContext.getDamageBounds();
+    
+    if (partial && damage.isEmpty())
+    {
+        // Updates ran but nothing visible changed
+        m_uiContext.endFrame();
+        return;
+    }
+    
+    m_renderList.reset();
+    m_renderList.clear(getBackgroundColor());
+    
+    m_uiContext.render(m_renderList);
     m_uiContext.endFrame();
+    if (m_coalesceFills) m_renderList.coalesceFillRects(m_dpiScale);
+    
+    // Same commands as the frame on screen: nothing to execute or present
+    const uint64_t fingerprint = m_renderList.getFingerprint();
+    if (m_hasLastFrame && fingerprint == m_lastFrameFingerprint)
+    {
+        ++m_skippedFrameCount;
+        return;
+    }
+    
+    m_lastFrameFingerprint = fingerprint;
+    m_hasLastFrame = true;
     
-    m_backend->executeRenderCommands(commandList);
+    m_backend->setDamageRect(partial ? damage : Rect());
+    m_backend->beginFrame();
+    m_backend->executeRenderCommands(m_renderList);
     m_backend->endFrame();
 }
 
+void BaseWindow::repaint()
+{
+    m_hasLastFrame = false;
+    m_uiContext.requestRedraw();
+    renderContent();
+}
+
 //==========================================================================================
 // Renderer Initialization
 
@@ -337,6 +378,7 @@ bool BaseWindow::initializeRenderer(IFontProvider* fontProvider)
     
     m_uiContext.setViewportSize(Vec2(m_width, m_height));
     m_uiContext.setDPIScale(m_dpiScale);
+    m_uiContext.setPartialRedrawEnabled(m_backend->supportsPartialRedraw());
     m_uiContext.setTextInputHandler(this);
     m_uiContext.setCoordinateMapper(this);
 
@@ -399,7 +441,11 @@ void BaseWindow::handleEvent(const Event& event)
         }
         
         if (handled)
+        {
+            // The captured widget invalidates what it changed; just make sure a frame runs
+            m_uiContext.requestAnimationFrame();
             return;
+        }
     }
     
     bool handled = false;
@@ -595,6 +641,11 @@ void BaseWindow::setTargetFPS(int fps)
     m_targetFPS = fps;
 }
 
+void BaseWindow::setFillCoalescingEnabled(bool enabled)
+{
+    m_coalesceFills = enabled;
+}
+
 //==========================================================================================
 // State Management
 
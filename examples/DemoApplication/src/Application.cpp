@@ -610,37 +610,37 @@ void MainWindowContent::createKnobTestArea() {
 void MainWindowContent::render(YuchenUI::RenderList& commandList)
 {
     if (m_titleLabel) {
-        m_titleLabel->addDrawCommands(commandList);
+        m_titleLabel->render(commandList);
     }
     if (m_levelMeterButton) {
-        m_levelMeterButton->addDrawCommands(commandList);
+        m_levelMeterButton->render(commandList);
     }
     if (m_dialogButton) {
-        m_dialogButton->addDrawCommands(commandList);
+        m_dialogButton->render(commandList);
     }
     if (m_themeButton) {
-        m_themeButton->addDrawCommands(commandList);
+        m_themeButton->render(commandList);
     }
     if (m_comboBoxGroupBox) {
-        m_comboBoxGroupBox->addDrawCommands(commandList);
+        m_comboBoxGroupBox->render(commandList);
     }
     if (m_spinBoxGroupBox) {
-        m_spinBoxGroupBox->addDrawCommands(commandList);
+        m_spinBoxGroupBox->render(commandList);
     }
     if (m_textInputGroupBox) {
-        m_textInputGroupBox->addDrawCommands(commandList);
+        m_textInputGroupBox->render(commandList);
     }
     if (m_checkBoxGroupBox) {
-        m_checkBoxGroupBox->addDrawCommands(commandList);
+        m_checkBoxGroupBox->render(commandList);
     }
     if (m_radioButtonGroupBox) {
-        m_radioButtonGroupBox->addDrawCommands(commandList);
+        m_radioButtonGroupBox->render(commandList);
     }
     if (m_scrollGroupBox) {
-        m_scrollGroupBox->addDrawCommands(commandList);
+        m_scrollGroupBox->render(commandList);
     }
     if (m_knobGroupBox) {
-        m_knobGroupBox->addDrawCommands(commandList);
+        m_knobGroupBox->render(commandList);
     }
 }
 
@@ -763,10 +763,10 @@ void ConfirmationDialogContent::onDestroy() {
 void ConfirmationDialogContent::render(YuchenUI::RenderList& commandList)
 {
     if (m_messageFrame) {
-        m_messageFrame->addDrawCommands(commandList);
+        m_messageFrame->render(commandList);
     }
     if (m_buttonFrame) {
-        m_buttonFrame->addDrawCommands(commandList);
+        m_buttonFrame->render(commandList);
     }
 }
 
@@ -1079,6 +1079,7 @@ void LevelMeterWindowContent::onUpdate(float deltaTime) {
         m_time += deltaTime;
         updateLevelMeter();
         updateStatusLabel();
+        if (m_context) m_context->requestAnimationFrame();
     }
 }
 
@@ -1089,18 +1090,18 @@ void LevelMeterWindowContent::onDestroy() {
 void LevelMeterWindowContent::render(YuchenUI::RenderList& commandList)
 {
     if (m_titleLabel) {
-        m_titleLabel->addDrawCommands(commandList);
+        m_titleLabel->render(commandList);
     }
     if (m_levelMeter) {
-        m_levelMeter->addDrawCommands(commandList);
+        m_levelMeter->render(commandList);
     }
     if (m_testFader) {
-        m_testFader->addDrawCommands(commandList);
+        m_testFader->render(commandList);
     }
     if (m_faderValueLabel) {
-        m_faderValueLabel->addDrawCommands(commandList);
+        m_faderValueLabel->render(commandList);
     }
     if (m_controlGroupBox) {
-        m_controlGroupBox->addDrawCommands(commandList);
+        m_controlGroupBox->render(commandList);
     }
 }
@@ -193,6 +193,9 @@ void MixerWindowContent::onUpdate(float deltaTime)
     }
     
     updateTestSignals();
+    
+    // Test signals move every frame, so keep frames coming
+    if (m_context) m_context->requestAnimationFrame();
 }
 
 void MixerWindowContent::updateTestSignals()
@@ -211,6 +214,6 @@ void MixerWindowContent::render(YuchenUI::RenderList& commandList)
 {
     if (m_scrollArea)
     {
-        m_scrollArea->addDrawCommands(commandList);
+        m_scrollArea->render(commandList);
     }
 }
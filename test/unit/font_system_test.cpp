@@ -17,19 +17,33 @@
 #include "YuchenUI/text/TextRenderer.h"
 #include "YuchenUI/text/TextUtils.h"
 #include "YuchenUI/text/GlyphCache.h"
+#include "YuchenUI/text/ShelfPacker.h"
+#include "YuchenUI/text/GlyphRasterizer.h"
 #include "YuchenUI/text/IFontProvider.h"
+#include "YuchenUI/text/LineBreaker.h"
 #include "YuchenUI/rendering/IGraphicsBackend.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/rendering/RenderBatchCompiler.h"
 #include "YuchenUI/core/Config.h"
 #include "embedded_resources.h"
+#include "test_resources.h"
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <hb.h>
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <unordered_set>
 #include <memory>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
 
 using namespace YuchenUI;
 using ::testing::_;
@@ -46,13 +60,15 @@ public:
     MockGraphicsBackend() : m_nextTextureId(1) {}
     
     MOCK_METHOD(bool, initialize, (void* platformSurface, int width, int height,
-                                   float dpiScale, IFontProvider* fontProvider), (override));
+                                   float dpiScale, IFontProvider* fontProvider,
+                                   IResourceResolver* resourceResolver), (override));
     MOCK_METHOD(void, resize, (int width, int height), (override));
     MOCK_METHOD(void, beginFrame, (), (override));
     MOCK_METHOD(void, endFrame, (), (override));
     MOCK_METHOD(void, executeRenderCommands, (const RenderList& commands), (override));
     MOCK_METHOD(Vec2, getRenderSize, (), (const, override));
     MOCK_METHOD(float, getDPIScale, (), (const, override));
+    MOCK_METHOD(bool, supportsDistanceFieldText, (), (const, override));
     
     // Texture management with tracking
     void* createTexture2D(uint32_t width, uint32_t height, TextureFormat format) override {
@@ -62,7 +78,7 @@ public:
         info.width = width;
         info.height = height;
         info.format = format;
-        info.data.resize(width * height * (format == TextureFormat::R8_Unorm ? 1 : 4));
+        info.data.resize(width * height * (format == TextureFormat::RGBA8_Unorm ? 4 : 1));
         
         m_textures[handle] = info;
         return handle;
@@ -75,7 +91,7 @@ public:
         if (it == m_textures.end()) return;
         
         TextureInfo& info = it->second;
-        size_t bytesPerPixel = (info.format == TextureFormat::R8_Unorm) ? 1 : 4;
+        size_t bytesPerPixel = (info.format == TextureFormat::RGBA8_Unorm) ? 4 : 1;
         
         for (uint32_t row = 0; row < height; ++row) {
             size_t srcOffset = row * bytesPerRow;
@@ -99,6 +115,16 @@ public:
     size_t getDestroyCount() const { return m_destroyCount; }
     void resetCounters() { m_updateCount = 0; m_destroyCount = 0; }
     
+    const std::vector<uint8_t>* getTextureData(void* texture) const {
+        auto it = m_textures.find(texture);
+        return it != m_textures.end() ? &it->second.data : nullptr;
+    }
+    
+    TextureFormat getTextureFormat(void* texture) const {
+        auto it = m_textures.find(texture);
+        return it != m_textures.end() ? it->second.format : TextureFormat::RGBA8_Unorm;
+    }
+    
 private:
     struct TextureInfo {
         uint32_t width;
@@ -170,7 +196,7 @@ class FontManagerTest : public ::testing::Test {
 protected:
     void SetUp() override {
         m_fontManager = std::make_unique<FontManager>();
-        bool initialized = m_fontManager->initialize();
+        bool initialized = m_fontManager->initialize(Testing::getEmbeddedResourceResolver());
         ASSERT_TRUE(initialized);
     }
     
@@ -193,7 +219,7 @@ protected:
             .WillByDefault(Return(1.0f));
         
         m_fontManager = std::make_unique<FontManager>();
-        ASSERT_TRUE(m_fontManager->initialize());
+        ASSERT_TRUE(m_fontManager->initialize(Testing::getEmbeddedResourceResolver()));
         
         m_textRenderer = std::make_unique<TextRenderer>(m_backend.get(),
                                                          m_fontManager.get());
@@ -552,6 +578,254 @@ TEST_F(FontManagerTest, MeasureText_Caching) {
     EXPECT_FLOAT_EQ(size1.y, size2.y);
 }
 
+TEST_F(FontManagerTest, MeasureCaretStops_MatchPrefixWidths) {
+    const std::string text = "Gain -3.5 dB, 主唱 ✓ Ж";
+    std::vector<float> stops;
+    m_fontManager->measureCaretStops(text.c_str(), 13.0f, stops);
+    
+    std::u32string codepoints;
+    TextUtils::decodeUTF8ToUTF32(text.data(), text.size(), codepoints);
+    ASSERT_EQ(stops.size(), codepoints.size() + 1);
+    EXPECT_FLOAT_EQ(stops.front(), 0.0f);
+    EXPECT_NEAR(stops.back(), m_fontManager->measureText(text.c_str(), 13.0f).x, 0.01f);
+    
+    // Same widths measureText() gives every prefix, which is what TextInput used to ask for
+    for (size_t i = 1; i < codepoints.size(); ++i) {
+        std::string prefix;
+        for (size_t k = 0; k < i; ++k) prefix += TextUtils::encodeUTF8(codepoints[k]);
+        EXPECT_NEAR(stops[i], m_fontManager->measureText(prefix.c_str(), 13.0f).x, 0.01f) << i;
+        EXPECT_GE(stops[i], stops[i - 1]);
+    }
+}
+
+TEST_F(FontManagerTest, MeasureCaretStops_OneStopPerCodepoint) {
+    std::vector<float> stops(5, 1.0f);
+    m_fontManager->measureCaretStops("", 12.0f, stops);
+    EXPECT_EQ(stops, std::vector<float>({ 0.0f }));
+    
+    // A combining mark shares its base's cluster but still gets a stop
+    m_fontManager->measureCaretStops("ae\xCC\x81z", 12.0f, stops);
+    ASSERT_EQ(stops.size(), 5u);
+    EXPECT_TRUE(std::is_sorted(stops.begin(), stops.end()));
+    EXPECT_GT(stops[4], stops[3]);
+}
+
+TEST_F(FontManagerTest, PerformanceTest_CaretStopsHitTest) {
+    // A 2,000 character field, dragged across: one hit test per mouse move
+    std::string text;
+    while (text.size() < 2000) text += "Bus 7 send level ";
+    text.resize(2000);
+    
+    const int hitTests = 400;
+    
+    // Previous approach: measure prefixes until the midpoint passes x (here, prefixes of a short
+    // 200 character field only, once each, which already costs more than the new full path)
+    auto prefixStart = std::chrono::high_resolution_clock::now();
+    float prefixSink = 0.0f;
+    for (size_t i = 1; i <= 200; ++i) prefixSink += m_fontManager->measureText(text.substr(0, i).c_str(), 12.0f).x;
+    auto prefixEnd = std::chrono::high_resolution_clock::now();
+    
+    std::vector<float> stops;
+    m_fontManager->measureCaretStops(text.c_str(), 12.0f, stops);
+    size_t indexSink = 0;
+    for (int h = 0; h < hitTests; ++h) {
+        const float x = stops.back() * h / hitTests;
+        indexSink += std::upper_bound(stops.begin(), stops.end(), x) - stops.begin();
+    }
+    auto stopsEnd = std::chrono::high_resolution_clock::now();
+    
+    const double prefixMs = std::chrono::duration<double, std::milli>(prefixEnd - prefixStart).count();
+    const double stopsMs = std::chrono::duration<double, std::milli>(stopsEnd - prefixEnd).count();
+    
+    std::cout << "[Caret stops] 2000 characters: shaped once + " << hitTests << " hit tests "
+              << stopsMs << " ms; 200 prefix measurements " << prefixMs << " ms" << std::endl;
+    
+    ASSERT_EQ(stops.size(), 2001u);
+    EXPECT_GT(prefixSink, 0.0f);
+    EXPECT_GT(indexSink, 0u);
+    EXPECT_LT(stopsMs, prefixMs);
+}
+
+TEST(LineBreakerTest, BreakOpportunities_Western) {
+    auto breaksOf = [](const char* text) {
+        std::u32string codepoints;
+        TextUtils::decodeUTF8ToUTF32(text, std::strlen(text), codepoints);
+        std::vector<uint32_t> values(codepoints.begin(), codepoints.end());
+        std::vector<uint8_t> breaks;
+        LineBreaker::findBreakOpportunities(values.data(), values.size(), breaks);
+        EXPECT_EQ(breaks.size(), values.size() + 1);
+        return breaks;
+    };
+    
+    // After the space run, never inside it
+    std::vector<uint8_t> breaks = breaksOf("Gain  trim");
+    EXPECT_EQ(std::count(breaks.begin(), breaks.end(), 1), 1);
+    EXPECT_TRUE(breaks[6]);
+    
+    // After a hyphen inside a word, not before a digit or after a leading hyphen
+    EXPECT_TRUE(breaksOf("pre-fader")[4]);
+    EXPECT_FALSE(breaksOf("-6 dB")[1]);
+    EXPECT_FALSE(breaksOf("--mono")[2]);
+    
+    // Not before closing punctuation or after opening punctuation
+    breaks = breaksOf("(a) b.");
+    EXPECT_FALSE(breaks[1]);
+    EXPECT_FALSE(breaks[2]);
+    EXPECT_TRUE(breaks[4]);
+    EXPECT_FALSE(breaks[5]);
+    
+    // Not before a combining mark
+    breaks = breaksOf("e\xCC\x81");
+    EXPECT_FALSE(breaks[1]);
+}
+
+TEST(LineBreakerTest, BreakOpportunities_CJK) {
+    // 混音台，(推子) 音量: every ideograph boundary except before the fullwidth comma,
+    // after the opening parenthesis and before the closing one
+    const uint32_t text[] = { 0x6DF7, 0x97F3, 0x53F0, 0xFF0C, 0xFF08, 0x63A8, 0x5B50, 0xFF09, 0x97F3, 0x91CF };
+    std::vector<uint8_t> breaks;
+    LineBreaker::findBreakOpportunities(text, 10, breaks);
+    
+    const uint8_t expected[] = { 0, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0 };
+    ASSERT_EQ(breaks.size(), 11u);
+    for (size_t i = 0; i < breaks.size(); ++i) {
+        EXPECT_EQ(breaks[i], expected[i]) << "boundary " << i;
+    }
+    
+    // Between a Latin word and an ideograph, and between kana
+    const uint32_t mixed[] = { 'M', 'I', 'X', 0x6DF7, 0x307F, 0x3063, 0x304F, 0x30B9 };
+    LineBreaker::findBreakOpportunities(mixed, 8, breaks);
+    EXPECT_TRUE(breaks[3]);
+    EXPECT_TRUE(breaks[4]);
+    EXPECT_FALSE(breaks[5]);    // small kana
+    EXPECT_TRUE(breaks[7]);
+}
+
+TEST_F(FontManagerTest, LineBreaker_LinesFitAndCoverParagraph) {
+    const std::string text = "Bus 7 send level follows the pre-fader tap when the mixer is in solo safe mode.";
+    const float fontSize = 12.0f;
+    
+    LineBreaker breaker;
+    breaker.setParagraph(text, m_fontManager.get(), fontSize);
+    EXPECT_NEAR(breaker.getNaturalWidth(), m_fontManager->measureText(text.c_str(), fontSize).x, 0.01f);
+    
+    for (float maxWidth : { 60.0f, 120.0f, 250.0f, 10000.0f }) {
+        const std::vector<LineBreakSpan>& lines = breaker.breakLines(maxWidth);
+        ASSERT_FALSE(lines.empty());
+        
+        size_t expectedStart = 0;
+        for (const LineBreakSpan& line : lines) {
+            // Lines follow each other, separated only by the spaces hanging at their ends
+            while (expectedStart < line.byteStart && text[expectedStart] == ' ') ++expectedStart;
+            EXPECT_EQ(line.byteStart, expectedStart);
+            expectedStart = line.byteStart + line.byteLength;
+            
+            const std::string lineText = text.substr(line.byteStart, line.byteLength);
+            EXPECT_LE(line.width, maxWidth);
+            EXPECT_NEAR(line.width, m_fontManager->measureText(lineText.c_str(), fontSize).x, 0.01f) << lineText;
+            EXPECT_NE(lineText.back(), ' ');
+        }
+        EXPECT_EQ(expectedStart, text.size());
+        
+        if (maxWidth == 10000.0f) {
+            EXPECT_EQ(lines.size(), 1u);
+        }
+        if (maxWidth == 60.0f) {
+            EXPECT_GT(lines.size(), 4u);
+        }
+    }
+    
+    // A word wider than the line is broken between characters
+    breaker.setParagraph("Oversampling", m_fontManager.get(), fontSize);
+    const std::vector<LineBreakSpan>& lines = breaker.breakLines(20.0f);
+    EXPECT_GT(lines.size(), 1u);
+    for (const LineBreakSpan& line : lines) EXPECT_GT(line.byteLength, 0u);
+}
+
+// Counts the provider calls that shape text
+class ShapingCountingFontManager : public FontManager {
+public:
+    Vec2 measureText(const char* text, float fontSize) const override {
+        ++m_shapeCalls;
+        return FontManager::measureText(text, fontSize);
+    }
+    
+    void measureCaretStops(const char* text, float fontSize, std::vector<float>& outStops) const override {
+        ++m_shapeCalls;
+        FontManager::measureCaretStops(text, fontSize, outStops);
+    }
+    
+    size_t getShapeCalls() const { return m_shapeCalls; }
+    
+private:
+    mutable size_t m_shapeCalls = 0;
+};
+
+TEST(LineBreakerTest, PerformanceTest_RewrapDoesNotReshape) {
+    ShapingCountingFontManager fontManager;
+    ASSERT_TRUE(fontManager.initialize(Testing::getEmbeddedResourceResolver()));
+    
+    // A log view of 500 lines, resized through 20 widths
+    std::vector<std::string> paragraphs;
+    for (int i = 0; i < 500; ++i) {
+        paragraphs.push_back("[" + std::to_string(i) + "] Plugin scan: loaded Compressor " + std::to_string(i * 7) +
+                             " with 2 inputs, 2 outputs and a sidechain bus in 3 ms");
+    }
+    const float fontSize = 12.0f;
+    const int widths = 20;
+    
+    std::vector<LineBreaker> breakers(paragraphs.size());
+    for (size_t i = 0; i < paragraphs.size(); ++i) breakers[i].setParagraph(paragraphs[i], &fontManager, fontSize);
+    
+    // Each paragraph is shaped exactly once; no width costs another shaping call
+    EXPECT_EQ(fontManager.getShapeCalls(), paragraphs.size());
+    
+    auto rewrapStart = std::chrono::high_resolution_clock::now();
+    size_t lineCount = 0;
+    for (int w = 0; w < widths; ++w) {
+        for (LineBreaker& breaker : breakers) lineCount += breaker.breakLines(150.0f + 20.0f * w).size();
+    }
+    auto rewrapEnd = std::chrono::high_resolution_clock::now();
+    
+    EXPECT_EQ(fontManager.getShapeCalls(), paragraphs.size());
+    EXPECT_GT(lineCount, paragraphs.size() * widths);
+    
+    // Same width again: the lines are returned as they are
+    const LineBreakSpan* previousLines = breakers[0].breakLines(530.0f).data();
+    EXPECT_EQ(breakers[0].breakLines(530.0f).data(), previousLines);
+    
+    // Previous approach for the same work: every character measured on its own, at every width
+    const size_t callsBefore = fontManager.getShapeCalls();
+    size_t characterLines = 0;
+    for (int w = 0; w < widths; ++w) {
+        const float maxWidth = 150.0f + 20.0f * w;
+        for (const std::string& paragraph : paragraphs) {
+            float x = 0.0f;
+            const char* cursor = paragraph.c_str();
+            while (*cursor) {
+                const char* begin = cursor;
+                TextUtils::decodeUTF8(cursor);
+                const float advance = fontManager.measureText(std::string(begin, cursor).c_str(), fontSize).x;
+                if (x + advance > maxWidth) { ++characterLines; x = 0.0f; }
+                x += advance;
+            }
+            ++characterLines;
+        }
+    }
+    auto characterEnd = std::chrono::high_resolution_clock::now();
+    
+    const double rewrapMs = std::chrono::duration<double, std::milli>(rewrapEnd - rewrapStart).count();
+    const double characterMs = std::chrono::duration<double, std::milli>(characterEnd - rewrapEnd).count();
+    
+    std::cout << "[Line breaker] 500 paragraphs, " << widths << " widths: rewrap " << rewrapMs << " ms, "
+              << fontManager.getShapeCalls() - callsBefore << " per-character measurements " << characterMs
+              << " ms" << std::endl;
+    
+    EXPECT_GT(characterLines, paragraphs.size() * widths);
+    
+    fontManager.destroy();
+}
+
 TEST_F(FontManagerTest, HasGlyph_BasicLatin) {
     FontHandle arial = m_fontManager->getDefaultFont();
     
@@ -562,12 +836,77 @@ TEST_F(FontManagerTest, HasGlyph_BasicLatin) {
 
 TEST_F(FontManagerTest, HasGlyph_CJK) {
     FontHandle cjkFont = m_fontManager->getDefaultCJKFont();
+    if (!m_fontManager->isValidFont(cjkFont) || cjkFont == m_fontManager->getDefaultFont()) {
+        GTEST_SKIP() << "No CJK font available on this platform";
+    }
     
     // Test common CJK characters
     EXPECT_TRUE(m_fontManager->hasGlyph(cjkFont, 0x4E2D));
     EXPECT_TRUE(m_fontManager->hasGlyph(cjkFont, 0x6587));
 }
 
+TEST_F(FontManagerTest, HasGlyph_MatchesCharacterMap) {
+    // Every codepoint of the blocks ordinary text uses, against FreeType directly
+    for (FontHandle font : { m_fontManager->getDefaultFont(), m_fontManager->getDefaultCJKFont() }) {
+        if (!m_fontManager->isValidFont(font)) continue;
+        FT_Face face = static_cast<FT_Face>(m_fontManager->getFontFace(font));
+        
+        for (uint32_t codepoint = 0; codepoint < 0x10000; ++codepoint) {
+            ASSERT_EQ(m_fontManager->hasGlyph(font, codepoint), FT_Get_Char_Index(face, codepoint) != 0)
+                << "font " << font << " U+" << std::hex << codepoint;
+        }
+        EXPECT_FALSE(m_fontManager->hasGlyph(font, 0x110000));
+    }
+}
+
+TEST_F(FontManagerTest, PerformanceTest_CoverageOverPastedCJK) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    
+    // A pasted page of CJK text: thousands of distinct ideographs with Latin mixed in
+    std::vector<uint32_t> codepoints;
+    for (uint32_t i = 0; i < 50000; ++i) codepoints.push_back(i % 7 == 0 ? 'a' + i % 26 : 0x4E00 + (i * 2654435761u) % 0x5000);
+    
+    // Reference: the per-codepoint hash map hasGlyph() used to keep, warmed up
+    std::unordered_map<uint64_t, bool> availability;
+    auto mapLookup = [&](FontHandle font, uint32_t codepoint) {
+        const uint64_t key = (static_cast<uint64_t>(font) << 32) | codepoint;
+        auto it = availability.find(key);
+        if (it != availability.end()) return it->second;
+        const bool has = FT_Get_Char_Index(static_cast<FT_Face>(m_fontManager->getFontFace(font)), codepoint) != 0;
+        availability[key] = has;
+        return has;
+    };
+    for (uint32_t codepoint : codepoints)
+        for (FontHandle font : chain.fonts) mapLookup(font, codepoint);
+    
+    size_t sink = 0;
+    auto coldStart = std::chrono::high_resolution_clock::now();
+    for (uint32_t codepoint : codepoints)
+        for (FontHandle font : chain.fonts) sink += m_fontManager->hasGlyph(font, codepoint);
+    auto coldEnd = std::chrono::high_resolution_clock::now();
+    for (uint32_t codepoint : codepoints)
+        for (FontHandle font : chain.fonts) sink += m_fontManager->hasGlyph(font, codepoint);
+    auto warmEnd = std::chrono::high_resolution_clock::now();
+    for (uint32_t codepoint : codepoints)
+        for (FontHandle font : chain.fonts) sink += mapLookup(font, codepoint);
+    auto mapEnd = std::chrono::high_resolution_clock::now();
+    
+    const double coldMs = std::chrono::duration<double, std::milli>(coldEnd - coldStart).count();
+    const double warmMs = std::chrono::duration<double, std::milli>(warmEnd - coldEnd).count();
+    const double mapMs = std::chrono::duration<double, std::milli>(mapEnd - warmEnd).count();
+    
+    size_t coverageBytes = 0;
+    for (FontHandle font : chain.fonts) coverageBytes += m_fontManager->getFontEntry(font)->coverage->getMemoryUsage();
+    
+    std::cout << "[Coverage] " << codepoints.size() << " codepoints x " << chain.fonts.size() << " fonts: first pass "
+              << coldMs << " ms, then " << warmMs << " ms; hash map " << mapMs << " ms holding "
+              << availability.size() << " entries, coverage " << coverageBytes << " bytes" << std::endl;
+    
+    EXPECT_GT(sink, 0u);
+    EXPECT_LT(coverageBytes * 10, availability.size() * sizeof(std::pair<const uint64_t, bool>));
+    EXPECT_LT(warmMs, mapMs * 1.5);
+}
+
 TEST_F(FontManagerTest, SelectFontForCodepoint_Latin) {
     FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
     
@@ -736,6 +1075,234 @@ TEST(TextUtilsTest, GetLanguageForScript_Common) {
     EXPECT_STREQ(TextUtils::getLanguageForScript(HB_SCRIPT_HIRAGANA), "ja");
 }
 
+TEST(TextUtilsTest, Classification_CoversAllOfUnicode) {
+    // Scripts outside the old hand-picked blocks
+    EXPECT_EQ(TextUtils::detectScript(0x0416), HB_SCRIPT_CYRILLIC);    // Ж
+    EXPECT_EQ(TextUtils::detectScript(0x0915), HB_SCRIPT_DEVANAGARI);  // क
+    EXPECT_EQ(TextUtils::detectScript(0x3042), HB_SCRIPT_HIRAGANA);    // あ
+    EXPECT_EQ(TextUtils::detectScript(0x31350), HB_SCRIPT_HAN);        // CJK Extension H
+    EXPECT_TRUE(TextUtils::isChineseCharacter(0x31350));
+    EXPECT_TRUE(TextUtils::isWesternCharacter(0x0416));
+    
+    // Script-neutral codepoints and combining marks are Common
+    EXPECT_EQ(TextUtils::detectScript('7'), HB_SCRIPT_COMMON);
+    EXPECT_EQ(TextUtils::detectScript(0x0301), HB_SCRIPT_COMMON);      // Combining acute
+    EXPECT_EQ(TextUtils::detectScript(0x110000), HB_SCRIPT_COMMON);
+    EXPECT_FALSE(TextUtils::isWesternCharacter(0x110000));
+    
+    // Classes follow Unicode properties rather than whole blocks
+    EXPECT_TRUE(TextUtils::isEmojiCharacter(0x2764));     // ❤ Extended_Pictographic
+    EXPECT_TRUE(TextUtils::isEmojiCharacter(0x1F1FA));    // Regional indicator U
+    EXPECT_FALSE(TextUtils::isEmojiCharacter(0x1F700));   // Alchemical symbol
+    EXPECT_TRUE(TextUtils::isSymbolCharacter(0x1F700));
+    EXPECT_TRUE(TextUtils::isSymbolCharacter(0x1D11E));   // Musical G clef
+    EXPECT_TRUE(TextUtils::isSymbolCharacter(0x2460));    // Circled digit one
+    EXPECT_TRUE(TextUtils::isChineseCharacter(0x3001));   // Ideographic comma
+    EXPECT_FALSE(TextUtils::isWesternCharacter(0x3001));
+}
+
+TEST(TextUtilsTest, DetectTextScript_CombiningMarksFollowTheirBase) {
+    EXPECT_EQ(TextUtils::detectTextScript("Cafe\xCC\x81"), HB_SCRIPT_LATIN);  // e + U+0301
+    EXPECT_EQ(TextUtils::detectTextScript("-12.5 dB"), HB_SCRIPT_LATIN);
+    EXPECT_EQ(TextUtils::detectTextScript("-12.5"), HB_SCRIPT_COMMON);
+    EXPECT_EQ(TextUtils::detectTextScript("Громкость 3"), HB_SCRIPT_CYRILLIC);
+}
+
+namespace {
+
+/** The range chain detectScript() used before the generated table, kept as a baseline. */
+hb_script_t detectScriptByRanges(uint32_t codepoint) {
+    if ((codepoint >= 0x4E00 && codepoint <= 0x9FFF) || (codepoint >= 0x3400 && codepoint <= 0x4DBF) ||
+        (codepoint >= 0x20000 && codepoint <= 0x2A6DF) || (codepoint >= 0x2A700 && codepoint <= 0x2B73F) ||
+        (codepoint >= 0x2B740 && codepoint <= 0x2B81F) || (codepoint >= 0xF900 && codepoint <= 0xFAFF) ||
+        (codepoint >= 0x2F800 && codepoint <= 0x2FA1F))
+        return HB_SCRIPT_HAN;
+    if ((codepoint >= 0x0020 && codepoint <= 0x007F) || (codepoint >= 0x00A0 && codepoint <= 0x00FF) ||
+        (codepoint >= 0x0100 && codepoint <= 0x017F) || (codepoint >= 0x0180 && codepoint <= 0x024F))
+        return HB_SCRIPT_LATIN;
+    if (codepoint >= 0x3040 && codepoint <= 0x309F) return HB_SCRIPT_HIRAGANA;
+    if (codepoint >= 0x30A0 && codepoint <= 0x30FF) return HB_SCRIPT_KATAKANA;
+    if (codepoint >= 0xAC00 && codepoint <= 0xD7AF) return HB_SCRIPT_HANGUL;
+    if (codepoint >= 0x0600 && codepoint <= 0x06FF) return HB_SCRIPT_ARABIC;
+    if (codepoint >= 0x0590 && codepoint <= 0x05FF) return HB_SCRIPT_HEBREW;
+    if (codepoint >= 0x0E00 && codepoint <= 0x0E7F) return HB_SCRIPT_THAI;
+    return HB_SCRIPT_COMMON;
+}
+
+bool isEmojiByRanges(uint32_t codepoint) {
+    return (codepoint >= 0x1F300 && codepoint <= 0x1FAFF) || (codepoint >= 0x2600 && codepoint <= 0x27BF) ||
+           (codepoint >= 0xFE00 && codepoint <= 0xFE0F);
+}
+
+} // namespace
+
+TEST(TextUtilsTest, PerformanceTest_ClassificationThroughput) {
+    // Mixed track-list text: Latin, CJK, emoji and symbols
+    std::string text;
+    for (int i = 0; i < 2000; ++i) text += "Lead Vox 主唱 🎤 -3.5 dB ▶ ";
+    
+    std::vector<uint32_t> codepoints;
+    for (const char* p = text.c_str(); *p; ) codepoints.push_back(TextUtils::decodeUTF8(p));
+    
+    const int rounds = 20;
+    uint32_t rangeSink = 0;
+    uint32_t tableSink = 0;
+    
+    auto rangeStart = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (uint32_t codepoint : codepoints)
+            rangeSink += static_cast<uint32_t>(detectScriptByRanges(codepoint)) + isEmojiByRanges(codepoint);
+    auto rangeEnd = std::chrono::high_resolution_clock::now();
+    
+    for (int r = 0; r < rounds; ++r)
+        for (uint32_t codepoint : codepoints)
+            tableSink += static_cast<uint32_t>(TextUtils::detectScript(codepoint)) + TextUtils::isEmojiCharacter(codepoint);
+    auto tableEnd = std::chrono::high_resolution_clock::now();
+    
+    for (int r = 0; r < rounds; ++r)
+        tableSink += static_cast<uint32_t>(TextUtils::detectTextScript(text.c_str()));
+    auto textEnd = std::chrono::high_resolution_clock::now();
+    
+    const double lookups = static_cast<double>(codepoints.size()) * rounds;
+    const double rangeMs = std::chrono::duration<double, std::milli>(rangeEnd - rangeStart).count();
+    const double tableMs = std::chrono::duration<double, std::milli>(tableEnd - rangeEnd).count();
+    const double textMs = std::chrono::duration<double, std::milli>(textEnd - tableEnd).count();
+    
+    std::cout << "[Classification] " << codepoints.size() << " codepoints x " << rounds << ": "
+              << lookups / rangeMs / 1000.0 << " M/s range chains, "
+              << lookups / tableMs / 1000.0 << " M/s table, detectTextScript "
+              << text.size() * rounds / textMs / 1000.0 << " MB/s" << std::endl;
+    
+    EXPECT_NE(rangeSink, 0u);
+    EXPECT_NE(tableSink, 0u);
+}
+
+namespace {
+
+/** Decodes with repeated decodeUTF8() calls, the reference for the bulk decoders. */
+std::u32string decodeOneByOne(const std::string& text) {
+    std::u32string result;
+    for (const char* p = text.c_str(); *p; ) result.push_back(TextUtils::decodeUTF8(p));
+    return result;
+}
+
+/** ASCII padding that puts the next byte at every position within a vector. */
+std::vector<std::string> paddedSamples(const std::string& tail) {
+    std::vector<std::string> samples;
+    for (size_t pad = 0; pad < 70; ++pad) samples.push_back(std::string(pad, 'a') + tail);
+    return samples;
+}
+
+} // namespace
+
+TEST(TextUtilsTest, DecodeUTF8_RejectsOverlongSequences) {
+    const char* text = "\xC0\xAF" "A";   // Overlong '/'
+    EXPECT_EQ(TextUtils::decodeUTF8(text), 0xFFFDu);
+    EXPECT_EQ(TextUtils::decodeUTF8(text), static_cast<uint32_t>('A'));
+}
+
+TEST(TextUtilsTest, ValidateUTF8_AcceptsWellFormedText) {
+    const std::string text = "Lead Vox 主唱 🎤 Громкость";
+    EXPECT_TRUE(TextUtils::validateUTF8(text.data(), text.size()));
+    EXPECT_TRUE(TextUtils::validateUTF8("", 0));
+    EXPECT_TRUE(TextUtils::validateUTF8("\xEF\xBF\xBD", 3));   // U+FFFD itself is valid
+}
+
+TEST(TextUtilsTest, ValidateUTF8_RejectsMalformedText) {
+    for (const std::string bad : { "\xFF", "\xC0\x80", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE4\xB8", "\x80" }) {
+        for (const std::string& sample : paddedSamples(bad)) {
+            EXPECT_FALSE(TextUtils::validateUTF8(sample.data(), sample.size())) << sample.size();
+            EXPECT_FALSE(TextUtils::validateUTF8((sample + "tail").data(), sample.size() + 4));
+        }
+    }
+}
+
+TEST(TextUtilsTest, DecodeUTF8ToUTF32_MatchesDecodeUTF8) {
+    for (const std::string tail : { "é", "主唱", "🎤x", "\xFF" "b", "\xE4\xB8" "c", "\xED\xA0\x80", "\xC0\xAF" }) {
+        for (const std::string& sample : paddedSamples(tail + std::string(40, 'z'))) {
+            std::u32string decoded = U"prefix";
+            const size_t count = TextUtils::decodeUTF8ToUTF32(sample.data(), sample.size(), decoded);
+            
+            EXPECT_EQ(decoded, U"prefix" + decodeOneByOne(sample));
+            EXPECT_EQ(count, decoded.size() - 6);
+        }
+    }
+    
+    // A cut-off sequence at the end of the range is one replacement character
+    std::u32string decoded;
+    TextUtils::decodeUTF8ToUTF32("ab\xE4\xB8", 4, decoded);
+    EXPECT_EQ(decoded, std::u32string(U"ab\uFFFD\uFFFD"));
+}
+
+TEST(TextUtilsTest, DecodeUTF8WithScripts_OneSweep) {
+    const std::string text = "Mix 主唱 🎤 Ж";
+    DecodedText decoded;
+    TextUtils::decodeUTF8WithScripts(text.data(), text.size(), decoded);
+    
+    EXPECT_EQ(decoded.codepoints, std::vector<uint32_t>({ 'M', 'i', 'x', ' ', 0x4E3B, 0x5531, ' ', 0x1F3A4, ' ', 0x0416 }));
+    EXPECT_EQ(decoded.byteOffsets, std::vector<uint32_t>({ 0, 1, 2, 3, 4, 7, 10, 11, 15, 16, 18 }));
+    ASSERT_EQ(decoded.scripts.size(), decoded.size());
+    EXPECT_EQ(decoded.getByteLength(7), 4u);
+    
+    for (size_t i = 0; i < decoded.size(); ++i)
+        EXPECT_EQ(decoded.scripts[i], TextUtils::detectScript(decoded.codepoints[i])) << i;
+    EXPECT_EQ(decoded.dominantScript, TextUtils::detectTextScript(text.c_str()));
+    EXPECT_EQ(decoded.dominantScript, HB_SCRIPT_HAN);
+    
+    // Reuse replaces the previous contents
+    TextUtils::decodeUTF8WithScripts("-3 dB", 5, decoded);
+    EXPECT_EQ(decoded.size(), 5u);
+    EXPECT_EQ(decoded.dominantScript, HB_SCRIPT_LATIN);
+}
+
+TEST(TextUtilsTest, PerformanceTest_BulkDecodeASCII) {
+    // Typical label text: plain ASCII
+    std::string text;
+    while (text.size() < 64 * 1024) text += "Channel 12 Send A -6.0 dB Pre Fader ";
+    
+    const int rounds = 50;
+    size_t sink = 0;
+    
+    auto scalarStart = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        std::u32string decoded;
+        decoded.reserve(text.size());
+        for (const char* p = text.c_str(); *p; ) decoded.push_back(TextUtils::decodeUTF8(p));
+        sink += decoded.size();
+    }
+    auto scalarEnd = std::chrono::high_resolution_clock::now();
+    
+    for (int r = 0; r < rounds; ++r) {
+        std::u32string decoded;
+        sink += TextUtils::decodeUTF8ToUTF32(text.data(), text.size(), decoded);
+    }
+    auto bulkEnd = std::chrono::high_resolution_clock::now();
+    
+    for (int r = 0; r < rounds; ++r) {
+        std::u32string copy(text.size(), U'\0');
+        for (size_t i = 0; i < text.size(); ++i) copy[i] = static_cast<unsigned char>(text[i]);
+        sink += copy.size();
+    }
+    auto copyEnd = std::chrono::high_resolution_clock::now();
+    
+    for (int r = 0; r < rounds; ++r) sink += TextUtils::validateUTF8(text.data(), text.size());
+    auto validateEnd = std::chrono::high_resolution_clock::now();
+    
+    const double megabytes = text.size() * rounds / (1024.0 * 1024.0);
+    const double scalarMs = std::chrono::duration<double, std::milli>(scalarEnd - scalarStart).count();
+    const double bulkMs = std::chrono::duration<double, std::milli>(bulkEnd - scalarEnd).count();
+    const double copyMs = std::chrono::duration<double, std::milli>(copyEnd - bulkEnd).count();
+    const double validateMs = std::chrono::duration<double, std::milli>(validateEnd - copyEnd).count();
+    
+    std::cout << "[UTF-8 ASCII] " << megabytes / (scalarMs / 1000.0) << " MB/s decodeUTF8, "
+              << megabytes / (bulkMs / 1000.0) << " MB/s decodeUTF8ToUTF32, "
+              << megabytes / (copyMs / 1000.0) << " MB/s widening copy, "
+              << megabytes / (validateMs / 1000.0) << " MB/s validateUTF8" << std::endl;
+    
+    EXPECT_GT(sink, 0u);
+    EXPECT_LT(bulkMs, scalarMs);
+}
+
 //==========================================================================================
 // TextRenderer Tests
 //==========================================================================================
@@ -801,6 +1368,58 @@ TEST_F(TextRendererTest, GenerateTextVertices_SimpleText) {
     EXPECT_EQ(vertices.size() % 4, 0u); // Should be multiple of 4 (quads)
 }
 
+TEST_F(TextRendererTest, GenerateTextVertices_SpillsIntoSecondAtlasPerRange) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    
+    // Glyphs this large fill a 1024x1024 atlas within a few dozen, standing in for a
+    // large CJK set at UI sizes
+    const std::string text = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    
+    ShapedText shaped;
+    m_textRenderer->shapeText(text.c_str(), chain, 300.0f, 0, shaped);
+    
+    std::vector<TextVertex> vertices;
+    std::vector<TextVertexRange> ranges;
+    m_textRenderer->generateTextVertices(shaped, Vec2(0, 0), Vec4(1, 1, 1, 1),
+                                         chain, 300.0f, vertices, ranges);
+    m_textRenderer->flushGlyphUploads();
+    
+    ASSERT_GE(ranges.size(), 2u);
+    EXPECT_GE(m_backend->getTextureCount(), ranges.size());
+    
+    uint32_t expectedFirst = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        const TextVertexRange& range = ranges[i];
+        EXPECT_EQ(range.firstVertex, expectedFirst);
+        EXPECT_EQ(range.vertexCount % 4, 0u);
+        expectedFirst += range.vertexCount;
+        for (size_t j = 0; j < i; ++j) EXPECT_NE(ranges[j].atlasTexture, range.atlasTexture);
+        
+        // Every quad's UV rect must land on coverage in its own atlas texture
+        const std::vector<uint8_t>* pixels = m_backend->getTextureData(range.atlasTexture);
+        ASSERT_NE(pixels, nullptr);
+        const uint32_t atlasSize = Config::GlyphCache::BASE_ATLAS_WIDTH;
+        
+        for (uint32_t v = range.firstVertex; v < range.firstVertex + range.vertexCount; v += 4) {
+            const Vec2 uvMin = vertices[v].texCoord;
+            const Vec2 uvMax = vertices[v + 3].texCoord;
+            ASSERT_LE(uvMax.x, 1.0f);
+            ASSERT_LE(uvMax.y, 1.0f);
+            
+            const uint32_t x0 = static_cast<uint32_t>(uvMin.x * atlasSize + 0.5f);
+            const uint32_t y0 = static_cast<uint32_t>(uvMin.y * atlasSize + 0.5f);
+            const uint32_t x1 = static_cast<uint32_t>(uvMax.x * atlasSize + 0.5f);
+            const uint32_t y1 = static_cast<uint32_t>(uvMax.y * atlasSize + 0.5f);
+            
+            uint32_t coverage = 0;
+            for (uint32_t y = y0; y < y1; ++y)
+                for (uint32_t x = x0; x < x1; ++x) coverage += (*pixels)[y * atlasSize + x];
+            EXPECT_GT(coverage, 0u) << "quad " << v / 4 << " samples an empty region of atlas " << range.atlasIndex;
+        }
+    }
+    EXPECT_EQ(expectedFirst, vertices.size());
+}
+
 TEST_F(TextRendererTest, BeginFrame_AdvancesGlyphCache) {
     m_textRenderer->beginFrame();
     m_textRenderer->beginFrame();
@@ -810,6 +1429,233 @@ TEST_F(TextRendererTest, BeginFrame_AdvancesGlyphCache) {
     SUCCEED();
 }
 
+TEST_F(TextRendererTest, ShapeText_HitsShareCachedRun) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    
+    ShapedTextRef first = m_textRenderer->shapeText("-12.5 dB", chain, 12.0f, 0.0f);
+    ShapedTextRef second = m_textRenderer->shapeText("-12.5 dB", chain, 12.0f, 0.0f);
+    
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_FALSE(first->isEmpty());
+    
+    const ShapedTextCacheStats& stats = m_textRenderer->getShapedTextCacheStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.entryCount, 1u);
+    EXPECT_GT(stats.bytesUsed, 0u);
+    
+    ShapedTextRef empty = m_textRenderer->shapeText("", chain, 12.0f, 0.0f);
+    ASSERT_NE(empty, nullptr);
+    EXPECT_TRUE(empty->isEmpty());
+}
+
+TEST_F(TextRendererTest, ShapeText_DistinctLetterSpacingsGetDistinctRuns) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    
+    // Spacings that used to fall into one quantization step, or truncate to the same key
+    ShapedTextRef tight = m_textRenderer->shapeText("Send", chain, 12.0f, 12.0f);
+    ShapedTextRef wide = m_textRenderer->shapeText("Send", chain, 12.0f, 18.0f);
+    ShapedTextRef negative = m_textRenderer->shapeText("Send", chain, 12.0f, -9.0f);
+    ShapedTextRef positive = m_textRenderer->shapeText("Send", chain, 12.0f, 9.0f);
+    
+    ASSERT_NE(tight, nullptr);
+    ASSERT_NE(wide, nullptr);
+    EXPECT_NE(tight.get(), wide.get());
+    EXPECT_NE(negative.get(), positive.get());
+    EXPECT_GT(wide->totalAdvance, tight->totalAdvance);
+    EXPECT_GT(positive->totalAdvance, negative->totalAdvance);
+    EXPECT_EQ(m_textRenderer->getShapedTextCacheStats().entryCount, 4u);
+    
+    // Negative and positive zero shape the same and share a run
+    EXPECT_EQ(m_textRenderer->shapeText("Send", chain, 12.0f, 0.0f).get(),
+              m_textRenderer->shapeText("Send", chain, 12.0f, -0.0f).get());
+}
+
+TEST_F(TextRendererTest, ShapeText_ChangingReadoutStaysWithinBudget) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    const size_t budget = 16 * 1024;
+    m_textRenderer->setShapedTextCacheBudget(budget);
+    
+    char buffer[32];
+    for (int frame = 0; frame < 5000; ++frame)
+    {
+        snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d:%02d",
+                 frame / 216000, (frame / 3600) % 60, (frame / 60) % 60, frame % 60);
+        m_textRenderer->shapeText(buffer, chain, 12.0f, 0.0f);
+        m_textRenderer->shapeText("Timecode", chain, 12.0f, 0.0f);
+    }
+    
+    const ShapedTextCacheStats& stats = m_textRenderer->getShapedTextCacheStats();
+    EXPECT_LE(stats.bytesUsed, budget);
+    EXPECT_EQ(stats.byteBudget, budget);
+    EXPECT_GT(stats.evictions, 0u);
+    EXPECT_EQ(stats.misses, 5001u);
+    EXPECT_EQ(stats.hits, 4999u);
+}
+
+//==========================================================================================
+// ShapedTextCache Tests
+//==========================================================================================
+
+namespace {
+
+const FontFallbackChain& testChain()
+{
+    static const FontFallbackChain chain(0, 1);
+    return chain;
+}
+
+ShapedText makeRun(size_t glyphCount)
+{
+    ShapedText shaped;
+    shaped.glyphs.resize(glyphCount);
+    shaped.totalAdvance = static_cast<float>(glyphCount);
+    return shaped;
+}
+
+TextCacheKey makeKey(const char* text)
+{
+    return TextCacheKey(text, testChain(), 12.0f);
+}
+
+} // namespace
+
+TEST(ShapedTextCacheTest, EvictsLeastRecentlyUsed) {
+    const size_t entryBytes = ShapedTextCache::estimateBytes(makeKey("a"), makeRun(8));
+    ShapedTextCache cache(entryBytes * 3);
+    
+    cache.insert(makeKey("a"), makeRun(8));
+    cache.insert(makeKey("b"), makeRun(8));
+    cache.insert(makeKey("c"), makeRun(8));
+    EXPECT_EQ(cache.getStats().bytesUsed, entryBytes * 3);
+    
+    // Touch "a" so "b" becomes the oldest
+    EXPECT_NE(cache.find(makeKey("a")), nullptr);
+    cache.insert(makeKey("d"), makeRun(8));
+    
+    EXPECT_EQ(cache.find(makeKey("b")), nullptr);
+    EXPECT_NE(cache.find(makeKey("a")), nullptr);
+    EXPECT_NE(cache.find(makeKey("c")), nullptr);
+    EXPECT_NE(cache.find(makeKey("d")), nullptr);
+    
+    const ShapedTextCacheStats& stats = cache.getStats();
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.entryCount, 3u);
+    EXPECT_EQ(stats.hits, 4u);
+    EXPECT_EQ(stats.misses, 1u);
+}
+
+TEST(ShapedTextCacheTest, EvictedRunStaysAliveForHolder) {
+    const size_t entryBytes = ShapedTextCache::estimateBytes(makeKey("a"), makeRun(4));
+    ShapedTextCache cache(entryBytes);
+    
+    ShapedTextRef held = cache.insert(makeKey("a"), makeRun(4));
+    cache.insert(makeKey("b"), makeRun(4));
+    
+    EXPECT_EQ(cache.find(makeKey("a")), nullptr);
+    EXPECT_EQ(held->glyphs.size(), 4u);
+    EXPECT_FLOAT_EQ(held->totalAdvance, 4.0f);
+}
+
+TEST(ShapedTextCacheTest, OversizedRunIsReturnedButNotCached) {
+    ShapedTextCache cache(ShapedTextCache::estimateBytes(makeKey("a"), makeRun(4)));
+    
+    ShapedTextRef run = cache.insert(makeKey("long"), makeRun(64));
+    ASSERT_NE(run, nullptr);
+    EXPECT_EQ(run->glyphs.size(), 64u);
+    EXPECT_EQ(cache.getStats().entryCount, 0u);
+    EXPECT_EQ(cache.getStats().bytesUsed, 0u);
+}
+
+TEST(ShapedTextCacheTest, ShrinkingBudgetEvicts) {
+    const size_t entryBytes = ShapedTextCache::estimateBytes(makeKey("a"), makeRun(2));
+    ShapedTextCache cache(entryBytes * 4);
+    
+    for (const char* text : { "a", "b", "c", "d" }) cache.insert(makeKey(text), makeRun(2));
+    cache.setByteBudget(entryBytes * 2);
+    
+    EXPECT_EQ(cache.getStats().entryCount, 2u);
+    EXPECT_EQ(cache.getStats().evictions, 2u);
+    EXPECT_NE(cache.find(makeKey("d")), nullptr);
+    EXPECT_EQ(cache.find(makeKey("a")), nullptr);
+    
+    cache.resetStats();
+    cache.clear();
+    EXPECT_EQ(cache.getStats().hits, 0u);
+    EXPECT_EQ(cache.getStats().bytesUsed, 0u);
+    EXPECT_EQ(cache.find(makeKey("d")), nullptr);
+}
+
+TEST(ShapedTextCacheTest, KeysCompareContentNotJustHash) {
+    const FontFallbackChain& chain = testChain();
+    const std::string owned = "Audio 1";
+    
+    TextCacheKey a("Audio 1", chain, 12.0f);
+    TextCacheKey b(std::string_view(owned), chain, 12.0f);
+    EXPECT_EQ(a.hash, b.hash);
+    EXPECT_TRUE(a == b);
+    
+    // Force equal hashes: differing content must still compare unequal
+    TextCacheKey c("Audio 2", chain, 12.0f);
+    c.hash = a.hash;
+    EXPECT_FALSE(a == c);
+    
+    FontFallbackChain otherChain(1, 0);
+    TextCacheKey d("Audio 1", otherChain, 12.0f);
+    d.hash = a.hash;
+    EXPECT_FALSE(a == d);
+    
+    TextCacheKey e("Audio 1", chain, 12.5f);
+    e.hash = a.hash;
+    EXPECT_FALSE(a == e);
+    
+    EXPECT_NE(TextCacheKey("ab", chain, 12.0f).hash, TextCacheKey("ba", chain, 12.0f).hash);
+    EXPECT_NE(TextCacheKey("", chain, 12.0f).hash, TextCacheKey(std::string_view("\0", 1), chain, 12.0f).hash);
+}
+
+TEST(ShapedTextCacheTest, StoredKeysOwnTheirBytes) {
+    ShapedTextCache cache;
+    
+    std::string text = "-inf";
+    cache.insert(TextCacheKey(text, testChain(), 12.0f), makeRun(4));
+    
+    // Overwriting the caller's buffer must not disturb the stored key
+    text = "+0.0";
+    EXPECT_EQ(cache.find(TextCacheKey(text, testChain(), 12.0f)), nullptr);
+    EXPECT_NE(cache.find(TextCacheKey("-inf", testChain(), 12.0f)), nullptr);
+}
+
+TEST(ShapedTextCacheTest, PerformanceTest_LookupCost) {
+    ShapedTextCache cache;
+    const FontFallbackChain& chain = testChain();
+    
+    const char* labels[] = { "M", "Solo", "-12.5 dB", "Audio 12", "00:01:23:14",
+                             "Master Bus", "Kick In (Sub) 2", "Reverb Return – Plate L/R" };
+    for (const char* label : labels) cache.insert(TextCacheKey(label, chain, 12.0f), makeRun(std::strlen(label)));
+    
+    const int iterations = 200000;
+    for (const char* label : labels)
+    {
+        const size_t length = std::strlen(label);
+        size_t found = 0;
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            TextCacheKey key(std::string_view(label, length), chain, 12.0f);
+            found += cache.find(key) != nullptr;
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        const double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        std::cout << "[ShapedTextCache] " << length << "-byte key lookup: " << ns << " ns" << std::endl;
+        
+        EXPECT_EQ(found, static_cast<size_t>(iterations));
+        EXPECT_LT(ns, 2000.0);
+    }
+}
+
 //==========================================================================================
 // GlyphCache Tests
 //==========================================================================================
@@ -893,6 +1739,821 @@ TEST_F(GlyphCacheTest, TextureCreation_Tracked) {
     EXPECT_GE(m_backend->getTextureCount(), initialCount);
 }
 
+TEST_F(GlyphCacheTest, ExpiredGlyphSpaceIsReused) {
+    GlyphKey first(1, 65, 12.0f);
+    std::vector<uint8_t> bitmap(16 * 16, 128);
+    m_glyphCache->cacheGlyph(first, bitmap.data(), Vec2(16, 16), Vec2(0, 12), 8.0f);
+    const Rect firstRect = m_glyphCache->getGlyph(first)->textureRect;
+    
+    const uint32_t frames = Config::GlyphCache::GLYPH_EXPIRE_FRAMES + Config::GlyphCache::CLEANUP_INTERVAL_FRAMES;
+    for (uint32_t i = 0; i < frames; ++i) m_glyphCache->beginFrame();
+    EXPECT_EQ(m_glyphCache->getGlyph(first), nullptr);
+    
+    GlyphKey second(1, 66, 12.0f);
+    m_glyphCache->cacheGlyph(second, bitmap.data(), Vec2(16, 16), Vec2(0, 12), 8.0f);
+    ASSERT_NE(m_glyphCache->getGlyph(second), nullptr);
+    EXPECT_EQ(m_glyphCache->getGlyph(second)->textureRect, firstRect);
+}
+
+TEST_F(GlyphCacheTest, RepackPreservesLiveGlyphs) {
+    // 28px glyphs pad to 32px cells: 32 per shelf, 20 shelves cover most of the atlas
+    const int glyphCount = 640;
+    const uint32_t size = 28;
+    
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        std::vector<uint8_t> bitmap(size * size, static_cast<uint8_t>(1 + i % 250));
+        m_glyphCache->cacheGlyph(GlyphKey(1, i, 12.0f), bitmap.data(), Vec2(size, size), Vec2(0, 20), 16.0f);
+    }
+    ASSERT_EQ(m_glyphCache->getAtlasCount(), 1u);
+    
+    // Keep every third glyph alive until the rest expire and the atlas is re-packed
+    const uint32_t frames = Config::GlyphCache::GLYPH_EXPIRE_FRAMES + Config::GlyphCache::CLEANUP_INTERVAL_FRAMES * 2;
+    for (uint32_t frame = 0; frame < frames; ++frame)
+    {
+        m_glyphCache->beginFrame();
+        for (int i = 0; i < glyphCount; i += 3) ASSERT_NE(m_glyphCache->getGlyph(GlyphKey(1, i, 12.0f)), nullptr);
+    }
+    
+    EXPECT_EQ(m_glyphCache->getGlyphCount(), static_cast<size_t>((glyphCount + 2) / 3));
+    EXPECT_LT(m_glyphCache->getAtlasFragmentation(0), Config::GlyphCache::DEFRAG_THRESHOLD);
+    
+    const std::vector<uint8_t>& pixels = m_glyphCache->getAtlasPixels(0);
+    const Vec2 atlasSize = m_glyphCache->getCurrentAtlasSize();
+    const size_t atlasWidth = static_cast<size_t>(atlasSize.x);
+    
+    float lowestTop = atlasSize.y;
+    for (int i = 0; i < glyphCount; i += 3)
+    {
+        const GlyphCacheEntry* entry = m_glyphCache->getGlyph(GlyphKey(1, i, 12.0f));
+        ASSERT_NE(entry, nullptr);
+        lowestTop = std::min(lowestTop, entry->textureRect.y);
+        
+        const size_t x = static_cast<size_t>(entry->textureRect.x);
+        const size_t y = static_cast<size_t>(entry->textureRect.y);
+        const uint8_t expected = static_cast<uint8_t>(1 + i % 250);
+        EXPECT_EQ(pixels[y * atlasWidth + x], expected) << "glyph " << i;
+        EXPECT_EQ(pixels[(y + size - 1) * atlasWidth + x + size - 1], expected) << "glyph " << i;
+    }
+    EXPECT_EQ(lowestTop, static_cast<float>(Config::GlyphCache::GLYPH_PADDING));
+    
+    // The texture received the re-packed copy
+    const std::vector<uint8_t>* texture = m_backend->getTextureData(m_glyphCache->getCurrentAtlasTexture());
+    ASSERT_NE(texture, nullptr);
+    EXPECT_TRUE(*texture == pixels);
+}
+
+TEST_F(GlyphCacheTest, UploadsAreDeferredAndMerged) {
+    const int glyphCount = 640;
+    const uint32_t size = 28;
+    m_backend->resetCounters();
+    
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        std::vector<uint8_t> bitmap(size * size, static_cast<uint8_t>(1 + i % 250));
+        m_glyphCache->cacheGlyph(GlyphKey(1, i, 12.0f), bitmap.data(), Vec2(size, size), Vec2(0, 20), 16.0f);
+    }
+    
+    EXPECT_EQ(m_backend->getUpdateCount(), 0u);
+    EXPECT_TRUE(m_glyphCache->hasPendingUploads());
+    
+    m_glyphCache->flushUploads();
+    EXPECT_FALSE(m_glyphCache->hasPendingUploads());
+    
+    // Shelves filled side by side merge into a handful of uploads, not one per glyph
+    const GlyphUploadStats& stats = m_glyphCache->getUploadStats();
+    EXPECT_EQ(stats.glyphsWritten, static_cast<uint64_t>(glyphCount));
+    EXPECT_EQ(stats.uploadCount, m_backend->getUpdateCount());
+    EXPECT_LE(stats.uploadCount, 2u);
+    EXPECT_LE(stats.uploadBytes, static_cast<uint64_t>(m_glyphCache->getAtlasPixels(0).size()));
+    EXPECT_EQ(stats.flushCount, 1u);
+    
+    const std::vector<uint8_t>* texture = m_backend->getTextureData(m_glyphCache->getCurrentAtlasTexture());
+    ASSERT_NE(texture, nullptr);
+    EXPECT_TRUE(*texture == m_glyphCache->getAtlasPixels(0));
+    
+    // A lone new glyph uploads only its padded cell, and an idle flush uploads nothing
+    m_glyphCache->resetUploadStats();
+    std::vector<uint8_t> bitmap(10 * 10, 255);
+    m_glyphCache->cacheGlyph(GlyphKey(2, 0, 12.0f), bitmap.data(), Vec2(10, 10), Vec2(0, 10), 11.0f);
+    m_glyphCache->flushUploads();
+    m_glyphCache->flushUploads();
+    
+    const uint32_t cell = 10 + Config::GlyphCache::GLYPH_PADDING * 2;
+    EXPECT_EQ(stats.uploadCount, 1u);
+    EXPECT_EQ(stats.uploadBytes, static_cast<uint64_t>(cell * cell));
+    EXPECT_EQ(stats.flushCount, 1u);
+}
+
+TEST_F(GlyphCacheTest, KeepsCachingNewGlyphsWithBoundedAtlases) {
+    // A CJK-heavy session: every frame shows 40 glyphs never seen before
+    const uint32_t size = 60;
+    const int glyphsPerFrame = 40;
+    const int frames = 200;
+    std::vector<uint8_t> bitmap(size * size, 200);
+    
+    int dropped = 0;
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        m_glyphCache->beginFrame();
+        for (int i = 0; i < glyphsPerFrame; ++i)
+        {
+            // Each glyph stays on screen for two frames, as text being typed would
+            for (int age = 0; age < 2 && frame - age >= 0; ++age)
+            {
+                GlyphKey key(2, static_cast<uint32_t>((frame - age) * glyphsPerFrame + i), 24.0f);
+                if (m_glyphCache->getGlyph(key)) continue;
+                
+                m_glyphCache->cacheGlyph(key, bitmap.data(), Vec2(size, size), Vec2(0, 50), 60.0f);
+                if (!m_glyphCache->getGlyph(key)) ++dropped;
+            }
+        }
+    }
+    
+    EXPECT_LE(m_glyphCache->getAtlasCount(), static_cast<size_t>(Config::GlyphCache::MAX_ATLASES));
+    
+    // Only frames that hit the atlas limit drop glyphs, and the next frame recovers
+    EXPECT_LT(dropped, frames * glyphsPerFrame / 10);
+    for (int i = 0; i < glyphsPerFrame; ++i)
+        EXPECT_NE(m_glyphCache->getGlyph(GlyphKey(2, static_cast<uint32_t>((frames - 1) * glyphsPerFrame + i), 24.0f)), nullptr);
+}
+
+//==========================================================================================
+// ShelfPacker Tests
+//==========================================================================================
+
+TEST(ShelfPackerTest, FreedSpanIsReused) {
+    ShelfPacker packer(512, 64);
+    
+    uint32_t x = 0, y = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> placed;
+    for (int i = 0; i < 16; ++i)
+    {
+        ASSERT_TRUE(packer.allocate(32, 16, x, y));
+        placed.emplace_back(x, y);
+    }
+    EXPECT_EQ(packer.getShelfTop(), 16u);
+    EXPECT_FALSE(packer.allocate(32, 64, x, y));
+    
+    packer.free(placed[5].first, placed[5].second, 32, 16);
+    ASSERT_TRUE(packer.allocate(30, 14, x, y));
+    EXPECT_EQ(x, placed[5].first);
+    EXPECT_EQ(y, placed[5].second);
+    EXPECT_EQ(packer.getShelfTop(), 16u);
+}
+
+TEST(ShelfPackerTest, EmptyShelvesAreReclaimed) {
+    ShelfPacker packer(64, 64);
+    
+    uint32_t ax, ay, bx, by, cx, cy;
+    ASSERT_TRUE(packer.allocate(64, 32, ax, ay));
+    ASSERT_TRUE(packer.allocate(64, 16, bx, by));
+    ASSERT_TRUE(packer.allocate(64, 16, cx, cy));
+    EXPECT_EQ(packer.getShelfTop(), 64u);
+    EXPECT_FLOAT_EQ(packer.getFragmentation(), 0.0f);
+    
+    // The emptied bottom shelf is re-cut for a shorter rectangle
+    packer.free(ax, ay, 64, 32);
+    uint32_t x, y;
+    ASSERT_TRUE(packer.allocate(64, 8, x, y));
+    EXPECT_EQ(y, 0u);
+    ASSERT_TRUE(packer.allocate(64, 24, x, y));
+    EXPECT_EQ(y, 8u);
+    
+    // Freeing everything gives the whole area back
+    packer.free(0, 0, 64, 8);
+    packer.free(0, 8, 64, 24);
+    packer.free(bx, by, 64, 16);
+    packer.free(cx, cy, 64, 16);
+    EXPECT_EQ(packer.getShelfTop(), 0u);
+    EXPECT_EQ(packer.getUsedArea(), 0u);
+    ASSERT_TRUE(packer.allocate(64, 64, x, y));
+}
+
+TEST(ShelfPackerTest, SimilarHeightsShareShelves) {
+    ShelfPacker packer(256, 256);
+    
+    uint32_t x, y;
+    ASSERT_TRUE(packer.allocate(20, 18, x, y));
+    ASSERT_TRUE(packer.allocate(20, 17, x, y));
+    EXPECT_EQ(y, 0u);
+    ASSERT_TRUE(packer.allocate(20, 6, x, y));
+    EXPECT_GT(y, 0u);
+    EXPECT_EQ(packer.getShelfTop(), 20u + 8u);
+}
+
+//==========================================================================================
+// GlyphRasterizer Tests
+//==========================================================================================
+
+class GlyphRasterizerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_fontManager = std::make_unique<FontManager>();
+        ASSERT_TRUE(m_fontManager->initialize(Testing::getEmbeddedResourceResolver()));
+    }
+    
+    void TearDown() override {
+        m_fontManager->destroy();
+        m_fontManager.reset();
+    }
+    
+    /** One job per character of text in the default font. */
+    std::vector<GlyphRasterJob> makeJobs(const char* text, float size) {
+        const FontHandle font = m_fontManager->getDefaultFont();
+        FT_Face face = static_cast<FT_Face>(m_fontManager->getFontFace(font));
+        
+        GlyphRasterJob job{ GlyphKey(font, 0, size, Config::Font::EMBOLDEN_STRENGTH), nullptr, 0 };
+        EXPECT_TRUE(m_fontManager->getFontData(font, job.fontData, job.fontDataSize));
+        
+        std::vector<GlyphRasterJob> jobs;
+        for (const char* c = text; *c; ++c) {
+            job.key.glyphIndex = FT_Get_Char_Index(face, static_cast<FT_ULong>(*c));
+            jobs.push_back(job);
+        }
+        return jobs;
+    }
+    
+    std::unique_ptr<FontManager> m_fontManager;
+};
+
+const char* const RASTER_TEXT = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 ";
+
+TEST_F(GlyphRasterizerTest, WorkersMatchInlineRasterization) {
+    std::vector<GlyphRasterJob> jobs = makeJobs(RASTER_TEXT, 24.0f);
+    
+    GlyphRasterizer rasterizer(4);
+    std::vector<RasterizedGlyph> results;
+    rasterizer.rasterize(jobs, results);
+    ASSERT_EQ(results.size(), jobs.size());
+    
+    void* face = m_fontManager->getFontFace(m_fontManager->getDefaultFont());
+    RasterizedGlyph inlineGlyph;
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        ASSERT_TRUE(GlyphRasterizer::rasterizeGlyph(face, jobs[i].key, inlineGlyph));
+        ASSERT_TRUE(results[i].isValid) << "glyph " << i;
+        EXPECT_TRUE(results[i].key == jobs[i].key);
+        EXPECT_EQ(results[i].size.x, inlineGlyph.size.x);
+        EXPECT_EQ(results[i].size.y, inlineGlyph.size.y);
+        EXPECT_EQ(results[i].bearing.x, inlineGlyph.bearing.x);
+        EXPECT_FLOAT_EQ(results[i].advance, inlineGlyph.advance);
+        EXPECT_TRUE(results[i].bitmap == inlineGlyph.bitmap) << "glyph " << i;
+    }
+    
+    // The space has metrics but no pixels
+    EXPECT_TRUE(results.back().bitmap.empty());
+    EXPECT_GT(results.back().advance, 0.0f);
+}
+
+TEST_F(GlyphRasterizerTest, SubmittedGlyphsAreCollectedOnce) {
+    std::vector<GlyphRasterJob> jobs = makeJobs("Hello", 18.0f);  // 'l' twice
+    
+    GlyphRasterizer rasterizer(2);
+    rasterizer.submit(jobs);
+    rasterizer.submit(jobs);
+    EXPECT_TRUE(rasterizer.isPending(jobs[0].key));
+    
+    std::vector<RasterizedGlyph> results;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (rasterizer.getPendingCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        rasterizer.collect(results);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    
+    EXPECT_EQ(results.size(), 4u);
+    EXPECT_FALSE(rasterizer.isPending(jobs[0].key));
+    for (const RasterizedGlyph& glyph : results) EXPECT_TRUE(glyph.isValid);
+}
+
+TEST_F(TextRendererTest, DeferredGlyphsDrawOnALaterFrame) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    ShapedText shaped;
+    m_textRenderer->shapeText("Deferred glyphs", chain, 16.0f, 0, shaped);
+    
+    m_textRenderer->setDeferGlyphRasterization(true);
+    
+    std::vector<TextVertex> vertices;
+    m_textRenderer->generateTextVertices(shaped, Vec2(0, 20), Vec4(1, 1, 1, 1), chain, 16.0f, vertices);
+    EXPECT_TRUE(vertices.empty());
+    EXPECT_TRUE(m_textRenderer->hasPendingGlyphs());
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (m_textRenderer->hasPendingGlyphs() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        m_textRenderer->beginFrame();
+    }
+    ASSERT_FALSE(m_textRenderer->hasPendingGlyphs());
+    
+    m_textRenderer->generateTextVertices(shaped, Vec2(0, 20), Vec4(1, 1, 1, 1), chain, 16.0f, vertices);
+    EXPECT_EQ(vertices.size(), 14u * 4u);  // Every glyph but the space
+}
+
+TEST_F(GlyphRasterizerTest, PerformanceTest_ParallelBatch) {
+    std::vector<GlyphRasterJob> jobs;
+    for (float size = 40.0f; size < 72.0f; size += 4.0f) {
+        std::vector<GlyphRasterJob> sized = makeJobs(RASTER_TEXT, size);
+        jobs.insert(jobs.end(), sized.begin(), sized.end());
+    }
+    
+    auto timeBatch = [&jobs](size_t threads) {
+        GlyphRasterizer rasterizer(threads);
+        std::vector<RasterizedGlyph> results;
+        rasterizer.rasterize(jobs, results);  // Warm up faces and threads
+        
+        auto start = std::chrono::high_resolution_clock::now();
+        rasterizer.rasterize(jobs, results);
+        auto end = std::chrono::high_resolution_clock::now();
+        
+        for (const RasterizedGlyph& glyph : results) EXPECT_TRUE(glyph.isValid);
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+    
+    const double single = timeBatch(1);
+    const double parallel = timeBatch(4);
+    std::cout << "[GlyphRasterizer] " << jobs.size() << " glyphs: " << single << " ms on 1 thread, "
+              << parallel << " ms on 4 threads" << std::endl;
+}
+
+//==========================================================================================
+// Batch Shaping Tests
+//==========================================================================================
+
+namespace {
+
+/** Track-list style labels: distinct strings at a few sizes and spacings. */
+std::vector<std::string> makeTrackNames(size_t count) {
+    std::vector<std::string> names;
+    for (size_t i = 0; i < count; ++i)
+        names.push_back("Track " + std::to_string(i + 1) + (i % 3 == 0 ? " Vox (Lead)" : i % 3 == 1 ? " Gtr DI" : " Drum Bus"));
+    return names;
+}
+
+void expectSameRun(const ShapedText& a, const ShapedText& b) {
+    ASSERT_EQ(a.glyphs.size(), b.glyphs.size());
+    EXPECT_FLOAT_EQ(a.totalAdvance, b.totalAdvance);
+    EXPECT_FLOAT_EQ(a.totalSize.x, b.totalSize.x);
+    EXPECT_FLOAT_EQ(a.totalSize.y, b.totalSize.y);
+    for (size_t g = 0; g < a.glyphs.size(); ++g) {
+        EXPECT_EQ(a.glyphs[g].glyphIndex, b.glyphs[g].glyphIndex);
+        EXPECT_EQ(a.glyphs[g].cluster, b.glyphs[g].cluster);
+        EXPECT_EQ(a.glyphs[g].fontHandle, b.glyphs[g].fontHandle);
+        EXPECT_FLOAT_EQ(a.glyphs[g].position.x, b.glyphs[g].position.x);
+        EXPECT_FLOAT_EQ(a.glyphs[g].position.y, b.glyphs[g].position.y);
+        EXPECT_FLOAT_EQ(a.glyphs[g].advance, b.glyphs[g].advance);
+    }
+}
+
+} // namespace
+
+TEST_F(TextRendererTest, ShapeTextBatch_MatchesSerialShaping) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    std::vector<std::string> names = makeTrackNames(24);
+    
+    std::vector<TextShapeRequest> requests;
+    for (size_t i = 0; i < names.size(); ++i) {
+        const float spacing = (i % 4 == 0) ? 100.0f : 0.0f;
+        requests.push_back({ names[i].c_str(), static_cast<uint32_t>(names[i].size()), &chain, 11.0f + (i % 3) * 2.5f, spacing });
+    }
+    requests.push_back(requests.front());  // Duplicate is shaped once
+    
+    TextRenderer batched(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(batched.initialize(1.0f));
+    
+    EXPECT_EQ(batched.shapeTextBatch(requests), names.size());
+    EXPECT_EQ(batched.getShapedTextCacheStats().misses, 0u);
+    EXPECT_EQ(batched.getShapedTextCacheStats().entryCount, names.size());
+    
+    // Everything is cached now
+    EXPECT_EQ(batched.shapeTextBatch(requests), 0u);
+    
+    for (const TextShapeRequest& request : requests) {
+        ShapedTextRef fromBatch = batched.shapeText(request.text, chain, request.fontSize, request.letterSpacing);
+        ShapedTextRef serial = m_textRenderer->shapeText(request.text, chain, request.fontSize, request.letterSpacing);
+        expectSameRun(*fromBatch, *serial);
+    }
+    EXPECT_EQ(batched.getShapedTextCacheStats().misses, 0u);
+    EXPECT_EQ(batched.getShapedTextCacheStats().hits, requests.size());
+    
+    batched.destroy();
+}
+
+TEST_F(TextRendererTest, ShapeTextBatch_SmallBatchesAreLeftToShapeText) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    const char* text = "Master";
+    
+    std::vector<TextShapeRequest> requests(Config::Text::PARALLEL_SHAPING_MIN_TEXTS,
+                                           TextShapeRequest{ text, 6, &chain, 12.0f, 0.0f });
+    EXPECT_EQ(m_textRenderer->shapeTextBatch(requests), 0u);
+    EXPECT_EQ(m_textRenderer->getShapedTextCacheStats().entryCount, 0u);
+}
+
+TEST_F(TextRendererTest, CompiledTextIsShapedBeforeEmitting) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    std::vector<std::string> names = makeTrackNames(32);
+    
+    RenderList list;
+    for (size_t i = 0; i < names.size(); ++i)
+        list.drawText(names[i].c_str(), Vec2(4.0f, 12.0f + i * 14.0f), chain, 11.0f, Vec4(1, 1, 1, 1));
+    
+    RenderBatchCompiler compiler(m_textRenderer.get(), nullptr);
+    compiler.compile(list, Vec2(400.0f, 600.0f));
+    
+    // Every string was shaped by the pre-pass, so emitting found them all cached
+    const ShapedTextCacheStats& stats = m_textRenderer->getShapedTextCacheStats();
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.hits, names.size());
+    EXPECT_GT(compiler.getTextVertices().size(), 0u);
+}
+
+TEST_F(TextRendererTest, PerformanceTest_FirstFrameShaping) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    std::vector<std::string> names = makeTrackNames(400);
+    
+    std::vector<TextShapeRequest> requests;
+    for (const std::string& name : names)
+        requests.push_back({ name.c_str(), static_cast<uint32_t>(name.size()), &chain, 12.0f, 0.0f });
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const TextShapeRequest& request : requests)
+        m_textRenderer->shapeText(request.text, chain, request.fontSize, request.letterSpacing);
+    auto serialEnd = std::chrono::high_resolution_clock::now();
+    
+    TextRenderer batched(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(batched.initialize(1.0f));
+    
+    auto batchStart = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(batched.shapeTextBatch(requests), names.size());
+    auto batchEnd = std::chrono::high_resolution_clock::now();
+    
+    std::cout << "[ShapeTextBatch] " << names.size() << " texts: "
+              << std::chrono::duration<double, std::milli>(serialEnd - start).count() << " ms serial, "
+              << std::chrono::duration<double, std::milli>(batchEnd - batchStart).count() << " ms batched" << std::endl;
+    
+    batched.destroy();
+}
+
+//==========================================================================================
+// Distance Field Glyph Tests
+//==========================================================================================
+
+TEST(DistanceFieldTest, SquareEdgeSitsAtHalfValue) {
+    const uint32_t size = 20;
+    const uint32_t spread = Config::GlyphCache::SDF_SPREAD;
+    std::vector<uint8_t> coverage(size * size, 255);
+    
+    std::vector<uint8_t> field;
+    GlyphRasterizer::makeDistanceField(coverage.data(), size, size, spread, field);
+    
+    const uint32_t fieldSize = size + spread * 2;
+    ASSERT_EQ(field.size(), fieldSize * fieldSize);
+    
+    auto at = [&](uint32_t x, uint32_t y) { return static_cast<int>(field[y * fieldSize + x]); };
+    const uint32_t middle = fieldSize / 2;
+    
+    EXPECT_EQ(at(middle, middle), 255);     // More than spread pixels inside
+    EXPECT_EQ(at(0, 0), 0);                 // More than spread pixels outside
+    
+    // The first pixels inside and outside the left edge straddle 128
+    const int inside = at(spread, middle);
+    const int outside = at(spread - 1, middle);
+    EXPECT_GT(inside, 128);
+    EXPECT_LT(outside, 128);
+    EXPECT_NEAR((inside + outside) / 2.0, 127.5, 2.0);
+    
+    // Values fall monotonically moving out of the glyph
+    for (uint32_t x = 1; x <= middle; ++x) EXPECT_GE(at(x, middle), at(x - 1, middle));
+}
+
+TEST_F(GlyphRasterizerTest, DistanceFieldGlyphIsPaddedBySpread) {
+    std::vector<GlyphRasterJob> jobs = makeJobs("H", Config::GlyphCache::SDF_REFERENCE_SIZE);
+    void* face = m_fontManager->getFontFace(m_fontManager->getDefaultFont());
+    
+    RasterizedGlyph coverage;
+    ASSERT_TRUE(GlyphRasterizer::rasterizeGlyph(face, GlyphKey(jobs[0].key.fontHandle, jobs[0].key.glyphIndex,
+                                                               Config::GlyphCache::SDF_REFERENCE_SIZE, 0), coverage));
+    
+    RasterizedGlyph field;
+    ASSERT_TRUE(GlyphRasterizer::rasterizeGlyph(face, GlyphKey(jobs[0].key.fontHandle, jobs[0].key.glyphIndex,
+                                                               Config::GlyphCache::SDF_REFERENCE_SIZE, 0,
+                                                               GlyphFormat::SignedDistance), field));
+    
+    const float spread = static_cast<float>(Config::GlyphCache::SDF_SPREAD);
+    EXPECT_EQ(field.size.x, coverage.size.x + spread * 2);
+    EXPECT_EQ(field.size.y, coverage.size.y + spread * 2);
+    EXPECT_EQ(field.bearing.x, coverage.bearing.x - spread);
+    EXPECT_EQ(field.bearing.y, coverage.bearing.y + spread);
+    EXPECT_FLOAT_EQ(field.advance, coverage.advance);
+    ASSERT_EQ(field.bitmap.size(), static_cast<size_t>(field.size.x * field.size.y));
+    
+    // The padding is far outside; the middle of a stem is a couple of pixels inside
+    EXPECT_EQ(field.bitmap.front(), 0);
+    EXPECT_GT(*std::max_element(field.bitmap.begin(), field.bitmap.end()), 160);
+}
+
+TEST_F(TextRendererTest, DistanceFieldGlyphsNeedBackendSupport) {
+    // The mock backend, like Metal and D3D11, samples every atlas as coverage by default
+    EXPECT_FALSE(m_textRenderer->setGlyphFormat(GlyphFormat::SignedDistance));
+    EXPECT_EQ(m_textRenderer->getGlyphFormat(), GlyphFormat::Coverage);
+    EXPECT_TRUE(m_textRenderer->setGlyphFormat(GlyphFormat::Coverage));
+    
+    ON_CALL(*m_backend, supportsDistanceFieldText()).WillByDefault(Return(true));
+    EXPECT_TRUE(m_textRenderer->setGlyphFormat(GlyphFormat::SignedDistance));
+    EXPECT_EQ(m_textRenderer->getGlyphFormat(), GlyphFormat::SignedDistance);
+}
+
+TEST_F(TextRendererTest, DistanceFieldGlyphsAreSharedAcrossSizes) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    ON_CALL(*m_backend, supportsDistanceFieldText()).WillByDefault(Return(true));
+    ASSERT_TRUE(m_textRenderer->setGlyphFormat(GlyphFormat::SignedDistance));
+    EXPECT_EQ(m_textRenderer->getGlyphFormat(), GlyphFormat::SignedDistance);
+    
+    const float sizes[] = { 9.0f, 14.0f, 36.0f };
+    float firstWidth[3] = {};
+    size_t uploadsAfterFirstSize = 0;
+    
+    for (int i = 0; i < 3; ++i) {
+        ShapedText shaped;
+        m_textRenderer->shapeText("Hello", chain, sizes[i], 0, shaped);
+        
+        std::vector<TextVertex> vertices;
+        std::vector<TextVertexRange> ranges;
+        m_textRenderer->generateTextVertices(shaped, Vec2(0, 0), Vec4(1, 1, 1, 1),
+                                             chain, sizes[i], vertices, ranges);
+        m_textRenderer->flushGlyphUploads();
+        
+        ASSERT_EQ(ranges.size(), 1u);
+        EXPECT_EQ(m_backend->getTextureFormat(ranges[0].atlasTexture), TextureFormat::R8_DistanceField);
+        ASSERT_GE(vertices.size(), 4u);
+        firstWidth[i] = vertices[1].position.x - vertices[0].position.x;
+        
+        if (i == 0) uploadsAfterFirstSize = m_backend->getUpdateCount();
+    }
+    
+    // Later sizes reuse the fields rasterized for the first
+    EXPECT_EQ(m_backend->getUpdateCount(), uploadsAfterFirstSize);
+    
+    // Quads scale with the font size
+    EXPECT_NEAR(firstWidth[1] / firstWidth[0], 14.0f / 9.0f, 1e-3f);
+    EXPECT_NEAR(firstWidth[2] / firstWidth[0], 36.0f / 9.0f, 1e-3f);
+}
+
+//==========================================================================================
+// Text Cache File Tests
+//==========================================================================================
+
+TEST_F(TextRendererTest, TextCache_RoundTripsGlyphsAndRuns) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    const char* const texts[] = { "Audio 1", "Kick", "Snare", "-inf", "+12.0 dB" };
+    const std::string path = ::testing::TempDir() + "yuchen_text_cache_round_trip.bin";
+    const uint32_t atlasSize = Config::GlyphCache::BASE_ATLAS_WIDTH;
+    
+    /** Bytes of every glyph quad's atlas rectangle, in quad order. */
+    auto sampleQuads = [&](TextRenderer& renderer, const char* text, std::vector<TextVertex>& vertices) {
+        ShapedText shaped;
+        renderer.shapeText(text, chain, 13.0f, 0, shaped);
+        std::vector<TextVertexRange> ranges;
+        renderer.generateTextVertices(shaped, Vec2(0, 0), Vec4(1, 1, 1, 1), chain, 13.0f, vertices, ranges);
+        renderer.flushGlyphUploads();
+        
+        std::vector<uint8_t> texels;
+        for (const TextVertexRange& range : ranges) {
+            const std::vector<uint8_t>& pixels = *m_backend->getTextureData(range.atlasTexture);
+            for (uint32_t v = range.firstVertex; v < range.firstVertex + range.vertexCount; v += 4) {
+                const uint32_t x0 = static_cast<uint32_t>(vertices[v].texCoord.x * atlasSize + 0.5f);
+                const uint32_t y0 = static_cast<uint32_t>(vertices[v].texCoord.y * atlasSize + 0.5f);
+                const uint32_t x1 = static_cast<uint32_t>(vertices[v + 3].texCoord.x * atlasSize + 0.5f);
+                const uint32_t y1 = static_cast<uint32_t>(vertices[v + 3].texCoord.y * atlasSize + 0.5f);
+                for (uint32_t y = y0; y < y1; ++y)
+                    texels.insert(texels.end(), pixels.begin() + y * atlasSize + x0, pixels.begin() + y * atlasSize + x1);
+            }
+        }
+        return texels;
+    };
+    
+    std::vector<std::vector<TextVertex>> expectedVertices(std::size(texts));
+    std::vector<std::vector<uint8_t>> expectedTexels;
+    for (size_t i = 0; i < std::size(texts); ++i)
+        expectedTexels.push_back(sampleQuads(*m_textRenderer, texts[i], expectedVertices[i]));
+    ASSERT_TRUE(m_textRenderer->saveCache(path.c_str()));
+    
+    TextRenderer warm(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(warm.initialize(1.0f));
+    m_backend->resetCounters();
+    
+    EXPECT_GE(warm.loadCache(path.c_str()), std::size(texts));
+    EXPECT_EQ(m_backend->getUpdateCount(), 1u);  // One upload for the whole atlas
+    std::remove(path.c_str());
+    
+    // Every text is a cache hit, every glyph is already in the atlas, and the quads
+    // sample the same bitmaps, wherever loading packed them
+    for (size_t i = 0; i < std::size(texts); ++i) {
+        std::vector<TextVertex> vertices;
+        EXPECT_TRUE(sampleQuads(warm, texts[i], vertices) == expectedTexels[i]) << texts[i];
+        
+        ASSERT_EQ(vertices.size(), expectedVertices[i].size()) << texts[i];
+        for (size_t v = 0; v < vertices.size(); ++v)
+            EXPECT_EQ(vertices[v].position, expectedVertices[i][v].position);
+    }
+    EXPECT_EQ(warm.getShapedTextCacheStats().misses, 0u);
+    EXPECT_EQ(warm.getGlyphUploadStats().uploadCount, 1u);  // Only the one made by loadCache()
+    
+    warm.destroy();
+}
+
+TEST_F(TextRendererTest, TextCache_IgnoresStaleOrCorruptFiles) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    const std::string path = ::testing::TempDir() + "yuchen_text_cache_stale.bin";
+    
+    ShapedText shaped;
+    m_textRenderer->shapeText("Master", chain, 12.0f, 0, shaped);
+    std::vector<TextVertex> vertices;
+    m_textRenderer->generateTextVertices(shaped, Vec2(0, 0), Vec4(1, 1, 1, 1), chain, 12.0f, vertices);
+    ASSERT_TRUE(m_textRenderer->saveCache(path.c_str()));
+    
+    // Another DPI scale
+    TextRenderer hiDpi(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(hiDpi.initialize(2.0f));
+    EXPECT_EQ(hiDpi.loadCache(path.c_str()), 0u);
+    hiDpi.destroy();
+    
+    // One flipped payload byte
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(bytes.size(), 64u);
+    bytes[bytes.size() / 2] ^= 0x5a;
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    
+    TextRenderer corrupt(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(corrupt.initialize(1.0f));
+    EXPECT_EQ(corrupt.loadCache(path.c_str()), 0u);
+    corrupt.destroy();
+    
+    std::remove(path.c_str());
+    EXPECT_EQ(m_textRenderer->loadCache(path.c_str()), 0u);  // Missing file
+}
+
+//==========================================================================================
+// Glyph Warm-up Tests
+//==========================================================================================
+
+TEST_F(GlyphCacheTest, PinnedGlyphsSurvivePeriodicExpiry) {
+    std::vector<uint8_t> bitmap(16 * 16, 128);
+    GlyphKey pinned(1, 65, 12.0f);
+    GlyphKey unpinned(1, 66, 12.0f);
+    
+    m_glyphCache->cacheGlyph(pinned, bitmap.data(), Vec2(16, 16), Vec2(0, 12), 8.0f);
+    m_glyphCache->cacheGlyph(unpinned, bitmap.data(), Vec2(16, 16), Vec2(0, 12), 8.0f);
+    EXPECT_TRUE(m_glyphCache->pinGlyph(pinned));
+    EXPECT_FALSE(m_glyphCache->pinGlyph(GlyphKey(1, 67, 12.0f)));
+    
+    const uint32_t frames = Config::GlyphCache::GLYPH_EXPIRE_FRAMES + Config::GlyphCache::CLEANUP_INTERVAL_FRAMES + 1;
+    for (uint32_t i = 0; i < frames; ++i) m_glyphCache->beginFrame();
+    
+    EXPECT_EQ(m_glyphCache->getGlyphCount(), 1u);
+    EXPECT_EQ(m_glyphCache->getGlyph(unpinned), nullptr);
+    
+    // First use ends the pin; unused from then on, the glyph expires
+    EXPECT_NE(m_glyphCache->getGlyph(pinned), nullptr);
+    for (uint32_t i = 0; i < frames; ++i) m_glyphCache->beginFrame();
+    EXPECT_EQ(m_glyphCache->getGlyph(pinned), nullptr);
+}
+
+TEST_F(TextRendererTest, Prewarm_CachesGlyphsInFrameSlices) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    std::vector<uint32_t> ascii;
+    for (uint32_t c = 0x21; c <= 0x7E; ++c) ascii.push_back(c);
+    
+    const size_t queued = m_textRenderer->prewarm(chain, { 11.0f, 12.0f }, ascii);
+    EXPECT_GT(queued, Config::Text::PREWARM_GLYPHS_PER_FRAME);
+    EXPECT_EQ(m_textRenderer->getPrewarmProgress().glyphsQueued, queued);
+    EXPECT_TRUE(m_textRenderer->hasPendingGlyphs());
+    
+    // Queuing the same set again adds nothing
+    EXPECT_EQ(m_textRenderer->prewarm(chain, { 12.0f }, ascii), 0u);
+    
+    size_t frames = 0;
+    size_t lastCached = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (m_textRenderer->hasPendingGlyphs() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        m_textRenderer->beginFrame();
+        ++frames;
+        
+        const size_t cached = m_textRenderer->getPrewarmProgress().glyphsCached;
+        EXPECT_LE(cached - lastCached, Config::Text::PREWARM_GLYPHS_PER_FRAME);
+        lastCached = cached;
+    }
+    ASSERT_FALSE(m_textRenderer->hasPendingGlyphs());
+    EXPECT_TRUE(m_textRenderer->getPrewarmProgress().isComplete());
+    EXPECT_FLOAT_EQ(m_textRenderer->getPrewarmProgress().getFraction(), 1.0f);
+    EXPECT_GE(frames, (queued + Config::Text::PREWARM_GLYPHS_PER_FRAME - 1) / Config::Text::PREWARM_GLYPHS_PER_FRAME);
+    
+    // Prewarmed text draws without rasterizing or uploading anything
+    m_textRenderer->flushGlyphUploads();
+    m_textRenderer->resetGlyphUploadStats();
+    
+    ShapedText shaped;
+    m_textRenderer->shapeText("Gain -12.5 dB", chain, 12.0f, 0, shaped);
+    std::vector<TextVertex> vertices;
+    m_textRenderer->generateTextVertices(shaped, Vec2(0, 20), Vec4(1, 1, 1, 1), chain, 12.0f, vertices);
+    m_textRenderer->flushGlyphUploads();
+    
+    EXPECT_EQ(vertices.size(), 11u * 4u);  // Every glyph but the two spaces
+    EXPECT_EQ(m_textRenderer->getGlyphUploadStats().uploadCount, 0u);
+}
+
+TEST_F(TextRendererTest, Prewarm_StringsAreShapedAndUsableAtOnce) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    std::vector<std::string> names = makeTrackNames(8);
+    
+    EXPECT_GT(m_textRenderer->prewarm(chain, { 11.0f }, names), 0u);
+    EXPECT_EQ(m_textRenderer->getPrewarmProgress().runsShaped, names.size());
+    EXPECT_EQ(m_textRenderer->getShapedTextCacheStats().misses, 0u);
+    
+    // Drawn before any slice ran: glyphs still in flight are rasterized by the draw
+    ShapedTextRef run = m_textRenderer->shapeText(names[0].c_str(), chain, 11.0f, 0.0f);
+    EXPECT_EQ(m_textRenderer->getShapedTextCacheStats().misses, 0u);
+    EXPECT_EQ(m_textRenderer->getShapedTextCacheStats().hits, 1u);
+    
+    ShapedText expected;
+    TextRenderer cold(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(cold.initialize(1.0f));
+    cold.shapeText(names[0].c_str(), chain, 11.0f, 0.0f, expected);
+    
+    std::vector<TextVertex> vertices;
+    std::vector<TextVertex> expectedVertices;
+    m_textRenderer->generateTextVertices(*run, Vec2(0, 20), Vec4(1, 1, 1, 1), chain, 11.0f, vertices);
+    cold.generateTextVertices(expected, Vec2(0, 20), Vec4(1, 1, 1, 1), chain, 11.0f, expectedVertices);
+    ASSERT_EQ(vertices.size(), expectedVertices.size());
+    for (size_t i = 0; i < vertices.size(); ++i)
+        EXPECT_EQ(vertices[i].position, expectedVertices[i].position);
+    cold.destroy();
+    
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (m_textRenderer->hasPendingGlyphs() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        m_textRenderer->beginFrame();
+    }
+    EXPECT_TRUE(m_textRenderer->getPrewarmProgress().isComplete());
+    
+    m_textRenderer->resetPrewarmProgress();
+    EXPECT_EQ(m_textRenderer->getPrewarmProgress().glyphsQueued, 0u);
+    EXPECT_TRUE(m_textRenderer->getPrewarmProgress().isComplete());
+}
+
+TEST_F(TextRendererTest, PerformanceTest_PrewarmedFirstDraw) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    std::vector<std::string> names = makeTrackNames(64);
+    const std::vector<float> sizes = { 10.0f, 11.0f, 12.0f, 14.0f };
+    
+    std::vector<TextVertex> vertices;
+    auto drawAll = [&](TextRenderer& renderer) {
+        for (float size : sizes)
+            for (const std::string& name : names)
+            {
+                ShapedTextRef run = renderer.shapeText(name.c_str(), chain, size, 0.0f);
+                renderer.generateTextVertices(*run, Vec2(0, 20), Vec4(1, 1, 1, 1), chain, size, vertices);
+            }
+        renderer.flushGlyphUploads();
+    };
+    
+    auto coldStart = std::chrono::high_resolution_clock::now();
+    drawAll(*m_textRenderer);
+    auto coldEnd = std::chrono::high_resolution_clock::now();
+    
+    TextRenderer warm(m_backend.get(), m_fontManager.get());
+    ASSERT_TRUE(warm.initialize(1.0f));
+    const size_t queued = warm.prewarm(chain, sizes, names);
+    
+    double worstSlice = 0.0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (warm.hasPendingGlyphs() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        auto sliceStart = std::chrono::high_resolution_clock::now();
+        warm.beginFrame();
+        auto sliceEnd = std::chrono::high_resolution_clock::now();
+        worstSlice = std::max(worstSlice, std::chrono::duration<double, std::milli>(sliceEnd - sliceStart).count());
+    }
+    EXPECT_TRUE(warm.getPrewarmProgress().isComplete());
+    
+    auto warmStart = std::chrono::high_resolution_clock::now();
+    drawAll(warm);
+    auto warmEnd = std::chrono::high_resolution_clock::now();
+    
+    std::cout << "[Prewarm] " << queued << " glyphs: first draw "
+              << std::chrono::duration<double, std::milli>(coldEnd - coldStart).count() << " ms cold, "
+              << std::chrono::duration<double, std::milli>(warmEnd - warmStart).count() << " ms warm, worst slice "
+              << worstSlice << " ms" << std::endl;
+    
+    warm.destroy();
+}
+
 //==========================================================================================
 // Memory Leak / Growth Tests - CRITICAL
 //==========================================================================================
@@ -908,7 +2569,7 @@ protected:
             .WillByDefault(Return(1.0f));
         
         m_fontManager = std::make_unique<FontManager>();
-        ASSERT_TRUE(m_fontManager->initialize());
+        ASSERT_TRUE(m_fontManager->initialize(Testing::getEmbeddedResourceResolver()));
         
         m_textRenderer = std::make_unique<TextRenderer>(m_backend.get(),
                                                          m_fontManager.get());
@@ -951,20 +2612,26 @@ TEST_F(MemoryLeakTest, DISABLED_ShapedTextCache_DynamicText) {
     SUCCEED(); // Placeholder - real test would check memory
 }
 
-TEST_F(MemoryLeakTest, DISABLED_GlyphAvailabilityCache_Growth) {
+TEST_F(MemoryLeakTest, GlyphAvailabilityCache_Growth) {
     // CRITICAL: Tests hasGlyph() cache growth
     
     FontHandle arial = m_fontManager->getDefaultFont();
+    const FontCoverage& coverage = *m_fontManager->getFontEntry(arial)->coverage;
     
     // Check 10000 different characters
     for (uint32_t i = 0x0020; i < 0x0020 + 10000; ++i) {
         m_fontManager->hasGlyph(arial, i);
     }
+    const size_t usage = coverage.getMemoryUsage();
     
-    // TODO: After fix, verify cache size is bounded
-    // Current: m_glyphAvailabilityCache grows unbounded
+    // Coverage is bounded by the blocks touched, not the codepoints asked
+    EXPECT_LE(coverage.getReadBlockCount(), 3u);
+    EXPECT_LE(usage, 3 * FontCoverage::BLOCK_SIZE / 8);
     
-    SUCCEED();
+    for (uint32_t i = 0x0020; i < 0x0020 + 10000; ++i) {
+        m_fontManager->hasGlyph(arial, i);
+    }
+    EXPECT_EQ(coverage.getMemoryUsage(), usage);
 }
 
 TEST_F(MemoryLeakTest, DISABLED_MeasureTextCache_Growth) {
@@ -0,0 +1,310 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - RenderBatchCompiler Unit Tests
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Tests for batch merging, painter's order preservation, clip handling and culling in
+** the backend-agnostic RenderBatchCompiler.
+**
+********************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "YuchenUI/rendering/RenderBatchCompiler.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/rendering/IGraphicsBackend.h"
+#include "YuchenUI/resource/IResourceResolver.h"
+#include "YuchenUI/image/TextureCache.h"
+#include "YuchenUI/core/Config.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace YuchenUI;
+
+namespace {
+
+//==========================================================================================
+// Test Doubles
+//==========================================================================================
+
+class MockGraphicsBackend : public IGraphicsBackend {
+public:
+    bool initialize(void*, int, int, float, IFontProvider*, IResourceResolver*) override { return true; }
+    void resize(int, int) override {}
+    void beginFrame() override {}
+    void endFrame() override {}
+    void executeRenderCommands(const RenderList&) override {}
+
+    void* createTexture2D(uint32_t, uint32_t, TextureFormat) override
+    {
+        return reinterpret_cast<void*>(static_cast<uintptr_t>(++m_nextHandle));
+    }
+    void updateTexture2D(void*, uint32_t, uint32_t, uint32_t, uint32_t, const void*, size_t) override {}
+    void destroyTexture(void*) override {}
+
+    Vec2 getRenderSize() const override { return Vec2(800, 600); }
+    float getDPIScale() const override { return 1.0f; }
+
+private:
+    uintptr_t m_nextHandle = 0x1000;
+};
+
+/** Serves the same 2x2 RGBA PNG for every path. */
+class MockResolver : public IResourceResolver {
+public:
+    MockResolver()
+    {
+        m_data.data = PNG_2X2;
+        m_data.size = sizeof(PNG_2X2);
+        m_data.designScale = 1.0f;
+    }
+
+    const Resources::ResourceData* find(const char*, const char*) override { return &m_data; }
+
+private:
+    static constexpr unsigned char PNG_2X2[] = {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48,
+        0x44, 0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x06, 0x00, 0x00,
+        0x00, 0x72, 0xb6, 0x0d, 0x24, 0x00, 0x00, 0x00, 0x11, 0x49, 0x44, 0x41, 0x54, 0x78,
+        0x9c, 0x63, 0xf8, 0xcf, 0xc0, 0xf0, 0x1f, 0x84, 0x19, 0x60, 0x0c, 0x00, 0x47, 0xca,
+        0x07, 0xf9, 0x67, 0x59, 0x6e, 0xb7, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+        0xae, 0x42, 0x60, 0x82
+    };
+
+    Resources::ResourceData m_data;
+};
+
+constexpr unsigned char MockResolver::PNG_2X2[];
+
+const Vec2 VIEWPORT(800, 600);
+const Vec4 RED(1, 0, 0, 1);
+const Vec4 GREEN(0, 1, 0, 1);
+
+} // namespace
+
+//==========================================================================================
+// Merging and Ordering
+//==========================================================================================
+
+TEST(RenderBatchCompilerTest, OverlappingCommandsKeepPainterOrder) {
+    RenderList list;
+    list.fillRect(Rect(0, 0, 100, 100), RED);
+    list.drawLine(Vec2(0, 50), Vec2(100, 50), GREEN, 2.0f);
+    list.fillRect(Rect(10, 10, 50, 50), GREEN);
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    const auto& batches = compiler.getBatches();
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[0].pipeline, ActivePipeline::Rect);
+    EXPECT_EQ(batches[1].pipeline, ActivePipeline::Shape);
+    EXPECT_EQ(batches[2].pipeline, ActivePipeline::Rect);
+    EXPECT_EQ(compiler.getStats().reorderedCommands, 0u);
+}
+
+TEST(RenderBatchCompilerTest, DisjointCommandsMergeAcrossPipelines) {
+    RenderList list;
+    list.fillRect(Rect(0, 0, 10, 10), RED);
+    list.drawLine(Vec2(100, 100), Vec2(200, 100), GREEN, 1.0f);
+    list.fillRect(Rect(20, 0, 10, 10), RED);
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    const auto& batches = compiler.getBatches();
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[0].pipeline, ActivePipeline::Rect);
+    EXPECT_EQ(batches[0].commandCount, 2u);
+    EXPECT_EQ(batches[0].firstVertex, 0u);
+    EXPECT_EQ(batches[0].vertexCount, static_cast<uint32_t>(compiler.getRectVertices().size()));
+    EXPECT_EQ(batches[1].pipeline, ActivePipeline::Shape);
+    EXPECT_EQ(compiler.getStats().reorderedCommands, 1u);
+}
+
+TEST(RenderBatchCompilerTest, ReorderedVerticesStayContiguous) {
+    RenderList list;
+    list.fillRect(Rect(0, 0, 10, 10), RED);
+    list.pushClipRect(Rect(300, 300, 100, 100));
+    list.fillRect(Rect(300, 300, 10, 10), GREEN);
+    list.popClipRect();
+    list.fillRect(Rect(20, 0, 10, 10), RED);
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    const auto& batches = compiler.getBatches();
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_FALSE(batches[0].hasClip);
+    EXPECT_EQ(batches[0].commandCount, 2u);
+    EXPECT_TRUE(batches[1].hasClip);
+    EXPECT_EQ(batches[1].firstVertex, batches[0].vertexCount);
+
+    // Both red rects come first in the stream, the clipped green one last
+    const auto& vertices = compiler.getRectVertices();
+    for (uint32_t i = 0; i < batches[0].vertexCount; ++i)
+        EXPECT_EQ(vertices[i].color, RED);
+    for (uint32_t i = 0; i < batches[1].vertexCount; ++i)
+        EXPECT_EQ(vertices[batches[1].firstVertex + i].color, GREEN);
+}
+
+TEST(RenderBatchCompilerTest, GradientRectEmitsOneQuadPerSegment) {
+    const GradientStop stops[] = { { 0.25f, RED }, { 0.5f, GREEN }, { 0.5f, RED }, { 1.0f, GREEN } };
+    RenderList list;
+    list.fillGradientRect(Rect(0, 0, 100, 10), stops, 4, GradientDirection::Horizontal);
+    list.fillRect(Rect(200, 0, 10, 10), RED);
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    // Padding before the first stop, two ramps; the zero-length segment is dropped
+    const auto& batches = compiler.getBatches();
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0].commandCount, 2u);
+    EXPECT_EQ(batches[0].vertexCount, 4u * 6u);
+
+    // Quads are (L,T), (L,B), (R,B), (L,T), (R,B), (R,T) and all carry the whole rect
+    const auto& vertices = compiler.getRectVertices();
+    for (uint32_t i = 0; i < 18; ++i)
+    {
+        EXPECT_EQ(vertices[i].rectOrigin, Vec2(0, 0));
+        EXPECT_EQ(vertices[i].rectSize, Vec2(100, 10));
+    }
+    EXPECT_EQ(vertices[0].color, RED);
+    EXPECT_EQ(vertices[5].color, RED);
+    EXPECT_EQ(vertices[6].color, RED);
+    EXPECT_EQ(vertices[11].color, GREEN);
+    EXPECT_EQ(vertices[12].color, RED);
+    EXPECT_EQ(vertices[17].color, GREEN);
+    EXPECT_FLOAT_EQ(vertices[5].position.x, vertices[6].position.x);
+    EXPECT_FLOAT_EQ(vertices[11].position.x, vertices[12].position.x);
+}
+
+//==========================================================================================
+// Clipping and Culling
+//==========================================================================================
+
+TEST(RenderBatchCompilerTest, NestedClipsIntersect) {
+    RenderList list;
+    list.pushClipRect(Rect(0, 0, 100, 100));
+    list.pushClipRect(Rect(50, 50, 100, 100));
+    list.fillRect(Rect(0, 0, 200, 200), RED);
+    list.popClipRect();
+    list.popClipRect();
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    const auto& batches = compiler.getBatches();
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_TRUE(batches[0].hasClip);
+    EXPECT_EQ(batches[0].clipRect, Rect(50, 50, 50, 50));
+}
+
+TEST(RenderBatchCompilerTest, FullyClippedCommandsAreCulled) {
+    RenderList list;
+    list.pushClipRect(Rect(0, 0, 100, 100));
+    list.fillRect(Rect(200, 200, 10, 10), RED);
+    list.fillRect(Rect(10, 10, 10, 10), RED);
+    list.popClipRect();
+    list.fillRect(Rect(1000, 1000, 10, 10), RED);
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    EXPECT_EQ(compiler.getBatches().size(), 1u);
+    EXPECT_EQ(compiler.getStats().drawCommands, 3u);
+    EXPECT_EQ(compiler.getStats().culledCommands, 2u);
+}
+
+TEST(RenderBatchCompilerTest, TextIsCulledWithoutRenderer) {
+    RenderList list;
+    FontFallbackChain chain(1);
+    list.drawText("-12.5 dB", Vec2(10, 10), chain, 11.0f, GREEN);
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    EXPECT_TRUE(compiler.getBatches().empty());
+    EXPECT_EQ(compiler.getStats().culledCommands, 1u);
+}
+
+TEST(RenderBatchCompilerTest, ReportsClearColor) {
+    RenderList list;
+    list.clear(Vec4(0.1f, 0.2f, 0.3f, 1.0f));
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    compiler.compile(list, VIEWPORT);
+
+    EXPECT_TRUE(compiler.hasClearColor());
+    EXPECT_EQ(compiler.getClearColor(), Vec4(0.1f, 0.2f, 0.3f, 1.0f));
+    EXPECT_TRUE(compiler.getBatches().empty());
+}
+
+//==========================================================================================
+// Images
+//==========================================================================================
+
+TEST(RenderBatchCompilerTest, ImagesBatchByTextureAndSampler) {
+    MockGraphicsBackend backend;
+    MockResolver resolver;
+    TextureCache textureCache(&backend, &resolver);
+    ASSERT_TRUE(textureCache.initialize());
+
+    RenderList list;
+    list.drawImage("app", "a.png", Rect(0, 0, 16, 16));
+    list.drawImage("app", "a.png", Rect(20, 0, 16, 16));
+    list.drawImage("app", "b.png", Rect(40, 0, 16, 16));
+    list.drawImage("app", "b.png", Rect(60, 0, 16, 16), ScaleMode::Tile);
+
+    RenderBatchCompiler compiler(nullptr, &textureCache);
+    compiler.compile(list, VIEWPORT);
+
+    const auto& batches = compiler.getBatches();
+    ASSERT_EQ(batches.size(), 3u);
+    EXPECT_EQ(batches[0].pipeline, ActivePipeline::Image);
+    EXPECT_EQ(batches[0].commandCount, 2u);
+    EXPECT_NE(batches[0].texture, batches[1].texture);
+    EXPECT_FALSE(batches[1].repeatSampler);
+    EXPECT_TRUE(batches[2].repeatSampler);
+    EXPECT_EQ(batches[1].texture, batches[2].texture);
+}
+
+//==========================================================================================
+// Performance
+//==========================================================================================
+
+TEST(RenderBatchCompilerPerformanceTest, CompileMixerSizedFrame) {
+    RenderList list;
+    const int channels = 48;
+    const int segmentsPerMeter = 200;
+
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        float x = static_cast<float>(ch * 16);
+        list.pushClipRect(Rect(x, 0, 16, 600));
+        list.fillRect(Rect(x, 0, 16, 600), Vec4(0.15f, 0.15f, 0.15f, 1), CornerRadius(2.0f));
+        for (int i = 0; i < segmentsPerMeter; ++i)
+            list.fillRect(Rect(x + 2, static_cast<float>(i * 3), 5, 2), Vec4(0.2f, 0.8f, 0.2f, 1));
+        list.drawLine(Vec2(x, 100), Vec2(x + 16, 100), Vec4(1, 1, 1, 1), 1.0f);
+        list.popClipRect();
+    }
+
+    RenderBatchCompiler compiler(nullptr, nullptr);
+    const int iterations = 100;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < iterations; ++frame)
+        compiler.compile(list, VIEWPORT);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double avgMs = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    std::cout << "\n[RenderBatchCompiler] " << list.getCommandCount() << " commands/frame: "
+              << avgMs << " ms/frame, " << compiler.getStats().batchCount << " batches" << std::endl;
+
+    EXPECT_EQ(compiler.getStats().batchCount, static_cast<size_t>(channels * 2));
+}
@@ -0,0 +1,418 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - RenderList Unit Tests
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Tests for command recording, the compact RenderCommand encoding and the per-list
+** RenderArena that owns text and font chain data.
+**
+********************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/rendering/RenderArena.h"
+#include "YuchenUI/core/Config.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace YuchenUI;
+
+//==========================================================================================
+// Command Encoding
+//==========================================================================================
+
+TEST(RenderCommandTest, IsCompactAndTriviallyCopyable) {
+    EXPECT_TRUE(std::is_trivially_copyable<RenderCommand>::value);
+    EXPECT_LE(sizeof(RenderCommand), 96u);
+}
+
+TEST(RenderListTest, RecordsRectPayload) {
+    RenderList list;
+    list.fillRect(Rect(10, 20, 30, 40), Vec4(1, 0, 0, 1), CornerRadius(4.0f));
+    list.drawRect(Rect(0, 0, 20, 20), Vec4(0, 1, 0, 1), 2.0f);
+
+    const auto& commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 2u);
+
+    EXPECT_EQ(commands[0].type, RenderCommandType::FillRect);
+    EXPECT_EQ(commands[0].rectangle.rect, Rect(10, 20, 30, 40));
+    EXPECT_EQ(commands[0].rectangle.color, Vec4(1, 0, 0, 1));
+    EXPECT_FLOAT_EQ(commands[0].rectangle.cornerRadius.topLeft, 4.0f);
+    EXPECT_FLOAT_EQ(commands[0].rectangle.borderWidth, 0.0f);
+
+    EXPECT_EQ(commands[1].type, RenderCommandType::DrawRect);
+    EXPECT_FLOAT_EQ(commands[1].rectangle.borderWidth, 2.0f);
+}
+
+TEST(RenderListTest, GradientStopsAreCopiedIntoArena) {
+    GradientStop stops[] = { { 0.0f, Vec4(0, 0, 0, 1) }, { 0.5f, Vec4(1, 1, 1, 1) }, { 1.0f, Vec4(0, 0, 0, 1) } };
+    RenderList list;
+    list.fillGradientRect(Rect(10, 20, 8, 200), stops, 3, GradientDirection::Horizontal);
+    list.fillGradientRect(Rect(0, 0, 40, 10), Vec4(1, 0, 0, 1), Vec4(0, 0, 1, 1),
+                          GradientDirection::Vertical, CornerRadius(2.0f));
+    stops[1].color = Vec4(1, 0, 0, 1);
+
+    const auto& commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 2u);
+
+    const auto& g = commands[0].gradient;
+    EXPECT_EQ(commands[0].type, RenderCommandType::FillGradientRect);
+    EXPECT_EQ(g.rect, Rect(10, 20, 8, 200));
+    EXPECT_EQ(g.direction, GradientDirection::Horizontal);
+    ASSERT_EQ(g.stopCount, 3u);
+    EXPECT_NE(g.stops, stops);
+    EXPECT_EQ(g.stops[1].color, Vec4(1, 1, 1, 1));
+    EXPECT_FLOAT_EQ(g.stops[1].position, 0.5f);
+
+    const auto& two = commands[1].gradient;
+    EXPECT_EQ(two.direction, GradientDirection::Vertical);
+    ASSERT_EQ(two.stopCount, 2u);
+    EXPECT_EQ(two.stops[0].color, Vec4(1, 0, 0, 1));
+    EXPECT_EQ(two.stops[1].color, Vec4(0, 0, 1, 1));
+    EXPECT_FLOAT_EQ(two.cornerRadius.topLeft, 2.0f);
+
+    RenderList replay;
+    replay.append(list, Vec2(5, 5));
+    list.reset();
+    EXPECT_EQ(replay.getCommands()[0].gradient.rect, Rect(15, 25, 8, 200));
+    EXPECT_EQ(replay.getCommands()[0].gradient.stops[2].color, Vec4(0, 0, 0, 1));
+    EXPECT_TRUE(replay.validate());
+}
+
+TEST(RenderListTest, TextIsCopiedIntoArena) {
+    RenderList list;
+    FontFallbackChain chain(1, 2);
+
+    std::string text = "Hello 世界";
+    list.drawText(text.c_str(), Vec2(5, 6), chain, 12.0f, Vec4(1, 1, 1, 1), 50.0f);
+    text.assign("overwritten");
+
+    const auto& cmd = list.getCommands().front();
+    ASSERT_EQ(cmd.type, RenderCommandType::DrawText);
+    EXPECT_STREQ(cmd.text.utf8, "Hello 世界");
+    EXPECT_EQ(cmd.text.length, std::strlen("Hello 世界"));
+    EXPECT_EQ(cmd.text.position, Vec2(5, 6));
+    EXPECT_FLOAT_EQ(cmd.text.fontSize, 12.0f);
+    EXPECT_FLOAT_EQ(cmd.text.letterSpacing, 50.0f);
+    ASSERT_NE(cmd.text.fontChain, nullptr);
+    EXPECT_EQ(cmd.text.fontChain->size(), 2u);
+    EXPECT_EQ(cmd.text.fontChain->getFont(1), FontHandle(2));
+}
+
+TEST(RenderListTest, IdenticalFontChainsShareStorage) {
+    RenderList list;
+    FontFallbackChain chainA(1, 2);
+    FontFallbackChain chainB(3);
+
+    list.drawText("a", Vec2(0, 0), chainA, 12.0f, Vec4());
+    list.drawText("b", Vec2(0, 0), chainA, 12.0f, Vec4());
+    list.drawText("c", Vec2(0, 0), chainB, 12.0f, Vec4());
+    list.drawText("d", Vec2(0, 0), chainA, 12.0f, Vec4());
+
+    const auto& commands = list.getCommands();
+    EXPECT_EQ(commands[0].text.fontChain, commands[1].text.fontChain);
+    EXPECT_EQ(commands[0].text.fontChain, commands[3].text.fontChain);
+    EXPECT_NE(commands[0].text.fontChain, commands[2].text.fontChain);
+    EXPECT_EQ(list.getArena().getFontChainCount(), 2u);
+}
+
+TEST(RenderListTest, ImagePathsAreCopiedIntoArena) {
+    RenderList list;
+    list.drawImage("app", "icons/mute.png", Rect(0, 0, 16, 16), ScaleMode::NineSlice,
+                   NineSliceMargins(2, 2, 2, 2));
+    list.drawImageRegion("app", "sprites.png", Rect(0, 0, 8, 8), Rect(8, 0, 8, 8));
+
+    const auto& commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 2u);
+    EXPECT_STREQ(commands[0].image.resourceNamespace, "app");
+    EXPECT_STREQ(commands[0].image.resourcePath, "icons/mute.png");
+    EXPECT_EQ(commands[0].image.scaleMode, ScaleMode::NineSlice);
+    EXPECT_FLOAT_EQ(commands[0].image.nineSliceMargins.left, 2.0f);
+    EXPECT_EQ(commands[1].image.sourceRect, Rect(8, 0, 8, 8));
+}
+
+TEST(RenderListTest, ClipCommandsCarryRect) {
+    RenderList list;
+    list.pushClipRect(Rect(1, 2, 3, 4));
+    list.fillRect(Rect(0, 0, 10, 10), Vec4());
+    list.popClipRect();
+
+    const auto& commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 3u);
+    EXPECT_EQ(commands[0].type, RenderCommandType::PushClip);
+    EXPECT_EQ(commands[0].clip.rect, Rect(1, 2, 3, 4));
+    EXPECT_EQ(commands[2].type, RenderCommandType::PopClip);
+    EXPECT_TRUE(list.validate());
+}
+
+TEST(RenderListTest, AppendTranslatesAndOwnsArenaData) {
+    FontFallbackChain chain(1, 2);
+    RenderList list;
+    {
+        RenderList cached(4, 64);
+        cached.pushClipRect(Rect(0, 0, 40, 20));
+        cached.fillRect(Rect(1, 2, 10, 10), Vec4(1, 0, 0, 1));
+        cached.drawText("Mute", Vec2(3, 14), chain, 11.0f, Vec4(1, 1, 1, 1));
+        cached.drawImage("app", "knob.png", Rect(0, 0, 20, 20));
+        cached.drawLine(Vec2(0, 0), Vec2(5, 5), Vec4(0, 1, 0, 1));
+        cached.fillCircle(Vec2(10, 10), 4.0f, Vec4(0, 0, 1, 1));
+        cached.popClipRect();
+
+        list.append(cached, Vec2(100, 50));
+        list.append(cached, Vec2(200, 50));
+    }
+
+    const auto& commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 14u);
+    EXPECT_EQ(commands[0].clip.rect, Rect(100, 50, 40, 20));
+    EXPECT_EQ(commands[1].rectangle.rect, Rect(101, 52, 10, 10));
+    EXPECT_EQ(commands[2].text.position, Vec2(103, 64));
+    EXPECT_STREQ(commands[2].text.utf8, "Mute");
+    EXPECT_EQ(commands[2].text.fontChain->size(), 2u);
+    EXPECT_STREQ(commands[3].image.resourcePath, "knob.png");
+    EXPECT_EQ(commands[3].image.destRect, Rect(100, 50, 20, 20));
+    EXPECT_EQ(commands[4].line.end, Vec2(105, 55));
+    EXPECT_EQ(commands[5].circle.center, Vec2(110, 60));
+    EXPECT_EQ(commands[8].rectangle.rect, Rect(201, 52, 10, 10));
+    EXPECT_EQ(commands[2].text.fontChain, commands[9].text.fontChain);
+    EXPECT_TRUE(list.validate());
+}
+
+TEST(RenderListTest, FingerprintMatchesIdenticalStreams) {
+    FontFallbackChain chain(1, 2);
+    auto record = [&](RenderList& list, const char* caption, float x) {
+        list.clear(Vec4(0, 0, 0, 1));
+        list.pushClipRect(Rect(0, 0, 100, 40));
+        list.fillRect(Rect(x, 2, 10, 10), Vec4(1, 0, 0, 1), CornerRadius(2.0f));
+        list.drawText(caption, Vec2(3, 14), chain, 11.0f, Vec4(1, 1, 1, 1));
+        list.drawImage("app", "knob.png", Rect(0, 0, 20, 20));
+        list.popClipRect();
+    };
+
+    RenderList a;
+    RenderList b(8, 64);
+    record(a, "Mute", 1.0f);
+    record(b, "Mute", 1.0f);
+    EXPECT_EQ(a.getFingerprint(), b.getFingerprint());
+
+    RenderList text;
+    record(text, "Solo", 1.0f);
+    EXPECT_NE(a.getFingerprint(), text.getFingerprint());
+
+    RenderList moved;
+    record(moved, "Mute", 1.5f);
+    EXPECT_NE(a.getFingerprint(), moved.getFingerprint());
+
+    // Replayed commands hash like directly recorded ones
+    RenderList replayed;
+    replayed.append(a);
+    EXPECT_EQ(a.getFingerprint(), replayed.getFingerprint());
+
+    const uint64_t recorded = a.getFingerprint();
+    a.reset();
+    EXPECT_EQ(a.getFingerprint(), RenderList().getFingerprint());
+    record(a, "Mute", 1.0f);
+    EXPECT_EQ(a.getFingerprint(), recorded);
+}
+
+TEST(RenderListTest, FingerprintIsOrderSensitive) {
+    RenderList a;
+    a.fillRect(Rect(0, 0, 10, 10), Vec4(1, 0, 0, 1));
+    a.fillRect(Rect(5, 5, 10, 10), Vec4(0, 1, 0, 1));
+
+    RenderList b;
+    b.fillRect(Rect(5, 5, 10, 10), Vec4(0, 1, 0, 1));
+    b.fillRect(Rect(0, 0, 10, 10), Vec4(1, 0, 0, 1));
+
+    EXPECT_NE(a.getFingerprint(), b.getFingerprint());
+
+    RenderList culled;
+    culled.setCullRect(Rect(0, 0, 4, 4));
+    culled.fillRect(Rect(0, 0, 10, 10), Vec4(1, 0, 0, 1));
+    culled.fillRect(Rect(5, 5, 10, 10), Vec4(0, 1, 0, 1));
+    EXPECT_NE(a.getFingerprint(), culled.getFingerprint());
+}
+
+TEST(RenderListTest, FingerprintHashesGradientStops) {
+    auto record = [](RenderList& list, const Vec4& center) {
+        const GradientStop stops[] = { { 0.0f, Vec4(0, 0, 0, 1) }, { 0.5f, center }, { 1.0f, Vec4(0, 0, 0, 1) } };
+        list.fillGradientRect(Rect(0, 0, 8, 100), stops, 3, GradientDirection::Horizontal);
+    };
+
+    RenderList a, b, c;
+    record(a, Vec4(1, 1, 1, 1));
+    record(b, Vec4(1, 1, 1, 1));
+    record(c, Vec4(1, 1, 0, 1));
+
+    EXPECT_EQ(a.getFingerprint(), b.getFingerprint());
+    EXPECT_NE(a.getFingerprint(), c.getFingerprint());
+}
+
+TEST(RenderListTest, CoalescesAbuttingFillRects) {
+    const Vec4 red(1, 0, 0, 1);
+    const Vec4 green(0, 1, 0, 1);
+    RenderList list;
+
+    // Row of 1px columns: two colors, so two runs
+    for (int x = 0; x < 6; ++x)
+        list.fillRect(Rect(10.0f + x, 20, 1, 30), x < 4 ? red : green);
+    // Stacked rows
+    list.fillRect(Rect(0, 0, 8, 2), red);
+    list.fillRect(Rect(0, 2, 8, 3), red);
+    // Rounded, gapped and clip-separated rects stay
+    list.fillRect(Rect(0, 5, 8, 2), red, CornerRadius(1.0f));
+    list.fillRect(Rect(0, 7, 8, 2), red);
+    list.fillRect(Rect(9, 7, 8, 2), red);
+    list.pushClipRect(Rect(0, 0, 50, 50));
+    list.fillRect(Rect(17, 7, 8, 2), red);
+    list.popClipRect();
+
+    EXPECT_EQ(list.coalesceFillRects(), 5u);
+    EXPECT_EQ(list.getCoalescedCommandCount(), 5u);
+
+    const auto& commands = list.getCommands();
+    ASSERT_EQ(commands.size(), 9u);
+    EXPECT_EQ(commands[0].rectangle.rect, Rect(10, 20, 4, 30));
+    EXPECT_EQ(commands[1].rectangle.rect, Rect(14, 20, 2, 30));
+    EXPECT_EQ(commands[1].rectangle.color, green);
+    EXPECT_EQ(commands[2].rectangle.rect, Rect(0, 0, 8, 5));
+    EXPECT_EQ(commands[3].rectangle.rect, Rect(0, 5, 8, 2));
+    EXPECT_EQ(commands[6].type, RenderCommandType::PushClip);
+    EXPECT_EQ(commands[7].rectangle.rect, Rect(17, 7, 8, 2));
+    EXPECT_TRUE(list.validate());
+
+    EXPECT_EQ(list.coalesceFillRects(), 0u);
+    list.reset();
+    EXPECT_EQ(list.getCoalescedCommandCount(), 0u);
+}
+
+TEST(RenderListTest, CoalescesOnlyAtPixelEdges) {
+    const Vec4 red(1, 0, 0, 1);
+    RenderList list;
+
+    // Seam at x = 10.5 lies inside a pixel at 1x and on a pixel edge at 2x
+    list.fillRect(Rect(5, 0, 5.5f, 10), red);
+    list.fillRect(Rect(10.5f, 0, 4.5f, 10), red);
+    EXPECT_EQ(list.coalesceFillRects(), 0u);
+    EXPECT_EQ(list.coalesceFillRects(2.0f), 1u);
+    EXPECT_EQ(list.getCommands()[0].rectangle.rect, Rect(5, 0, 10, 10));
+}
+
+TEST(RenderListTest, FoldsColumnRampsIntoGradients) {
+    // 16 one-pixel columns: a ramp up, then a flat run, then a ramp down
+    auto shadeAt = [](int x) { return (x < 6 ? 40.0f + 20.0f * x : (x < 10 ? 140.0f : 140.0f - 10.0f * (x - 9))) / 255.0f; };
+    auto record = [&](RenderList& list, bool vertical) {
+        for (int i = 0; i < 16; ++i)
+        {
+            Rect column = vertical ? Rect(40, 8.0f + i, 12, 1) : Rect(8.0f + i, 40, 1, 12);
+            list.fillRect(column, Vec4(shadeAt(i), 0.5f, 0.25f, 1));
+        }
+    };
+
+    for (bool vertical : { false, true })
+    {
+        RenderList list;
+        record(list, vertical);
+        EXPECT_EQ(list.coalesceFillRects(), 15u);
+        ASSERT_EQ(list.getCommandCount(), 1u);
+
+        const RenderCommand& cmd = list.getCommands()[0];
+        ASSERT_EQ(cmd.type, RenderCommandType::FillGradientRect);
+        EXPECT_EQ(cmd.gradient.rect, vertical ? Rect(40, 8, 12, 16) : Rect(8, 40, 16, 12));
+        EXPECT_EQ(cmd.gradient.direction, vertical ? GradientDirection::Vertical : GradientDirection::Horizontal);
+
+        // Stops at the centers of the first column, the two bends and the last column
+        ASSERT_EQ(cmd.gradient.stopCount, 4u);
+        EXPECT_FLOAT_EQ(cmd.gradient.stops[0].position, 0.5f / 16.0f);
+        EXPECT_FLOAT_EQ(cmd.gradient.stops[1].position, 5.5f / 16.0f);
+        EXPECT_FLOAT_EQ(cmd.gradient.stops[2].position, 9.5f / 16.0f);
+        EXPECT_FLOAT_EQ(cmd.gradient.stops[3].position, 15.5f / 16.0f);
+        EXPECT_NEAR(cmd.gradient.stops[3].color.x, shadeAt(15), 1e-5f);
+        EXPECT_TRUE(list.validate());
+    }
+
+    // At 2x a logical column is two physical pixels, so a gradient would blend inside it;
+    // only the flat run of columns 5 to 9 merges
+    RenderList hiDpi;
+    record(hiDpi, false);
+    EXPECT_EQ(hiDpi.coalesceFillRects(2.0f), 4u);
+    EXPECT_EQ(hiDpi.getCommandCount(), 12u);
+    for (const RenderCommand& cmd : hiDpi.getCommands())
+        EXPECT_EQ(cmd.type, RenderCommandType::FillRect);
+}
+
+//==========================================================================================
+// Arena
+//==========================================================================================
+
+TEST(RenderArenaTest, LargeStringsGetDedicatedBlock) {
+    RenderArena arena;
+    std::string big(RenderArena::DEFAULT_BLOCK_SIZE * 2, 'x');
+
+    const char* small = arena.storeString("abc", 3);
+    const char* stored = arena.storeString(big.data(), big.size());
+
+    EXPECT_STREQ(small, "abc");
+    EXPECT_EQ(std::strlen(stored), big.size());
+    EXPECT_GE(arena.getBytesReserved(), big.size() + 1);
+}
+
+TEST(RenderArenaTest, ResetKeepsReservedMemory) {
+    RenderList list;
+    FontFallbackChain chain(1);
+
+    auto recordFrame = [&]() {
+        list.reset();
+        for (int i = 0; i < 2000; ++i) {
+            list.fillRect(Rect(static_cast<float>(i), 0, 1, 10), Vec4(0.5f, 0.5f, 0.5f, 1));
+            if (i % 4 == 0) {
+                list.drawText("-12.5 dB", Vec2(0, 0), chain, 11.0f, Vec4());
+            }
+        }
+    };
+
+    recordFrame();
+    size_t reserved = list.getArena().getBytesReserved();
+    size_t used = list.getArena().getBytesUsed();
+
+    for (int frame = 0; frame < 10; ++frame) {
+        recordFrame();
+        EXPECT_EQ(list.getArena().getBytesReserved(), reserved);
+        EXPECT_EQ(list.getArena().getBytesUsed(), used);
+    }
+}
+
+//==========================================================================================
+// Performance
+//==========================================================================================
+
+TEST(RenderListPerformanceTest, RecordMixerSizedFrame) {
+    RenderList list;
+    FontFallbackChain chain(1, 2);
+    const int iterations = 200;
+    const int commandsPerFrame = 9000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < iterations; ++frame) {
+        list.reset();
+        for (int i = 0; i < commandsPerFrame; ++i) {
+            if (i % 50 == 0) {
+                list.drawText("Audio 1", Vec2(0, 0), chain, 11.0f, Vec4());
+            } else {
+                list.fillRect(Rect(static_cast<float>(i % 700), 0, 1, 224), Vec4(0.2f, 0.8f, 0.2f, 1));
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double avgMs = std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    std::cout << "\n[RenderList] " << commandsPerFrame << " commands/frame: "
+              << avgMs << " ms/frame, " << sizeof(RenderCommand) << " bytes/command" << std::endl;
+
+    EXPECT_EQ(list.getCommandCount(), static_cast<size_t>(commandsPerFrame));
+}
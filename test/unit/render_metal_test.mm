@@ -70,6 +70,7 @@ public:
     MOCK_METHOD(FontMetrics, getFontMetrics, (FontHandle, float), (const, override));
     MOCK_METHOD(GlyphMetrics, getGlyphMetrics, (FontHandle, uint32_t, float), (const, override));
     MOCK_METHOD(Vec2, measureText, (const char*, float), (const, override));
+    MOCK_METHOD(void, measureCaretStops, (const char*, float, std::vector<float>&), (const, override));
     MOCK_METHOD(float, getTextHeight, (FontHandle, float), (const, override));
     MOCK_METHOD(bool, hasGlyph, (FontHandle, uint32_t), (const, override));
     MOCK_METHOD(FontHandle, selectFontForCodepoint, (uint32_t, const FontFallbackChain&), (const, override));
@@ -79,6 +80,7 @@ public:
     MOCK_METHOD(FontHandle, getDefaultNarrowBoldFont, (), (const, override));
     MOCK_METHOD(FontHandle, getDefaultCJKFont, (), (const, override));
     MOCK_METHOD(void*, getFontFace, (FontHandle), (const, override));
+    MOCK_METHOD(bool, getFontData, (FontHandle, const void*&, size_t&), (const, override));
     MOCK_METHOD(void*, getHarfBuzzFont, (FontHandle, float, float), (override));
 };
 
@@ -0,0 +1,792 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - SoftwareRenderer Unit Tests
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Pixel tests for the CPU backend: rect, border, clip, triangle, circle, image and text
+** rasterization, plus frame timing for a mixer-sized command list and its first frame
+** with and without a text cache file.
+**
+********************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "YuchenUI/rendering/SoftwareRenderer.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/resource/IResourceResolver.h"
+#include "YuchenUI/text/FontManager.h"
+#include "YuchenUI/text/GlyphCache.h"
+#include "YuchenUI/core/Config.h"
+#include "test_resources.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace YuchenUI;
+
+namespace {
+
+//==========================================================================================
+// Test Doubles
+//==========================================================================================
+
+/** Serves a 2x2 opaque red RGBA PNG for every path. */
+class MockResolver : public IResourceResolver {
+public:
+    MockResolver()
+    {
+        m_data.data = PNG_2X2;
+        m_data.size = sizeof(PNG_2X2);
+        m_data.designScale = 1.0f;
+    }
+
+    const Resources::ResourceData* find(const char*, const char*) override { return &m_data; }
+
+private:
+    static constexpr unsigned char PNG_2X2[] = {
+        0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48,
+        0x44, 0x52, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x08, 0x06, 0x00, 0x00,
+        0x00, 0x72, 0xb6, 0x0d, 0x24, 0x00, 0x00, 0x00, 0x11, 0x49, 0x44, 0x41, 0x54, 0x78,
+        0x9c, 0x63, 0xf8, 0xcf, 0xc0, 0xf0, 0x1f, 0x84, 0x19, 0x60, 0x0c, 0x00, 0x47, 0xca,
+        0x07, 0xf9, 0x67, 0x59, 0x6e, 0xb7, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44,
+        0xae, 0x42, 0x60, 0x82
+    };
+
+    Resources::ResourceData m_data;
+};
+
+constexpr unsigned char MockResolver::PNG_2X2[];
+
+uint8_t red(uint32_t pixel)   { return static_cast<uint8_t>(pixel); }
+uint8_t green(uint32_t pixel) { return static_cast<uint8_t>(pixel >> 8); }
+uint8_t alpha(uint32_t pixel) { return static_cast<uint8_t>(pixel >> 24); }
+
+const Vec4 BLACK(0, 0, 0, 1);
+const Vec4 RED(1, 0, 0, 1);
+const Vec4 GREEN(0, 1, 0, 1);
+
+/** Approximates the MixerPanel example's channel strips: pan knobs, solo/mute buttons,
+    fader, two-channel segmented meter, number displays and name label. */
+void buildMixerStrips(RenderList& list, const FontFallbackChain& chain, int strips, float height)
+{
+    const float stripWidth = 30.0f;
+    const Vec4 panel(0.16f, 0.16f, 0.17f, 1);
+    const Vec4 well(0.08f, 0.08f, 0.09f, 1);
+    const Vec4 text(0.85f, 0.85f, 0.85f, 1);
+
+    list.clear(Vec4(0.1f, 0.1f, 0.1f, 1));
+    for (int ch = 0; ch < strips; ++ch)
+    {
+        float x = static_cast<float>(ch) * stripWidth;
+        list.pushClipRect(Rect(x, 0, stripWidth, height));
+        list.fillRect(Rect(x, 0, stripWidth, height), panel);
+        list.drawRect(Rect(x, 0, stripWidth, height), well, 1.0f);
+
+        // Pan section
+        list.fillCircle(Vec2(x + 15, 20), 10.0f, well);
+        list.drawCircle(Vec2(x + 15, 20), 10.0f, text, 1.5f);
+        list.drawLine(Vec2(x + 15, 20), Vec2(x + 21, 13), text, 1.5f);
+        list.fillRect(Rect(x + 2, 34, 26, 12), well, CornerRadius(2.0f));
+        list.drawText("<50", Vec2(x + 4, 44), chain, 9.0f, text);
+
+        // Solo / mute
+        list.fillRect(Rect(x + 2, 50, 12, 12), Vec4(0.8f, 0.7f, 0.1f, 1), CornerRadius(3.0f));
+        list.fillRect(Rect(x + 16, 50, 12, 12), Vec4(0.2f, 0.4f, 0.9f, 1), CornerRadius(3.0f));
+
+        // Fader and meter
+        float top = 70.0f;
+        float bottom = height - 50.0f;
+        list.fillRect(Rect(x + 6, top, 3, bottom - top), well, CornerRadius(1.5f));
+        list.fillRect(Rect(x + 2, top + (bottom - top) * 0.3f, 11, 20), Vec4(0.6f, 0.6f, 0.62f, 1), CornerRadius(2.0f));
+        for (int meter = 0; meter < 2; ++meter)
+        {
+            float mx = x + 17 + meter * 5.0f;
+            list.fillRect(Rect(mx, top, 4, bottom - top), well);
+            for (int seg = 0; seg < 40; ++seg)
+            {
+                float y = bottom - (seg + 1) * (bottom - top) / 40.0f;
+                Vec4 color = seg < 30 ? Vec4(0.2f, 0.8f, 0.3f, 1) : (seg < 37 ? Vec4(0.9f, 0.8f, 0.2f, 1) : Vec4(0.9f, 0.2f, 0.2f, 1));
+                list.fillRect(Rect(mx, y, 4, (bottom - top) / 40.0f - 1.0f), color);
+            }
+        }
+
+        // Number displays and name
+        list.fillRect(Rect(x + 2, bottom + 4, 26, 12), well, CornerRadius(2.0f));
+        list.drawText("-6.5", Vec2(x + 4, bottom + 14), chain, 9.0f, text);
+        list.drawText("Audio", Vec2(x + 2, height - 8), chain, 9.0f, text);
+        list.popClipRect();
+    }
+}
+
+double timeFrames(SoftwareRenderer& renderer, const RenderList& list, int iterations)
+{
+    // Re-renders one list on purpose; measure rasterization, not frame skipping
+    renderer.setSkipIdenticalFrames(false);
+
+    renderer.beginFrame();
+    renderer.executeRenderCommands(list);
+    renderer.endFrame();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < iterations; ++frame)
+    {
+        renderer.beginFrame();
+        renderer.executeRenderCommands(list);
+        renderer.endFrame();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+//==========================================================================================
+// Fixture
+//==========================================================================================
+
+class SoftwareRendererTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        m_fontManager = std::make_unique<FontManager>();
+        ASSERT_TRUE(m_fontManager->initialize(Testing::getEmbeddedResourceResolver()));
+
+        m_renderer = std::make_unique<SoftwareRenderer>();
+        ASSERT_TRUE(m_renderer->initialize(nullptr, 200, 100, 1.0f, m_fontManager.get(), &m_resolver));
+    }
+
+    void TearDown() override {
+        m_renderer.reset();
+        m_fontManager.reset();
+    }
+
+    void render(const RenderList& list) {
+        m_renderer->beginFrame();
+        m_renderer->executeRenderCommands(list);
+        m_renderer->endFrame();
+    }
+
+    uint32_t pixel(int x, int y) const { return m_renderer->getPixel(x, y); }
+
+    MockResolver m_resolver;
+    std::unique_ptr<FontManager> m_fontManager;
+    std::unique_ptr<SoftwareRenderer> m_renderer;
+};
+
+//==========================================================================================
+// Framebuffer
+//==========================================================================================
+
+TEST_F(SoftwareRendererTest, FramebufferUsesPhysicalSize) {
+    SoftwareRenderer hiDpi;
+    ASSERT_TRUE(hiDpi.initialize(nullptr, 200, 100, 2.0f, m_fontManager.get(), &m_resolver));
+    EXPECT_EQ(hiDpi.getPixelWidth(), 400);
+    EXPECT_EQ(hiDpi.getPixelHeight(), 200);
+    EXPECT_EQ(hiDpi.getRenderSize(), Vec2(200, 100));
+
+    hiDpi.resize(50, 40);
+    EXPECT_EQ(hiDpi.getPixelWidth(), 100);
+    EXPECT_EQ(hiDpi.getPixelHeight(), 80);
+}
+
+TEST_F(SoftwareRendererTest, ClearFillsFramebuffer) {
+    RenderList list;
+    list.clear(Vec4(0, 0, 1, 1));
+    render(list);
+
+    EXPECT_EQ(pixel(0, 0), 0xFFFF0000u);
+    EXPECT_EQ(pixel(199, 99), 0xFFFF0000u);
+}
+
+//==========================================================================================
+// Primitives
+//==========================================================================================
+
+TEST_F(SoftwareRendererTest, FillRectCoversPixelCenters) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillRect(Rect(10, 10, 20, 10), RED);
+    render(list);
+
+    EXPECT_EQ(pixel(10, 10), 0xFF0000FFu);
+    EXPECT_EQ(pixel(29, 19), 0xFF0000FFu);
+    EXPECT_EQ(pixel(20, 15), 0xFF0000FFu);
+    EXPECT_EQ(pixel(31, 15), 0xFF000000u);
+    EXPECT_EQ(pixel(20, 21), 0xFF000000u);
+}
+
+TEST_F(SoftwareRendererTest, TranslucentRectBlendsOverBackground) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillRect(Rect(0, 0, 10, 10), Vec4(1, 1, 1, 0.5f));
+    render(list);
+
+    EXPECT_NEAR(red(pixel(5, 5)), 128, 1);
+    EXPECT_EQ(alpha(pixel(5, 5)), 255);
+}
+
+TEST_F(SoftwareRendererTest, RoundedCornersAreAntialiased) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillRect(Rect(10, 10, 40, 40), RED, CornerRadius(10.0f));
+    render(list);
+
+    EXPECT_EQ(red(pixel(10, 10)), 0);      // Outside the corner arc
+    EXPECT_EQ(red(pixel(30, 30)), 255);    // Interior
+    EXPECT_EQ(red(pixel(10, 30)), 255);    // Straight edge
+    uint8_t edge = red(pixel(13, 12));     // On the arc
+    EXPECT_GT(edge, 0);
+    EXPECT_LT(edge, 255);
+}
+
+TEST_F(SoftwareRendererTest, BorderLeavesInteriorUntouched) {
+    RenderList list;
+    list.clear(BLACK);
+    list.drawRect(Rect(10, 10, 40, 40), RED, 2.0f);
+    render(list);
+
+    EXPECT_EQ(red(pixel(10, 30)), 255);
+    EXPECT_EQ(red(pixel(11, 30)), 255);
+    EXPECT_EQ(red(pixel(30, 30)), 0);
+    EXPECT_EQ(red(pixel(48, 30)), 255);
+}
+
+TEST_F(SoftwareRendererTest, ClipRectLimitsDrawing) {
+    RenderList list;
+    list.clear(BLACK);
+    list.pushClipRect(Rect(20, 20, 10, 10));
+    list.fillRect(Rect(0, 0, 100, 100), GREEN);
+    list.popClipRect();
+    render(list);
+
+    EXPECT_EQ(green(pixel(25, 25)), 255);
+    EXPECT_EQ(green(pixel(19, 25)), 0);
+    EXPECT_EQ(green(pixel(30, 25)), 0);
+    EXPECT_EQ(green(pixel(25, 30)), 0);
+}
+
+TEST_F(SoftwareRendererTest, HorizontalGradientInterpolatesAcrossRect) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillGradientRect(Rect(20, 10, 100, 20), Vec4(0, 0, 0, 1), RED, GradientDirection::Horizontal);
+    render(list);
+
+    EXPECT_LE(red(pixel(20, 15)), 2);
+    EXPECT_NEAR(red(pixel(70, 15)), 128, 2);
+    EXPECT_GE(red(pixel(119, 15)), 253);
+    EXPECT_LT(red(pixel(45, 15)), red(pixel(46, 15)));
+    EXPECT_EQ(red(pixel(121, 15)), 0);
+    EXPECT_EQ(red(pixel(70, 31)), 0);
+}
+
+TEST_F(SoftwareRendererTest, MultiStopVerticalGradientHasNoSeams) {
+    const GradientStop stops[] = { { 0.0f, RED }, { 0.5f, GREEN }, { 1.0f, RED } };
+    RenderList list;
+    list.clear(BLACK);
+    list.fillGradientRect(Rect(10, 10, 20, 80), stops, 3, GradientDirection::Vertical);
+    render(list);
+
+    EXPECT_GE(red(pixel(20, 10)), 250);
+    EXPECT_GE(green(pixel(20, 50)), 250);
+    EXPECT_GE(red(pixel(20, 89)), 250);
+
+    // Every row inside the rect is fully covered, including both sides of the seam
+    for (int y = 10; y < 90; ++y)
+        EXPECT_EQ(alpha(pixel(20, y)), 255) << "row " << y;
+    EXPECT_EQ(red(pixel(20, 49)) + green(pixel(20, 49)), 255);
+    EXPECT_EQ(red(pixel(20, 50)) + green(pixel(20, 50)), 255);
+}
+
+TEST_F(SoftwareRendererTest, FlatGradientMatchesFillRect) {
+    const GradientStop stops[] = { { 0.0f, GREEN }, { 0.3f, GREEN }, { 1.0f, GREEN } };
+
+    RenderList plain;
+    plain.clear(BLACK);
+    plain.fillRect(Rect(10.5f, 10, 60, 40), GREEN, CornerRadius(8.0f));
+    render(plain);
+    std::vector<uint8_t> expected(m_renderer->getPixels(),
+                                  m_renderer->getPixels() + m_renderer->getBytesPerRow() * m_renderer->getPixelHeight());
+
+    RenderList gradient;
+    gradient.clear(BLACK);
+    gradient.fillGradientRect(Rect(10.5f, 10, 60, 40), stops, 3, GradientDirection::Horizontal, CornerRadius(8.0f));
+    render(gradient);
+
+    EXPECT_EQ(std::memcmp(expected.data(), m_renderer->getPixels(), expected.size()), 0);
+}
+
+TEST_F(SoftwareRendererTest, TriangleAndLine) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillTriangle(Vec2(10, 10), Vec2(50, 10), Vec2(10, 50), RED);
+    list.drawLine(Vec2(100, 20), Vec2(180, 20), GREEN, 2.0f);
+    render(list);
+
+    EXPECT_EQ(red(pixel(15, 15)), 255);
+    EXPECT_EQ(red(pixel(45, 45)), 0);
+    EXPECT_EQ(green(pixel(140, 19)), 255);
+    EXPECT_EQ(green(pixel(140, 20)), 255);
+    EXPECT_EQ(green(pixel(140, 23)), 0);
+}
+
+TEST_F(SoftwareRendererTest, FilledAndOutlinedCircles) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillCircle(Vec2(30, 50), 20.0f, RED);
+    list.drawCircle(Vec2(100, 50), 20.0f, GREEN, 2.0f);
+    render(list);
+
+    EXPECT_EQ(red(pixel(30, 50)), 255);
+    EXPECT_EQ(red(pixel(30, 10)), 0);
+    EXPECT_EQ(red(pixel(12, 50)), 255);
+
+    EXPECT_EQ(green(pixel(100, 50)), 0);
+    EXPECT_GT(green(pixel(81, 50)), 128);
+    EXPECT_EQ(green(pixel(100, 10)), 0);
+}
+
+TEST_F(SoftwareRendererTest, ImageIsSampledFromTexture) {
+    RenderList list;
+    list.clear(BLACK);
+    list.drawImage("app", "red.png", Rect(20, 20, 16, 16));
+    list.drawImage("app", "red.png", Rect(60, 20, 40, 16), ScaleMode::Tile);
+    render(list);
+
+    EXPECT_EQ(pixel(28, 28), 0xFF0000FFu);
+    EXPECT_EQ(pixel(80, 28), 0xFF0000FFu);
+    EXPECT_EQ(pixel(40, 28), 0xFF000000u);
+}
+
+TEST_F(SoftwareRendererTest, TextProducesGlyphCoverage) {
+    RenderList list;
+    list.clear(BLACK);
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    list.drawText("HHHH", Vec2(10, 40), chain, 24.0f, Vec4(1, 1, 1, 1));
+    render(list);
+
+    int lit = 0;
+    for (int y = 0; y < 100; ++y)
+        for (int x = 0; x < 200; ++x)
+            if (red(pixel(x, y)) > 128) ++lit;
+
+    EXPECT_GT(lit, 100);
+    EXPECT_EQ(m_renderer->getBatchStats().batchCount, 1u);
+}
+
+TEST_F(SoftwareRendererTest, DistanceFieldTextMatchesCoverageText) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    auto litPixels = [&]() {
+        RenderList list;
+        list.clear(BLACK);
+        list.drawText("HHHH", Vec2(10, 40), chain, 24.0f, Vec4(1, 1, 1, 1));
+        render(list);
+
+        int lit = 0;
+        for (int y = 0; y < 100; ++y)
+            for (int x = 0; x < 200; ++x)
+                if (red(pixel(x, y)) > 128) ++lit;
+        return lit;
+    };
+
+    const int coverageLit = litPixels();
+    m_renderer->setGlyphFormat(GlyphFormat::SignedDistance);
+    EXPECT_EQ(m_renderer->getGlyphFormat(), GlyphFormat::SignedDistance);
+    const int distanceLit = litPixels();
+
+    EXPECT_GT(coverageLit, 100);
+    EXPECT_NEAR(distanceLit, coverageLit, coverageLit * 0.15);
+}
+
+TEST_F(SoftwareRendererTest, GlyphsInLaterAtlasesSampleTheirOwnTexture) {
+    // At 300pt a few dozen glyphs fill a 1024x1024 atlas, so the tail of this string
+    // lands in later atlases
+    const char* text = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+
+    SoftwareRenderer spilled;
+    ASSERT_TRUE(spilled.initialize(nullptr, 320, 320, 1.0f, m_fontManager.get(), &m_resolver));
+
+    RenderList all;
+    all.clear(BLACK);
+    all.drawText(text, Vec2(0, 280), chain, 300.0f, Vec4(1, 1, 1, 1));
+    spilled.beginFrame();
+    spilled.executeRenderCommands(all);
+    spilled.endFrame();
+
+    // One batch per atlas, not one per glyph
+    const size_t textBatches = spilled.getBatchStats().batchCount;
+    EXPECT_GE(textBatches, 2u);
+    EXPECT_LE(textBatches, static_cast<size_t>(Config::GlyphCache::MAX_ATLASES));
+
+    RenderList last;
+    last.clear(BLACK);
+    last.drawText("9", Vec2(20, 280), chain, 300.0f, Vec4(1, 1, 1, 1));
+    spilled.beginFrame();
+    spilled.executeRenderCommands(last);
+    spilled.endFrame();
+
+    // The same glyph rasterized into the first atlas of a fresh renderer
+    SoftwareRenderer fresh;
+    ASSERT_TRUE(fresh.initialize(nullptr, 320, 320, 1.0f, m_fontManager.get(), &m_resolver));
+    fresh.beginFrame();
+    fresh.executeRenderCommands(last);
+    fresh.endFrame();
+
+    int lit = 0;
+    for (int y = 0; y < 320; ++y)
+        for (int x = 0; x < 320; ++x) {
+            ASSERT_EQ(spilled.getPixel(x, y), fresh.getPixel(x, y)) << "at " << x << "," << y;
+            if (red(fresh.getPixel(x, y)) > 128) ++lit;
+        }
+    EXPECT_GT(lit, 1000);
+}
+
+TEST_F(SoftwareRendererTest, GlyphUploadsAreBatchedPerFrame) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    RenderList list;
+    list.clear(BLACK);
+    const char* lines[] = { "The quick brown fox", "jumps over the lazy dog", "0123456789 -dB +dB",
+                            "THE QUICK BROWN FOX", "JUMPS OVER THE LAZY DOG", "Mixer Bus Aux Send" };
+    for (int i = 0; i < 6; ++i)
+        for (int size = 9; size <= 14; ++size)
+            list.drawText(lines[i], Vec2(4, 12.0f + i * 14), chain, static_cast<float>(size), Vec4(1, 1, 1, 1));
+    render(list);
+
+    // Dozens of new glyphs, a few uploads
+    const GlyphUploadStats& stats = m_renderer->getGlyphUploadStats();
+    EXPECT_GT(stats.glyphsWritten, 100u);
+    EXPECT_LE(stats.uploadCount, 4u);
+    EXPECT_EQ(stats.flushCount, 1u);
+
+    // Nothing new on the next frame, nothing uploaded
+    const uint64_t uploads = stats.uploadCount;
+    list.fillRect(Rect(0, 0, 1, 1), BLACK);
+    render(list);
+    EXPECT_EQ(stats.uploadCount, uploads);
+}
+
+//==========================================================================================
+// Tiling
+//==========================================================================================
+
+TEST_F(SoftwareRendererTest, ClearAppliesWithoutDrawCommands) {
+    RenderList list;
+    list.clear(Vec4(0, 0, 1, 1));
+    render(list);
+
+    m_renderer->beginFrame();
+    m_renderer->endFrame();
+    EXPECT_EQ(pixel(100, 50), 0xFFFF0000u);
+}
+
+TEST_F(SoftwareRendererTest, ThreadCountDoesNotChangeOutput) {
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    RenderList list;
+    buildMixerStrips(list, chain, 24, 300.0f);
+
+    SoftwareRenderer single;
+    single.setThreadCount(1);
+    ASSERT_TRUE(single.initialize(nullptr, 720, 300, 1.5f, m_fontManager.get(), &m_resolver));
+    single.beginFrame();
+    single.executeRenderCommands(list);
+    single.endFrame();
+
+    SoftwareRenderer threaded;
+    threaded.setThreadCount(4);
+    ASSERT_TRUE(threaded.initialize(nullptr, 720, 300, 1.5f, m_fontManager.get(), &m_resolver));
+    threaded.beginFrame();
+    threaded.executeRenderCommands(list);
+    threaded.endFrame();
+
+    EXPECT_EQ(threaded.getThreadCount(), 4u);
+    size_t bytes = single.getBytesPerRow() * single.getPixelHeight();
+    EXPECT_EQ(std::memcmp(single.getPixels(), threaded.getPixels(), bytes), 0);
+}
+
+//==========================================================================================
+// Partial Redraw
+//==========================================================================================
+
+TEST_F(SoftwareRendererTest, DamageRectPreservesPixelsOutside) {
+    RenderList first;
+    first.clear(BLACK);
+    first.fillRect(Rect(0, 0, 200, 100), RED);
+    render(first);
+
+    // Second frame clears and draws everywhere, but only the damage may change
+    RenderList second;
+    second.clear(BLACK);
+    second.fillRect(Rect(0, 0, 200, 100), Vec4(0, 0, 1, 1));
+    m_renderer->setDamageRect(Rect(100, 40, 20, 10));
+    render(second);
+
+    EXPECT_EQ(pixel(100, 40), 0xFFFF0000u);
+    EXPECT_EQ(pixel(119, 49), 0xFFFF0000u);
+    EXPECT_EQ(pixel(99, 40), 0xFF0000FFu);
+    EXPECT_EQ(pixel(120, 45), 0xFF0000FFu);
+    EXPECT_EQ(pixel(110, 50), 0xFF0000FFu);
+
+    // The damage applies to one frame only
+    render(second);
+    EXPECT_EQ(pixel(0, 0), 0xFFFF0000u);
+}
+
+TEST_F(SoftwareRendererTest, DamagedClearWithoutDrawCommands) {
+    RenderList list;
+    list.clear(RED);
+    render(list);
+
+    RenderList clearOnly;
+    clearOnly.clear(BLACK);
+    m_renderer->setDamageRect(Rect(10, 10, 5, 5));
+    render(clearOnly);
+
+    EXPECT_EQ(pixel(12, 12), 0xFF000000u);
+    EXPECT_EQ(pixel(20, 20), 0xFF0000FFu);
+}
+
+TEST_F(SoftwareRendererTest, CoalescedFillRectsMatchPixels) {
+    // Meter-style column fills: 1px columns whose color changes every few columns,
+    // folded into one gradient per channel
+    auto record = [](RenderList& list) {
+        list.clear(BLACK);
+        for (int ch = 0; ch < 8; ++ch)
+        {
+            for (int x = 0; x < 12; ++x)
+            {
+                float shade = 0.4f + 0.1f * static_cast<float>(x / 4);
+                list.fillRect(Rect(ch * 20.0f + x, 10, 1, 80), Vec4(shade, 0.8f, 0.2f, 1));
+            }
+        }
+    };
+
+    RenderList plain;
+    record(plain);
+    render(plain);
+    std::vector<uint8_t> expected(m_renderer->getPixels(),
+                                  m_renderer->getPixels() + m_renderer->getBytesPerRow() * m_renderer->getPixelHeight());
+
+    RenderList merged;
+    record(merged);
+    EXPECT_EQ(merged.coalesceFillRects(), 8u * 11u);
+    m_renderer->setSkipIdenticalFrames(false);
+    render(merged);
+
+    EXPECT_EQ(std::memcmp(expected.data(), m_renderer->getPixels(), expected.size()), 0);
+}
+
+TEST_F(SoftwareRendererTest, CoalescedColumnRampsMatchPixels) {
+    // Pre-gradient meter lighting: a cosine profile sampled once per 1px column
+    auto record = [](RenderList& list) {
+        list.clear(BLACK);
+        for (int ch = 0; ch < 6; ++ch)
+        {
+            const int width = 4 + ch * 6;
+            for (int x = 0; x < width; ++x)
+            {
+                float light = 0.55f + 0.45f * std::cos((x + 0.5f) / width * 3.14159265f - 1.5707963f);
+                list.fillRect(Rect(ch * 36.0f + x, 10, 1, 80), Vec4(0.2f * light, 0.9f * light, 0.3f * light, 1));
+            }
+        }
+    };
+
+    RenderList plain;
+    record(plain);
+    render(plain);
+    std::vector<uint8_t> expected(m_renderer->getPixels(),
+                                  m_renderer->getPixels() + m_renderer->getBytesPerRow() * m_renderer->getPixelHeight());
+
+    RenderList merged;
+    record(merged);
+    const size_t recorded = merged.getCommandCount();
+    merged.coalesceFillRects();
+    EXPECT_LT(merged.getCommandCount() * 10, recorded);
+    m_renderer->setSkipIdenticalFrames(false);
+    render(merged);
+
+    EXPECT_EQ(std::memcmp(expected.data(), m_renderer->getPixels(), expected.size()), 0);
+}
+
+//==========================================================================================
+// Identical Frames
+//==========================================================================================
+
+TEST_F(SoftwareRendererTest, IdenticalFrameIsSkipped) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillRect(Rect(10, 10, 20, 10), RED);
+    render(list);
+    EXPECT_EQ(m_renderer->getSkippedFrameCount(), 0u);
+
+    // Same commands recorded again into a fresh list
+    RenderList again;
+    again.clear(BLACK);
+    again.fillRect(Rect(10, 10, 20, 10), RED);
+    render(again);
+    EXPECT_EQ(m_renderer->getSkippedFrameCount(), 1u);
+    EXPECT_EQ(pixel(15, 15), 0xFF0000FFu);
+    EXPECT_EQ(pixel(50, 50), 0xFF000000u);
+
+    RenderList moved;
+    moved.clear(BLACK);
+    moved.fillRect(Rect(11, 10, 20, 10), RED);
+    render(moved);
+    EXPECT_EQ(m_renderer->getSkippedFrameCount(), 1u);
+    EXPECT_EQ(pixel(10, 15), 0xFF000000u);
+}
+
+TEST_F(SoftwareRendererTest, ClearOnlyFrameBreaksSkipping) {
+    RenderList list;
+    list.clear(BLACK);
+    list.fillRect(Rect(10, 10, 20, 10), RED);
+    render(list);
+
+    m_renderer->beginFrame();
+    m_renderer->endFrame();
+    EXPECT_EQ(pixel(15, 15), 0xFF000000u);
+
+    render(list);
+    EXPECT_EQ(m_renderer->getSkippedFrameCount(), 0u);
+    EXPECT_EQ(pixel(15, 15), 0xFF0000FFu);
+}
+
+//==========================================================================================
+// Performance
+//==========================================================================================
+
+TEST_F(SoftwareRendererTest, PerformanceTest_MixerSizedFrame) {
+    const int channels = 48;
+    const int segmentsPerMeter = 200;
+
+    SoftwareRenderer renderer;
+    ASSERT_TRUE(renderer.initialize(nullptr, 800, 600, 2.0f, m_fontManager.get(), &m_resolver));
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+
+    RenderList list;
+    list.clear(Vec4(0.1f, 0.1f, 0.1f, 1));
+    for (int ch = 0; ch < channels; ++ch)
+    {
+        float x = static_cast<float>(ch * 16);
+        list.pushClipRect(Rect(x, 0, 16, 600));
+        list.fillRect(Rect(x, 0, 16, 600), Vec4(0.15f, 0.15f, 0.15f, 1), CornerRadius(2.0f));
+        for (int i = 0; i < segmentsPerMeter; ++i)
+            list.fillRect(Rect(x + 2, static_cast<float>(i * 3), 5, 2), Vec4(0.2f, 0.8f, 0.2f, 1));
+        list.drawLine(Vec2(x, 100), Vec2(x + 16, 100), Vec4(1, 1, 1, 1), 1.0f);
+        list.drawText("-12", Vec2(x + 1, 590), chain, 9.0f, Vec4(1, 1, 1, 1));
+        list.popClipRect();
+    }
+
+    double avgMs = timeFrames(renderer, list, 10);
+    std::cout << "\n[SoftwareRenderer] " << list.getCommandCount() << " commands, "
+              << renderer.getPixelWidth() << "x" << renderer.getPixelHeight() << " px ("
+              << SoftwareRenderer::getKernelName() << "): " << avgMs << " ms/frame" << std::endl;
+
+    EXPECT_GT(renderer.getBatchStats().batchCount, 0u);
+}
+
+TEST_F(SoftwareRendererTest, PerformanceTest_TileScaling4K) {
+    // 64 strips at 3840x2160 physical (1920x1080 logical at 2x)
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    RenderList list;
+    buildMixerStrips(list, chain, 64, 1080.0f);
+
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "\n[SoftwareRenderer] 64-strip mixer, " << list.getCommandCount() << " commands, 3840x2160 ("
+              << SoftwareRenderer::getKernelName() << ")" << std::endl;
+
+    double baseline = 0.0;
+    for (size_t threads = 1; ; threads = std::min(threads * 2, maxThreads))
+    {
+        SoftwareRenderer renderer;
+        renderer.setThreadCount(threads);
+        ASSERT_TRUE(renderer.initialize(nullptr, 1920, 1080, 2.0f, m_fontManager.get(), &m_resolver));
+
+        double avgMs = timeFrames(renderer, list, 5);
+        if (threads == 1) baseline = avgMs;
+        std::cout << "  " << threads << " thread(s): " << avgMs << " ms/frame, speedup "
+                  << baseline / avgMs << "x" << std::endl;
+
+        if (threads == maxThreads) break;
+    }
+
+    EXPECT_GT(baseline, 0.0);
+}
+
+TEST_F(SoftwareRendererTest, PerformanceTest_RedundantMixerFrames) {
+    // Meters that settle at rest: every fourth frame changes, the rest repeat
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    SoftwareRenderer renderer;
+    ASSERT_TRUE(renderer.initialize(nullptr, 720, 300, 1.0f, m_fontManager.get(), &m_resolver));
+
+    const int frames = 40;
+    RenderList list;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        list.reset();
+        buildMixerStrips(list, chain, 24, 300.0f);
+        list.fillRect(Rect(0, 290, static_cast<float>(frame / 4 % 10) * 10.0f + 1.0f, 4), RED);
+
+        renderer.beginFrame();
+        renderer.executeRenderCommands(list);
+        renderer.endFrame();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double avgMs = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+    std::cout << "\n[SoftwareRenderer] redundant frames: " << renderer.getSkippedFrameCount() << " of "
+              << frames << " skipped, " << avgMs << " ms/frame" << std::endl;
+
+    EXPECT_GE(renderer.getSkippedFrameCount(), static_cast<uint64_t>(frames / 2));
+}
+
+TEST_F(SoftwareRendererTest, PerformanceTest_TimeToFirstFrameWithTextCache) {
+    // The MixerPanel window (1920x800, 64 visible strips with their track names); the warm
+    // renderer starts from the cold one's cache file
+    FontFallbackChain chain = m_fontManager->createDefaultFallbackChain();
+    RenderList list;
+    buildMixerStrips(list, chain, 64, 800.0f);
+    for (int ch = 0; ch < 64; ++ch)
+    {
+        const std::string name = "Audio " + std::to_string(ch + 1);
+        list.drawText(name.c_str(), Vec2(ch * 30.0f + 2, 780), chain, 11.0f, Vec4(1, 1, 1, 1));
+    }
+    const std::string path = ::testing::TempDir() + "yuchen_text_cache_first_frame.bin";
+
+    double loadMs = 0.0;
+    auto firstFrame = [&](SoftwareRenderer& renderer, bool warm, size_t& adopted) {
+        auto start = std::chrono::high_resolution_clock::now();
+        EXPECT_TRUE(renderer.initialize(nullptr, 1920, 800, 1.0f, m_fontManager.get(), &m_resolver));
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        adopted = warm ? renderer.loadTextCache(path.c_str()) : 0;
+        loadMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - loadStart).count();
+        renderer.beginFrame();
+        renderer.executeRenderCommands(list);
+        renderer.endFrame();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    };
+
+    size_t adopted = 0;
+    SoftwareRenderer cold;
+    double coldMs = firstFrame(cold, false, adopted);
+    ASSERT_TRUE(cold.saveTextCache(path.c_str()));
+
+    SoftwareRenderer warm;
+    double warmMs = firstFrame(warm, true, adopted);
+    std::remove(path.c_str());
+
+    std::cout << "\n[SoftwareRenderer] MixerPanel time to first frame, 1920x800: " << coldMs
+              << " ms cold, " << warmMs << " ms warm, of which " << loadMs << " ms loading the cache (" << adopted
+              << " glyphs and runs adopted)" << std::endl;
+
+    EXPECT_GT(adopted, 0u);
+    EXPECT_EQ(std::memcmp(cold.getPixels(), warm.getPixels(), cold.getBytesPerRow() * cold.getPixelHeight()), 0);
+}
@@ -0,0 +1,36 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - Unit Test Helpers
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Shared access to the framework's embedded resources (fonts, images) for unit tests.
+**
+********************************************************************************************/
+
+#pragma once
+
+#include "YuchenUI/resource/ResourceManager.h"
+#include "YuchenUI/resource/EmbeddedResourceProvider.h"
+#include "embedded_resources.h"
+
+namespace YuchenUI {
+namespace Testing {
+
+/** Registers the embedded "YuchenUI" provider once and returns the global resolver,
+    mirroring what Application::initialize() does for real apps. */
+inline IResourceResolver* getEmbeddedResourceResolver()
+{
+    static const bool registered = []() {
+        ResourceManager::getInstance().registerProvider(
+            "YuchenUI",
+            new EmbeddedResourceProvider(Resources::getAllResources(), Resources::getResourceCount()));
+        return true;
+    }();
+    (void)registered;
+
+    return &ResourceManager::getInstance();
+}
+
+} // namespace Testing
+} // namespace YuchenUI
@@ -0,0 +1,336 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - UIContext Redraw Scheduling Unit Tests
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Tests for on-demand rendering: invalidation and input request a frame, completed frames
+** clear the request, animation frames become due after their delay, and damage regions
+** restrict recording to the widgets that changed.
+**
+********************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "YuchenUI/core/UIContext.h"
+#include "YuchenUI/core/IUIContent.h"
+#include "YuchenUI/core/Config.h"
+#include "YuchenUI/widgets/Button.h"
+#include "YuchenUI/widgets/SpinBox.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/text/FontManager.h"
+#include "YuchenUI/theme/ThemeManager.h"
+#include "test_resources.h"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace YuchenUI;
+
+namespace {
+
+//==========================================================================================
+// Test Doubles
+//==========================================================================================
+
+/** Content hosting two buttons; optionally animates every frame. */
+class ButtonContent : public IUIContent {
+public:
+    void onCreate(UIContext* context, const Rect&) override
+    {
+        m_context = context;
+        button = new Button(Rect(10, 10, 60, 24));
+        button->setOwnerContext(context);
+        addComponent(button);
+
+        other = new Button(Rect(120, 60, 60, 24));
+        other->setText("Other");
+        other->setOwnerContext(context);
+        addComponent(other);
+    }
+
+    void onUpdate(float) override
+    {
+        ++updateCount;
+        if (animate) m_context->requestAnimationFrame();
+    }
+
+    void render(RenderList& commandList) override
+    {
+        button->render(commandList);
+        other->render(commandList);
+    }
+
+    Button* button = nullptr;
+    Button* other = nullptr;
+    bool animate = false;
+    int updateCount = 0;
+};
+
+} // namespace
+
+//==========================================================================================
+// Fixture
+//==========================================================================================
+
+class UIContextRedrawTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_fontManager = std::make_unique<FontManager>();
+        ASSERT_TRUE(m_fontManager->initialize(Testing::getEmbeddedResourceResolver()));
+        m_themeManager = std::make_unique<ThemeManager>();
+        m_themeManager->setFontProvider(m_fontManager.get());
+        m_context = std::make_unique<UIContext>(m_fontManager.get(), m_themeManager.get());
+        m_context->setViewportSize(Vec2(200, 100));
+
+        auto content = std::make_unique<ButtonContent>();
+        m_content = content.get();
+        m_context->setContent(std::move(content));
+    }
+
+    void TearDown() override
+    {
+        // Content must go before the context it registered with, as in BaseWindow
+        if (m_context) m_context->setContent(nullptr);
+    }
+
+    /** Runs a frame the way BaseWindow does, returning false if it was skipped. */
+    bool runFrame()
+    {
+        if (!m_context->needsRedraw()) return false;
+
+        RenderList list;
+        m_context->beginFrame();
+        m_context->render(list);
+        m_context->endFrame();
+        return true;
+    }
+
+    std::unique_ptr<FontManager> m_fontManager;
+    std::unique_ptr<ThemeManager> m_themeManager;
+    std::unique_ptr<UIContext> m_context;
+    ButtonContent* m_content = nullptr;
+};
+
+//==========================================================================================
+// Idle Frames
+//==========================================================================================
+
+TEST_F(UIContextRedrawTest, IdleFramesAreSkipped) {
+    EXPECT_TRUE(runFrame());
+    EXPECT_FALSE(m_context->needsRedraw());
+    EXPECT_LT(m_context->getTimeUntilNextFrame(), 0.0f);
+
+    for (int i = 0; i < 10; ++i) EXPECT_FALSE(runFrame());
+    EXPECT_EQ(m_content->updateCount, 1);
+}
+
+TEST_F(UIContextRedrawTest, InvalidateRequestsRedraw) {
+    runFrame();
+
+    m_content->button->setText("Mute");
+    EXPECT_TRUE(m_context->needsRedraw());
+    EXPECT_EQ(m_context->getTimeUntilNextFrame(), 0.0f);
+
+    EXPECT_TRUE(runFrame());
+    EXPECT_FALSE(runFrame());
+}
+
+TEST_F(UIContextRedrawTest, InputRequestsRedraw) {
+    runFrame();
+
+    m_context->handleMouseMove(Vec2(100, 95));
+    EXPECT_FALSE(m_context->needsRedraw());
+
+    m_context->handleMouseMove(Vec2(20, 20));
+    EXPECT_TRUE(m_context->needsRedraw());
+    runFrame();
+
+    // Widgets invalidate themselves; input nothing handles costs no frame
+    m_context->handleMouseClick(Vec2(100, 95), true);
+    m_context->handleMouseClick(Vec2(100, 95), false);
+    m_context->handleMouseWheel(Vec2(0, 1), Vec2(100, 95));
+    m_context->handleKeyEvent(KeyCode::A, true, KeyModifiers(), false);
+    m_context->handleTextInput('a');
+    EXPECT_FALSE(m_context->needsRedraw());
+
+    EXPECT_TRUE(m_context->handleMouseClick(Vec2(20, 20), true));
+    EXPECT_TRUE(m_context->needsRedraw());
+    runFrame();
+    m_context->handleMouseClick(Vec2(20, 20), false);
+}
+
+TEST_F(UIContextRedrawTest, FrameRequestCallbackWakesIdleContext) {
+    int wakes = 0;
+    m_context->setFrameRequestCallback([&wakes]() { ++wakes; });
+    runFrame();
+    EXPECT_EQ(wakes, 0);
+
+    // Only the first request after an idle frame wakes the platform
+    m_content->button->setText("Mute");
+    m_content->other->setText("Solo");
+    m_context->requestRedraw();
+    EXPECT_EQ(wakes, 1);
+    runFrame();
+
+    m_context->handleMouseMove(Vec2(20, 20));
+    EXPECT_EQ(wakes, 2);
+    runFrame();
+
+    // Animation frames wake when they move the next frame earlier
+    m_context->requestAnimationFrame(1.0f);
+    m_context->requestAnimationFrame(2.0f);
+    m_context->requestAnimationFrame(0.5f);
+    EXPECT_EQ(wakes, 4);
+
+    m_context->setFrameRequestCallback(nullptr);
+    m_context->requestRedraw();
+    EXPECT_EQ(wakes, 4);
+}
+
+//==========================================================================================
+// Animation Frames
+//==========================================================================================
+
+TEST_F(UIContextRedrawTest, AnimationFrameBecomesDue) {
+    runFrame();
+
+    m_context->requestAnimationFrame(0.05f);
+    EXPECT_FALSE(m_context->needsRedraw());
+    float wait = m_context->getTimeUntilNextFrame();
+    EXPECT_GT(wait, 0.0f);
+    EXPECT_LE(wait, 0.05f);
+
+    // An earlier request wins over a later one
+    m_context->requestAnimationFrame(1.0f);
+    EXPECT_LE(m_context->getTimeUntilNextFrame(), 0.05f);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_TRUE(m_context->needsRedraw());
+    EXPECT_TRUE(runFrame());
+    EXPECT_FALSE(runFrame());
+}
+
+TEST_F(UIContextRedrawTest, AnimatingContentKeepsFramesComing) {
+    m_content->animate = true;
+    for (int i = 0; i < 5; ++i) EXPECT_TRUE(runFrame());
+
+    m_content->animate = false;
+    EXPECT_TRUE(runFrame());
+    EXPECT_FALSE(runFrame());
+    EXPECT_EQ(m_content->updateCount, 6);
+}
+
+TEST_F(UIContextRedrawTest, EditingSpinBoxSchedulesCursorBlink) {
+    SpinBox spinBox(Rect(0, 0, 100, 20));
+    spinBox.setOwnerContext(m_context.get());
+    runFrame();
+
+    spinBox.setFocus();
+    EXPECT_TRUE(m_context->needsRedraw());
+    runFrame();
+
+    spinBox.update(0.0f);
+    float wait = m_context->getTimeUntilNextFrame();
+    EXPECT_GT(wait, 0.0f);
+    EXPECT_LE(wait, 0.53f);
+
+    spinBox.clearFocus();
+}
+
+//==========================================================================================
+// Damage Regions
+//==========================================================================================
+
+TEST_F(UIContextRedrawTest, InvalidateDamagesWidgetBounds) {
+    runFrame();
+    EXPECT_TRUE(m_context->getDamageRects().empty());
+
+    m_content->button->setText("Mute");
+    EXPECT_FALSE(m_context->isFullRedraw());
+    ASSERT_EQ(m_context->getDamageRects().size(), 1u);
+
+    const Rect expected = Rect(10, 10, 60, 24).expanded(Config::Rendering::DAMAGE_OUTSET);
+    EXPECT_EQ(m_context->getDamageRects()[0], expected);
+    EXPECT_EQ(m_context->getDamageBounds(), expected);
+
+    // Repeated invalidation of the same widget adds nothing
+    m_content->button->setText("Solo");
+    EXPECT_EQ(m_context->getDamageRects().size(), 1u);
+}
+
+TEST_F(UIContextRedrawTest, MovedWidgetDamagesOldAndNewBounds) {
+    runFrame();
+
+    m_content->button->setBounds(Rect(40, 50, 60, 24));
+    ASSERT_EQ(m_context->getDamageRects().size(), 2u);
+
+    const float outset = Config::Rendering::DAMAGE_OUTSET;
+    EXPECT_EQ(m_context->getDamageRects()[0], Rect(10, 10, 60, 24).expanded(outset));
+    EXPECT_EQ(m_context->getDamageRects()[1], Rect(40, 50, 60, 24).expanded(outset));
+    EXPECT_EQ(m_context->getDamageBounds(), Rect(10, 10, 90, 64).expanded(outset));
+}
+
+TEST_F(UIContextRedrawTest, PartialRedrawSkipsUndamagedWidgets) {
+    m_context->setPartialRedrawEnabled(true);
+
+    RenderList full;
+    m_context->beginFrame();
+    m_context->render(full);
+    m_context->endFrame();
+    const FrameStats fullStats = m_context->getFrameStats();
+    EXPECT_TRUE(fullStats.fullRedraw);
+    EXPECT_FLOAT_EQ(fullStats.damagedPixelFraction, 1.0f);
+    EXPECT_EQ(fullStats.commandsSkipped, 0u);
+
+    RenderList otherOnly;
+    m_content->other->render(otherOnly);
+    const size_t otherCommands = otherOnly.getCommandCount();
+
+    m_content->button->setText("Mute");
+
+    RenderList partial;
+    m_context->beginFrame();
+    m_context->render(partial);
+    m_context->endFrame();
+    const FrameStats& stats = m_context->getFrameStats();
+
+    EXPECT_FALSE(stats.fullRedraw);
+    EXPECT_EQ(stats.damageRectCount, 1u);
+    EXPECT_EQ(stats.commandsSkipped, otherCommands);
+    RenderList buttonOnly;
+    m_content->button->render(buttonOnly);
+    EXPECT_EQ(stats.commandsRecorded, buttonOnly.getCommandCount());
+    EXPECT_GT(stats.damagedPixelFraction, 0.0f);
+    EXPECT_LT(stats.damagedPixelFraction, 0.15f);
+    EXPECT_FALSE(partial.hasCullRect());
+}
+
+TEST_F(UIContextRedrawTest, FullRedrawOverridesDamage) {
+    m_context->setPartialRedrawEnabled(true);
+    runFrame();
+
+    m_content->button->setText("Mute");
+    m_context->requestRedraw();
+    EXPECT_TRUE(m_context->isFullRedraw());
+    EXPECT_TRUE(m_context->getDamageRects().empty());
+    EXPECT_EQ(m_context->getDamageBounds(), Rect(0, 0, 200, 100));
+
+    m_content->other->setText("Again");
+    EXPECT_TRUE(m_context->getDamageRects().empty());
+}
+
+TEST_F(UIContextRedrawTest, DamageCollapsesBeyondLimit) {
+    runFrame();
+
+    for (size_t i = 0; i <= Config::Rendering::MAX_DAMAGE_RECTS; ++i)
+        m_context->invalidateRect(Rect(static_cast<float>(i * 5 % 200), 0, 2, 2));
+
+    ASSERT_EQ(m_context->getDamageRects().size(), 1u);
+    EXPECT_EQ(m_context->getDamageRects()[0], m_context->getDamageBounds());
+
+    m_context->invalidateRect(Rect(500, 500, 10, 10));
+    EXPECT_EQ(m_context->getDamageRects().size(), 1u);
+}
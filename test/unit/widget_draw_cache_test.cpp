@@ -0,0 +1,315 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - Widget Draw Cache Unit Tests
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Tests for the retained per-widget display list: replay at new offsets, invalidation on
+** state, geometry and theme changes, and the per-frame cost of a static mixer surface.
+**
+********************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "YuchenUI/widgets/Widget.h"
+#include "YuchenUI/widgets/Button.h"
+#include "YuchenUI/widgets/TextLabel.h"
+#include "YuchenUI/core/UIContext.h"
+#include "YuchenUI/rendering/RenderList.h"
+#include "YuchenUI/text/FontManager.h"
+#include "YuchenUI/theme/ThemeManager.h"
+#include "test_resources.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace YuchenUI;
+
+namespace {
+
+//==========================================================================================
+// Test Doubles
+//==========================================================================================
+
+/** Leaf widget that counts how often it is asked to draw. */
+class CountingWidget : public Widget {
+public:
+    explicit CountingWidget(const Rect& bounds)
+    {
+        setBounds(bounds);
+        setDrawCacheEnabled(true);
+    }
+
+    void addDrawCommands(RenderList& commandList, const Vec2& offset) const override
+    {
+        ++drawCount;
+        commandList.fillRect(Rect(m_bounds.x + offset.x, m_bounds.y + offset.y,
+                                  m_bounds.width, m_bounds.height), Vec4(1, 0, 0, 1));
+    }
+
+    bool handleMouseMove(const Vec2&, const Vec2&) override { return false; }
+    bool handleMouseClick(const Vec2&, bool, const Vec2&) override { return false; }
+
+    mutable int drawCount = 0;
+};
+
+/** Plain container that draws its children through renderChildren(). */
+class Panel : public Widget {
+public:
+    explicit Panel(const Rect& bounds) { setBounds(bounds); }
+
+    void addDrawCommands(RenderList& commandList, const Vec2& offset) const override
+    {
+        renderChildren(commandList, Vec2(m_bounds.x + offset.x, m_bounds.y + offset.y));
+    }
+
+    bool handleMouseMove(const Vec2& position, const Vec2& offset) override
+    {
+        return dispatchMouseEvent(position, false, offset, true);
+    }
+
+    bool handleMouseClick(const Vec2& position, bool pressed, const Vec2& offset) override
+    {
+        return dispatchMouseEvent(position, pressed, offset, false);
+    }
+};
+
+void expectSameCommands(const RenderList& expected, const RenderList& actual)
+{
+    const auto& a = expected.getCommands();
+    const auto& b = actual.getCommands();
+    ASSERT_EQ(a.size(), b.size());
+
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(a[i].type, b[i].type) << "command " << i;
+
+        switch (a[i].type)
+        {
+            case RenderCommandType::FillRect:
+            case RenderCommandType::DrawRect:
+                EXPECT_EQ(a[i].rectangle.rect, b[i].rectangle.rect) << "command " << i;
+                EXPECT_EQ(a[i].rectangle.color, b[i].rectangle.color) << "command " << i;
+                break;
+            case RenderCommandType::DrawText:
+                EXPECT_EQ(a[i].text.position, b[i].text.position) << "command " << i;
+                EXPECT_STREQ(a[i].text.utf8, b[i].text.utf8) << "command " << i;
+                EXPECT_EQ(a[i].text.fontChain->fonts, b[i].text.fontChain->fonts) << "command " << i;
+                break;
+            case RenderCommandType::DrawImage:
+                EXPECT_EQ(a[i].image.destRect, b[i].image.destRect) << "command " << i;
+                EXPECT_EQ(a[i].image.sourceRect, b[i].image.sourceRect) << "command " << i;
+                EXPECT_STREQ(a[i].image.resourcePath, b[i].image.resourcePath) << "command " << i;
+                break;
+            case RenderCommandType::PushClip:
+                EXPECT_EQ(a[i].clip.rect, b[i].clip.rect) << "command " << i;
+                break;
+            case RenderCommandType::DrawLine:
+                EXPECT_EQ(a[i].line.start, b[i].line.start) << "command " << i;
+                EXPECT_EQ(a[i].line.end, b[i].line.end) << "command " << i;
+                break;
+            case RenderCommandType::FillTriangle:
+            case RenderCommandType::DrawTriangle:
+                EXPECT_EQ(a[i].triangle.p1, b[i].triangle.p1) << "command " << i;
+                EXPECT_EQ(a[i].triangle.p3, b[i].triangle.p3) << "command " << i;
+                break;
+            case RenderCommandType::FillCircle:
+            case RenderCommandType::DrawCircle:
+                EXPECT_EQ(a[i].circle.center, b[i].circle.center) << "command " << i;
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+} // namespace
+
+//==========================================================================================
+// Fixture
+//==========================================================================================
+
+class WidgetDrawCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_fontManager = std::make_unique<FontManager>();
+        ASSERT_TRUE(m_fontManager->initialize(Testing::getEmbeddedResourceResolver()));
+        m_themeManager = std::make_unique<ThemeManager>();
+        m_themeManager->setFontProvider(m_fontManager.get());
+        m_context = std::make_unique<UIContext>(m_fontManager.get(), m_themeManager.get());
+    }
+
+    std::unique_ptr<FontManager> m_fontManager;
+    std::unique_ptr<ThemeManager> m_themeManager;
+    std::unique_ptr<UIContext> m_context;
+};
+
+//==========================================================================================
+// Replay
+//==========================================================================================
+
+TEST_F(WidgetDrawCacheTest, ReplayMatchesDirectDrawing) {
+    Button button(Rect(10, 20, 60, 24));
+    button.setOwnerContext(m_context.get());
+    button.setText("Solo");
+
+    TextLabel label(Rect(10, 50, 60, 16));
+    label.setOwnerContext(m_context.get());
+    label.setText("Audio 1");
+
+    for (const Vec2& offset : { Vec2(0, 0), Vec2(200, 100), Vec2(37, 411) })
+    {
+        RenderList direct;
+        button.addDrawCommands(direct, offset);
+        label.addDrawCommands(direct, offset);
+
+        RenderList cached;
+        button.render(cached, offset);
+        label.render(cached, offset);
+
+        expectSameCommands(direct, cached);
+        EXPECT_TRUE(button.isDrawCacheValid());
+        EXPECT_TRUE(label.isDrawCacheValid());
+    }
+}
+
+TEST_F(WidgetDrawCacheTest, StaticWidgetDrawsOnce) {
+    CountingWidget widget(Rect(5, 5, 20, 10));
+
+    RenderList list;
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        list.reset();
+        widget.render(list, Vec2(static_cast<float>(frame), 0));
+    }
+
+    EXPECT_EQ(widget.drawCount, 1);
+    ASSERT_EQ(list.getCommandCount(), 1u);
+    EXPECT_EQ(list.getCommands()[0].rectangle.rect, Rect(9, 5, 20, 10));
+}
+
+//==========================================================================================
+// Invalidation
+//==========================================================================================
+
+TEST_F(WidgetDrawCacheTest, StateChangesInvalidate) {
+    CountingWidget widget(Rect(0, 0, 20, 10));
+    RenderList list;
+
+    widget.render(list);
+    widget.setBounds(Rect(4, 4, 20, 10));
+    widget.render(list);
+    EXPECT_EQ(widget.drawCount, 2);
+
+    widget.setEnabled(false);
+    widget.render(list);
+    EXPECT_EQ(widget.drawCount, 3);
+
+    widget.invalidate();
+    widget.render(list);
+    widget.render(list);
+    EXPECT_EQ(widget.drawCount, 4);
+
+    widget.setDrawCacheEnabled(false);
+    widget.render(list);
+    widget.render(list);
+    EXPECT_EQ(widget.drawCount, 6);
+}
+
+TEST_F(WidgetDrawCacheTest, ThemeChangeInvalidates) {
+    CountingWidget widget(Rect(0, 0, 20, 10));
+    widget.setOwnerContext(m_context.get());
+    RenderList list;
+
+    widget.render(list);
+    widget.render(list);
+    EXPECT_EQ(widget.drawCount, 1);
+
+    m_themeManager->setStyle(std::make_unique<ProtoolsClassicStyle>());
+    EXPECT_FALSE(widget.isDrawCacheValid());
+    widget.render(list);
+    EXPECT_EQ(widget.drawCount, 2);
+}
+
+TEST_F(WidgetDrawCacheTest, ButtonHoverInvalidates) {
+    Button button(Rect(0, 0, 60, 24));
+    button.setOwnerContext(m_context.get());
+
+    RenderList list;
+    button.render(list);
+    EXPECT_TRUE(button.isDrawCacheValid());
+
+    button.handleMouseMove(Vec2(500, 500));
+    EXPECT_TRUE(button.isDrawCacheValid());
+
+    button.handleMouseMove(Vec2(10, 10));
+    EXPECT_FALSE(button.isDrawCacheValid());
+}
+
+TEST_F(WidgetDrawCacheTest, WidgetsWithChildrenDrawDirectly) {
+    Panel panel(Rect(10, 10, 100, 100));
+    panel.setDrawCacheEnabled(true);
+    auto* child = panel.addChild(new CountingWidget(Rect(5, 5, 20, 10)));
+
+    RenderList list;
+    panel.render(list);
+    child->setBounds(Rect(6, 6, 20, 10));
+    list.reset();
+    panel.render(list);
+
+    EXPECT_EQ(child->drawCount, 2);
+    ASSERT_EQ(list.getCommandCount(), 1u);
+    EXPECT_EQ(list.getCommands()[0].rectangle.rect, Rect(16, 16, 20, 10));
+}
+
+//==========================================================================================
+// Performance
+//==========================================================================================
+
+TEST_F(WidgetDrawCacheTest, PerformanceTest_StaticMixerSurface) {
+    const int strips = 64;
+    Panel surface(Rect(0, 0, 64 * 72.0f, 600));
+    surface.setOwnerContext(m_context.get());
+
+    std::vector<Button*> buttons;
+    for (int ch = 0; ch < strips; ++ch)
+    {
+        const float x = ch * 72.0f;
+        const char* captions[] = { "S", "M", "R", "I" };
+        for (int b = 0; b < 4; ++b)
+        {
+            auto* button = surface.addChild(new Button(Rect(x + 4 + b * 16.0f, 300, 15, 16)));
+            button->setText(captions[b]);
+            buttons.push_back(button);
+        }
+        auto* name = surface.addChild(new TextLabel(Rect(x + 4, 570, 64, 16)));
+        name->setText("Audio " + std::to_string(ch + 1));
+    }
+
+    auto timeFrames = [&](bool cached, int iterations) {
+        for (Widget* child : surface.getChildren()) child->setDrawCacheEnabled(cached);
+
+        RenderList list;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < iterations; ++frame)
+        {
+            list.reset();
+            buttons[frame % buttons.size()]->setText(frame & 1 ? "M" : "S");
+            surface.render(list);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+    };
+
+    const int iterations = 100;
+    const double uncachedMs = timeFrames(false, iterations);
+    const double cachedMs = timeFrames(true, iterations);
+
+    std::cout << "\n[WidgetDrawCache] " << surface.getChildCount() << " widgets, one changing per frame: "
+              << uncachedMs << " ms/frame uncached, " << cachedMs << " ms/frame cached" << std::endl;
+
+    EXPECT_LT(cachedMs, uncachedMs);
+}
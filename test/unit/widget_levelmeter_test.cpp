@@ -14,6 +14,9 @@
 #include "YuchenUI/theme/Theme.h"
 #include "YuchenUI/theme/IThemeProvider.h"
 #include "YuchenUI/text/IFontProvider.h"
+#include "YuchenUI/text/FontDatabase.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <vector>
 #include <unordered_map>
@@ -34,6 +37,7 @@ public:
     MOCK_METHOD(FontMetrics, getFontMetrics, (FontHandle, float), (const, override));
     MOCK_METHOD(GlyphMetrics, getGlyphMetrics, (FontHandle, uint32_t, float), (const, override));
     MOCK_METHOD(Vec2, measureText, (const char*, float), (const, override));
+    MOCK_METHOD(void, measureCaretStops, (const char*, float, std::vector<float>&), (const, override));
     MOCK_METHOD(float, getTextHeight, (FontHandle, float), (const, override));
     MOCK_METHOD(bool, hasGlyph, (FontHandle, uint32_t), (const, override));
     MOCK_METHOD(FontHandle, selectFontForCodepoint, (uint32_t, const FontFallbackChain&), (const, override));
@@ -42,12 +46,23 @@ public:
     MOCK_METHOD(FontHandle, getDefaultNarrowFont, (), (const, override));
     MOCK_METHOD(FontHandle, getDefaultNarrowBoldFont, (), (const, override));
     MOCK_METHOD(FontHandle, getDefaultCJKFont, (), (const, override));
+    MOCK_METHOD(FontHandle, getDefaultSymbolFont, (), (const, override));
+    MOCK_METHOD(FontFallbackChain, createDefaultFallbackChain, (), (const, override));
+    MOCK_METHOD(FontFallbackChain, createBoldFallbackChain, (), (const, override));
+    MOCK_METHOD(FontFallbackChain, createTitleFallbackChain, (), (const, override));
+    MOCK_METHOD(FontHandle, findFont, (const char*, FontWeight, FontStyle), (const, override));
+    MOCK_METHOD(std::vector<std::string>, availableFontFamilies, (), (const, override));
+    MOCK_METHOD(std::vector<FontDescriptor>, fontsForFamily, (const char*), (const, override));
+    MOCK_METHOD(void, printAvailableFonts, (), (const, override));
     MOCK_METHOD(void*, getFontFace, (FontHandle), (const, override));
+    MOCK_METHOD(bool, getFontData, (FontHandle, const void*&, size_t&), (const, override));
     MOCK_METHOD(void*, getHarfBuzzFont, (FontHandle, float, float), (override));
 };
 
 class MockUIStyle : public UIStyle {
 public:
+    StyleType getType() const override { return StyleType::ProtoolsDark; }
+
     LevelMeterColors getLevelMeterColors() const override {
         LevelMeterColors colors;
         colors.levelNormal = Vec4::FromRGBA(0, 255, 0, 255);
@@ -78,12 +93,13 @@ public:
     void drawScrollbarThumb(const ScrollbarThumbDrawInfo&, RenderList&) override {}
     void drawScrollbarButton(const ScrollbarButtonDrawInfo&, RenderList&) override {}
     void drawTextInput(const TextInputDrawInfo&, RenderList&) override {}
-    void drawSpinBox(const SpinBoxDrawInfo&, RenderList&) override {}
+    SpinBoxColors getSpinBoxColors() const override { return SpinBoxColors(); }
     void drawComboBox(const ComboBoxDrawInfo&, RenderList&) override {}
     void drawFocusIndicator(const FocusIndicatorDrawInfo&, RenderList&) override {}
     void drawCheckBox(const CheckBoxDrawInfo&, RenderList&) override {}
     void drawRadioButton(const RadioButtonDrawInfo&, RenderList&) override {}
     void drawKnob(const KnobDrawInfo&, RenderList&) override {}
+    void drawNumberBackground(const NumberBackgroundDrawInfo&, RenderList&) override {}
     
     Vec4 getWindowBackground(WindowType) const override { return Vec4(); }
     Vec4 getDefaultTextColor() const override { return Vec4::FromRGBA(255, 255, 255, 255); }
@@ -554,41 +570,113 @@ TEST_F(LevelMeterPerformanceTest, CRITICAL_60FPS_Feasibility) {
     }
 }
 
-TEST_F(LevelMeterPerformanceTest, BlendCache_EffectivenessAnalysis) {
-    std::cout << "\n=== BlendedColorCache 效率分析 ===" << std::endl;
+TEST_F(LevelMeterPerformanceTest, GradientFill_OneCommandPerRegion) {
+    std::cout << "\n=== 渐变填充命令统计 ===" << std::endl;
     
-    // 创建电平表
+    // 0dB：背景和电平填充的三个区域（正常/警告/峰值）都会绘制
     Rect bounds(0, 0, 100, 240);
     LevelMeter meter(uiContext_.get(), bounds, 2, ScaleType::SAMPLE_PEAK);
     
-    std::vector<float> levels = {-12.0f, -18.0f};
+    std::vector<float> levels = {0.0f, 0.0f};
     meter.updateLevels(levels);
     
-    InstrumentedRenderList cmdList;
-    
-    // 第一次渲染（冷缓存）
-    auto start = std::chrono::high_resolution_clock::now();
+    RenderList cmdList;
     meter.addDrawCommands(cmdList);
-    auto end = std::chrono::high_resolution_clock::now();
-    double coldTime = std::chrono::duration<double, std::milli>(end - start).count();
-    
-    // 后续渲染（热缓存）
-    cmdList.reset();
-    start = std::chrono::high_resolution_clock::now();
-    for (int i = 0; i < 100; ++i) {
-        cmdList.reset();
-        meter.addDrawCommands(cmdList);
+    
+    size_t gradientCount = 0;
+    size_t columnCount = 0;
+    for (const auto& cmd : cmdList.getCommands()) {
+        if (cmd.type == RenderCommandType::FillGradientRect) {
+            ++gradientCount;
+            EXPECT_EQ(cmd.gradient.direction, GradientDirection::Horizontal);
+            EXPECT_EQ(cmd.gradient.stopCount, BlendedColorCache::LIGHTING_STOP_COUNT);
+        } else if (cmd.type == RenderCommandType::FillRect && cmd.rectangle.rect.width <= 1.0f) {
+            ++columnCount;
+        }
     }
-    end = std::chrono::high_resolution_clock::now();
-    double warmTime = std::chrono::duration<double, std::milli>(end - start).count() / 100.0;
     
-    std::cout << "冷缓存（首次）: " << coldTime << "ms" << std::endl;
-    std::cout << "热缓存（平均）: " << warmTime << "ms" << std::endl;
-    std::cout << "加速比: " << (coldTime / warmTime) << "x" << std::endl;
+    std::cout << "总命令: " << cmdList.getCommandCount() << " | 渐变: " << gradientCount
+              << " | 1px列: " << columnCount << std::endl;
     
-    // 缓存应该有显著效果
-    EXPECT_LT(warmTime, coldTime * 0.8)
-        << "BlendedColorCache没有显著效果，可能设计有问题";
+    // 每通道：背景3块 + 填充3块，各一条命令
+    EXPECT_EQ(gradientCount, 2u * 6u);
+    EXPECT_EQ(columnCount, 0u) << "光照效果不应再逐像素列绘制";
+}
+
+TEST_F(LevelMeterPerformanceTest, ColumnLighting_CoalescesToGradients_35Channels) {
+    // 按旧方式逐像素列绘制35通道的光照：每列一条 fillRect，颜色取自渐变在列中心的值
+    const size_t channels = 35;
+    Rect bounds(0, 0, MeterDimensions::getTotalWidth(channels), 240);
+    LevelMeter meter(uiContext_.get(), bounds, channels, ScaleType::SAMPLE_PEAK);
+    meter.updateLevels(std::vector<float>(channels, 0.0f));
+    
+    RenderList reference;
+    meter.addDrawCommands(reference);
+    
+    auto sample = [](const GradientStop* stops, uint32_t count, float t) {
+        if (t <= stops[0].position) return stops[0].color;
+        for (uint32_t i = 1; i < count; ++i) {
+            if (t > stops[i].position) continue;
+            const GradientStop& a = stops[i - 1];
+            const GradientStop& b = stops[i];
+            float f = b.position > a.position ? (t - a.position) / (b.position - a.position) : 1.0f;
+            return Vec4(a.color.x + (b.color.x - a.color.x) * f, a.color.y + (b.color.y - a.color.y) * f,
+                        a.color.z + (b.color.z - a.color.z) * f, a.color.w + (b.color.w - a.color.w) * f);
+        }
+        return stops[count - 1].color;
+    };
+    auto toBytes = [](const Vec4& c) {
+        auto byte = [](float v) { return static_cast<int>(std::min(std::max(v, 0.0f), 1.0f) * 255.0f + 0.5f); };
+        return std::array<int, 4>{ byte(c.x), byte(c.y), byte(c.z), byte(c.w) };
+    };
+    
+    RenderList columns;
+    std::vector<Vec4> columnColors;
+    size_t regionCount = 0;
+    for (const auto& cmd : reference.getCommands()) {
+        if (cmd.type != RenderCommandType::FillGradientRect) continue;
+        const auto& g = cmd.gradient;
+        const int width = static_cast<int>(g.rect.width);
+        ASSERT_EQ(static_cast<float>(width), g.rect.width);
+        ++regionCount;
+        for (int x = 0; x < width; ++x) {
+            Vec4 color = sample(g.stops, g.stopCount, (x + 0.5f) / width);
+            columns.fillRect(Rect(g.rect.x + x, g.rect.y, 1.0f, g.rect.height), color);
+            columnColors.push_back(color);
+        }
+    }
+    
+    const size_t recorded = columns.getCommandCount();
+    const size_t removed = columns.coalesceFillRects();
+    
+    std::cout << "\n=== 35通道逐列光照合并 ===" << std::endl;
+    std::cout << "区域: " << regionCount << " | 逐列命令: " << recorded
+              << " | 合并后: " << columns.getCommandCount() << std::endl;
+    
+    // 每个区域的各列合并为一条命令（渐变，或单色区域的一个矩形），且每列在8位输出下颜色不变
+    ASSERT_GT(regionCount, 0u);
+    EXPECT_EQ(recorded, columnColors.size());
+    EXPECT_EQ(columns.getCommandCount(), regionCount);
+    EXPECT_EQ(removed, recorded - regionCount);
+    EXPECT_TRUE(columns.validate());
+    
+    size_t column = 0;
+    size_t gradientCount = 0;
+    for (const auto& cmd : columns.getCommands()) {
+        const bool gradient = cmd.type == RenderCommandType::FillGradientRect;
+        ASSERT_TRUE(gradient || cmd.type == RenderCommandType::FillRect);
+        gradientCount += gradient ? 1 : 0;
+        const Rect& rect = gradient ? cmd.gradient.rect : cmd.rectangle.rect;
+        const int width = static_cast<int>(rect.width);
+        for (int x = 0; x < width; ++x, ++column) {
+            ASSERT_LT(column, columnColors.size());
+            Vec4 color = gradient ? sample(cmd.gradient.stops, cmd.gradient.stopCount, (x + 0.5f) / width)
+                                  : cmd.rectangle.color;
+            EXPECT_EQ(toBytes(color), toBytes(columnColors[column]));
+        }
+    }
+    EXPECT_GT(gradientCount, regionCount / 2);
+    EXPECT_EQ(column, columnColors.size());
 }
 
 //==========================================================================================
@@ -0,0 +1,50 @@
+/*******************************************************************************************
+**
+** YuchenUI - Modern C++ GUI Framework - WorkerPool Unit Tests
+**
+** Copyright (C) 2025 Yuchen Wei
+**
+** Tests that every task runs exactly once with a valid worker index, for inline and
+** threaded pools, across repeated jobs.
+**
+********************************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "YuchenUI/utils/WorkerPool.h"
+
+#include <atomic>
+#include <vector>
+
+using namespace YuchenUI;
+
+TEST(WorkerPoolTest, SingleThreadRunsInline) {
+    WorkerPool pool(1);
+    EXPECT_EQ(pool.getThreadCount(), 1u);
+
+    std::vector<int> order;
+    pool.parallelFor(5, [&](size_t task, size_t worker) {
+        EXPECT_EQ(worker, 0u);
+        order.push_back(static_cast<int>(task));
+    });
+
+    EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2, 3, 4 }));
+}
+
+TEST(WorkerPoolTest, EveryTaskRunsOnce) {
+    WorkerPool pool(4);
+    ASSERT_EQ(pool.getThreadCount(), 4u);
+
+    for (int job = 0; job < 50; ++job)
+    {
+        std::vector<std::atomic<int>> hits(257);
+        for (auto& h : hits) h = 0;
+
+        pool.parallelFor(hits.size(), [&](size_t task, size_t worker) {
+            EXPECT_LT(worker, 4u);
+            hits[task].fetch_add(1);
+        });
+
+        for (auto& h : hits) ASSERT_EQ(h.load(), 1);
+    }
+}